@@ -7,6 +7,8 @@ layout (location = 0) in vec3 inNormal;
 layout (location = 1) in vec2 inUV;
 layout (location = 2) in vec3 inColor;
 layout (location = 3) in vec3 inWorldPos;
+// written by the vertex shader, from push constants or the indirect draw instance
+layout (location = 4) flat in uint inMaterialIndex;
 
 layout (location = 0) out vec4 outPosition;
 layout (location = 1) out vec4 outNormal;
@@ -36,12 +38,6 @@ layout(std140, set = 0, binding = 2) readonly buffer MaterialBuffer {
     Material materialData[];
 };
 
-layout (push_constant) uniform uNodePushConstant
-{
-    uint uNodeIndex;
-    uint uMaterialIndex;
-};
-
 struct SurfaceOut
 {
     vec4 albedo;
@@ -68,7 +64,7 @@ vec3 GetNormal() {
 
 void SurfaceShaderTextured(out SurfaceOut surface)
 {
-    Material surfMat = materialData[uMaterialIndex];
+    Material surfMat = materialData[inMaterialIndex];
 
     surface.normal = GetNormal();
 
@@ -36,6 +36,7 @@ layout (location = 0) out vec3 outNormal;
 layout (location = 1) out vec2 outUV;
 layout (location = 2) out vec3 outColor;
 layout (location = 3) out vec3 outWorldPos;
+layout (location = 4) flat out uint outMaterialIndex;
 
 void main()
 {
@@ -54,4 +55,6 @@ void main()
 
     // Currently just vertex color
     outColor = inColor.rgb;
+
+    outMaterialIndex = uMaterialIndex;
 }
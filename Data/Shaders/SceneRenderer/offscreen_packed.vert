@@ -0,0 +1,77 @@
+#version 450
+
+// asset::PackedVertex, see AssetLib/VertexQuantization.h
+// x: pos.xy unorm16, y: pos.z unorm16 | tangent handedness unorm16, z: octahedral normal snorm16,
+// w: octahedral tangent snorm16
+layout (location = 0) in uvec4 inPacked0;
+// x: uv0 half2, y: uv1 half2, z: color unorm8, w: reserved
+layout (location = 1) in uvec4 inPacked1;
+
+layout(set = 0, binding = 0) uniform uCameraData
+{
+    mat4 uProjViewMatrix;
+    mat4 uProjMatrix;
+    mat4 uViewMatrix;
+};
+
+// scene graph node data
+struct NodeData {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+};
+
+layout(std140, set = 0, binding = 1) readonly buffer NodeBuffer {
+    NodeData nodesData[];
+};
+
+// same prefix as offscreen.vert, followed by the submesh quantization bounds
+layout (push_constant) uniform uNodePushConstant
+{
+    uint uNodeIndex;
+    uint uMaterialIndex;
+    uint uPadding0;
+    uint uPadding1;
+    vec4 uPosOffset;
+    vec4 uPosScale;
+};
+
+layout (location = 0) out vec3 outNormal;
+layout (location = 1) out vec2 outUV;
+layout (location = 2) out vec3 outColor;
+layout (location = 3) out vec3 outWorldPos;
+layout (location = 4) flat out uint outMaterialIndex;
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
+void main()
+{
+    // unorm16 steps, scale is extent / 65535
+    vec3 quantizedPos = vec3(inPacked0.x & 0xFFFFu, inPacked0.x >> 16, inPacked0.y & 0xFFFFu);
+    vec3 inPos = uPosOffset.xyz + quantizedPos * uPosScale.xyz;
+    vec3 inNormal = OctDecode(unpackSnorm2x16(inPacked0.z));
+    vec4 inColor = unpackUnorm4x8(inPacked1.z);
+
+    vec4 locPos = nodesData[uNodeIndex].modelMatrix * vec4(inPos, 1.0);
+
+    gl_Position = uProjViewMatrix * vec4(locPos.xyz, 1.0);
+
+    outUV = unpackHalf2x16(inPacked1.x);
+
+    // Vertex position in world space
+    outWorldPos = locPos.xyz / locPos.w;
+
+    // Normal in world space
+    mat3 mNormal = mat3(nodesData[uNodeIndex].normalMatrix);
+    outNormal = mNormal * inNormal;
+
+    // Currently just vertex color
+    outColor = inColor.rgb;
+
+    outMaterialIndex = uMaterialIndex;
+}
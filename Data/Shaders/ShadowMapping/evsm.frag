@@ -5,6 +5,9 @@ layout(location = 0) in FS_IN {
     vec2 texCoord;
 } fs_in;
 
+// written by the vertex shader, from push constants or the indirect draw instance
+layout(location = 2) flat in uint inMaterialIndex;
+
 layout(location = 0) out vec4 outColor;
 
 layout (push_constant) uniform uPushConstant
@@ -59,7 +62,7 @@ vec4 ShadowDepthToEVSM(float depth)
 
 void main()
 {
-    vec4 diffuseColor = texture(uTextureArray[materialData[pc.materialIndex].bcTexIndex], fs_in.texCoord);
+    vec4 diffuseColor = texture(uTextureArray[materialData[inMaterialIndex].bcTexIndex], fs_in.texCoord);
 
     if (diffuseColor.a <= pc.alphaCutoff) { discard; }
 
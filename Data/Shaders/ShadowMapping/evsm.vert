@@ -14,6 +14,8 @@ layout(location = 0) out VS_OUT {
     vec2 texCoord;
 } vs_out;
 
+layout(location = 2) flat out uint outMaterialIndex;
+
 struct NodeData {
     mat4 modelMatrix;
     mat4 normalMatrix;
@@ -41,6 +43,7 @@ void main()
     vec4 vertexPos = vec4(inPos.xyz, 1.0);
     vs_out.position = uLightViewProjection * nodesData[pc.nodeIndex].modelMatrix * vertexPos;
     vs_out.texCoord = inUV0.xy;
+    outMaterialIndex = pc.materialIndex;
     // final drawing pos
     gl_Position = vs_out.position;
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#version 460
+
+// asset::PackedVertex, see AssetLib/VertexQuantization.h
+// x: pos.xy unorm16, y: pos.z unorm16 | tangent handedness unorm16, z: octahedral normal snorm16,
+// w: octahedral tangent snorm16
+layout (location = 0) in uvec4 inPacked0;
+// x: uv0 half2, y: uv1 half2, z: color unorm8, w: reserved
+layout (location = 1) in uvec4 inPacked1;
+
+layout(location = 0) out VS_OUT {
+    vec4 position;
+    vec2 texCoord;
+} vs_out;
+
+layout(location = 2) flat out uint outMaterialIndex;
+
+struct NodeData {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+};
+
+layout (set = 0, binding = 0) uniform uLightInfo
+{
+    mat4 uLightViewProjection;
+};
+
+layout(std140, set = 0, binding = 1) readonly buffer NodeBuffer {
+    NodeData nodesData[];
+};
+
+// same prefix as evsm.vert, followed by the submesh quantization bounds
+layout (push_constant) uniform uNodePushConstant
+{
+    vec2 exponents;
+    uint nodeIndex;
+    uint materialIndex;
+    float alphaCutoff;
+    vec4 posOffset;
+    vec4 posScale;
+} pc;
+
+void main()
+{
+    // unorm16 steps, scale is extent / 65535
+    vec3 quantizedPos = vec3(inPacked0.x & 0xFFFFu, inPacked0.x >> 16, inPacked0.y & 0xFFFFu);
+    vec4 vertexPos = vec4(pc.posOffset.xyz + quantizedPos * pc.posScale.xyz, 1.0);
+    vs_out.position = uLightViewProjection * nodesData[pc.nodeIndex].modelMatrix * vertexPos;
+    vs_out.texCoord = unpackHalf2x16(inPacked1.x);
+    outMaterialIndex = pc.materialIndex;
+    // final drawing pos
+    gl_Position = vs_out.position;
+}
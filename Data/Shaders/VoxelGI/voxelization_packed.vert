@@ -0,0 +1,61 @@
+#version 450
+
+// asset::PackedVertex, see AssetLib/VertexQuantization.h
+// x: pos.xy unorm16, y: pos.z unorm16 | tangent handedness unorm16, z: octahedral normal snorm16,
+// w: octahedral tangent snorm16
+layout (location = 0) in uvec4 inPacked0;
+// x: uv0 half2, y: uv1 half2, z: color unorm8, w: reserved
+layout (location = 1) in uvec4 inPacked1;
+
+layout(location = 0) out VS_OUT {
+    vec3 color;
+    vec3 tangent;
+    vec3 normal;
+    vec2 texCoord;
+} vs_out;
+
+// scene graph node data
+struct NodeData {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+};
+
+layout(std140, set = 0, binding = 0) readonly buffer NodeBuffer {
+    NodeData nodesData[];
+};
+
+// same prefix as voxelization.vert, followed by the submesh quantization bounds
+layout (push_constant) uniform uNodePushConstant
+{
+    uint nodeIndex;
+    uint materialIndex;
+    uint flagStaticVoxels;
+    uint volumeDimension;
+    vec4 posOffset;
+    vec4 posScale;
+} pc;
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
+void main()
+{
+    // unorm16 steps, scale is extent / 65535
+    vec3 quantizedPos = vec3(inPacked0.x & 0xFFFFu, inPacked0.x >> 16, inPacked0.y & 0xFFFFu);
+    vec3 inPos = pc.posOffset.xyz + quantizedPos * pc.posScale.xyz;
+    vec3 inNormal = OctDecode(unpackSnorm2x16(inPacked0.z));
+    vec3 inTangent = OctDecode(unpackSnorm2x16(inPacked0.w));
+
+    gl_Position = nodesData[pc.nodeIndex].modelMatrix * vec4(inPos, 1.0);
+
+    // Normal in world space
+    vs_out.normal = (nodesData[pc.nodeIndex].normalMatrix * vec4(inNormal, 0.0f)).xyz;
+    vs_out.texCoord = unpackHalf2x16(inPacked1.x);
+    vs_out.color = unpackUnorm4x8(inPacked1.z).xyz;
+    vs_out.tangent = inTangent;
+}
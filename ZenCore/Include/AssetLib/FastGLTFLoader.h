@@ -4,8 +4,16 @@
 #include <fastgltf/types.hpp>
 #include <fastgltf/tools.hpp>
 #include "Types.h"
+#include "MeshletBuilder.h"
+#include "MeshOptimizer.h"
+#include "SceneCache.h"
 #include "Utils/UniquePtr.h"
 
+namespace zen
+{
+class JobSystem;
+} // namespace zen
+
 namespace zen::sg
 {
 class Scene;
@@ -31,7 +39,63 @@ public:
         return m_indices;
     }
 
+    // textures and meshes are converted on a job system by default, the serial path produces
+    // bit-identical vertices and indices
+    void SetParallelLoading(bool parallelLoading)
+    {
+        m_parallelLoading = parallelLoading;
+    }
+
+    // reorders the triangles and vertices of every submesh for the post-transform cache,
+    // overdraw and vertex fetch after loading, see MeshOptimizer::Optimize
+    void SetOptimizeMeshes(bool optimizeMeshes)
+    {
+        m_optimizeMeshes = optimizeMeshes;
+    }
+
+    // partitions every submesh into meshlets after loading, see sg::SubMesh::GetFirstMeshlet
+    void SetBuildMeshlets(bool buildMeshlets)
+    {
+        m_buildMeshlets = buildMeshlets;
+    }
+
+    const auto& GetMeshletData() const
+    {
+        return m_meshletData;
+    }
+
+    // cooks every loaded scene into sceneCacheDir and maps the cooked copy instead of parsing on
+    // later loads of an unchanged file, see SceneCache. Textures get mip chains in both cases.
+    void SetSceneCacheDir(std::string sceneCacheDir)
+    {
+        m_sceneCacheDir = std::move(sceneCacheDir);
+    }
+
+    // true if the last LoadFromFile was served by the scene cache
+    bool IsLoadedFromSceneCache() const
+    {
+        return m_loadedFromSceneCache;
+    }
+
 private:
+    // where a primitive lands in m_vertices and m_indices, computed before conversion
+    struct GltfPrimitiveRange
+    {
+        const fastgltf::Primitive* pPrimitive{nullptr};
+        uint32_t vertexOffset{0};
+        uint32_t vertexCount{0};
+        uint32_t indexOffset{0};
+        uint32_t indexCount{0};
+        Vec4 diffuseColor{1.0f};
+    };
+
+    // SceneCacheKey::loaderFlags
+    static constexpr uint32_t cSceneCacheOptimizeMeshes = 1 << 0;
+    static constexpr uint32_t cSceneCacheBuildMeshlets  = 1 << 1;
+
+    static constexpr uint32_t cNumVerticesPerJob = 16 * 1024;
+    static constexpr uint32_t cNumIndicesPerJob  = 64 * 1024;
+
     void LoadGltfSamplers(sg::Scene* pScene);
 
     void LoadGltfTextures(sg::Scene* pScene);
@@ -40,6 +104,20 @@ private:
 
     void LoadGltfMeshes(sg::Scene* pScene);
 
+    void OptimizeGltfMeshes(const std::vector<GltfPrimitiveRange>& primitiveRanges);
+
+    // firstMeshlets[i]..firstMeshlets[i + 1] are the meshlets of primitiveRanges[i]
+    void BuildGltfMeshlets(const std::vector<GltfPrimitiveRange>& primitiveRanges,
+                           std::vector<uint32_t>& firstMeshlets);
+
+    void ConvertGltfVertices(const GltfPrimitiveRange& range,
+                             uint32_t vertexBegin,
+                             uint32_t vertexEnd);
+
+    void ConvertGltfIndices(const GltfPrimitiveRange& range,
+                            uint32_t indexBegin,
+                            uint32_t indexEnd);
+
     void LoadGltfRenderableNodes(sg::Scene* pScene);
 
     void LoadGltfRenderableNodes(
@@ -88,5 +166,14 @@ private:
     // vertices and indices
     std::vector<Vertex> m_vertices;
     std::vector<uint32_t> m_indices;
+    MeshletData m_meshletData;
+    bool m_parallelLoading{true};
+    bool m_optimizeMeshes{false};
+    bool m_buildMeshlets{false};
+    std::string m_sceneCacheDir;
+    bool m_loadedFromSceneCache{false};
+    // hierarchy as created by LoadGltfRenderableNodes, only recorded for the scene cache
+    std::vector<SceneCacheNode> m_sceneCacheNodes;
+    JobSystem* m_pJobSystem{nullptr};
 };
 } // namespace zen::asset
\ No newline at end of file
@@ -145,6 +145,13 @@ public:
         return m_indices;
     }
 
+    // reorders the triangles and vertices of every submesh after loading, see
+    // MeshOptimizer::Optimize
+    void SetOptimizeMeshes(bool optimizeMeshes)
+    {
+        m_optimizeMeshes = optimizeMeshes;
+    }
+
 private:
     void LoadGltfSamplers(sg::Scene* pScene);
 
@@ -174,5 +181,6 @@ private:
     // vertices and indices
     std::vector<Vertex> m_vertices;
     std::vector<uint32_t> m_indices;
+    bool m_optimizeMeshes{false};
 };
 } // namespace zen::asset
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include "Types.h"
+
+namespace zen::asset
+{
+struct VertexCacheStatistics
+{
+    uint32_t numTransformedVertices{0};
+    // average cache miss ratio, vertex shader invocations per triangle, 0.5 at best
+    float acmr{0.0f};
+    // average transform to vertex ratio, vertex shader invocations per used vertex, 1 at best
+    float atvr{0.0f};
+};
+
+// Import time reordering of indexed triangle lists. Every function works on one submesh whose
+// indices point into the scene vertex array, and only touches the vertices between the smallest
+// and the largest index of that submesh, so submeshes owning disjoint vertex ranges can be
+// optimized independently and in parallel.
+class MeshOptimizer
+{
+public:
+    // cache size the analysis defaults to, a conservative fit for current GPUs
+    static constexpr uint32_t cCacheSize = 16;
+    // overdraw optimization may make the acmr of a cluster this much worse
+    static constexpr float cOverdrawThreshold = 1.05f;
+
+    // vertex cache, overdraw and vertex fetch optimization in that order
+    static void Optimize(Vertex* pVertices, uint32_t* pIndices, uint32_t numIndices);
+
+    // reorders triangles for the post-transform cache (Forsyth, linear speed vertex cache
+    // optimization), winding and the set of triangles are preserved
+    static void OptimizeVertexCache(uint32_t* pIndices, uint32_t numIndices);
+
+    // splits cache optimized triangles into clusters and draws the outward facing ones first,
+    // call after OptimizeVertexCache, threshold bounds the acmr loss of the split
+    static void OptimizeOverdraw(const Vertex* pVertices,
+                                 uint32_t* pIndices,
+                                 uint32_t numIndices,
+                                 float threshold = cOverdrawThreshold);
+
+    // renumbers vertices in order of first use and rewrites the indices, unreferenced vertices of
+    // the range move to its end
+    static void OptimizeVertexFetch(Vertex* pVertices, uint32_t* pIndices, uint32_t numIndices);
+
+    // simulates a fifo post-transform cache
+    static VertexCacheStatistics AnalyzeVertexCache(const uint32_t* pIndices,
+                                                    uint32_t numIndices,
+                                                    uint32_t cacheSize = cCacheSize);
+};
+} // namespace zen::asset
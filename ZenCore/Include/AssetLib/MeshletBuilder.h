@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include "Types.h"
+
+namespace zen::asset
+{
+struct Meshlet
+{
+    // ranges in MeshletData::vertices and MeshletData::triangles (in triangles)
+    uint32_t vertexOffset{0};
+    uint32_t triangleOffset{0};
+    uint32_t vertexCount{0};
+    uint32_t triangleCount{0};
+    // xyz center, w radius
+    Vec4 boundingSphere{0.0f};
+    // xyz axis, w cutoff, a cutoff of 1 never culls, see MeshletBuilder::IsBackFacing
+    Vec4 normalCone{0.0f, 0.0f, 0.0f, 1.0f};
+};
+
+struct MeshletData
+{
+    std::vector<Meshlet> meshlets;
+    // indices into the scene vertex array
+    std::vector<uint32_t> vertices;
+    // 3 indices into the meshlet's vertices per triangle
+    std::vector<uint8_t> triangles;
+};
+
+// Partitions an indexed triangle list into clusters small enough for a mesh shader workgroup.
+// Clusters grow over shared vertices, so they stay spatially compact on connected meshes and
+// follow the index order on triangle soups.
+class MeshletBuilder
+{
+public:
+    static constexpr uint32_t cMaxVertices  = 64;
+    static constexpr uint32_t cMaxTriangles = 124;
+
+    // appends the meshlets of one submesh to meshletData, returns the number of meshlets added
+    static uint32_t Build(const Vertex* pVertices,
+                          const uint32_t* pIndices,
+                          uint32_t numIndices,
+                          MeshletData& meshletData);
+
+    // true if every triangle of the meshlet faces away from cameraPos (counter-clockwise front)
+    static bool IsBackFacing(const Meshlet& meshlet, const Vec3& cameraPos);
+};
+} // namespace zen::asset
@@ -0,0 +1,81 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "MeshletBuilder.h"
+
+namespace zen::sg
+{
+class Scene;
+} // namespace zen::sg
+
+namespace zen::asset
+{
+// node of the loaded hierarchy, recorded in the order the loader created it (children first)
+struct SceneCacheNode
+{
+    uint32_t index{0};
+    // index of the parent node, -1 for root nodes
+    int32_t parentIndex{-1};
+    // -1 for nodes without a mesh, these keep no transform
+    int32_t meshIndex{-1};
+    Vec3 translation{0.0f};
+    Quat rotation{};
+    Vec3 scale{1.0f};
+    std::string name;
+};
+
+// what a cooked scene has to match to be reused
+struct SceneCacheKey
+{
+    // content hash of the .gltf or .glb file
+    uint64_t sourceHash{0};
+    // path, size and write time of the files next to the source, covers external buffers and
+    // images without parsing the source
+    uint64_t dependencyHash{0};
+    // loader options that change the cooked data
+    uint32_t loaderFlags{0};
+};
+
+// Cooked binary copy of a loaded glTF scene: vertices, indices, meshlets, submesh tables,
+// materials and decoded textures with their mip chains. A warm load maps the file and rebuilds
+// the scene without parsing glTF or decoding images. Any mismatch of version, key or size fails
+// the read and the caller loads the source again.
+class SceneCache
+{
+public:
+    // bump whenever the file layout changes, Vertex and Meshlet sizes are checked separately
+    static constexpr uint32_t cVersion = 1;
+    static constexpr uint32_t cMagic   = 0x4E43535A; // "ZSCN"
+
+    static constexpr const char* cExtension = ".zscene";
+
+    // cacheDir/<stem>_<hash of the source path>.zscene
+    static std::string GetCachePath(const std::string& cacheDir, const std::string& sourcePath);
+
+    // returns false if the source can not be read
+    static bool CalcKey(const std::string& sourcePath,
+                        const std::string& cacheDir,
+                        uint32_t loaderFlags,
+                        SceneCacheKey& key);
+
+    // call before sg::Scene::UpdateAABB, mesh bounds are stored untransformed. The file is written
+    // next to cachePath first and renamed, a crashed write never leaves a partial cache behind.
+    static bool Write(const std::string& cachePath,
+                      const SceneCacheKey& key,
+                      const sg::Scene& scene,
+                      const std::vector<SceneCacheNode>& nodes,
+                      const std::vector<Vertex>& vertices,
+                      const std::vector<uint32_t>& indices,
+                      const MeshletData& meshletData);
+
+    // fills an empty scene and leaves it untouched on failure, sg::Scene::UpdateAABB is left to
+    // the caller
+    static bool Read(const std::string& cachePath,
+                     const SceneCacheKey& key,
+                     sg::Scene* pScene,
+                     std::vector<Vertex>& vertices,
+                     std::vector<uint32_t>& indices,
+                     MeshletData& meshletData);
+};
+} // namespace zen::asset
@@ -10,5 +10,12 @@ class TextureLoader
 public:
     static TextureInfo LoadTexture2DFromFile(const std::string& filename);
     static void LoadTexture2DFromFile(const std::string& filename, TextureInfo* pOutTexInfo);
+
+    // appends the mip chain of an RGBA8 image down to 1x1 to data, levels are tightly packed with
+    // level 0 first, srgb images are filtered in linear space. Returns the number of levels.
+    static uint32_t GenerateMipmaps(uint32_t width,
+                                    uint32_t height,
+                                    bool srgb,
+                                    std::vector<uint8_t>& data);
 };
 } // namespace zen::asset
\ No newline at end of file
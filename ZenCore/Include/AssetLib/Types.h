@@ -322,6 +322,24 @@ struct Vertex
     Vec4 color;
 };
 
+// Compact layout of Vertex for static geometry, 32 bytes instead of 112, see
+// AssetLib/VertexQuantization.h. Read by shaders as two uvec4, joints and weights are dropped.
+struct PackedVertex
+{
+    // unorm16 within the submesh bounds, w holds the tangent handedness (0: -1, 0xFFFF: +1)
+    uint16_t pos[4];
+    // octahedral snorm16
+    int16_t normal[2];
+    int16_t tangent[2];
+    // half floats
+    uint16_t uv0[2];
+    uint16_t uv1[2];
+    // unorm8
+    uint8_t color[4];
+    uint32_t reserved;
+};
+static_assert(sizeof(PackedVertex) == 32);
+
 struct TextureInfo
 {
     TextureInfo() = default;
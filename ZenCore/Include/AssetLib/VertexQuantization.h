@@ -0,0 +1,40 @@
+#pragma once
+#include "AssetLib/Types.h"
+
+namespace zen::asset
+{
+// Restores positions of a packed submesh: pos = offset + unorm16 * scale
+struct VertexQuantizationBounds
+{
+    Vec4 offset{0.0f};
+    Vec4 scale{0.0f};
+};
+
+// Round trip error bounds of Vertex -> PackedVertex -> Vertex:
+//   pos:      half a quantization step per axis, extent / 131070 of the submesh bounds
+//   normal:   octahedral snorm16, < 0.005 degrees for unit vectors, zero or nan vectors become +Z
+//   tangent:  same as normal for xyz, handedness w is exact for -1 and +1
+//   uv0, uv1: half floats, relative error <= 2^-11 for |uv| < 65504
+//   color:    unorm8, 1 / 510 per channel, values are clamped to [0, 1]
+//   joint0, weight0 are not stored and restored as zero.
+VertexQuantizationBounds CalcVertexQuantizationBounds(const Vertex* pVertices,
+                                                      uint32_t numVertices);
+
+PackedVertex PackVertex(const Vertex& vertex, const VertexQuantizationBounds& bounds);
+
+Vertex UnpackVertex(const PackedVertex& packedVertex, const VertexQuantizationBounds& bounds);
+
+// packs the vertices of one submesh, returns the bounds the shaders need to restore positions
+VertexQuantizationBounds PackVertices(const Vertex* pVertices,
+                                      uint32_t numVertices,
+                                      PackedVertex* pPackedVertices);
+
+uint16_t FloatToHalf(float value);
+
+float HalfToFloat(uint16_t value);
+
+// maps a direction onto [-1, 1]^2, the inverse is exact up to normalization
+Vec2 OctEncode(const Vec3& direction);
+
+Vec3 OctDecode(const Vec2& encoded);
+} // namespace zen::asset
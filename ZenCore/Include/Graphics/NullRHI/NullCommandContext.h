@@ -0,0 +1,260 @@
+#pragma once
+#include "Graphics/RHI/RHICommandList.h"
+#include "Templates/HashMap.h"
+#include <string>
+
+namespace zen
+{
+class NullRHI;
+class NullPipeline;
+class NullBuffer;
+class NullTexture;
+
+enum class NullCommandType : uint32_t
+{
+    eBeginRendering,
+    eEndRendering,
+    eSetScissor,
+    eSetViewport,
+    eSetDepthBias,
+    eSetLineWidth,
+    eSetBlendConstants,
+    eBindPipeline,
+    eBindVertexBuffers,
+    eDraw,
+    eDrawIndexed,
+    eDrawIndexedIndirect,
+    eDrawIndexedIndirectCount,
+    eDispatch,
+    eDispatchIndirect,
+    eSetPushConstants,
+    eTransitions,
+    eSetBarrierEvent,
+    eWaitBarrierEvent,
+    eGenTextureMipmaps,
+    eTextureLayoutTransition,
+    eClearBuffer,
+    eCopyBuffer,
+    eClearTexture,
+    eCopyTexture,
+    eCopyTextureToBuffer,
+    eCopyBufferToTexture,
+    eResolveTexture,
+    ePresent,
+    eMax
+};
+
+// one replayed call, resources are named by their tags so tests can compare whole frames
+struct NullCommandRecord
+{
+    NullCommandType type{NullCommandType::eMax};
+    RHICommandContextType contextType{RHICommandContextType::eGraphics};
+    std::string text;
+};
+
+// the usage a command list expects a resource in when it first touches it and the usage it
+// leaves the resource in, eMax if unknown
+template <class Usage> struct NullUsageRange
+{
+    Usage expectedUsage;
+    Usage finalUsage;
+};
+
+// resources only learn their usage when the list is submitted, so lists can be finalized on
+// different threads and still be checked in submission order
+struct NullResourceUsages
+{
+    HashMap<NullBuffer*, NullUsageRange<RHIBufferUsage>> buffers;
+    HashMap<NullTexture*, NullUsageRange<RHITextureUsage>> textures;
+};
+
+// the records of one finalized command list, appended to the RHI's log when submitted
+class NullPlatformCommandList : public RHIPlatformCommandList
+{
+public:
+    HeapVector<NullCommandRecord> records;
+    NullResourceUsages usages;
+};
+
+// replays RHICommandLists into a log instead of a GPU command buffer. Every call is checked
+// against the state recorded so far: render pass nesting, bound pipelines, destroyed or
+// unbound resources and the usage each texture and buffer was last transitioned to in this
+// list. Violations are reported to the NullRHI
+class NullCommandContext : public IRHICommandContext
+{
+public:
+    NullCommandContext(RHICommandContextType contextType, NullRHI* pRHI) :
+        m_contextType(contextType), m_pRHI(pRHI)
+    {}
+
+    RHICommandContextType GetContextType() override
+    {
+        return m_contextType;
+    }
+
+    // records since the last TakeRecords
+    const HeapVector<NullCommandRecord>& GetRecords() const
+    {
+        return m_records;
+    }
+
+    uint32_t GetNumRecords(NullCommandType type) const;
+
+    // moves the records out and resets the per-list state, called when the list is finalized.
+    // The resource usages are dropped if pOutUsages is null
+    void TakeRecords(HeapVector<NullCommandRecord>& outRecords,
+                     NullResourceUsages* pOutUsages = nullptr);
+
+    void RHIBeginRendering(const RHIRenderingLayout* pRenderingLayout) override;
+
+    void RHIEndRendering() override;
+
+    void RHISetScissor(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) override;
+
+    void RHISetViewport(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) override;
+
+    void RHISetDepthBias(float depthBiasConstantFactor,
+                         float depthBiasClamp,
+                         float depthBiasSlopeFactor) override;
+
+    void RHISetLineWidth(float lineWidth) override;
+
+    void RHISetBlendConstants(const Color& blendConstants) override;
+
+    void RHIBindPipeline(RHIPipeline* pPipeline,
+                         uint32_t numDescriptorSets,
+                         RHIDescriptorSet* const* pDescriptorSets) override;
+
+    void RHIBindVertexBuffers(VectorView<RHIBuffer*> pBuffers,
+                              VectorView<uint64_t> offsets) override;
+
+    void RHIBindVertexBuffer(RHIBuffer* pBuffer, uint64_t offset) override;
+
+    void RHIDraw(uint32_t vertexCount,
+                 uint32_t instanceCount,
+                 uint32_t firstVertex,
+                 uint32_t firstInstance) override;
+
+    void RHIDrawIndexed(RHIBuffer* pIndexBuffer,
+                        DataFormat indexFormat,
+                        uint32_t indexBufferOffset,
+                        uint32_t indexCount,
+                        uint32_t instanceCount,
+                        uint32_t firstIndex,
+                        int32_t vertexOffset,
+                        uint32_t firstInstance) override;
+
+    void RHIDrawIndexedIndirect(RHIBuffer* pIndirectBuffer,
+                                RHIBuffer* pIndexBuffer,
+                                DataFormat indexFormat,
+                                uint32_t indexBufferOffset,
+                                uint32_t offset,
+                                uint32_t drawCount,
+                                uint32_t stride) override;
+
+    void RHIDrawIndexedIndirectCount(RHIBuffer* pIndirectBuffer,
+                                     RHIBuffer* pIndexBuffer,
+                                     DataFormat indexFormat,
+                                     uint32_t indexBufferOffset,
+                                     uint32_t offset,
+                                     RHIBuffer* pCountBuffer,
+                                     uint32_t countBufferOffset,
+                                     uint32_t maxDrawCount,
+                                     uint32_t stride) override;
+
+    void RHIDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+
+    void RHIDispatchIndirect(RHIBuffer* pIndirectBuffer, uint32_t offset) override;
+
+    void RHISetPushConstants(RHIPipeline* pPipeline, VectorView<uint8_t> data) override;
+
+    void RHIAddTransitions(BitField<RHIPipelineStageBits> srcStages,
+                           BitField<RHIPipelineStageBits> dstStages,
+                           VectorView<RHIMemoryTransition> memoryTransitions,
+                           VectorView<RHIBufferTransition> bufferTransitions,
+                           VectorView<RHITextureTransition> textureTransitions) override;
+
+    void RHISetBarrierEvent(RHIBarrierEvent* pEvent,
+                            BitField<RHIPipelineStageBits> srcStages,
+                            BitField<RHIPipelineStageBits> dstStages,
+                            VectorView<RHIBufferTransition> bufferTransitions,
+                            VectorView<RHITextureTransition> textureTransitions) override;
+
+    void RHIWaitBarrierEvent(RHIBarrierEvent* pEvent) override;
+
+    void RHIGenTextureMipmaps(RHITexture* pTexture) override;
+
+    void RHIAddTextureTransition(RHITexture* pTexture, RHITextureLayout newLayout) override;
+
+    void RHIClearBuffer(RHIBuffer* pBuffer, uint32_t offset, uint32_t size) override;
+
+    void RHICopyBuffer(RHIBuffer* pSrcBuffer,
+                       RHIBuffer* pDstBuffer,
+                       const RHIBufferCopyRegion& region) override;
+
+    void RHIClearTexture(RHITexture* pTex,
+                         const Color& color,
+                         const RHITextureSubResourceRange& range) override;
+
+    void RHICopyTexture(RHITexture* pSrcTexture,
+                        RHITexture* pDstTexture,
+                        VectorView<RHITextureCopyRegion> regions) override;
+
+    void RHICopyTextureToBuffer(RHITexture* pSrcTex,
+                                RHIBuffer* pDstBuffer,
+                                VectorView<RHIBufferTextureCopyRegion> regions) override;
+
+    void RHICopyBufferToTexture(RHIBuffer* pSrcBuffer,
+                                RHITexture* pDstTexture,
+                                VectorView<RHIBufferTextureCopyRegion> regions) override;
+
+    void RHIResolveTexture(RHITexture* pSrcTexture,
+                           RHITexture* pDstTexture,
+                           uint32_t srcLayer,
+                           uint32_t srcMipmap,
+                           uint32_t dstLayer,
+                           uint32_t dstMipmap) override;
+
+    void RHIWaitUntilCompleted() override;
+
+private:
+    void Record(NullCommandType type, std::string text);
+
+    void ReportError(const std::string& message);
+
+    // the tag of a live resource, "null" or "destroyed" otherwise
+    std::string Name(const RHIResource* pResource) const;
+
+    // false if the resource is null, destroyed, not created by the null RHI or has no memory
+    bool ValidateBuffer(const RHIBuffer* pBuffer, const char* pCommand);
+
+    bool ValidateTexture(const RHITexture* pTexture, const char* pCommand);
+
+    void ValidateOutsideRendering(const char* pCommand);
+
+    void ValidateDraw(const char* pCommand);
+
+    void ValidateDispatch(const char* pCommand);
+
+    void ApplyBufferTransitions(VectorView<RHIBufferTransition> bufferTransitions);
+
+    void ApplyTextureTransitions(VectorView<RHITextureTransition> textureTransitions);
+
+    // the usage this list left the resource in, expectedUsage if the list has not touched it yet
+    RHIBufferUsage GetTrackedUsage(NullBuffer* pBuffer, RHIBufferUsage expectedUsage);
+
+    RHITextureUsage GetTrackedUsage(NullTexture* pTexture, RHITextureUsage expectedUsage);
+
+    void SetTrackedUsage(NullBuffer* pBuffer, RHIBufferUsage usage);
+
+    void SetTrackedUsage(NullTexture* pTexture, RHITextureUsage usage);
+
+    RHICommandContextType m_contextType;
+    NullRHI* m_pRHI{nullptr};
+    HeapVector<NullCommandRecord> m_records;
+    NullResourceUsages m_usages;
+
+    bool m_insideRendering{false};
+    const NullPipeline* m_pBoundPipeline{nullptr};
+};
+} // namespace zen
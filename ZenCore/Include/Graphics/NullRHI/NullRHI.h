@@ -0,0 +1,226 @@
+#pragma once
+#include "Graphics/RHI/DynamicRHI.h"
+#include "Graphics/RHI/RHIDebug.h"
+#include "Graphics/NullRHI/NullCommandContext.h"
+#include "Templates/HashMap.h"
+#include "Utils/Mutex.h"
+#include <atomic>
+
+namespace zen
+{
+// A headless RHI without a GPU. Resources are plain host objects, command lists are replayed
+// into NullCommandContexts that validate every call and log it. Submitted lists end up in one
+// log that tests can inspect, validation errors are collected instead of crashing a driver.
+class NullRHI : public DynamicRHI
+{
+public:
+    NullRHI();
+
+    ~NullRHI() override = default;
+
+    void Init() override;
+
+    void Destroy() override;
+
+    IRHICommandContext* GetCommandContext(RHICommandContextType contextType) override;
+
+    IRHICommandContext* GetTransferCommandContext() override;
+
+    // the legacy immediate path is Vulkan only
+    LegacyRHICommandListContext* CreateLegacyCmdListContext() override
+    {
+        return nullptr;
+    }
+
+    void WaitForLegacyCommandList(LegacyRHICommandList* pCmdList) override {}
+
+    LegacyRHICommandList* GetLegacyImmediateCommandList() override
+    {
+        return nullptr;
+    }
+
+    RHIAPIType GetAPIType() override
+    {
+        return RHIAPIType::eNull;
+    }
+
+    const char* GetName() override
+    {
+        return "Null";
+    }
+
+    DataFormat GetSupportedDepthFormat() override
+    {
+        return DataFormat::eD32SFloatS8UInt;
+    }
+
+    RHIViewport* CreateViewport(void* pWindow,
+                                uint32_t width,
+                                uint32_t height,
+                                bool enableVSync) override;
+
+    void DestroyViewport(RHIViewport* pViewport) override;
+
+    void BeginDrawingViewport(RHIViewport* pViewport) override;
+
+    void EndDrawingViewport(RHIViewport* pViewport,
+                            LegacyRHICommandListContext* pCmdListContext,
+                            bool present) override;
+
+    void EndDrawingViewport(RHIViewport* pViewportRHI,
+                            RHICommandList* pCmdList,
+                            bool present) override;
+
+    RHIShader* CreateShader(const RHIShaderCreateInfo& createInfo) override;
+
+    void DestroyShader(RHIShader* pShader) override;
+
+    RHIPipeline* CreatePipeline(const RHIComputePipelineCreateInfo& createInfo) override;
+
+    RHIPipeline* CreatePipeline(const RHIGfxPipelineCreateInfo& createInfo) override;
+
+    void DestroyPipeline(RHIPipeline* pPipeline) override;
+
+    RHISampler* CreateSampler(const RHISamplerCreateInfo& createInfo) override;
+
+    void DestroySampler(RHISampler* pSampler) override;
+
+    RHITexture* CreateTexture(const RHITextureCreateInfo& createInfo) override;
+
+    RHITexture* CreateTextureProxy(const RHITexture* pBaseTexture,
+                                   const RHITextureProxyCreateInfo& proxyInfo) override;
+
+    void DestroyTexture(RHITexture* pTexture) override;
+
+    RHIBuffer* CreateBuffer(const RHIBufferCreateInfo& createInfo) override;
+
+    void DestroyBuffer(RHIBuffer* pBuffer) override;
+
+    RHIMemoryBlock* CreateMemoryBlock(const RHIMemoryRequirements& requirements) override;
+
+    void DestroyMemoryBlock(RHIMemoryBlock* pMemoryBlock) override;
+
+    void BindTextureMemory(RHITexture* pTexture,
+                           RHIMemoryBlock* pMemoryBlock,
+                           uint64_t offset) override;
+
+    void BindBufferMemory(RHIBuffer* pBuffer,
+                          RHIMemoryBlock* pMemoryBlock,
+                          uint64_t offset) override;
+
+    void DestroyDescriptorSet(RHIDescriptorSet* pDescriptorSet) override;
+
+    RHIPlatformCommandList* FinalizeCommandList(RHICommandList* pCmdList) override;
+
+    void FinalizeCommandLists(VectorView<RHICommandList*> cmdLists,
+                              HeapVector<RHIPlatformCommandList*>& outCommandLists) override;
+
+    void SubmitPlatformCommandLists(VectorView<RHIPlatformCommandList*> commandLists) override;
+
+    void SubmitAllGPUCommands() override {}
+
+    void WaitDeviceIdle() override {}
+
+    const RHIGPUInfo& QueryGPUInfo() const override
+    {
+        return m_gpuInfo;
+    }
+
+    // lets tests turn optional features off
+    void SetGPUInfo(const RHIGPUInfo& gpuInfo)
+    {
+        m_gpuInfo = gpuInfo;
+    }
+
+    // everything submitted so far, in submission order
+    const HeapVector<NullCommandRecord>& GetSubmittedRecords() const
+    {
+        return m_submittedRecords;
+    }
+
+    uint32_t GetNumSubmittedRecords(NullCommandType type) const;
+
+    void ClearSubmittedRecords()
+    {
+        m_submittedRecords.clear();
+    }
+
+    HeapVector<std::string> GetValidationErrors() const;
+
+    void ClearValidationErrors();
+
+    void ReportError(const std::string& message);
+
+    // resources register themselves while they are alive, so contexts can detect use after
+    // destroy and tests can detect leaks
+    void RegisterResource(const RHIResource* pResource, RHIResourceType type);
+
+    void UnregisterResource(const RHIResource* pResource);
+
+    bool IsResourceAlive(const RHIResource* pResource) const;
+
+    uint32_t GetNumLiveResources(RHIResourceType type) const;
+
+    // total number of resources of type created since Init
+    uint32_t GetNumCreatedResources(RHIResourceType type) const;
+
+    uint64_t AllocBarrierEventHandle()
+    {
+        return ++m_lastBarrierEventHandle;
+    }
+
+private:
+    // checks the usages the list expects against the resources and moves them to the final ones
+    void ApplyResourceUsages(const NullResourceUsages& usages);
+
+    void SubmitRecords(HeapVector<NullCommandRecord>& records);
+
+    RHIGPUInfo m_gpuInfo{};
+
+    RHIViewport* m_pCurrentViewport{nullptr};
+
+    HeapVector<NullCommandRecord> m_submittedRecords;
+
+    mutable Mutex m_resourceMutex;
+    HashMap<const RHIResource*, RHIResourceType> m_liveResources;
+    uint32_t m_numCreatedResources[ToUnderlying(RHIResourceType::eMax)]{};
+
+    mutable Mutex m_errorMutex;
+    HeapVector<std::string> m_validationErrors;
+
+    std::atomic<uint64_t> m_lastBarrierEventHandle{0};
+};
+
+class NullResourceFactory : public RHIResourceFactory
+{
+public:
+    RHIBuffer* CreateBuffer(const RHIBufferCreateInfo& createInfo) final;
+
+    RHITexture* CreateTexture(const RHITextureCreateInfo& createInfo) final;
+
+    RHISampler* CreateSampler(const RHISamplerCreateInfo& createInfo) final;
+
+    RHIShader* CreateShader(const RHIShaderCreateInfo& createInfo) final;
+
+    RHIPipeline* CreatePipeline(const RHIComputePipelineCreateInfo& createInfo) final;
+
+    RHIPipeline* CreatePipeline(const RHIGfxPipelineCreateInfo& createInfo) final;
+};
+
+class NullRHIDebug : public RHIDebug
+{
+public:
+    NullRHIDebug() = default;
+
+    void SetPipelineDebugName(RHIPipeline* pPipelineHandle, const std::string& debugName) final
+    {}
+
+    void SetTextureDebugName(RHITexture* pTexture, const std::string& debugName) final {}
+
+    void SetDescriptorSetDebugName(RHIDescriptorSet* pDescriptorSetHandle,
+                                   const std::string& debugName) final
+    {}
+};
+
+extern NullRHI* GNullRHI;
+} // namespace zen
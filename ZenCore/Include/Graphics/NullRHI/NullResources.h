@@ -0,0 +1,343 @@
+#pragma once
+#include "Graphics/RHI/RHIResource.h"
+
+namespace zen
+{
+class NullMemoryBlock;
+
+// resources of the null RHI own no GPU objects, they keep what the command context needs to
+// validate their use: the usage they were last transitioned to and, for transient resources,
+// the memory they are bound to
+
+class NullBuffer : public RHIBuffer
+{
+public:
+    static NullBuffer* CreateObject(const RHIBufferCreateInfo& createInfo);
+
+    uint8_t* Map() override;
+
+    void Unmap() override;
+
+    void SetTexelFormat(DataFormat format) override;
+
+    bool IsMapped() const
+    {
+        return m_pMappedData != nullptr;
+    }
+
+    // transient buffers are unusable until their memory is bound
+    bool HasMemory() const
+    {
+        return !m_transient || m_pMemoryBlock != nullptr;
+    }
+
+    const NullMemoryBlock* GetMemoryBlock() const
+    {
+        return m_pMemoryBlock;
+    }
+
+    uint64_t GetMemoryOffset() const
+    {
+        return m_memoryOffset;
+    }
+
+    // transient buffers only
+    void BindMemory(const NullMemoryBlock* pMemoryBlock, uint64_t offset);
+
+    // RHIBufferUsage::eMax when the buffer was never transitioned as a whole
+    RHIBufferUsage GetTrackedUsage() const
+    {
+        return m_trackedUsage;
+    }
+
+    void SetTrackedUsage(RHIBufferUsage usage)
+    {
+        m_trackedUsage = usage;
+    }
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    explicit NullBuffer(const RHIBufferCreateInfo& createInfo) : RHIBuffer(createInfo) {}
+
+    // host memory that Map hands out, so uploads through the null RHI still write somewhere
+    uint8_t* m_pMappedData{nullptr};
+    const NullMemoryBlock* m_pMemoryBlock{nullptr};
+    uint64_t m_memoryOffset{0};
+    RHIBufferUsage m_trackedUsage{RHIBufferUsage::eMax};
+};
+
+class NullTexture : public RHITexture
+{
+public:
+    static NullTexture* CreateObject(const RHITextureCreateInfo& createInfo);
+
+    static NullTexture* CreateProxyObject(const NullTexture* pBaseTexture,
+                                          const RHITextureProxyCreateInfo& proxyInfo);
+
+    bool IsProxy() const
+    {
+        return m_isProxy;
+    }
+
+    bool HasMemory() const;
+
+    const NullMemoryBlock* GetMemoryBlock() const
+    {
+        return m_pMemoryBlock;
+    }
+
+    uint64_t GetMemoryOffset() const
+    {
+        return m_memoryOffset;
+    }
+
+    // transient textures only
+    void BindMemory(const NullMemoryBlock* pMemoryBlock, uint64_t offset);
+
+    // RHITextureUsage::eMax when the texture was never transitioned as a whole
+    RHITextureUsage GetTrackedUsage() const
+    {
+        return m_trackedUsage;
+    }
+
+    void SetTrackedUsage(RHITextureUsage usage)
+    {
+        m_trackedUsage = usage;
+    }
+
+    bool CoversWholeTexture(const RHITextureSubResourceRange& range) const
+    {
+        return range.baseMipLevel == 0 && range.levelCount >= m_subResourceRange.levelCount &&
+            range.baseArrayLayer == 0 && range.layerCount >= m_subResourceRange.layerCount;
+    }
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    explicit NullTexture(const RHITextureCreateInfo& createInfo) : RHITexture(createInfo) {}
+
+    NullTexture(const NullTexture* pBaseTexture, const RHITextureProxyCreateInfo& proxyInfo) :
+        RHITexture(pBaseTexture, proxyInfo)
+    {}
+
+    const NullMemoryBlock* m_pMemoryBlock{nullptr};
+    uint64_t m_memoryOffset{0};
+    RHITextureUsage m_trackedUsage{RHITextureUsage::eMax};
+};
+
+class NullSampler : public RHISampler
+{
+public:
+    static NullSampler* CreateObject(const RHISamplerCreateInfo& createInfo);
+
+    const RHISamplerCreateInfo& GetBaseInfo() const
+    {
+        return m_baseInfo;
+    }
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    explicit NullSampler(const RHISamplerCreateInfo& createInfo) : RHISampler(createInfo) {}
+};
+
+class NullShader : public RHIShader
+{
+public:
+    static NullShader* CreateObject(const RHIShaderCreateInfo& createInfo);
+
+    RHIDescriptorSet* CreateDescriptorSet(uint32_t setIndex) override;
+
+    const RHIShaderResourceDescriptorTable& GetSRDTable() const
+    {
+        return m_SRDTable;
+    }
+
+    // nullptr if the shader does not declare set/binding
+    const RHIShaderResourceDescriptor* FindDescriptor(uint32_t setIndex, uint32_t binding) const;
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    explicit NullShader(const RHIShaderCreateInfo& createInfo) : RHIShader(createInfo) {}
+};
+
+class NullDescriptorSet : public RHIDescriptorSet
+{
+public:
+    // bindings are validated against the reflected layout of the shader
+    void Update(const HeapVector<RHIShaderResourceBinding>& resourceBindings) override;
+
+    const RHIShader* GetShader() const
+    {
+        return m_pShader;
+    }
+
+    uint32_t GetSetIndex() const
+    {
+        return m_setIndex;
+    }
+
+    const HeapVector<RHIShaderResourceBinding>& GetBindings() const
+    {
+        return m_bindings;
+    }
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    NullDescriptorSet(const RHIShader* pShader, uint32_t setIndex) :
+        RHIDescriptorSet(pShader, setIndex)
+    {}
+
+    HeapVector<RHIShaderResourceBinding> m_bindings;
+
+    friend class NullShader;
+};
+
+class NullPipeline : public RHIPipeline
+{
+public:
+    static NullPipeline* CreateObject(const RHIGfxPipelineCreateInfo& createInfo);
+
+    static NullPipeline* CreateObject(const RHIComputePipelineCreateInfo& createInfo);
+
+    RHIPipelineType GetPipelineType() const
+    {
+        return m_type;
+    }
+
+    const RHIShader* GetShader() const
+    {
+        return m_pShader;
+    }
+
+    const RHIGfxPipelineStates& GetGfxStates() const
+    {
+        return m_gfxStates;
+    }
+
+    // graphics pipelines only
+    const RHIRenderingLayout* GetRenderingLayout() const
+    {
+        return m_pRenderingLayout;
+    }
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    explicit NullPipeline(const RHIGfxPipelineCreateInfo& createInfo) : RHIPipeline(createInfo) {}
+
+    explicit NullPipeline(const RHIComputePipelineCreateInfo& createInfo) :
+        RHIPipeline(createInfo)
+    {}
+};
+
+class NullMemoryBlock : public RHIMemoryBlock
+{
+public:
+    static NullMemoryBlock* CreateObject(const RHIMemoryRequirements& requirements);
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    explicit NullMemoryBlock(const RHIMemoryRequirements& requirements) :
+        RHIMemoryBlock(requirements)
+    {}
+};
+
+// a swapchain without a window, the back buffers are plain null textures
+class NullViewport : public RHIViewport
+{
+public:
+    static NullViewport* CreateObject(void* pWindow,
+                                      uint32_t width,
+                                      uint32_t height,
+                                      bool enableVSync);
+
+    uint32_t GetWidth() const override
+    {
+        return m_width;
+    }
+
+    uint32_t GetHeight() const override
+    {
+        return m_height;
+    }
+
+    void WaitForFrameCompletion() override {}
+
+    void IssueFrameEvent() override {}
+
+    DataFormat GetSwapchainFormat() override
+    {
+        return DataFormat::eR8G8B8A8UNORM;
+    }
+
+    DataFormat GetDepthStencilFormat() override
+    {
+        return DataFormat::eD32SFloatS8UInt;
+    }
+
+    RHITexture* GetColorBackBuffer() override
+    {
+        return m_pColorBackBuffer;
+    }
+
+    RHITextureSubResourceRange GetColorBackBufferRange() override
+    {
+        return m_pColorBackBuffer->GetSubResourceRange();
+    }
+
+    RHITexture* GetDepthStencilBackBuffer() override
+    {
+        return m_pDepthStencilBackBuffer;
+    }
+
+    RHITextureSubResourceRange GetDepthStencilBackBufferRange() override
+    {
+        return m_pDepthStencilBackBuffer->GetSubResourceRange();
+    }
+
+    void Resize(uint32_t width, uint32_t height) override;
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    NullViewport(void* pWindow, uint32_t width, uint32_t height, bool enableVSync) :
+        RHIViewport(pWindow, width, height, enableVSync)
+    {}
+
+    void CreateBackBuffers();
+
+    void DestroyBackBuffers();
+
+    NullTexture* m_pColorBackBuffer{nullptr};
+    NullTexture* m_pDepthStencilBackBuffer{nullptr};
+};
+} // namespace zen
@@ -7,6 +7,7 @@ namespace zen
 {
 class LegacyRHICommandList;
 class LegacyRHICommandListContext;
+class RHIShaderReflectionCache;
 
 class DynamicRHI
 {
@@ -122,6 +123,20 @@ public:
     virtual RHIBuffer* CreateBuffer(const RHIBufferCreateInfo& createInfo) = 0;
 
     virtual void DestroyBuffer(RHIBuffer* pBuffer) = 0;
+
+    // GPU only memory for transient resources, the block must outlive everything bound to it
+    virtual RHIMemoryBlock* CreateMemoryBlock(const RHIMemoryRequirements& requirements) = 0;
+
+    virtual void DestroyMemoryBlock(RHIMemoryBlock* pMemoryBlock) = 0;
+
+    // binds a transient texture at offset into pMemoryBlock, its views are created here
+    virtual void BindTextureMemory(RHITexture* pTexture,
+                                   RHIMemoryBlock* pMemoryBlock,
+                                   uint64_t offset) = 0;
+
+    virtual void BindBufferMemory(RHIBuffer* pBuffer,
+                                  RHIMemoryBlock* pMemoryBlock,
+                                  uint64_t offset) = 0;
     //
     // virtual uint8_t* MapBuffer(BufferHandle bufferHandle) = 0;
     //
@@ -139,6 +154,11 @@ public:
     //     DescriptorSetHandle descriptorSetHandle,
     //     const std::vector<RHIShaderResourceBinding>& resourceBindings) = 0;
 
+    // replays pCmdList into its context, returns nullptr if nothing was recorded. Lists with
+    // different contexts can be finalized on different threads, the submission order is still
+    // the order of SubmitPlatformCommandLists
+    virtual RHIPlatformCommandList* FinalizeCommandList(RHICommandList* pCmdList) = 0;
+
     virtual void FinalizeCommandLists(VectorView<RHICommandList*> cmdLists,
                                       HeapVector<RHIPlatformCommandList*>& outCommandLists) = 0;
 
@@ -155,9 +175,17 @@ public:
         return m_pResourceFactory;
     }
 
+    // shared by every shader the backend creates, persisted across runs
+    RHIShaderReflectionCache* GetShaderReflectionCache() const
+    {
+        return m_pShaderReflectionCache;
+    }
+
 protected:
     RHIResourceFactory* m_pResourceFactory{nullptr};
 
+    RHIShaderReflectionCache* m_pShaderReflectionCache{nullptr};
+
     LegacyRHICommandListContext* m_pLegacyImmediateContext{nullptr};
     LegacyRHICommandList* m_pLegacyImmediateCommandList{nullptr};
 
@@ -21,12 +21,48 @@ public:
     virtual ~RHIPlatformCommandList() = default;
 };
 
+// tags the recorded commands, RHICommandListBase::Execute switches on it instead of going
+// through a vtable
+enum class RHICommandType : uint32_t
+{
+    eClearBuffer,
+    eCopyBuffer,
+    eClearTexture,
+    eCopyTexture,
+    eCopyBufferToTexture,
+    eCopyTextureToBuffer,
+    eResolveTexture,
+    eBeginRendering,
+    eEndRendering,
+    eBindPipeline,
+    eSetScissor,
+    eSetViewport,
+    eSetDepthBias,
+    eSetLineWidth,
+    eSetBlendConstants,
+    eBindVertexBuffer,
+    eBindVertexBuffers,
+    eDraw,
+    eDrawIndexed,
+    eDrawIndexedIndirect,
+    eDrawIndexedIndirectCount,
+    eDispatch,
+    eDispatchIndirect,
+    eSetPushConstants,
+    eAddTransitions,
+    eSetBarrierEvent,
+    eWaitBarrierEvent,
+    eAddTextureTransition,
+    eGenTextureMipmaps,
+    eMax
+};
+
+// commands are plain structs placed back to back in the list's linear allocator, they are
+// dropped with the allocator and never destroyed one by one
 struct RHICommandBase
 {
     RHICommandBase* pNextCmd{nullptr};
-    void (*pDestroy)(RHICommandBase*){nullptr};
-
-    virtual ~RHICommandBase() {}
+    RHICommandType type{RHICommandType::eMax};
 };
 
 enum class RHICommandContextType : uint32_t
@@ -91,6 +127,17 @@ public:
                                         uint32_t drawCount,
                                         uint32_t stride) = 0;
 
+    // draw count is read from pCountBuffer at countBufferOffset, clamped to maxDrawCount
+    virtual void RHIDrawIndexedIndirectCount(RHIBuffer* pIndirectBuffer,
+                                             RHIBuffer* pIndexBuffer,
+                                             DataFormat indexFormat,
+                                             uint32_t indexBufferOffset,
+                                             uint32_t offset,
+                                             RHIBuffer* pCountBuffer,
+                                             uint32_t countBufferOffset,
+                                             uint32_t maxDrawCount,
+                                             uint32_t stride) = 0;
+
     virtual void RHIDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) = 0;
 
     virtual void RHIDispatchIndirect(RHIBuffer* pIndirectBuffer, uint32_t offset) = 0;
@@ -103,6 +150,17 @@ public:
                                    VectorView<RHIBufferTransition> bufferTransitions,
                                    VectorView<RHITextureTransition> textureTransitions) = 0;
 
+    // starts the transitions once the work recorded so far reaches srcStages, the work between
+    // the set and RHIWaitBarrierEvent does not wait for them
+    virtual void RHISetBarrierEvent(RHIBarrierEvent* pEvent,
+                                    BitField<RHIPipelineStageBits> srcStages,
+                                    BitField<RHIPipelineStageBits> dstStages,
+                                    VectorView<RHIBufferTransition> bufferTransitions,
+                                    VectorView<RHITextureTransition> textureTransitions) = 0;
+
+    // the work recorded from here on waits for the transitions of pEvent at their dstStages
+    virtual void RHIWaitBarrierEvent(RHIBarrierEvent* pEvent) = 0;
+
     virtual void RHIGenTextureMipmaps(RHITexture* pTexture) = 0;
 
     virtual void RHIAddTextureTransition(RHITexture* pTexture, RHITextureLayout newLayout) = 0;
@@ -174,11 +232,8 @@ public:
     template <typename T, typename... Args> T* AllocateCmdTyped(Args&&... args)
     {
         static_assert(std::is_base_of_v<RHICommandBase, T>, "T must derive from RHICommandBase");
-        T* pCmd        = new (AllocateCmd(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
-        pCmd->pDestroy = [](RHICommandBase* pBase) {
-            static_cast<T*>(pBase)->~T();
-        };
-        return pCmd;
+        static_assert(std::is_trivially_destructible_v<T>, "commands are never destroyed");
+        return new (AllocateCmd(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
     }
 
     template <typename T> T* AllocateCmdData(size_t count)
@@ -207,12 +262,34 @@ public:
 
     void Reset();
 
+    uint32_t GetNumCommands() const
+    {
+        return m_numCommands;
+    }
+
+    // state commands dropped while recording because they matched the bound state
+    uint32_t GetNumSkippedCommands() const
+    {
+        return m_numSkippedCommands;
+    }
+
 protected:
     RHICommandListBase() : m_cmdAllocator(64 * 1024)
     {
         m_ppCmdPtr = &m_pCmdHead;
     }
 
+    // true if binding pPipeline with these sets changes nothing, records them as bound otherwise
+    bool IsPipelineBound(RHIPipeline* pPipeline,
+                         uint32_t numDescriptorSets,
+                         RHIDescriptorSet* const* pDescriptorSets);
+
+    // true if the same constants were pushed for pPipeline since it was bound
+    bool ArePushConstantsSet(RHIPipeline* pPipeline, VectorView<uint8_t> data) const;
+
+    // forgets the bound state, the next bind and push are always recorded
+    void InvalidateBoundState();
+
     RHICommandBase* m_pCmdHead{nullptr};
     RHICommandBase** m_ppCmdPtr{nullptr};
 
@@ -220,17 +297,28 @@ protected:
     IRHICommandContext* m_pComputeContext{nullptr};
 
     uint32_t m_numCommands{0};
+    uint32_t m_numSkippedCommands{0};
     PoolAllocator<LinearAllocator> m_cmdAllocator;
+
+    // the state the recorded commands leave behind. Both RHI backends keep pipelines and
+    // descriptor sets bound until the next bind, so binding the same ones again is redundant
+    RHIPipeline* m_pBoundPipeline{nullptr};
+    uint32_t m_numBoundDescriptorSets{0};
+    RHIDescriptorSet* m_boundDescriptorSets[MAX_NUM_DESCRIPTOR_SETS]{};
+    // points into the recorded SetPushConstants command
+    RHIPipeline* m_pPushConstantsPipeline{nullptr};
+    VectorView<uint8_t> m_pushConstants;
 };
 
-struct RHICommand : public RHICommandBase
+template <RHICommandType Type> struct RHICommand : public RHICommandBase
 {
-    virtual ~RHICommand() {};
-
-    virtual void Execute(RHICommandListBase& cmdList) = 0;
+    RHICommand()
+    {
+        type = Type;
+    }
 };
 
-struct RHICommandClearBuffer : public RHICommand
+struct RHICommandClearBuffer : public RHICommand<RHICommandType::eClearBuffer>
 {
     RHIBuffer* pBuffer;
     uint32_t offset;
@@ -240,13 +328,13 @@ struct RHICommandClearBuffer : public RHICommand
         pBuffer(pBuffer), offset(offset), size(size)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIClearBuffer(pBuffer, offset, size);
+        pContext->RHIClearBuffer(pBuffer, offset, size);
     }
 };
 
-struct RHICommandCopyBuffer : public RHICommand
+struct RHICommandCopyBuffer : public RHICommand<RHICommandType::eCopyBuffer>
 {
     RHIBuffer* pSrcBuffer;
     RHIBuffer* pDstBuffer;
@@ -258,13 +346,13 @@ struct RHICommandCopyBuffer : public RHICommand
         pSrcBuffer(pSrcBuffer), pDstBuffer(pDstBuffer), copyRegion(region)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHICopyBuffer(pSrcBuffer, pDstBuffer, copyRegion);
+        pContext->RHICopyBuffer(pSrcBuffer, pDstBuffer, copyRegion);
     }
 };
 
-struct RHICommandClearTexture : public RHICommand
+struct RHICommandClearTexture : public RHICommand<RHICommandType::eClearTexture>
 {
     RHITexture* pTexture;
     Color clearColor;
@@ -276,13 +364,13 @@ struct RHICommandClearTexture : public RHICommand
         pTexture(pTexture), clearColor(color), range(range)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIClearTexture(pTexture, clearColor, range);
+        pContext->RHIClearTexture(pTexture, clearColor, range);
     }
 };
 
-struct RHICommandCopyTexture : public RHICommand
+struct RHICommandCopyTexture : public RHICommand<RHICommandType::eCopyTexture>
 {
     RHITexture* pSrcTexture;
     RHITexture* pDstTexture;
@@ -295,13 +383,13 @@ struct RHICommandCopyTexture : public RHICommand
         pSrcTexture(pSrcTexture), pDstTexture(pDstTexture)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHICopyTexture(pSrcTexture, pDstTexture, copyRegions);
+        pContext->RHICopyTexture(pSrcTexture, pDstTexture, copyRegions);
     }
 };
 
-struct RHICommandCopyBufferToTexture : public RHICommand
+struct RHICommandCopyBufferToTexture : public RHICommand<RHICommandType::eCopyBufferToTexture>
 {
     RHIBuffer* pSrcBuffer;
     RHITexture* pDstTexture;
@@ -314,13 +402,13 @@ struct RHICommandCopyBufferToTexture : public RHICommand
         pSrcBuffer(pSrcBuffer), pDstTexture(pDstTexture)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHICopyBufferToTexture(pSrcBuffer, pDstTexture, copyRegions);
+        pContext->RHICopyBufferToTexture(pSrcBuffer, pDstTexture, copyRegions);
     }
 };
 
-struct RHICommandCopyTextureToBuffer : public RHICommand
+struct RHICommandCopyTextureToBuffer : public RHICommand<RHICommandType::eCopyTextureToBuffer>
 {
     RHITexture* pSrcTexture;
     RHIBuffer* pDstBuffer;
@@ -330,13 +418,13 @@ struct RHICommandCopyTextureToBuffer : public RHICommand
         pSrcTexture(pSrcTexture), pDstBuffer(pDstBuffer)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHICopyTextureToBuffer(pSrcTexture, pDstBuffer, copyRegions);
+        pContext->RHICopyTextureToBuffer(pSrcTexture, pDstBuffer, copyRegions);
     }
 };
 
-struct RHICommandResolveTexture : public RHICommand
+struct RHICommandResolveTexture : public RHICommand<RHICommandType::eResolveTexture>
 {
     RHITexture* pSrcTexture;
     RHITexture* pDstTexture;
@@ -359,14 +447,14 @@ struct RHICommandResolveTexture : public RHICommand
         dstMipmap(dstMipmap)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIResolveTexture(pSrcTexture, pDstTexture, srcLayer, srcMipmap,
-                                                dstLayer, dstMipmap);
+        pContext->RHIResolveTexture(pSrcTexture, pDstTexture, srcLayer, srcMipmap,
+                                    dstLayer, dstMipmap);
     }
 };
 
-struct RHICommandBeginRendering final : public RHICommand
+struct RHICommandBeginRendering final : public RHICommand<RHICommandType::eBeginRendering>
 {
     const RHIRenderingLayout* pRenderingLayout;
 
@@ -374,21 +462,21 @@ struct RHICommandBeginRendering final : public RHICommand
         pRenderingLayout(pRenderingLayout)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIBeginRendering(pRenderingLayout);
+        pContext->RHIBeginRendering(pRenderingLayout);
     }
 };
 
-struct RHICommandEndRendering final : public RHICommand
+struct RHICommandEndRendering final : public RHICommand<RHICommandType::eEndRendering>
 {
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIEndRendering();
+        pContext->RHIEndRendering();
     }
 };
 
-struct RHICommandBindPipeline final : public RHICommand
+struct RHICommandBindPipeline final : public RHICommand<RHICommandType::eBindPipeline>
 {
     RHIPipelineType pipelineType;
     RHIPipeline* pPipeline;
@@ -405,13 +493,13 @@ struct RHICommandBindPipeline final : public RHICommand
         pDescriptorSets(pDescriptorSets)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIBindPipeline(pPipeline, numDescriptorSets, pDescriptorSets);
+        pContext->RHIBindPipeline(pPipeline, numDescriptorSets, pDescriptorSets);
     }
 };
 
-struct RHICommandSetScissor final : public RHICommand
+struct RHICommandSetScissor final : public RHICommand<RHICommandType::eSetScissor>
 {
     uint32_t minX;
     uint32_t minY;
@@ -422,13 +510,13 @@ struct RHICommandSetScissor final : public RHICommand
         minX(minX), minY(minY), maxX(maxX), maxY(maxY)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHISetScissor(minX, minY, maxX, maxY);
+        pContext->RHISetScissor(minX, minY, maxX, maxY);
     }
 };
 
-struct RHICommandSetViewport final : public RHICommand
+struct RHICommandSetViewport final : public RHICommand<RHICommandType::eSetViewport>
 {
     uint32_t minX;
     uint32_t minY;
@@ -439,13 +527,13 @@ struct RHICommandSetViewport final : public RHICommand
         minX(minX), minY(minY), maxX(maxX), maxY(maxY)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHISetViewport(minX, minY, maxX, maxY);
+        pContext->RHISetViewport(minX, minY, maxX, maxY);
     }
 };
 
-struct RHICommandSetDepthBias : public RHICommand
+struct RHICommandSetDepthBias : public RHICommand<RHICommandType::eSetDepthBias>
 {
     float depthBiasConstantFactor;
     float depthBiasClamp;
@@ -459,26 +547,26 @@ struct RHICommandSetDepthBias : public RHICommand
         depthBiasSlopeFactor(depthBiasSlopeFactor)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHISetDepthBias(depthBiasConstantFactor, depthBiasClamp,
-                                              depthBiasSlopeFactor);
+        pContext->RHISetDepthBias(depthBiasConstantFactor, depthBiasClamp,
+                                  depthBiasSlopeFactor);
     }
 };
 
-struct RHICommandSetLineWidth : public RHICommand
+struct RHICommandSetLineWidth : public RHICommand<RHICommandType::eSetLineWidth>
 {
     float lineWidth;
 
     explicit RHICommandSetLineWidth(float lineWidth) : lineWidth(lineWidth) {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHISetLineWidth(lineWidth);
+        pContext->RHISetLineWidth(lineWidth);
     }
 };
 
-struct RHICommandSetBlendConstants : public RHICommand
+struct RHICommandSetBlendConstants : public RHICommand<RHICommandType::eSetBlendConstants>
 {
     Color blendConstants;
 
@@ -486,13 +574,13 @@ struct RHICommandSetBlendConstants : public RHICommand
         blendConstants(std::move(blendConstants))
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHISetBlendConstants(blendConstants);
+        pContext->RHISetBlendConstants(blendConstants);
     }
 };
 
-struct RHICommandBindVertexBuffer final : public RHICommand
+struct RHICommandBindVertexBuffer final : public RHICommand<RHICommandType::eBindVertexBuffer>
 {
     RHIBuffer* pVertexBuffer;
     uint64_t offset;
@@ -501,26 +589,26 @@ struct RHICommandBindVertexBuffer final : public RHICommand
         pVertexBuffer(pVertexBuffer), offset(offset)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIBindVertexBuffer(pVertexBuffer, offset);
+        pContext->RHIBindVertexBuffer(pVertexBuffer, offset);
     }
 };
 
-struct RHICommandBindVertexBuffers final : public RHICommand
+struct RHICommandBindVertexBuffers final : public RHICommand<RHICommandType::eBindVertexBuffers>
 {
     VectorView<RHIBuffer*> vertexBuffers;
     VectorView<uint64_t> offsets;
 
     RHICommandBindVertexBuffers() = default;
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIBindVertexBuffers(vertexBuffers, offsets);
+        pContext->RHIBindVertexBuffers(vertexBuffers, offsets);
     }
 };
 
-struct RHICommandDraw final : public RHICommand
+struct RHICommandDraw final : public RHICommand<RHICommandType::eDraw>
 {
     uint32_t vertexCount;
     uint32_t instanceCount;
@@ -537,13 +625,13 @@ struct RHICommandDraw final : public RHICommand
         firstInstance(firstInstance)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIDraw(vertexCount, instanceCount, firstVertex, firstInstance);
+        pContext->RHIDraw(vertexCount, instanceCount, firstVertex, firstInstance);
     }
 };
 
-struct RHICommandDrawIndexed final : public RHICommand
+struct RHICommandDrawIndexed final : public RHICommand<RHICommandType::eDrawIndexed>
 {
     struct Param
     {
@@ -578,15 +666,15 @@ struct RHICommandDrawIndexed final : public RHICommand
         firstInstance(param.firstInstance)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIDrawIndexed(pIndexBuffer, indexFormat, indexBufferOffset,
-                                             indexCount, instanceCount, firstIndex, vertexOffset,
-                                             firstInstance);
+        pContext->RHIDrawIndexed(pIndexBuffer, indexFormat, indexBufferOffset,
+                                 indexCount, instanceCount, firstIndex, vertexOffset,
+                                 firstInstance);
     }
 };
 
-struct RHICommandDrawIndexedIndirect final : public RHICommand
+struct RHICommandDrawIndexedIndirect final : public RHICommand<RHICommandType::eDrawIndexedIndirect>
 {
     struct Param
     {
@@ -617,14 +705,60 @@ struct RHICommandDrawIndexedIndirect final : public RHICommand
         stride(param.stride)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIDrawIndexedIndirect(pIndirectBuffer, pIndexBuffer, indexFormat,
-                                                     indexBufferOffset, offset, drawCount, stride);
+        pContext->RHIDrawIndexedIndirect(pIndirectBuffer, pIndexBuffer, indexFormat,
+                                         indexBufferOffset, offset, drawCount, stride);
     }
 };
 
-struct RHICommandDispatch final : public RHICommand
+struct RHICommandDrawIndexedIndirectCount final
+    : public RHICommand<RHICommandType::eDrawIndexedIndirectCount>
+{
+    struct Param
+    {
+        RHIBuffer* pIndirectBuffer;
+        RHIBuffer* pIndexBuffer;
+        DataFormat indexFormat;
+        uint32_t indexBufferOffset;
+        uint32_t offset;
+        RHIBuffer* pCountBuffer;
+        uint32_t countBufferOffset;
+        uint32_t maxDrawCount;
+        uint32_t stride;
+    };
+
+    RHIBuffer* pIndirectBuffer;
+    RHIBuffer* pIndexBuffer;
+    DataFormat indexFormat;
+    uint32_t indexBufferOffset;
+    uint32_t offset;
+    RHIBuffer* pCountBuffer;
+    uint32_t countBufferOffset;
+    uint32_t maxDrawCount;
+    uint32_t stride;
+
+    explicit RHICommandDrawIndexedIndirectCount(const Param& param) :
+        pIndirectBuffer(param.pIndirectBuffer),
+        pIndexBuffer(param.pIndexBuffer),
+        indexFormat(param.indexFormat),
+        indexBufferOffset(param.indexBufferOffset),
+        offset(param.offset),
+        pCountBuffer(param.pCountBuffer),
+        countBufferOffset(param.countBufferOffset),
+        maxDrawCount(param.maxDrawCount),
+        stride(param.stride)
+    {}
+
+    void Execute(IRHICommandContext* pContext) const
+    {
+        pContext->RHIDrawIndexedIndirectCount(pIndirectBuffer, pIndexBuffer, indexFormat,
+                                              indexBufferOffset, offset, pCountBuffer,
+                                              countBufferOffset, maxDrawCount, stride);
+    }
+};
+
+struct RHICommandDispatch final : public RHICommand<RHICommandType::eDispatch>
 {
     uint32_t groupCountX;
     uint32_t groupCountY;
@@ -634,13 +768,13 @@ struct RHICommandDispatch final : public RHICommand
         groupCountX(groupCountX), groupCountY(groupCountY), groupCountZ(groupCountZ)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIDispatch(groupCountX, groupCountY, groupCountZ);
+        pContext->RHIDispatch(groupCountX, groupCountY, groupCountZ);
     }
 };
 
-struct RHICommandDispatchIndirect final : public RHICommand
+struct RHICommandDispatchIndirect final : public RHICommand<RHICommandType::eDispatchIndirect>
 {
     RHIBuffer* pIndirectBuffer;
     uint32_t offset;
@@ -649,26 +783,26 @@ struct RHICommandDispatchIndirect final : public RHICommand
         pIndirectBuffer(pIndirectBuffer), offset(offset)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIDispatchIndirect(pIndirectBuffer, offset);
+        pContext->RHIDispatchIndirect(pIndirectBuffer, offset);
     }
 };
 
-struct RHICommandSetPushConstants final : public RHICommand
+struct RHICommandSetPushConstants final : public RHICommand<RHICommandType::eSetPushConstants>
 {
     RHIPipeline* pPipeline;
     VectorView<uint8_t> data;
 
     explicit RHICommandSetPushConstants(RHIPipeline* pPipeline) : pPipeline(pPipeline) {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHISetPushConstants(pPipeline, data);
+        pContext->RHISetPushConstants(pPipeline, data);
     }
 };
 
-struct RHICommandAddTransitions final : public RHICommand
+struct RHICommandAddTransitions final : public RHICommand<RHICommandType::eAddTransitions>
 {
     BitField<RHIPipelineStageBits> srcStages;
     BitField<RHIPipelineStageBits> dstStages;
@@ -690,14 +824,48 @@ struct RHICommandAddTransitions final : public RHICommand
         srcStages(srcStages), dstStages(dstStages)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIAddTransitions(srcStages, dstStages, memoryTransitions,
-                                                bufferTransitions, textureTransitions);
+        pContext->RHIAddTransitions(srcStages, dstStages, memoryTransitions,
+                                    bufferTransitions, textureTransitions);
     }
 };
 
-struct RHICommandAddTextureTransition : public RHICommand
+struct RHICommandSetBarrierEvent final : public RHICommand<RHICommandType::eSetBarrierEvent>
+{
+    RHIBarrierEvent* pEvent;
+    BitField<RHIPipelineStageBits> srcStages;
+    BitField<RHIPipelineStageBits> dstStages;
+
+    VectorView<RHIBufferTransition> bufferTransitions;
+    VectorView<RHITextureTransition> textureTransitions;
+
+    RHICommandSetBarrierEvent(RHIBarrierEvent* pEvent,
+                              BitField<RHIPipelineStageBits> srcStages,
+                              BitField<RHIPipelineStageBits> dstStages) :
+        pEvent(pEvent), srcStages(srcStages), dstStages(dstStages)
+    {}
+
+    void Execute(IRHICommandContext* pContext) const
+    {
+        pContext->RHISetBarrierEvent(pEvent, srcStages, dstStages, bufferTransitions,
+                                     textureTransitions);
+    }
+};
+
+struct RHICommandWaitBarrierEvent final : public RHICommand<RHICommandType::eWaitBarrierEvent>
+{
+    RHIBarrierEvent* pEvent;
+
+    explicit RHICommandWaitBarrierEvent(RHIBarrierEvent* pEvent) : pEvent(pEvent) {}
+
+    void Execute(IRHICommandContext* pContext) const
+    {
+        pContext->RHIWaitBarrierEvent(pEvent);
+    }
+};
+
+struct RHICommandAddTextureTransition : public RHICommand<RHICommandType::eAddTextureTransition>
 {
     RHITexture* pTexture;
 
@@ -707,21 +875,21 @@ struct RHICommandAddTextureTransition : public RHICommand
         pTexture(pTexture), newLayout(newLayout)
     {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIAddTextureTransition(pTexture, newLayout);
+        pContext->RHIAddTextureTransition(pTexture, newLayout);
     }
 };
 
-struct RHICommandGenTextureMipmaps : public RHICommand
+struct RHICommandGenTextureMipmaps : public RHICommand<RHICommandType::eGenTextureMipmaps>
 {
     RHITexture* pTexture;
 
     RHICommandGenTextureMipmaps(RHITexture* pTexture) : pTexture(pTexture) {}
 
-    void Execute(RHICommandListBase& cmdList) override
+    void Execute(IRHICommandContext* pContext) const
     {
-        cmdList.GetContext()->RHIGenTextureMipmaps(pTexture);
+        pContext->RHIGenTextureMipmaps(pTexture);
     }
 };
 
@@ -799,6 +967,8 @@ public:
 
     void DrawIndexedIndirect(const RHICommandDrawIndexedIndirect::Param& param);
 
+    void DrawIndexedIndirectCount(const RHICommandDrawIndexedIndirectCount::Param& param);
+
     void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
 
     void DispatchIndirect(RHIBuffer* pIndirectBuffer, uint32_t offset);
@@ -813,6 +983,16 @@ public:
 
     void AddTextureTransition(RHITexture* pTexture, RHITextureLayout newLayout);
 
+    // pEvent must stay alive until the list is submitted, the wait is recorded later on the same
+    // queue
+    void SetBarrierEvent(RHIBarrierEvent* pEvent,
+                         BitField<RHIPipelineStageBits> srcStages,
+                         BitField<RHIPipelineStageBits> dstStages,
+                         VectorView<RHIBufferTransition> bufferTransitions,
+                         VectorView<RHITextureTransition> textureTransitions);
+
+    void WaitBarrierEvent(RHIBarrierEvent* pEvent);
+
     void GenerateTextureMipmaps(RHITexture* pTexture);
     // todo: add BeginRendering/EndRendering && BeginRenderPass
 };
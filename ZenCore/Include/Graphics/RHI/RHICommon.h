@@ -28,12 +28,16 @@ class RHITexture;
 enum class RHIAPIType
 {
     eVulkan = 0,
-    eMax    = 1
+    // headless, validates and logs commands without a GPU
+    eNull = 1,
+    eMax  = 2
 };
 
 struct RHIGPUInfo
 {
     bool supportGeometryShader{false};
+    // RHIDrawIndexedIndirectCount is available
+    bool supportDrawIndirectCount{false};
     size_t uniformBufferAlignment{0};
     size_t storageBufferAlignment{0};
 };
@@ -1332,6 +1336,13 @@ inline BitField<RHIAccessFlagBits> RHIBufferUsageToAccessFlagBits(RHIBufferUsage
     return result;
 }
 
+// a split barrier, the transitions start when the event is set and finish where it is waited on
+// later in the same queue. The RHI assigns the handle when the event is set
+struct RHIBarrierEvent
+{
+    uint64_t handle{0};
+};
+
 struct RHIMemoryTransition
 {
     BitField<RHIAccessFlagBits> srcAccess;
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <string>
 
 namespace zen
 {
@@ -22,6 +23,8 @@ public:
         m_VkRHIOptions.useDynamicRendering      = true;
         m_VkRHIOptions.uploadCmdBufferSemaphore = false;
         m_VkRHIOptions.maxDescriptorSetPerPool  = 64;
+        m_VkRHIOptions.pipelineCachePath        = "vk_pipeline_cache.bin";
+        m_shaderReflectionCachePath             = "shader_reflection_cache.bin";
     }
 
     bool UseDynamicRendering() const
@@ -44,6 +47,28 @@ public:
         return m_VkRHIOptions.maxDescriptorSetPerPool;
     }
 
+    // read when the device is created, empty keeps the VkPipelineCache in memory only
+    const std::string& VKPipelineCachePath() const
+    {
+        return m_VkRHIOptions.pipelineCachePath;
+    }
+
+    void SetVKPipelineCachePath(std::string path)
+    {
+        m_VkRHIOptions.pipelineCachePath = std::move(path);
+    }
+
+    // read when the RHI is initialized, empty keeps the reflection cache in memory only
+    const std::string& ShaderReflectionCachePath() const
+    {
+        return m_shaderReflectionCachePath;
+    }
+
+    void SetShaderReflectionCachePath(std::string path)
+    {
+        m_shaderReflectionCachePath = std::move(path);
+    }
+
 private:
     // Private constructor to prevent instantiation
     RHIOptions()
@@ -56,6 +81,9 @@ private:
         bool uploadCmdBufferSemaphore;
         bool useDynamicRendering;
         uint32_t maxDescriptorSetPerPool;
+        std::string pipelineCachePath;
     } m_VkRHIOptions;
+
+    std::string m_shaderReflectionCachePath;
 };
 } // namespace zen
\ No newline at end of file
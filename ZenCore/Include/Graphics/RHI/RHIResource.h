@@ -17,7 +17,8 @@ enum class RHIResourceType : uint32_t
     eShader        = 5,
     ePipeline      = 6,
     eDescriptorSet = 7,
-    eMax           = 8
+    eMemoryBlock   = 8,
+    eMax           = 9
 };
 
 class RHIResource
@@ -342,11 +343,40 @@ protected:
     bool m_enableVSync{true};
 };
 
+struct RHIMemoryRequirements
+{
+    uint64_t size{0};
+    uint64_t alignment{1};
+    uint32_t memoryTypeBits{~0u};
+};
+
+// device memory that transient buffers and textures are placed into, several resources with
+// disjoint lifetimes can share the same range
+class RHIMemoryBlock : public RHIResource
+{
+public:
+    ~RHIMemoryBlock() override = default;
+
+    const RHIMemoryRequirements& GetRequirements() const
+    {
+        return m_requirements;
+    }
+
+protected:
+    explicit RHIMemoryBlock(const RHIMemoryRequirements& requirements) :
+        RHIResource(RHIResourceType::eMemoryBlock), m_requirements(requirements)
+    {}
+
+    RHIMemoryRequirements m_requirements{};
+};
+
 struct RHIBufferCreateInfo
 {
     uint32_t size{0};
     BitField<RHIBufferUsageFlagBits> usageFlags{0};
     RHIBufferAllocateType allocateType{RHIBufferAllocateType::eNone};
+    // created without memory, bound once with DynamicRHI::BindBufferMemory
+    bool transient{false};
     std::string tag;
 };
 
@@ -368,12 +398,24 @@ public:
         return m_requiredSize;
     }
 
+    bool IsTransient() const
+    {
+        return m_transient;
+    }
+
+    // only known for transient buffers
+    const RHIMemoryRequirements& GetMemoryRequirements() const
+    {
+        return m_memoryRequirements;
+    }
+
 protected:
     explicit RHIBuffer(const RHIBufferCreateInfo& createInfo) :
         RHIResource(RHIResourceType::eBuffer),
         m_requiredSize(createInfo.size),
         m_usageFlags(createInfo.usageFlags),
-        m_allocateType(createInfo.allocateType)
+        m_allocateType(createInfo.allocateType),
+        m_transient(createInfo.transient)
     {
         m_resourceTag = createInfo.tag;
     }
@@ -381,6 +423,8 @@ protected:
     uint32_t m_requiredSize{0};
     BitField<RHIBufferUsageFlagBits> m_usageFlags;
     RHIBufferAllocateType m_allocateType{RHIBufferAllocateType::eNone};
+    bool m_transient{false};
+    RHIMemoryRequirements m_memoryRequirements{};
     // BufferHandle m_handle;
 };
 
@@ -398,6 +442,8 @@ struct RHITextureCreateInfo
     // memory flags
     bool cpuReadable{false};
     bool mutableFormat{false};
+    // created without memory, bound once with DynamicRHI::BindTextureMemory
+    bool transient{false};
     std::string tag;
 };
 
@@ -452,6 +498,17 @@ public:
         return m_baseInfo.mipmaps;
     }
 
+    bool IsTransient() const
+    {
+        return m_baseInfo.transient;
+    }
+
+    // only known for transient textures
+    const RHIMemoryRequirements& GetMemoryRequirements() const
+    {
+        return m_memoryRequirements;
+    }
+
     bool IsRenderTarget() const
     {
         return m_baseInfo.usageFlags.HasFlags(RHITextureUsageFlagBits::eColorAttachment,
@@ -530,6 +587,8 @@ protected:
     bool m_isProxy{};
 
     RHITextureSubResourceRange m_subResourceRange{};
+
+    RHIMemoryRequirements m_memoryRequirements{};
 };
 
 struct RHISamplerCreateInfo
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+#include "RHICommon.h"
+#include "RHIResource.h"
+#include "Templates/HashMap.h"
+#include "Utils/Mutex.h"
+
+namespace zen
+{
+// Reflection output of shader groups keyed by the hash of their SPIR-V. spirv-reflect only runs
+// for code the cache has not seen, entries are kept in the compact form they are stored on disk
+// and decoded on lookup. A file that is truncated, corrupted or written by another version is
+// dropped as a whole and the cache starts empty.
+class RHIShaderReflectionCache
+{
+public:
+    static constexpr uint32_t cMagic   = 0x4352535A; // "ZSRC"
+    static constexpr uint32_t cVersion = 1;
+
+    // an empty path keeps the cache in memory only
+    void Load(const std::string& path);
+
+    // returns true if the file was written, false if nothing was added since the last load or
+    // save, or the write failed
+    bool Save();
+
+    // thread safe. Fills shaderGroupInfo from the cache, or reflects the SPIR-V and adds the
+    // result, shaderGroupInfo.name is not touched
+    void GetOrReflect(const RHIShaderGroupSPIRVPtr& shaderGroupSpirv,
+                      RHIShaderGroupInfo& shaderGroupInfo);
+
+    // thread safe, returns false if hash is unknown
+    bool Find(uint64_t hash, RHIShaderGroupInfo& shaderGroupInfo);
+
+    // thread safe, an existing entry is kept
+    void Add(uint64_t hash, const RHIShaderGroupInfo& shaderGroupInfo);
+
+    uint32_t GetNumEntries();
+
+    uint32_t GetNumHits() const
+    {
+        return m_numHits.load(std::memory_order_relaxed);
+    }
+
+    uint32_t GetNumMisses() const
+    {
+        return m_numMisses.load(std::memory_order_relaxed);
+    }
+
+    // covers the stage flags and the code of every stage
+    static uint64_t CalcSPIRVHash(const RHIShaderGroupSPIRV& shaderGroupSpirv);
+
+    // appends the reflection data to outData, the name is not stored
+    static void Serialize(const RHIShaderGroupInfo& shaderGroupInfo, std::vector<uint8_t>& outData);
+
+    // returns false if the data is truncated or has trailing bytes
+    static bool Deserialize(const uint8_t* pData,
+                            size_t dataSize,
+                            RHIShaderGroupInfo& shaderGroupInfo);
+
+    static std::vector<uint8_t> PackCacheFile(
+        const HashMap<uint64_t, std::vector<uint8_t>>& entries);
+
+    // fills entries from a file written by PackCacheFile, returns false and leaves entries empty
+    // if anything does not match
+    static bool UnpackCacheFile(const uint8_t* pFile,
+                                size_t fileSize,
+                                HashMap<uint64_t, std::vector<uint8_t>>& entries);
+
+private:
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t numEntries;
+        uint32_t padding;
+        uint64_t dataSize;
+        uint64_t dataHash;
+    };
+
+    Mutex m_mutex;
+    // SPIR-V hash -> serialized RHIShaderGroupInfo
+    HashMap<uint64_t, std::vector<uint8_t>> m_entries;
+
+    std::string m_path;
+
+    // entries were added since the last load or save
+    bool m_dirty{false};
+
+    std::atomic<uint32_t> m_numHits{0};
+    std::atomic<uint32_t> m_numMisses{0};
+};
+} // namespace zen
@@ -111,7 +111,9 @@ static void ParseSpvPushConstants(RHIShaderStage stage,
     pconstants.resize(pcCount);
     result = spvReflectEnumeratePushConstantBlocks(pModule, &pcCount, pconstants.data());
     VERIFY_EXPR(result == SPV_REFLECT_RESULT_SUCCESS);
-    shaderGroupInfo.pushConstants.size = pconstants[0]->size;
+    // stages may declare a prefix of the block, e.g. a fragment shader reading only the indices
+    shaderGroupInfo.pushConstants.size =
+        std::max(shaderGroupInfo.pushConstants.size, pconstants[0]->size);
     shaderGroupInfo.pushConstants.stageFlags.SetFlag(RHIShaderStageToFlagBits(stage));
     shaderGroupInfo.pushConstants.name = pconstants[0]->type_description->type_name;
 }
@@ -330,7 +330,9 @@ inline void HashParam<std::vector<val::SubpassInfo>>(size_t& seed,
 
 
 template <class T, class... A>
-T& RequestResourceNoLock(const val::Device& device, HashMap<std::size_t, T>& resources, A&... args)
+T& RequestResourceNoLock(const val::Device& device,
+                         StableHashMap<std::size_t, T>& resources,
+                         A&... args)
 {
     std::size_t hash{0U};
     HashParam(hash, args...);
@@ -376,7 +378,7 @@ T& RequestResourceNoLock(const val::Device& device, HashMap<std::size_t, T>& res
 
 template <class T, class... A> T& RequestResource(const val::Device& device,
                                                   std::mutex& resourceMutex,
-                                                  HashMap<std::size_t, T>& resources,
+                                                  StableHashMap<std::size_t, T>& resources,
                                                   A&... args)
 {
     std::lock_guard<std::mutex> guard(resourceMutex);
@@ -439,9 +441,9 @@ private:
         std::mutex graphicsPipeline;
     } m_mutexTable;
 
-    HashMap<size_t, val::RenderPass> m_renderPasses;
-    HashMap<size_t, val::Framebuffer> m_framebuffers;
-    HashMap<size_t, val::PipelineLayout> m_pipelineLayouts;
-    HashMap<size_t, val::GraphicsPipeline> m_graphicPipelines;
+    StableHashMap<size_t, val::RenderPass> m_renderPasses;
+    StableHashMap<size_t, val::Framebuffer> m_framebuffers;
+    StableHashMap<size_t, val::PipelineLayout> m_pipelineLayouts;
+    StableHashMap<size_t, val::GraphicsPipeline> m_graphicPipelines;
 };
 } // namespace zen
\ No newline at end of file
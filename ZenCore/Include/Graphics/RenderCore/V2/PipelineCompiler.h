@@ -0,0 +1,87 @@
+#pragma once
+#include <vector>
+#include "Graphics/RHI/RHIResource.h"
+#include "Templates/HashMap.h"
+#include "Utils/JobSystem.h"
+#include "Utils/Mutex.h"
+#include "Utils/UniquePtr.h"
+
+namespace zen::rc
+{
+// Creates graphics pipelines on JobSystem workers so a new pass or material does not stall the
+// render thread. Requests are keyed by the RenderDevice pipeline description hash and compiled
+// once, no matter how many threads ask for the same pipeline. Finished pipelines are handed out
+// on the render thread by PublishCompleted(), which also writes them into the slots passed along
+// with the requests, a pipeline never shows up in the middle of recording.
+class PipelineCompiler
+{
+public:
+    struct CompiledPipeline
+    {
+        size_t hash{0};
+        RHIPipeline* pPipeline{nullptr};
+    };
+
+    // numWorkers == 0 means one worker per hardware thread minus the calling thread
+    explicit PipelineCompiler(uint32_t numWorkers = 0);
+
+    // waits for the compiles in flight, pipelines that were never published are destroyed
+    ~PipelineCompiler();
+
+    // thread safe. Returns the pipeline once it is published, nullptr while it is pending. The
+    // rendering layout of createInfo is copied into the request, the shader must stay alive until
+    // the compile is done. *ppTarget, if not null, is written by PublishCompleted()
+    RHIPipeline* RequestGfxPipeline(size_t hash,
+                                    const RHIGfxPipelineCreateInfo& createInfo,
+                                    RHIPipeline** ppTarget = nullptr);
+
+    // render thread only, fills the targets of the finished compiles and appends them to
+    // outCompiled, ownership of the pipelines goes to the caller
+    void PublishCompleted(std::vector<CompiledPipeline>& outCompiled);
+
+    // blocks until the pipeline requested with hash is compiled, without waiting for the other
+    // compiles in flight. Does not publish it
+    void Wait(size_t hash);
+
+    // blocks until every requested pipeline is compiled, does not publish them
+    void WaitIdle();
+
+    // number of unique pipelines requested so far
+    uint32_t GetNumRequested();
+
+    uint32_t GetNumPending() const
+    {
+        return m_numPending.load(std::memory_order_acquire);
+    }
+
+private:
+    ZEN_NO_COPY_MOVE(PipelineCompiler)
+
+    struct Request
+    {
+        size_t hash{0};
+        RHIGfxPipelineCreateInfo createInfo{};
+        // createInfo.pRenderingLayout points here, the caller's layout may change while compiling
+        RHIRenderingLayout renderingLayout{};
+        // slots written on publish
+        std::vector<RHIPipeline**> targets;
+        // set by the worker, read on the render thread after m_completed handed it over
+        RHIPipeline* pPipeline{nullptr};
+        bool published{false};
+        JobCounter counter;
+        std::atomic<bool> compiled{false};
+    };
+
+    void Compile(Request* pRequest);
+
+    void WaitRequest(Request* pRequest);
+
+    UniquePtr<JobSystem> m_pJobSystem;
+
+    Mutex m_mutex;
+    HashMap<size_t, Request*> m_requests;
+    // compiled but not yet published
+    std::vector<Request*> m_completed;
+    std::atomic<uint32_t> m_numPending{0};
+};
+} // namespace zen::rc
@@ -0,0 +1,77 @@
+#pragma once
+#include "Templates/HeapVector.h"
+#include "Graphics/RHI/RHIResource.h"
+
+namespace zen::rc
+{
+// first and last position of a resource in the compiled node order, both inclusive
+struct RDGResourceLifetime
+{
+    int32_t firstNode{-1};
+    int32_t lastNode{-1};
+
+    bool IsValid() const
+    {
+        return firstNode >= 0 && lastNode >= firstNode;
+    }
+
+    bool Overlaps(const RDGResourceLifetime& other) const
+    {
+        return firstNode <= other.lastNode && other.firstNode <= lastNode;
+    }
+};
+
+struct RDGTransientRequest
+{
+    RHIMemoryRequirements memory;
+    RDGResourceLifetime lifetime;
+    // the resource is already bound to this memory and keeps it, memory can not be rebound
+    bool fixed{false};
+    uint32_t fixedBlockIndex{0};
+    uint64_t fixedOffset{0};
+};
+
+struct RDGTransientPlacement
+{
+    uint32_t blockIndex{0};
+    uint64_t offset{0};
+    // request that used the same memory last before this one, -1 if the range is used first here
+    int32_t aliasedRequest{-1};
+};
+
+struct RDGTransientBlock
+{
+    uint64_t size{0};
+    uint64_t alignment{1};
+    uint32_t memoryTypeBits{~0u};
+};
+
+struct RDGTransientLayout
+{
+    // parallel to the requests
+    HeapVector<RDGTransientPlacement> placements;
+    HeapVector<RDGTransientBlock> blocks;
+    // sum of all request sizes, what one allocation per resource would take
+    uint64_t requestedSize{0};
+    // sum of all block sizes
+    uint64_t allocatedSize{0};
+    // largest sum of request sizes alive at one node, no placement can go below it
+    uint64_t peakLiveSize{0};
+    // fixed requests that share memory while both are alive, RenderGraph fails the compile on them
+    HeapVector<std::pair<uint32_t, uint32_t>> fixedConflicts;
+};
+
+// Places transient resources into as few memory blocks as possible. Requests whose lifetimes do
+// not overlap may share memory, larger requests are placed first and take the lowest free offset
+// of the first compatible block. Blocks grow up to maxBlockSize, a request larger than that gets
+// a block of its own. Fixed requests keep their placement and the others are placed around them.
+class RDGTransientAllocator
+{
+public:
+    static constexpr uint64_t cDefaultMaxBlockSize = 256ull * 1024 * 1024;
+
+    static void Place(const HeapVector<RDGTransientRequest>& requests,
+                      uint64_t maxBlockSize,
+                      RDGTransientLayout& outLayout);
+};
+} // namespace zen::rc
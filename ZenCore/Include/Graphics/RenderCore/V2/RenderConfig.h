@@ -24,6 +24,29 @@ struct RenderConfig
 
     uint32_t numThreads = 8;
 
+    // Draw the G-buffer from asset::PackedVertex (32 bytes) instead of asset::Vertex (112 bytes),
+    // must be set before the renderers are initialized
+    bool packedVertices = false;
+
+    // cull submeshes against the view frustum through the scene BVH, otherwise every submesh
+    // is drawn
+    bool frustumCulling = true;
+
+    // cull the G-buffer and shadow map draws in a compute pass and submit the survivors with one
+    // indirect count draw per pass, the render graphs are no longer rebuilt when the view moves.
+    // Needs RHIGPUInfo::supportDrawIndirectCount and is turned off with packedVertices
+    bool gpuDrivenDraws = false;
+
+    // compile the pipelines of the per-frame passes on worker threads, those passes are skipped
+    // until their pipeline is ready instead of stalling the frame that builds them
+    bool asyncPipelineCompile = false;
+
+    uint32_t numPipelineCompileThreads = 2;
+
+    // record each render graph into up to this many command lists on worker threads, the lists
+    // are submitted in order. 1 records on the render thread
+    uint32_t numRecordThreads = 1;
+
     DataFormat shadowDepthFormat{DataFormat::eD16UNORM};
 };
 } // namespace zen::rc
\ No newline at end of file
@@ -45,6 +45,9 @@ enum class TextureDimension : uint32_t
 struct TextureUsageHint
 {
     bool copyUsage : 1;
+    // render targets and storage textures only, memory is bound by
+    // RenderDevice::AllocateTransientMemory and shared with other transient resources of the graph
+    bool transient : 1;
 };
 
 struct TextureFormat
@@ -122,7 +125,8 @@ struct GraphicsPass
 {
     // FramebufferHandle framebuffer;
     // RenderPassHandle renderPass;
-    RHIPipeline* pPipeline;
+    // null while an async compile is pending
+    RHIPipeline* pPipeline{nullptr};
     RHIDescriptorSet* pDescriptorSets[MAX_NUM_DESCRIPTOR_SETS];
     uint32_t numDescriptorSets{0};
     ShaderProgram* pShaderProgram;
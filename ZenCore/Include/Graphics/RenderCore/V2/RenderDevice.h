@@ -13,6 +13,11 @@
 #define STAGING_POOL_SIZE_BYTES               (128 * 1024 * 1024)
 #define MAX_TEXTURE_STAGING_PENDING_FREE_SIZE (64 * 1024 * 1024)
 
+namespace zen
+{
+class JobSystem;
+}
+
 namespace zen::sg
 {
 class Scene;
@@ -24,6 +29,7 @@ class RenderDevice;
 class RenderGraph;
 class RendererServer;
 class TextureManager;
+class PipelineCompiler;
 class SkyboxRenderer;
 
 struct GraphicsCommandListPoolPolicy
@@ -133,6 +139,15 @@ public:
         return *this;
     }
 
+    // with RenderConfig::asyncPipelineCompile the pipeline is compiled on a worker thread and
+    // GraphicsPass::pPipeline stays null until it is published, the render graph skips the pass
+    // meanwhile. Only for passes that run every frame, one-shot passes need their pipeline now.
+    GraphicsPassBuilder& SetAsyncPipelineCompile(bool async)
+    {
+        m_asyncPipelineCompile = async;
+        return *this;
+    }
+
     GraphicsPass* Build();
 
 private:
@@ -149,6 +164,7 @@ private:
     RHIFramebufferInfo m_framebufferInfo{};
     HashMap<uint32_t, HeapVector<RHIShaderResourceBinding>> m_dsBindings;
     HashMap<uint32_t, int> m_specializationConstants;
+    bool m_asyncPipelineCompile{false};
 };
 
 class GraphicsPassResourceUpdater
@@ -349,6 +365,7 @@ struct RenderFrame
 
     std::vector<PendingBufferUpdate> pendingBufferUpdates;
     std::vector<RHITexture*> texturesPendingFree;
+    std::vector<RHIMemoryBlock*> memoryBlocksPendingFree;
 };
 
 struct RenderDeviceFeatures
@@ -370,6 +387,10 @@ public:
 
     void ExecuteRenderGraphs(VectorView<UniquePtr<RenderGraph>> rdgs);
 
+    // binds the transient resources of a compiled graph that have no memory yet, following its
+    // transient layout. Memory blocks are kept per graph tag and grow with the layout
+    void AllocateTransientMemory(const RenderGraph& rdg);
+
     // todo: implement pool based recycle mechanism
     RHIRenderingLayout* AcquireRenderingLayout();
 
@@ -440,13 +461,29 @@ public:
     //                                     const RenderPassHandle& renderPass,
     //                                     const HashMap<uint32_t, int>& specializationConstants);
 
+    // with an async target and a PipelineCompiler, a missing pipeline is queued for a worker
+    // and null is returned, *ppAsyncTarget receives it at the start of a later frame
     RHIPipeline* GetOrCreateGfxPipeline(RHIGfxPipelineStates& PSO,
                                         RHIShader* pShader,
                                         const RHIRenderingLayout* pRenderingLayout,
-                                        const HashMap<uint32_t, int>& specializationConstants);
+                                        const HashMap<uint32_t, int>& specializationConstants,
+                                        RHIPipeline** ppAsyncTarget = nullptr);
 
     RHIPipeline* GetOrCreateComputePipeline(RHIShader* pShader);
 
+    // flattens everything the backend bakes into a graphics pipeline: fixed-function states,
+    // enabled blend attachments, render target formats and sorted specialization constants.
+    // Floats are stored by bit pattern, equal descriptions always give the same hash.
+    static void BuildGfxPipelineDesc(const RHIGfxPipelineStates& pso,
+                                     uint32_t shaderHash,
+                                     const RHIRenderingLayout* pRenderingLayout,
+                                     const HashMap<uint32_t, int>& specializationConstants,
+                                     std::vector<uint32_t>& outDesc);
+
+    static void BuildComputePipelineDesc(uint32_t shaderHash, std::vector<uint32_t>& outDesc);
+
+    static size_t CalcPipelineHash(const std::vector<uint32_t>& desc);
+
     RHIViewport* CreateViewport(void* pWindow,
                                 uint32_t width,
                                 uint32_t height,
@@ -535,12 +572,25 @@ private:
 
     void AcquireGraphicsCmdLists(size_t numCmdLists, HeapVector<RHICommandList*>& outCmdLists);
 
+    // records rdg into one or more lists appended to outCmdLists, with m_pRecordJobSystem the
+    // graph is split into segments that are recorded and finalized on its workers. The finalized
+    // lists are appended to outPlatformCmdLists in submission order
+    void RecordRenderGraph(RenderGraph* pRDG,
+                           HeapVector<RHICommandList*>& outCmdLists,
+                           HeapVector<RHIPlatformCommandList*>& outPlatformCmdLists);
+
     void SubmitCommandLists(VectorView<RHICommandList*> cmdLists);
 
     void ProcessPendingFreeResources(uint32_t frameIndex);
 
+    // a retired block is freed with the last resource bound to it
+    void ReleaseTransientBinding(RHIResource* pResource);
+
     void FlushPendingBufferUpdates();
 
+    // moves the pipelines finished by m_pPipelineCompiler into m_pipelineCache
+    void PublishCompiledPipelines();
+
     void ResolveBufferStagingFlushAction(StagingFlushAction action);
 
     void UpdateBufferInternal(RHIBuffer* pBufferHandle,
@@ -563,17 +613,9 @@ private:
     // static size_t CalcFramebufferHash(const RHIFramebufferInfo& info,
     //                                   RenderPassHandle renderPassHandle);
 
-    // static size_t CalcGfxPipelineHash(const RHIGfxPipelineStates& pso,
-    //                                   RHIShader* shader,
-    //                                   const RenderPassHandle& renderPass,
-    //                                   const HashMap<uint32_t, int>& specializationConstants);
-
-    static size_t CalcGfxPipelineHash(const RHIGfxPipelineStates& pso,
-                                      RHIShader* pShader,
-                                      // const RHIRenderPassLayout& renderPassLayout,
-                                      const HashMap<uint32_t, int>& specializationConstants);
-
-    static size_t CalcComputePipelineHash(RHIShader* pShader);
+    // records the description of a new key, in debug builds a differing description behind an
+    // existing key is reported as a collision
+    void CheckPipelineDesc(size_t hash, const std::vector<uint32_t>& desc);
 
     static size_t CalcSamplerHash(const RHISamplerCreateInfo& info);
 
@@ -598,11 +640,19 @@ private:
 
     RendererServer* m_pRendererServer{nullptr};
     TextureManager* m_pTextureManager{nullptr};
+    // only with RenderConfig::asyncPipelineCompile
+    PipelineCompiler* m_pPipelineCompiler{nullptr};
+    // only with RenderConfig::numRecordThreads > 1
+    JobSystem* m_pRecordJobSystem{nullptr};
 
     DeletionQueue m_deletionQueue;
 
     // HashMap<size_t, RenderPassHandle> m_renderPassCache;
     HashMap<size_t, RHIPipeline*> m_pipelineCache;
+#if defined(ZEN_DEBUG)
+    // descriptions behind m_pipelineCache keys, a mismatch on lookup is a hash collision
+    HashMap<size_t, std::vector<uint32_t>> m_pipelineDescs;
+#endif
     HashMap<size_t, RHISampler*> m_samplerCache;
     // HashMap<RHITexture*, RHITexture*> m_textureMap;
     std::vector<RHIBuffer*> m_buffers;
@@ -611,6 +661,18 @@ private:
     std::vector<RHIViewport*> m_viewports;
     RHIViewport* m_pMainViewport{nullptr};
 
+    struct TransientBinding
+    {
+        uint32_t blockIndex;
+        uint64_t offset;
+        RHIMemoryBlock* pBlock;
+    };
+    // RenderGraph tag -> memory blocks of its transient layout
+    HashMap<std::string, std::vector<RHIMemoryBlock*>> m_transientMemory;
+    // blocks replaced by a larger one -> number of resources still bound to them
+    HashMap<RHIMemoryBlock*, uint32_t> m_retiredTransientMemory;
+    HashMap<RHIResource*, TransientBinding> m_transientBindings;
+
     friend class GraphicsPassBuilder;
     friend class ComputePassBuilder;
 };
@@ -4,12 +4,17 @@
 #include "Templates/HeapVector.h"
 #include "Memory/PagedAllocator.h"
 #include "Memory/PoolAllocator.h"
+#include "Utils/Mutex.h"
 #include "Graphics/RHI/RHICommon.h"
 #include "RenderCoreDefs.h"
+#include "RDGTransientAllocator.h"
 
 namespace zen
 {
 class RHICommandList;
+class RHIPlatformCommandList;
+class JobSystem;
+class RHIViewport;
 }
 // RDG_ID class
 class RDG_ID
@@ -140,25 +145,26 @@ enum class RDGPassType : uint32_t
 
 enum class RDGPassCmdType : uint32_t
 {
-    eNone                = 0,
-    eBindIndexBuffer     = 1,
-    eBindVertexBuffer    = 2,
-    eBindPipeline        = 3,
-    eClearAttachment     = 4,
-    eDraw                = 5,
-    eDrawIndexed         = 6,
-    eDrawIndexedIndirect = 7,
-    eExecuteCommands     = 8,
-    eNextSubpass         = 9,
-    eDispatch            = 10,
-    eDispatchIndirect    = 11,
-    eSetPushConstant     = 12,
-    eSetLineWidth        = 13,
-    eSetBlendConstant    = 14,
-    eSetScissor          = 15,
-    eSetViewport         = 16,
-    eSetDepthBias        = 17,
-    eMax                 = 18
+    eNone                     = 0,
+    eBindIndexBuffer          = 1,
+    eBindVertexBuffer         = 2,
+    eBindPipeline             = 3,
+    eClearAttachment          = 4,
+    eDraw                     = 5,
+    eDrawIndexed              = 6,
+    eDrawIndexedIndirect      = 7,
+    eExecuteCommands          = 8,
+    eNextSubpass              = 9,
+    eDispatch                 = 10,
+    eDispatchIndirect         = 11,
+    eSetPushConstant          = 12,
+    eSetLineWidth             = 13,
+    eSetBlendConstant         = 14,
+    eSetScissor               = 15,
+    eSetViewport              = 16,
+    eSetDepthBias             = 17,
+    eDrawIndexedIndirectCount = 18,
+    eMax                      = 19
 };
 
 enum class RDGNodeType : uint32_t
@@ -197,6 +203,10 @@ struct RDGResourceTracker
     RHIBufferUsage bufferUsage{RHIBufferUsage::eNone};
     RHITextureUsage textureUsage{RHITextureUsage::eNone};
     RHITextureSubResourceRange textureSubResourceRange;
+    // graph that placed the transient resource and the memory it is bound to from then on
+    std::string transientGraphTag;
+    uint32_t transientBlockIndex{0};
+    uint64_t transientOffset{0};
 };
 
 class RDGResourceTrackerPool
@@ -215,6 +225,10 @@ public:
                             RHIAccessMode accessMode,
                             RHIBufferUsage usage);
 
+    void RemoveTracker(const RHIResource* pResource);
+
+    void Clear();
+
 private:
     // HashMap<Handle, RDGResourceTracker*> m_trackerMap;
     HashMap<const RHIResource*, RDGResourceTracker*> m_trackerMap;
@@ -240,6 +254,10 @@ struct RDGResource
     std::string tag;
     RHIResource* pPhysicalRes{nullptr};
     RDGResourceType type{RDGResourceType::eNone};
+    // created without memory, placed into memory shared with other transient resources
+    bool transient{false};
+    // an output of the graph, its last contents are used after the graph, see Export*
+    bool exported{false};
 
     RDGVector<RDGAccess> accesses;
 };
@@ -423,14 +441,50 @@ struct RDGTextureMipmapGenNode : RDGNodeBase
     RHITexture* pTexture;
 };
 
+// where the state a transition leaves was used last: compiled index of the last node and the
+// stages of every node using the resource in that state
+struct RDGTransitionSource
+{
+    int32_t node{-1};
+    BitField<RHIPipelineStageBits> stages;
+};
+
 struct RDGCompiledNode
 {
     RDG_ID nodeId{-1};
+    // dependency level, consecutive nodes of a level share one prologue barrier
+    uint32_t level{0};
     BitField<RHIPipelineStageBits> prologueSrcStages;
     BitField<RHIPipelineStageBits> prologueDstStages;
     HeapVector<RDGAccess> initialResourceAccesses;
     HeapVector<RHIBufferTransition> prologueBufferTransitions;
     HeapVector<RHITextureTransition> prologueTextureTransitions;
+    // RDG resource of each prologue transition, used to patch a cached plan with the physical
+    // resources of another graph
+    HeapVector<RDG_ID> prologueBufferResourceIds;
+    HeapVector<RDG_ID> prologueTextureResourceIds;
+    HeapVector<RDGTransitionSource> prologueBufferSources;
+    HeapVector<RDGTransitionSource> prologueTextureSources;
+    // transient resources first used here reuse memory of resources that are done, not cached
+    // since the placement depends on the physical resources
+    HeapVector<RHIMemoryTransition> aliasingMemoryTransitions;
+    // split barrier, not cached. Prologue transitions with a distant source start right after
+    // splitSrcNode and the node waits for them before it runs
+    int32_t splitSrcNode{-1};
+    BitField<RHIPipelineStageBits> splitSrcStages;
+    HeapVector<RHIBufferTransition> splitBufferTransitions;
+    HeapVector<RHITextureTransition> splitTextureTransitions;
+    // compiled indices of the nodes whose split barriers start after this node
+    HeapVector<uint32_t> splitBarrierConsumers;
+};
+
+// transitions recorded before a compiled node, ranges into the transitions resolved for Execute
+struct RDGRecordBarriers
+{
+    uint32_t firstBufferTransition{0};
+    uint32_t numBufferTransitions{0};
+    uint32_t firstTextureTransition{0};
+    uint32_t numTextureTransitions{0};
 };
 
 struct RDGCompileStats
@@ -440,6 +494,75 @@ struct RDGCompileStats
     uint32_t resourceCount{0};
     uint32_t barrierCount{0};
     uint32_t commandListCount{0};
+    // totals of the compiled plan cache when this graph was compiled
+    uint32_t cacheHits{0};
+    uint32_t cacheMisses{0};
+    uint32_t transientResourceCount{0};
+    // memory of the transient placement and what one allocation per resource would take
+    uint64_t transientMemorySize{0};
+    uint64_t transientMemoryRequestedSize{0};
+    uint32_t aliasingBarrierCount{0};
+    // pipeline barriers recorded with one per node that has transitions and with the nodes of a
+    // dependency level merged
+    uint32_t unmergedBarrierBatchCount{0};
+    uint32_t barrierBatchCount{0};
+    // transitions moved to split barriers since their source node is far ahead
+    uint32_t splitBarrierCount{0};
+    // read only first uses already in the requested state, dropped by the last Execute
+    uint32_t redundantTransitionCount{0};
+    // nodes whose writes never reach an exported resource, not part of the compiled nodes
+    uint32_t culledNodeCount{0};
+    uint32_t culledPassCount{0};
+};
+
+// Compiled plans shared by all RenderGraph instances, keyed by the structure of the graph: node
+// types and stages, resource types and every resource access. Physical resources are not part of
+// the key, renderers build a new graph every frame and usually end up with the same structure.
+class RDGCompiledPlanCache
+{
+public:
+    static constexpr uint32_t cMaxPlans = 64;
+
+    ~RDGCompiledPlanCache();
+
+    // copies the plan into the output on a hit, transitions of the copy have no physical resources
+    bool Restore(uint64_t hash,
+                 const std::vector<uint32_t>& structureKey,
+                 HeapVector<HeapVector<RDG_ID>>& outSortedNodes,
+                 HeapVector<RDGCompiledNode>& outCompiledNodes,
+                 RDGCompileStats& outStats);
+
+    void Store(uint64_t hash,
+               std::vector<uint32_t>&& structureKey,
+               const HeapVector<HeapVector<RDG_ID>>& sortedNodes,
+               const HeapVector<RDGCompiledNode>& compiledNodes,
+               const RDGCompileStats& stats);
+
+    void Clear();
+
+    uint32_t GetNumHits() const
+    {
+        return m_numHits;
+    }
+
+    uint32_t GetNumMisses() const
+    {
+        return m_numMisses;
+    }
+
+private:
+    struct Plan
+    {
+        std::vector<uint32_t> structureKey;
+        HeapVector<HeapVector<RDG_ID>> sortedNodes;
+        HeapVector<RDGCompiledNode> compiledNodes;
+        RDGCompileStats stats;
+    };
+
+    Mutex m_mutex;
+    HashMap<uint64_t, Plan*> m_plans;
+    uint32_t m_numHits{0};
+    uint32_t m_numMisses{0};
 };
 
 struct RDGBindIndexBufferNode : RDGPassChildNode
@@ -497,7 +620,8 @@ struct RDGBindVertexBufferNode : RDGPassChildNode
 
 struct RDGBindPipelineNode : RDGPassChildNode
 {
-    RHIPipeline* pPipeline;
+    // the pass's pipeline slot, async compiled pipelines land there after the graph is built
+    RHIPipeline* const* ppPipeline{nullptr};
     RHIPipelineType pipelineType{RHIPipelineType::eNone};
 };
 
@@ -524,6 +648,16 @@ struct RDGDrawIndexedIndirectNode : RDGPassChildNode
     uint32_t stride{0};
 };
 
+struct RDGDrawIndexedIndirectCountNode : RDGPassChildNode
+{
+    RHIBuffer* pIndirectBuffer;
+    RHIBuffer* pCountBuffer;
+    uint32_t offset{0};
+    uint32_t countBufferOffset{0};
+    uint32_t maxDrawCount{0};
+    uint32_t stride{0};
+};
+
 struct RDGDispatchNode : RDGPassChildNode
 {
     uint32_t groupCountX{0};
@@ -589,6 +723,10 @@ struct RDGSetDepthBiasNode : RDGPassChildNode
 class RenderGraph
 {
 public:
+    // compiled nodes between the source of a transition and its consumer before the transition
+    // becomes a split barrier
+    static constexpr uint32_t cSplitBarrierMinDistance = 4;
+
     RenderGraph(std::string tag) :
         m_rdgTag(std::move(tag)),
         m_resourceAllocator(ZEN_DEFAULT_PAGESIZE, false),
@@ -603,7 +741,7 @@ public:
     }
 
     void AddPassBindPipelineNode(RDGPassNode* pParent,
-                                 RHIPipeline* pPipelineHandle,
+                                 RHIPipeline* const* ppPipeline,
                                  RHIPipelineType pipelineType);
 
     RDGPassNode* AddComputePassNode(const ComputePass* pComputePass, std::string tag);
@@ -658,6 +796,15 @@ public:
                                                 uint32_t drawCount,
                                                 uint32_t stride);
 
+    // the draw count is written on the GPU, e.g. by a culling compute pass
+    void AddGraphicsPassDrawIndexedIndirectCountNode(RDGPassNode* pParent,
+                                                     RHIBuffer* pIndirectBuffer,
+                                                     uint32_t offset,
+                                                     RHIBuffer* pCountBuffer,
+                                                     uint32_t countBufferOffset,
+                                                     uint32_t maxDrawCount,
+                                                     uint32_t stride);
+
     void AddGraphicsPassSetBlendConstantNode(RDGPassNode* pParent, const Color& color);
 
     void AddGraphicsPassSetLineWidthNode(RDGPassNode* pParent, float width);
@@ -704,15 +851,94 @@ public:
 
     void AddTextureMipmapGenNode(RHITexture* pTexture);
 
+    // Declares an output of the graph. Once a graph has an output, nodes whose writes reach
+    // neither an output nor a node that contributes to one are culled when the graph is compiled.
+    // Graphs without outputs keep every node. Resources read after the graph, e.g. by another
+    // graph or on the CPU, have to be exported as well.
+    void ExportTexture(RHITexture* pTexture);
+
+    void ExportBuffer(RHIBuffer* pBuffer);
+
+    // exports the color back buffer of the viewport
+    void ExportViewport(RHIViewport* pViewport);
 
     void Begin();
 
+    // compiles the graph, throws std::runtime_error when transient resources placed by an earlier
+    // compile now overlap in the memory they are bound to
     void End();
 
     // void Execute(RHICommandList* cmdList);
 
     void Execute(RHICommandList* pCmdList);
 
+    // Records the compiled nodes into cmdLists.size() command lists, each list gets one contiguous
+    // segment of the compiled order. Barriers are resolved on the calling thread first, then the
+    // segments are recorded on pJobSystem workers, or in turn if it is null. Submitting the lists
+    // in order gives the same command stream as recording into a single list.
+    // With pOutPlatformCmdLists each segment is also finalized by GDynamicRHI on the worker that
+    // recorded it, slot i holds the platform list of cmdLists[i] or nullptr if it is empty.
+    void Execute(VectorView<RHICommandList*> cmdLists,
+                 JobSystem* pJobSystem,
+                 HeapVector<RHIPlatformCommandList*>* pOutPlatformCmdLists = nullptr);
+
+    const RDGCompileStats& GetCompileStats() const
+    {
+        return m_compileStats;
+    }
+
+    const HeapVector<RDGCompiledNode>& GetCompiledNodes() const
+    {
+        return m_compiledNodes;
+    }
+
+    const std::string& GetTag() const
+    {
+        return m_rdgTag;
+    }
+
+    // indexed by RDG resource id
+    const HeapVector<RDGResourceLifetime>& GetResourceLifetimes() const
+    {
+        return m_resourceLifetimes;
+    }
+
+    RDGResourceLifetime GetResourceLifetime(RHIResource* pResource) const
+    {
+        auto iter = m_resourceMap.find(pResource);
+        return iter == m_resourceMap.end() ? RDGResourceLifetime{} :
+                                             m_resourceLifetimes[iter->second->id];
+    }
+
+    // placement of the transient resources, parallel to GetTransientResources()
+    const RDGTransientLayout& GetTransientLayout() const
+    {
+        return m_transientLayout;
+    }
+
+    const HeapVector<RHIResource*>& GetTransientResources() const
+    {
+        return m_transientResources;
+    }
+
+    // drops the compiled plans of all graphs
+    static void ClearCompiledPlanCache()
+    {
+        s_compiledPlanCache.Clear();
+    }
+
+    // forgets the last known state of every tracked resource
+    static void ClearResourceTrackers()
+    {
+        s_trackerPool.Clear();
+    }
+
+    // forgets the state and the transient placement of a resource that is being destroyed
+    static void ReleaseResourceTracker(const RHIResource* pResource)
+    {
+        s_trackerPool.RemoveTracker(pResource);
+    }
+
 private:
     void DeclareTextureAccessForPass(const RDGPassNode* pPassNode,
                                      RHITexture* pTexture,
@@ -740,7 +966,15 @@ private:
         return key;
     }
 
-    void RunNode(RDGNodeBase* pNode);
+    void RunNode(RDGNodeBase* pNode, RHICommandList* pCmdList);
+
+    // lookup without inserting, segments are recorded concurrently
+    VectorView<RDGPassChildNode*> GetPassChildNodes(const RDG_ID& passId) const
+    {
+        auto iter = m_passChildNodeMap.find(passId);
+        return iter == m_passChildNodeMap.end() ? VectorView<RDGPassChildNode*>{} :
+                                                  VectorView<RDGPassChildNode*>(iter->second);
+    }
 
     bool AddNodeDepsForResource(RDGResource* pResource,
                                 HashMap<RDG_ID, HeapVector<RDG_ID>>& nodeDependencies,
@@ -752,6 +986,14 @@ private:
 
     void Compile();
 
+    // marks the nodes that do not contribute to an exported resource and drops their accesses
+    void CullNodes();
+
+    bool IsNodeCulled(const RDG_ID& nodeId) const
+    {
+        return !m_culledNodes.empty() && m_culledNodes[nodeId] != 0;
+    }
+
     void BuildCompiledNodeList();
 
     void AttachFirstUseBarriers();
@@ -760,10 +1002,43 @@ private:
 
     void AddResourceAccess(RDGResource* pResource, const RDGAccess& access);
 
-    void EmitCompiledNodeBarriers(RDGCompiledNode& compiledNode);
+    // resolves the initial accesses of a node against the tracked resource state and appends
+    // its transitions to m_recordBufferTransitions and m_recordTextureTransitions
+    void ResolveCompiledNodeBarriers(const RDGCompiledNode& compiledNode,
+                                     RDGRecordBarriers& outBarriers);
+
+    // splits the compiled nodes into numSegments ranges with about the same number of commands
+    void SplitRecordSegments(uint32_t numSegments, HeapVector<uint32_t>& outSegmentBegins) const;
+
+    // without eventsAcrossLists a split barrier whose source is outside the segment becomes a
+    // plain barrier in front of its consumer, lists encoded at the same time can't share events
+    void RecordSegment(uint32_t beginNode,
+                       uint32_t endNode,
+                       RHICommandList* pCmdList,
+                       bool eventsAcrossLists = true);
+
+    // true when the prologue barrier of the node is merged into the one of the previous node
+    bool JoinsBarrierGroup(uint32_t node) const;
+
+    // one barrier for the prologues of the group starting at beginNode, the group may continue
+    // in a later list
+    void RecordBarrierGroup(uint32_t beginNode, RHICommandList* pCmdList);
+
+    // moves transitions with a distant source to split barriers and counts the barrier batches
+    void OptimizeBarriers();
 
     void ValidateCompiledGraph() const;
 
+    void BuildStructureKey(std::vector<uint32_t>& outKey) const;
+
+    void PatchCompiledNodeResources();
+
+    void AnalyzeResourceLifetimes();
+
+    void PlaceTransientResources();
+
+    static bool IsTransientResource(RHIResource* pResourceRHI, RDGResourceType type);
+
     template <class T>
         requires std::derived_from<T, RDGNodeBase>
     T* AllocNode()
@@ -898,6 +1173,7 @@ private:
             pResource->id           = static_cast<int32_t>(m_resources.size());
             pResource->type         = type;
             pResource->pPhysicalRes = pResourceRHI;
+            pResource->transient    = IsTransientResource(pResourceRHI, type);
 
             m_resources.push_back(pResource);
             m_resourceMap[pResourceRHI] = pResource;
@@ -927,11 +1203,12 @@ private:
     // RHI CommandList
     // RHICommandList* m_cmdList{nullptr};
 
-    RHICommandList* m_pCmdList{nullptr};
     // nodes
     uint32_t m_nodeCount{0};
     HeapVector<HeapVector<RDG_ID>> m_sortedNodes;
     HeapVector<RDGCompiledNode> m_compiledNodes;
+    // indexed by node id, empty unless the graph has outputs
+    HeapVector<uint8_t> m_culledNodes;
 
     HashMap<RDG_ID, RDGNodeBase*> m_baseNodeMap;
     HashMap<RDG_ID, HeapVector<RDGPassChildNode*>> m_passChildNodeMap;
@@ -946,7 +1223,18 @@ private:
     HashMap<RDG_ID, HeapVector<RDGAccess>> m_nodeAccessMap;
     RDGExecutionState m_executionState{RDGExecutionState::eIdle};
     RDGCompileStats m_compileStats;
+    HeapVector<RDGResourceLifetime> m_resourceLifetimes;
+    HeapVector<RHIResource*> m_transientResources;
+    RDGTransientLayout m_transientLayout;
+    // barriers of the compiled nodes resolved for the current Execute
+    HeapVector<RDGRecordBarriers> m_recordBarriers;
+    HeapVector<RHIBufferTransition> m_recordBufferTransitions;
+    HeapVector<RHITextureTransition> m_recordTextureTransitions;
+    // events of the split barriers, indexed by the compiled index of the consumer
+    HeapVector<RHIBarrierEvent> m_barrierEvents;
     // track resource state across multiple RDG instances
     static RDGResourceTrackerPool s_trackerPool;
+    // reuse compiled plans across RDG instances
+    static RDGCompiledPlanCache s_compiledPlanCache;
 };
 } // namespace zen::rc
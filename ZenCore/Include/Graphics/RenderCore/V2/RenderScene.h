@@ -1,6 +1,12 @@
 #pragma once
 #include "Graphics/RenderCore/V2/RenderDevice.h"
 #include "SceneGraph/Scene.h"
+#include "AssetLib/VertexQuantization.h"
+
+namespace zen
+{
+class Frustum;
+} // namespace zen
 
 namespace zen::sg
 {
@@ -38,6 +44,18 @@ struct SceneUniformData
     Vec4 viewPos;
 };
 
+// world space bounds and draw arguments of one sg::SceneBVH item, read by cull_draws.comp and the
+// indirect vertex shaders
+struct DrawInstanceData
+{
+    Vec4 center;
+    Vec4 extent;
+    uint32_t indexCount;
+    uint32_t firstIndex;
+    uint32_t nodeIndex;
+    uint32_t materialIndex;
+};
+
 class RenderScene
 {
 public:
@@ -53,13 +71,27 @@ public:
 
     void PrepareBuffers();
 
+    // per frame, uploads the nodes moved through the scene transform hierarchy
     void Update();
 
+    // not created when RenderConfig::packedVertices is set and the GPU supports geometry shaders
     RHIBuffer* GetVertexBuffer() const
     {
         return m_pVertexBuffer;
     }
 
+    // only created when RenderConfig::packedVertices is set
+    RHIBuffer* GetPackedVertexBuffer() const
+    {
+        return m_pPackedVertexBuffer;
+    }
+
+    const asset::VertexQuantizationBounds& GetVertexQuantizationBounds(
+        const sg::SubMesh* pSubMesh) const
+    {
+        return m_vertexQuantizationBounds.at(pSubMesh);
+    }
+
     RHIBuffer* GetIndexBuffer() const
     {
         return m_pIndexBuffer;
@@ -85,6 +117,20 @@ public:
         return m_pMaterialSSBO;
     }
 
+    // only created when RenderConfig::gpuDrivenDraws is set, indexed like the BVH items
+    RHIBuffer* GetDrawInstancesSSBO() const
+    {
+        return m_pDrawInstanceSSBO;
+    }
+
+    uint32_t GetNumDrawInstances() const
+    {
+        return m_numDrawInstances;
+    }
+
+    // bounds are the ones sg::SceneBVH culls the item with
+    static DrawInstanceData MakeDrawInstance(const sg::SceneBVH::Item& item);
+
     const EnvTexture& GetEnvTexture() const
     {
         return m_envTexture;
@@ -110,6 +156,15 @@ public:
         return m_pScene->GetLocalAABB();
     }
 
+    const sg::SceneBVH& GetBVH() const
+    {
+        return m_pScene->GetBVH();
+    }
+
+    // fills visibleItems with the BVH items intersecting the frustum, all of them when
+    // RenderConfig::frustumCulling is off
+    void CullView(const Frustum& frustum, std::vector<uint32_t>& visibleItems) const;
+
     const sg::Camera* GetCamera() const;
 
     const uint8_t* GetCameraUniformData() const;
@@ -122,6 +177,15 @@ public:
     }
 
 private:
+    void PackVertices(const SceneData& sceneData);
+
+    void PrepareDrawInstances();
+
+    std::vector<DrawInstanceData> MakeDrawInstances() const;
+
+    // uploads the node data and draw instances of the renderable nodes after they moved
+    void UpdateNodesData();
+
     RenderDevice* m_pRenderDevice{nullptr};
     sg::Scene* m_pScene{nullptr};
     sg::Camera* m_pCamera{nullptr};
@@ -132,11 +196,17 @@ private:
     std::vector<sg::MaterialData> m_materialsData;
     RHIBuffer* m_pMaterialSSBO;
 
+    RHIBuffer* m_pDrawInstanceSSBO{nullptr};
+    uint32_t m_numDrawInstances{0};
+
     SceneUniformData m_sceneUniformData{};
 
-    RHIBuffer* m_pVertexBuffer;
+    RHIBuffer* m_pVertexBuffer{nullptr};
     RHIBuffer* m_pIndexBuffer;
 
+    RHIBuffer* m_pPackedVertexBuffer{nullptr};
+    HashMap<const sg::SubMesh*, asset::VertexQuantizationBounds> m_vertexQuantizationBounds;
+
     RHIBuffer* m_pTriangleMapBuffer;
 
     uint32_t m_numIndices{0};
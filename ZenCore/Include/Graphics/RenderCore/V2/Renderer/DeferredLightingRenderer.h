@@ -1,6 +1,7 @@
 #pragma once
 #include "Utils/UniquePtr.h"
 #include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "Graphics/RenderCore/V2/Renderer/IndirectDrawCuller.h"
 
 namespace zen::sys
 {
@@ -34,11 +35,8 @@ public:
 
     void Destroy();
 
-    void SetRenderScene(RenderScene* pRenderScene)
-    {
-        m_pScene = pRenderScene;
-        UpdateGraphicsPassResources();
-    }
+    void SetRenderScene(RenderScene* pRenderScene);
+
     void PrepareRenderWorkload();
 
     void OnResize();
@@ -57,8 +55,19 @@ private:
 
     void BuildRenderGraph();
 
+    // culls the scene for the camera, the render graph is rebuilt when the visible set changes
+    void UpdateVisibleItems();
+
     void AddMeshDrawNodes(RDGPassNode* pPass, const Rect2<int>& area, const Rect2<float>& viewport);
 
+    void AddPackedMeshDrawNodes(RDGPassNode* pPass,
+                                const Rect2<int>& area,
+                                const Rect2<float>& viewport);
+
+    void AddIndirectMeshDrawNodes(RDGPassNode* pPass,
+                                  const Rect2<int>& area,
+                                  const Rect2<float>& viewport);
+
     RenderDevice* m_pRenderDevice{nullptr};
 
     RHIViewport* m_pViewport{nullptr};
@@ -74,6 +83,13 @@ private:
 
     RenderScene* m_pScene{nullptr};
 
+    // sg::SceneBVH items drawn by the current render graph
+    std::vector<uint32_t> m_visibleItems;
+    std::vector<uint32_t> m_cullResult;
+
+    // only created when RenderConfig::gpuDrivenDraws is set, replaces m_visibleItems
+    UniquePtr<IndirectDrawCuller> m_indirectCuller;
+
     // struct
     // {
     //     TextureHandle position;
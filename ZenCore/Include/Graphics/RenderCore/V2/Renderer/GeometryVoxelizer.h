@@ -35,6 +35,9 @@ protected:
 
     void UpdateUniformData() final;
 
+    // draws every submesh with asset::PackedVertex and its quantization bounds
+    void AddPackedVoxelizationDrawNodes(RDGPassNode* pPass);
+
     RHIBuffer* m_pVoxelVBO;
     struct
     {
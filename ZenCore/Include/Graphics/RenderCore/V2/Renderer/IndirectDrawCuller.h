@@ -0,0 +1,59 @@
+#pragma once
+#include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "Graphics/RenderCore/V2/ShaderProgram.h"
+
+namespace zen
+{
+class Frustum;
+} // namespace zen
+
+namespace zen::rc
+{
+class RenderScene;
+class RenderDevice;
+
+// Frustum culls the RenderScene draw instances on the GPU and compacts the survivors into an
+// indirect command buffer, one indexed indirect count draw then submits the whole view. The
+// frustum lives in a uniform buffer so a moving view never rebuilds the render graph.
+class IndirectDrawCuller
+{
+public:
+    explicit IndirectDrawCuller(RenderDevice* pRenderDevice);
+
+    void Init(const std::string& tag);
+
+    void Destroy();
+
+    void SetRenderScene(RenderScene* pRenderScene);
+
+    void SetFrustum(const Frustum& frustum);
+
+    // clears the draw count and dispatches the culling pass, call before the graphics pass that
+    // draws the result
+    void AddCullPassNodes(RenderGraph* pRDG);
+
+    // vertex and index buffers, viewport and scissor are left to the caller
+    void AddDrawNode(RenderGraph* pRDG, RDGPassNode* pPass);
+
+    static CullDrawsSP::CullData MakeCullData(const Frustum& frustum,
+                                              uint32_t numInstances,
+                                              bool cullingEnabled);
+
+private:
+    static constexpr uint32_t cWorkgroupSize = 64;
+
+    RenderDevice* m_pRenderDevice{nullptr};
+
+    RenderScene* m_pScene{nullptr};
+
+    ComputePass* m_pCullPass{nullptr};
+
+    std::string m_tag;
+
+    uint32_t m_numInstances{0};
+
+    RHIBuffer* m_pCullDataBuffer{nullptr};
+    RHIBuffer* m_pDrawCommandBuffer{nullptr};
+    RHIBuffer* m_pDrawCountBuffer{nullptr};
+};
+} // namespace zen::rc
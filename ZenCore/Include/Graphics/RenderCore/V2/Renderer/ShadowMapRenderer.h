@@ -1,6 +1,7 @@
 #pragma once
 #include "Graphics/RenderCore/V2/RenderGraph.h"
 #include "Graphics/RenderCore/V2/RenderResource.h"
+#include "Graphics/RenderCore/V2/Renderer/IndirectDrawCuller.h"
 #include "SceneGraph/Camera.h"
 
 namespace zen::sg
@@ -49,10 +50,16 @@ private:
 
     void BuildRenderGraph();
 
+    // draws m_visibleItems with asset::PackedVertex and the submesh quantization bounds
+    void AddPackedMeshDrawNodes(RDGPassNode* pPass);
+
     void UpdateGraphicsPassResources();
 
     void UpdateUniformData();
 
+    // culls the scene for the light view, the render graph is rebuilt when the visible set changes
+    void UpdateVisibleItems();
+
     RenderDevice* m_pRenderDevice{nullptr};
 
     RHIViewport* m_pViewport{nullptr};
@@ -86,5 +93,15 @@ private:
     RHISampler* m_pColorSampler;
 
     UniquePtr<sg::Camera> m_lightView;
+
+    // frustum of the matrix in uLightInfo
+    Frustum m_lightFrustum;
+
+    // sg::SceneBVH items drawn by the current render graph
+    std::vector<uint32_t> m_visibleItems;
+    std::vector<uint32_t> m_cullResult;
+
+    // only created when RenderConfig::gpuDrivenDraws is set, replaces m_visibleItems
+    UniquePtr<IndirectDrawCuller> m_indirectCuller;
 };
 } // namespace zen::rc
\ No newline at end of file
@@ -132,6 +132,62 @@ public:
     } pushConstantsData;
 };
 
+// GBufferSP reading asset::PackedVertex, used when RenderConfig::packedVertices is set
+class GBufferPackedSP : public ShaderProgram
+{
+public:
+    explicit GBufferPackedSP(RenderDevice* pRenderDevice) :
+        ShaderProgram(pRenderDevice, "GBufferPackedSP")
+    {
+        AddShaderStage(RHIShaderStage::eVertex, "SceneRenderer/offscreen_packed.vert.spv");
+        AddShaderStage(RHIShaderStage::eFragment, "SceneRenderer/offscreen.frag.spv");
+        Init();
+    }
+
+    struct PushConstantsData
+    {
+        uint32_t nodeIndex;
+        uint32_t materialIndex;
+        uint32_t padding[2];
+        Vec4 posOffset;
+        Vec4 posScale;
+    } pushConstantsData;
+};
+
+// GBufferSP for RenderConfig::gpuDrivenDraws, node and material are read from the draw instance
+// selected by gl_InstanceIndex instead of push constants
+class GBufferIndirectSP : public ShaderProgram
+{
+public:
+    explicit GBufferIndirectSP(RenderDevice* pRenderDevice) :
+        ShaderProgram(pRenderDevice, "GBufferIndirectSP")
+    {
+        AddShaderStage(RHIShaderStage::eVertex, "SceneRenderer/offscreen_indirect.vert.spv");
+        AddShaderStage(RHIShaderStage::eFragment, "SceneRenderer/offscreen.frag.spv");
+        Init();
+    }
+};
+
+// frustum culls RenderScene draw instances into DrawIndexedIndirectCommands
+class CullDrawsSP : public ShaderProgram
+{
+public:
+    explicit CullDrawsSP(RenderDevice* pRenderDevice) : ShaderProgram(pRenderDevice, "CullDrawsSP")
+    {
+        AddShaderStage(RHIShaderStage::eCompute, "SceneRenderer/cull_draws.comp.spv");
+        Init();
+    }
+
+    // layout of uCullData, every IndirectDrawCuller binds its own buffer
+    struct CullData
+    {
+        Vec4 frustumPlanes[6];
+        uint32_t numInstances;
+        uint32_t cullingEnabled;
+        uint32_t padding[2];
+    };
+};
+
 class DeferredLightingSP : public ShaderProgram
 {
 public:
@@ -196,13 +252,8 @@ class VoxelizationSP : public ShaderProgram
 {
 public:
     explicit VoxelizationSP(RenderDevice* pRenderDevice) :
-        ShaderProgram(pRenderDevice, "VoxelizationSP")
-    {
-        AddShaderStage(RHIShaderStage::eVertex, "VoxelGI/voxelization.vert.spv");
-        AddShaderStage(RHIShaderStage::eGeometry, "VoxelGI/voxelization.geom.spv");
-        AddShaderStage(RHIShaderStage::eFragment, "VoxelGI/voxelization.frag.spv");
-        Init();
-    }
+        VoxelizationSP(pRenderDevice, "VoxelizationSP", "VoxelGI/voxelization.vert.spv")
+    {}
 
     const uint8_t* GetVoxelConfigData() const
     {
@@ -223,6 +274,37 @@ public:
         uint32_t flagStaticVoxels;
         uint32_t volumeDimension;
     } pushConstantsData;
+
+protected:
+    VoxelizationSP(RenderDevice* pRenderDevice,
+                   std::string name,
+                   const std::string& vertexShaderPath) :
+        ShaderProgram(pRenderDevice, std::move(name))
+    {
+        AddShaderStage(RHIShaderStage::eVertex, vertexShaderPath);
+        AddShaderStage(RHIShaderStage::eGeometry, "VoxelGI/voxelization.geom.spv");
+        AddShaderStage(RHIShaderStage::eFragment, "VoxelGI/voxelization.frag.spv");
+        Init();
+    }
+};
+
+// VoxelizationSP reading asset::PackedVertex, used when RenderConfig::packedVertices is set
+class VoxelizationPackedSP : public VoxelizationSP
+{
+public:
+    explicit VoxelizationPackedSP(RenderDevice* pRenderDevice) :
+        VoxelizationSP(pRenderDevice,
+                       "VoxelizationPackedSP",
+                       "VoxelGI/voxelization_packed.vert.spv")
+    {}
+
+    // PushConstantsData followed by the submesh quantization bounds
+    struct PackedPushConstantsData
+    {
+        PushConstantsData base;
+        Vec4 posOffset;
+        Vec4 posScale;
+    } packedPushConstantsData;
 };
 
 class VoxelDrawSP : public ShaderProgram
@@ -459,12 +541,8 @@ class ShadowMapRenderSP : public ShaderProgram
 {
 public:
     explicit ShadowMapRenderSP(RenderDevice* pRenderDevice) :
-        ShaderProgram(pRenderDevice, "ShadowMapRenderSP")
-    {
-        AddShaderStage(RHIShaderStage::eVertex, "ShadowMapping/evsm.vert.spv");
-        AddShaderStage(RHIShaderStage::eFragment, "ShadowMapping/evsm.frag.spv");
-        Init();
-    }
+        ShadowMapRenderSP(pRenderDevice, "ShadowMapRenderSP", "ShadowMapping/evsm.vert.spv")
+    {}
 
 
     const uint8_t* GetLightInfoData() const
@@ -484,6 +562,49 @@ public:
     {
         Mat4 lightViewProjection;
     } lightInfo;
+
+protected:
+    ShadowMapRenderSP(RenderDevice* pRenderDevice,
+                      std::string name,
+                      const std::string& vertexShaderPath) :
+        ShaderProgram(pRenderDevice, std::move(name))
+    {
+        AddShaderStage(RHIShaderStage::eVertex, vertexShaderPath);
+        AddShaderStage(RHIShaderStage::eFragment, "ShadowMapping/evsm.frag.spv");
+        Init();
+    }
+};
+
+// ShadowMapRenderSP reading asset::PackedVertex, used when RenderConfig::packedVertices is set
+class ShadowMapRenderPackedSP : public ShadowMapRenderSP
+{
+public:
+    explicit ShadowMapRenderPackedSP(RenderDevice* pRenderDevice) :
+        ShadowMapRenderSP(pRenderDevice,
+                          "ShadowMapRenderPackedSP",
+                          "ShadowMapping/evsm_packed.vert.spv")
+    {}
+
+    // PushConstantsData followed by the submesh quantization bounds
+    struct PackedPushConstantsData
+    {
+        PushConstantsData base;
+        uint32_t padding[3];
+        Vec4 posOffset;
+        Vec4 posScale;
+    } packedPushConstantsData;
+};
+
+// ShadowMapRenderSP for RenderConfig::gpuDrivenDraws, nodeIndex and materialIndex of the push
+// constants are unused
+class ShadowMapRenderIndirectSP : public ShadowMapRenderSP
+{
+public:
+    explicit ShadowMapRenderIndirectSP(RenderDevice* pRenderDevice) :
+        ShadowMapRenderSP(pRenderDevice,
+                          "ShadowMapRenderIndirectSP",
+                          "ShadowMapping/evsm_indirect.vert.spv")
+    {}
 };
 
 class ShaderProgramManager
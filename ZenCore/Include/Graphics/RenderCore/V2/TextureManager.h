@@ -38,10 +38,11 @@ private:
                        const uint8_t* pData,
                        bool generateMipmaps = false);
 
-    void UpdateTextureCube(RHITexture* pTexture,
-                           const HeapVector<RHIBufferTextureCopyRegion>& regions,
-                           uint32_t dataSize,
-                           const uint8_t* pData);
+    // one staging buffer copied through several regions, e.g. cube faces or mip levels
+    void UpdateTextureRegions(RHITexture* pTexture,
+                              const HeapVector<RHIBufferTextureCopyRegion>& regions,
+                              uint32_t dataSize,
+                              const uint8_t* pData);
 
     // void UpdateTexture(const RHITexture* textureHandle,
     //                    const Vec3i& textureSize,
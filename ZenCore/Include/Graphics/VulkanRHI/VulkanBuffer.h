@@ -41,6 +41,9 @@ public:
         return m_bufferView;
     }
 
+    // transient buffers only
+    void BindMemory(const VulkanMemoryBlock* pMemoryBlock, uint64_t offset);
+
 protected:
     void Init() override;
 
@@ -53,5 +56,7 @@ private:
     uint32_t m_allocatedSize{0};
     VkBufferView m_bufferView{VK_NULL_HANDLE};
     VulkanMemoryAllocation m_memAlloc{};
+    // transient buffers are bound once
+    bool m_bound{false};
 };
 } // namespace zen
\ No newline at end of file
@@ -18,6 +18,7 @@ class VulkanPipeline;
 class FVulkanCommandBufferPool;
 class VulkanFence;
 class VulkanSemaphore;
+class VulkanPipelineBarrier;
 class VulkanQueue;
 struct RHIRenderingLayout;
 class FVulkanCommandListContext;
@@ -314,11 +315,18 @@ public:
         return m_lastSubmittedSerial;
     }
 
+    // called with the first collected workload before the workloads are queued, in submission
+    // order
+    virtual void ReconcileImageLayouts(VulkanWorkload* pFirstWorkload) {}
+
 protected:
     void FinalizePendingRenderPassWorkload();
 
     void MarkRenderPassWorkloadEndPending();
 
+    // begins a command buffer that runs ahead of the others of pWorkload, the caller ends it
+    FVulkanCommandBuffer* PrependCommandBuffer(VulkanWorkload* pWorkload);
+
 private:
     enum class WorkloadPhase : uint8_t
     {
@@ -333,6 +341,9 @@ private:
 
     void FinalizePendingWorkload();
 
+    // returns a command buffer of the pool that has begun recording
+    FVulkanCommandBuffer* AcquireCommandBuffer();
+
     void SetupNewCommandBuffer();
 
     void StartWorkload();
@@ -470,6 +481,16 @@ public:
                                 uint32_t drawCount,
                                 uint32_t stride) override;
 
+    void RHIDrawIndexedIndirectCount(RHIBuffer* pIndirectBuffer,
+                                     RHIBuffer* pIndexBuffer,
+                                     DataFormat indexFormat,
+                                     uint32_t indexBufferOffset,
+                                     uint32_t offset,
+                                     RHIBuffer* pCountBuffer,
+                                     uint32_t countBufferOffset,
+                                     uint32_t maxDrawCount,
+                                     uint32_t stride) override;
+
     void RHIDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
 
     void RHIDispatchIndirect(RHIBuffer* pIndirectBuffer, uint32_t offset) override;
@@ -517,10 +538,45 @@ public:
 
     void RHIWaitUntilCompleted() override;
 
+    void RHISetBarrierEvent(RHIBarrierEvent* pEvent,
+                            BitField<RHIPipelineStageBits> srcStages,
+                            BitField<RHIPipelineStageBits> dstStages,
+                            VectorView<RHIBufferTransition> bufferTransitions,
+                            VectorView<RHITextureTransition> textureTransitions) override;
+
+    void RHIWaitBarrierEvent(RHIBarrierEvent* pEvent) override;
+
+    // moves the layouts the list expected to find into place ahead of the list, then publishes
+    // the layouts it left the images in to the RHI
+    void ReconcileImageLayouts(VulkanWorkload* pFirstWorkload) override;
+
     // todo: need a function to collect recorded workload in this context
 private:
+    // resolves the image layouts and adds the barriers of the transitions to barrier
+    void AddTransitionBarriers(VectorView<RHIBufferTransition> bufferTransitions,
+                               VectorView<RHITextureTransition> textureTransitions,
+                               VulkanPipelineBarrier& barrier);
+
+    // layout of the image at this point of the list. The first use takes expectedLayout, or the
+    // RHI wide layout if it is undefined, and remembers it for ReconcileImageLayouts
+    VkImageLayout GetImageLayout(VulkanTexture* pVulkanTexture,
+                                 VkImageLayout expectedLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+
+    void SetImageLayout(VkImage image, VkImageLayout layout);
+
+    struct InitialImageLayout
+    {
+        VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+        VkImageSubresourceRange range{};
+    };
+
     RHICommandContextType m_contextType;
 
+    // lists are finalized in parallel, the RHI wide layouts are only updated at submit time.
+    // Until then the list keeps the layouts it expects images in and the ones it leaves them in
+    HashMap<VkImage, InitialImageLayout> m_initialImageLayouts;
+    HashMap<VkImage, VkImageLayout> m_imageLayouts;
+
     VulkanDevice* m_pDevice{nullptr};
 
     VulkanGfxState* m_pGfxState{nullptr};
@@ -13,6 +13,8 @@ class LegacyVulkanCommandListContext;
 class LegacyVulkanCommandList;
 class VulkanFenceManager;
 class VulkanSemaphoreManager;
+class VulkanBarrierEventManager;
+class VulkanPipelineCache;
 
 struct DeviceExtensionFlags
 {
@@ -26,6 +28,8 @@ struct DeviceExtensionFlags
     uint32_t hasDeferredHostOperation : 1;
     uint32_t hasSPIRV_14 : 1;
     uint32_t hasDynamicRendering : 1;
+    uint32_t hasDrawIndirectCount : 1;
+    uint32_t hasSynchronization2 : 1;
 };
 
 class VulkanDevice
@@ -74,6 +78,12 @@ public:
         return m_pSemaphoreManger;
     }
 
+    // shared by every pipeline created on this device, persisted at RHIOptions::VKPipelineCachePath
+    VulkanPipelineCache* GetPipelineCache() const
+    {
+        return m_pPipelineCache;
+    }
+
     VulkanQueue* GetGfxQueue() const
     {
         return m_pGfxQueue;
@@ -116,6 +126,21 @@ public:
         return m_extensionFlags.hasTimelineSemaphore != 0;
     }
 
+    bool SupportsDrawIndirectCount() const
+    {
+        return m_extensionFlags.hasDrawIndirectCount != 0;
+    }
+
+    bool SupportsSynchronization2() const
+    {
+        return m_extensionFlags.hasSynchronization2 != 0;
+    }
+
+    VulkanBarrierEventManager* GetBarrierEventManager() const
+    {
+        return m_pBarrierEventManager;
+    }
+
     // LegacyVulkanCommandListContext* GetLegacyImmediateCmdContext() const
     // {
     //     return m_legacyImmediateContext;
@@ -158,7 +183,11 @@ private:
     VulkanQueue* m_pComputeQueue{nullptr};
     VulkanQueue* m_pTransferQueue{nullptr};
 
+    VulkanBarrierEventManager* m_pBarrierEventManager{nullptr};
+
     VulkanFenceManager* m_pFenceManager;
     VulkanSemaphoreManager* m_pSemaphoreManger;
+
+    VulkanPipelineCache* m_pPipelineCache{nullptr};
 };
 } // namespace zen
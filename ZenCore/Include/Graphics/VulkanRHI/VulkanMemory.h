@@ -2,6 +2,7 @@
 #include <vk_mem_alloc.h>
 #include "Templates/HashMap.h"
 #include "Graphics/RHI/RHICommon.h"
+#include "Graphics/RHI/RHIResource.h"
 
 namespace zen
 {
@@ -42,10 +43,47 @@ public:
 
     void FreeBuffer(VkBuffer buffer, const VulkanMemoryAllocation& memAlloc);
 
+    // device local memory that transient images and buffers are bound into
+    void AllocMemoryBlock(const VkMemoryRequirements& requirements,
+                          VulkanMemoryAllocation* pAllocation);
+
+    void FreeMemoryBlock(const VulkanMemoryAllocation& memAlloc);
+
+    void BindImageMemory(const VulkanMemoryAllocation& memAlloc,
+                         VkDeviceSize offset,
+                         VkImage image);
+
+    void BindBufferMemory(const VulkanMemoryAllocation& memAlloc,
+                          VkDeviceSize offset,
+                          VkBuffer buffer);
+
 private:
     VmaPool GetOrCreateSmallAllocPools(MemoryTypeIndex memTypeIndex);
 
     VmaAllocator m_vmaAllocator{VK_NULL_HANDLE};
     HashMap<MemoryTypeIndex, VmaPool> m_smallPools;
 };
+
+class VulkanMemoryBlock : public RHIMemoryBlock
+{
+public:
+    static VulkanMemoryBlock* CreateObject(const RHIMemoryRequirements& requirements);
+
+    const VulkanMemoryAllocation& GetMemoryAllocation() const
+    {
+        return m_memAlloc;
+    }
+
+protected:
+    void Init() override;
+
+    void Destroy() override;
+
+private:
+    explicit VulkanMemoryBlock(const RHIMemoryRequirements& requirements) :
+        RHIMemoryBlock(requirements)
+    {}
+
+    VulkanMemoryAllocation m_memAlloc{};
+};
 } // namespace zen
\ No newline at end of file
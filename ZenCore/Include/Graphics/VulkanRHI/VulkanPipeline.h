@@ -130,7 +130,9 @@ private:
     VulkanDescriptorPoolKey m_descriptorPoolKey{};
 };
 
-using VulkanDescriptorPools = HashMap<VulkanDescriptorPoolKey, HashMap<VkDescriptorPool, uint32_t>>;
+// descriptor sets keep an iterator to their pool entry, the outer map must not move elements
+using VulkanDescriptorPools =
+    StableHashMap<VulkanDescriptorPoolKey, HashMap<VkDescriptorPool, uint32_t>>;
 using VulkanDescriptorPoolsIt = VulkanDescriptorPools::iterator;
 
 class VulkanDescriptorPoolManager
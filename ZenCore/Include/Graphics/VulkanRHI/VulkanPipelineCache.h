@@ -0,0 +1,80 @@
+#pragma once
+#include "VulkanHeaders.h"
+#include <string>
+#include <vector>
+
+namespace zen
+{
+class VulkanDevice;
+
+// VkPipelineCache kept on disk between runs. The driver blob is stored behind a header with the
+// device identity and a content hash. A file written for another device or driver, or one that
+// is truncated or corrupted, is dropped and the cache starts empty.
+class VulkanPipelineCache
+{
+public:
+    static constexpr uint32_t cMagic   = 0x4350565A; // "ZVPC"
+    static constexpr uint32_t cVersion = 1;
+
+    // an empty path keeps the cache in memory only
+    void Init(VulkanDevice* pDevice, const std::string& path);
+
+    // returns true if the file was written, false if the cache holds nothing the file does not
+    // have already or the write failed
+    bool Save();
+
+    // saves, then destroys the VkPipelineCache
+    void Destroy();
+
+    VkPipelineCache GetVkHandle() const
+    {
+        return m_pipelineCache;
+    }
+
+    bool IsLoadedFromDisk() const
+    {
+        return m_loadedFromDisk;
+    }
+
+    static std::vector<uint8_t> PackCacheFile(const VkPhysicalDeviceProperties& properties,
+                                              const uint8_t* pData,
+                                              size_t dataSize);
+
+    // fills data with the driver blob of a file written by PackCacheFile, returns false and
+    // leaves data empty if anything does not match
+    static bool UnpackCacheFile(const VkPhysicalDeviceProperties& properties,
+                                const uint8_t* pFile,
+                                size_t fileSize,
+                                std::vector<uint8_t>& data);
+
+private:
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vendorID;
+        uint32_t deviceID;
+        uint32_t driverVersion;
+        uint32_t padding;
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+        uint64_t dataSize;
+        uint64_t dataHash;
+    };
+
+    // checks the VkPipelineCacheHeaderVersionOne the driver puts in front of its data
+    static bool ValidateDriverHeader(const VkPhysicalDeviceProperties& properties,
+                                     const uint8_t* pData,
+                                     size_t dataSize);
+
+    VulkanDevice* m_pDevice{nullptr};
+
+    VkPipelineCache m_pipelineCache{VK_NULL_HANDLE};
+
+    std::string m_path;
+
+    // hash of the data last read from or written to m_path
+    uint64_t m_fileDataHash{0};
+
+    bool m_loadedFromDisk{false};
+};
+} // namespace zen
@@ -3,6 +3,7 @@
 #include "VulkanHeaders.h"
 #include "Templates/HeapVector.h"
 #include "Templates/Queue.h"
+#include "Utils/Mutex.h"
 
 namespace zen
 {
@@ -113,6 +114,8 @@ private:
     VulkanCommandBuffer* m_pLastSubmittedCmdBuffer{nullptr};
 
     HeapVector<FVulkanCommandBufferPool*> m_cmdBufferPools;
+    // command list contexts of this queue may be finalized on worker threads
+    Mutex m_workloadPoolMutex;
     HeapVector<VulkanWorkload*> m_workloadPool;
 
     Queue<VulkanWorkload*> m_workloadsPendingSubmit;  // queued workloads, need to submit
@@ -4,6 +4,7 @@
 #include "Memory/PagedAllocator.h"
 #include "Templates/HashMap.h"
 #include "Templates/ObjectPool.h"
+#include "Utils/Mutex.h"
 #include "Graphics/RHI/DynamicRHI.h"
 #include "Graphics/RHI/RHICommands.h"
 #include "Graphics/VulkanRHI/VulkanPlatformCommandList.h"
@@ -27,6 +28,7 @@ class VulkanShader;
 class VulkanTexture;
 class VulkanBuffer;
 class VulkanSampler;
+class VulkanMemoryBlock;
 class VulkanDescriptorSet;
 class VulkanPipeline;
 class VulkanCommandBuffer;
@@ -39,6 +41,7 @@ using VersatileResource = VersatileResourceTemplate<VulkanShader,
                                                     VulkanTexture,
                                                     VulkanSampler,
                                                     VulkanBuffer,
+                                                    VulkanMemoryBlock,
                                                     VulkanDescriptorSet,
                                                     VulkanPipeline,
                                                     VulkanViewport>;
@@ -183,6 +186,16 @@ public:
     RHIBuffer* CreateBuffer(const RHIBufferCreateInfo& createInfo) final;
 
     void DestroyBuffer(RHIBuffer* pBuffer) final;
+
+    RHIMemoryBlock* CreateMemoryBlock(const RHIMemoryRequirements& requirements) final;
+
+    void DestroyMemoryBlock(RHIMemoryBlock* pMemoryBlock) final;
+
+    void BindTextureMemory(RHITexture* pTexture,
+                           RHIMemoryBlock* pMemoryBlock,
+                           uint64_t offset) final;
+
+    void BindBufferMemory(RHIBuffer* pBuffer, RHIMemoryBlock* pMemoryBlock, uint64_t offset) final;
     //
     // void SetBufferTexelFormat(BufferHandle bufferHandle, DataFormat format) final;
 
@@ -193,6 +206,8 @@ public:
     // void UpdateDescriptorSet(DescriptorSetHandle descriptorSetHandle,
     //                          const HeapVector<RHIShaderResourceBinding>& resourceBindings) final;
 
+    RHIPlatformCommandList* FinalizeCommandList(RHICommandList* pCmdList) final;
+
     void FinalizeCommandLists(VectorView<RHICommandList*> cmdLists,
                               HeapVector<RHIPlatformCommandList*>& outCommandLists) final;
 
@@ -272,20 +287,26 @@ private:
 
     // allocator for memory
     // VulkanMemoryAllocator* m_vkMemAllocator{nullptr};
-    // allocators for resources
+    // allocators for resources, thread safe since pipelines are also created on
+    // rc::PipelineCompiler workers
     PagedAllocator<VersatileResource> m_resourceAllocator;
 
     // HashMap<RHIShader*, VulkanPipeline*> m_shaderPipelines;
 
     // used when ChangeTextureLayout or AddPipelineBarrier is called,
-    // primarily applied outside the RenderGraph.
+    // primarily applied outside the RenderGraph. Command list contexts track their own layouts
+    // while they are finalized and merge them in here at submit time
     HashMap<VkImage, VkImageLayout> m_imageLayoutCache;
+    Mutex m_imageLayoutCacheMutex;
 
     HashMap<uint32_t, VkRenderPass> m_renderPassCache;
+    Mutex m_renderPassCacheMutex;
 
     HashMap<uint32_t, VkFramebuffer> m_framebufferCache;
+    Mutex m_framebufferCacheMutex;
 
     ObjectPool<VulkanPlatformCommandList> m_platformCommandListPool;
+    Mutex m_platformCommandListPoolMutex;
 };
 
 class VulkanResourceFactory : public RHIResourceFactory
@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 #include <queue>
 #include "VulkanCommon.h"
 #include "Graphics/RHI/RHIResource.h"
@@ -166,15 +167,81 @@ public:
     //              BitField<RHIPipelineStageBits> srcStages,
     //              BitField<RHIPipelineStageBits> dstStages);
 
+    // same as Execute with one vkCmdPipelineBarrier2KHR, needs VK_KHR_synchronization2
+    void Execute2(VkCommandBuffer cmdBuffer,
+                  VkPipelineStageFlags srcStageFlags,
+                  VkPipelineStageFlags dstStageFlags);
+
+    // halves of a split barrier, both need the same barriers and stages. The barriers are kept
+    // after the set and cleared by the wait
+    void SetEvent2(VkCommandBuffer cmdBuffer,
+                   VkEvent event,
+                   VkPipelineStageFlags srcStageFlags,
+                   VkPipelineStageFlags dstStageFlags);
+
+    void WaitEvent2(VkCommandBuffer cmdBuffer,
+                    VkEvent event,
+                    VkPipelineStageFlags srcStageFlags,
+                    VkPipelineStageFlags dstStageFlags);
+
+    bool IsEmpty() const
+    {
+        return m_memoryBarriers.empty() && m_bufferBarriers.empty() && m_imageBarriers.empty();
+    }
+
 private:
     static VkPipelineStageFlags VkLayoutToPipelineStageFlags(VkImageLayout layout);
     static VkAccessFlags VkLayoutToAccessFlags(VkImageLayout layout);
 
+    // converts the recorded barriers, dependencyInfo points into the *2 vectors
+    void BuildDependencyInfo(VkPipelineStageFlags srcStageFlags,
+                             VkPipelineStageFlags dstStageFlags,
+                             VkDependencyInfoKHR& dependencyInfo);
+
+    void Clear();
+
     VkPipelineStageFlags m_srcStageFlags{0};
     VkPipelineStageFlags m_dstStageFlags{0};
 
     HeapVector<VkImageMemoryBarrier> m_imageBarriers;
     HeapVector<VkMemoryBarrier> m_memoryBarriers;
     HeapVector<VkBufferMemoryBarrier> m_bufferBarriers;
+
+    HeapVector<VkImageMemoryBarrier2KHR> m_imageBarriers2;
+    HeapVector<VkMemoryBarrier2KHR> m_memoryBarriers2;
+    HeapVector<VkBufferMemoryBarrier2KHR> m_bufferBarriers2;
+};
+
+// split barriers behind RHIBarrierEvent. Shared by the contexts of a device, a render graph may
+// set an event in one list and wait for it in a later list of the same queue
+class VulkanBarrierEventManager
+{
+public:
+    struct BarrierEvent
+    {
+        // null without VK_KHR_synchronization2, the wait then records a plain pipeline barrier
+        VkEvent event{VK_NULL_HANDLE};
+        VkPipelineStageFlags srcStageFlags{0};
+        VkPipelineStageFlags dstStageFlags{0};
+        VulkanPipelineBarrier barrier;
+    };
+
+    explicit VulkanBarrierEventManager(VulkanDevice* pDevice) : m_pDevice(pDevice) {}
+
+    void Destroy();
+
+    // handles start at 1, 0 is an event that was never set
+    uint64_t AllocateEvent();
+
+    BarrierEvent* GetEvent(uint64_t handle);
+
+    // the event is reset by the wait, later sets on the same queue may reuse it
+    void ReleaseEvent(uint64_t handle);
+
+private:
+    VulkanDevice* m_pDevice{nullptr};
+    std::mutex m_mutex;
+    HeapVector<BarrierEvent*> m_events;
+    HeapVector<uint32_t> m_freeEvents;
 };
 } // namespace zen
\ No newline at end of file
@@ -125,6 +125,9 @@ public:
         return m_vkImageCI.usage;
     }
 
+    // transient textures only, creates the image view
+    void BindMemory(const VulkanMemoryBlock* pMemoryBlock, uint64_t offset);
+
 protected:
     void Init() override;
 
@@ -117,6 +117,18 @@ private:
     };
 
     static constexpr uint32_t cMaxTrackedAllocationSites = 4096;
+    // the site table is split into independently locked shards so that threads allocating from
+    // different sites do not contend on a single lock
+    static constexpr uint32_t cNumAllocationSiteShards = 16;
+    static constexpr uint32_t cAllocationSitesPerShard =
+        cMaxTrackedAllocationSites / cNumAllocationSiteShards;
+
+    struct alignas(64) AllocationSiteShard
+    {
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        bool overflow{false};
+        AllocationSiteStats sites[cAllocationSitesPerShard]{};
+    };
 
     void TrackAllocationSiteAlloc(size_t size,
                                   const char* pFileName,
@@ -125,11 +137,16 @@ private:
 
     void TrackAllocationSiteFree(size_t size, const char* pFileName, uint32_t lineNum);
 
-    AllocationSiteStats* FindOrAddAllocationSite(const char* pFileName, uint32_t lineNum);
+    AllocationSiteStats* FindOrAddAllocationSite(AllocationSiteShard& shard,
+                                                 uintptr_t hash,
+                                                 const char* pFileName,
+                                                 uint32_t lineNum);
+
+    static uintptr_t HashAllocationSite(const char* pFileName, uint32_t lineNum);
 
-    void LockAllocationSiteStats();
+    static void LockAllocationSiteShard(AllocationSiteShard& shard);
 
-    void UnlockAllocationSiteStats();
+    static void UnlockAllocationSiteShard(AllocationSiteShard& shard);
 
     static void* DefaultAllocImpl(size_t size, size_t alignment);
 
@@ -150,9 +167,7 @@ private:
     std::atomic<size_t> m_totalFreed{0};
     std::atomic<size_t> m_currentUsage{0};
     std::atomic<size_t> m_peakUsage{0};
-    std::atomic_flag m_allocationSiteStatsLock = ATOMIC_FLAG_INIT;
-    AllocationSiteStats m_allocationSiteStats[cMaxTrackedAllocationSites]{};
-    bool m_allocationSiteStatsOverflow{false};
+    AllocationSiteShard m_allocationSiteShards[cNumAllocationSiteShards]{};
 };
 
 // template <typename T, typename... Args> T* MemNew(Args&&... args)
@@ -27,8 +27,16 @@ public:
         if (pMem != nullptr)
             return pMem;
 
-        // current allocator is full -> create a bigger one
-        size_t newSize = pAlloc->Capacity() * 2;
+        // current allocator is full -> move on to the ones kept from before the last reset
+        while (m_currentIndex + 1 < m_allocators.size())
+        {
+            pMem = m_allocators[++m_currentIndex]->Alloc(size, alignment);
+            if (pMem != nullptr)
+                return pMem;
+        }
+
+        // all of them are full -> create a bigger one
+        size_t newSize = m_allocators[m_currentIndex]->Capacity() * 2;
         if (newSize < size)
             newSize = size * 2;
 
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace zen
+{
+/// Size class slab allocator with per-thread caches.
+///
+/// Small requests are rounded up to one of cNumSizeClasses size classes. Each class is carved out
+/// of 64KB aligned spans reserved from the OS, a page map records the size class of every span
+/// page so that Free() does not need a size. Every thread keeps a free list per class and
+/// exchanges blocks with the central heap in batches, so the common path takes no lock.
+/// Spans are never returned to the OS.
+class SizeClassAllocator
+{
+public:
+    static constexpr size_t cMaxSmallSize    = 32 * 1024;
+    static constexpr size_t cMinAlignment    = 16;
+    static constexpr uint32_t cNumSizeClasses = 40;
+    static constexpr uint32_t cPageShift      = 16;
+    static constexpr size_t cPageSize        = size_t(1) << cPageShift;
+
+    /// Whether a request can be served by the size class allocator.
+    static bool IsSmall(size_t size, size_t alignment)
+    {
+        return size > 0 && size <= cMaxSmallSize && alignment <= cMinAlignment;
+    }
+
+    /// Returns nullptr if the OS refused to back a new span.
+    static void* Alloc(size_t size);
+
+    /// pMem must be owned by this allocator, see Owns().
+    static void Free(void* pMem);
+
+    /// Whether pMem was returned by Alloc().
+    static bool Owns(const void* pMem);
+
+    /// Usable size of a block returned by Alloc(), 0 if not owned.
+    static size_t GetBlockSize(const void* pMem);
+
+    /// Rounds size up to its size class, 0 if the size is not small.
+    static size_t GetSizeClassSize(size_t size);
+
+    /// Total bytes reserved from the OS for spans.
+    static size_t GetReservedBytes();
+
+    /// Returns every block cached by the calling thread to the central heap.
+    static void FlushThreadCache();
+};
+} // namespace zen
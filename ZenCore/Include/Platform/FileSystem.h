@@ -11,6 +11,13 @@ class FileSystem
 public:
     static std::string LoadTextFile(const std::string& path);
 
+    // writes to tempPath next to the target, path + ".tmp" if empty, and renames it over path so
+    // a crashed write never leaves a partial file. Creates missing parent directories
+    static bool WriteBinaryFileAtomic(const std::string& path,
+                                      const uint8_t* pData,
+                                      size_t size,
+                                      const std::string& tempPath = {});
+
     template <typename T = uint8_t> static HeapVector<T> LoadSpvFile(const std::string& name)
     {
         const auto path = std::string(SPV_SHADER_PATH) + name;
@@ -39,4 +46,39 @@ public:
         return buffer;
     }
 };
+
+// Read only mapping of a whole file, pages are loaded by the OS on first access instead of read
+// up front. The view stays valid until Close() or destruction.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+
+    ~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // returns false if the file can not be opened or is empty
+    bool Open(const std::string& path);
+
+    void Close();
+
+    const uint8_t* GetData() const
+    {
+        return m_pData;
+    }
+
+    size_t GetSize() const
+    {
+        return m_size;
+    }
+
+private:
+    const uint8_t* m_pData{nullptr};
+    size_t m_size{0};
+};
 } // namespace zen::platform
@@ -0,0 +1,117 @@
+#pragma once
+#include <vector>
+#include "Math/Math.h"
+
+namespace zen
+{
+class JobSystem;
+} // namespace zen
+
+namespace zen::sg
+{
+class Node;
+class SubMesh;
+
+// 64 bit draw sort key, from the most significant field: pass, pipeline, material, depth. Sorted
+// keys group the draws of a pass by pipeline and material to save state changes, each group is
+// ordered by depth. Back to front keys have no pipeline and material, blending needs the whole
+// pass in depth order.
+class DrawKey
+{
+public:
+    static constexpr uint32_t cPassBits     = 4;
+    static constexpr uint32_t cPipelineBits = 12;
+    static constexpr uint32_t cMaterialBits = 16;
+    static constexpr uint32_t cDepthBits    = 32;
+
+    static constexpr uint32_t cMaterialShift = cDepthBits;
+    static constexpr uint32_t cPipelineShift = cMaterialShift + cMaterialBits;
+    static constexpr uint32_t cPassShift     = cPipelineShift + cPipelineBits;
+
+    // fields are masked to their width, depth is a view distance (negative counts as 0) sorted
+    // front to back unless backToFront is set, which drops pipeline and material
+    static uint64_t Make(uint32_t pass,
+                         uint32_t pipeline,
+                         uint32_t material,
+                         float depth,
+                         bool backToFront = false);
+
+    static uint32_t GetPass(uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> cPassShift) & ((1u << cPassBits) - 1);
+    }
+
+    static uint32_t GetPipeline(uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> cPipelineShift) & ((1u << cPipelineBits) - 1);
+    }
+
+    static uint32_t GetMaterial(uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> cMaterialShift) & ((1u << cMaterialBits) - 1);
+    }
+
+    // bits of a non-negative float order like the float itself
+    static uint32_t EncodeDepth(float depth);
+};
+
+struct DrawItem
+{
+    Node* pNode{nullptr};
+    SubMesh* pSubMesh{nullptr};
+};
+
+// Flat list of draws sorted by DrawKey with RadixSort. Arrays keep their capacity between frames,
+// a rebuilt list does not allocate once it reached its size.
+class DrawList
+{
+public:
+    // keeps the capacity
+    void Clear();
+
+    void Reserve(uint32_t count);
+
+    void Add(uint64_t key, Node* pNode, SubMesh* pSubMesh)
+    {
+        m_keys.push_back(key);
+        m_items.push_back({pNode, pSubMesh});
+    }
+
+    // stable, draws with equal keys stay in the order they were added
+    void Sort(JobSystem* pJobSystem = nullptr);
+
+    uint32_t GetSize() const
+    {
+        return static_cast<uint32_t>(m_items.size());
+    }
+
+    bool IsEmpty() const
+    {
+        return m_items.empty();
+    }
+
+    const DrawItem& operator[](uint32_t index) const
+    {
+        return m_items[index];
+    }
+
+    const std::vector<DrawItem>& GetItems() const
+    {
+        return m_items;
+    }
+
+    const std::vector<uint64_t>& GetKeys() const
+    {
+        return m_keys;
+    }
+
+private:
+    std::vector<uint64_t> m_keys;
+    std::vector<DrawItem> m_items;
+    // sort scratch
+    std::vector<uint32_t> m_order;
+    std::vector<uint64_t> m_scratchKeys;
+    std::vector<uint32_t> m_scratchOrder;
+    std::vector<DrawItem> m_sortedItems;
+};
+} // namespace zen::sg
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <limits>
 #include "Templates/HashMap.h"
 #include "Math/Math.h"
 #include "Component.h"
@@ -55,6 +56,11 @@ public:
         return m_pParent;
     }
 
+    const auto& GetChildren() const
+    {
+        return m_children;
+    }
+
     auto& GetName() const
     {
         return m_name;
@@ -70,6 +76,17 @@ public:
         return m_renderableIndex;
     }
 
+    // index into the scene transform hierarchy
+    auto GetTransformIndex() const
+    {
+        return m_transformIndex;
+    }
+
+    void SetTransformIndex(uint32_t index)
+    {
+        m_transformIndex = index;
+    }
+
     uint64_t GetHash() const
     {
         return *(reinterpret_cast<const uint64_t*>(this));
@@ -98,6 +115,8 @@ private:
 
     uint32_t m_renderableIndex{0};
 
+    uint32_t m_transformIndex{std::numeric_limits<uint32_t>::max()};
+
     std::string m_name;
 
     Node* m_pParent{nullptr};
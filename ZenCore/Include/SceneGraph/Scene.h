@@ -4,6 +4,9 @@
 #include "Mesh.h"
 #include "Sampler.h"
 #include "Transform.h"
+#include "TransformHierarchy.h"
+#include "SceneBVH.h"
+#include "DrawList.h"
 #include "Light.h"
 
 namespace zen::sg
@@ -32,8 +35,13 @@ public:
         return m_renderableNodes.size();
     }
 
-    std::vector<std::pair<Node*, SubMesh*>> GetSortedSubMeshes(const Vec3& eyePos,
-                                                               const Mat4& transform);
+    // fills drawList with every submesh of every mesh node, keyed by alpha mode (pass), double
+    // sidedness (pipeline), material and the distance of the bounds center to eyePos, then sorts
+    // it. Blended draws sort back to front.
+    void BuildDrawList(const Vec3& eyePos,
+                       const Mat4& transform,
+                       DrawList& drawList,
+                       JobSystem* pJobSystem = nullptr);
 
     void AddRenderableNode(Node* pNode)
     {
@@ -91,6 +99,35 @@ public:
 
     void UpdateAABB();
 
+    // flattens the node transforms into the transform hierarchy, nodes without a Transform
+    // component are identity. Node::GetTransformIndex addresses the nodes afterwards.
+    void BuildTransformHierarchy();
+
+    // updates the dirty part of the hierarchy and refreshes NodeData of the renderable nodes in it,
+    // a built BVH is refitted when any of them moved. Returns whether one moved.
+    bool UpdateTransforms(JobSystem* pJobSystem = nullptr);
+
+    // call once NodeData holds the final model matrices
+    void BuildBVH()
+    {
+        m_bvh.Build(this);
+    }
+
+    const SceneBVH& GetBVH() const
+    {
+        return m_bvh;
+    }
+
+    TransformHierarchy& GetTransformHierarchy()
+    {
+        return m_transformHierarchy;
+    }
+
+    const TransformHierarchy& GetTransformHierarchy() const
+    {
+        return m_transformHierarchy;
+    }
+
     auto GetSize() const
     {
         return m_aabb.GetScale();
@@ -126,6 +163,8 @@ public:
     }
 
 private:
+    void AddTransformHierarchyNode(Node* pNode, uint32_t parent);
+
     std::string m_name;
 
     // aabb without transformation
@@ -137,6 +176,10 @@ private:
 
     std::vector<Node*> m_renderableNodes;
 
+    TransformHierarchy m_transformHierarchy;
+
+    SceneBVH m_bvh;
+
     Node* m_pRootNode{nullptr};
 
     HashMap<TypeId, std::vector<UniquePtr<Component>>> m_components;
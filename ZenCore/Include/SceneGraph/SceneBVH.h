@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include "AABB.h"
+
+namespace zen
+{
+class Frustum;
+} // namespace zen
+
+namespace zen::sg
+{
+class Scene;
+class Node;
+class SubMesh;
+
+// 4-wide bounding volume hierarchy over world space submesh bounds. Each node stores the boxes
+// of its 4 children as center/extent arrays so one frustum plane is tested against all of them
+// with a single SIMD expression. Children are either inner nodes or single items, items below a
+// node are a contiguous range of the build order.
+class SceneBVH
+{
+public:
+    // one submesh of one renderable node
+    struct Item
+    {
+        Node* pNode{nullptr};
+        SubMesh* pSubMesh{nullptr};
+    };
+
+    // collects the submeshes of the renderable nodes, bounds come from NodeData::modelMatrix
+    void Build(Scene* pScene);
+
+    // items without scene objects, used by tests and benchmarks
+    void Build(const std::vector<AABB>& bounds);
+
+    // recomputes item bounds from the node model matrices and refits the tree bottom up,
+    // the topology is kept
+    void Refit();
+
+    void Refit(const std::vector<AABB>& bounds);
+
+    // appends the indices of the items intersecting the frustum, in tree order
+    void Cull(const Frustum& frustum, std::vector<uint32_t>& visibleItems) const;
+
+    void Clear();
+
+    bool IsEmpty() const
+    {
+        return m_items.empty();
+    }
+
+    uint32_t GetNumItems() const
+    {
+        return static_cast<uint32_t>(m_items.size());
+    }
+
+    const Item& GetItem(uint32_t index) const
+    {
+        return m_items[index];
+    }
+
+    uint32_t GetNumNodes() const
+    {
+        return static_cast<uint32_t>(m_nodes.size());
+    }
+
+    // bounds of the transformed box, unlike AABB::Transform this covers rotations
+    static AABB TransformAABB(const AABB& aabb, const Mat4& model);
+
+private:
+    static constexpr uint32_t cWidth     = 4;
+    static constexpr uint32_t cItemFlag  = 0x80000000u;
+    static constexpr uint32_t cEmptySlot = 0xFFFFFFFFu;
+
+    struct alignas(16) BVHNode
+    {
+        float centerX[cWidth];
+        float centerY[cWidth];
+        float centerZ[cWidth];
+        float extentX[cWidth];
+        float extentY[cWidth];
+        float extentZ[cWidth];
+        // inner node index, item index | cItemFlag or cEmptySlot
+        uint32_t children[cWidth];
+        // range of m_itemOrder below this node
+        uint32_t firstItem;
+        uint32_t numItems;
+    };
+
+    struct ItemBounds
+    {
+        Vec3 center;
+        Vec3 extent;
+    };
+
+    void BuildTree();
+
+    uint32_t BuildNode(uint32_t begin, uint32_t end);
+
+    void SetSlot(BVHNode& node, uint32_t slot, const Vec3& center, const Vec3& extent);
+
+    void RefitNodes();
+
+    void SetItemBounds(uint32_t index, const AABB& aabb);
+
+    std::vector<Item> m_items;
+    std::vector<ItemBounds> m_itemBounds;
+    // item indices in build order
+    std::vector<uint32_t> m_itemOrder;
+    std::vector<BVHNode> m_nodes;
+};
+} // namespace zen::sg
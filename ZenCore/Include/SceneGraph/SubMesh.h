@@ -79,6 +79,23 @@ public:
         return m_aabb;
     }
 
+    // range in the meshlet data of the loader, empty unless meshlets were built
+    void SetMeshletRange(uint32_t firstMeshlet, uint32_t meshletCount)
+    {
+        m_firstMeshlet = firstMeshlet;
+        m_meshletCount = meshletCount;
+    }
+
+    auto GetFirstMeshlet() const
+    {
+        return m_firstMeshlet;
+    }
+
+    auto GetMeshletCount() const
+    {
+        return m_meshletCount;
+    }
+
     bool HasIndices() const
     {
         return m_hasIndices;
@@ -93,6 +110,8 @@ private:
     uint32_t m_firstIndex{0};
     uint32_t m_indexCount{0};
     uint32_t m_vertexCount{0};
+    uint32_t m_firstMeshlet{0};
+    uint32_t m_meshletCount{0};
 
     AABB m_aabb;
 
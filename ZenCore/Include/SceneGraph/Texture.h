@@ -51,7 +51,8 @@ public:
     uint32_t width{0};
     uint32_t height{0};
     asset::Format format{asset::Format::UNDEFINED};
-    // byte data no mipmaps
+    // number of levels in bytesData, tightly packed with level 0 first
+    uint32_t mipLevels{1};
     std::vector<uint8_t> bytesData;
 };
 
@@ -77,6 +78,9 @@ inline bool operator==(const Texture& lhs, const Texture& rhs)
     if (lhs.format != rhs.format)
         return false;
 
+    if (lhs.mipLevels != rhs.mipLevels)
+        return false;
+
     // Compare the byte data (check if sizes and contents match)
     if (lhs.bytesData.size() != rhs.bytesData.size())
         return false;
@@ -33,30 +33,48 @@ public:
     void SetLocalMatrix(const Mat4& mat)
     {
         m_localMatrix = mat;
+        InvalidateWorldMatrix();
     }
 
-    void InvalidateWorldMatrix()
+    const Vec3& GetTranslation() const
     {
-        m_updateWorldMatrix = true;
+        return m_translation;
     }
 
-    TypeId GetTypeId() const override
+    const Vec3& GetScale() const
     {
-        return typeid(Transform);
-    };
+        return m_scale;
+    }
 
-private:
+    const Quat& GetRotation() const
+    {
+        return m_rotation;
+    }
+
+    // translation, rotation and scale applied to the matrix set with SetLocalMatrix
     Mat4 GetLocalMatrix()
     {
         if (!m_validLocalMatrix)
         {
-            m_localMatrix = glm::translate(Mat4(1.0f), m_translation) * glm::mat4_cast(m_rotation) *
-                glm::scale(Mat4(1.0f), m_scale) * m_localMatrix;
+            m_combinedLocalMatrix = glm::translate(Mat4(1.0f), m_translation) *
+                glm::mat4_cast(m_rotation) * glm::scale(Mat4(1.0f), m_scale) * m_localMatrix;
             m_validLocalMatrix = true;
         }
-        return m_localMatrix;
+        return m_combinedLocalMatrix;
     }
 
+    void InvalidateWorldMatrix()
+    {
+        m_updateWorldMatrix = true;
+        m_validLocalMatrix  = false;
+    }
+
+    TypeId GetTypeId() const override
+    {
+        return typeid(Transform);
+    };
+
+private:
     void UpdateWorldMatrix();
     // binding node
     const Node& m_node;
@@ -66,6 +84,8 @@ private:
     Quat m_rotation{};
     // node local matrix
     Mat4 m_localMatrix{1.0f};
+    // translation, rotation and scale applied to the node local matrix
+    Mat4 m_combinedLocalMatrix{1.0f};
     // combined transform matrix
     Mat4 m_worldMatrix{1.0f};
     bool m_updateWorldMatrix{false};
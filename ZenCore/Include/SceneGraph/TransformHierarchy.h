@@ -0,0 +1,106 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include "Math/Math.h"
+
+namespace zen
+{
+class JobSystem;
+} // namespace zen
+
+namespace zen::sg
+{
+// Node transforms flattened in depth-first order: every parent comes before its children and
+// every subtree is a contiguous index range. Local and world transforms live in separate arrays,
+// an update is one linear pass over the dirty range instead of a parent walk per node.
+class TransformHierarchy
+{
+public:
+    static constexpr uint32_t cInvalidIndex = std::numeric_limits<uint32_t>::max();
+    // subtrees up to this size are updated by one job
+    static constexpr uint32_t cNumNodesPerJob = 4096;
+
+    // nodes must be added depth first: the parent is the last added node or one of its
+    // ancestors, cInvalidIndex starts a new root. Returns the index of the new node.
+    uint32_t AddNode(uint32_t parent,
+                     const Vec3& translation = Vec3(0.0f),
+                     const Quat& rotation    = Quat(1.0f, 0.0f, 0.0f, 0.0f),
+                     const Vec3& scale       = Vec3(1.0f));
+
+    uint32_t AddNode(uint32_t parent, const Mat4& localMatrix);
+
+    void SetLocalTransform(uint32_t index,
+                           const Vec3& translation,
+                           const Quat& rotation,
+                           const Vec3& scale);
+
+    void SetLocalMatrix(uint32_t index, const Mat4& localMatrix);
+
+    const Mat4& GetLocalMatrix(uint32_t index) const
+    {
+        return m_localMatrices[index];
+    }
+
+    // recomputes world and normal matrices of the dirty nodes and their descendants, large
+    // ranges are split into subtrees and updated on the job system when one is given
+    void Update(JobSystem* pJobSystem = nullptr);
+
+    void Clear();
+
+    void Reserve(uint32_t numNodes);
+
+    uint32_t GetNumNodes() const
+    {
+        return static_cast<uint32_t>(m_parents.size());
+    }
+
+    uint32_t GetParent(uint32_t index) const
+    {
+        return m_parents[index];
+    }
+
+    // one past the last node of the subtree rooted at index
+    uint32_t GetSubtreeEnd(uint32_t index) const
+    {
+        return m_subtreeEnds[index];
+    }
+
+    const Mat4& GetWorldMatrix(uint32_t index) const
+    {
+        return m_worldMatrices[index];
+    }
+
+    // inverse transpose of the world matrix
+    const Mat4& GetNormalMatrix(uint32_t index) const
+    {
+        return m_normalMatrices[index];
+    }
+
+    // whether the matrices of the node changed in the last update
+    bool IsUpdated(uint32_t index) const
+    {
+        return (m_flags[index] & cFlagUpdated) != 0;
+    }
+
+private:
+    static constexpr uint8_t cFlagDirty   = 1;
+    static constexpr uint8_t cFlagUpdated = 2;
+
+    void MarkDirty(uint32_t index);
+
+    void UpdateRange(uint32_t begin, uint32_t end);
+
+    std::vector<uint32_t> m_parents;
+    std::vector<uint32_t> m_subtreeEnds;
+    std::vector<Mat4> m_localMatrices;
+    std::vector<Mat4> m_worldMatrices;
+    std::vector<Mat4> m_normalMatrices;
+    std::vector<uint8_t> m_flags;
+    // nodes in [m_dirtyBegin, m_dirtyEnd) are visited by the next update
+    uint32_t m_dirtyBegin{cInvalidIndex};
+    uint32_t m_dirtyEnd{0};
+    // range visited by the last update, its updated flags are cleared by the next one
+    uint32_t m_updatedBegin{0};
+    uint32_t m_updatedEnd{0};
+};
+} // namespace zen::sg
@@ -10,6 +10,8 @@ namespace zen::sys
 class SceneEditor
 {
 public:
+    // renderable nodes of the transform hierarchy are moved by the next Scene::UpdateTransforms,
+    // the others right away
     static void CenterAndNormalizeScene(sg::Scene* pScene);
 };
 } // namespace zen::sys
\ No newline at end of file
@@ -1,7 +1,933 @@
 #pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+
+#include "Utils/Errors.h"
+#include "Memory/Memory.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define ZEN_HASHMAP_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define ZEN_HASHMAP_NEON 1
+#endif
 
 namespace zen
 {
-template <class K, class V> using HashMap = std::unordered_map<K, V>;
-}
\ No newline at end of file
+/// Default hasher of HashMap. std::string keys hash through std::string_view so that they can be
+/// looked up with string views and literals without building a temporary std::string.
+template <class K> struct HashMapHash : std::hash<K>
+{};
+
+template <> struct HashMapHash<std::string>
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const
+    {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+namespace hash_map
+{
+// control byte of every slot: empty, deleted (tombstone) or the low 7 bits of the hash when full
+using Ctrl = int8_t;
+
+static constexpr Ctrl cCtrlEmpty   = -128;
+static constexpr Ctrl cCtrlDeleted = -2;
+static constexpr size_t cGroupWidth = 16;
+
+// std::hash is the identity for integers and pointers, spread the entropy over all bits before
+// it is split into the group index (H1) and the control byte (H2)
+inline uint64_t MixHash(uint64_t hash)
+{
+    hash ^= hash >> 32;
+    hash *= 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+inline size_t H1(size_t hash)
+{
+    return hash >> 7;
+}
+
+inline Ctrl H2(size_t hash)
+{
+    return static_cast<Ctrl>(hash & 0x7F);
+}
+
+/// Set of matching slots within a group, each slot owns (1 << Shift) bits of the mask.
+template <uint32_t Shift> class BitMask
+{
+public:
+    explicit BitMask(uint64_t mask) : m_mask(mask) {}
+
+    explicit operator bool() const
+    {
+        return m_mask != 0;
+    }
+
+    uint32_t LowestIndex() const
+    {
+        return static_cast<uint32_t>(std::countr_zero(m_mask)) >> Shift;
+    }
+
+    void ClearLowest()
+    {
+        m_mask &= m_mask - 1;
+    }
+
+private:
+    uint64_t m_mask;
+};
+
+#if defined(ZEN_HASHMAP_SSE2)
+class Group
+{
+public:
+    using Mask = BitMask<0>;
+
+    explicit Group(const Ctrl* pCtrl) :
+        m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl)))
+    {}
+
+    Mask Match(Ctrl h2) const
+    {
+        return Mask(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl))));
+    }
+
+    Mask MatchEmpty() const
+    {
+        return Match(cCtrlEmpty);
+    }
+
+    // empty and deleted are the only negative control values below -1
+    Mask MatchEmptyOrDeleted() const
+    {
+        return Mask(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_ctrl))));
+    }
+
+private:
+    __m128i m_ctrl;
+};
+#elif defined(ZEN_HASHMAP_NEON)
+class Group
+{
+public:
+    // NEON has no movemask, narrowing the compare result leaves one nibble per slot
+    using Mask = BitMask<2>;
+
+    explicit Group(const Ctrl* pCtrl) : m_ctrl(vld1q_s8(pCtrl)) {}
+
+    Mask Match(Ctrl h2) const
+    {
+        return ToMask(vceqq_s8(vdupq_n_s8(h2), m_ctrl));
+    }
+
+    Mask MatchEmpty() const
+    {
+        return Match(cCtrlEmpty);
+    }
+
+    Mask MatchEmptyOrDeleted() const
+    {
+        return ToMask(vcltq_s8(m_ctrl, vdupq_n_s8(-1)));
+    }
+
+private:
+    static Mask ToMask(uint8x16_t cmp)
+    {
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+        return Mask(vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull);
+    }
+
+    int8x16_t m_ctrl;
+};
+#else
+class Group
+{
+public:
+    using Mask = BitMask<0>;
+
+    explicit Group(const Ctrl* pCtrl) : m_pCtrl(pCtrl) {}
+
+    Mask Match(Ctrl h2) const
+    {
+        uint64_t mask = 0;
+        for (uint32_t i = 0; i < cGroupWidth; ++i)
+        {
+            mask |= static_cast<uint64_t>(m_pCtrl[i] == h2) << i;
+        }
+        return Mask(mask);
+    }
+
+    Mask MatchEmpty() const
+    {
+        return Match(cCtrlEmpty);
+    }
+
+    Mask MatchEmptyOrDeleted() const
+    {
+        uint64_t mask = 0;
+        for (uint32_t i = 0; i < cGroupWidth; ++i)
+        {
+            mask |= static_cast<uint64_t>(m_pCtrl[i] < -1) << i;
+        }
+        return Mask(mask);
+    }
+
+private:
+    const Ctrl* m_pCtrl;
+};
+#endif
+} // namespace hash_map
+
+/// Open addressing hash map with elements stored inline in a flat slot array (swiss table).
+///
+/// Slots are organized in groups of 16 with one control byte each, a lookup compares all control
+/// bytes of a group against 7 bits of the hash at once and only touches slots that match. Erased
+/// slots become tombstones unless their group still has an empty slot.
+///
+/// Unlike std::unordered_map, inserting may move elements: references, pointers and iterators
+/// are invalidated by any insertion that grows the table. Erasing only invalidates the erased
+/// element. Use StableHashMap when element addresses must survive insertion.
+template <class K, class V, class Hash = HashMapHash<K>, class KeyEqual = std::equal_to<>>
+class HashMap
+{
+    using Ctrl = hash_map::Ctrl;
+
+    template <class H, class = void> struct IsTransparent : std::false_type
+    {};
+
+    template <class H>
+    struct IsTransparent<H, std::void_t<typename H::is_transparent>> : std::true_type
+    {};
+
+    // heterogeneous lookup is only offered when the hasher accepts other key types
+    template <class H> using EnableIfTransparent = std::enable_if_t<IsTransparent<H>::value>;
+
+public:
+    using key_type        = K;
+    using mapped_type     = V;
+    using value_type      = std::pair<const K, V>;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher          = Hash;
+    using key_equal       = KeyEqual;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    template <bool IsConst> class IteratorBase
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = HashMap::value_type;
+        using difference_type   = ptrdiff_t;
+        using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+        using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+        IteratorBase() = default;
+
+        template <bool OtherConst, class = std::enable_if_t<IsConst && !OtherConst>>
+        IteratorBase(const IteratorBase<OtherConst>& other) :
+            m_pCtrl(other.m_pCtrl), m_pCtrlEnd(other.m_pCtrlEnd), m_pSlot(other.m_pSlot)
+        {}
+
+        reference operator*() const
+        {
+            return *m_pSlot;
+        }
+
+        pointer operator->() const
+        {
+            return m_pSlot;
+        }
+
+        IteratorBase& operator++()
+        {
+            ++m_pCtrl;
+            ++m_pSlot;
+            SkipFreeSlots();
+            return *this;
+        }
+
+        IteratorBase operator++(int)
+        {
+            IteratorBase tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        friend bool operator==(const IteratorBase& lhs, const IteratorBase& rhs)
+        {
+            return lhs.m_pSlot == rhs.m_pSlot;
+        }
+
+        friend bool operator!=(const IteratorBase& lhs, const IteratorBase& rhs)
+        {
+            return lhs.m_pSlot != rhs.m_pSlot;
+        }
+
+    private:
+        friend class HashMap;
+        template <bool> friend class IteratorBase;
+
+        IteratorBase(const Ctrl* pCtrl, const Ctrl* pCtrlEnd, value_type* pSlot) :
+            m_pCtrl(pCtrl), m_pCtrlEnd(pCtrlEnd), m_pSlot(pSlot)
+        {}
+
+        void SkipFreeSlots()
+        {
+            while (m_pCtrl != m_pCtrlEnd && *m_pCtrl < 0)
+            {
+                ++m_pCtrl;
+                ++m_pSlot;
+            }
+        }
+
+        const Ctrl* m_pCtrl{nullptr};
+        const Ctrl* m_pCtrlEnd{nullptr};
+        value_type* m_pSlot{nullptr};
+    };
+
+    using iterator       = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    // ----------- ctor / dtor -----------
+
+    HashMap() = default;
+
+    explicit HashMap(size_type bucketCount)
+    {
+        reserve(bucketCount);
+    }
+
+    HashMap(std::initializer_list<value_type> init)
+    {
+        insert(init);
+    }
+
+    template <class InputIt> HashMap(InputIt first, InputIt last)
+    {
+        insert(first, last);
+    }
+
+    HashMap(const HashMap& other)
+    {
+        reserve(other.size());
+        for (const value_type& value : other)
+        {
+            EmplaceNew(Hash{}(value.first), value.first, value.second);
+        }
+    }
+
+    HashMap(HashMap&& other) noexcept
+    {
+        MoveFrom(other);
+    }
+
+    ~HashMap()
+    {
+        DestroySlots();
+        FreeTable();
+    }
+
+    HashMap& operator=(const HashMap& other)
+    {
+        if (this != &other)
+        {
+            HashMap tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    HashMap& operator=(HashMap&& other) noexcept
+    {
+        if (this != &other)
+        {
+            DestroySlots();
+            FreeTable();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    HashMap& operator=(std::initializer_list<value_type> init)
+    {
+        clear();
+        insert(init);
+        return *this;
+    }
+
+    // ----------- iterators -----------
+
+    iterator begin() noexcept
+    {
+        iterator it(m_pCtrl, m_pCtrl + m_capacity, m_pSlots);
+        it.SkipFreeSlots();
+        return it;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_cast<HashMap*>(this)->begin();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(m_pCtrl + m_capacity, m_pCtrl + m_capacity, m_pSlots + m_capacity);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_cast<HashMap*>(this)->end();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // ----------- capacity -----------
+
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    float load_factor() const noexcept
+    {
+        return m_capacity == 0 ? 0.0f : static_cast<float>(m_size) / m_capacity;
+    }
+
+    /// Makes room for count elements, inserting up to count elements afterwards never rehashes.
+    void reserve(size_type count)
+    {
+        if (count > m_size + m_growthLeft)
+        {
+            Resize(CapacityForSize(count));
+        }
+    }
+
+    void clear() noexcept
+    {
+        DestroySlots();
+        if (m_capacity > 0)
+        {
+            std::memset(m_pCtrl, static_cast<uint8_t>(hash_map::cCtrlEmpty), m_capacity);
+        }
+        m_size       = 0;
+        m_growthLeft = CapacityToGrowth(m_capacity);
+    }
+
+    // ----------- modifiers -----------
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return TryEmplaceImpl(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return TryEmplaceImpl(std::move(const_cast<K&>(value.first)), std::move(value.second));
+    }
+
+    template <class P, class = std::enable_if_t<std::is_constructible_v<value_type, P&&>>>
+    std::pair<iterator, bool> insert(P&& value)
+    {
+        return emplace(std::forward<P>(value));
+    }
+
+    template <class InputIt> void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> init)
+    {
+        reserve(m_size + init.size());
+        insert(init.begin(), init.end());
+    }
+
+    template <class M> std::pair<iterator, bool> insert_or_assign(const K& key, M&& obj)
+    {
+        auto result = TryEmplaceImpl(key, std::forward<M>(obj));
+        if (!result.second)
+        {
+            result.first->second = std::forward<M>(obj);
+        }
+        return result;
+    }
+
+    template <class M> std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj)
+    {
+        auto result = TryEmplaceImpl(std::move(key), std::forward<M>(obj));
+        if (!result.second)
+        {
+            result.first->second = std::forward<M>(obj);
+        }
+        return result;
+    }
+
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        // the key is only known once the element is built, move it into the slot afterwards
+        value_type value(std::forward<Args>(args)...);
+        return TryEmplaceImpl(std::move(const_cast<K&>(value.first)), std::move(value.second));
+    }
+
+    template <class... Args> std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+    {
+        return TryEmplaceImpl(key, std::forward<Args>(args)...);
+    }
+
+    template <class... Args> std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        return TryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        ASSERT(pos.m_pSlot >= m_pSlots && pos.m_pSlot < m_pSlots + m_capacity);
+        const size_type index = static_cast<size_type>(pos.m_pSlot - m_pSlots);
+        EraseAt(index);
+        // the erased slot is free now, advancing skips it and every following free slot
+        iterator it(m_pCtrl + index, m_pCtrl + m_capacity, m_pSlots + index);
+        return ++it;
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(const_iterator(pos));
+    }
+
+    size_type erase(const K& key)
+    {
+        return EraseImpl(key);
+    }
+
+    template <class Q, class H = Hash, class = EnableIfTransparent<H>>
+    size_type erase(const Q& key)
+    {
+        return EraseImpl(key);
+    }
+
+    void swap(HashMap& other) noexcept
+    {
+        std::swap(m_pCtrl, other.m_pCtrl);
+        std::swap(m_pSlots, other.m_pSlots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growthLeft, other.m_growthLeft);
+    }
+
+    // ----------- lookup -----------
+
+    V& operator[](const K& key)
+    {
+        return TryEmplaceImpl(key).first->second;
+    }
+
+    V& operator[](K&& key)
+    {
+        return TryEmplaceImpl(std::move(key)).first->second;
+    }
+
+    V& at(const K& key)
+    {
+        return AtImpl(key);
+    }
+
+    const V& at(const K& key) const
+    {
+        return const_cast<HashMap*>(this)->AtImpl(key);
+    }
+
+    template <class Q, class H = Hash, class = EnableIfTransparent<H>>
+    V& at(const Q& key)
+    {
+        return AtImpl(key);
+    }
+
+    template <class Q, class H = Hash, class = EnableIfTransparent<H>>
+    const V& at(const Q& key) const
+    {
+        return const_cast<HashMap*>(this)->AtImpl(key);
+    }
+
+    iterator find(const K& key)
+    {
+        return MakeIterator(FindIndex(key, Hash{}(key)));
+    }
+
+    const_iterator find(const K& key) const
+    {
+        return const_cast<HashMap*>(this)->find(key);
+    }
+
+    template <class Q, class H = Hash, class = EnableIfTransparent<H>>
+    iterator find(const Q& key)
+    {
+        return MakeIterator(FindIndex(key, Hash{}(key)));
+    }
+
+    template <class Q, class H = Hash, class = EnableIfTransparent<H>>
+    const_iterator find(const Q& key) const
+    {
+        return const_cast<HashMap*>(this)->find(key);
+    }
+
+    bool contains(const K& key) const
+    {
+        return FindIndex(key, Hash{}(key)) != cInvalidIndex;
+    }
+
+    template <class Q, class H = Hash, class = EnableIfTransparent<H>>
+    bool contains(const Q& key) const
+    {
+        return FindIndex(key, Hash{}(key)) != cInvalidIndex;
+    }
+
+    size_type count(const K& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <class Q, class H = Hash, class = EnableIfTransparent<H>>
+    size_type count(const Q& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    friend bool operator==(const HashMap& lhs, const HashMap& rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        for (const value_type& value : lhs)
+        {
+            auto it = rhs.find(value.first);
+            if (it == rhs.end() || !(it->second == value.second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const HashMap& lhs, const HashMap& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    static constexpr size_type cInvalidIndex = ~size_type(0);
+
+    // max load factor 7/8
+    static size_type CapacityToGrowth(size_type capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    static size_type CapacityForSize(size_type size)
+    {
+        size_type capacity = hash_map::cGroupWidth;
+        while (CapacityToGrowth(capacity) < size)
+        {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    static size_type SlotOffset(size_type capacity)
+    {
+        return (capacity + alignof(value_type) - 1) & ~(alignof(value_type) - 1);
+    }
+
+    static size_t HashOf(size_t hash)
+    {
+        return static_cast<size_t>(hash_map::MixHash(hash));
+    }
+
+    iterator MakeIterator(size_type index)
+    {
+        if (index == cInvalidIndex)
+        {
+            return end();
+        }
+        return iterator(m_pCtrl + index, m_pCtrl + m_capacity, m_pSlots + index);
+    }
+
+    // groups are probed quadratically (triangular numbers), which visits every group exactly once
+    // because the group count is a power of two
+    template <class Q> size_type FindIndex(const Q& key, size_t rawHash) const
+    {
+        if (m_capacity == 0)
+        {
+            return cInvalidIndex;
+        }
+        const size_t hash          = HashOf(rawHash);
+        const hash_map::Ctrl h2    = hash_map::H2(hash);
+        const size_type groupMask  = m_capacity / hash_map::cGroupWidth - 1;
+        size_type groupIndex       = hash_map::H1(hash) & groupMask;
+        for (size_type probe = 1;; ++probe)
+        {
+            const size_type groupStart = groupIndex * hash_map::cGroupWidth;
+            const hash_map::Group group(m_pCtrl + groupStart);
+            for (auto match = group.Match(h2); match; match.ClearLowest())
+            {
+                const size_type index = groupStart + match.LowestIndex();
+                if (KeyEqual{}(m_pSlots[index].first, key))
+                {
+                    return index;
+                }
+            }
+            if (group.MatchEmpty() || probe > groupMask)
+            {
+                return cInvalidIndex;
+            }
+            groupIndex = (groupIndex + probe) & groupMask;
+        }
+    }
+
+    size_type FindFirstNonFull(size_t hash) const
+    {
+        const size_type groupMask = m_capacity / hash_map::cGroupWidth - 1;
+        size_type groupIndex      = hash_map::H1(hash) & groupMask;
+        for (size_type probe = 1;; ++probe)
+        {
+            const size_type groupStart = groupIndex * hash_map::cGroupWidth;
+            const auto mask = hash_map::Group(m_pCtrl + groupStart).MatchEmptyOrDeleted();
+            if (mask)
+            {
+                return groupStart + mask.LowestIndex();
+            }
+            groupIndex = (groupIndex + probe) & groupMask;
+        }
+    }
+
+    // returns the slot a new element with this hash goes to, growing the table if needed
+    size_type PrepareInsert(size_t hash)
+    {
+        if (m_capacity == 0)
+        {
+            Resize(hash_map::cGroupWidth);
+        }
+        size_type index = FindFirstNonFull(hash);
+        if (m_growthLeft == 0 && m_pCtrl[index] != hash_map::cCtrlDeleted)
+        {
+            // mostly tombstones, rebuilding at the same capacity is enough
+            const size_type newCapacity =
+                m_size <= CapacityToGrowth(m_capacity) / 2 ? m_capacity : m_capacity * 2;
+            Resize(newCapacity);
+            index = FindFirstNonFull(hash);
+        }
+        return index;
+    }
+
+    void CommitInsert(size_type index, size_t hash)
+    {
+        if (m_pCtrl[index] == hash_map::cCtrlEmpty)
+        {
+            --m_growthLeft;
+        }
+        m_pCtrl[index] = hash_map::H2(hash);
+        ++m_size;
+    }
+
+    template <class KK, class... Args> iterator EmplaceNew(size_t rawHash, KK&& key, Args&&... args)
+    {
+        const size_t hash     = HashOf(rawHash);
+        const size_type index = PrepareInsert(hash);
+        new (m_pSlots + index) value_type(std::piecewise_construct,
+                                          std::forward_as_tuple(std::forward<KK>(key)),
+                                          std::forward_as_tuple(std::forward<Args>(args)...));
+        CommitInsert(index, hash);
+        return MakeIterator(index);
+    }
+
+    template <class KK, class... Args>
+    std::pair<iterator, bool> TryEmplaceImpl(KK&& key, Args&&... args)
+    {
+        const size_t rawHash  = Hash{}(key);
+        const size_type index = FindIndex(key, rawHash);
+        if (index != cInvalidIndex)
+        {
+            return {MakeIterator(index), false};
+        }
+        return {EmplaceNew(rawHash, std::forward<KK>(key), std::forward<Args>(args)...), true};
+    }
+
+    template <class Q> V& AtImpl(const Q& key)
+    {
+        const size_type index = FindIndex(key, Hash{}(key));
+        if (index == cInvalidIndex)
+        {
+            throw std::out_of_range("HashMap::at: key not found");
+        }
+        return m_pSlots[index].second;
+    }
+
+    template <class Q> size_type EraseImpl(const Q& key)
+    {
+        const size_type index = FindIndex(key, Hash{}(key));
+        if (index == cInvalidIndex)
+        {
+            return 0;
+        }
+        EraseAt(index);
+        return 1;
+    }
+
+    void EraseAt(size_type index)
+    {
+        m_pSlots[index].~value_type();
+        --m_size;
+        // a group with an empty slot ends every probe sequence that reaches it, so the slot can
+        // become empty again without breaking lookups of elements placed further along
+        const size_type groupStart = index & ~(hash_map::cGroupWidth - 1);
+        if (hash_map::Group(m_pCtrl + groupStart).MatchEmpty())
+        {
+            m_pCtrl[index] = hash_map::cCtrlEmpty;
+            ++m_growthLeft;
+        }
+        else
+        {
+            m_pCtrl[index] = hash_map::cCtrlDeleted;
+        }
+    }
+
+    void Resize(size_type newCapacity)
+    {
+        Ctrl* pOldCtrl        = m_pCtrl;
+        value_type* pOldSlots = m_pSlots;
+        const size_type oldCapacity = m_capacity;
+
+        const size_t alignment = std::max<size_t>(alignof(value_type), hash_map::cGroupWidth);
+        void* pMem =
+            ZEN_MEM_ALLOC_ALIGNED(SlotOffset(newCapacity) + newCapacity * sizeof(value_type),
+                                  alignment);
+        m_pCtrl    = static_cast<Ctrl*>(pMem);
+        m_pSlots   = reinterpret_cast<value_type*>(static_cast<uint8_t*>(pMem) +
+                                                 SlotOffset(newCapacity));
+        m_capacity = newCapacity;
+        std::memset(m_pCtrl, static_cast<uint8_t>(hash_map::cCtrlEmpty), newCapacity);
+        m_growthLeft = CapacityToGrowth(newCapacity) - m_size;
+
+        for (size_type i = 0; i < oldCapacity; ++i)
+        {
+            if (pOldCtrl[i] < 0)
+            {
+                continue;
+            }
+            value_type& oldSlot   = pOldSlots[i];
+            const size_t hash     = HashOf(Hash{}(oldSlot.first));
+            const size_type index = FindFirstNonFull(hash);
+            m_pCtrl[index]        = hash_map::H2(hash);
+            new (m_pSlots + index)
+                value_type(std::move(const_cast<K&>(oldSlot.first)), std::move(oldSlot.second));
+            oldSlot.~value_type();
+        }
+
+        if (pOldCtrl)
+        {
+            ZEN_MEM_FREE(pOldCtrl);
+        }
+    }
+
+    void DestroySlots()
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>)
+        {
+            for (size_type i = 0; i < m_capacity; ++i)
+            {
+                if (m_pCtrl[i] >= 0)
+                {
+                    m_pSlots[i].~value_type();
+                }
+            }
+        }
+    }
+
+    void FreeTable()
+    {
+        if (m_pCtrl)
+        {
+            ZEN_MEM_FREE(m_pCtrl);
+        }
+        m_pCtrl      = nullptr;
+        m_pSlots     = nullptr;
+        m_capacity   = 0;
+        m_size       = 0;
+        m_growthLeft = 0;
+    }
+
+    void MoveFrom(HashMap& other) noexcept
+    {
+        m_pCtrl      = other.m_pCtrl;
+        m_pSlots     = other.m_pSlots;
+        m_capacity   = other.m_capacity;
+        m_size       = other.m_size;
+        m_growthLeft = other.m_growthLeft;
+
+        other.m_pCtrl      = nullptr;
+        other.m_pSlots     = nullptr;
+        other.m_capacity   = 0;
+        other.m_size       = 0;
+        other.m_growthLeft = 0;
+    }
+
+    Ctrl* m_pCtrl{nullptr};
+    value_type* m_pSlots{nullptr};
+    size_type m_capacity{0};
+    size_type m_size{0};
+    // number of elements that can still be inserted into empty slots before the table grows
+    size_type m_growthLeft{0};
+};
+
+template <class K, class V, class Hash, class KeyEqual>
+void swap(HashMap<K, V, Hash, KeyEqual>& lhs, HashMap<K, V, Hash, KeyEqual>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// Node based hash map, references and iterators to elements stay valid until they are erased.
+template <class K, class V> using StableHashMap = std::unordered_map<K, V>;
+} // namespace zen
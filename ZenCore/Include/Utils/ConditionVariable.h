@@ -4,6 +4,7 @@
 #include <windows.h>
 #undef WIN32_NO_STATUS
 #endif
+#include <chrono>
 #include "ObjectBase.h"
 // clang-format on
 #include "Mutex.h"
@@ -39,15 +40,30 @@ public:
     }
 #endif
 
+#if defined(ZEN_LINUX)
+    // futex word, bumped on every notify
+    typedef std::atomic<uint32_t> ConditionVariableData;
+
+    ConditionVariable() : m_osConVar(0) {}
+    ~ConditionVariable() {}
+#endif
+
     template <class Predicate>
     void Wait(Mutex* pMutex, Predicate predicate, uint32_t milliseconds = INF_TIME);
 
+    // waits until notified or the timeout elapsed, returns false on timeout
+    // pMutex must be locked by the calling thread, spurious wake ups are possible
+    bool WaitFor(Mutex* pMutex, uint32_t milliseconds);
+
+    // waits until predicate() is true or the timeout elapsed, returns the last predicate() result
+    template <class Predicate> bool WaitFor(Mutex* pMutex, Predicate predicate, uint32_t milliseconds);
+
     void NotifyOne();
 
     void NotifyAll();
 
 private:
-    void Wait(Mutex* pMutex, uint32_t milliseconds = INF_TIME);
+    bool Wait(Mutex* pMutex, uint32_t milliseconds = INF_TIME);
 
     ConditionVariableData m_osConVar;
     ZEN_NO_COPY(ConditionVariable)
@@ -55,12 +71,13 @@ private:
 
 // Win32 Implementation
 #if defined(ZEN_WIN32)
-inline void ConditionVariable::Wait(zen::Mutex* pMutex, uint32_t milliseconds)
+inline bool ConditionVariable::Wait(zen::Mutex* pMutex, uint32_t milliseconds)
 {
     if (pMutex != nullptr)
     {
-        SleepConditionVariableCS(&m_osConVar, pMutex->GetMutexData(), milliseconds);
+        return SleepConditionVariableCS(&m_osConVar, pMutex->GetMutexData(), milliseconds) != 0;
     }
+    return true;
 }
 inline void ConditionVariable::NotifyOne()
 {
@@ -83,7 +100,7 @@ void ConditionVariable::Wait(Mutex* pMutex, Predicate predicate, uint32_t millis
 #endif
 
 #if defined(ZEN_MACOS)
-inline void ConditionVariable::Wait(zen::Mutex* pMutex, uint32_t milliseconds)
+inline bool ConditionVariable::Wait(zen::Mutex* pMutex, uint32_t milliseconds)
 {
     if (pMutex != nullptr)
     {
@@ -100,9 +117,10 @@ inline void ConditionVariable::Wait(zen::Mutex* pMutex, uint32_t milliseconds)
                             .count();
             ts.tv_nsec = (timeout.time_since_epoch().count() % 1000000000) * 1000;
 
-            pthread_cond_timedwait(&m_osConVar, pMutex->GetMutexData(), &ts);
+            return pthread_cond_timedwait(&m_osConVar, pMutex->GetMutexData(), &ts) != ETIMEDOUT;
         }
     }
+    return true;
 }
 inline void ConditionVariable::NotifyOne()
 {
@@ -123,4 +141,79 @@ void ConditionVariable::Wait(Mutex* pMutex, Predicate predicate, uint32_t millis
     }
 }
 #endif
-} // namespace zen
\ No newline at end of file
+
+#if defined(ZEN_LINUX)
+inline bool ConditionVariable::Wait(zen::Mutex* pMutex, uint32_t milliseconds)
+{
+    if (pMutex == nullptr)
+    {
+        return true;
+    }
+    // sample the sequence before unlocking, a notify in between changes it and the futex wait
+    // returns immediately instead of missing the wake up
+    const uint32_t seq = m_osConVar.load(std::memory_order_relaxed);
+    pMutex->UnLock();
+
+    bool signaled = true;
+    if (milliseconds == INF_TIME)
+    {
+        FutexWait(&m_osConVar, seq, nullptr);
+    }
+    else
+    {
+        timespec ts;
+        ts.tv_sec  = milliseconds / 1000;
+        ts.tv_nsec = static_cast<long>(milliseconds % 1000) * 1000000;
+        signaled   = FutexWait(&m_osConVar, seq, &ts);
+    }
+    // other threads may be blocked on the mutex as well, keep it marked as contended so that
+    // UnLock() wakes them up
+    pMutex->LockContended();
+    return signaled;
+}
+
+inline void ConditionVariable::NotifyOne()
+{
+    m_osConVar.fetch_add(1, std::memory_order_relaxed);
+    FutexWake(&m_osConVar, 1);
+}
+
+inline void ConditionVariable::NotifyAll()
+{
+    m_osConVar.fetch_add(1, std::memory_order_relaxed);
+    FutexWake(&m_osConVar, INT_MAX);
+}
+
+template <class Predicate>
+void ConditionVariable::Wait(Mutex* pMutex, Predicate predicate, uint32_t milliseconds)
+{
+    while (!predicate())
+    {
+        Wait(pMutex, milliseconds);
+    }
+}
+#endif
+
+inline bool ConditionVariable::WaitFor(Mutex* pMutex, uint32_t milliseconds)
+{
+    return Wait(pMutex, milliseconds);
+}
+
+template <class Predicate>
+bool ConditionVariable::WaitFor(Mutex* pMutex, Predicate predicate, uint32_t milliseconds)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    while (!predicate())
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            return predicate();
+        }
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+        Wait(pMutex, static_cast<uint32_t>(remaining) + 1);
+    }
+    return true;
+}
+} // namespace zen
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstring>
 #include <vector>
 #include <stdexcept>
 
@@ -23,6 +24,37 @@ template <class T> inline void HashCombine(size_t& seed, const T& v)
     seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+// 64-bit hash of a byte range, 8 bytes per step with a murmur3 finalizer. Not cryptographic, meant
+// for content keys of cached data.
+inline uint64_t HashBytes64(const void* pData, size_t size, uint64_t seed = 0)
+{
+    constexpr uint64_t cMul0 = 0x9E3779B97F4A7C15ull;
+    constexpr uint64_t cMul1 = 0xBF58476D1CE4E5B9ull;
+    const uint8_t* pBytes    = static_cast<const uint8_t*>(pData);
+    uint64_t hash            = seed ^ (size * cMul0);
+    size_t i                 = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, pBytes + i, 8);
+        hash ^= word * cMul1;
+        hash = ((hash << 31) | (hash >> 33)) * cMul0;
+    }
+    if (i < size)
+    {
+        uint64_t tail = 0;
+        std::memcpy(&tail, pBytes + i, size - i);
+        hash ^= tail * cMul1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
 template <class T> inline std::vector<uint8_t> ToBytes(const T& value)
 {
     return std::vector<uint8_t>{reinterpret_cast<const uint8_t*>(&value),
@@ -0,0 +1,272 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ObjectBase.h"
+#include "SpinLock.h"
+#include "UniquePtr.h"
+
+namespace zen
+{
+class JobSystem;
+
+// Completion counter shared by a batch of jobs, used in place of std::future.
+// Every job submitted with a counter increments it, and decrements it when done.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    bool IsDone() const
+    {
+        return m_pending.load(std::memory_order_acquire) == 0;
+    }
+
+    uint32_t GetValue() const
+    {
+        return m_pending.load(std::memory_order_acquire);
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_pending{0};
+
+    ZEN_NO_COPY_MOVE(JobCounter)
+};
+
+// A job occupies exactly one cache line, callables up to cStorageSize bytes are stored inline,
+// larger ones fall back to a heap allocation.
+struct alignas(64) Job
+{
+    static constexpr size_t cStorageSize = 40;
+
+    using InvokeFunc = void (*)(Job*);
+
+    union
+    {
+        InvokeFunc pInvoke;
+        Job* pNext; // only valid while the job sits in a free list
+    };
+    JobCounter* pCounter{nullptr};
+    uint32_t ownerIndex{0};
+    alignas(8) uint8_t storage[cStorageSize];
+};
+static_assert(sizeof(Job) == 64, "Job should fit in a single cache line");
+
+// Fixed capacity Chase-Lev deque: the owner pushes and pops at the bottom,
+// other workers steal from the top.
+// See "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al. 2013).
+class JobQueue
+{
+public:
+    static constexpr int64_t cCapacity = 8192;
+
+    // owner only, returns false if the queue is full
+    bool Push(Job* pJob)
+    {
+        const int64_t b = m_bottom.load(std::memory_order_relaxed);
+        const int64_t t = m_top.load(std::memory_order_acquire);
+        if (b - t >= cCapacity)
+        {
+            return false;
+        }
+        m_jobs[b & cMask].store(pJob, std::memory_order_relaxed);
+        m_bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    // owner only
+    Job* Pop()
+    {
+        const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+
+        Job* pJob = nullptr;
+        if (t <= b)
+        {
+            pJob = m_jobs[b & cMask].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // last element, race against stealers
+                if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed))
+                {
+                    pJob = nullptr;
+                }
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return pJob;
+    }
+
+    // any thread, returns nullptr if empty or if the steal lost a race
+    Job* Steal()
+    {
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t < b)
+        {
+            Job* pJob = m_jobs[t & cMask].load(std::memory_order_relaxed);
+            if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return pJob;
+        }
+        return nullptr;
+    }
+
+    bool Empty() const
+    {
+        const int64_t t = m_top.load(std::memory_order_acquire);
+        const int64_t b = m_bottom.load(std::memory_order_acquire);
+        return b <= t;
+    }
+
+private:
+    static constexpr int64_t cMask = cCapacity - 1;
+    static_assert((cCapacity & cMask) == 0, "JobQueue capacity must be a power of 2");
+
+    alignas(64) std::atomic<int64_t> m_top{0};
+    alignas(64) std::atomic<int64_t> m_bottom{0};
+    alignas(64) std::atomic<Job*> m_jobs[cCapacity];
+};
+
+// Work-stealing job system. Each worker owns a JobQueue, idle workers steal from the others.
+// Threads that are not workers (e.g. the main thread) get their own queue on first use, and
+// help executing jobs while waiting on a JobCounter.
+class JobSystem
+{
+public:
+    // numWorkers == 0 means one worker per hardware thread minus the calling thread
+    explicit JobSystem(uint32_t numWorkers = 0);
+
+    // waits for the workers to exit, jobs still queued are executed on the calling thread
+    ~JobSystem();
+
+    template <class F> void Submit(F&& func, JobCounter* pCounter = nullptr)
+    {
+        using FuncType = std::decay_t<F>;
+
+        Job* pJob = AllocJob();
+        if (pJob == nullptr)
+        {
+            // no queue available for this thread, run it inline
+            func();
+            return;
+        }
+        if constexpr (sizeof(FuncType) <= Job::cStorageSize && alignof(FuncType) <= 8 &&
+                      std::is_nothrow_move_constructible_v<FuncType>)
+        {
+            new (pJob->storage) FuncType(std::forward<F>(func));
+            pJob->pInvoke = [](Job* pJob) {
+                FuncType* pFunc = std::launder(reinterpret_cast<FuncType*>(pJob->storage));
+                (*pFunc)();
+                pFunc->~FuncType();
+            };
+        }
+        else
+        {
+            FuncType* pFunc = new FuncType(std::forward<F>(func));
+            std::memcpy(pJob->storage, &pFunc, sizeof(pFunc));
+            pJob->pInvoke = [](Job* pJob) {
+                FuncType* pFunc = nullptr;
+                std::memcpy(&pFunc, pJob->storage, sizeof(pFunc));
+                (*pFunc)();
+                delete pFunc;
+            };
+        }
+        pJob->pCounter = pCounter;
+        if (pCounter != nullptr)
+        {
+            pCounter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        Enqueue(pJob);
+    }
+
+    // splits [0, count) into ranges of at most batchSize elements, func(begin, end) is called once
+    // per range. func is captured by reference, it must outlive Wait(pCounter).
+    template <class F>
+    void ParallelFor(uint32_t count, uint32_t batchSize, F&& func, JobCounter* pCounter)
+    {
+        batchSize = batchSize == 0 ? 1 : batchSize;
+        for (uint32_t begin = 0; begin < count; begin += batchSize)
+        {
+            const uint32_t end = std::min(count, begin + batchSize);
+            Submit([&func, begin, end]() { func(begin, end); }, pCounter);
+        }
+    }
+
+    // blocks until the counter reaches zero, executing pending jobs meanwhile
+    void Wait(JobCounter* pCounter);
+
+    uint32_t GetNumWorkers() const
+    {
+        return m_numWorkers;
+    }
+
+private:
+    ZEN_NO_COPY_MOVE(JobSystem)
+
+    static constexpr uint32_t cMaxContexts  = 64;
+    static constexpr uint32_t cJobChunkSize = 256;
+    static constexpr uint32_t cSpinCount    = 64;
+
+    struct alignas(64) WorkerContext
+    {
+        JobQueue queue;
+        // jobs owned by this context, only touched by the owning thread
+        Job* pFreeList{nullptr};
+        // jobs owned by this context but finished by other threads
+        std::atomic<Job*> pRemoteFreeList{nullptr};
+        std::vector<Job*> jobChunks;
+        std::thread::id threadId;
+        uint32_t index{0};
+    };
+
+    WorkerContext* GetContext();
+
+    Job* AllocJob();
+
+    void FreeJob(WorkerContext* pContext, Job* pJob);
+
+    void Enqueue(Job* pJob);
+
+    void Execute(WorkerContext* pContext, Job* pJob);
+
+    Job* FindJob(WorkerContext* pContext);
+
+    bool HasPendingJobs() const;
+
+    void WakeWorkers();
+
+    void WorkerMain(uint32_t index);
+
+    const uint64_t m_id;
+    uint32_t m_numWorkers{0};
+    std::vector<std::thread> m_threads;
+
+    UniquePtr<WorkerContext> m_contexts[cMaxContexts];
+    std::atomic<uint32_t> m_numContexts{0};
+    SpinLock m_contextLock;
+
+    std::atomic<bool> m_stop{false};
+    std::atomic<uint32_t> m_numSleeping{0};
+    std::atomic<uint32_t> m_wakeEpoch{0};
+};
+} // namespace zen
@@ -8,11 +8,37 @@
 #if defined(ZEN_MACOS)
 #include <pthread.h>
 #endif
+
+#if defined(ZEN_LINUX)
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #include "ObjectBase.h"
 // clang-format on
 
 namespace zen
 {
+#if defined(ZEN_LINUX)
+// thin wrappers around the futex syscall, pTimeout is a relative timeout, nullptr waits forever
+// returns false if the wait timed out
+inline bool FutexWait(std::atomic<uint32_t>* pWord, uint32_t expected, const timespec* pTimeout)
+{
+    long ret = syscall(SYS_futex, reinterpret_cast<uint32_t*>(pWord), FUTEX_WAIT_PRIVATE, expected,
+                       pTimeout, nullptr, 0);
+    return !(ret == -1 && errno == ETIMEDOUT);
+}
+
+inline void FutexWake(std::atomic<uint32_t>* pWord, int numWaiters)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(pWord), FUTEX_WAKE_PRIVATE, numWaiters, nullptr,
+            nullptr, 0);
+}
+#endif
 
 class Mutex
 {
@@ -42,6 +68,16 @@ public:
     }
 #endif
 
+#if defined(ZEN_LINUX)
+    // futex word: 0 unlocked, 1 locked, 2 locked with (possible) waiters
+    typedef std::atomic<uint32_t> MutexData;
+    Mutex() : m_osMutex(0) {}
+    ~Mutex() {}
+
+    // lock and mark the futex as contended, used when re-acquiring after a condition variable wait
+    void LockContended();
+#endif
+
 
     void Lock();
 
@@ -115,4 +151,53 @@ inline bool Mutex::TryLock()
     return pthread_mutex_trylock(&m_osMutex) == 0;
 }
 #endif
+
+#if defined(ZEN_LINUX)
+// see "Futexes Are Tricky" (Drepper), mutex take 3
+inline void Mutex::Lock()
+{
+    uint32_t state = 0;
+    if (m_osMutex.compare_exchange_strong(state, 1, std::memory_order_acquire,
+                                          std::memory_order_relaxed))
+    {
+        return;
+    }
+    // short spin before going to the kernel, critical sections are usually tiny
+    for (uint32_t i = 0; i < 64 && state != 2; ++i)
+    {
+        state = 0;
+        if (m_osMutex.compare_exchange_weak(state, 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+    LockContended();
+}
+
+inline void Mutex::LockContended()
+{
+    uint32_t state = m_osMutex.exchange(2, std::memory_order_acquire);
+    while (state != 0)
+    {
+        FutexWait(&m_osMutex, 2, nullptr);
+        state = m_osMutex.exchange(2, std::memory_order_acquire);
+    }
+}
+
+inline void Mutex::UnLock()
+{
+    if (m_osMutex.exchange(0, std::memory_order_release) == 2)
+    {
+        FutexWake(&m_osMutex, 1);
+    }
+}
+
+inline bool Mutex::TryLock()
+{
+    uint32_t state = 0;
+    return m_osMutex.compare_exchange_strong(state, 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+}
+#endif
 } // namespace zen
\ No newline at end of file
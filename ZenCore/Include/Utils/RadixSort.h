@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+
+namespace zen
+{
+class JobSystem;
+
+// Stable LSD radix sort of 64 bit keys with a 32 bit payload, one byte per pass. Passes whose
+// byte is the same for every key are skipped, so keys that only use their low bits sort in fewer
+// passes. Large inputs are split into blocks that count and scatter in parallel.
+class RadixSort
+{
+public:
+    // below this the job overhead outweighs the parallel passes
+    static constexpr uint32_t cMinParallelCount = 1u << 16;
+
+    // the scratch arrays hold count elements each, the result ends up in pKeys and pValues
+    static void Sort(uint64_t* pKeys,
+                     uint32_t* pValues,
+                     uint64_t* pScratchKeys,
+                     uint32_t* pScratchValues,
+                     uint32_t count,
+                     JobSystem* pJobSystem = nullptr);
+};
+} // namespace zen
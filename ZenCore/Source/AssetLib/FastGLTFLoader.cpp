@@ -1,9 +1,10 @@
 #include <future>
 #include <stb_image.h>
 #include "AssetLib/FastGLTFLoader.h"
+#include "AssetLib/TextureLoader.h"
 #include "SceneGraph/Scene.h"
 #include "Utils/Errors.h"
-#include "Utils/ThreadPool.h"
+#include "Utils/JobSystem.h"
 #include "Graphics/RenderCore/V2/RenderConfig.h"
 
 namespace zen::asset
@@ -75,6 +76,29 @@ void FastGLTFLoader::LoadFromFile(const std::string& path, sg::Scene* pScene)
 {
     m_name = std::filesystem::path(path).stem().string();
     pScene->SetName(m_name);
+
+    // the cooked data covers the whole vertex and index arrays, only for fresh loaders
+    m_loadedFromSceneCache = false;
+    SceneCacheKey sceneCacheKey;
+    std::string sceneCachePath;
+    const uint32_t sceneCacheFlags = (m_optimizeMeshes ? cSceneCacheOptimizeMeshes : 0) |
+        (m_buildMeshlets ? cSceneCacheBuildMeshlets : 0);
+    const bool useSceneCache = !m_sceneCacheDir.empty() && m_vertices.empty() &&
+        SceneCache::CalcKey(path, m_sceneCacheDir, sceneCacheFlags, sceneCacheKey);
+    if (useSceneCache)
+    {
+        sceneCachePath = SceneCache::GetCachePath(m_sceneCacheDir, path);
+        if (SceneCache::Read(sceneCachePath, sceneCacheKey, pScene, m_vertices, m_indices,
+                             m_meshletData))
+        {
+            m_vertexPos            = m_vertices.size();
+            m_indexPos             = m_indices.size();
+            m_loadedFromSceneCache = true;
+            pScene->UpdateAABB();
+            return;
+        }
+    }
+
     auto gltfFile = fastgltf::MappedGltfFile::FromPath(path);
     if (!bool(gltfFile))
     {
@@ -88,12 +112,28 @@ void FastGLTFLoader::LoadFromFile(const std::string& path, sg::Scene* pScene)
         LOGE("Failed to load glTF: {}", fastgltf::getErrorMessage(loadedAsset.error()));
     }
     m_gltfAsset = std::move(loadedAsset.get());
+
+    // shared by texture decoding and mesh conversion, only alive while loading
+    UniquePtr<JobSystem> jobSystem;
+    if (m_parallelLoading)
+    {
+        jobSystem    = MakeUnique<JobSystem>(rc::RenderConfig::GetInstance().numThreads);
+        m_pJobSystem = jobSystem.Get();
+    }
     LoadGltfSamplers(pScene);
     LoadGltfTextures(pScene);
     LoadGltfMaterials(pScene);
     LoadGltfMeshes(pScene);
     LoadGltfRenderableNodes(pScene);
+    // mesh bounds are still untransformed here
+    if (useSceneCache)
+    {
+        SceneCache::Write(sceneCachePath, sceneCacheKey, *pScene, m_sceneCacheNodes, m_vertices,
+                          m_indices, m_meshletData);
+        m_sceneCacheNodes.clear();
+    }
     pScene->UpdateAABB();
+    m_pJobSystem = nullptr;
 }
 
 void FastGLTFLoader::LoadGltfSamplers(sg::Scene* pScene)
@@ -265,44 +305,38 @@ private:
 
 void FastGLTFLoader::LoadGltfTextures(sg::Scene* pScene)
 {
-    uint32_t groupSize = rc::RenderConfig::GetInstance().numThreads;
-    auto threadPool    = MakeUnique<ThreadPool<void, uint32_t>>(groupSize);
-
     std::vector<UniquePtr<sg::Texture>> textures;
     size_t numTextures = m_gltfAsset.textures.size();
     textures.resize(numTextures);
 
-    uint32_t groupWorkLoad = numTextures / groupSize;
-    uint32_t workRemained  = numTextures % rc::RenderConfig::GetInstance().numThreads;
-
-    uint32_t startIdx = 0;
-    std::vector<std::future<std::vector<sg::Texture*>>> futures;
-    for (size_t i = 0; i < groupSize; ++i)
+    // cooked scenes carry mip chains, they are built here as well so that cold and warm loads
+    // produce the same textures
+    auto LoadTexture = [this, &textures](uint32_t i) {
+        sg::Texture* pTexture = LoadGltfTextureVisitor(i);
+        if (!m_sceneCacheDir.empty())
+        {
+            pTexture->mipLevels =
+                TextureLoader::GenerateMipmaps(pTexture->width, pTexture->height,
+                                               pTexture->format == Format::R8G8B8A8_SRGB,
+                                               pTexture->bytesData);
+        }
+        textures[i] = UniquePtr(pTexture);
+    };
+    if (m_pJobSystem != nullptr)
     {
-        uint32_t endIdx = startIdx + groupWorkLoad;
-        if (workRemained > 0)
+        // one job per texture, idle workers steal the remaining decodes
+        JobCounter counter;
+        for (uint32_t i = 0; i < numTextures; ++i)
         {
-            workRemained--;
-            endIdx++;
+            m_pJobSystem->Submit([&LoadTexture, i]() { LoadTexture(i); }, &counter);
         }
-        auto future = threadPool->Push([this, startIdx, endIdx](uint32_t threadId) {
-            std::vector<sg::Texture*> batchResult;
-            for (uint32_t j = startIdx; j < endIdx; j++)
-            {
-                sg::Texture* pTexture = LoadGltfTextureVisitor(j);
-                batchResult.push_back(pTexture);
-            }
-            return batchResult;
-        });
-        futures.emplace_back(std::move(future));
-        startIdx = endIdx;
+        m_pJobSystem->Wait(&counter);
     }
-    for (auto& fut : futures)
+    else
     {
-        std::vector<sg::Texture*> batch = fut.get();
-        for (auto* pSgTex : batch)
+        for (uint32_t i = 0; i < numTextures; ++i)
         {
-            textures[pSgTex->index] = UniquePtr(pSgTex);
+            LoadTexture(i);
         }
     }
     sg::Scene::LoadDefaultTextures(textures.size());
@@ -422,323 +456,472 @@ void FastGLTFLoader::LoadGltfMaterials(sg::Scene* pScene)
 
 void FastGLTFLoader::LoadGltfMeshes(sg::Scene* pScene)
 {
-    size_t totalVertexCount = 0;
-    size_t totalIndexCount  = 0;
+    // assign every primitive its range of the vertex and index arrays up front (prefix sum), so
+    // that primitives can be converted in any order and the result matches a serial conversion
+    std::vector<GltfPrimitiveRange> primitiveRanges;
+    size_t vertexOffset = m_vertexPos;
+    size_t indexOffset  = m_indexPos;
     for (const fastgltf::Mesh& mesh : m_gltfAsset.meshes)
     {
         for (const auto& primitive : mesh.primitives)
         {
-            totalVertexCount +=
-                m_gltfAsset.accessors[primitive.findAttribute("POSITION")->accessorIndex].count;
+            GltfPrimitiveRange range{};
+            range.pPrimitive   = &primitive;
+            range.vertexOffset = static_cast<uint32_t>(vertexOffset);
+            range.indexOffset  = static_cast<uint32_t>(indexOffset);
+            range.diffuseColor = Vec4(1.0f);
+            if (primitive.findAttribute("POSITION") != primitive.attributes.end())
+            {
+                range.vertexCount =
+                    m_gltfAsset.accessors[primitive.findAttribute("POSITION")->accessorIndex].count;
+            }
             if (primitive.indicesAccessor.has_value())
             {
-                totalIndexCount += m_gltfAsset.accessors[primitive.indicesAccessor.value()].count;
+                range.indexCount = m_gltfAsset.accessors[primitive.indicesAccessor.value()].count;
+            }
+            if (primitive.materialIndex.has_value())
+            {
+                range.diffuseColor = glm::make_vec4(
+                    m_gltfAsset.materials[primitive.materialIndex.value()]
+                        .pbrData.baseColorFactor.data());
+            }
+            vertexOffset += range.vertexCount;
+            indexOffset += range.indexCount;
+            primitiveRanges.push_back(range);
+        }
+    }
+    m_vertices.resize(vertexOffset);
+    m_indices.resize(indexOffset);
+
+    if (m_pJobSystem != nullptr)
+    {
+        // large primitives are split as well, a CAD part can hold millions of vertices alone
+        JobCounter counter;
+        for (const GltfPrimitiveRange& range : primitiveRanges)
+        {
+            for (uint32_t begin = 0; begin < range.vertexCount; begin += cNumVerticesPerJob)
+            {
+                const uint32_t end = std::min(begin + cNumVerticesPerJob, range.vertexCount);
+                m_pJobSystem->Submit(
+                    [this, &range, begin, end]() { ConvertGltfVertices(range, begin, end); },
+                    &counter);
+            }
+            for (uint32_t begin = 0; begin < range.indexCount; begin += cNumIndicesPerJob)
+            {
+                const uint32_t end = std::min(begin + cNumIndicesPerJob, range.indexCount);
+                m_pJobSystem->Submit(
+                    [this, &range, begin, end]() { ConvertGltfIndices(range, begin, end); },
+                    &counter);
+            }
+        }
+        m_pJobSystem->Wait(&counter);
+    }
+    else
+    {
+        for (const GltfPrimitiveRange& range : primitiveRanges)
+        {
+            ConvertGltfVertices(range, 0, range.vertexCount);
+            // non-indexed primitives have no index range
+            if (range.indexCount > 0)
+            {
+                ConvertGltfIndices(range, 0, range.indexCount);
             }
         }
     }
-    m_vertices.resize(totalVertexCount);
-    m_indices.resize(totalIndexCount);
+    m_vertexPos = vertexOffset;
+    m_indexPos  = indexOffset;
+
+    // meshlets are built from the optimized order
+    if (m_optimizeMeshes)
+    {
+        OptimizeGltfMeshes(primitiveRanges);
+    }
+    std::vector<uint32_t> firstMeshlets;
+    if (m_buildMeshlets)
+    {
+        BuildGltfMeshlets(primitiveRanges, firstMeshlets);
+    }
 
+    const auto& sgMaterials = pScene->GetComponents<sg::Material>();
+    size_t rangeIndex       = 0;
     for (const fastgltf::Mesh& gltfMesh : m_gltfAsset.meshes)
     {
         UniquePtr<sg::Mesh> sgMesh = MakeUnique<sg::Mesh>(std::string(gltfMesh.name));
         uint32_t subMeshIndex      = 0;
         for (const auto& primitive : gltfMesh.primitives)
         {
-            uint32_t vertexStart = static_cast<uint32_t>(m_vertexPos);
-            uint32_t indexStart  = static_cast<uint32_t>(m_indexPos);
-            uint32_t indexCount  = 0;
-            uint32_t vertexCount = 0;
+            const GltfPrimitiveRange& range = primitiveRanges[rangeIndex++];
             Vec3 posMin{};
             Vec3 posMax{};
-            Vec4 diffuseColor = Vec4(1.0f);
+            if (primitive.findAttribute("POSITION") != primitive.attributes.end())
+            {
+                const fastgltf::Accessor& accessor =
+                    m_gltfAsset.accessors[primitive.findAttribute("POSITION")->accessorIndex];
+                auto minValues = *(std::get_if<FASTGLTF_STD_PMR_NS::vector<double>>(&accessor.min));
+                auto maxValues = *(std::get_if<FASTGLTF_STD_PMR_NS::vector<double>>(&accessor.max));
+                // update min max position
+                posMin = Vec3(minValues[0], minValues[1], minValues[2]);
+                posMax = Vec3(maxValues[0], maxValues[1], maxValues[2]);
+            }
             // get sub mesh material
             sg::Material* pSgMaterial = nullptr;
             uint32_t materialIndex;
-            const auto& sgMaterials = pScene->GetComponents<sg::Material>();
             if (primitive.materialIndex.has_value())
             {
                 materialIndex = primitive.materialIndex.value();
-                pSgMaterial    = sgMaterials[materialIndex];
-                diffuseColor  = glm::make_vec4(
-                    m_gltfAsset.materials[materialIndex].pbrData.baseColorFactor.data());
+                pSgMaterial   = sgMaterials[materialIndex];
             }
             else
             {
                 materialIndex = sgMaterials.size() - 1;
-                pSgMaterial    = sgMaterials.back();
+                pSgMaterial   = sgMaterials.back();
             }
 
-            // Vertices
-            const float* pBufferPos          = nullptr;
-            const float* pBufferNormals      = nullptr;
-            const float* pBufferTangents     = nullptr;
-            const float* pBufferTexCoordSet0 = nullptr;
-            const float* pBufferTexCoordSet1 = nullptr;
-            const void* pBufferColorSet0     = nullptr;
-            const uint32_t* pBufferJoints    = nullptr;
-            const float* pBufferWeights      = nullptr;
-
-            fastgltf::ComponentType jointsBufferComponentType = fastgltf::ComponentType::Invalid;
-            fastgltf::ComponentType colorBufferComponentType  = fastgltf::ComponentType::Invalid;
-            // Get buffer data for vertex positions
-            if (primitive.findAttribute("POSITION") != primitive.attributes.end())
+            const auto subMeshName =
+                fmt::format("Mesh_{}_SubMesh#{}", std::string(gltfMesh.name), subMeshIndex);
+            // create sub mesh
+            UniquePtr<sg::SubMesh> subMesh = MakeUnique<sg::SubMesh>(
+                subMeshName, range.indexOffset, range.indexCount, range.vertexCount);
+            subMesh->SetMaterial(materialIndex, pSgMaterial);
+            subMesh->SetAABB(posMin, posMax);
+            if (m_buildMeshlets)
             {
-                fastgltf::Accessor& accessor =
-                    m_gltfAsset.accessors[primitive.findAttribute("POSITION")->accessorIndex];
-                LoadAccessor<float>(accessor, pBufferPos, &vertexCount);
-                auto minValues = *(std::get_if<FASTGLTF_STD_PMR_NS::vector<double>>(&accessor.min));
-                auto maxValues = *(std::get_if<FASTGLTF_STD_PMR_NS::vector<double>>(&accessor.max));
-                // update min max position
-                posMin = Vec3(minValues[0], minValues[1], minValues[2]);
-                posMax = Vec3(maxValues[0], maxValues[1], maxValues[2]);
+                subMesh->SetMeshletRange(firstMeshlets[rangeIndex - 1],
+                                         firstMeshlets[rangeIndex] - firstMeshlets[rangeIndex - 1]);
             }
-            // Get buffer data for vertex color
-            if (primitive.findAttribute("COLOR_0") != primitive.attributes.end())
+
+            sgMesh->AddSubMesh(subMesh.Get());
+            sgMesh->SetAABB(posMin, posMax);
+
+            pScene->AddComponent(std::move(subMesh));
+            subMeshIndex++;
+        }
+        pScene->AddComponent(std::move(sgMesh));
+    }
+}
+
+void FastGLTFLoader::OptimizeGltfMeshes(const std::vector<GltfPrimitiveRange>& primitiveRanges)
+{
+    // primitives own disjoint vertex ranges and can be optimized independently
+    auto OptimizePrimitive = [this](const GltfPrimitiveRange& range) {
+        if (range.indexCount == 0 || range.pPrimitive->type != fastgltf::PrimitiveType::Triangles)
+        {
+            return;
+        }
+        MeshOptimizer::Optimize(m_vertices.data(), m_indices.data() + range.indexOffset,
+                                range.indexCount);
+    };
+    if (m_pJobSystem != nullptr)
+    {
+        JobCounter counter;
+        for (const GltfPrimitiveRange& range : primitiveRanges)
+        {
+            m_pJobSystem->Submit([&OptimizePrimitive, &range]() { OptimizePrimitive(range); },
+                                 &counter);
+        }
+        m_pJobSystem->Wait(&counter);
+    }
+    else
+    {
+        for (const GltfPrimitiveRange& range : primitiveRanges)
+        {
+            OptimizePrimitive(range);
+        }
+    }
+}
+
+void FastGLTFLoader::BuildGltfMeshlets(const std::vector<GltfPrimitiveRange>& primitiveRanges,
+                                       std::vector<uint32_t>& firstMeshlets)
+{
+    // primitives are independent, build them separately and concatenate in primitive order
+    std::vector<MeshletData> primitiveMeshlets(primitiveRanges.size());
+    auto BuildPrimitiveMeshlets = [this, &primitiveRanges, &primitiveMeshlets](size_t i) {
+        const GltfPrimitiveRange& range = primitiveRanges[i];
+        MeshletBuilder::Build(m_vertices.data(), m_indices.data() + range.indexOffset,
+                              range.indexCount, primitiveMeshlets[i]);
+    };
+    if (m_pJobSystem != nullptr)
+    {
+        JobCounter counter;
+        for (size_t i = 0; i < primitiveRanges.size(); ++i)
+        {
+            m_pJobSystem->Submit([&BuildPrimitiveMeshlets, i]() { BuildPrimitiveMeshlets(i); },
+                                 &counter);
+        }
+        m_pJobSystem->Wait(&counter);
+    }
+    else
+    {
+        for (size_t i = 0; i < primitiveRanges.size(); ++i)
+        {
+            BuildPrimitiveMeshlets(i);
+        }
+    }
+
+    firstMeshlets.resize(primitiveRanges.size() + 1);
+    for (size_t i = 0; i < primitiveRanges.size(); ++i)
+    {
+        firstMeshlets[i]            = static_cast<uint32_t>(m_meshletData.meshlets.size());
+        const uint32_t vertexBase   = static_cast<uint32_t>(m_meshletData.vertices.size());
+        const uint32_t triangleBase = static_cast<uint32_t>(m_meshletData.triangles.size() / 3);
+        for (Meshlet meshlet : primitiveMeshlets[i].meshlets)
+        {
+            meshlet.vertexOffset += vertexBase;
+            meshlet.triangleOffset += triangleBase;
+            m_meshletData.meshlets.push_back(meshlet);
+        }
+        m_meshletData.vertices.insert(m_meshletData.vertices.end(),
+                                      primitiveMeshlets[i].vertices.begin(),
+                                      primitiveMeshlets[i].vertices.end());
+        m_meshletData.triangles.insert(m_meshletData.triangles.end(),
+                                       primitiveMeshlets[i].triangles.begin(),
+                                       primitiveMeshlets[i].triangles.end());
+    }
+    firstMeshlets.back() = static_cast<uint32_t>(m_meshletData.meshlets.size());
+}
+
+void FastGLTFLoader::ConvertGltfVertices(const GltfPrimitiveRange& range,
+                                         uint32_t vertexBegin,
+                                         uint32_t vertexEnd)
+{
+    const fastgltf::Primitive& primitive = *range.pPrimitive;
+    const Vec4 diffuseColor              = range.diffuseColor;
+
+    const float* pBufferPos          = nullptr;
+    const float* pBufferNormals      = nullptr;
+    const float* pBufferTangents     = nullptr;
+    const float* pBufferTexCoordSet0 = nullptr;
+    const float* pBufferTexCoordSet1 = nullptr;
+    const void* pBufferColorSet0     = nullptr;
+    const uint32_t* pBufferJoints    = nullptr;
+    const float* pBufferWeights      = nullptr;
+
+    fastgltf::ComponentType jointsBufferComponentType = fastgltf::ComponentType::Invalid;
+    fastgltf::ComponentType colorBufferComponentType  = fastgltf::ComponentType::Invalid;
+    // Get buffer data for vertex positions
+    if (primitive.findAttribute("POSITION") != primitive.attributes.end())
+    {
+        LoadAccessor<float>(
+            m_gltfAsset.accessors[primitive.findAttribute("POSITION")->accessorIndex], pBufferPos);
+    }
+    // Get buffer data for vertex color
+    if (primitive.findAttribute("COLOR_0") != primitive.attributes.end())
+    {
+        const fastgltf::Accessor& accessor =
+            m_gltfAsset.accessors[primitive.findAttribute("COLOR_0")->accessorIndex];
+        colorBufferComponentType = accessor.componentType;
+        switch (colorBufferComponentType)
+        {
+            case fastgltf::ComponentType::Float:
             {
-                fastgltf::Accessor& accessor =
-                    m_gltfAsset.accessors[primitive.findAttribute("COLOR_0")->accessorIndex];
-                colorBufferComponentType = accessor.componentType;
-                switch (colorBufferComponentType)
-                {
-                    case fastgltf::ComponentType::Float:
-                    {
-                        const float* pBuffer;
-                        LoadAccessor<float>(
-                            m_gltfAsset
-                                .accessors[primitive.findAttribute("COLOR_0")->accessorIndex],
-                            pBuffer);
-                        pBufferColorSet0 = pBuffer;
-                        break;
-                    }
-                    case fastgltf::ComponentType::UnsignedShort:
-                    {
-                        const uint16_t* pBuffer;
-                        LoadAccessor<uint16_t>(
-                            m_gltfAsset
-                                .accessors[primitive.findAttribute("COLOR_0")->accessorIndex],
-                            pBuffer);
-                        pBufferColorSet0 = pBuffer;
-                        break;
-                    }
-                    case fastgltf::ComponentType::UnsignedByte:
-                    {
-                        const uint8_t* pBuffer;
-                        LoadAccessor<uint8_t>(
-                            m_gltfAsset
-                                .accessors[primitive.findAttribute("COLOR_0")->accessorIndex],
-                            pBuffer);
-                        pBufferColorSet0 = pBuffer;
-                        break;
-                    }
-                    default:
-                    {
-                        LOGE("Unexpected component type {}", (uint16_t)colorBufferComponentType);
-                        break;
-                    }
-                }
+                const float* pBuffer;
+                LoadAccessor<float>(accessor, pBuffer);
+                pBufferColorSet0 = pBuffer;
+                break;
             }
-            // Get buffer data for vertex normals
-            if (primitive.findAttribute("NORMAL") != primitive.attributes.end())
+            case fastgltf::ComponentType::UnsignedShort:
             {
-                LoadAccessor<float>(
-                    m_gltfAsset.accessors[primitive.findAttribute("NORMAL")->accessorIndex],
-                    pBufferNormals);
+                const uint16_t* pBuffer;
+                LoadAccessor<uint16_t>(accessor, pBuffer);
+                pBufferColorSet0 = pBuffer;
+                break;
             }
-            // Get buffer data for vertex tangents
-            if (primitive.findAttribute("TANGENT") != primitive.attributes.end())
+            case fastgltf::ComponentType::UnsignedByte:
             {
-                LoadAccessor<float>(
-                    m_gltfAsset.accessors[primitive.findAttribute("TANGENT")->accessorIndex],
-                    pBufferTangents);
+                const uint8_t* pBuffer;
+                LoadAccessor<uint8_t>(accessor, pBuffer);
+                pBufferColorSet0 = pBuffer;
+                break;
             }
-            // Get buffer data for vertex texture coordinates
-            // glTF supports multiple sets
-            if (primitive.findAttribute("TEXCOORD_0") != primitive.attributes.end())
+            default:
             {
-                LoadAccessor<float>(
-                    m_gltfAsset.accessors[primitive.findAttribute("TEXCOORD_0")->accessorIndex],
-                    pBufferTexCoordSet0);
+                LOGE("Unexpected component type {}", (uint16_t)colorBufferComponentType);
+                break;
             }
-            if (primitive.findAttribute("TEXCOORD_1") != primitive.attributes.end())
+        }
+    }
+    // Get buffer data for vertex normals
+    if (primitive.findAttribute("NORMAL") != primitive.attributes.end())
+    {
+        LoadAccessor<float>(
+            m_gltfAsset.accessors[primitive.findAttribute("NORMAL")->accessorIndex],
+            pBufferNormals);
+    }
+    // Get buffer data for vertex tangents
+    if (primitive.findAttribute("TANGENT") != primitive.attributes.end())
+    {
+        LoadAccessor<float>(
+            m_gltfAsset.accessors[primitive.findAttribute("TANGENT")->accessorIndex],
+            pBufferTangents);
+    }
+    // Get buffer data for vertex texture coordinates
+    // glTF supports multiple sets
+    if (primitive.findAttribute("TEXCOORD_0") != primitive.attributes.end())
+    {
+        LoadAccessor<float>(
+            m_gltfAsset.accessors[primitive.findAttribute("TEXCOORD_0")->accessorIndex],
+            pBufferTexCoordSet0);
+    }
+    if (primitive.findAttribute("TEXCOORD_1") != primitive.attributes.end())
+    {
+        LoadAccessor<float>(
+            m_gltfAsset.accessors[primitive.findAttribute("TEXCOORD_1")->accessorIndex],
+            pBufferTexCoordSet1);
+    }
+
+    // Get buffer data for joints
+    if (primitive.findAttribute("JOINTS_0") != primitive.attributes.end())
+    {
+        const fastgltf::Accessor& accessor =
+            m_gltfAsset.accessors[primitive.findAttribute("JOINTS_0")->accessorIndex];
+        LoadAccessor<uint32_t>(accessor, pBufferJoints);
+        jointsBufferComponentType = accessor.componentType;
+    }
+    // Get buffer data for joint weights
+    if (primitive.findAttribute("WEIGHTS_0") != primitive.attributes.end())
+    {
+        LoadAccessor<float>(
+            m_gltfAsset.accessors[primitive.findAttribute("WEIGHTS_0")->accessorIndex],
+            pBufferWeights);
+    }
+    // Append data to model's vertex buffer
+    for (size_t vertexIterator = vertexBegin; vertexIterator < vertexEnd; ++vertexIterator)
+    {
+        Vertex vertex{};
+        // position
+        auto position =
+            pBufferPos ? glm::make_vec3(&pBufferPos[vertexIterator * 3]) : glm::vec3(0.0f);
+        vertex.pos = glm::vec4(position.x, position.y, position.z, 1.0f);
+        // color
+        glm::vec3 vertexColor{1.0f};
+        switch (colorBufferComponentType)
+        {
+            case fastgltf::ComponentType::Float:
             {
-                LoadAccessor<float>(
-                    m_gltfAsset.accessors[primitive.findAttribute("TEXCOORD_1")->accessorIndex],
-                    pBufferTexCoordSet1);
+                vertexColor = pBufferColorSet0 ?
+                    glm::make_vec3(&(
+                        (static_cast<const float*>(pBufferColorSet0))[vertexIterator * 3])) :
+                    glm::vec3(1.0f);
+                break;
             }
-
-            // Get buffer data for joints
-            if (primitive.findAttribute("JOINTS_0") != primitive.attributes.end())
+            case fastgltf::ComponentType::UnsignedShort:
             {
-                fastgltf::Accessor& accessor =
-                    m_gltfAsset.accessors[primitive.findAttribute("JOINTS_0")->accessorIndex];
-                LoadAccessor<uint32_t>(accessor, pBufferJoints);
-                jointsBufferComponentType = accessor.componentType;
+                const uint16_t* pVec3 =
+                    &((static_cast<const uint16_t*>(pBufferColorSet0))[vertexIterator * 3]);
+                float norm  = 0xFFFF;
+                vertexColor = pBufferColorSet0 ?
+                    glm::vec3(pVec3[0] / norm, pVec3[1] / norm, pVec3[2] / norm) :
+                    glm::vec3(1.0f);
+                break;
             }
-            // Get buffer data for joint weights
-            if (primitive.findAttribute("WEIGHTS_0") != primitive.attributes.end())
+            case fastgltf::ComponentType::UnsignedByte:
             {
-                LoadAccessor<float>(
-                    m_gltfAsset.accessors[primitive.findAttribute("WEIGHTS_0")->accessorIndex],
-                    pBufferWeights);
+                const uint8_t* pVec3 =
+                    &((static_cast<const uint8_t*>(pBufferColorSet0))[vertexIterator * 3]);
+                float norm  = 0xFF;
+                vertexColor = pBufferColorSet0 ?
+                    glm::vec3(pVec3[0] / norm, pVec3[1] / norm, pVec3[2] / norm) :
+                    glm::vec3(1.0f);
+                break;
             }
-            // Append data to model's vertex buffer
-            for (size_t vertexIterator = 0; vertexIterator < vertexCount; ++vertexIterator)
+            default:
             {
-                Vertex vertex{};
-                // position
-                auto position =
-                    pBufferPos ? glm::make_vec3(&pBufferPos[vertexIterator * 3]) : glm::vec3(0.0f);
-                vertex.pos = glm::vec4(position.x, position.y, position.z, 1.0f);
-                // color
-                glm::vec3 vertexColor{1.0f};
-                switch (colorBufferComponentType)
-                {
-                    case fastgltf::ComponentType::Float:
-                    {
-                        vertexColor = pBufferColorSet0 ?
-                            glm::make_vec3(&(
-                                (static_cast<const float*>(pBufferColorSet0))[vertexIterator * 3])) :
-                            glm::vec3(1.0f);
-                        break;
-                    }
-                    case fastgltf::ComponentType::UnsignedShort:
-                    {
-                        const uint16_t* pVec3 =
-                            &((static_cast<const uint16_t*>(pBufferColorSet0))[vertexIterator * 3]);
-                        float norm  = 0xFFFF;
-                        vertexColor = pBufferColorSet0 ?
-                            glm::vec3(pVec3[0] / norm, pVec3[1] / norm, pVec3[2] / norm) :
-                            glm::vec3(1.0f);
-                        break;
-                    }
-                    case fastgltf::ComponentType::UnsignedByte:
-                    {
-                        const uint8_t* pVec3 =
-                            &((static_cast<const uint8_t*>(pBufferColorSet0))[vertexIterator * 3]);
-                        float norm  = 0xFF;
-                        vertexColor = pBufferColorSet0 ?
-                            glm::vec3(pVec3[0] / norm, pVec3[1] / norm, pVec3[2] / norm) :
-                            glm::vec3(1.0f);
-                        break;
-                    }
-                    default:
-                    {
-                        break;
-                    }
-                }
-                vertex.color =
-                    glm::vec4(vertexColor.x, vertexColor.y, vertexColor.z, 1.0f) * diffuseColor;
-                // normal
-                vertex.normal = glm::normalize(glm::vec4(
-                    pBufferNormals ?
-                        glm::vec4(glm::make_vec3(&pBufferNormals[vertexIterator * 3]), 0.0f) :
-                        glm::vec4(0.0f)));
-                // uv0
-                auto uv0   = pBufferTexCoordSet0 ?
-                      glm::make_vec2(&pBufferTexCoordSet0[vertexIterator * 2]) :
-                      glm::vec3(0.0f);
-                vertex.uv0 = uv0;
-                // uv1
-                auto uv1   = pBufferTexCoordSet1 ?
-                      glm::make_vec2(&pBufferTexCoordSet1[vertexIterator * 2]) :
-                      glm::vec3(0.0f);
-                vertex.uv1 = uv1;
-                // tangent
-                glm::vec4 tangent = pBufferTangents ?
-                    glm::make_vec4(&pBufferTangents[vertexIterator * 4]) :
-                    glm::vec4(0.0f);
-                vertex.tangent =
-                    Vec4(glm::vec3(tangent.x, tangent.y, tangent.z) * tangent.w, tangent.w);
-                // joint indices and joint weights
-                if (pBufferJoints && pBufferWeights)
-                {
-                    switch (jointsBufferComponentType)
-                    {
-                        case fastgltf::ComponentType::Byte:
-                        case fastgltf::ComponentType::UnsignedByte:
-                            vertex.joint0 =
-                                glm::ivec4(glm::make_vec4(&(reinterpret_cast<const int8_t*>(
-                                    pBufferJoints)[vertexIterator * 4])));
-                            break;
-                        case fastgltf::ComponentType::Short:
-                        case fastgltf::ComponentType::UnsignedShort:
-                            vertex.joint0 =
-                                glm::ivec4(glm::make_vec4(&(reinterpret_cast<const int16_t*>(
-                                    pBufferJoints)[vertexIterator * 4])));
-                            break;
-                        case fastgltf::ComponentType::Int:
-                        case fastgltf::ComponentType::UnsignedInt:
-                            vertex.joint0 =
-                                glm::ivec4(glm::make_vec4(&(reinterpret_cast<const int32_t*>(
-                                    pBufferJoints)[vertexIterator * 4])));
-                            break;
-                        default: LOGE("data type of joints buffer not found"); break;
-                    }
-                    vertex.weight0 = glm::make_vec4(&pBufferWeights[vertexIterator * 4]);
-                }
-                m_vertices[m_vertexPos] = vertex;
-                m_vertexPos++;
+                break;
             }
-            // Indices
-            if (primitive.indicesAccessor.has_value())
+        }
+        vertex.color =
+            glm::vec4(vertexColor.x, vertexColor.y, vertexColor.z, 1.0f) * diffuseColor;
+        // normal
+        vertex.normal = glm::normalize(glm::vec4(
+            pBufferNormals ?
+                glm::vec4(glm::make_vec3(&pBufferNormals[vertexIterator * 3]), 0.0f) :
+                glm::vec4(0.0f)));
+        // uv0
+        auto uv0   = pBufferTexCoordSet0 ?
+              glm::make_vec2(&pBufferTexCoordSet0[vertexIterator * 2]) :
+              glm::vec3(0.0f);
+        vertex.uv0 = uv0;
+        // uv1
+        auto uv1   = pBufferTexCoordSet1 ?
+              glm::make_vec2(&pBufferTexCoordSet1[vertexIterator * 2]) :
+              glm::vec3(0.0f);
+        vertex.uv1 = uv1;
+        // tangent
+        glm::vec4 tangent = pBufferTangents ?
+            glm::make_vec4(&pBufferTangents[vertexIterator * 4]) :
+            glm::vec4(0.0f);
+        vertex.tangent =
+            Vec4(glm::vec3(tangent.x, tangent.y, tangent.z) * tangent.w, tangent.w);
+        // joint indices and joint weights
+        if (pBufferJoints && pBufferWeights)
+        {
+            switch (jointsBufferComponentType)
             {
-                const auto& accessor = m_gltfAsset.accessors[primitive.indicesAccessor.value()];
-                indexCount           = accessor.count;
-                switch (accessor.componentType)
-                {
-                    case fastgltf::ComponentType::UnsignedInt:
-                    {
-                        const uint32_t* pBufferIndices = nullptr;
-                        LoadAccessor<uint32_t>(accessor, pBufferIndices);
-                        for (size_t index = 0; index < accessor.count; index++)
-                        {
-                            m_indices[m_indexPos] = pBufferIndices[index] + vertexStart;
-                            m_indexPos++;
-                        }
-                        break;
-                    }
-                    case fastgltf::ComponentType::UnsignedShort:
-                    {
-                        const uint16_t* pBufferIndices = nullptr;
-                        LoadAccessor<uint16_t>(accessor, pBufferIndices);
-                        for (size_t index = 0; index < accessor.count; index++)
-                        {
-                            m_indices[m_indexPos] = pBufferIndices[index] + vertexStart;
-                            m_indexPos++;
-                        }
-                        break;
-                    }
-                    case fastgltf::ComponentType::UnsignedByte:
-                    {
-                        const uint8_t* pBufferIndices = nullptr;
-                        LoadAccessor<uint8_t>(accessor, pBufferIndices);
-                        for (size_t index = 0; index < accessor.count; index++)
-                        {
-                            m_indices[m_indexPos] = pBufferIndices[index] + vertexStart;
-                            m_indexPos++;
-                        }
-                        break;
-                    }
-                    default: LOGE("Unsupported gltf index component type!"); break;
-                }
+                case fastgltf::ComponentType::Byte:
+                case fastgltf::ComponentType::UnsignedByte:
+                    vertex.joint0 =
+                        glm::ivec4(glm::make_vec4(&(reinterpret_cast<const int8_t*>(
+                            pBufferJoints)[vertexIterator * 4])));
+                    break;
+                case fastgltf::ComponentType::Short:
+                case fastgltf::ComponentType::UnsignedShort:
+                    vertex.joint0 =
+                        glm::ivec4(glm::make_vec4(&(reinterpret_cast<const int16_t*>(
+                            pBufferJoints)[vertexIterator * 4])));
+                    break;
+                case fastgltf::ComponentType::Int:
+                case fastgltf::ComponentType::UnsignedInt:
+                    vertex.joint0 =
+                        glm::ivec4(glm::make_vec4(&(reinterpret_cast<const int32_t*>(
+                            pBufferJoints)[vertexIterator * 4])));
+                    break;
+                default: LOGE("data type of joints buffer not found"); break;
             }
+            vertex.weight0 = glm::make_vec4(&pBufferWeights[vertexIterator * 4]);
+        }
+        m_vertices[range.vertexOffset + vertexIterator] = vertex;
+    }
+}
 
-            const auto subMeshName =
-                fmt::format("Mesh_{}_SubMesh#{}", std::string(gltfMesh.name), subMeshIndex);
-            // create sub mesh
-            UniquePtr<sg::SubMesh> subMesh =
-                MakeUnique<sg::SubMesh>(subMeshName, indexStart, indexCount, vertexCount);
-            subMesh->SetMaterial(materialIndex, pSgMaterial);
-            subMesh->SetAABB(posMin, posMax);
-
-            sgMesh->AddSubMesh(subMesh.Get());
-            sgMesh->SetAABB(posMin, posMax);
-
-            pScene->AddComponent(std::move(subMesh));
-            subMeshIndex++;
+void FastGLTFLoader::ConvertGltfIndices(const GltfPrimitiveRange& range,
+                                        uint32_t indexBegin,
+                                        uint32_t indexEnd)
+{
+    const auto& accessor = m_gltfAsset.accessors[range.pPrimitive->indicesAccessor.value()];
+    uint32_t* pDstIndices = m_indices.data() + range.indexOffset;
+    switch (accessor.componentType)
+    {
+        case fastgltf::ComponentType::UnsignedInt:
+        {
+            const uint32_t* pBufferIndices = nullptr;
+            LoadAccessor<uint32_t>(accessor, pBufferIndices);
+            for (size_t index = indexBegin; index < indexEnd; index++)
+            {
+                pDstIndices[index] = pBufferIndices[index] + range.vertexOffset;
+            }
+            break;
         }
-        pScene->AddComponent(std::move(sgMesh));
+        case fastgltf::ComponentType::UnsignedShort:
+        {
+            const uint16_t* pBufferIndices = nullptr;
+            LoadAccessor<uint16_t>(accessor, pBufferIndices);
+            for (size_t index = indexBegin; index < indexEnd; index++)
+            {
+                pDstIndices[index] = pBufferIndices[index] + range.vertexOffset;
+            }
+            break;
+        }
+        case fastgltf::ComponentType::UnsignedByte:
+        {
+            const uint8_t* pBufferIndices = nullptr;
+            LoadAccessor<uint8_t>(accessor, pBufferIndices);
+            for (size_t index = indexBegin; index < indexEnd; index++)
+            {
+                pDstIndices[index] = pBufferIndices[index] + range.vertexOffset;
+            }
+            break;
+        }
+        default: LOGE("Unsupported gltf index component type!"); break;
     }
 }
 
@@ -769,20 +952,24 @@ void FastGLTFLoader::LoadGltfRenderableNodes(uint32_t nodeIndex,
     auto transform = MakeUnique<sg::Transform>(*newNode);
     newNode->SetParent(pParent);
 
+    SceneCacheNode cacheNode;
     auto TRS = std::get_if<fastgltf::TRS>(&gltfNode.transform);
     if (TRS->translation.size() == 3)
     {
-        transform->SetTranslation(glm::make_vec3(TRS->translation.data()));
+        cacheNode.translation = glm::make_vec3(TRS->translation.data());
+        transform->SetTranslation(cacheNode.translation);
     }
 
     if (TRS->rotation.size() == 4)
     {
-        transform->SetRotation(glm::make_quat(TRS->rotation.data()));
+        cacheNode.rotation = glm::make_quat(TRS->rotation.data());
+        transform->SetRotation(cacheNode.rotation);
     }
 
     if (TRS->scale.size() == 3)
     {
-        transform->SetScale(glm::make_vec3(TRS->scale.data()));
+        cacheNode.scale = glm::make_vec3(TRS->scale.data());
+        transform->SetScale(cacheNode.scale);
     }
 
     // Node with children
@@ -812,6 +999,15 @@ void FastGLTFLoader::LoadGltfRenderableNodes(uint32_t nodeIndex,
     {
         pParent->AddChild(newNode.Get());
     }
+    if (!m_sceneCacheDir.empty())
+    {
+        cacheNode.index       = nodeIndex;
+        cacheNode.parentIndex = pParent ? static_cast<int32_t>(pParent->GetIndex()) : -1;
+        cacheNode.meshIndex =
+            gltfNode.meshIndex.has_value() ? static_cast<int32_t>(gltfNode.meshIndex.value()) : -1;
+        cacheNode.name = newNode->GetName();
+        m_sceneCacheNodes.push_back(std::move(cacheNode));
+    }
     sgNodes.push_back(newNode);
 }
 } // namespace zen::asset
\ No newline at end of file
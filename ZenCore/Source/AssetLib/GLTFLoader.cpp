@@ -1,6 +1,7 @@
 #define TINYGLTF_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "AssetLib/GLTFLoader.h"
+#include "AssetLib/MeshOptimizer.h"
 #include "Utils/Errors.h"
 #include "SceneGraph/Scene.h"
 #include "SceneGraph/Transform.h"
@@ -592,6 +593,14 @@ void GLTFLoader::LoadGltfMeshes(sg::Scene* pScene)
                         return;
                 }
             }
+            // mode -1 defaults to triangles
+            const bool isTriangleList =
+                primitive.mode == TINYGLTF_MODE_TRIANGLES || primitive.mode == -1;
+            if (m_optimizeMeshes && hasIndices && isTriangleList)
+            {
+                MeshOptimizer::Optimize(m_vertices.data(), m_indices.data() + indexStart,
+                                        indexCount);
+            }
             const auto subMeshName = fmt::format("Mesh {} SubMesh#{}", gltfMesh.name, subMeshIndex);
             // create sub mesh
             UniquePtr<sg::SubMesh> subMesh =
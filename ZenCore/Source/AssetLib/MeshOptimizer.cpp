@@ -0,0 +1,454 @@
+#include "AssetLib/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace zen::asset
+{
+static constexpr uint32_t cInvalidIndex = std::numeric_limits<uint32_t>::max();
+// lru cache modelled while scoring vertices, larger than the analyzed fifo on purpose, the
+// ordering then also suits bigger caches
+static constexpr uint32_t cMaxScoreCacheSize = 32;
+static constexpr float cCacheDecayPower      = 1.5f;
+static constexpr float cLastTriangleScore    = 0.75f;
+static constexpr float cValenceBoostScale    = 2.0f;
+static constexpr float cValenceBoostPower    = 0.5f;
+static constexpr uint32_t cMaxValenceTable   = 32;
+
+// smallest and largest index as [baseVertex, baseVertex + numVertices)
+static void CalcVertexRange(const uint32_t* pIndices,
+                            uint32_t numIndices,
+                            uint32_t& baseVertex,
+                            uint32_t& numVertices)
+{
+    const auto [pMinIndex, pMaxIndex] = std::minmax_element(pIndices, pIndices + numIndices);
+    baseVertex                        = *pMinIndex;
+    numVertices                       = *pMaxIndex - baseVertex + 1;
+}
+
+static Vec3 GetPosition(const Vertex& vertex)
+{
+    return Vec3(vertex.pos.x, vertex.pos.y, vertex.pos.z);
+}
+
+namespace
+{
+// Forsyth's vertex score, recently used vertices and vertices with few remaining triangles score
+// high, so that the ordering finishes local fans before moving on
+class VertexScoreTable
+{
+public:
+    VertexScoreTable()
+    {
+        for (uint32_t i = 0; i < cMaxScoreCacheSize; ++i)
+        {
+            if (i < 3)
+            {
+                // the last triangle's vertices are scored lower to avoid strips turning back
+                m_cacheScores[i] = cLastTriangleScore;
+            }
+            else
+            {
+                const float scale = 1.0f / (cMaxScoreCacheSize - 3);
+                m_cacheScores[i]  = std::pow(1.0f - (i - 3) * scale, cCacheDecayPower);
+            }
+        }
+        m_valenceScores[0] = 0.0f;
+        for (uint32_t i = 1; i < cMaxValenceTable; ++i)
+        {
+            m_valenceScores[i] =
+                cValenceBoostScale * std::pow(static_cast<float>(i), -cValenceBoostPower);
+        }
+    }
+
+    float GetScore(uint32_t cachePosition, uint32_t numLiveTriangles) const
+    {
+        if (numLiveTriangles == 0)
+        {
+            return -1.0f;
+        }
+        const float cacheScore =
+            cachePosition < cMaxScoreCacheSize ? m_cacheScores[cachePosition] : 0.0f;
+        if (numLiveTriangles < cMaxValenceTable)
+        {
+            return cacheScore + m_valenceScores[numLiveTriangles];
+        }
+        const float valence = static_cast<float>(numLiveTriangles);
+        return cacheScore + cValenceBoostScale * std::pow(valence, -cValenceBoostPower);
+    }
+
+private:
+    float m_cacheScores[cMaxScoreCacheSize];
+    float m_valenceScores[cMaxValenceTable];
+};
+
+// fifo cache that keeps hits and misses of a triangle sequence, reset only invalidates entries
+class FifoCacheSimulator
+{
+public:
+    FifoCacheSimulator(uint32_t baseVertex, uint32_t numVertices, uint32_t cacheSize) :
+        m_baseVertex(baseVertex), m_cacheSize(cacheSize), m_timestamps(numVertices, 0)
+    {}
+
+    // returns the number of vertices the triangle has to transform
+    uint32_t AddTriangle(const uint32_t* pTriangle)
+    {
+        uint32_t numMisses = 0;
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            uint32_t& timestamp = m_timestamps[pTriangle[i] - m_baseVertex];
+            if (timestamp == 0 || m_timestamp - timestamp >= m_cacheSize)
+            {
+                timestamp = ++m_timestamp;
+                numMisses++;
+            }
+        }
+        return numMisses;
+    }
+
+    void Reset()
+    {
+        m_timestamp += m_cacheSize + 1;
+    }
+
+private:
+    uint32_t m_baseVertex;
+    uint32_t m_cacheSize;
+    // m_timestamp when a vertex last entered the cache, 0 if never
+    uint32_t m_timestamp{0};
+    std::vector<uint32_t> m_timestamps;
+};
+} // namespace
+
+void MeshOptimizer::Optimize(Vertex* pVertices, uint32_t* pIndices, uint32_t numIndices)
+{
+    OptimizeVertexCache(pIndices, numIndices);
+    OptimizeOverdraw(pVertices, pIndices, numIndices);
+    OptimizeVertexFetch(pVertices, pIndices, numIndices);
+}
+
+void MeshOptimizer::OptimizeVertexCache(uint32_t* pIndices, uint32_t numIndices)
+{
+    static const VertexScoreTable cScoreTable;
+
+    const uint32_t numTriangles = numIndices / 3;
+    if (numTriangles == 0)
+    {
+        return;
+    }
+    uint32_t baseVertex  = 0;
+    uint32_t numVertices = 0;
+    CalcVertexRange(pIndices, numTriangles * 3, baseVertex, numVertices);
+
+    // vertex -> live triangles, emitted triangles are swapped out of each vertex's list
+    std::vector<uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    for (uint32_t i = 0; i < numTriangles * 3; ++i)
+    {
+        adjacencyOffsets[pIndices[i] - baseVertex + 1]++;
+    }
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+    }
+    std::vector<uint32_t> adjacency(numTriangles * 3);
+    std::vector<uint32_t> numLiveTriangles(numVertices, 0);
+    for (uint32_t i = 0; i < numTriangles * 3; ++i)
+    {
+        const uint32_t vertex = pIndices[i] - baseVertex;
+        adjacency[adjacencyOffsets[vertex] + numLiveTriangles[vertex]++] = i / 3;
+    }
+
+    std::vector<uint32_t> cachePositions(numVertices, cInvalidIndex);
+    std::vector<float> vertexScores(numVertices);
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        vertexScores[i] = cScoreTable.GetScore(cInvalidIndex, numLiveTriangles[i]);
+    }
+    std::vector<float> triangleScores(numTriangles);
+    uint32_t bestTriangle = 0;
+    for (uint32_t i = 0; i < numTriangles; ++i)
+    {
+        triangleScores[i] = vertexScores[pIndices[i * 3 + 0] - baseVertex] +
+            vertexScores[pIndices[i * 3 + 1] - baseVertex] +
+            vertexScores[pIndices[i * 3 + 2] - baseVertex];
+        if (triangleScores[i] > triangleScores[bestTriangle])
+        {
+            bestTriangle = i;
+        }
+    }
+
+    std::vector<uint8_t> emitted(numTriangles, 0);
+    std::vector<uint32_t> optimizedIndices(numTriangles * 3);
+    uint32_t cache[cMaxScoreCacheSize + 3];
+    uint32_t newCache[cMaxScoreCacheSize + 3];
+    uint32_t cacheSize  = 0;
+    uint32_t scanCursor = 0;
+    for (uint32_t numEmitted = 0; numEmitted < numTriangles; ++numEmitted)
+    {
+        if (bestTriangle == cInvalidIndex)
+        {
+            // no live triangle touches the cache, restart from the next one in index order
+            while (emitted[scanCursor])
+            {
+                scanCursor++;
+            }
+            bestTriangle = scanCursor;
+        }
+        const uint32_t* pTriangle = pIndices + bestTriangle * 3;
+        std::copy(pTriangle, pTriangle + 3, optimizedIndices.data() + numEmitted * 3);
+        emitted[bestTriangle] = 1;
+
+        // the triangle's vertices move to the front, the rest shifts back
+        uint32_t newCacheSize = 0;
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            const uint32_t vertex = pTriangle[i] - baseVertex;
+            if (std::find(newCache, newCache + newCacheSize, vertex) == newCache + newCacheSize)
+            {
+                newCache[newCacheSize++] = vertex;
+            }
+            uint32_t* pLiveBegin = adjacency.data() + adjacencyOffsets[vertex];
+            uint32_t* pLiveEnd   = pLiveBegin + numLiveTriangles[vertex];
+            uint32_t* pEntry     = std::find(pLiveBegin, pLiveEnd, bestTriangle);
+            if (pEntry != pLiveEnd)
+            {
+                *pEntry = *(pLiveEnd - 1);
+                numLiveTriangles[vertex]--;
+            }
+        }
+        const uint32_t numTriangleVertices = newCacheSize;
+        for (uint32_t i = 0; i < cacheSize; ++i)
+        {
+            if (std::find(newCache, newCache + numTriangleVertices, cache[i]) ==
+                newCache + numTriangleVertices)
+            {
+                newCache[newCacheSize++] = cache[i];
+            }
+        }
+
+        // rescore vertices that entered, moved or fell out of the cache and their triangles
+        for (uint32_t i = 0; i < newCacheSize; ++i)
+        {
+            const uint32_t vertex  = newCache[i];
+            cachePositions[vertex] = i < cMaxScoreCacheSize ? i : cInvalidIndex;
+            vertexScores[vertex] =
+                cScoreTable.GetScore(cachePositions[vertex], numLiveTriangles[vertex]);
+        }
+        bestTriangle    = cInvalidIndex;
+        float bestScore = std::numeric_limits<float>::lowest();
+        for (uint32_t i = 0; i < newCacheSize; ++i)
+        {
+            const uint32_t vertex = newCache[i];
+            for (uint32_t j = 0; j < numLiveTriangles[vertex]; ++j)
+            {
+                const uint32_t triangle = adjacency[adjacencyOffsets[vertex] + j];
+                triangleScores[triangle] = vertexScores[pIndices[triangle * 3 + 0] - baseVertex] +
+                    vertexScores[pIndices[triangle * 3 + 1] - baseVertex] +
+                    vertexScores[pIndices[triangle * 3 + 2] - baseVertex];
+                if (triangleScores[triangle] > bestScore)
+                {
+                    bestTriangle = triangle;
+                    bestScore    = triangleScores[triangle];
+                }
+            }
+        }
+        cacheSize = std::min(newCacheSize, cMaxScoreCacheSize);
+        std::copy(newCache, newCache + cacheSize, cache);
+    }
+    std::copy(optimizedIndices.begin(), optimizedIndices.end(), pIndices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(const Vertex* pVertices,
+                                     uint32_t* pIndices,
+                                     uint32_t numIndices,
+                                     float threshold)
+{
+    const uint32_t numTriangles = numIndices / 3;
+    if (numTriangles < 2)
+    {
+        return;
+    }
+    uint32_t baseVertex  = 0;
+    uint32_t numVertices = 0;
+    CalcVertexRange(pIndices, numTriangles * 3, baseVertex, numVertices);
+
+    // hard boundaries where the cache optimized order misses all three vertices anyway
+    std::vector<uint32_t> hardBoundaries;
+    {
+        FifoCacheSimulator cache(baseVertex, numVertices, cCacheSize);
+        for (uint32_t i = 0; i < numTriangles; ++i)
+        {
+            if (cache.AddTriangle(pIndices + i * 3) == 3)
+            {
+                hardBoundaries.push_back(i);
+            }
+        }
+        hardBoundaries.push_back(numTriangles);
+    }
+
+    // soft boundaries split hard clusters wherever the part before restarting the cache is
+    // within threshold of the whole cluster's acmr (Sander et al., Fast Triangle Reordering)
+    std::vector<uint32_t> clusterStarts;
+    FifoCacheSimulator cache(baseVertex, numVertices, cCacheSize);
+    for (size_t i = 0; i + 1 < hardBoundaries.size(); ++i)
+    {
+        const uint32_t begin = hardBoundaries[i];
+        const uint32_t end   = hardBoundaries[i + 1];
+        cache.Reset();
+        uint32_t numMisses = 0;
+        for (uint32_t j = begin; j < end; ++j)
+        {
+            numMisses += cache.AddTriangle(pIndices + j * 3);
+        }
+        const float clusterThreshold = threshold * numMisses / (end - begin);
+
+        cache.Reset();
+        clusterStarts.push_back(begin);
+        uint32_t clusterStart     = begin;
+        uint32_t numClusterMisses = 0;
+        for (uint32_t j = begin; j < end; ++j)
+        {
+            numClusterMisses += cache.AddTriangle(pIndices + j * 3);
+            const float clusterAcmr = static_cast<float>(numClusterMisses) / (j - clusterStart + 1);
+            if (j + 1 < end && clusterAcmr <= clusterThreshold)
+            {
+                cache.Reset();
+                clusterStart     = j + 1;
+                numClusterMisses = 0;
+                clusterStarts.push_back(clusterStart);
+            }
+        }
+    }
+    clusterStarts.push_back(numTriangles);
+    const uint32_t numClusters = static_cast<uint32_t>(clusterStarts.size() - 1);
+
+    // area weighted centroid and normal per cluster and of the whole mesh
+    std::vector<Vec3> clusterCentroids(numClusters, Vec3(0.0f));
+    std::vector<Vec3> clusterNormals(numClusters, Vec3(0.0f));
+    Vec3 meshCentroid{0.0f};
+    float meshArea = 0.0f;
+    for (uint32_t i = 0; i < numClusters; ++i)
+    {
+        float clusterArea = 0.0f;
+        for (uint32_t j = clusterStarts[i]; j < clusterStarts[i + 1]; ++j)
+        {
+            const Vec3 p0     = GetPosition(pVertices[pIndices[j * 3 + 0]]);
+            const Vec3 p1     = GetPosition(pVertices[pIndices[j * 3 + 1]]);
+            const Vec3 p2     = GetPosition(pVertices[pIndices[j * 3 + 2]]);
+            const Vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float area  = glm::length(normal);
+            clusterCentroids[i] += (p0 + p1 + p2) * (area / 3.0f);
+            clusterNormals[i] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += clusterCentroids[i];
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f)
+        {
+            clusterCentroids[i] /= clusterArea;
+        }
+    }
+    if (meshArea > 0.0f)
+    {
+        meshCentroid /= meshArea;
+    }
+
+    // clusters facing away from the center are likely to occlude the rest, draw them first
+    std::vector<float> sortKeys(numClusters, 0.0f);
+    for (uint32_t i = 0; i < numClusters; ++i)
+    {
+        const float normalLength = glm::length(clusterNormals[i]);
+        if (normalLength > 0.0f)
+        {
+            sortKeys[i] =
+                glm::dot(clusterCentroids[i] - meshCentroid, clusterNormals[i] / normalLength);
+        }
+    }
+    std::vector<uint32_t> clusterOrder(numClusters);
+    for (uint32_t i = 0; i < numClusters; ++i)
+    {
+        clusterOrder[i] = i;
+    }
+    std::stable_sort(
+        clusterOrder.begin(), clusterOrder.end(),
+        [&sortKeys](uint32_t lhs, uint32_t rhs) { return sortKeys[lhs] > sortKeys[rhs]; });
+
+    std::vector<uint32_t> sortedIndices;
+    sortedIndices.reserve(numTriangles * 3);
+    for (uint32_t cluster : clusterOrder)
+    {
+        sortedIndices.insert(sortedIndices.end(), pIndices + clusterStarts[cluster] * 3,
+                             pIndices + clusterStarts[cluster + 1] * 3);
+    }
+    std::copy(sortedIndices.begin(), sortedIndices.end(), pIndices);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(Vertex* pVertices, uint32_t* pIndices, uint32_t numIndices)
+{
+    if (numIndices == 0)
+    {
+        return;
+    }
+    uint32_t baseVertex  = 0;
+    uint32_t numVertices = 0;
+    CalcVertexRange(pIndices, numIndices, baseVertex, numVertices);
+
+    std::vector<uint32_t> remap(numVertices, cInvalidIndex);
+    uint32_t numRemapped = 0;
+    for (uint32_t i = 0; i < numIndices; ++i)
+    {
+        uint32_t& newVertex = remap[pIndices[i] - baseVertex];
+        if (newVertex == cInvalidIndex)
+        {
+            newVertex = numRemapped++;
+        }
+        pIndices[i] = newVertex + baseVertex;
+    }
+    for (uint32_t& newVertex : remap)
+    {
+        if (newVertex == cInvalidIndex)
+        {
+            newVertex = numRemapped++;
+        }
+    }
+
+    std::vector<Vertex> vertices(pVertices + baseVertex, pVertices + baseVertex + numVertices);
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        pVertices[baseVertex + remap[i]] = vertices[i];
+    }
+}
+
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const uint32_t* pIndices,
+                                                        uint32_t numIndices,
+                                                        uint32_t cacheSize)
+{
+    VertexCacheStatistics statistics{};
+    const uint32_t numTriangles = numIndices / 3;
+    if (numTriangles == 0)
+    {
+        return statistics;
+    }
+    uint32_t baseVertex  = 0;
+    uint32_t numVertices = 0;
+    CalcVertexRange(pIndices, numTriangles * 3, baseVertex, numVertices);
+
+    FifoCacheSimulator cache(baseVertex, numVertices, cacheSize);
+    std::vector<uint8_t> used(numVertices, 0);
+    uint32_t numUsedVertices = 0;
+    for (uint32_t i = 0; i < numTriangles; ++i)
+    {
+        statistics.numTransformedVertices += cache.AddTriangle(pIndices + i * 3);
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            uint8_t& vertexUsed = used[pIndices[i * 3 + j] - baseVertex];
+            numUsedVertices += vertexUsed == 0;
+            vertexUsed = 1;
+        }
+    }
+    statistics.acmr = static_cast<float>(statistics.numTransformedVertices) / numTriangles;
+    statistics.atvr = static_cast<float>(statistics.numTransformedVertices) / numUsedVertices;
+    return statistics;
+}
+} // namespace zen::asset
@@ -0,0 +1,242 @@
+#include "AssetLib/MeshletBuilder.h"
+#include <algorithm>
+#include <limits>
+
+namespace zen::asset
+{
+static constexpr uint8_t cInvalidLocalIndex = 0xFF;
+static constexpr uint32_t cInvalidTriangle  = std::numeric_limits<uint32_t>::max();
+// widens the normal cone a little so float error never culls a visible triangle
+static constexpr float cNormalConeTolerance = 1e-4f;
+
+static Vec3 GetPosition(const Vertex& vertex)
+{
+    return Vec3(vertex.pos.x, vertex.pos.y, vertex.pos.z);
+}
+
+static void CalcMeshletBounds(const Vertex* pVertices,
+                              const MeshletData& meshletData,
+                              Meshlet& meshlet)
+{
+    const uint32_t* pMeshletVertices = meshletData.vertices.data() + meshlet.vertexOffset;
+    const uint8_t* pMeshletTriangles = meshletData.triangles.data() + meshlet.triangleOffset * 3;
+
+    Vec3 min{std::numeric_limits<float>::max()};
+    Vec3 max{std::numeric_limits<float>::lowest()};
+    for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+    {
+        const Vec3 pos = GetPosition(pVertices[pMeshletVertices[i]]);
+        min            = glm::min(min, pos);
+        max            = glm::max(max, pos);
+    }
+    const Vec3 center = (min + max) * 0.5f;
+    float radius      = 0.0f;
+    for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+    {
+        const Vec3 pos = GetPosition(pVertices[pMeshletVertices[i]]);
+        radius         = std::max(radius, glm::distance(center, pos));
+    }
+    meshlet.boundingSphere = Vec4(center, radius);
+
+    Vec3 normals[MeshletBuilder::cMaxTriangles];
+    uint32_t numNormals = 0;
+    Vec3 axis{0.0f};
+    for (uint32_t i = 0; i < meshlet.triangleCount; ++i)
+    {
+        const Vec3 p0     = GetPosition(pVertices[pMeshletVertices[pMeshletTriangles[i * 3 + 0]]]);
+        const Vec3 p1     = GetPosition(pVertices[pMeshletVertices[pMeshletTriangles[i * 3 + 1]]]);
+        const Vec3 p2     = GetPosition(pVertices[pMeshletVertices[pMeshletTriangles[i * 3 + 2]]]);
+        const Vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        const float area  = glm::length(normal);
+        // degenerate triangles are invisible from any side
+        if (area > 0.0f)
+        {
+            normals[numNormals] = normal / area;
+            axis += normals[numNormals];
+            numNormals++;
+        }
+    }
+    meshlet.normalCone = Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    const float axisLength = glm::length(axis);
+    if (numNormals == 0 || axisLength < 1e-6f)
+    {
+        return;
+    }
+    axis /= axisLength;
+    float minDot = 1.0f;
+    for (uint32_t i = 0; i < numNormals; ++i)
+    {
+        minDot = std::min(minDot, glm::dot(normals[i], axis));
+    }
+    // normals spread over a hemisphere or more, some triangle faces every view
+    if (minDot <= 0.0f)
+    {
+        return;
+    }
+    const float cutoff =
+        std::min(std::sqrt(1.0f - minDot * minDot) + cNormalConeTolerance, 1.0f);
+    meshlet.normalCone = Vec4(axis, cutoff);
+}
+
+uint32_t MeshletBuilder::Build(const Vertex* pVertices,
+                               const uint32_t* pIndices,
+                               uint32_t numIndices,
+                               MeshletData& meshletData)
+{
+    const uint32_t numTriangles = numIndices / 3;
+    if (numTriangles == 0)
+    {
+        return 0;
+    }
+    const auto [pMinIndex, pMaxIndex] = std::minmax_element(pIndices, pIndices + numTriangles * 3);
+    const uint32_t baseVertex         = *pMinIndex;
+    const uint32_t numVertices        = *pMaxIndex - baseVertex + 1;
+
+    // vertex -> triangles adjacency, used to grow meshlets over shared vertices
+    std::vector<uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    for (uint32_t i = 0; i < numTriangles * 3; ++i)
+    {
+        adjacencyOffsets[pIndices[i] - baseVertex + 1]++;
+    }
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+    }
+    std::vector<uint32_t> adjacency(numTriangles * 3);
+    std::vector<uint32_t> adjacencyCursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint32_t i = 0; i < numTriangles * 3; ++i)
+    {
+        adjacency[adjacencyCursors[pIndices[i] - baseVertex]++] = i / 3;
+    }
+    // triangles not yet in a meshlet per vertex, lets the search skip exhausted vertices
+    std::vector<uint32_t> numLiveTriangles(numVertices);
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        numLiveTriangles[i] = adjacencyOffsets[i + 1] - adjacencyOffsets[i];
+    }
+
+    std::vector<uint8_t> emitted(numTriangles, 0);
+    std::vector<uint8_t> localIndices(numVertices, cInvalidLocalIndex);
+
+    const size_t firstMeshlet = meshletData.meshlets.size();
+    Meshlet meshlet{};
+    meshlet.vertexOffset   = static_cast<uint32_t>(meshletData.vertices.size());
+    meshlet.triangleOffset = static_cast<uint32_t>(meshletData.triangles.size() / 3);
+    Vec3 positionSum{0.0f};
+
+    auto CountNewVertices = [&](uint32_t triangle) {
+        return static_cast<uint32_t>(
+            (localIndices[pIndices[triangle * 3 + 0] - baseVertex] == cInvalidLocalIndex) +
+            (localIndices[pIndices[triangle * 3 + 1] - baseVertex] == cInvalidLocalIndex) +
+            (localIndices[pIndices[triangle * 3 + 2] - baseVertex] == cInvalidLocalIndex));
+    };
+    auto GetTriangleCenter = [&](uint32_t triangle) {
+        return (GetPosition(pVertices[pIndices[triangle * 3 + 0]]) +
+                GetPosition(pVertices[pIndices[triangle * 3 + 1]]) +
+                GetPosition(pVertices[pIndices[triangle * 3 + 2]])) /
+            3.0f;
+    };
+    auto FlushMeshlet = [&]() {
+        CalcMeshletBounds(pVertices, meshletData, meshlet);
+        meshletData.meshlets.push_back(meshlet);
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+        {
+            localIndices[meshletData.vertices[meshlet.vertexOffset + i] - baseVertex] =
+                cInvalidLocalIndex;
+        }
+        meshlet                = Meshlet{};
+        meshlet.vertexOffset   = static_cast<uint32_t>(meshletData.vertices.size());
+        meshlet.triangleOffset = static_cast<uint32_t>(meshletData.triangles.size() / 3);
+        positionSum            = Vec3(0.0f);
+    };
+
+    uint32_t scanCursor = 0;
+    for (uint32_t numEmitted = 0; numEmitted < numTriangles; ++numEmitted)
+    {
+        // prefer triangles adding the fewest new vertices, then the ones closest to the center
+        uint32_t bestTriangle = cInvalidTriangle;
+        if (meshlet.triangleCount > 0)
+        {
+            const Vec3 center           = positionSum / static_cast<float>(meshlet.vertexCount);
+            uint32_t bestNumNewVertices = 4;
+            float bestDistance          = std::numeric_limits<float>::max();
+            for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+            {
+                const uint32_t vertex = meshletData.vertices[meshlet.vertexOffset + i] - baseVertex;
+                if (numLiveTriangles[vertex] == 0)
+                {
+                    continue;
+                }
+                for (uint32_t j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1]; ++j)
+                {
+                    const uint32_t triangle = adjacency[j];
+                    if (emitted[triangle])
+                    {
+                        continue;
+                    }
+                    const uint32_t numNewVertices = CountNewVertices(triangle);
+                    if (meshlet.vertexCount + numNewVertices > cMaxVertices ||
+                        numNewVertices > bestNumNewVertices)
+                    {
+                        continue;
+                    }
+                    const Vec3 offset    = GetTriangleCenter(triangle) - center;
+                    const float distance = glm::dot(offset, offset);
+                    if (numNewVertices < bestNumNewVertices || distance < bestDistance)
+                    {
+                        bestTriangle       = triangle;
+                        bestNumNewVertices = numNewVertices;
+                        bestDistance       = distance;
+                    }
+                }
+            }
+        }
+        if (bestTriangle == cInvalidTriangle)
+        {
+            // nothing connected fits, continue in index order
+            while (emitted[scanCursor])
+            {
+                scanCursor++;
+            }
+            bestTriangle = scanCursor;
+            if (meshlet.vertexCount + CountNewVertices(bestTriangle) > cMaxVertices)
+            {
+                FlushMeshlet();
+            }
+        }
+
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            const uint32_t vertex = pIndices[bestTriangle * 3 + i] - baseVertex;
+            if (localIndices[vertex] == cInvalidLocalIndex)
+            {
+                localIndices[vertex] = static_cast<uint8_t>(meshlet.vertexCount++);
+                meshletData.vertices.push_back(vertex + baseVertex);
+                positionSum += GetPosition(pVertices[vertex + baseVertex]);
+            }
+            meshletData.triangles.push_back(localIndices[vertex]);
+            numLiveTriangles[vertex]--;
+        }
+        emitted[bestTriangle] = 1;
+        meshlet.triangleCount++;
+        if (meshlet.triangleCount == cMaxTriangles)
+        {
+            FlushMeshlet();
+        }
+    }
+    if (meshlet.triangleCount > 0)
+    {
+        FlushMeshlet();
+    }
+    return static_cast<uint32_t>(meshletData.meshlets.size() - firstMeshlet);
+}
+
+bool MeshletBuilder::IsBackFacing(const Meshlet& meshlet, const Vec3& cameraPos)
+{
+    const Vec3 center   = Vec3(meshlet.boundingSphere);
+    const Vec3 axis     = Vec3(meshlet.normalCone);
+    const Vec3 toCenter = center - cameraPos;
+    return glm::dot(toCenter, axis) >=
+        meshlet.normalCone.w * glm::length(toCenter) + meshlet.boundingSphere.w;
+}
+} // namespace zen::asset
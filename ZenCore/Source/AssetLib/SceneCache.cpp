@@ -0,0 +1,628 @@
+#include "AssetLib/SceneCache.h"
+#include "Platform/FileSystem.h"
+#include "SceneGraph/Scene.h"
+#include "Utils/Errors.h"
+#include "Utils/Helpers.h"
+#include <algorithm>
+#include <filesystem>
+#include <type_traits>
+
+namespace zen::asset
+{
+namespace
+{
+struct SceneCacheHeader
+{
+    uint32_t magic{SceneCache::cMagic};
+    uint32_t version{SceneCache::cVersion};
+    uint32_t vertexSize{sizeof(Vertex)};
+    uint32_t meshletSize{sizeof(Meshlet)};
+    uint64_t sourceHash{0};
+    uint64_t dependencyHash{0};
+    uint32_t loaderFlags{0};
+    uint32_t padding{0};
+    // size of the whole file, catches truncated files
+    uint64_t fileSize{0};
+};
+
+// arrays start at this alignment relative to the file start, mappings are page aligned
+constexpr size_t cArrayAlignment = 16;
+
+class CacheWriter
+{
+public:
+    template <class T> void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteString(const std::string& str)
+    {
+        Write(static_cast<uint32_t>(str.size()));
+        WriteBytes(str.data(), str.size());
+    }
+
+    template <class T> void WriteArray(const T* pData, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(static_cast<uint64_t>(count));
+        m_data.resize((m_data.size() + cArrayAlignment - 1) & ~(cArrayAlignment - 1), 0);
+        WriteBytes(pData, count * sizeof(T));
+    }
+
+    template <class T> void WriteArray(const std::vector<T>& values)
+    {
+        WriteArray(values.data(), values.size());
+    }
+
+    std::vector<uint8_t>& GetData()
+    {
+        return m_data;
+    }
+
+private:
+    void WriteBytes(const void* pData, size_t size)
+    {
+        const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+        m_data.insert(m_data.end(), pBytes, pBytes + size);
+    }
+
+    std::vector<uint8_t> m_data;
+};
+
+// bounds checked, the first out of range read fails every following read
+class CacheReader
+{
+public:
+    CacheReader(const uint8_t* pData, size_t size) : m_pData(pData), m_size(size) {}
+
+    template <class T> T Read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        if (Reserve(sizeof(T)))
+        {
+            std::memcpy(&value, m_pData + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+        }
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        const uint32_t size = Read<uint32_t>();
+        if (!Reserve(size))
+        {
+            return {};
+        }
+        std::string str(reinterpret_cast<const char*>(m_pData + m_offset), size);
+        m_offset += size;
+        return str;
+    }
+
+    template <class T> void ReadArray(std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const uint64_t count = Read<uint64_t>();
+        Skip(((m_offset + cArrayAlignment - 1) & ~(cArrayAlignment - 1)) - m_offset);
+        if (count > GetRemainingSize() / sizeof(T))
+        {
+            m_valid = false;
+            return;
+        }
+        values.resize(count);
+        if (count > 0)
+        {
+            std::memcpy(values.data(), m_pData + m_offset, count * sizeof(T));
+            m_offset += count * sizeof(T);
+        }
+    }
+
+    // element counts of sections, every element takes at least one byte
+    uint32_t ReadCount()
+    {
+        const uint32_t count = Read<uint32_t>();
+        if (count > GetRemainingSize())
+        {
+            m_valid = false;
+            return 0;
+        }
+        return count;
+    }
+
+    bool IsValid() const
+    {
+        return m_valid;
+    }
+
+    bool IsAtEnd() const
+    {
+        return m_valid && m_offset == m_size;
+    }
+
+    void Fail()
+    {
+        m_valid = false;
+    }
+
+private:
+    bool Reserve(size_t size)
+    {
+        if (!m_valid || size > m_size - m_offset)
+        {
+            m_valid = false;
+        }
+        return m_valid;
+    }
+
+    void Skip(size_t size)
+    {
+        if (Reserve(size))
+        {
+            m_offset += size;
+        }
+    }
+
+    size_t GetRemainingSize() const
+    {
+        return m_valid ? m_size - m_offset : 0;
+    }
+
+    const uint8_t* m_pData{nullptr};
+    size_t m_size{0};
+    size_t m_offset{0};
+    bool m_valid{true};
+};
+
+void WriteAABB(CacheWriter& writer, const sg::AABB& aabb)
+{
+    writer.Write(aabb.GetMin());
+    writer.Write(aabb.GetMax());
+}
+
+sg::AABB ReadAABB(CacheReader& reader)
+{
+    const Vec3 min = reader.Read<Vec3>();
+    const Vec3 max = reader.Read<Vec3>();
+    return sg::AABB(min, max);
+}
+} // namespace
+
+std::string SceneCache::GetCachePath(const std::string& cacheDir, const std::string& sourcePath)
+{
+    // the stem alone collides for the many scene.gltf files out there
+    const std::string sourceId =
+        std::filesystem::absolute(sourcePath).lexically_normal().generic_string();
+    const uint64_t pathHash = util::HashBytes64(sourceId.data(), sourceId.size());
+    const std::string fileName =
+        fmt::format("{}_{:016x}{}", std::filesystem::path(sourcePath).stem().string(), pathHash,
+                    cExtension);
+    return (std::filesystem::path(cacheDir) / fileName).string();
+}
+
+bool SceneCache::CalcKey(const std::string& sourcePath,
+                         const std::string& cacheDir,
+                         uint32_t loaderFlags,
+                         SceneCacheKey& key)
+{
+    platform::MappedFile sourceFile;
+    if (!sourceFile.Open(sourcePath))
+    {
+        return false;
+    }
+    key.sourceHash  = util::HashBytes64(sourceFile.GetData(), sourceFile.GetSize());
+    key.loaderFlags = loaderFlags;
+
+    // buffers and images are referenced relative to the source, stamp everything next to it
+    // except cooked files
+    namespace fs                 = std::filesystem;
+    const fs::path sourceDir     = fs::absolute(sourcePath).parent_path();
+    const fs::path sourceFileAbs = fs::absolute(sourcePath).lexically_normal();
+    const fs::path cacheDirAbs   = fs::absolute(cacheDir).lexically_normal();
+    struct Dependency
+    {
+        std::string path;
+        uint64_t size;
+        int64_t writeTime;
+    };
+    std::vector<Dependency> dependencies;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(sourceDir, fs::directory_options::skip_permission_denied,
+                                        ec);
+    for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+    {
+        // failing queries of single entries must not end the walk
+        std::error_code entryEc;
+        const fs::path path = it->path().lexically_normal();
+        if (it->is_directory(entryEc) && path == cacheDirAbs)
+        {
+            it.disable_recursion_pending();
+            continue;
+        }
+        if (!it->is_regular_file(entryEc) || path == sourceFileAbs ||
+            path.extension() == cExtension)
+        {
+            continue;
+        }
+        Dependency dependency{};
+        dependency.path      = path.lexically_relative(sourceDir).generic_string();
+        dependency.size      = it->file_size(entryEc);
+        dependency.writeTime = it->last_write_time(entryEc).time_since_epoch().count();
+        dependencies.push_back(std::move(dependency));
+    }
+    std::sort(dependencies.begin(), dependencies.end(),
+              [](const Dependency& lhs, const Dependency& rhs) { return lhs.path < rhs.path; });
+    uint64_t hash = 0;
+    for (const Dependency& dependency : dependencies)
+    {
+        hash = util::HashBytes64(dependency.path.data(), dependency.path.size(), hash);
+        hash = util::HashBytes64(&dependency.size, sizeof(dependency.size), hash);
+        hash = util::HashBytes64(&dependency.writeTime, sizeof(dependency.writeTime), hash);
+    }
+    key.dependencyHash = hash;
+    return true;
+}
+
+bool SceneCache::Write(const std::string& cachePath,
+                       const SceneCacheKey& key,
+                       const sg::Scene& scene,
+                       const std::vector<SceneCacheNode>& nodes,
+                       const std::vector<Vertex>& vertices,
+                       const std::vector<uint32_t>& indices,
+                       const MeshletData& meshletData)
+{
+    const auto samplers  = scene.GetComponents<sg::Sampler>();
+    const auto textures  = scene.GetComponents<sg::Texture>();
+    const auto materials = scene.GetComponents<sg::Material>();
+    const auto meshes    = scene.GetComponents<sg::Mesh>();
+    // the loader appends 5 default textures and a default material, both are recreated on read
+    if (textures.size() < 5 || materials.empty())
+    {
+        return false;
+    }
+
+    CacheWriter writer;
+    SceneCacheHeader header{};
+    header.sourceHash     = key.sourceHash;
+    header.dependencyHash = key.dependencyHash;
+    header.loaderFlags    = key.loaderFlags;
+    writer.Write(header);
+
+    writer.WriteArray(vertices);
+    writer.WriteArray(indices);
+    writer.WriteArray(meshletData.meshlets);
+    writer.WriteArray(meshletData.vertices);
+    writer.WriteArray(meshletData.triangles);
+
+    writer.Write(static_cast<uint32_t>(samplers.size()));
+    for (const sg::Sampler* pSampler : samplers)
+    {
+        writer.WriteString(pSampler->GetName());
+        writer.Write(pSampler->minFilter);
+        writer.Write(pSampler->magFilter);
+        writer.Write(pSampler->wrapS);
+        writer.Write(pSampler->wrapT);
+    }
+
+    const uint32_t numTextures = static_cast<uint32_t>(textures.size() - 5);
+    HashMap<const sg::Texture*, int32_t> texturePositions;
+    for (uint32_t i = 0; i < textures.size(); ++i)
+    {
+        texturePositions[textures[i]] = static_cast<int32_t>(i);
+    }
+    writer.Write(numTextures);
+    for (uint32_t i = 0; i < numTextures; ++i)
+    {
+        const sg::Texture* pTexture = textures[i];
+        writer.WriteString(pTexture->GetName());
+        writer.Write(pTexture->index);
+        writer.Write(pTexture->samplerIndex);
+        writer.Write(pTexture->width);
+        writer.Write(pTexture->height);
+        writer.Write(pTexture->format);
+        writer.Write(pTexture->mipLevels);
+        writer.WriteArray(pTexture->bytesData);
+    }
+
+    auto WriteTextureRef = [&](const sg::Texture* pTexture) {
+        auto it = texturePositions.find(pTexture);
+        writer.Write(it != texturePositions.end() ? it->second : -1);
+    };
+    writer.Write(static_cast<uint32_t>(materials.size() - 1));
+    for (size_t i = 0; i + 1 < materials.size(); ++i)
+    {
+        const sg::Material* pMaterial = materials[i];
+        writer.WriteString(pMaterial->GetName());
+        writer.Write(pMaterial->index);
+        writer.Write(pMaterial->alphaMode);
+        writer.Write(pMaterial->doubleSided);
+        writer.Write(pMaterial->alphaCutoff);
+        writer.Write(pMaterial->metallicFactor);
+        writer.Write(pMaterial->roughnessFactor);
+        writer.Write(pMaterial->baseColorFactor);
+        writer.Write(pMaterial->emissiveFactor);
+        writer.Write(pMaterial->emissiveStrength);
+        writer.Write(pMaterial->texCoordSets);
+        WriteTextureRef(pMaterial->m_pBaseColorTexture);
+        WriteTextureRef(pMaterial->m_pMetallicRoughnessTexture);
+        WriteTextureRef(pMaterial->m_pNormalTexture);
+        WriteTextureRef(pMaterial->m_pOcclusionTexture);
+        WriteTextureRef(pMaterial->m_pEmissiveTexture);
+    }
+
+    writer.Write(static_cast<uint32_t>(meshes.size()));
+    for (const sg::Mesh* pMesh : meshes)
+    {
+        writer.WriteString(pMesh->GetName());
+        WriteAABB(writer, pMesh->GetAABB());
+        writer.Write(static_cast<uint32_t>(pMesh->GetSubMeshes().size()));
+        for (const sg::SubMesh* pSubMesh : pMesh->GetSubMeshes())
+        {
+            writer.WriteString(pSubMesh->GetName());
+            writer.Write(pSubMesh->GetFirstIndex());
+            writer.Write(pSubMesh->GetIndexCount());
+            writer.Write(pSubMesh->GetVertexCount());
+            writer.Write(pSubMesh->GetMaterialIndex());
+            WriteAABB(writer, pSubMesh->GetAABB());
+            writer.Write(pSubMesh->GetFirstMeshlet());
+            writer.Write(pSubMesh->GetMeshletCount());
+        }
+    }
+
+    writer.Write(static_cast<uint32_t>(nodes.size()));
+    for (const SceneCacheNode& node : nodes)
+    {
+        writer.WriteString(node.name);
+        writer.Write(node.index);
+        writer.Write(node.parentIndex);
+        writer.Write(node.meshIndex);
+        writer.Write(node.translation);
+        writer.Write(node.rotation);
+        writer.Write(node.scale);
+    }
+
+    std::vector<uint8_t>& data = writer.GetData();
+    header.fileSize            = data.size();
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    // keeps the cooked extension so that the dependency stamp skips it as well
+    std::filesystem::path tempPath = cachePath;
+    tempPath.replace_extension(std::string(".cooking") + cExtension);
+    return platform::FileSystem::WriteBinaryFileAtomic(cachePath, data.data(), data.size(),
+                                                       tempPath.string());
+}
+
+bool SceneCache::Read(const std::string& cachePath,
+                      const SceneCacheKey& key,
+                      sg::Scene* pScene,
+                      std::vector<Vertex>& vertices,
+                      std::vector<uint32_t>& indices,
+                      MeshletData& meshletData)
+{
+    platform::MappedFile file;
+    if (!file.Open(cachePath))
+    {
+        return false;
+    }
+    CacheReader reader(file.GetData(), file.GetSize());
+    const SceneCacheHeader header = reader.Read<SceneCacheHeader>();
+    if (!reader.IsValid() || header.magic != cMagic || header.version != cVersion ||
+        header.vertexSize != sizeof(Vertex) || header.meshletSize != sizeof(Meshlet) ||
+        header.sourceHash != key.sourceHash || header.dependencyHash != key.dependencyHash ||
+        header.loaderFlags != key.loaderFlags || header.fileSize != file.GetSize())
+    {
+        return false;
+    }
+
+    // everything is rebuilt off to the side and handed to the scene once the whole file checks out
+    std::vector<Vertex> cachedVertices;
+    std::vector<uint32_t> cachedIndices;
+    MeshletData cachedMeshletData;
+    reader.ReadArray(cachedVertices);
+    reader.ReadArray(cachedIndices);
+    reader.ReadArray(cachedMeshletData.meshlets);
+    reader.ReadArray(cachedMeshletData.vertices);
+    reader.ReadArray(cachedMeshletData.triangles);
+
+    std::vector<UniquePtr<sg::Sampler>> samplers(reader.ReadCount());
+    for (auto& sampler : samplers)
+    {
+        sampler            = MakeUnique<sg::Sampler>(reader.ReadString());
+        sampler->minFilter = reader.Read<sg::TextureFilter>();
+        sampler->magFilter = reader.Read<sg::TextureFilter>();
+        sampler->wrapS     = reader.Read<sg::SamplerAddressMode>();
+        sampler->wrapT     = reader.Read<sg::SamplerAddressMode>();
+    }
+
+    const uint32_t numTextures = reader.ReadCount();
+    std::vector<UniquePtr<sg::Texture>> textures(numTextures);
+    for (auto& texture : textures)
+    {
+        texture               = MakeUnique<sg::Texture>(reader.ReadString());
+        texture->index        = reader.Read<uint32_t>();
+        texture->samplerIndex = reader.Read<int>();
+        texture->width        = reader.Read<uint32_t>();
+        texture->height       = reader.Read<uint32_t>();
+        texture->format       = reader.Read<Format>();
+        texture->mipLevels    = reader.Read<uint32_t>();
+        reader.ReadArray(texture->bytesData);
+    }
+    if (!reader.IsValid())
+    {
+        return false;
+    }
+    sg::Scene::LoadDefaultTextures(numTextures);
+    sg::Scene::DefaultTextures defaultTextures = sg::Scene::GetDefaultTextures();
+    textures.emplace_back(defaultTextures.pBaseColor);
+    textures.emplace_back(defaultTextures.pMetallicRoughness);
+    textures.emplace_back(defaultTextures.pNormal);
+    textures.emplace_back(defaultTextures.pEmissive);
+    textures.emplace_back(defaultTextures.pOcclusion);
+
+    auto ReadTextureRef = [&]() -> sg::Texture* {
+        const int32_t position = reader.Read<int32_t>();
+        if (position < 0 || position >= static_cast<int32_t>(textures.size()))
+        {
+            reader.Fail();
+            return nullptr;
+        }
+        return textures[position].Get();
+    };
+    std::vector<UniquePtr<sg::Material>> materials(reader.ReadCount());
+    for (auto& material : materials)
+    {
+        material                   = MakeUnique<sg::Material>(reader.ReadString());
+        material->index            = reader.Read<uint32_t>();
+        material->alphaMode        = reader.Read<sg::AlphaMode>();
+        material->doubleSided      = reader.Read<bool>();
+        material->alphaCutoff      = reader.Read<float>();
+        material->metallicFactor   = reader.Read<float>();
+        material->roughnessFactor  = reader.Read<float>();
+        material->baseColorFactor  = reader.Read<Vec4>();
+        material->emissiveFactor   = reader.Read<Vec4>();
+        material->emissiveStrength = reader.Read<float>();
+        material->texCoordSets     = reader.Read<sg::Material::TexCoordSets>();
+        material->m_pBaseColorTexture         = ReadTextureRef();
+        material->m_pMetallicRoughnessTexture = ReadTextureRef();
+        material->m_pNormalTexture            = ReadTextureRef();
+        material->m_pOcclusionTexture         = ReadTextureRef();
+        material->m_pEmissiveTexture          = ReadTextureRef();
+        if (!reader.IsValid())
+        {
+            return false;
+        }
+        material->SetData();
+    }
+    UniquePtr<sg::Material> defaultMaterial      = sg::Material::CreateDefaultUnique();
+    defaultMaterial->m_pBaseColorTexture         = defaultTextures.pBaseColor;
+    defaultMaterial->m_pMetallicRoughnessTexture = defaultTextures.pMetallicRoughness;
+    defaultMaterial->m_pNormalTexture            = defaultTextures.pNormal;
+    defaultMaterial->m_pOcclusionTexture         = defaultTextures.pOcclusion;
+    defaultMaterial->m_pEmissiveTexture          = defaultTextures.pEmissive;
+    materials.emplace_back(defaultMaterial);
+
+    std::vector<UniquePtr<sg::SubMesh>> subMeshes;
+    std::vector<UniquePtr<sg::Mesh>> meshes(reader.ReadCount());
+    for (auto& mesh : meshes)
+    {
+        mesh                 = MakeUnique<sg::Mesh>(reader.ReadString());
+        const sg::AABB aabb  = ReadAABB(reader);
+        const uint32_t count = reader.ReadCount();
+        for (uint32_t i = 0; i < count && reader.IsValid(); ++i)
+        {
+            std::string name             = reader.ReadString();
+            const uint32_t firstIndex    = reader.Read<uint32_t>();
+            const uint32_t indexCount    = reader.Read<uint32_t>();
+            const uint32_t vertexCount   = reader.Read<uint32_t>();
+            const uint32_t materialIndex = reader.Read<uint32_t>();
+            const sg::AABB subMeshAABB   = ReadAABB(reader);
+            const uint32_t firstMeshlet  = reader.Read<uint32_t>();
+            const uint32_t meshletCount  = reader.Read<uint32_t>();
+            if (materialIndex >= materials.size() ||
+                uint64_t(firstIndex) + indexCount > cachedIndices.size() ||
+                uint64_t(firstMeshlet) + meshletCount > cachedMeshletData.meshlets.size())
+            {
+                return false;
+            }
+            auto subMesh = MakeUnique<sg::SubMesh>(std::move(name), firstIndex, indexCount,
+                                                   vertexCount);
+            subMesh->SetMaterial(materialIndex, materials[materialIndex].Get());
+            subMesh->SetAABB(subMeshAABB.GetMin(), subMeshAABB.GetMax());
+            subMesh->SetMeshletRange(firstMeshlet, meshletCount);
+            mesh->AddSubMesh(subMesh.Get());
+            subMeshes.push_back(std::move(subMesh));
+        }
+        mesh->SetAABB(aabb.GetMin(), aabb.GetMax());
+    }
+
+    std::vector<SceneCacheNode> cacheNodes(reader.ReadCount());
+    for (SceneCacheNode& cacheNode : cacheNodes)
+    {
+        cacheNode.name        = reader.ReadString();
+        cacheNode.index       = reader.Read<uint32_t>();
+        cacheNode.parentIndex = reader.Read<int32_t>();
+        cacheNode.meshIndex   = reader.Read<int32_t>();
+        cacheNode.translation = reader.Read<Vec3>();
+        cacheNode.rotation    = reader.Read<Quat>();
+        cacheNode.scale       = reader.Read<Vec3>();
+    }
+    if (!reader.IsAtEnd())
+    {
+        return false;
+    }
+
+    // nodes were recorded children first, create all of them before linking parents
+    std::vector<UniquePtr<sg::Node>> nodes(cacheNodes.size());
+    HashMap<uint32_t, sg::Node*> nodeMap;
+    for (size_t i = 0; i < cacheNodes.size(); ++i)
+    {
+        nodes[i] = MakeUnique<sg::Node>(cacheNodes[i].index, cacheNodes[i].name);
+        if (!nodeMap.insert({cacheNodes[i].index, nodes[i].Get()}).second ||
+            cacheNodes[i].meshIndex >= static_cast<int32_t>(meshes.size()))
+        {
+            return false;
+        }
+    }
+    std::vector<sg::Node*> parents(cacheNodes.size(), nullptr);
+    for (size_t i = 0; i < cacheNodes.size(); ++i)
+    {
+        if (cacheNodes[i].parentIndex >= 0)
+        {
+            auto it = nodeMap.find(static_cast<uint32_t>(cacheNodes[i].parentIndex));
+            if (it == nodeMap.end())
+            {
+                return false;
+            }
+            parents[i] = it->second;
+        }
+        nodes[i]->SetParent(parents[i]);
+    }
+
+    // same order of operations as the loader, parent transforms are attached after their
+    // children computed their world matrices
+    std::vector<UniquePtr<sg::Transform>> transforms;
+    std::vector<sg::Node*> renderableNodes;
+    for (size_t i = 0; i < cacheNodes.size(); ++i)
+    {
+        const SceneCacheNode& cacheNode = cacheNodes[i];
+        sg::Node* pNode                 = nodes[i].Get();
+        if (cacheNode.meshIndex >= 0)
+        {
+            auto transform = MakeUnique<sg::Transform>(*pNode);
+            transform->SetTranslation(cacheNode.translation);
+            transform->SetRotation(cacheNode.rotation);
+            transform->SetScale(cacheNode.scale);
+            pNode->AddComponent(transform.Get());
+
+            sg::Mesh* pMesh = meshes[cacheNode.meshIndex].Get();
+            pNode->AddComponent(pMesh);
+            pNode->SetData(static_cast<uint32_t>(renderableNodes.size()),
+                           pNode->GetComponent<sg::Transform>()->GetWorldMatrix());
+            pMesh->AddNode(pNode);
+            renderableNodes.push_back(pNode);
+            transforms.push_back(std::move(transform));
+        }
+        if (parents[i] != nullptr)
+        {
+            parents[i]->AddChild(pNode);
+        }
+    }
+
+    vertices                = std::move(cachedVertices);
+    indices                 = std::move(cachedIndices);
+    meshletData             = std::move(cachedMeshletData);
+    pScene->SetComponents(std::move(samplers));
+    pScene->SetComponents(std::move(textures));
+    pScene->SetComponents(std::move(materials));
+    pScene->SetComponents(std::move(subMeshes));
+    pScene->SetComponents(std::move(meshes));
+    pScene->SetComponents(std::move(transforms));
+    for (sg::Node* pNode : renderableNodes)
+    {
+        pScene->AddRenderableNode(pNode);
+    }
+    pScene->SetNodes(std::move(nodes));
+    return true;
+}
+} // namespace zen::asset
@@ -1,9 +1,27 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include "AssetLib/TextureLoader.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 
 namespace zen::asset
 {
+static float SrgbToLinear(float value)
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float LinearToSrgb(float value)
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+static uint8_t ToUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
 TextureInfo TextureLoader::LoadTexture2DFromFile(const std::string& filename)
 {
     // TODO: support more texture formats (e.g.dds) & configurable texture components
@@ -46,4 +64,68 @@ void TextureLoader::LoadTexture2DFromFile(const std::string& filename, TextureIn
     pOutTexInfo->data   = std::move(vecData);
     pOutTexInfo->format = Format::R8G8B8A8_UNORM;
 }
-} // namespace zen::asset
\ No newline at end of file
+
+uint32_t TextureLoader::GenerateMipmaps(uint32_t width,
+                                        uint32_t height,
+                                        bool srgb,
+                                        std::vector<uint8_t>& data)
+{
+    static const auto cSrgbToLinear = []() {
+        std::array<float, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            table[i] = SrgbToLinear(i / 255.0f);
+        }
+        return table;
+    }();
+
+    if (width == 0 || height == 0)
+    {
+        return 1;
+    }
+    const uint32_t numLevels =
+        static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    size_t srcOffset = 0;
+    for (uint32_t level = 1; level < numLevels; ++level)
+    {
+        const uint32_t dstWidth  = std::max(width >> 1, 1u);
+        const uint32_t dstHeight = std::max(height >> 1, 1u);
+        const size_t dstOffset   = data.size();
+        data.resize(dstOffset + static_cast<size_t>(dstWidth) * dstHeight * 4);
+        const uint8_t* pSrc = data.data() + srcOffset;
+        uint8_t* pDst       = data.data() + dstOffset;
+        // 2x2 box filter, a side of 1 repeats its texel
+        for (uint32_t y = 0; y < dstHeight; ++y)
+        {
+            const uint32_t y0 = std::min(y * 2, height - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, height - 1);
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t x0         = std::min(x * 2, width - 1);
+                const uint32_t x1         = std::min(x * 2 + 1, width - 1);
+                const uint8_t* pTexels[4] = {
+                    pSrc + (static_cast<size_t>(y0) * width + x0) * 4,
+                    pSrc + (static_cast<size_t>(y0) * width + x1) * 4,
+                    pSrc + (static_cast<size_t>(y1) * width + x0) * 4,
+                    pSrc + (static_cast<size_t>(y1) * width + x1) * 4,
+                };
+                uint8_t* pTexel = pDst + (static_cast<size_t>(y) * dstWidth + x) * 4;
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    float sum = 0.0f;
+                    for (const uint8_t* pSrcTexel : pTexels)
+                    {
+                        // alpha is linear in srgb formats as well
+                        sum += srgb && c < 3 ? cSrgbToLinear[pSrcTexel[c]] : pSrcTexel[c] / 255.0f;
+                    }
+                    pTexel[c] = ToUnorm8(srgb && c < 3 ? LinearToSrgb(sum * 0.25f) : sum * 0.25f);
+                }
+            }
+        }
+        srcOffset = dstOffset;
+        width     = dstWidth;
+        height    = dstHeight;
+    }
+    return numLevels;
+}
+} // namespace zen::asset
@@ -0,0 +1,207 @@
+#include "AssetLib/VertexQuantization.h"
+#include <cstring>
+#include <limits>
+
+namespace zen::asset
+{
+static uint16_t QuantizeUnorm16(float value)
+{
+    return static_cast<uint16_t>(std::round(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+static int16_t QuantizeSnorm16(float value)
+{
+    return static_cast<int16_t>(std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+static uint8_t QuantizeUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::round(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+static float DequantizeSnorm16(int16_t value)
+{
+    // -32768 and -32767 both map to -1, matches unpackSnorm2x16 in the shaders
+    return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+}
+
+static void EncodeDirection(const Vec3& direction, int16_t* pOut)
+{
+    const Vec2 encoded = OctEncode(direction);
+    pOut[0]            = QuantizeSnorm16(encoded.x);
+    pOut[1]            = QuantizeSnorm16(encoded.y);
+}
+
+static Vec3 DecodeDirection(const int16_t* pEncoded)
+{
+    return OctDecode(Vec2(DequantizeSnorm16(pEncoded[0]), DequantizeSnorm16(pEncoded[1])));
+}
+
+VertexQuantizationBounds CalcVertexQuantizationBounds(const Vertex* pVertices,
+                                                      uint32_t numVertices)
+{
+    VertexQuantizationBounds bounds;
+    if (numVertices == 0)
+    {
+        return bounds;
+    }
+    Vec3 min{std::numeric_limits<float>::max()};
+    Vec3 max{std::numeric_limits<float>::lowest()};
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        const Vec3 pos(pVertices[i].pos.x, pVertices[i].pos.y, pVertices[i].pos.z);
+        min = glm::min(min, pos);
+        max = glm::max(max, pos);
+    }
+    bounds.offset = Vec4(min, 0.0f);
+    bounds.scale  = Vec4((max - min) / 65535.0f, 0.0f);
+    return bounds;
+}
+
+PackedVertex PackVertex(const Vertex& vertex, const VertexQuantizationBounds& bounds)
+{
+    PackedVertex packedVertex{};
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        // flat axes have a zero scale, every vertex sits on the offset
+        packedVertex.pos[i] = bounds.scale[i] > 0.0f ?
+            QuantizeUnorm16((vertex.pos[i] - bounds.offset[i]) / (bounds.scale[i] * 65535.0f)) :
+            0;
+    }
+    packedVertex.pos[3] = QuantizeUnorm16(vertex.tangent.w * 0.5f + 0.5f);
+
+    EncodeDirection(Vec3(vertex.normal), packedVertex.normal);
+    EncodeDirection(Vec3(vertex.tangent), packedVertex.tangent);
+
+    packedVertex.uv0[0] = FloatToHalf(vertex.uv0.x);
+    packedVertex.uv0[1] = FloatToHalf(vertex.uv0.y);
+    packedVertex.uv1[0] = FloatToHalf(vertex.uv1.x);
+    packedVertex.uv1[1] = FloatToHalf(vertex.uv1.y);
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        packedVertex.color[i] = QuantizeUnorm8(vertex.color[i]);
+    }
+    return packedVertex;
+}
+
+Vertex UnpackVertex(const PackedVertex& packedVertex, const VertexQuantizationBounds& bounds)
+{
+    Vertex vertex{};
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        vertex.pos[i] =
+            bounds.offset[i] + static_cast<float>(packedVertex.pos[i]) * bounds.scale[i];
+    }
+    vertex.pos.w = 1.0f;
+
+    vertex.normal           = Vec4(DecodeDirection(packedVertex.normal), 0.0f);
+    const float tangentSign = static_cast<float>(packedVertex.pos[3]) / 65535.0f * 2.0f - 1.0f;
+    vertex.tangent          = Vec4(DecodeDirection(packedVertex.tangent), tangentSign);
+
+    vertex.uv0 = Vec2(HalfToFloat(packedVertex.uv0[0]), HalfToFloat(packedVertex.uv0[1]));
+    vertex.uv1 = Vec2(HalfToFloat(packedVertex.uv1[0]), HalfToFloat(packedVertex.uv1[1]));
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        vertex.color[i] = static_cast<float>(packedVertex.color[i]) / 255.0f;
+    }
+    return vertex;
+}
+
+VertexQuantizationBounds PackVertices(const Vertex* pVertices,
+                                      uint32_t numVertices,
+                                      PackedVertex* pPackedVertices)
+{
+    const VertexQuantizationBounds bounds = CalcVertexQuantizationBounds(pVertices, numVertices);
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        pPackedVertices[i] = PackVertex(pVertices[i], bounds);
+    }
+    return bounds;
+}
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t half;
+    if (bits >= 0x47800000u)
+    {
+        // too large for a half (>= 65536), inf or nan
+        half = bits > 0x7F800000u ? 0x7E00 : 0x7C00;
+    }
+    else if (bits < 0x38800000u)
+    {
+        // subnormal half or zero, adding 0.5 aligns the mantissa so the fpu does the rounding
+        float aligned;
+        std::memcpy(&aligned, &bits, sizeof(aligned));
+        aligned += 0.5f;
+        std::memcpy(&half, &aligned, sizeof(half));
+        half -= 0x3F000000u;
+    }
+    else
+    {
+        // rebias the exponent and round the mantissa to nearest even
+        const uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + mantissaOdd;
+        half = bits >> 13;
+    }
+    return static_cast<uint16_t>((sign >> 16) | half);
+}
+
+float HalfToFloat(uint16_t value)
+{
+    const uint32_t sign     = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        const float result = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -result : result;
+    }
+    if (exponent == 31)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+Vec2 OctEncode(const Vec3& direction)
+{
+    const float l1Norm = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    // also catches nan, the loaders normalize missing normals
+    if (!(l1Norm > 0.0f))
+    {
+        return Vec2(0.0f);
+    }
+    const Vec3 p = direction / l1Norm;
+    if (p.z >= 0.0f)
+    {
+        return Vec2(p.x, p.y);
+    }
+    // fold the lower hemisphere over the diagonals
+    return Vec2((1.0f - std::abs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - std::abs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+}
+
+Vec3 OctDecode(const Vec2& encoded)
+{
+    Vec3 direction(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+    const float t = std::max(-direction.z, 0.0f);
+    direction.x += direction.x >= 0.0f ? -t : t;
+    direction.y += direction.y >= 0.0f ? -t : t;
+    return glm::normalize(direction);
+}
+} // namespace zen::asset
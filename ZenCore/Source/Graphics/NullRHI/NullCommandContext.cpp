@@ -0,0 +1,657 @@
+#include "Graphics/NullRHI/NullCommandContext.h"
+#include "Graphics/NullRHI/NullRHI.h"
+#include "Graphics/NullRHI/NullResources.h"
+
+namespace zen
+{
+static const char* ContextTypeName(RHICommandContextType contextType)
+{
+    switch (contextType)
+    {
+        case RHICommandContextType::eGraphics: return "graphics";
+        case RHICommandContextType::eAsyncCompute: return "async compute";
+        case RHICommandContextType::eTransfer: return "transfer";
+        default: break;
+    }
+    return "unknown";
+}
+
+uint32_t NullCommandContext::GetNumRecords(NullCommandType type) const
+{
+    uint32_t count = 0;
+    for (const NullCommandRecord& record : m_records)
+    {
+        count += record.type == type ? 1 : 0;
+    }
+    return count;
+}
+
+void NullCommandContext::TakeRecords(HeapVector<NullCommandRecord>& outRecords,
+                                     NullResourceUsages* pOutUsages)
+{
+    if (m_insideRendering)
+    {
+        ReportError("the command list ends inside BeginRendering/EndRendering");
+    }
+    for (NullCommandRecord& record : m_records)
+    {
+        outRecords.emplace_back(std::move(record));
+    }
+    m_records.clear();
+    if (pOutUsages != nullptr)
+    {
+        pOutUsages->buffers.swap(m_usages.buffers);
+        pOutUsages->textures.swap(m_usages.textures);
+    }
+    m_usages.buffers.clear();
+    m_usages.textures.clear();
+    m_insideRendering = false;
+    m_pBoundPipeline  = nullptr;
+}
+
+void NullCommandContext::Record(NullCommandType type, std::string text)
+{
+    NullCommandRecord record;
+    record.type        = type;
+    record.contextType = m_contextType;
+    record.text        = std::move(text);
+    m_records.emplace_back(std::move(record));
+}
+
+void NullCommandContext::ReportError(const std::string& message)
+{
+    m_pRHI->ReportError(std::string(ContextTypeName(m_contextType)) + " context: " + message);
+}
+
+// destroyed resources must not be dereferenced, not even for their tag
+std::string NullCommandContext::Name(const RHIResource* pResource) const
+{
+    if (pResource == nullptr)
+    {
+        return "null";
+    }
+    if (!m_pRHI->IsResourceAlive(pResource))
+    {
+        return "destroyed";
+    }
+    return pResource->GetResourceTag();
+}
+
+bool NullCommandContext::ValidateBuffer(const RHIBuffer* pBuffer, const char* pCommand)
+{
+    if (pBuffer == nullptr || !m_pRHI->IsResourceAlive(pBuffer))
+    {
+        ReportError(std::string(pCommand) + " uses a " + Name(pBuffer) + " buffer");
+        return false;
+    }
+    if (!static_cast<const NullBuffer*>(pBuffer)->HasMemory())
+    {
+        ReportError(std::string(pCommand) + " uses transient buffer " +
+                    pBuffer->GetResourceTag() + " before its memory is bound");
+        return false;
+    }
+    return true;
+}
+
+bool NullCommandContext::ValidateTexture(const RHITexture* pTexture, const char* pCommand)
+{
+    if (pTexture == nullptr || !m_pRHI->IsResourceAlive(pTexture))
+    {
+        ReportError(std::string(pCommand) + " uses a " + Name(pTexture) + " texture");
+        return false;
+    }
+    if (!static_cast<const NullTexture*>(pTexture)->HasMemory())
+    {
+        ReportError(std::string(pCommand) + " uses transient texture " +
+                    pTexture->GetResourceTag() + " before its memory is bound");
+        return false;
+    }
+    return true;
+}
+
+void NullCommandContext::ValidateOutsideRendering(const char* pCommand)
+{
+    if (m_insideRendering)
+    {
+        ReportError(std::string(pCommand) + " inside BeginRendering/EndRendering");
+    }
+}
+
+void NullCommandContext::ValidateDraw(const char* pCommand)
+{
+    if (m_contextType != RHICommandContextType::eGraphics)
+    {
+        ReportError(std::string(pCommand) + " outside the graphics queue");
+    }
+    if (!m_insideRendering)
+    {
+        ReportError(std::string(pCommand) + " outside BeginRendering/EndRendering");
+    }
+    if (m_pBoundPipeline == nullptr || !m_pRHI->IsResourceAlive(m_pBoundPipeline) ||
+        m_pBoundPipeline->GetPipelineType() != RHIPipelineType::eGraphics)
+    {
+        ReportError(std::string(pCommand) + " without a graphics pipeline bound");
+    }
+}
+
+void NullCommandContext::ValidateDispatch(const char* pCommand)
+{
+    if (m_contextType == RHICommandContextType::eTransfer)
+    {
+        ReportError(std::string(pCommand) + " on the transfer queue");
+    }
+    ValidateOutsideRendering(pCommand);
+    if (m_pBoundPipeline == nullptr || !m_pRHI->IsResourceAlive(m_pBoundPipeline) ||
+        m_pBoundPipeline->GetPipelineType() != RHIPipelineType::eCompute)
+    {
+        ReportError(std::string(pCommand) + " without a compute pipeline bound");
+    }
+}
+
+RHIBufferUsage NullCommandContext::GetTrackedUsage(NullBuffer* pBuffer,
+                                                   RHIBufferUsage expectedUsage)
+{
+    auto iter = m_usages.buffers.find(pBuffer);
+    if (iter == m_usages.buffers.end())
+    {
+        m_usages.buffers[pBuffer] = {expectedUsage, expectedUsage};
+        return expectedUsage;
+    }
+    return iter->second.finalUsage;
+}
+
+RHITextureUsage NullCommandContext::GetTrackedUsage(NullTexture* pTexture,
+                                                    RHITextureUsage expectedUsage)
+{
+    auto iter = m_usages.textures.find(pTexture);
+    if (iter == m_usages.textures.end())
+    {
+        m_usages.textures[pTexture] = {expectedUsage, expectedUsage};
+        return expectedUsage;
+    }
+    return iter->second.finalUsage;
+}
+
+void NullCommandContext::SetTrackedUsage(NullBuffer* pBuffer, RHIBufferUsage usage)
+{
+    auto iter = m_usages.buffers.find(pBuffer);
+    if (iter == m_usages.buffers.end())
+    {
+        m_usages.buffers[pBuffer] = {RHIBufferUsage::eMax, usage};
+        return;
+    }
+    iter->second.finalUsage = usage;
+}
+
+void NullCommandContext::SetTrackedUsage(NullTexture* pTexture, RHITextureUsage usage)
+{
+    auto iter = m_usages.textures.find(pTexture);
+    if (iter == m_usages.textures.end())
+    {
+        m_usages.textures[pTexture] = {RHITextureUsage::eMax, usage};
+        return;
+    }
+    iter->second.finalUsage = usage;
+}
+
+// the usage a transition starts from must match the last one recorded for the resource. Only
+// whole resource transitions are tracked, after a partial one the usage is unknown again. The
+// first transition of a resource in a list is checked against the resource when the list is
+// submitted
+void NullCommandContext::ApplyBufferTransitions(VectorView<RHIBufferTransition> bufferTransitions)
+{
+    for (const RHIBufferTransition& transition : bufferTransitions)
+    {
+        if (!ValidateBuffer(transition.pBuffer, "AddTransitions"))
+        {
+            continue;
+        }
+        NullBuffer* pBuffer    = static_cast<NullBuffer*>(transition.pBuffer);
+        const bool wholeBuffer = transition.offset == 0 &&
+            (transition.size == ZEN_BUFFER_WHOLE_SIZE ||
+             transition.size >= pBuffer->GetRequiredSize());
+        if (wholeBuffer && transition.oldUsage != RHIBufferUsage::eNone)
+        {
+            const RHIBufferUsage trackedUsage = GetTrackedUsage(pBuffer, transition.oldUsage);
+            if (trackedUsage != RHIBufferUsage::eMax && transition.oldUsage != trackedUsage)
+            {
+                ReportError("AddTransitions: buffer " + pBuffer->GetResourceTag() +
+                            " is transitioned from usage " +
+                            std::to_string(ToUnderlying(transition.oldUsage)) +
+                            " but is in usage " + std::to_string(ToUnderlying(trackedUsage)));
+            }
+        }
+        SetTrackedUsage(pBuffer, wholeBuffer ? transition.newUsage : RHIBufferUsage::eMax);
+    }
+}
+
+void NullCommandContext::ApplyTextureTransitions(
+    VectorView<RHITextureTransition> textureTransitions)
+{
+    for (const RHITextureTransition& transition : textureTransitions)
+    {
+        if (!ValidateTexture(transition.pTexture, "AddTransitions"))
+        {
+            continue;
+        }
+        NullTexture* pTexture   = static_cast<NullTexture*>(transition.pTexture);
+        const bool wholeTexture = pTexture->CoversWholeTexture(transition.subResourceRange);
+        if (wholeTexture && transition.oldUsage != RHITextureUsage::eNone)
+        {
+            const RHITextureUsage trackedUsage = GetTrackedUsage(pTexture, transition.oldUsage);
+            if (trackedUsage != RHITextureUsage::eMax && transition.oldUsage != trackedUsage)
+            {
+                ReportError("AddTransitions: texture " + pTexture->GetResourceTag() +
+                            " is transitioned from usage " +
+                            std::to_string(ToUnderlying(transition.oldUsage)) +
+                            " but is in usage " + std::to_string(ToUnderlying(trackedUsage)));
+            }
+        }
+        SetTrackedUsage(pTexture, wholeTexture ? transition.newUsage : RHITextureUsage::eMax);
+    }
+}
+
+void NullCommandContext::RHIBeginRendering(const RHIRenderingLayout* pRenderingLayout)
+{
+    if (m_insideRendering)
+    {
+        ReportError("BeginRendering inside BeginRendering/EndRendering");
+    }
+    if (m_contextType != RHICommandContextType::eGraphics)
+    {
+        ReportError("BeginRendering outside the graphics queue");
+    }
+    m_insideRendering = true;
+
+    std::string text = "BeginRendering";
+    for (uint32_t i = 0; i < pRenderingLayout->numColorRenderTargets; i++)
+    {
+        RHITexture* pTexture = pRenderingLayout->colorRenderTargets[i].pTexture;
+        text += " " + Name(pTexture);
+        if (ValidateTexture(pTexture, "BeginRendering"))
+        {
+            RHITextureUsage usage = GetTrackedUsage(static_cast<NullTexture*>(pTexture),
+                                                    RHITextureUsage::eColorAttachment);
+            if (usage != RHITextureUsage::eMax && usage != RHITextureUsage::eColorAttachment)
+            {
+                ReportError("BeginRendering: " + pTexture->GetResourceTag() +
+                            " is not in the color attachment usage");
+            }
+        }
+    }
+    if (pRenderingLayout->hasDepthStencilRT)
+    {
+        RHITexture* pTexture = pRenderingLayout->depthStencilRenderTarget.pTexture;
+        text += " depth " + Name(pTexture);
+        if (ValidateTexture(pTexture, "BeginRendering"))
+        {
+            RHITextureUsage usage = GetTrackedUsage(static_cast<NullTexture*>(pTexture),
+                                                    RHITextureUsage::eDepthStencilAttachment);
+            if (usage != RHITextureUsage::eMax &&
+                usage != RHITextureUsage::eDepthStencilAttachment)
+            {
+                ReportError("BeginRendering: " + pTexture->GetResourceTag() +
+                            " is not in the depth stencil attachment usage");
+            }
+        }
+    }
+    Record(NullCommandType::eBeginRendering, std::move(text));
+}
+
+void NullCommandContext::RHIEndRendering()
+{
+    if (!m_insideRendering)
+    {
+        ReportError("EndRendering without BeginRendering");
+    }
+    m_insideRendering = false;
+    Record(NullCommandType::eEndRendering, "EndRendering");
+}
+
+void NullCommandContext::RHISetScissor(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY)
+{
+    Record(NullCommandType::eSetScissor,
+           "SetScissor " + std::to_string(minX) + " " + std::to_string(minY) + " " +
+               std::to_string(maxX) + " " + std::to_string(maxY));
+}
+
+void NullCommandContext::RHISetViewport(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY)
+{
+    Record(NullCommandType::eSetViewport,
+           "SetViewport " + std::to_string(minX) + " " + std::to_string(minY) + " " +
+               std::to_string(maxX) + " " + std::to_string(maxY));
+}
+
+void NullCommandContext::RHISetDepthBias(float depthBiasConstantFactor,
+                                         float depthBiasClamp,
+                                         float depthBiasSlopeFactor)
+{
+    Record(NullCommandType::eSetDepthBias,
+           "SetDepthBias " + std::to_string(depthBiasConstantFactor) + " " +
+               std::to_string(depthBiasClamp) + " " + std::to_string(depthBiasSlopeFactor));
+}
+
+void NullCommandContext::RHISetLineWidth(float lineWidth)
+{
+    Record(NullCommandType::eSetLineWidth, "SetLineWidth " + std::to_string(lineWidth));
+}
+
+void NullCommandContext::RHISetBlendConstants(const Color& blendConstants)
+{
+    Record(NullCommandType::eSetBlendConstants, "SetBlendConstants");
+}
+
+void NullCommandContext::RHIBindPipeline(RHIPipeline* pPipeline,
+                                         uint32_t numDescriptorSets,
+                                         RHIDescriptorSet* const* pDescriptorSets)
+{
+    if (pPipeline == nullptr || !m_pRHI->IsResourceAlive(pPipeline))
+    {
+        ReportError("BindPipeline binds a " + Name(pPipeline) + " pipeline");
+        m_pBoundPipeline = nullptr;
+    }
+    else
+    {
+        m_pBoundPipeline = static_cast<const NullPipeline*>(pPipeline);
+    }
+    for (uint32_t i = 0; i < numDescriptorSets; i++)
+    {
+        if (pDescriptorSets[i] == nullptr || !m_pRHI->IsResourceAlive(pDescriptorSets[i]))
+        {
+            ReportError("BindPipeline binds a " + Name(pDescriptorSets[i]) + " descriptor set " +
+                        std::to_string(i));
+        }
+    }
+    Record(NullCommandType::eBindPipeline,
+           "BindPipeline " + Name(pPipeline) + " " + std::to_string(numDescriptorSets));
+}
+
+void NullCommandContext::RHIBindVertexBuffers(VectorView<RHIBuffer*> pBuffers,
+                                              VectorView<uint64_t> offsets)
+{
+    if (pBuffers.size() != offsets.size())
+    {
+        ReportError("BindVertexBuffers with " + std::to_string(pBuffers.size()) +
+                    " buffers but " + std::to_string(offsets.size()) + " offsets");
+    }
+    std::string text = "BindVertexBuffers";
+    for (RHIBuffer* pBuffer : pBuffers)
+    {
+        ValidateBuffer(pBuffer, "BindVertexBuffers");
+        text += " " + Name(pBuffer);
+    }
+    Record(NullCommandType::eBindVertexBuffers, std::move(text));
+}
+
+void NullCommandContext::RHIBindVertexBuffer(RHIBuffer* pBuffer, uint64_t offset)
+{
+    ValidateBuffer(pBuffer, "BindVertexBuffer");
+    Record(NullCommandType::eBindVertexBuffers, "BindVertexBuffers " + Name(pBuffer));
+}
+
+void NullCommandContext::RHIDraw(uint32_t vertexCount,
+                                 uint32_t instanceCount,
+                                 uint32_t firstVertex,
+                                 uint32_t firstInstance)
+{
+    ValidateDraw("Draw");
+    Record(NullCommandType::eDraw,
+           "Draw " + std::to_string(vertexCount) + " " + std::to_string(instanceCount));
+}
+
+void NullCommandContext::RHIDrawIndexed(RHIBuffer* pIndexBuffer,
+                                        DataFormat indexFormat,
+                                        uint32_t indexBufferOffset,
+                                        uint32_t indexCount,
+                                        uint32_t instanceCount,
+                                        uint32_t firstIndex,
+                                        int32_t vertexOffset,
+                                        uint32_t firstInstance)
+{
+    ValidateDraw("DrawIndexed");
+    ValidateBuffer(pIndexBuffer, "DrawIndexed");
+    Record(NullCommandType::eDrawIndexed,
+           "DrawIndexed " + Name(pIndexBuffer) + " " + std::to_string(indexCount) + " " +
+               std::to_string(instanceCount));
+}
+
+void NullCommandContext::RHIDrawIndexedIndirect(RHIBuffer* pIndirectBuffer,
+                                                RHIBuffer* pIndexBuffer,
+                                                DataFormat indexFormat,
+                                                uint32_t indexBufferOffset,
+                                                uint32_t offset,
+                                                uint32_t drawCount,
+                                                uint32_t stride)
+{
+    ValidateDraw("DrawIndexedIndirect");
+    ValidateBuffer(pIndirectBuffer, "DrawIndexedIndirect");
+    ValidateBuffer(pIndexBuffer, "DrawIndexedIndirect");
+    Record(NullCommandType::eDrawIndexedIndirect,
+           "DrawIndexedIndirect " + Name(pIndirectBuffer) + " " + std::to_string(drawCount));
+}
+
+void NullCommandContext::RHIDrawIndexedIndirectCount(RHIBuffer* pIndirectBuffer,
+                                                     RHIBuffer* pIndexBuffer,
+                                                     DataFormat indexFormat,
+                                                     uint32_t indexBufferOffset,
+                                                     uint32_t offset,
+                                                     RHIBuffer* pCountBuffer,
+                                                     uint32_t countBufferOffset,
+                                                     uint32_t maxDrawCount,
+                                                     uint32_t stride)
+{
+    ValidateDraw("DrawIndexedIndirectCount");
+    if (!m_pRHI->QueryGPUInfo().supportDrawIndirectCount)
+    {
+        ReportError("DrawIndexedIndirectCount is not supported");
+    }
+    ValidateBuffer(pIndirectBuffer, "DrawIndexedIndirectCount");
+    ValidateBuffer(pIndexBuffer, "DrawIndexedIndirectCount");
+    ValidateBuffer(pCountBuffer, "DrawIndexedIndirectCount");
+    Record(NullCommandType::eDrawIndexedIndirectCount,
+           "DrawIndexedIndirectCount " + Name(pIndirectBuffer) + " " + Name(pCountBuffer) + " " +
+               std::to_string(maxDrawCount));
+}
+
+void NullCommandContext::RHIDispatch(uint32_t groupCountX,
+                                     uint32_t groupCountY,
+                                     uint32_t groupCountZ)
+{
+    ValidateDispatch("Dispatch");
+    Record(NullCommandType::eDispatch,
+           "Dispatch " + std::to_string(groupCountX) + " " + std::to_string(groupCountY) + " " +
+               std::to_string(groupCountZ));
+}
+
+void NullCommandContext::RHIDispatchIndirect(RHIBuffer* pIndirectBuffer, uint32_t offset)
+{
+    ValidateDispatch("DispatchIndirect");
+    ValidateBuffer(pIndirectBuffer, "DispatchIndirect");
+    Record(NullCommandType::eDispatchIndirect,
+           "DispatchIndirect " + Name(pIndirectBuffer) + " " + std::to_string(offset));
+}
+
+void NullCommandContext::RHISetPushConstants(RHIPipeline* pPipeline, VectorView<uint8_t> data)
+{
+    if (pPipeline == nullptr || !m_pRHI->IsResourceAlive(pPipeline))
+    {
+        ReportError("SetPushConstants for a " + Name(pPipeline) + " pipeline");
+    }
+    Record(NullCommandType::eSetPushConstants,
+           "SetPushConstants " + Name(pPipeline) + " " + std::to_string(data.size()));
+}
+
+void NullCommandContext::RHIAddTransitions(BitField<RHIPipelineStageBits> srcStages,
+                                           BitField<RHIPipelineStageBits> dstStages,
+                                           VectorView<RHIMemoryTransition> memoryTransitions,
+                                           VectorView<RHIBufferTransition> bufferTransitions,
+                                           VectorView<RHITextureTransition> textureTransitions)
+{
+    ValidateOutsideRendering("AddTransitions");
+    ApplyBufferTransitions(bufferTransitions);
+    ApplyTextureTransitions(textureTransitions);
+
+    std::string text = "Transitions " + std::to_string(memoryTransitions.size());
+    for (const RHIBufferTransition& transition : bufferTransitions)
+    {
+        text += " " + Name(transition.pBuffer) + ":" +
+            std::to_string(ToUnderlying(transition.oldUsage)) + "->" +
+            std::to_string(ToUnderlying(transition.newUsage));
+    }
+    for (const RHITextureTransition& transition : textureTransitions)
+    {
+        text += " " + Name(transition.pTexture) + ":" +
+            std::to_string(ToUnderlying(transition.oldUsage)) + "->" +
+            std::to_string(ToUnderlying(transition.newUsage));
+    }
+    Record(NullCommandType::eTransitions, std::move(text));
+}
+
+void NullCommandContext::RHISetBarrierEvent(RHIBarrierEvent* pEvent,
+                                            BitField<RHIPipelineStageBits> srcStages,
+                                            BitField<RHIPipelineStageBits> dstStages,
+                                            VectorView<RHIBufferTransition> bufferTransitions,
+                                            VectorView<RHITextureTransition> textureTransitions)
+{
+    ValidateOutsideRendering("SetBarrierEvent");
+    if (pEvent->handle != 0)
+    {
+        ReportError("SetBarrierEvent sets an event that is not waited on yet");
+    }
+    pEvent->handle = m_pRHI->AllocBarrierEventHandle();
+    ApplyBufferTransitions(bufferTransitions);
+    ApplyTextureTransitions(textureTransitions);
+    Record(NullCommandType::eSetBarrierEvent,
+           "SetBarrierEvent " + std::to_string(pEvent->handle) + " " +
+               std::to_string(bufferTransitions.size()) + " " +
+               std::to_string(textureTransitions.size()));
+}
+
+void NullCommandContext::RHIWaitBarrierEvent(RHIBarrierEvent* pEvent)
+{
+    ValidateOutsideRendering("WaitBarrierEvent");
+    if (pEvent->handle == 0)
+    {
+        ReportError("WaitBarrierEvent waits on an event that is not set");
+    }
+    Record(NullCommandType::eWaitBarrierEvent,
+           "WaitBarrierEvent " + std::to_string(pEvent->handle));
+    pEvent->handle = 0;
+}
+
+void NullCommandContext::RHIGenTextureMipmaps(RHITexture* pTexture)
+{
+    ValidateOutsideRendering("GenTextureMipmaps");
+    if (m_contextType != RHICommandContextType::eGraphics)
+    {
+        ReportError("GenTextureMipmaps outside the graphics queue");
+    }
+    if (ValidateTexture(pTexture, "GenTextureMipmaps"))
+    {
+        // the mips end up in different layouts
+        SetTrackedUsage(static_cast<NullTexture*>(pTexture), RHITextureUsage::eMax);
+    }
+    Record(NullCommandType::eGenTextureMipmaps, "GenTextureMipmaps " + Name(pTexture));
+}
+
+void NullCommandContext::RHIAddTextureTransition(RHITexture* pTexture, RHITextureLayout newLayout)
+{
+    ValidateOutsideRendering("AddTextureTransition");
+    if (ValidateTexture(pTexture, "AddTextureTransition"))
+    {
+        // layouts do not map back to a single usage
+        SetTrackedUsage(static_cast<NullTexture*>(pTexture), RHITextureUsage::eMax);
+    }
+    Record(NullCommandType::eTextureLayoutTransition,
+           "AddTextureTransition " + Name(pTexture) + " " +
+               std::to_string(ToUnderlying(newLayout)));
+}
+
+void NullCommandContext::RHIClearBuffer(RHIBuffer* pBuffer, uint32_t offset, uint32_t size)
+{
+    ValidateOutsideRendering("ClearBuffer");
+    ValidateBuffer(pBuffer, "ClearBuffer");
+    Record(NullCommandType::eClearBuffer, "ClearBuffer " + Name(pBuffer) + " " +
+                                              std::to_string(offset) + " " +
+                                              std::to_string(size));
+}
+
+void NullCommandContext::RHICopyBuffer(RHIBuffer* pSrcBuffer,
+                                       RHIBuffer* pDstBuffer,
+                                       const RHIBufferCopyRegion& region)
+{
+    ValidateOutsideRendering("CopyBuffer");
+    if (ValidateBuffer(pSrcBuffer, "CopyBuffer") && ValidateBuffer(pDstBuffer, "CopyBuffer") &&
+        (region.srcOffset + region.size > pSrcBuffer->GetRequiredSize() ||
+         region.dstOffset + region.size > pDstBuffer->GetRequiredSize()))
+    {
+        ReportError("CopyBuffer from " + pSrcBuffer->GetResourceTag() + " to " +
+                    pDstBuffer->GetResourceTag() + " is out of range");
+    }
+    Record(NullCommandType::eCopyBuffer, "CopyBuffer " + Name(pSrcBuffer) + " " +
+                                             Name(pDstBuffer) + " " +
+                                             std::to_string(region.size));
+}
+
+void NullCommandContext::RHIClearTexture(RHITexture* pTex,
+                                         const Color& color,
+                                         const RHITextureSubResourceRange& range)
+{
+    ValidateOutsideRendering("ClearTexture");
+    ValidateTexture(pTex, "ClearTexture");
+    Record(NullCommandType::eClearTexture, "ClearTexture " + Name(pTex));
+}
+
+void NullCommandContext::RHICopyTexture(RHITexture* pSrcTexture,
+                                        RHITexture* pDstTexture,
+                                        VectorView<RHITextureCopyRegion> regions)
+{
+    ValidateOutsideRendering("CopyTexture");
+    ValidateTexture(pSrcTexture, "CopyTexture");
+    ValidateTexture(pDstTexture, "CopyTexture");
+    Record(NullCommandType::eCopyTexture, "CopyTexture " + Name(pSrcTexture) + " " +
+                                              Name(pDstTexture) + " " +
+                                              std::to_string(regions.size()));
+}
+
+void NullCommandContext::RHICopyTextureToBuffer(RHITexture* pSrcTex,
+                                                RHIBuffer* pDstBuffer,
+                                                VectorView<RHIBufferTextureCopyRegion> regions)
+{
+    ValidateOutsideRendering("CopyTextureToBuffer");
+    ValidateTexture(pSrcTex, "CopyTextureToBuffer");
+    ValidateBuffer(pDstBuffer, "CopyTextureToBuffer");
+    Record(NullCommandType::eCopyTextureToBuffer,
+           "CopyTextureToBuffer " + Name(pSrcTex) + " " + Name(pDstBuffer) + " " +
+               std::to_string(regions.size()));
+}
+
+void NullCommandContext::RHICopyBufferToTexture(RHIBuffer* pSrcBuffer,
+                                                RHITexture* pDstTexture,
+                                                VectorView<RHIBufferTextureCopyRegion> regions)
+{
+    ValidateOutsideRendering("CopyBufferToTexture");
+    ValidateBuffer(pSrcBuffer, "CopyBufferToTexture");
+    ValidateTexture(pDstTexture, "CopyBufferToTexture");
+    Record(NullCommandType::eCopyBufferToTexture,
+           "CopyBufferToTexture " + Name(pSrcBuffer) + " " + Name(pDstTexture) + " " +
+               std::to_string(regions.size()));
+}
+
+void NullCommandContext::RHIResolveTexture(RHITexture* pSrcTexture,
+                                           RHITexture* pDstTexture,
+                                           uint32_t srcLayer,
+                                           uint32_t srcMipmap,
+                                           uint32_t dstLayer,
+                                           uint32_t dstMipmap)
+{
+    ValidateOutsideRendering("ResolveTexture");
+    ValidateTexture(pSrcTexture, "ResolveTexture");
+    ValidateTexture(pDstTexture, "ResolveTexture");
+    Record(NullCommandType::eResolveTexture,
+           "ResolveTexture " + Name(pSrcTexture) + " " + Name(pDstTexture));
+}
+
+// lists are replayed synchronously, there is nothing to wait for
+void NullCommandContext::RHIWaitUntilCompleted() {}
+} // namespace zen
@@ -0,0 +1,381 @@
+#include "Graphics/NullRHI/NullRHI.h"
+#include "Graphics/NullRHI/NullResources.h"
+#include "Graphics/RHI/RHIOptions.h"
+#include "Graphics/RHI/RHIShaderReflectionCache.h"
+
+namespace zen
+{
+NullRHI* GNullRHI = nullptr;
+
+NullRHI::NullRHI()
+{
+    GNullRHI = this;
+
+    m_gpuInfo.supportGeometryShader    = true;
+    m_gpuInfo.supportDrawIndirectCount = true;
+    m_gpuInfo.uniformBufferAlignment   = 256;
+    m_gpuInfo.storageBufferAlignment   = 256;
+}
+
+void NullRHI::Init()
+{
+    m_pResourceFactory = ZEN_NEW() NullResourceFactory();
+
+    m_pShaderReflectionCache = ZEN_NEW() RHIShaderReflectionCache();
+    m_pShaderReflectionCache->Load(RHIOptions::GetInstance().ShaderReflectionCachePath());
+}
+
+void NullRHI::Destroy()
+{
+    if (m_pTransferContext != nullptr)
+    {
+        ZEN_DELETE(m_pTransferContext);
+        m_pTransferContext = nullptr;
+    }
+
+    ZEN_DELETE(m_pResourceFactory);
+
+    m_pShaderReflectionCache->Save();
+    ZEN_DELETE(m_pShaderReflectionCache);
+
+    if (!m_liveResources.empty())
+    {
+        LOGW("NullRHI destroyed with {} live resources", m_liveResources.size());
+    }
+}
+
+IRHICommandContext* NullRHI::GetCommandContext(RHICommandContextType contextType)
+{
+    return ZEN_NEW() NullCommandContext(contextType, this);
+}
+
+IRHICommandContext* NullRHI::GetTransferCommandContext()
+{
+    if (m_pTransferContext == nullptr)
+    {
+        m_pTransferContext = ZEN_NEW() NullCommandContext(RHICommandContextType::eTransfer, this);
+    }
+    return m_pTransferContext;
+}
+
+RHIViewport* NullRHI::CreateViewport(void* pWindow,
+                                     uint32_t width,
+                                     uint32_t height,
+                                     bool enableVSync)
+{
+    return NullViewport::CreateObject(pWindow, width, height, enableVSync);
+}
+
+void NullRHI::DestroyViewport(RHIViewport* pViewport)
+{
+    pViewport->ReleaseReference();
+}
+
+void NullRHI::BeginDrawingViewport(RHIViewport* pViewport)
+{
+    m_pCurrentViewport = pViewport;
+}
+
+void NullRHI::EndDrawingViewport(RHIViewport* pViewport,
+                                 LegacyRHICommandListContext* pCmdListContext,
+                                 bool present)
+{
+    ReportError("EndDrawingViewport: the legacy command list path is not supported");
+}
+
+void NullRHI::EndDrawingViewport(RHIViewport* pViewportRHI, RHICommandList* pCmdList, bool present)
+{
+    if (pViewportRHI != m_pCurrentViewport)
+    {
+        ReportError("EndDrawingViewport: the viewport is not being drawn");
+    }
+    pCmdList->Execute();
+    pCmdList->Reset();
+
+    HeapVector<NullCommandRecord> records;
+    NullResourceUsages usages;
+    static_cast<NullCommandContext*>(pCmdList->GetContext())->TakeRecords(records, &usages);
+    ApplyResourceUsages(usages);
+    if (present)
+    {
+        NullCommandRecord presentRecord;
+        presentRecord.type = NullCommandType::ePresent;
+        presentRecord.text = "Present " + pViewportRHI->GetColorBackBuffer()->GetResourceTag();
+        records.emplace_back(std::move(presentRecord));
+    }
+    SubmitRecords(records);
+}
+
+RHIShader* NullRHI::CreateShader(const RHIShaderCreateInfo& createInfo)
+{
+    return m_pResourceFactory->CreateShader(createInfo);
+}
+
+void NullRHI::DestroyShader(RHIShader* pShader)
+{
+    pShader->ReleaseReference();
+}
+
+RHIPipeline* NullRHI::CreatePipeline(const RHIComputePipelineCreateInfo& createInfo)
+{
+    return m_pResourceFactory->CreatePipeline(createInfo);
+}
+
+RHIPipeline* NullRHI::CreatePipeline(const RHIGfxPipelineCreateInfo& createInfo)
+{
+    return m_pResourceFactory->CreatePipeline(createInfo);
+}
+
+void NullRHI::DestroyPipeline(RHIPipeline* pPipeline)
+{
+    pPipeline->ReleaseReference();
+}
+
+RHISampler* NullRHI::CreateSampler(const RHISamplerCreateInfo& createInfo)
+{
+    return m_pResourceFactory->CreateSampler(createInfo);
+}
+
+void NullRHI::DestroySampler(RHISampler* pSampler)
+{
+    pSampler->ReleaseReference();
+}
+
+RHITexture* NullRHI::CreateTexture(const RHITextureCreateInfo& createInfo)
+{
+    return m_pResourceFactory->CreateTexture(createInfo);
+}
+
+RHITexture* NullRHI::CreateTextureProxy(const RHITexture* pBaseTexture,
+                                        const RHITextureProxyCreateInfo& proxyInfo)
+{
+    return NullTexture::CreateProxyObject(static_cast<const NullTexture*>(pBaseTexture),
+                                          proxyInfo);
+}
+
+void NullRHI::DestroyTexture(RHITexture* pTexture)
+{
+    pTexture->ReleaseReference();
+}
+
+RHIBuffer* NullRHI::CreateBuffer(const RHIBufferCreateInfo& createInfo)
+{
+    return m_pResourceFactory->CreateBuffer(createInfo);
+}
+
+void NullRHI::DestroyBuffer(RHIBuffer* pBuffer)
+{
+    pBuffer->ReleaseReference();
+}
+
+RHIMemoryBlock* NullRHI::CreateMemoryBlock(const RHIMemoryRequirements& requirements)
+{
+    return NullMemoryBlock::CreateObject(requirements);
+}
+
+void NullRHI::DestroyMemoryBlock(RHIMemoryBlock* pMemoryBlock)
+{
+    pMemoryBlock->ReleaseReference();
+}
+
+void NullRHI::BindTextureMemory(RHITexture* pTexture, RHIMemoryBlock* pMemoryBlock, uint64_t offset)
+{
+    static_cast<NullTexture*>(pTexture)->BindMemory(static_cast<NullMemoryBlock*>(pMemoryBlock),
+                                                    offset);
+}
+
+void NullRHI::BindBufferMemory(RHIBuffer* pBuffer, RHIMemoryBlock* pMemoryBlock, uint64_t offset)
+{
+    static_cast<NullBuffer*>(pBuffer)->BindMemory(static_cast<NullMemoryBlock*>(pMemoryBlock),
+                                                  offset);
+}
+
+void NullRHI::DestroyDescriptorSet(RHIDescriptorSet* pDescriptorSet)
+{
+    pDescriptorSet->ReleaseReference();
+}
+
+RHIPlatformCommandList* NullRHI::FinalizeCommandList(RHICommandList* pCmdList)
+{
+    pCmdList->Execute();
+
+    auto* pContext = static_cast<NullCommandContext*>(pCmdList->GetContext());
+    if (pContext->GetRecords().empty())
+    {
+        return nullptr;
+    }
+    NullPlatformCommandList* pPlatformCmdList = ZEN_NEW() NullPlatformCommandList();
+    pContext->TakeRecords(pPlatformCmdList->records, &pPlatformCmdList->usages);
+    return pPlatformCmdList;
+}
+
+void NullRHI::FinalizeCommandLists(VectorView<RHICommandList*> cmdLists,
+                                   HeapVector<RHIPlatformCommandList*>& outCommandLists)
+{
+    for (RHICommandList* pCmdList : cmdLists)
+    {
+        RHIPlatformCommandList* pPlatformCmdList = FinalizeCommandList(pCmdList);
+        if (pPlatformCmdList != nullptr)
+        {
+            outCommandLists.push_back(pPlatformCmdList);
+        }
+    }
+}
+
+void NullRHI::SubmitPlatformCommandLists(VectorView<RHIPlatformCommandList*> commandLists)
+{
+    for (RHIPlatformCommandList* pCommandList : commandLists)
+    {
+        auto* pPlatformCmdList = static_cast<NullPlatformCommandList*>(pCommandList);
+        ApplyResourceUsages(pPlatformCmdList->usages);
+        SubmitRecords(pPlatformCmdList->records);
+        ZEN_DELETE(pPlatformCmdList);
+    }
+}
+
+// resources destroyed since the list was finalized are already reported by the list's records
+void NullRHI::ApplyResourceUsages(const NullResourceUsages& usages)
+{
+    for (const auto& kv : usages.buffers)
+    {
+        if (!IsResourceAlive(kv.first))
+        {
+            continue;
+        }
+        const RHIBufferUsage usage = kv.first->GetTrackedUsage();
+        if (usage != RHIBufferUsage::eMax && kv.second.expectedUsage != RHIBufferUsage::eMax &&
+            kv.second.expectedUsage != usage)
+        {
+            ReportError("submit: buffer " + kv.first->GetResourceTag() + " is expected in usage " +
+                        std::to_string(ToUnderlying(kv.second.expectedUsage)) +
+                        " but is in usage " + std::to_string(ToUnderlying(usage)));
+        }
+        kv.first->SetTrackedUsage(kv.second.finalUsage);
+    }
+    for (const auto& kv : usages.textures)
+    {
+        if (!IsResourceAlive(kv.first))
+        {
+            continue;
+        }
+        const RHITextureUsage usage = kv.first->GetTrackedUsage();
+        if (usage != RHITextureUsage::eMax && kv.second.expectedUsage != RHITextureUsage::eMax &&
+            kv.second.expectedUsage != usage)
+        {
+            ReportError("submit: texture " + kv.first->GetResourceTag() + " is expected in usage " +
+                        std::to_string(ToUnderlying(kv.second.expectedUsage)) +
+                        " but is in usage " + std::to_string(ToUnderlying(usage)));
+        }
+        kv.first->SetTrackedUsage(kv.second.finalUsage);
+    }
+}
+
+void NullRHI::SubmitRecords(HeapVector<NullCommandRecord>& records)
+{
+    for (NullCommandRecord& record : records)
+    {
+        m_submittedRecords.emplace_back(std::move(record));
+    }
+    records.clear();
+}
+
+uint32_t NullRHI::GetNumSubmittedRecords(NullCommandType type) const
+{
+    uint32_t count = 0;
+    for (const NullCommandRecord& record : m_submittedRecords)
+    {
+        count += record.type == type ? 1 : 0;
+    }
+    return count;
+}
+
+HeapVector<std::string> NullRHI::GetValidationErrors() const
+{
+    LockAuto lock(&m_errorMutex);
+    HeapVector<std::string> errors;
+    for (const std::string& error : m_validationErrors)
+    {
+        errors.push_back(error);
+    }
+    return errors;
+}
+
+void NullRHI::ClearValidationErrors()
+{
+    LockAuto lock(&m_errorMutex);
+    m_validationErrors.clear();
+}
+
+void NullRHI::ReportError(const std::string& message)
+{
+    LOGE("NullRHI: {}", message);
+    LockAuto lock(&m_errorMutex);
+    m_validationErrors.push_back(message);
+}
+
+void NullRHI::RegisterResource(const RHIResource* pResource, RHIResourceType type)
+{
+    LockAuto lock(&m_resourceMutex);
+    m_liveResources[pResource] = type;
+    m_numCreatedResources[ToUnderlying(type)]++;
+}
+
+void NullRHI::UnregisterResource(const RHIResource* pResource)
+{
+    LockAuto lock(&m_resourceMutex);
+    m_liveResources.erase(pResource);
+}
+
+bool NullRHI::IsResourceAlive(const RHIResource* pResource) const
+{
+    LockAuto lock(&m_resourceMutex);
+    return m_liveResources.contains(pResource);
+}
+
+uint32_t NullRHI::GetNumLiveResources(RHIResourceType type) const
+{
+    LockAuto lock(&m_resourceMutex);
+    uint32_t count = 0;
+    for (const auto& kv : m_liveResources)
+    {
+        count += kv.second == type ? 1 : 0;
+    }
+    return count;
+}
+
+uint32_t NullRHI::GetNumCreatedResources(RHIResourceType type) const
+{
+    LockAuto lock(&m_resourceMutex);
+    return m_numCreatedResources[ToUnderlying(type)];
+}
+
+RHIBuffer* NullResourceFactory::CreateBuffer(const RHIBufferCreateInfo& createInfo)
+{
+    return NullBuffer::CreateObject(createInfo);
+}
+
+RHITexture* NullResourceFactory::CreateTexture(const RHITextureCreateInfo& createInfo)
+{
+    return NullTexture::CreateObject(createInfo);
+}
+
+RHISampler* NullResourceFactory::CreateSampler(const RHISamplerCreateInfo& createInfo)
+{
+    return NullSampler::CreateObject(createInfo);
+}
+
+RHIShader* NullResourceFactory::CreateShader(const RHIShaderCreateInfo& createInfo)
+{
+    return NullShader::CreateObject(createInfo);
+}
+
+RHIPipeline* NullResourceFactory::CreatePipeline(const RHIComputePipelineCreateInfo& createInfo)
+{
+    return NullPipeline::CreateObject(createInfo);
+}
+
+RHIPipeline* NullResourceFactory::CreatePipeline(const RHIGfxPipelineCreateInfo& createInfo)
+{
+    return NullPipeline::CreateObject(createInfo);
+}
+} // namespace zen
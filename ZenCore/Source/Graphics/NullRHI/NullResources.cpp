@@ -0,0 +1,448 @@
+#include "Graphics/NullRHI/NullResources.h"
+#include "Graphics/NullRHI/NullRHI.h"
+#include "Graphics/Common/Format.h"
+#include "Graphics/RHI/RHIShaderReflectionCache.h"
+#include "Platform/FileSystem.h"
+
+namespace zen
+{
+// what a GPU would roughly ask for, enough to exercise the transient memory aliasing
+static constexpr uint64_t cNullMemoryAlignment = 256;
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static uint64_t CalcTextureSize(const RHITextureCreateInfo& createInfo)
+{
+    const uint64_t pixelSize = std::max(GetTextureFormatPixelSize(createInfo.format), 1u);
+    uint64_t size            = 0;
+    uint32_t width           = createInfo.width;
+    uint32_t height          = createInfo.height;
+    uint32_t depth           = createInfo.depth;
+    for (uint32_t mip = 0; mip < createInfo.mipmaps; mip++)
+    {
+        size += static_cast<uint64_t>(width) * height * depth * pixelSize;
+        width  = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+        depth  = std::max(depth / 2, 1u);
+    }
+    return size * createInfo.arrayLayers;
+}
+
+static void ValidateMemoryBinding(const RHIResource* pResource,
+                                  bool transient,
+                                  bool bound,
+                                  const RHIMemoryRequirements& requirements,
+                                  const NullMemoryBlock* pMemoryBlock,
+                                  uint64_t offset)
+{
+    const std::string& tag = pResource->GetResourceTag();
+    if (!transient)
+    {
+        GNullRHI->ReportError("BindMemory: " + tag + " is not transient");
+    }
+    if (bound)
+    {
+        GNullRHI->ReportError("BindMemory: " + tag + " is already bound");
+    }
+    if (pMemoryBlock == nullptr || !GNullRHI->IsResourceAlive(pMemoryBlock))
+    {
+        GNullRHI->ReportError("BindMemory: " + tag + " is bound to a destroyed memory block");
+        return;
+    }
+    if (offset % requirements.alignment != 0)
+    {
+        GNullRHI->ReportError("BindMemory: " + tag + " offset " + std::to_string(offset) +
+                              " is not aligned to " + std::to_string(requirements.alignment));
+    }
+    if (offset + requirements.size > pMemoryBlock->GetRequirements().size)
+    {
+        GNullRHI->ReportError("BindMemory: " + tag + " does not fit into its memory block");
+    }
+}
+
+NullBuffer* NullBuffer::CreateObject(const RHIBufferCreateInfo& createInfo)
+{
+    NullBuffer* pBuffer = ZEN_NEW() NullBuffer(createInfo);
+
+    pBuffer->Init();
+
+    return pBuffer;
+}
+
+void NullBuffer::Init()
+{
+    if (m_transient)
+    {
+        m_memoryRequirements.size      = AlignUp(m_requiredSize, cNullMemoryAlignment);
+        m_memoryRequirements.alignment = cNullMemoryAlignment;
+    }
+    GNullRHI->RegisterResource(this, RHIResourceType::eBuffer);
+}
+
+void NullBuffer::Destroy()
+{
+    if (m_pMappedData != nullptr)
+    {
+        ZEN_MEM_FREE(m_pMappedData);
+    }
+    GNullRHI->UnregisterResource(this);
+
+    ZEN_DELETE(this);
+}
+
+uint8_t* NullBuffer::Map()
+{
+    if (m_pMappedData == nullptr)
+    {
+        m_pMappedData = static_cast<uint8_t*>(ZEN_MEM_CALLOC(m_requiredSize));
+    }
+    return m_pMappedData;
+}
+
+void NullBuffer::Unmap() {}
+
+void NullBuffer::SetTexelFormat(DataFormat format) {}
+
+void NullBuffer::BindMemory(const NullMemoryBlock* pMemoryBlock, uint64_t offset)
+{
+    ValidateMemoryBinding(this, m_transient, m_pMemoryBlock != nullptr, m_memoryRequirements,
+                          pMemoryBlock, offset);
+    m_pMemoryBlock = pMemoryBlock;
+    m_memoryOffset = offset;
+}
+
+NullTexture* NullTexture::CreateObject(const RHITextureCreateInfo& createInfo)
+{
+    NullTexture* pTexture = ZEN_NEW() NullTexture(createInfo);
+
+    pTexture->Init();
+
+    return pTexture;
+}
+
+NullTexture* NullTexture::CreateProxyObject(const NullTexture* pBaseTexture,
+                                            const RHITextureProxyCreateInfo& proxyInfo)
+{
+    NullTexture* pProxyTexture = ZEN_NEW() NullTexture(pBaseTexture, proxyInfo);
+
+    pProxyTexture->Init();
+
+    return pProxyTexture;
+}
+
+void NullTexture::Init()
+{
+    if (m_isProxy)
+    {
+        // same storage as the base texture, viewed with the proxy's format and range
+        m_baseInfo             = m_pBaseTexture->GetBaseInfo();
+        m_baseInfo.format      = m_proxyInfo.format;
+        m_baseInfo.type        = m_proxyInfo.type;
+        m_baseInfo.arrayLayers = m_proxyInfo.arrayLayers;
+        m_baseInfo.mipmaps     = m_proxyInfo.mipmaps;
+        m_baseInfo.tag         = m_proxyInfo.tag;
+        InitSubresourceRange();
+    }
+    else if (m_baseInfo.transient)
+    {
+        m_memoryRequirements.size =
+            AlignUp(CalcTextureSize(m_baseInfo), cNullMemoryAlignment);
+        m_memoryRequirements.alignment = cNullMemoryAlignment;
+    }
+    GNullRHI->RegisterResource(this, RHIResourceType::eTexture);
+}
+
+void NullTexture::Destroy()
+{
+    GNullRHI->UnregisterResource(this);
+
+    ZEN_DELETE(this);
+}
+
+bool NullTexture::HasMemory() const
+{
+    if (m_isProxy)
+    {
+        return static_cast<const NullTexture*>(m_pBaseTexture)->HasMemory();
+    }
+    return !m_baseInfo.transient || m_pMemoryBlock != nullptr;
+}
+
+void NullTexture::BindMemory(const NullMemoryBlock* pMemoryBlock, uint64_t offset)
+{
+    ValidateMemoryBinding(this, m_baseInfo.transient && !m_isProxy, m_pMemoryBlock != nullptr,
+                          m_memoryRequirements, pMemoryBlock, offset);
+    m_pMemoryBlock = pMemoryBlock;
+    m_memoryOffset = offset;
+}
+
+NullSampler* NullSampler::CreateObject(const RHISamplerCreateInfo& createInfo)
+{
+    NullSampler* pSampler = ZEN_NEW() NullSampler(createInfo);
+
+    pSampler->Init();
+
+    return pSampler;
+}
+
+void NullSampler::Init()
+{
+    GNullRHI->RegisterResource(this, RHIResourceType::eSampler);
+}
+
+void NullSampler::Destroy()
+{
+    GNullRHI->UnregisterResource(this);
+
+    ZEN_DELETE(this);
+}
+
+NullShader* NullShader::CreateObject(const RHIShaderCreateInfo& createInfo)
+{
+    NullShader* pShader = ZEN_NEW() NullShader(createInfo);
+
+    pShader->Init();
+
+    return pShader;
+}
+
+void NullShader::Init()
+{
+    m_resourceTag = m_name;
+    // the SPIR-V is still loaded and reflected so descriptor set updates can be validated,
+    // a shader without stages has no resources
+    if (!m_shaderStageFlags.IsEmpty())
+    {
+        for (uint32_t i = 0; i < ToUnderlying(RHIShaderStage::eMax); i++)
+        {
+            RHIShaderStage stage = static_cast<RHIShaderStage>(i);
+            if (m_shaderGroupSPIRV->HasShaderStage(stage))
+            {
+                m_shaderGroupSPIRV->SetStageSPIRV(
+                    stage, platform::FileSystem::LoadSpvFile(m_spirvFileName[i]));
+            }
+        }
+
+        RHIShaderGroupInfo sgInfo{};
+        GNullRHI->GetShaderReflectionCache()->GetOrReflect(m_shaderGroupSPIRV, sgInfo);
+        m_SRDTable = sgInfo.SRDTable;
+    }
+    GNullRHI->RegisterResource(this, RHIResourceType::eShader);
+}
+
+void NullShader::Destroy()
+{
+    GNullRHI->UnregisterResource(this);
+
+    ZEN_DELETE(this);
+}
+
+RHIDescriptorSet* NullShader::CreateDescriptorSet(uint32_t setIndex)
+{
+    NullDescriptorSet* pDescriptorSet = ZEN_NEW() NullDescriptorSet(this, setIndex);
+
+    pDescriptorSet->Init();
+
+    return pDescriptorSet;
+}
+
+const RHIShaderResourceDescriptor* NullShader::FindDescriptor(uint32_t setIndex,
+                                                              uint32_t binding) const
+{
+    if (setIndex >= m_SRDTable.size())
+    {
+        return nullptr;
+    }
+    for (const RHIShaderResourceDescriptor& srd : m_SRDTable[setIndex])
+    {
+        if (srd.binding == binding)
+        {
+            return &srd;
+        }
+    }
+    return nullptr;
+}
+
+void NullDescriptorSet::Init()
+{
+    const NullShader* pShader = static_cast<const NullShader*>(m_pShader);
+    if (m_setIndex >= pShader->GetSRDTable().size())
+    {
+        GNullRHI->ReportError("CreateDescriptorSet: shader " + pShader->GetResourceTag() +
+                              " has no set " + std::to_string(m_setIndex));
+    }
+    GNullRHI->RegisterResource(this, RHIResourceType::eDescriptorSet);
+}
+
+void NullDescriptorSet::Destroy()
+{
+    GNullRHI->UnregisterResource(this);
+
+    ZEN_DELETE(this);
+}
+
+void NullDescriptorSet::Update(const HeapVector<RHIShaderResourceBinding>& resourceBindings)
+{
+    const NullShader* pShader = static_cast<const NullShader*>(m_pShader);
+    for (const RHIShaderResourceBinding& srb : resourceBindings)
+    {
+        const std::string location = "set " + std::to_string(m_setIndex) + " binding " +
+            std::to_string(srb.binding);
+        const RHIShaderResourceDescriptor* pSRD = pShader->FindDescriptor(m_setIndex, srb.binding);
+        if (pSRD == nullptr)
+        {
+            GNullRHI->ReportError("UpdateDescriptorSet: " + location + " is not declared");
+        }
+        else if (pSRD->type != srb.type)
+        {
+            GNullRHI->ReportError("UpdateDescriptorSet: " + location + " type mismatch");
+        }
+        for (const RHIResource* pResource : srb.resources)
+        {
+            if (pResource == nullptr || !GNullRHI->IsResourceAlive(pResource))
+            {
+                GNullRHI->ReportError("UpdateDescriptorSet: " + location +
+                                      " references a destroyed resource");
+            }
+        }
+    }
+    m_bindings.clear();
+    for (const RHIShaderResourceBinding& srb : resourceBindings)
+    {
+        RHIShaderResourceBinding& binding = m_bindings.emplace_back();
+        binding.type                      = srb.type;
+        binding.binding                   = srb.binding;
+        for (RHIResource* pResource : srb.resources)
+        {
+            binding.resources.push_back(pResource);
+        }
+    }
+}
+
+NullPipeline* NullPipeline::CreateObject(const RHIGfxPipelineCreateInfo& createInfo)
+{
+    NullPipeline* pPipeline = ZEN_NEW() NullPipeline(createInfo);
+
+    pPipeline->Init();
+
+    return pPipeline;
+}
+
+NullPipeline* NullPipeline::CreateObject(const RHIComputePipelineCreateInfo& createInfo)
+{
+    NullPipeline* pPipeline = ZEN_NEW() NullPipeline(createInfo);
+
+    pPipeline->Init();
+
+    return pPipeline;
+}
+
+void NullPipeline::Init()
+{
+    if (m_pShader != nullptr && !GNullRHI->IsResourceAlive(m_pShader))
+    {
+        GNullRHI->ReportError("CreatePipeline: the shader is destroyed");
+    }
+    else if (m_pShader != nullptr)
+    {
+        // pipelines are named after their shader in the command log
+        m_resourceTag = m_pShader->GetResourceTag();
+    }
+    GNullRHI->RegisterResource(this, RHIResourceType::ePipeline);
+}
+
+void NullPipeline::Destroy()
+{
+    GNullRHI->UnregisterResource(this);
+
+    ZEN_DELETE(this);
+}
+
+NullMemoryBlock* NullMemoryBlock::CreateObject(const RHIMemoryRequirements& requirements)
+{
+    NullMemoryBlock* pMemoryBlock = ZEN_NEW() NullMemoryBlock(requirements);
+
+    pMemoryBlock->Init();
+
+    return pMemoryBlock;
+}
+
+void NullMemoryBlock::Init()
+{
+    GNullRHI->RegisterResource(this, RHIResourceType::eMemoryBlock);
+}
+
+void NullMemoryBlock::Destroy()
+{
+    GNullRHI->UnregisterResource(this);
+
+    ZEN_DELETE(this);
+}
+
+NullViewport* NullViewport::CreateObject(void* pWindow,
+                                         uint32_t width,
+                                         uint32_t height,
+                                         bool enableVSync)
+{
+    NullViewport* pViewport = ZEN_NEW() NullViewport(pWindow, width, height, enableVSync);
+
+    pViewport->Init();
+
+    return pViewport;
+}
+
+void NullViewport::Init()
+{
+    CreateBackBuffers();
+    GNullRHI->RegisterResource(this, RHIResourceType::eViewport);
+}
+
+void NullViewport::Destroy()
+{
+    DestroyBackBuffers();
+    GNullRHI->UnregisterResource(this);
+
+    ZEN_DELETE(this);
+}
+
+void NullViewport::Resize(uint32_t width, uint32_t height)
+{
+    m_width  = width;
+    m_height = height;
+    DestroyBackBuffers();
+    CreateBackBuffers();
+}
+
+void NullViewport::CreateBackBuffers()
+{
+    RHITextureCreateInfo colorCI{};
+    colorCI.format = GetSwapchainFormat();
+    colorCI.type   = RHITextureType::e2D;
+    colorCI.width  = m_width;
+    colorCI.height = m_height;
+    colorCI.usageFlags.SetFlags(RHITextureUsageFlagBits::eColorAttachment,
+                                RHITextureUsageFlagBits::eTransferDst);
+    colorCI.tag        = "viewport_color";
+    m_pColorBackBuffer = NullTexture::CreateObject(colorCI);
+
+    RHITextureCreateInfo depthCI{};
+    depthCI.format = GetDepthStencilFormat();
+    depthCI.type   = RHITextureType::e2D;
+    depthCI.width  = m_width;
+    depthCI.height = m_height;
+    depthCI.usageFlags.SetFlag(RHITextureUsageFlagBits::eDepthStencilAttachment);
+    depthCI.tag               = "viewport_depth";
+    m_pDepthStencilBackBuffer = NullTexture::CreateObject(depthCI);
+}
+
+void NullViewport::DestroyBackBuffers()
+{
+    m_pColorBackBuffer->ReleaseReference();
+    m_pDepthStencilBackBuffer->ReleaseReference();
+    m_pColorBackBuffer        = nullptr;
+    m_pDepthStencilBackBuffer = nullptr;
+}
+} // namespace zen
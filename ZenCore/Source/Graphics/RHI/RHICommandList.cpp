@@ -1,44 +1,107 @@
 #include "Graphics/RHI/RHICommandList.h"
 #include "Utils/Errors.h"
+#include <algorithm>
 
 namespace zen
 {
+#define ZEN_EXECUTE_CMD(name)                                                                   \
+    case RHICommandType::e##name:                                                               \
+        static_cast<const RHICommand##name*>(pCmd)->Execute(pContext);                          \
+        break
+
 void RHICommandListBase::Execute()
 {
-    RHICommandBase* pCmd = m_pCmdHead;
-    while (pCmd)
+    IRHICommandContext* pContext = GetContext();
+    for (const RHICommandBase* pCmd = m_pCmdHead; pCmd != nullptr; pCmd = pCmd->pNextCmd)
     {
-        RHICommandBase* pNext = pCmd->pNextCmd; // Save next before freeing
-
-        dynamic_cast<RHICommand*>(pCmd)->Execute(*this);
-
-        pCmd = pNext;
+        switch (pCmd->type)
+        {
+            ZEN_EXECUTE_CMD(ClearBuffer);
+            ZEN_EXECUTE_CMD(CopyBuffer);
+            ZEN_EXECUTE_CMD(ClearTexture);
+            ZEN_EXECUTE_CMD(CopyTexture);
+            ZEN_EXECUTE_CMD(CopyBufferToTexture);
+            ZEN_EXECUTE_CMD(CopyTextureToBuffer);
+            ZEN_EXECUTE_CMD(ResolveTexture);
+            ZEN_EXECUTE_CMD(BeginRendering);
+            ZEN_EXECUTE_CMD(EndRendering);
+            ZEN_EXECUTE_CMD(BindPipeline);
+            ZEN_EXECUTE_CMD(SetScissor);
+            ZEN_EXECUTE_CMD(SetViewport);
+            ZEN_EXECUTE_CMD(SetDepthBias);
+            ZEN_EXECUTE_CMD(SetLineWidth);
+            ZEN_EXECUTE_CMD(SetBlendConstants);
+            ZEN_EXECUTE_CMD(BindVertexBuffer);
+            ZEN_EXECUTE_CMD(BindVertexBuffers);
+            ZEN_EXECUTE_CMD(Draw);
+            ZEN_EXECUTE_CMD(DrawIndexed);
+            ZEN_EXECUTE_CMD(DrawIndexedIndirect);
+            ZEN_EXECUTE_CMD(DrawIndexedIndirectCount);
+            ZEN_EXECUTE_CMD(Dispatch);
+            ZEN_EXECUTE_CMD(DispatchIndirect);
+            ZEN_EXECUTE_CMD(SetPushConstants);
+            ZEN_EXECUTE_CMD(AddTransitions);
+            ZEN_EXECUTE_CMD(SetBarrierEvent);
+            ZEN_EXECUTE_CMD(WaitBarrierEvent);
+            ZEN_EXECUTE_CMD(AddTextureTransition);
+            ZEN_EXECUTE_CMD(GenTextureMipmaps);
+            case RHICommandType::eMax: break;
+        }
     }
+    // the context may drop its state once the list is replayed, commands appended later must
+    // not rely on it
+    InvalidateBoundState();
 }
 
+#undef ZEN_EXECUTE_CMD
+
 void RHICommandListBase::Reset()
 {
-    RHICommandBase* pCmd = m_pCmdHead;
-    while (pCmd)
-    {
-        RHICommandBase* pNext = pCmd->pNextCmd;
-
-        if (pCmd->pDestroy)
-        {
-            pCmd->pDestroy(pCmd);
-        }
-        else
-        {
-            pCmd->~RHICommandBase();
-        }
+    m_pCmdHead           = nullptr;
+    m_ppCmdPtr           = &m_pCmdHead;
+    m_numCommands        = 0;
+    m_numSkippedCommands = 0;
+    m_cmdAllocator.Reset();
+    InvalidateBoundState();
+}
 
-        pCmd = pNext;
+bool RHICommandListBase::IsPipelineBound(RHIPipeline* pPipeline,
+                                         uint32_t numDescriptorSets,
+                                         RHIDescriptorSet* const* pDescriptorSets)
+{
+    if (numDescriptorSets > MAX_NUM_DESCRIPTOR_SETS)
+    {
+        InvalidateBoundState();
+        return false;
+    }
+    if (pPipeline != nullptr && pPipeline == m_pBoundPipeline &&
+        numDescriptorSets == m_numBoundDescriptorSets &&
+        std::equal(pDescriptorSets, pDescriptorSets + numDescriptorSets, m_boundDescriptorSets))
+    {
+        return true;
     }
+    m_pBoundPipeline         = pPipeline;
+    m_numBoundDescriptorSets = numDescriptorSets;
+    std::copy_n(pDescriptorSets, numDescriptorSets, m_boundDescriptorSets);
+    // vulkan only keeps push constants across binds of pipelines with compatible layouts
+    m_pPushConstantsPipeline = nullptr;
+    return false;
+}
 
-    m_pCmdHead    = nullptr;
-    m_ppCmdPtr    = &m_pCmdHead;
-    m_numCommands = 0;
-    m_cmdAllocator.Reset();
+bool RHICommandListBase::ArePushConstantsSet(RHIPipeline* pPipeline,
+                                             VectorView<uint8_t> data) const
+{
+    return pPipeline != nullptr && pPipeline == m_pPushConstantsPipeline &&
+        data.size() == m_pushConstants.size() &&
+        std::equal(data.begin(), data.end(), m_pushConstants.begin());
+}
+
+void RHICommandListBase::InvalidateBoundState()
+{
+    m_pBoundPipeline         = nullptr;
+    m_numBoundDescriptorSets = 0;
+    m_pPushConstantsPipeline = nullptr;
+    m_pushConstants          = {};
 }
 
 RHICommandList* RHICommandList::Create(IRHICommandContext* pContext)
@@ -180,11 +243,14 @@ void RHICommandList::SetBlendConstants(const Color& color)
 void RHICommandList::BeginRendering(const RHIRenderingLayout* pRenderingLayout)
 {
     ALLOC_CMD(RHICommandBeginRendering)(pRenderingLayout);
+    // pushing constants ends pending render pass workloads on vulkan, keep those pushes
+    m_pPushConstantsPipeline = nullptr;
 }
 
 void RHICommandList::EndRendering()
 {
     ALLOC_CMD(RHICommandEndRendering)();
+    m_pPushConstantsPipeline = nullptr;
 }
 
 void RHICommandList::BindPipeline(RHIPipelineType pipelineType,
@@ -192,6 +258,11 @@ void RHICommandList::BindPipeline(RHIPipelineType pipelineType,
                                   uint32_t numDescriptorSets,
                                   RHIDescriptorSet* const* pDescriptorSets)
 {
+    if (IsPipelineBound(pPipeline, numDescriptorSets, pDescriptorSets))
+    {
+        ++m_numSkippedCommands;
+        return;
+    }
     ALLOC_CMD(RHICommandBindPipeline)(pipelineType, pPipeline, numDescriptorSets, pDescriptorSets);
 }
 
@@ -241,6 +312,12 @@ void RHICommandList::DrawIndexedIndirect(const RHICommandDrawIndexedIndirect::Pa
     ALLOC_CMD(RHICommandDrawIndexedIndirect)(param);
 }
 
+void RHICommandList::DrawIndexedIndirectCount(
+    const RHICommandDrawIndexedIndirectCount::Param& param)
+{
+    ALLOC_CMD(RHICommandDrawIndexedIndirectCount)(param);
+}
+
 void RHICommandList::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
 {
     ALLOC_CMD(RHICommandDispatch)(groupCountX, groupCountY, groupCountZ);
@@ -253,6 +330,11 @@ void RHICommandList::DispatchIndirect(RHIBuffer* pIndirectBuffer, uint32_t offse
 
 void RHICommandList::SetPushConstants(RHIPipeline* pPipeline, VectorView<uint8_t> data)
 {
+    if (ArePushConstantsSet(pPipeline, data))
+    {
+        ++m_numSkippedCommands;
+        return;
+    }
     RHICommandSetPushConstants* pCmd = ALLOC_CMD(RHICommandSetPushConstants)(pPipeline);
 
     uint8_t* pData = AllocateCmdData<uint8_t>(data.size());
@@ -261,6 +343,9 @@ void RHICommandList::SetPushConstants(RHIPipeline* pPipeline, VectorView<uint8_t
         std::ranges::copy(data, pData);
     }
     pCmd->data = MakeVecView(pData, data.size());
+
+    m_pPushConstantsPipeline = pPipeline;
+    m_pushConstants          = pCmd->data;
 }
 
 void RHICommandList::AddTransitions(BitField<RHIPipelineStageBits> srcStages,
@@ -317,6 +402,38 @@ void RHICommandList::AddTextureTransition(RHITexture* pTexture, RHITextureLayout
     ALLOC_CMD(RHICommandAddTextureTransition)(pTexture, newLayout);
 }
 
+void RHICommandList::SetBarrierEvent(RHIBarrierEvent* pEvent,
+                                     BitField<RHIPipelineStageBits> srcStages,
+                                     BitField<RHIPipelineStageBits> dstStages,
+                                     VectorView<RHIBufferTransition> bufferTransitions,
+                                     VectorView<RHITextureTransition> textureTransitions)
+{
+    RHICommandSetBarrierEvent* pCmd =
+        ALLOC_CMD(RHICommandSetBarrierEvent)(pEvent, srcStages, dstStages);
+
+    RHIBufferTransition* pBufferTransitions =
+        AllocateCmdData<RHIBufferTransition>(bufferTransitions.size());
+    if (pBufferTransitions != nullptr)
+    {
+        std::ranges::copy(bufferTransitions, pBufferTransitions);
+    }
+
+    RHITextureTransition* pTextureTransitions =
+        AllocateCmdData<RHITextureTransition>(textureTransitions.size());
+    if (pTextureTransitions != nullptr)
+    {
+        std::ranges::copy(textureTransitions, pTextureTransitions);
+    }
+
+    pCmd->bufferTransitions  = MakeVecView(pBufferTransitions, bufferTransitions.size());
+    pCmd->textureTransitions = MakeVecView(pTextureTransitions, textureTransitions.size());
+}
+
+void RHICommandList::WaitBarrierEvent(RHIBarrierEvent* pEvent)
+{
+    ALLOC_CMD(RHICommandWaitBarrierEvent)(pEvent);
+}
+
 void RHICommandList::GenerateTextureMipmaps(RHITexture* pTexture)
 {
     ALLOC_CMD(RHICommandGenTextureMipmaps)(pTexture);
@@ -1,5 +1,6 @@
 #include "Graphics/RHI/DynamicRHI.h"
 #include "Graphics/RHI/RHIDebug.h"
+#include "Graphics/NullRHI/NullRHI.h"
 #include "Graphics/VulkanRHI/VulkanRHI.h"
 #include "Utils/Errors.h"
 #include "Graphics/VulkanRHI/VulkanCommands.h"
@@ -17,6 +18,10 @@ DynamicRHI* DynamicRHI::Create(RHIAPIType type)
     {
         pRHI = ZEN_NEW() VulkanRHI();
     }
+    else if (type == RHIAPIType::eNull)
+    {
+        pRHI = ZEN_NEW() NullRHI();
+    }
     else
     {
         LOGE("Dynamic RHI creation failed! Unsupported Graphics API type!");
@@ -36,6 +41,10 @@ RHIDebug* RHIDebug::Create()
     {
         return ZEN_NEW() VulkanDebug();
     }
+    if (GDynamicRHI != nullptr && GDynamicRHI->GetAPIType() == RHIAPIType::eNull)
+    {
+        return ZEN_NEW() NullRHIDebug();
+    }
     LOGE("Dynamic RHI creation failed! Unsupported Graphics API type!");
 
     return nullptr;
@@ -0,0 +1,446 @@
+#include "Graphics/RHI/RHIShaderReflectionCache.h"
+#include "Graphics/RHI/RHIShaderUtil.h"
+#include "Platform/FileSystem.h"
+#include "Utils/Errors.h"
+#include "Utils/Helpers.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace zen
+{
+namespace
+{
+class ReflectionWriter
+{
+public:
+    explicit ReflectionWriter(std::vector<uint8_t>& data) : m_data(data) {}
+
+    template <class T> void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(&value);
+        m_data.insert(m_data.end(), pBytes, pBytes + sizeof(T));
+    }
+
+    template <class T> void Write(const BitField<T>& flags)
+    {
+        Write(static_cast<int64_t>(flags));
+    }
+
+    void WriteString(const std::string& str)
+    {
+        Write(static_cast<uint32_t>(str.size()));
+        m_data.insert(m_data.end(), str.begin(), str.end());
+    }
+
+private:
+    std::vector<uint8_t>& m_data;
+};
+
+// bounds checked, the first out of range read fails every following read
+class ReflectionReader
+{
+public:
+    ReflectionReader(const uint8_t* pData, size_t size) : m_pData(pData), m_size(size) {}
+
+    template <class T> T Read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        if (Reserve(sizeof(T)))
+        {
+            std::memcpy(&value, m_pData + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+        }
+        return value;
+    }
+
+    template <class T> void Read(BitField<T>& flags)
+    {
+        flags = Read<int64_t>();
+    }
+
+    std::string ReadString()
+    {
+        const uint32_t size = Read<uint32_t>();
+        if (!Reserve(size))
+        {
+            return {};
+        }
+        std::string str(reinterpret_cast<const char*>(m_pData + m_offset), size);
+        m_offset += size;
+        return str;
+    }
+
+    void ReadBytes(std::vector<uint8_t>& bytes)
+    {
+        const uint32_t size = Read<uint32_t>();
+        if (!Reserve(size))
+        {
+            return;
+        }
+        bytes.assign(m_pData + m_offset, m_pData + m_offset + size);
+        m_offset += size;
+    }
+
+    // element counts are checked against the remaining bytes before anything is allocated
+    uint32_t ReadCount(size_t minElementSize)
+    {
+        const uint32_t count = Read<uint32_t>();
+        if (count > (m_size - m_offset) / minElementSize)
+        {
+            m_valid = false;
+            return 0;
+        }
+        return count;
+    }
+
+    bool IsValid() const
+    {
+        return m_valid;
+    }
+
+    bool IsAtEnd() const
+    {
+        return m_offset == m_size;
+    }
+
+private:
+    bool Reserve(size_t size)
+    {
+        if (!m_valid || size > m_size - m_offset)
+        {
+            m_valid = false;
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t* m_pData{nullptr};
+    size_t m_size{0};
+    size_t m_offset{0};
+    bool m_valid{true};
+};
+
+// an empty string and the smallest fixed part of each element
+constexpr size_t cMinVertexInputSize   = sizeof(uint32_t) * 5;
+constexpr size_t cMinSRDSize           = sizeof(uint32_t) * 7 + sizeof(int64_t);
+constexpr size_t cMinSpecConstantSize  = sizeof(uint32_t) * 3 + sizeof(int64_t);
+constexpr size_t cMinDescriptorSetSize = sizeof(uint32_t);
+} // namespace
+
+void RHIShaderReflectionCache::Load(const std::string& path)
+{
+    m_path = path;
+    if (m_path.empty())
+    {
+        return;
+    }
+    std::ifstream file(m_path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return;
+    }
+    std::vector<uint8_t> fileData(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(fileData.data()),
+              static_cast<std::streamsize>(fileData.size()));
+
+    HashMap<uint64_t, std::vector<uint8_t>> entries;
+    if (!file || !UnpackCacheFile(fileData.data(), fileData.size(), entries))
+    {
+        LOGW("Discarding invalid shader reflection cache {}", m_path);
+        return;
+    }
+
+    LockAuto lock(&m_mutex);
+    m_entries = std::move(entries);
+    m_dirty   = false;
+    LOGI("Shader reflection cache loaded from {} ({} entries)", m_path, m_entries.size());
+}
+
+bool RHIShaderReflectionCache::Save()
+{
+    std::vector<uint8_t> fileData;
+    {
+        LockAuto lock(&m_mutex);
+        if (m_path.empty() || !m_dirty)
+        {
+            return false;
+        }
+        fileData = PackCacheFile(m_entries);
+        m_dirty  = false;
+    }
+
+    return platform::FileSystem::WriteBinaryFileAtomic(m_path, fileData.data(), fileData.size());
+}
+
+void RHIShaderReflectionCache::GetOrReflect(const RHIShaderGroupSPIRVPtr& shaderGroupSpirv,
+                                            RHIShaderGroupInfo& shaderGroupInfo)
+{
+    const uint64_t hash = CalcSPIRVHash(*shaderGroupSpirv);
+    if (Find(hash, shaderGroupInfo))
+    {
+        m_numHits.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_numMisses.fetch_add(1, std::memory_order_relaxed);
+
+    // reflected outside the lock, threads missing the same code all reflect it and Add keeps one
+    RHIShaderGroupInfo reflected{};
+    RHIShaderUtil::ReflectShaderGroupInfo(shaderGroupSpirv, reflected);
+    Add(hash, reflected);
+
+    std::string name     = std::move(shaderGroupInfo.name);
+    shaderGroupInfo      = std::move(reflected);
+    shaderGroupInfo.name = std::move(name);
+}
+
+bool RHIShaderReflectionCache::Find(uint64_t hash, RHIShaderGroupInfo& shaderGroupInfo)
+{
+    std::vector<uint8_t> data;
+    {
+        LockAuto lock(&m_mutex);
+        auto it = m_entries.find(hash);
+        if (it == m_entries.end())
+        {
+            return false;
+        }
+        data = it->second;
+    }
+    RHIShaderGroupInfo cached{};
+    if (!Deserialize(data.data(), data.size(), cached))
+    {
+        // entries are validated on load and written by Serialize, this is a bug
+        LOGE("Corrupted shader reflection cache entry {:#x}", hash);
+        return false;
+    }
+    cached.name     = std::move(shaderGroupInfo.name);
+    shaderGroupInfo = std::move(cached);
+    return true;
+}
+
+void RHIShaderReflectionCache::Add(uint64_t hash, const RHIShaderGroupInfo& shaderGroupInfo)
+{
+    std::vector<uint8_t> data;
+    Serialize(shaderGroupInfo, data);
+
+    LockAuto lock(&m_mutex);
+    if (!m_entries.contains(hash))
+    {
+        m_entries[hash] = std::move(data);
+        m_dirty         = true;
+    }
+}
+
+uint32_t RHIShaderReflectionCache::GetNumEntries()
+{
+    LockAuto lock(&m_mutex);
+    return static_cast<uint32_t>(m_entries.size());
+}
+
+uint64_t RHIShaderReflectionCache::CalcSPIRVHash(const RHIShaderGroupSPIRV& shaderGroupSpirv)
+{
+    uint64_t hash = 0;
+    for (uint32_t i = 0; i < ToUnderlying(RHIShaderStage::eMax); i++)
+    {
+        const RHIShaderStage stage = static_cast<RHIShaderStage>(i);
+        if (!shaderGroupSpirv.HasShaderStage(stage))
+        {
+            continue;
+        }
+        const HeapVector<uint8_t>& code = shaderGroupSpirv.GetStageSPIRV(stage);
+        // the stage goes into the seed, the same module used as another stage reflects differently
+        hash = util::HashBytes64(code.data(), code.size(), hash ^ (i + 1));
+    }
+    return hash;
+}
+
+void RHIShaderReflectionCache::Serialize(const RHIShaderGroupInfo& shaderGroupInfo,
+                                         std::vector<uint8_t>& outData)
+{
+    ReflectionWriter writer(outData);
+
+    writer.WriteString(shaderGroupInfo.pushConstants.name);
+    writer.Write(shaderGroupInfo.pushConstants.size);
+    writer.Write(shaderGroupInfo.pushConstants.stageFlags);
+
+    writer.Write(static_cast<uint32_t>(shaderGroupInfo.vertexInputAttributes.size()));
+    for (const auto& attribute : shaderGroupInfo.vertexInputAttributes)
+    {
+        writer.WriteString(attribute.name);
+        writer.Write(attribute.location);
+        writer.Write(attribute.binding);
+        writer.Write(attribute.offset);
+        writer.Write(static_cast<uint32_t>(attribute.format));
+    }
+    writer.Write(shaderGroupInfo.vertexBindingStride);
+
+    writer.Write(static_cast<uint32_t>(shaderGroupInfo.SRDTable.size()));
+    for (const auto& setSRDs : shaderGroupInfo.SRDTable)
+    {
+        writer.Write(static_cast<uint32_t>(setSRDs.size()));
+        for (const RHIShaderResourceDescriptor& srd : setSRDs)
+        {
+            writer.WriteString(srd.name);
+            writer.Write(ToUnderlying(srd.type));
+            writer.Write(srd.stageFlags);
+            writer.Write(static_cast<uint32_t>(srd.writable));
+            writer.Write(srd.arraySize);
+            writer.Write(srd.blockSize);
+            writer.Write(srd.set);
+            writer.Write(srd.binding);
+        }
+    }
+
+    writer.Write(static_cast<uint32_t>(shaderGroupInfo.specializationConstants.size()));
+    for (const RHIShaderSpecializationConstant& spc : shaderGroupInfo.specializationConstants)
+    {
+        writer.Write(ToUnderlying(spc.type));
+        writer.Write(spc.constantId);
+        writer.Write(spc.stages);
+        // default value, the raw bits of the union
+        writer.Write(spc.intValue);
+    }
+}
+
+bool RHIShaderReflectionCache::Deserialize(const uint8_t* pData,
+                                           size_t dataSize,
+                                           RHIShaderGroupInfo& shaderGroupInfo)
+{
+    ReflectionReader reader(pData, dataSize);
+
+    shaderGroupInfo.pushConstants.name = reader.ReadString();
+    shaderGroupInfo.pushConstants.size = reader.Read<uint32_t>();
+    reader.Read(shaderGroupInfo.pushConstants.stageFlags);
+
+    const uint32_t numVertexInputs = reader.ReadCount(cMinVertexInputSize);
+    shaderGroupInfo.vertexInputAttributes.resize(numVertexInputs);
+    for (auto& attribute : shaderGroupInfo.vertexInputAttributes)
+    {
+        attribute.name     = reader.ReadString();
+        attribute.location = reader.Read<uint32_t>();
+        attribute.binding  = reader.Read<uint32_t>();
+        attribute.offset   = reader.Read<uint32_t>();
+        attribute.format   = static_cast<DataFormat>(reader.Read<uint32_t>());
+    }
+    shaderGroupInfo.vertexBindingStride = reader.Read<uint32_t>();
+
+    const uint32_t numSets = reader.ReadCount(cMinDescriptorSetSize);
+    if (numSets > MAX_NUM_DESCRIPTOR_SETS)
+    {
+        return false;
+    }
+    shaderGroupInfo.SRDTable.resize(numSets);
+    for (auto& setSRDs : shaderGroupInfo.SRDTable)
+    {
+        const uint32_t numSRDs = reader.ReadCount(cMinSRDSize);
+        setSRDs.resize(numSRDs);
+        for (RHIShaderResourceDescriptor& srd : setSRDs)
+        {
+            srd.name = reader.ReadString();
+            srd.type = static_cast<RHIShaderResourceType>(reader.Read<uint32_t>());
+            reader.Read(srd.stageFlags);
+            srd.writable  = reader.Read<uint32_t>() != 0;
+            srd.arraySize = reader.Read<uint32_t>();
+            srd.blockSize = reader.Read<uint32_t>();
+            srd.set       = reader.Read<uint32_t>();
+            srd.binding   = reader.Read<uint32_t>();
+        }
+    }
+
+    const uint32_t numSpecConstants = reader.ReadCount(cMinSpecConstantSize);
+    shaderGroupInfo.specializationConstants.resize(numSpecConstants);
+    for (RHIShaderSpecializationConstant& spc : shaderGroupInfo.specializationConstants)
+    {
+        spc.type       = static_cast<RHIShaderSpecializationConstantType>(reader.Read<uint32_t>());
+        spc.constantId = reader.Read<uint32_t>();
+        reader.Read(spc.stages);
+        spc.intValue = reader.Read<uint32_t>();
+    }
+
+    return reader.IsValid() && reader.IsAtEnd();
+}
+
+std::vector<uint8_t> RHIShaderReflectionCache::PackCacheFile(
+    const HashMap<uint64_t, std::vector<uint8_t>>& entries)
+{
+    // sorted by hash, the same entries always give the same file
+    std::vector<uint64_t> hashes;
+    hashes.reserve(entries.size());
+    for (const auto& kv : entries)
+    {
+        hashes.push_back(kv.first);
+    }
+    std::sort(hashes.begin(), hashes.end());
+
+    std::vector<uint8_t> data;
+    ReflectionWriter writer(data);
+    for (uint64_t hash : hashes)
+    {
+        const std::vector<uint8_t>& entry = entries.find(hash)->second;
+        writer.Write(hash);
+        writer.Write(static_cast<uint32_t>(entry.size()));
+        data.insert(data.end(), entry.begin(), entry.end());
+    }
+
+    FileHeader header{};
+    header.magic      = cMagic;
+    header.version    = cVersion;
+    header.numEntries = static_cast<uint32_t>(hashes.size());
+    header.dataSize   = data.size();
+    header.dataHash   = util::HashBytes64(data.data(), data.size());
+
+    std::vector<uint8_t> fileData(sizeof(FileHeader) + data.size());
+    std::memcpy(fileData.data(), &header, sizeof(FileHeader));
+    if (!data.empty())
+    {
+        std::memcpy(fileData.data() + sizeof(FileHeader), data.data(), data.size());
+    }
+    return fileData;
+}
+
+bool RHIShaderReflectionCache::UnpackCacheFile(const uint8_t* pFile,
+                                               size_t fileSize,
+                                               HashMap<uint64_t, std::vector<uint8_t>>& entries)
+{
+    entries.clear();
+    if (fileSize < sizeof(FileHeader))
+    {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, pFile, sizeof(FileHeader));
+    const uint8_t* pData = pFile + sizeof(FileHeader);
+    if (header.magic != cMagic || header.version != cVersion ||
+        header.dataSize != fileSize - sizeof(FileHeader) ||
+        util::HashBytes64(pData, header.dataSize) != header.dataHash)
+    {
+        return false;
+    }
+
+    ReflectionReader reader(pData, header.dataSize);
+    for (uint32_t i = 0; i < header.numEntries && reader.IsValid(); i++)
+    {
+        const uint64_t hash = reader.Read<uint64_t>();
+        std::vector<uint8_t> entry;
+        reader.ReadBytes(entry);
+        // every entry has to decode, a file that passed the hash can still come from a bug
+        RHIShaderGroupInfo shaderGroupInfo{};
+        if (!reader.IsValid() || !Deserialize(entry.data(), entry.size(), shaderGroupInfo))
+        {
+            entries.clear();
+            return false;
+        }
+        entries[hash] = std::move(entry);
+    }
+    if (!reader.IsValid() || !reader.IsAtEnd() || entries.size() != header.numEntries)
+    {
+        entries.clear();
+        return false;
+    }
+    return true;
+}
+} // namespace zen
@@ -23,6 +23,12 @@ void DeferredLightingRenderer::Init()
     PrepareTextures();
 
     BuildGraphicsPasses();
+
+    if (RenderConfig::GetInstance().gpuDrivenDraws)
+    {
+        m_indirectCuller = MakeUnique<IndirectDrawCuller>(m_pRenderDevice);
+        m_indirectCuller->Init("OffScreen");
+    }
 }
 
 void DeferredLightingRenderer::Destroy()
@@ -33,10 +39,32 @@ void DeferredLightingRenderer::Destroy()
     m_pRenderDevice->DestroyTexture(m_offscreenTextures.pMetallicRoughness);
     m_pRenderDevice->DestroyTexture(m_offscreenTextures.pEmissiveOcclusion);
     m_pRenderDevice->DestroyTexture(m_offscreenTextures.pDepth);
+    if (m_indirectCuller)
+    {
+        m_indirectCuller->Destroy();
+    }
+}
+
+void DeferredLightingRenderer::SetRenderScene(RenderScene* pRenderScene)
+{
+    m_pScene = pRenderScene;
+    if (m_indirectCuller)
+    {
+        m_indirectCuller->SetRenderScene(m_pScene);
+    }
+    UpdateGraphicsPassResources();
 }
 
 void DeferredLightingRenderer::PrepareRenderWorkload()
 {
+    if (m_indirectCuller)
+    {
+        m_indirectCuller->SetFrustum(m_pScene->GetCamera()->GetFrustum());
+    }
+    else
+    {
+        UpdateVisibleItems();
+    }
     if (m_rebuildRDG)
     {
         BuildRenderGraph();
@@ -48,6 +76,16 @@ void DeferredLightingRenderer::PrepareRenderWorkload()
         "uSceneData", m_pScene->GetSceneUniformData(), 0);
 }
 
+void DeferredLightingRenderer::UpdateVisibleItems()
+{
+    m_pScene->CullView(m_pScene->GetCamera()->GetFrustum(), m_cullResult);
+    if (m_cullResult != m_visibleItems)
+    {
+        m_visibleItems.swap(m_cullResult);
+        m_rebuildRDG = true;
+    }
+}
+
 void DeferredLightingRenderer::OnResize()
 {
     m_rebuildRDG = true;
@@ -217,10 +255,15 @@ void DeferredLightingRenderer::BuildGraphicsPasses()
         pso.colorBlendState.AddAttachments(5);
         pso.dynamicStates.Enable(RHIDynamicState::eScissor, RHIDynamicState::eViewPort);
 
+        const RenderConfig& config = RenderConfig::GetInstance();
+        const char* shaderProgramName =
+            config.gpuDrivenDraws ? "GBufferIndirectSP" :
+                                    (config.packedVertices ? "GBufferPackedSP" : "GBufferSP");
+
         rc::GraphicsPassBuilder builder(m_pRenderDevice);
         m_gfxPasses.pOffscreen =
             builder
-                .SetShaderProgramName("GBufferSP")
+                .SetShaderProgramName(shaderProgramName)
                 // .SetNumSamples(SampleCount::e1)
                 // (World space) Positions
                 .AddColorRenderTarget(m_offscreenTextures.pPosition)
@@ -237,6 +280,7 @@ void DeferredLightingRenderer::BuildGraphicsPasses()
                 .SetPipelineState(pso)
                 .SetFramebufferInfo(m_pViewport, RenderConfig::GetInstance().offScreenFbSize,
                                     RenderConfig::GetInstance().offScreenFbSize)
+                .SetAsyncPipelineCompile(true)
                 .SetTag("OffScreen")
                 .Build();
     }
@@ -263,6 +307,7 @@ void DeferredLightingRenderer::BuildGraphicsPasses()
                                            RHIRenderTargetStoreOp::eStore)
                 .SetPipelineState(pso)
                 .SetFramebufferInfo(m_pViewport)
+                .SetAsyncPipelineCompile(true)
                 .SetTag("SceneLighting")
                 .Build();
     }
@@ -272,6 +317,10 @@ void DeferredLightingRenderer::BuildRenderGraph()
 {
     m_rdg = MakeUnique<RenderGraph>("deferred_lighting_rdg");
     m_rdg->Begin();
+    if (m_indirectCuller)
+    {
+        m_indirectCuller->AddCullPassNodes(m_rdg.Get());
+    }
     // offscreen pPass
     {
         const uint32_t cFbSize = RenderConfig::GetInstance().offScreenFbSize;
@@ -369,26 +418,76 @@ void DeferredLightingRenderer::AddMeshDrawNodes(RDGPassNode* pPass,
                                                 const Rect2<int>& area,
                                                 const Rect2<float>& viewport)
 {
+    if (m_indirectCuller)
+    {
+        AddIndirectMeshDrawNodes(pPass, area, viewport);
+        return;
+    }
+    if (RenderConfig::GetInstance().packedVertices)
+    {
+        AddPackedMeshDrawNodes(pPass, area, viewport);
+        return;
+    }
     GBufferSP* pShaderProgram = dynamic_cast<GBufferSP*>(m_gfxPasses.pOffscreen->pShaderProgram);
     m_rdg->AddGraphicsPassBindVertexBufferNode(pPass, m_pScene->GetVertexBuffer(), {0});
     m_rdg->AddGraphicsPassBindIndexBufferNode(pPass, m_pScene->GetIndexBuffer(),
                                               DataFormat::eR32UInt);
     m_rdg->AddGraphicsPassSetViewportNode(pPass, viewport);
     m_rdg->AddGraphicsPassSetScissorNode(pPass, area);
-    for (auto* node : m_pScene->GetRenderableNodes())
+    const sg::SceneBVH& bvh = m_pScene->GetBVH();
+    for (uint32_t itemIndex : m_visibleItems)
     {
-        pShaderProgram->pushConstantsData.nodeIndex = node->GetRenderableIndex();
-        for (auto* subMesh : node->GetComponent<sg::Mesh>()->GetSubMeshes())
-        {
-            pShaderProgram->pushConstantsData.materialIndex = subMesh->GetMaterial()->index;
-            m_rdg->AddGraphicsPassSetPushConstants(pPass, &pShaderProgram->pushConstantsData,
-                                                   sizeof(GBufferSP::PushConstantsData));
-            m_rdg->AddGraphicsPassDrawIndexedNode(pPass, subMesh->GetIndexCount(), 1,
-                                                  subMesh->GetFirstIndex(), 0, 0);
-        }
+        const sg::SceneBVH::Item& item = bvh.GetItem(itemIndex);
+        pShaderProgram->pushConstantsData.nodeIndex     = item.pNode->GetRenderableIndex();
+        pShaderProgram->pushConstantsData.materialIndex = item.pSubMesh->GetMaterial()->index;
+        m_rdg->AddGraphicsPassSetPushConstants(pPass, &pShaderProgram->pushConstantsData,
+                                               sizeof(GBufferSP::PushConstantsData));
+        m_rdg->AddGraphicsPassDrawIndexedNode(pPass, item.pSubMesh->GetIndexCount(), 1,
+                                              item.pSubMesh->GetFirstIndex(), 0, 0);
     }
 }
 
+void DeferredLightingRenderer::AddPackedMeshDrawNodes(RDGPassNode* pPass,
+                                                      const Rect2<int>& area,
+                                                      const Rect2<float>& viewport)
+{
+    GBufferPackedSP* pShaderProgram =
+        dynamic_cast<GBufferPackedSP*>(m_gfxPasses.pOffscreen->pShaderProgram);
+    m_rdg->AddGraphicsPassBindVertexBufferNode(pPass, m_pScene->GetPackedVertexBuffer(), {0});
+    m_rdg->AddGraphicsPassBindIndexBufferNode(pPass, m_pScene->GetIndexBuffer(),
+                                              DataFormat::eR32UInt);
+    m_rdg->AddGraphicsPassSetViewportNode(pPass, viewport);
+    m_rdg->AddGraphicsPassSetScissorNode(pPass, area);
+    // the BVH holds no empty submeshes
+    const sg::SceneBVH& bvh = m_pScene->GetBVH();
+    for (uint32_t itemIndex : m_visibleItems)
+    {
+        const sg::SceneBVH::Item& item = bvh.GetItem(itemIndex);
+        const asset::VertexQuantizationBounds& bounds =
+            m_pScene->GetVertexQuantizationBounds(item.pSubMesh);
+        pShaderProgram->pushConstantsData.nodeIndex     = item.pNode->GetRenderableIndex();
+        pShaderProgram->pushConstantsData.materialIndex = item.pSubMesh->GetMaterial()->index;
+        pShaderProgram->pushConstantsData.posOffset     = bounds.offset;
+        pShaderProgram->pushConstantsData.posScale      = bounds.scale;
+        m_rdg->AddGraphicsPassSetPushConstants(pPass, &pShaderProgram->pushConstantsData,
+                                               sizeof(GBufferPackedSP::PushConstantsData));
+        m_rdg->AddGraphicsPassDrawIndexedNode(pPass, item.pSubMesh->GetIndexCount(), 1,
+                                              item.pSubMesh->GetFirstIndex(), 0, 0);
+    }
+}
+
+void DeferredLightingRenderer::AddIndirectMeshDrawNodes(RDGPassNode* pPass,
+                                                        const Rect2<int>& area,
+                                                        const Rect2<float>& viewport)
+{
+    m_rdg->AddGraphicsPassBindVertexBufferNode(pPass, m_pScene->GetVertexBuffer(), {0});
+    m_rdg->AddGraphicsPassBindIndexBufferNode(pPass, m_pScene->GetIndexBuffer(),
+                                              DataFormat::eR32UInt);
+    m_rdg->AddGraphicsPassSetViewportNode(pPass, viewport);
+    m_rdg->AddGraphicsPassSetScissorNode(pPass, area);
+    m_indirectCuller->AddDrawNode(m_rdg.Get(), pPass);
+}
+
 void DeferredLightingRenderer::UpdateGraphicsPassResources()
 {
     const EnvTexture& envTexture = m_pScene->GetEnvTexture();
@@ -403,6 +502,11 @@ void DeferredLightingRenderer::UpdateGraphicsPassResources()
                                   m_pScene->GetNodesDataSSBO());
         ADD_SHADER_BINDING_SINGLE(bufferBindings, 2, RHIShaderResourceType::eStorageBuffer,
                                   m_pScene->GetMaterialsDataSSBO());
+        if (m_indirectCuller)
+        {
+            ADD_SHADER_BINDING_SINGLE(bufferBindings, 3, RHIShaderResourceType::eStorageBuffer,
+                                      m_pScene->GetDrawInstancesSSBO());
+        }
         // texture array
         ADD_SHADER_BINDING_TEXTURE_ARRAY(textureBindings, 0,
                                          RHIShaderResourceType::eSamplerWithTexture, m_pColorSampler,
@@ -1,5 +1,6 @@
 #include "Graphics/RenderCore/V2/Renderer/GeometryVoxelizer.h"
 
+#include "Graphics/RenderCore/V2/RenderConfig.h"
 #include "Graphics/RenderCore/V2/RenderResource.h"
 #include "Graphics/RenderCore/V2/RenderScene.h"
 #include "Graphics/RenderCore/V2/ShaderProgram.h"
@@ -69,23 +70,36 @@ void GeometryVoxelizer::BuildRenderGraph()
 
         // m_rdg->DeclareTextureAccessForPass(pPass, 4, textures, RHITextureUsage::eStorage, ranges,
         //                                    RHIAccessMode::eReadWrite);
-        m_rdg->AddGraphicsPassBindVertexBufferNode(pPass, m_pScene->GetVertexBuffer(), {0});
+        const bool packedVertices = RenderConfig::GetInstance().packedVertices;
+        m_rdg->AddGraphicsPassBindVertexBufferNode(
+            pPass,
+            packedVertices ? m_pScene->GetPackedVertexBuffer() : m_pScene->GetVertexBuffer(),
+            {0});
         m_rdg->AddGraphicsPassBindIndexBufferNode(pPass, m_pScene->GetIndexBuffer(),
                                                   DataFormat::eR32UInt);
         m_rdg->AddGraphicsPassSetViewportNode(pPass, viewport);
         m_rdg->AddGraphicsPassSetScissorNode(pPass, area);
         pShaderProgram->pushConstantsData.flagStaticVoxels = 1;
         pShaderProgram->pushConstantsData.volumeDimension  = m_voxelTexResolution;
-        for (auto* node : m_pScene->GetRenderableNodes())
+        if (packedVertices)
         {
-            pShaderProgram->pushConstantsData.nodeIndex = node->GetRenderableIndex();
-            for (auto* subMesh : node->GetComponent<sg::Mesh>()->GetSubMeshes())
+            AddPackedVoxelizationDrawNodes(pPass);
+        }
+        else
+        {
+            for (auto* node : m_pScene->GetRenderableNodes())
             {
-                pShaderProgram->pushConstantsData.materialIndex = subMesh->GetMaterial()->index;
-                m_rdg->AddGraphicsPassSetPushConstants(pPass, &pShaderProgram->pushConstantsData,
-                                                       sizeof(VoxelizationSP::PushConstantsData));
-                m_rdg->AddGraphicsPassDrawIndexedNode(pPass, subMesh->GetIndexCount(), 1,
-                                                      subMesh->GetFirstIndex(), 0, 0);
+                pShaderProgram->pushConstantsData.nodeIndex = node->GetRenderableIndex();
+                for (auto* subMesh : node->GetComponent<sg::Mesh>()->GetSubMeshes())
+                {
+                    pShaderProgram->pushConstantsData.materialIndex =
+                        subMesh->GetMaterial()->index;
+                    m_rdg->AddGraphicsPassSetPushConstants(
+                        pPass, &pShaderProgram->pushConstantsData,
+                        sizeof(VoxelizationSP::PushConstantsData));
+                    m_rdg->AddGraphicsPassDrawIndexedNode(pPass, subMesh->GetIndexCount(), 1,
+                                                          subMesh->GetFirstIndex(), 0, 0);
+                }
             }
         }
         m_needVoxelization = false;
@@ -127,6 +141,36 @@ void GeometryVoxelizer::BuildRenderGraph()
     m_rdg->End();
 }
 
+void GeometryVoxelizer::AddPackedVoxelizationDrawNodes(RDGPassNode* pPass)
+{
+    VoxelizationPackedSP* pShaderProgram =
+        dynamic_cast<VoxelizationPackedSP*>(m_gfxPasses.pVoxelization->pShaderProgram);
+    VoxelizationSP::PushConstantsData& base = pShaderProgram->packedPushConstantsData.base;
+    base = pShaderProgram->pushConstantsData;
+    for (auto* node : m_pScene->GetRenderableNodes())
+    {
+        base.nodeIndex = node->GetRenderableIndex();
+        for (auto* subMesh : node->GetComponent<sg::Mesh>()->GetSubMeshes())
+        {
+            // empty submeshes have no quantization bounds
+            if (subMesh->GetIndexCount() == 0)
+            {
+                continue;
+            }
+            const asset::VertexQuantizationBounds& bounds =
+                m_pScene->GetVertexQuantizationBounds(subMesh);
+            base.materialIndex                                = subMesh->GetMaterial()->index;
+            pShaderProgram->packedPushConstantsData.posOffset = bounds.offset;
+            pShaderProgram->packedPushConstantsData.posScale  = bounds.scale;
+            m_rdg->AddGraphicsPassSetPushConstants(
+                pPass, &pShaderProgram->packedPushConstantsData,
+                sizeof(VoxelizationPackedSP::PackedPushConstantsData));
+            m_rdg->AddGraphicsPassDrawIndexedNode(pPass, subMesh->GetIndexCount(), 1,
+                                                  subMesh->GetFirstIndex(), 0, 0);
+        }
+    }
+}
+
 void GeometryVoxelizer::BuildGraphicsPasses()
 {
     // voxelization graphics pass, set static flag
@@ -143,7 +187,9 @@ void GeometryVoxelizer::BuildGraphicsPasses()
         rc::GraphicsPassBuilder builder(m_pRenderDevice);
         m_gfxPasses.pVoxelization =
             builder
-                .SetShaderProgramName("VoxelizationSP")
+                .SetShaderProgramName(RenderConfig::GetInstance().packedVertices ?
+                                          "VoxelizationPackedSP" :
+                                          "VoxelizationSP")
                 // .SetNumSamples(SampleCount::e1)
                 .SetPipelineState(pso)
                 //.AddColorRenderTarget(DataFormat::eR8G8B8A8SRGB, RHITextureUsage::eColorAttachment,
@@ -0,0 +1,103 @@
+#include "Graphics/RenderCore/V2/Renderer/IndirectDrawCuller.h"
+#include "Graphics/RenderCore/V2/RenderScene.h"
+#include "Graphics/RenderCore/V2/RenderDevice.h"
+#include "Graphics/RenderCore/V2/RenderConfig.h"
+#include "Graphics/RenderCore/V2/ShaderProgram.h"
+#include "Graphics/Types/Frustum.h"
+
+namespace zen::rc
+{
+IndirectDrawCuller::IndirectDrawCuller(RenderDevice* pRenderDevice) :
+    m_pRenderDevice(pRenderDevice)
+{}
+
+void IndirectDrawCuller::Init(const std::string& tag)
+{
+    m_tag = tag;
+
+    ComputePassBuilder builder(m_pRenderDevice);
+    m_pCullPass = builder.SetShaderProgramName("CullDrawsSP").SetTag(tag + "_CullDraws").Build();
+}
+
+void IndirectDrawCuller::Destroy()
+{
+    if (m_pCullDataBuffer != nullptr)
+    {
+        m_pRenderDevice->DestroyBuffer(m_pCullDataBuffer);
+        m_pRenderDevice->DestroyBuffer(m_pDrawCommandBuffer);
+        m_pRenderDevice->DestroyBuffer(m_pDrawCountBuffer);
+    }
+}
+
+void IndirectDrawCuller::SetRenderScene(RenderScene* pRenderScene)
+{
+    m_pScene       = pRenderScene;
+    m_numInstances = m_pScene->GetNumDrawInstances();
+
+    CullDrawsSP::CullData cullData{};
+    m_pCullDataBuffer = m_pRenderDevice->CreateUniformBuffer(
+        sizeof(CullDrawsSP::CullData), reinterpret_cast<const uint8_t*>(&cullData),
+        m_tag + "_cull_data");
+    // at least one command, empty scenes still bind a valid buffer
+    m_pDrawCommandBuffer = m_pRenderDevice->CreateIndirectBuffer(
+        sizeof(DrawIndexedIndirectCommand) * std::max(m_numInstances, 1u), nullptr,
+        m_tag + "_draw_commands");
+    const uint32_t drawCount = 0;
+    m_pDrawCountBuffer       = m_pRenderDevice->CreateIndirectBuffer(
+        sizeof(uint32_t), reinterpret_cast<const uint8_t*>(&drawCount), m_tag + "_draw_count");
+
+    HeapVector<RHIShaderResourceBinding> set0bindings;
+    ADD_SHADER_BINDING_SINGLE(set0bindings, 0, RHIShaderResourceType::eUniformBuffer,
+                              m_pCullDataBuffer);
+    ADD_SHADER_BINDING_SINGLE(set0bindings, 1, RHIShaderResourceType::eStorageBuffer,
+                              m_pScene->GetDrawInstancesSSBO());
+    ADD_SHADER_BINDING_SINGLE(set0bindings, 2, RHIShaderResourceType::eStorageBuffer,
+                              m_pDrawCommandBuffer);
+    ADD_SHADER_BINDING_SINGLE(set0bindings, 3, RHIShaderResourceType::eStorageBuffer,
+                              m_pDrawCountBuffer);
+    ComputePassResourceUpdater updater(m_pRenderDevice, m_pCullPass);
+    updater.SetShaderResourceBinding(0, std::move(set0bindings)).Update();
+}
+
+void IndirectDrawCuller::SetFrustum(const Frustum& frustum)
+{
+    const CullDrawsSP::CullData cullData =
+        MakeCullData(frustum, m_numInstances, RenderConfig::GetInstance().frustumCulling);
+    m_pRenderDevice->UpdateBuffer(m_pCullDataBuffer, sizeof(CullDrawsSP::CullData),
+                                  reinterpret_cast<const uint8_t*>(&cullData));
+}
+
+void IndirectDrawCuller::AddCullPassNodes(RenderGraph* pRDG)
+{
+    pRDG->AddBufferClearNode(m_pDrawCountBuffer, 0, sizeof(uint32_t));
+    if (m_numInstances == 0)
+    {
+        return;
+    }
+    auto* pPass = pRDG->AddComputePassNode(m_pCullPass, m_tag + "_cull_draws");
+    pRDG->AddComputePassDispatchNode(pPass, (m_numInstances + cWorkgroupSize - 1) / cWorkgroupSize,
+                                     1, 1);
+}
+
+void IndirectDrawCuller::AddDrawNode(RenderGraph* pRDG, RDGPassNode* pPass)
+{
+    pRDG->AddGraphicsPassDrawIndexedIndirectCountNode(pPass, m_pDrawCommandBuffer, 0,
+                                                      m_pDrawCountBuffer, 0, m_numInstances,
+                                                      sizeof(DrawIndexedIndirectCommand));
+}
+
+CullDrawsSP::CullData IndirectDrawCuller::MakeCullData(const Frustum& frustum,
+                                                       uint32_t numInstances,
+                                                       bool cullingEnabled)
+{
+    CullDrawsSP::CullData cullData{};
+    const std::array<Vec4, 6>& planes = frustum.GetPlanes();
+    for (uint32_t i = 0; i < planes.size(); i++)
+    {
+        cullData.frustumPlanes[i] = planes[i];
+    }
+    cullData.numInstances   = numInstances;
+    cullData.cullingEnabled = cullingEnabled ? 1 : 0;
+    return cullData;
+}
+} // namespace zen::rc
@@ -0,0 +1,150 @@
+#include "Graphics/RenderCore/V2/PipelineCompiler.h"
+#include "Graphics/RHI/DynamicRHI.h"
+#include <thread>
+
+namespace zen::rc
+{
+PipelineCompiler::PipelineCompiler(uint32_t numWorkers)
+{
+    m_pJobSystem = MakeUnique<JobSystem>(numWorkers);
+}
+
+PipelineCompiler::~PipelineCompiler()
+{
+    WaitIdle();
+    for (auto& kv : m_requests)
+    {
+        Request* pRequest = kv.second;
+        if (!pRequest->published && pRequest->pPipeline != nullptr)
+        {
+            GDynamicRHI->DestroyPipeline(pRequest->pPipeline);
+        }
+        ZEN_DELETE(pRequest);
+    }
+    m_requests.clear();
+    m_completed.clear();
+}
+
+RHIPipeline* PipelineCompiler::RequestGfxPipeline(size_t hash,
+                                                  const RHIGfxPipelineCreateInfo& createInfo,
+                                                  RHIPipeline** ppTarget)
+{
+    Request* pRequest = nullptr;
+    {
+        LockAuto lock(&m_mutex);
+        auto it = m_requests.find(hash);
+        if (it != m_requests.end())
+        {
+            Request* pExisting = it->second;
+            if (pExisting->published)
+            {
+                return pExisting->pPipeline;
+            }
+            if (ppTarget != nullptr)
+            {
+                pExisting->targets.push_back(ppTarget);
+            }
+            return nullptr;
+        }
+
+        pRequest             = ZEN_NEW() Request();
+        pRequest->hash       = hash;
+        pRequest->createInfo = createInfo;
+        if (createInfo.pRenderingLayout != nullptr)
+        {
+            pRequest->renderingLayout             = *createInfo.pRenderingLayout;
+            pRequest->createInfo.pRenderingLayout = &pRequest->renderingLayout;
+        }
+        if (ppTarget != nullptr)
+        {
+            pRequest->targets.push_back(ppTarget);
+        }
+        m_requests[hash] = pRequest;
+        m_numPending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // outside the lock, Submit runs the job inline when this thread can not get a queue
+    m_pJobSystem->Submit([this, pRequest]() { Compile(pRequest); }, &pRequest->counter);
+    return nullptr;
+}
+
+void PipelineCompiler::Compile(Request* pRequest)
+{
+    RHIPipeline* pPipeline = GDynamicRHI->CreatePipeline(pRequest->createInfo);
+
+    LockAuto lock(&m_mutex);
+    pRequest->pPipeline = pPipeline;
+    pRequest->compiled.store(true, std::memory_order_release);
+    m_completed.push_back(pRequest);
+    m_numPending.fetch_sub(1, std::memory_order_release);
+}
+
+void PipelineCompiler::WaitRequest(Request* pRequest)
+{
+    // the counter is still 0 while the thread that made the request has not submitted it yet
+    while (!pRequest->compiled.load(std::memory_order_acquire))
+    {
+        m_pJobSystem->Wait(&pRequest->counter);
+        if (!pRequest->compiled.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void PipelineCompiler::Wait(size_t hash)
+{
+    Request* pRequest = nullptr;
+    {
+        LockAuto lock(&m_mutex);
+        auto it = m_requests.find(hash);
+        if (it == m_requests.end())
+        {
+            return;
+        }
+        pRequest = it->second;
+    }
+    // requests live until the compiler is destroyed
+    WaitRequest(pRequest);
+}
+
+void PipelineCompiler::PublishCompleted(std::vector<CompiledPipeline>& outCompiled)
+{
+    LockAuto lock(&m_mutex);
+    for (Request* pRequest : m_completed)
+    {
+        pRequest->published = true;
+        for (RHIPipeline** ppTarget : pRequest->targets)
+        {
+            *ppTarget = pRequest->pPipeline;
+        }
+        pRequest->targets.clear();
+        pRequest->targets.shrink_to_fit();
+        outCompiled.push_back({pRequest->hash, pRequest->pPipeline});
+    }
+    m_completed.clear();
+}
+
+void PipelineCompiler::WaitIdle()
+{
+    std::vector<Request*> requests;
+    {
+        LockAuto lock(&m_mutex);
+        requests.reserve(m_requests.size());
+        for (auto& kv : m_requests)
+        {
+            requests.push_back(kv.second);
+        }
+    }
+    for (Request* pRequest : requests)
+    {
+        WaitRequest(pRequest);
+    }
+}
+
+uint32_t PipelineCompiler::GetNumRequested()
+{
+    LockAuto lock(&m_mutex);
+    return static_cast<uint32_t>(m_requests.size());
+}
+} // namespace zen::rc
@@ -0,0 +1,217 @@
+#include "Graphics/RenderCore/V2/RDGTransientAllocator.h"
+#include "Memory/Memory.h"
+#include "Utils/Errors.h"
+#include <algorithm>
+#include <vector>
+
+namespace zen::rc
+{
+namespace
+{
+struct MemoryRange
+{
+    uint64_t begin;
+    uint64_t end;
+};
+
+bool MemoryOverlaps(const RDGTransientPlacement& a,
+                    uint64_t sizeA,
+                    const RDGTransientPlacement& b,
+                    uint64_t sizeB)
+{
+    return a.blockIndex == b.blockIndex && a.offset < b.offset + sizeB &&
+        b.offset < a.offset + sizeA;
+}
+
+// lowest aligned offset where size bytes fit between the occupied ranges, which are sorted by
+// begin, returns false if the end would pass limit
+bool FindFreeOffset(const HeapVector<MemoryRange>& occupied,
+                    uint64_t size,
+                    uint64_t alignment,
+                    uint64_t limit,
+                    uint64_t& outOffset)
+{
+    uint64_t offset = 0;
+    for (const MemoryRange& range : occupied)
+    {
+        if (offset + size <= range.begin)
+        {
+            break;
+        }
+        offset = std::max(offset, Pow2Align(range.end, alignment));
+    }
+    outOffset = offset;
+    return offset + size <= limit;
+}
+} // namespace
+
+void RDGTransientAllocator::Place(const HeapVector<RDGTransientRequest>& requests,
+                                  uint64_t maxBlockSize,
+                                  RDGTransientLayout& outLayout)
+{
+    outLayout.placements.clear();
+    outLayout.blocks.clear();
+    outLayout.requestedSize = 0;
+    outLayout.allocatedSize = 0;
+    outLayout.peakLiveSize  = 0;
+    outLayout.fixedConflicts.clear();
+    if (requests.empty())
+    {
+        return;
+    }
+    outLayout.placements.resize(requests.size());
+
+    // requests placed so far, per block
+    HeapVector<HeapVector<uint32_t>> residents;
+    std::vector<uint32_t> order;
+    order.reserve(requests.size());
+    int32_t lastNode = 0;
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        const RDGTransientRequest& request = requests[i];
+        VERIFY_EXPR_MSG(request.lifetime.IsValid(), "transient request without lifetime");
+        outLayout.requestedSize += request.memory.size;
+        lastNode = std::max(lastNode, request.lifetime.lastNode);
+        if (!request.fixed)
+        {
+            order.push_back(i);
+            continue;
+        }
+
+        while (outLayout.blocks.size() <= request.fixedBlockIndex)
+        {
+            outLayout.blocks.emplace_back();
+            residents.emplace_back();
+        }
+        RDGTransientPlacement& placement = outLayout.placements[i];
+        placement.blockIndex             = request.fixedBlockIndex;
+        placement.offset                 = request.fixedOffset;
+
+        RDGTransientBlock& block = outLayout.blocks[request.fixedBlockIndex];
+        block.size               = std::max(block.size, request.fixedOffset + request.memory.size);
+        block.alignment = std::max<uint64_t>(block.alignment, request.memory.alignment);
+        block.memoryTypeBits &= request.memory.memoryTypeBits;
+        for (uint32_t resident : residents[request.fixedBlockIndex])
+        {
+            if (requests[resident].lifetime.Overlaps(request.lifetime) &&
+                MemoryOverlaps(placement, request.memory.size, outLayout.placements[resident],
+                               requests[resident].memory.size))
+            {
+                outLayout.fixedConflicts.emplace_back(resident, i);
+            }
+        }
+        residents[request.fixedBlockIndex].push_back(i);
+    }
+
+    // largest first, then in execution order so the result does not depend on request order ties
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        const RDGTransientRequest& ra = requests[a];
+        const RDGTransientRequest& rb = requests[b];
+        if (ra.memory.size != rb.memory.size)
+        {
+            return ra.memory.size > rb.memory.size;
+        }
+        if (ra.lifetime.firstNode != rb.lifetime.firstNode)
+        {
+            return ra.lifetime.firstNode < rb.lifetime.firstNode;
+        }
+        return a < b;
+    });
+
+    HeapVector<MemoryRange> occupied;
+    for (uint32_t requestIndex : order)
+    {
+        const RDGTransientRequest& request = requests[requestIndex];
+        const uint64_t alignment           = std::max<uint64_t>(request.memory.alignment, 1);
+        RDGTransientPlacement& placement   = outLayout.placements[requestIndex];
+
+        bool placed = false;
+        for (uint32_t blockIndex = 0; blockIndex < outLayout.blocks.size() && !placed; blockIndex++)
+        {
+            RDGTransientBlock& block = outLayout.blocks[blockIndex];
+            if ((block.memoryTypeBits & request.memory.memoryTypeBits) == 0)
+            {
+                continue;
+            }
+
+            occupied.clear();
+            for (uint32_t resident : residents[blockIndex])
+            {
+                if (requests[resident].lifetime.Overlaps(request.lifetime))
+                {
+                    const uint64_t offset = outLayout.placements[resident].offset;
+                    occupied.push_back({offset, offset + requests[resident].memory.size});
+                }
+            }
+            std::sort(occupied.begin(), occupied.end(),
+                      [](const MemoryRange& a, const MemoryRange& b) { return a.begin < b.begin; });
+
+            uint64_t offset = 0;
+            if (!FindFreeOffset(occupied, request.memory.size, alignment,
+                                std::max(maxBlockSize, block.size), offset))
+            {
+                continue;
+            }
+
+            placement.blockIndex = blockIndex;
+            placement.offset     = offset;
+            block.size           = std::max(block.size, offset + request.memory.size);
+            block.alignment      = std::max(block.alignment, alignment);
+            block.memoryTypeBits &= request.memory.memoryTypeBits;
+            residents[blockIndex].push_back(requestIndex);
+            placed = true;
+        }
+
+        if (!placed)
+        {
+            placement.blockIndex = static_cast<uint32_t>(outLayout.blocks.size());
+            placement.offset     = 0;
+
+            RDGTransientBlock& block = outLayout.blocks.emplace_back();
+            block.size               = request.memory.size;
+            block.alignment          = alignment;
+            block.memoryTypeBits     = request.memory.memoryTypeBits;
+            residents.emplace_back().push_back(requestIndex);
+        }
+    }
+
+    for (const RDGTransientBlock& block : outLayout.blocks)
+    {
+        outLayout.allocatedSize += block.size;
+    }
+
+    // the latest finished request sharing memory with each one needs an aliasing barrier
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        RDGTransientPlacement& placement = outLayout.placements[i];
+        for (uint32_t j = 0; j < requests.size(); j++)
+        {
+            if (requests[j].lifetime.lastNode >= requests[i].lifetime.firstNode ||
+                !MemoryOverlaps(placement, requests[i].memory.size, outLayout.placements[j],
+                                requests[j].memory.size))
+            {
+                continue;
+            }
+            if (placement.aliasedRequest < 0 ||
+                requests[j].lifetime.lastNode >
+                    requests[placement.aliasedRequest].lifetime.lastNode)
+            {
+                placement.aliasedRequest = static_cast<int32_t>(j);
+            }
+        }
+    }
+
+    HeapVector<uint64_t> liveSizes(static_cast<uint32_t>(lastNode) + 1);
+    for (const RDGTransientRequest& request : requests)
+    {
+        for (int32_t node = request.lifetime.firstNode; node <= request.lifetime.lastNode; node++)
+        {
+            liveSizes[node] += request.memory.size;
+        }
+    }
+    for (uint64_t liveSize : liveSizes)
+    {
+        outLayout.peakLiveSize = std::max(outLayout.peakLiveSize, liveSize);
+    }
+}
+} // namespace zen::rc
@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 #include <utility>
 
 #include "Graphics/RenderCore/V2/RenderDevice.h"
+#include "Graphics/RenderCore/V2/PipelineCompiler.h"
 #include "Graphics/RHI/RHICommandList.h"
 #include "Graphics/RenderCore/V2/Renderer/RendererServer.h"
 #include "Graphics/RenderCore/V2/RenderGraph.h"
@@ -10,6 +14,7 @@
 #include "Graphics/RenderCore/V2/ShaderProgram.h"
 #include "SceneGraph/Scene.h"
 #include "Utils/Helpers.h"
+#include "Utils/JobSystem.h"
 
 
 namespace zen::rc
@@ -176,7 +181,8 @@ GraphicsPass* GraphicsPassBuilder::Build()
     // m_pGfxPass->renderPassLayout  = m_rpLayout;
 
     m_pGfxPass->pPipeline = m_pRenderDevice->GetOrCreateGfxPipeline(
-        m_PSO, pShader, m_pGfxPass->pRenderingLayout, m_specializationConstants);
+        m_PSO, pShader, m_pGfxPass->pRenderingLayout, m_specializationConstants,
+        m_asyncPipelineCompile ? &m_pGfxPass->pPipeline : nullptr);
 
     // set up resource trackers
     // build PassTextureTracker and PassBufferTracker
@@ -254,8 +260,12 @@ GraphicsPass* GraphicsPassBuilder::Build()
         m_pGfxPass->pDescriptorSets[setIndex]->Update(bindings);
     }
 
-    m_pRenderDevice->GetRHIDebug()->SetPipelineDebugName(m_pGfxPass->pPipeline,
-                                                         m_tag + "_Pipeline");
+    // async compiled pipelines stay unnamed, they may be shared by several passes anyway
+    if (m_pGfxPass->pPipeline != nullptr)
+    {
+        m_pRenderDevice->GetRHIDebug()->SetPipelineDebugName(m_pGfxPass->pPipeline,
+                                                             m_tag + "_Pipeline");
+    }
 
     m_pRenderDevice->m_gfxPasses.push_back(m_pGfxPass);
     return m_pGfxPass;
@@ -745,6 +755,17 @@ void RenderDevice::Init(RHIViewport* pMainViewport)
 
     m_pMainViewport = pMainViewport;
 
+    if (RenderConfig::GetInstance().asyncPipelineCompile)
+    {
+        m_pPipelineCompiler =
+            ZEN_NEW() PipelineCompiler(RenderConfig::GetInstance().numPipelineCompileThreads);
+    }
+
+    if (RenderConfig::GetInstance().numRecordThreads > 1)
+    {
+        m_pRecordJobSystem = ZEN_NEW() JobSystem(RenderConfig::GetInstance().numRecordThreads);
+    }
+
     m_pRendererServer = ZEN_NEW() RendererServer(this, m_pMainViewport);
     m_pRendererServer->Init();
 }
@@ -754,6 +775,20 @@ void RenderDevice::Destroy()
     FlushPendingBufferUpdates();
     m_pTextureManager->FlushPendingTextureUpdates();
 
+    if (m_pPipelineCompiler != nullptr)
+    {
+        m_pPipelineCompiler->WaitIdle();
+        PublishCompiledPipelines();
+        ZEN_DELETE(m_pPipelineCompiler);
+        m_pPipelineCompiler = nullptr;
+    }
+
+    if (m_pRecordJobSystem != nullptr)
+    {
+        ZEN_DELETE(m_pRecordJobSystem);
+        m_pRecordJobSystem = nullptr;
+    }
+
     for (auto* pViewport : m_viewports)
     {
         GDynamicRHI->DestroyViewport(pViewport);
@@ -799,6 +834,9 @@ void RenderDevice::Destroy()
         GDynamicRHI->DestroyBuffer(buffer);
     }
 
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+
     m_deletionQueue.Flush();
 
     if (m_pImmediateGraphicsCmdList != nullptr)
@@ -832,6 +870,25 @@ void RenderDevice::Destroy()
         ProcessPendingFreeResources(i);
     }
 
+    // after every transient resource is gone
+    for (auto& kv : m_transientMemory)
+    {
+        for (RHIMemoryBlock* pBlock : kv.second)
+        {
+            if (pBlock != nullptr)
+            {
+                GDynamicRHI->DestroyMemoryBlock(pBlock);
+            }
+        }
+    }
+    for (auto& kv : m_retiredTransientMemory)
+    {
+        GDynamicRHI->DestroyMemoryBlock(kv.first);
+    }
+    m_transientMemory.clear();
+    m_retiredTransientMemory.clear();
+    m_transientBindings.clear();
+
     m_graphicsCmdListPool.ForEachObject(
         [](RHICommandList* pCmdList) { pCmdList->WaitUntilCompleted(); });
     m_graphicsCmdListPool.Destroy();
@@ -846,30 +903,31 @@ void RenderDevice::ExecuteRenderGraphs(RHIViewport* pViewport, VectorView<Render
 {
     GDynamicRHI->BeginDrawingViewport(pViewport);
 
-    const size_t numRenderCmdLists = rdgs.size();
     HeapVector<RHICommandList*> cmdLists;
-    // use a dedicated cmd list to present
-    AcquireGraphicsCmdLists(numRenderCmdLists + 1, cmdLists);
+    HeapVector<RHIPlatformCommandList*> platformCmdLists;
     FlushPendingBufferUpdates();
     m_pTextureManager->FlushPendingTextureUpdates();
 
-    for (size_t i = 0; i < numRenderCmdLists; ++i)
+    for (RenderGraph* pRDG : rdgs)
     {
-        rdgs[i]->Execute(cmdLists[i]);
+        AllocateTransientMemory(*pRDG);
+        RecordRenderGraph(pRDG, cmdLists, platformCmdLists);
     }
     EndFrame();
 
-    if (numRenderCmdLists > 0)
+    if (!cmdLists.empty())
     {
-        SubmitCommandLists(MakeVecView(cmdLists.data(), numRenderCmdLists));
-        for (size_t i = 0; i < numRenderCmdLists; ++i)
+        GDynamicRHI->SubmitPlatformCommandLists(MakeVecView(platformCmdLists));
+        for (RHICommandList* pCmdList : cmdLists)
         {
-            m_graphicsCmdListPool.Release(cmdLists[i]);
+            m_graphicsCmdListPool.Release(pCmdList);
         }
     }
 
-    GDynamicRHI->EndDrawingViewport(pViewport, cmdLists[numRenderCmdLists], true);
-    m_graphicsCmdListPool.Release(cmdLists[numRenderCmdLists]);
+    // use a dedicated cmd list to present
+    RHICommandList* pPresentCmdList = m_graphicsCmdListPool.Acquire();
+    GDynamicRHI->EndDrawingViewport(pViewport, pPresentCmdList, true);
+    m_graphicsCmdListPool.Release(pPresentCmdList);
 }
 
 void RenderDevice::ExecuteRenderGraphs(VectorView<UniquePtr<RenderGraph>> rdgs)
@@ -882,16 +940,17 @@ void RenderDevice::ExecuteRenderGraphs(VectorView<UniquePtr<RenderGraph>> rdgs)
     }
 
     HeapVector<RHICommandList*> cmdLists;
-    AcquireGraphicsCmdLists(rdgs.size(), cmdLists);
+    HeapVector<RHIPlatformCommandList*> platformCmdLists;
     FlushPendingBufferUpdates();
     m_pTextureManager->FlushPendingTextureUpdates();
 
     for (size_t i = 0; i < rdgs.size(); ++i)
     {
-        rdgs[i]->Execute(cmdLists[i]);
+        AllocateTransientMemory(*rdgs[i]);
+        RecordRenderGraph(rdgs[i].Get(), cmdLists, platformCmdLists);
     }
 
-    SubmitCommandLists(MakeVecView(cmdLists));
+    GDynamicRHI->SubmitPlatformCommandLists(MakeVecView(platformCmdLists));
 
     for (RHICommandList* pCmdList : cmdLists)
     {
@@ -974,6 +1033,7 @@ RHITexture* RenderDevice::CreateTextureColorRT(const TextureFormat& texFormat,
     texInfo.samples       = texFormat.sampleCount;
     texInfo.mutableFormat = texFormat.mutableFormat;
     texInfo.tag           = std::move(texName);
+    texInfo.transient     = usageHint.transient;
     texInfo.usageFlags.SetFlags(RHITextureUsageFlagBits::eColorAttachment,
                                 RHITextureUsageFlagBits::eSampled);
 
@@ -1007,6 +1067,7 @@ RHITexture* RenderDevice::CreateTextureDepthStencilRT(const TextureFormat& texFo
     texInfo.samples       = texFormat.sampleCount;
     texInfo.mutableFormat = texFormat.mutableFormat;
     texInfo.tag           = std::move(texName);
+    texInfo.transient     = usageHint.transient;
     texInfo.usageFlags.SetFlags(RHITextureUsageFlagBits::eDepthStencilAttachment,
                                 RHITextureUsageFlagBits::eSampled);
 
@@ -1036,6 +1097,7 @@ RHITexture* RenderDevice::CreateTextureStorage(const TextureFormat& texFormat,
     texInfo.samples       = texFormat.sampleCount;
     texInfo.mutableFormat = texFormat.mutableFormat;
     texInfo.tag           = std::move(texName);
+    texInfo.transient     = usageHint.transient;
 
     texInfo.usageFlags.SetFlags(RHITextureUsageFlagBits::eStorage,
                                 RHITextureUsageFlagBits::eSampled);
@@ -1136,6 +1198,8 @@ void RenderDevice::DestroyTexture(RHITexture* pTexture)
     // }
     // textureRD->DecreaseRefCount();
     // m_textureMap.erase(textureRD->GetHandle());
+    ReleaseTransientBinding(pTexture);
+    RenderGraph::ReleaseResourceTracker(pTexture);
     m_frames[m_currentFrame].texturesPendingFree.emplace_back(pTexture);
 }
 
@@ -1305,9 +1369,96 @@ void RenderDevice::UpdateBuffer(RHIBuffer* pBuffer,
 
 void RenderDevice::DestroyBuffer(RHIBuffer* pBufferHandle)
 {
+    ReleaseTransientBinding(pBufferHandle);
+    RenderGraph::ReleaseResourceTracker(pBufferHandle);
     GDynamicRHI->DestroyBuffer(pBufferHandle);
 }
 
+void RenderDevice::AllocateTransientMemory(const RenderGraph& rdg)
+{
+    const RDGTransientLayout& layout          = rdg.GetTransientLayout();
+    const HeapVector<RHIResource*>& resources = rdg.GetTransientResources();
+    std::vector<RHIMemoryBlock*>& blocks      = m_transientMemory[rdg.GetTag()];
+    for (uint32_t i = 0; i < resources.size(); i++)
+    {
+        RHIResource* pResource                 = resources[i];
+        const RDGTransientPlacement& placement = layout.placements[i];
+
+        // the graph keeps bound resources at their placement
+        auto iter = m_transientBindings.find(pResource);
+        if (iter != m_transientBindings.end())
+        {
+            VERIFY_EXPR_MSG_F(iter->second.blockIndex == placement.blockIndex &&
+                                  iter->second.offset == placement.offset,
+                              "transient resource {} of RenderGraph '{}' moved",
+                              pResource->GetResourceTag(), rdg.GetTag());
+            continue;
+        }
+
+        const RDGTransientBlock& blockLayout = layout.blocks[placement.blockIndex];
+        if (placement.blockIndex >= blocks.size())
+        {
+            blocks.resize(placement.blockIndex + 1, nullptr);
+        }
+        RHIMemoryBlock*& pBlock = blocks[placement.blockIndex];
+        if (pBlock == nullptr || pBlock->GetRequirements().size < blockLayout.size)
+        {
+            // resources bound to a smaller block keep it alive until they are destroyed
+            if (pBlock != nullptr)
+            {
+                uint32_t numBound = 0;
+                for (auto& kv : m_transientBindings)
+                {
+                    numBound += kv.second.pBlock == pBlock ? 1 : 0;
+                }
+                if (numBound > 0)
+                {
+                    m_retiredTransientMemory[pBlock] = numBound;
+                }
+                else
+                {
+                    m_frames[m_currentFrame].memoryBlocksPendingFree.push_back(pBlock);
+                }
+            }
+            RHIMemoryRequirements requirements{};
+            requirements.size           = blockLayout.size;
+            requirements.alignment      = blockLayout.alignment;
+            requirements.memoryTypeBits = blockLayout.memoryTypeBits;
+            pBlock                      = GDynamicRHI->CreateMemoryBlock(requirements);
+        }
+
+        RHITexture* pTexture = dynamic_cast<RHITexture*>(pResource);
+        if (pTexture != nullptr)
+        {
+            GDynamicRHI->BindTextureMemory(pTexture, pBlock, placement.offset);
+        }
+        else
+        {
+            GDynamicRHI->BindBufferMemory(dynamic_cast<RHIBuffer*>(pResource), pBlock,
+                                          placement.offset);
+        }
+        m_transientBindings[pResource] = {placement.blockIndex, placement.offset, pBlock};
+    }
+}
+
+void RenderDevice::ReleaseTransientBinding(RHIResource* pResource)
+{
+    auto iter = m_transientBindings.find(pResource);
+    if (iter == m_transientBindings.end())
+    {
+        return;
+    }
+    RHIMemoryBlock* pBlock = iter->second.pBlock;
+    m_transientBindings.erase(iter);
+
+    auto retiredIter = m_retiredTransientMemory.find(pBlock);
+    if (retiredIter != m_retiredTransientMemory.end() && --retiredIter->second == 0)
+    {
+        m_retiredTransientMemory.erase(retiredIter);
+        m_frames[m_currentFrame].memoryBlocksPendingFree.push_back(pBlock);
+    }
+}
+
 // RenderPassHandle RenderDevice::GetOrCreateRenderPass(const RHIRenderPassLayout& layout)
 // {
 //     auto hash = CalcRenderPassLayoutHash(layout);
@@ -1344,7 +1495,8 @@ RHIPipeline* RenderDevice::GetOrCreateGfxPipeline(
     RHIGfxPipelineStates& PSO,
     RHIShader* pShader,
     const RHIRenderingLayout* pRenderingLayout,
-    const HashMap<uint32_t, int>& specializationConstants)
+    const HashMap<uint32_t, int>& specializationConstants,
+    RHIPipeline** ppAsyncTarget)
 {
     RHIGfxPipelineCreateInfo createInfo{};
     createInfo.pShader          = pShader;
@@ -1352,11 +1504,30 @@ RHIPipeline* RenderDevice::GetOrCreateGfxPipeline(
     createInfo.pRenderingLayout = pRenderingLayout;
     createInfo.subpassIdx       = 0;
 
-    auto hash = CalcGfxPipelineHash(PSO, pShader, specializationConstants);
+    std::vector<uint32_t> desc;
+    BuildGfxPipelineDesc(PSO, pShader->GetHash32(), pRenderingLayout, specializationConstants,
+                         desc);
+    const size_t hash = CalcPipelineHash(desc);
+    CheckPipelineDesc(hash, desc);
     if (!m_pipelineCache.contains(hash))
     {
-        // create new one
-        m_pipelineCache[hash] = GDynamicRHI->CreatePipeline(createInfo);
+        if (m_pPipelineCompiler == nullptr)
+        {
+            // create new one
+            m_pipelineCache[hash] = GDynamicRHI->CreatePipeline(createInfo);
+        }
+        else
+        {
+            // one compile per hash, also when a worker is already busy with it
+            m_pPipelineCompiler->RequestGfxPipeline(hash, createInfo, ppAsyncTarget);
+            if (ppAsyncTarget != nullptr)
+            {
+                return nullptr;
+            }
+            // only this pipeline, not every compile the async requests queued up
+            m_pPipelineCompiler->Wait(hash);
+            PublishCompiledPipelines();
+        }
     }
     return m_pipelineCache[hash];
 }
@@ -1366,7 +1537,10 @@ RHIPipeline* RenderDevice::GetOrCreateComputePipeline(RHIShader* pShader)
     RHIComputePipelineCreateInfo createInfo{};
     createInfo.pShader = pShader;
 
-    auto hash = CalcComputePipelineHash(pShader);
+    std::vector<uint32_t> desc;
+    BuildComputePipelineDesc(pShader->GetHash32(), desc);
+    const size_t hash = CalcPipelineHash(desc);
+    CheckPipelineDesc(hash, desc);
     if (!m_pipelineCache.contains(hash))
     {
         m_pipelineCache[hash] = GDynamicRHI->CreatePipeline(createInfo);
@@ -1652,10 +1826,25 @@ void RenderDevice::NextFrame()
     FlushPendingBufferUpdates();
     m_pTextureManager->FlushPendingTextureUpdates();
     ProcessPendingFreeResources(m_currentFrame);
+    PublishCompiledPipelines();
     m_currentFrame = (m_currentFrame + 1) % m_frames.size();
     BeginFrame();
 }
 
+void RenderDevice::PublishCompiledPipelines()
+{
+    if (m_pPipelineCompiler == nullptr)
+    {
+        return;
+    }
+    std::vector<PipelineCompiler::CompiledPipeline> compiled;
+    m_pPipelineCompiler->PublishCompleted(compiled);
+    for (const PipelineCompiler::CompiledPipeline& entry : compiled)
+    {
+        m_pipelineCache[entry.hash] = entry.pPipeline;
+    }
+}
+
 void RenderDevice::BeginFrame()
 {
     m_framesCounter++;
@@ -1693,6 +1882,32 @@ void RenderDevice::AcquireGraphicsCmdLists(size_t numCmdLists,
     }
 }
 
+void RenderDevice::RecordRenderGraph(RenderGraph* pRDG,
+                                     HeapVector<RHICommandList*>& outCmdLists,
+                                     HeapVector<RHIPlatformCommandList*>& outPlatformCmdLists)
+{
+    size_t numSegments = 1;
+    if (m_pRecordJobSystem != nullptr)
+    {
+        numSegments = std::min<size_t>(RenderConfig::GetInstance().numRecordThreads,
+                                       pRDG->GetCompiledNodes().size());
+        numSegments = std::max<size_t>(numSegments, 1);
+    }
+
+    const size_t firstCmdList = outCmdLists.size();
+    AcquireGraphicsCmdLists(numSegments, outCmdLists);
+    HeapVector<RHIPlatformCommandList*> platformCmdLists;
+    pRDG->Execute(MakeVecView(outCmdLists.data() + firstCmdList, numSegments), m_pRecordJobSystem,
+                  &platformCmdLists);
+    for (RHIPlatformCommandList* pPlatformCmdList : platformCmdLists)
+    {
+        if (pPlatformCmdList != nullptr)
+        {
+            outPlatformCmdLists.push_back(pPlatformCmdList);
+        }
+    }
+}
+
 void RenderDevice::SubmitCommandLists(VectorView<RHICommandList*> cmdLists)
 {
     HeapVector<RHIPlatformCommandList*> platformCommandLists;
@@ -1707,6 +1922,13 @@ void RenderDevice::ProcessPendingFreeResources(uint32_t frameIndex)
         pTexture->ReleaseReference();
     }
     m_frames[frameIndex].texturesPendingFree.clear();
+
+    // after the resources bound to them
+    for (RHIMemoryBlock* pBlock : m_frames[frameIndex].memoryBlocksPendingFree)
+    {
+        GDynamicRHI->DestroyMemoryBlock(pBlock);
+    }
+    m_frames[frameIndex].memoryBlocksPendingFree.clear();
 }
 
 // todo: consider attachment size when calculating hash
@@ -1773,68 +1995,201 @@ size_t RenderDevice::CalcRenderPassLayoutHash(const RHIRenderPassLayout& layout)
 //     return seed;
 // }
 
-// size_t RenderDevice::CalcGfxPipelineHash(const RHIGfxPipelineStates& pso,
-//                                          RHIShader* shader,
-//                                          const RenderPassHandle& renderPass,
-//                                          const HashMap<uint32_t, int>& specializationConstants)
-// {
-//     std::size_t seed = 0;
-//     // Hashing utility
-//     auto combineHash = [&seed](auto&& value) {
-//         seed ^= std::hash<std::decay_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) +
-//             (seed >> 2);
-//     };
-//     combineHash(shader->GetHash32());
-//     combineHash(renderPass.value);
-//     combineHash(pso.primitiveType);
-//     for (auto& kv : specializationConstants)
-//     {
-//         combineHash(kv.first);
-//         combineHash(kv.second);
-//     }
-//     return seed;
-// }
+namespace
+{
+// leading word of a pipeline description, keeps graphics and compute keys apart
+constexpr uint32_t cGfxPipelineDescTag     = 0x50584647; // "GFXP"
+constexpr uint32_t cComputePipelineDescTag = 0x504D4F43; // "COMP"
 
-size_t RenderDevice::CalcGfxPipelineHash(const RHIGfxPipelineStates& pso,
-                                         RHIShader* pShader,
-                                         // const RHIRenderPassLayout& renderPassLayout,
-                                         const HashMap<uint32_t, int>& specializationConstants)
+class PipelineDescWriter
 {
-    std::size_t seed = 0;
-    // Hashing utility
-    auto combineHash = [&seed](auto&& value) {
-        seed ^= std::hash<std::decay_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) +
-            (seed >> 2);
-    };
-    combineHash(pShader->GetHash32());
-    // for (uint32_t i = 0; i < renderPassLayout.GetNumRenderTargets(); i++)
-    // for (auto& colorRT : renderPassLayout.GetColorRenderTargets())
-    // {
-    //     combineHash(colorRT.texture);
-    // }
-    // if (renderPassLayout.HasDepthStencilRenderTarget())
-    // {
-    //     combineHash(renderPassLayout.GetDepthStencilRenderTarget().texture);
-    // }
-    combineHash(pso.primitiveType);
-    for (auto& kv : specializationConstants)
+public:
+    explicit PipelineDescWriter(std::vector<uint32_t>& desc) : m_desc(desc) {}
+
+    template <typename T> void Write(T value)
     {
-        combineHash(kv.first);
-        combineHash(kv.second);
+        if constexpr (std::is_enum_v<T>)
+        {
+            m_desc.push_back(static_cast<uint32_t>(ToUnderlying(value)));
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            // bit pattern, -0.0f and 0.0f stay distinct like they do for the driver
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            m_desc.push_back(bits);
+        }
+        else if constexpr (sizeof(T) == sizeof(uint64_t))
+        {
+            const uint64_t bits = static_cast<uint64_t>(value);
+            m_desc.push_back(static_cast<uint32_t>(bits));
+            m_desc.push_back(static_cast<uint32_t>(bits >> 32));
+        }
+        else
+        {
+            m_desc.push_back(static_cast<uint32_t>(value));
+        }
+    }
+
+    void Write(const RHIStencilOpState& op)
+    {
+        Write(op.fail);
+        Write(op.pass);
+        Write(op.depthFail);
+        Write(op.compare);
+        Write(op.compareMask);
+        Write(op.writeMask);
+        Write(op.reference);
+    }
+
+    void Write(const RHIRenderTarget& rt)
+    {
+        // load and store ops are left out, render passes that differ only in those are
+        // compatible and share pipelines
+        Write(rt.format);
+        Write(rt.numSamples);
+    }
+
+private:
+    std::vector<uint32_t>& m_desc;
+};
+} // namespace
+
+void RenderDevice::BuildGfxPipelineDesc(const RHIGfxPipelineStates& pso,
+                                        uint32_t shaderHash,
+                                        const RHIRenderingLayout* pRenderingLayout,
+                                        const HashMap<uint32_t, int>& specializationConstants,
+                                        std::vector<uint32_t>& outDesc)
+{
+    outDesc.clear();
+    PipelineDescWriter writer(outDesc);
+    writer.Write(cGfxPipelineDescTag);
+    writer.Write(shaderHash);
+    writer.Write(pso.primitiveType);
+
+    const RHIGfxPipelineRasterizationState& rs = pso.rasterizationState;
+    writer.Write(rs.enableDepthClamp);
+    writer.Write(rs.discardPrimitives);
+    writer.Write(rs.wireframe);
+    writer.Write(rs.cullMode);
+    writer.Write(rs.frontFace);
+    writer.Write(rs.enableDepthBias);
+    writer.Write(rs.depthBiasConstantFactor);
+    writer.Write(rs.depthBiasClamp);
+    writer.Write(rs.depthBiasSlopeFactor);
+    writer.Write(rs.lineWidth);
+
+    const RHIGfxPipelineMultiSampleState& ms = pso.multiSampleState;
+    writer.Write(ms.sampleCount);
+    writer.Write(ms.enableSampleShading);
+    writer.Write(ms.minSampleShading);
+    writer.Write(ms.enableAlphaToCoverage);
+    writer.Write(ms.enableAlphaToOne);
+    writer.Write(ms.sampleMasks);
+
+    const RHIGfxPipelineDepthStencilState& ds = pso.depthStencilState;
+    writer.Write(ds.enableDepthTest);
+    writer.Write(ds.enableDepthWrite);
+    writer.Write(ds.depthCompareOp);
+    writer.Write(ds.enableDepthBoundsTest);
+    writer.Write(ds.enableStencilTest);
+    writer.Write(ds.frontOp);
+    writer.Write(ds.backOp);
+    writer.Write(ds.minDepthBounds);
+    writer.Write(ds.maxDepthBounds);
+
+    const RHIGfxPipelineColorBlendState& cb = pso.colorBlendState;
+    writer.Write(cb.enableLogicOp);
+    writer.Write(cb.logicOp);
+    writer.Write(cb.attachmentsMask.Raw());
+    // unused attachment slots keep whatever was there, only the enabled ones reach the driver
+    for (uint32_t i = 0; i < MAX_NUM_COLOR_ATTACHMENTS; i++)
+    {
+        if (!cb.attachmentsMask.Test(i))
+        {
+            continue;
+        }
+        const RHIGfxPipelineColorBlendState::Attachment& attachment = cb.attachments[i];
+        writer.Write(attachment.enableBlend);
+        writer.Write(attachment.srcColorBlendFactor);
+        writer.Write(attachment.dstColorBlendFactor);
+        writer.Write(attachment.colorBlendOp);
+        writer.Write(attachment.srcAlphaBlendFactor);
+        writer.Write(attachment.dstAlphaBlendFactor);
+        writer.Write(attachment.alphaBlendOp);
+        writer.Write(static_cast<int64_t>(attachment.colorWriteMask));
+    }
+    writer.Write(cb.blendConstants.r);
+    writer.Write(cb.blendConstants.g);
+    writer.Write(cb.blendConstants.b);
+    writer.Write(cb.blendConstants.a);
+
+    writer.Write(pso.dynamicStates.enabledStates.Raw());
+
+    if (pRenderingLayout != nullptr)
+    {
+        writer.Write(pRenderingLayout->numLayers);
+        writer.Write(pRenderingLayout->numColorRenderTargets);
+        for (uint32_t i = 0; i < pRenderingLayout->numColorRenderTargets; i++)
+        {
+            writer.Write(pRenderingLayout->colorRenderTargets[i]);
+        }
+        writer.Write(pRenderingLayout->hasDepthStencilRT);
+        if (pRenderingLayout->hasDepthStencilRT)
+        {
+            writer.Write(pRenderingLayout->depthStencilRenderTarget);
+        }
+    }
+    else
+    {
+        writer.Write(0u);
+    }
+
+    // HashMap iteration order depends on insertion history, sort by constant id
+    std::vector<std::pair<uint32_t, int>> specConstants;
+    specConstants.reserve(specializationConstants.size());
+    for (const auto& kv : specializationConstants)
+    {
+        specConstants.emplace_back(kv.first, kv.second);
+    }
+    std::sort(specConstants.begin(), specConstants.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    writer.Write(static_cast<uint32_t>(specConstants.size()));
+    for (const auto& kv : specConstants)
+    {
+        writer.Write(kv.first);
+        writer.Write(kv.second);
     }
-    return seed;
 }
 
-size_t RenderDevice::CalcComputePipelineHash(RHIShader* pShader)
+void RenderDevice::BuildComputePipelineDesc(uint32_t shaderHash, std::vector<uint32_t>& outDesc)
 {
-    std::size_t seed = 0;
-    // Hashing utility
-    auto combineHash = [&seed](auto&& value) {
-        seed ^= std::hash<std::decay_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) +
-            (seed >> 2);
-    };
-    combineHash(pShader->GetHash32());
-    return seed;
+    outDesc.clear();
+    outDesc.push_back(cComputePipelineDescTag);
+    outDesc.push_back(shaderHash);
+}
+
+size_t RenderDevice::CalcPipelineHash(const std::vector<uint32_t>& desc)
+{
+    return static_cast<size_t>(util::HashBytes64(desc.data(), desc.size() * sizeof(uint32_t)));
+}
+
+void RenderDevice::CheckPipelineDesc(size_t hash, const std::vector<uint32_t>& desc)
+{
+#if defined(ZEN_DEBUG)
+    auto it = m_pipelineDescs.find(hash);
+    if (it == m_pipelineDescs.end())
+    {
+        m_pipelineDescs[hash] = desc;
+        return;
+    }
+    VERIFY_EXPR_MSG_F(it->second == desc,
+                      "pipeline hash collision on {:#x}, different states share one cache entry",
+                      hash);
+#else
+    (void)hash;
+    (void)desc;
+#endif
 }
 
 size_t RenderDevice::CalcSamplerHash(const RHISamplerCreateInfo& info)
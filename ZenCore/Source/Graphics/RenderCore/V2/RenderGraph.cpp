@@ -1,7 +1,10 @@
 #include "Graphics/RenderCore/V2/RenderGraph.h"
 #include "Graphics/RenderCore/V2/RenderResource.h"
 #include "Graphics/RHI/RHICommandList.h"
+#include "Graphics/RHI/DynamicRHI.h"
 #include "Graphics/RenderCore/V2/ShaderProgram.h"
+#include "Utils/Helpers.h"
+#include "Utils/JobSystem.h"
 
 #ifdef ZEN_WIN32
 #    include <queue>
@@ -9,6 +12,7 @@
 namespace zen::rc
 {
 RDGResourceTrackerPool RenderGraph::s_trackerPool;
+RDGCompiledPlanCache RenderGraph::s_compiledPlanCache;
 
 namespace
 {
@@ -66,8 +70,186 @@ bool AccessNeedsBarrier(const RDGResource* pResource,
 
     return true;
 }
+
+bool HasPrologueTransitions(const RDGCompiledNode& compiledNode)
+{
+    return !compiledNode.initialResourceAccesses.empty() ||
+        !compiledNode.prologueBufferTransitions.empty() ||
+        !compiledNode.prologueTextureTransitions.empty();
+}
+
+// moves the prologue transitions of the node at position whose source is far enough ahead to
+// outSplitTransitions, outSplitSource collects their sources
+template <class Transition>
+void SplitDistantTransitions(uint32_t position,
+                             HeapVector<Transition>& transitions,
+                             HeapVector<RDG_ID>& resourceIds,
+                             HeapVector<RDGTransitionSource>& sources,
+                             HeapVector<Transition>& outSplitTransitions,
+                             RDGTransitionSource& outSplitSource)
+{
+    const int32_t minDistance   = static_cast<int32_t>(RenderGraph::cSplitBarrierMinDistance);
+    const int32_t maxSourceNode = static_cast<int32_t>(position) - minDistance;
+    uint32_t numKept = 0;
+    for (uint32_t i = 0; i < transitions.size(); i++)
+    {
+        const RDGTransitionSource& source = sources[i];
+        if (source.node >= 0 && source.node <= maxSourceNode)
+        {
+            outSplitTransitions.push_back(transitions[i]);
+            outSplitSource.node = std::max(outSplitSource.node, source.node);
+            outSplitSource.stages.SetFlag(source.stages);
+            continue;
+        }
+        transitions[numKept] = transitions[i];
+        resourceIds[numKept] = resourceIds[i];
+        sources[numKept]     = source;
+        numKept++;
+    }
+    transitions.resize(numKept);
+    resourceIds.resize(numKept);
+    sources.resize(numKept);
+}
+
+void AppendKey64(std::vector<uint32_t>& key, int64_t value)
+{
+    key.push_back(static_cast<uint32_t>(value));
+    key.push_back(static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32));
+}
+
+void AppendAccessKey(std::vector<uint32_t>& key, const RDGAccess& access)
+{
+    key.push_back(static_cast<uint32_t>(access.accessMode));
+    key.push_back(static_cast<uint32_t>(static_cast<int32_t>(access.nodeId)));
+    key.push_back(static_cast<uint32_t>(static_cast<int32_t>(access.resourceId)));
+    key.push_back(ToUnderlying(access.bufferUsage));
+    key.push_back(ToUnderlying(access.textureUsage));
+    AppendKey64(key, static_cast<int64_t>(access.accessFlags));
+    AppendKey64(key, static_cast<int64_t>(access.textureSubResourceRange.aspect));
+    key.push_back(access.textureSubResourceRange.baseMipLevel);
+    key.push_back(access.textureSubResourceRange.levelCount);
+    key.push_back(access.textureSubResourceRange.baseArrayLayer);
+    key.push_back(access.textureSubResourceRange.layerCount);
+}
+
+void CopySortedNodes(const HeapVector<HeapVector<RDG_ID>>& src, HeapVector<HeapVector<RDG_ID>>& dst)
+{
+    dst.clear();
+    dst.reserve(src.size());
+    for (const HeapVector<RDG_ID>& level : src)
+    {
+        dst.emplace_back().push_back(level);
+    }
+}
+
+void CopyCompiledNodes(const HeapVector<RDGCompiledNode>& src, HeapVector<RDGCompiledNode>& dst)
+{
+    dst.clear();
+    dst.reserve(src.size());
+    for (const RDGCompiledNode& srcNode : src)
+    {
+        RDGCompiledNode& dstNode  = dst.emplace_back();
+        dstNode.nodeId            = srcNode.nodeId;
+        dstNode.level             = srcNode.level;
+        dstNode.prologueSrcStages = srcNode.prologueSrcStages;
+        dstNode.prologueDstStages = srcNode.prologueDstStages;
+        dstNode.initialResourceAccesses.push_back(srcNode.initialResourceAccesses);
+        dstNode.prologueBufferTransitions.push_back(srcNode.prologueBufferTransitions);
+        dstNode.prologueTextureTransitions.push_back(srcNode.prologueTextureTransitions);
+        dstNode.prologueBufferResourceIds.push_back(srcNode.prologueBufferResourceIds);
+        dstNode.prologueTextureResourceIds.push_back(srcNode.prologueTextureResourceIds);
+        dstNode.prologueBufferSources.push_back(srcNode.prologueBufferSources);
+        dstNode.prologueTextureSources.push_back(srcNode.prologueTextureSources);
+    }
+}
 } // namespace
 
+RDGCompiledPlanCache::~RDGCompiledPlanCache()
+{
+    Clear();
+}
+
+bool RDGCompiledPlanCache::Restore(uint64_t hash,
+                                   const std::vector<uint32_t>& structureKey,
+                                   HeapVector<HeapVector<RDG_ID>>& outSortedNodes,
+                                   HeapVector<RDGCompiledNode>& outCompiledNodes,
+                                   RDGCompileStats& outStats)
+{
+    LockAuto lock(&m_mutex);
+    auto iter = m_plans.find(hash);
+    if (iter == m_plans.end() || iter->second->structureKey != structureKey)
+    {
+        m_numMisses++;
+        return false;
+    }
+
+    const Plan* pPlan = iter->second;
+    CopySortedNodes(pPlan->sortedNodes, outSortedNodes);
+    CopyCompiledNodes(pPlan->compiledNodes, outCompiledNodes);
+    outStats = pPlan->stats;
+    m_numHits++;
+    return true;
+}
+
+void RDGCompiledPlanCache::Store(uint64_t hash,
+                                 std::vector<uint32_t>&& structureKey,
+                                 const HeapVector<HeapVector<RDG_ID>>& sortedNodes,
+                                 const HeapVector<RDGCompiledNode>& compiledNodes,
+                                 const RDGCompileStats& stats)
+{
+    LockAuto lock(&m_mutex);
+    auto iter = m_plans.find(hash);
+    Plan* pPlan;
+    if (iter != m_plans.end())
+    {
+        // same hash but a different structure, the newer graph wins
+        pPlan = iter->second;
+    }
+    else
+    {
+        if (m_plans.size() >= cMaxPlans)
+        {
+            // graph structures keep changing, start over instead of tracking usage
+            for (auto& kv : m_plans)
+            {
+                delete kv.second;
+            }
+            m_plans.clear();
+        }
+        pPlan         = new Plan();
+        m_plans[hash] = pPlan;
+    }
+
+    pPlan->structureKey = std::move(structureKey);
+    CopySortedNodes(sortedNodes, pPlan->sortedNodes);
+    CopyCompiledNodes(compiledNodes, pPlan->compiledNodes);
+    pPlan->stats = stats;
+    // don't keep physical resources of this graph alive in the plan
+    for (RDGCompiledNode& compiledNode : pPlan->compiledNodes)
+    {
+        for (RHIBufferTransition& transition : compiledNode.prologueBufferTransitions)
+        {
+            transition.pBuffer = nullptr;
+        }
+        for (RHITextureTransition& transition : compiledNode.prologueTextureTransitions)
+        {
+            transition.pTexture = nullptr;
+        }
+    }
+}
+
+void RDGCompiledPlanCache::Clear()
+{
+    LockAuto lock(&m_mutex);
+    for (auto& kv : m_plans)
+    {
+        delete kv.second;
+    }
+    // release the table as well, the cache is cleared on shutdown
+    HashMap<uint64_t, Plan*> emptyPlans;
+    m_plans.swap(emptyPlans);
+}
+
 RDGResourceTrackerPool::RDGResourceTrackerPool() = default;
 
 RDGResourceTrackerPool::~RDGResourceTrackerPool()
@@ -78,6 +260,26 @@ RDGResourceTrackerPool::~RDGResourceTrackerPool()
     }
 }
 
+void RDGResourceTrackerPool::Clear()
+{
+    for (auto& kv : m_trackerMap)
+    {
+        delete kv.second;
+    }
+    HashMap<const RHIResource*, RDGResourceTracker*> emptyTrackers;
+    m_trackerMap.swap(emptyTrackers);
+}
+
+void RDGResourceTrackerPool::RemoveTracker(const RHIResource* pResource)
+{
+    auto iter = m_trackerMap.find(pResource);
+    if (iter != m_trackerMap.end())
+    {
+        delete iter->second;
+        m_trackerMap.erase(iter);
+    }
+}
+
 RDGResourceTracker* RDGResourceTrackerPool::GetTracker(const RHIResource* pResource)
 {
     if (!m_trackerMap.contains(pResource))
@@ -112,11 +314,11 @@ void RDGResourceTrackerPool::UpdateTrackerState(const RHIBuffer* pBuffer,
 }
 
 void RenderGraph::AddPassBindPipelineNode(RDGPassNode* pParent,
-                                          RHIPipeline* pPipelineHandle,
+                                          RHIPipeline* const* ppPipeline,
                                           RHIPipelineType pipelineType)
 {
     auto* pNode         = AllocPassChildNode<RDGBindPipelineNode>(pParent);
-    pNode->pPipeline    = std::move(pPipelineHandle);
+    pNode->ppPipeline   = ppPipeline;
     pNode->pipelineType = pipelineType;
     pNode->type         = RDGPassCmdType::eBindPipeline;
 }
@@ -155,7 +357,7 @@ RDGPassNode* RenderGraph::AddComputePassNode(const ComputePass* pComputePass, st
             }
         }
     }
-    AddPassBindPipelineNode(pNode, pComputePass->pPipeline, RHIPipelineType::eCompute);
+    AddPassBindPipelineNode(pNode, &pComputePass->pPipeline, RHIPipelineType::eCompute);
     return pNode;
 }
 
@@ -258,7 +460,7 @@ RDGPassNode* RenderGraph::AddGraphicsPassNode(const GraphicsPass* pGfxPass, std:
             pNode, depthStencilRT.pTexture, RHITextureUsage::eDepthStencilAttachment,
             depthStencilRT.pTexture->GetSubResourceRange(), RHIAccessMode::eReadWrite);
     }
-    AddPassBindPipelineNode(pNode, pGfxPass->pPipeline, RHIPipelineType::eGraphics);
+    AddPassBindPipelineNode(pNode, &pGfxPass->pPipeline, RHIPipelineType::eGraphics);
     for (uint32_t i = 0; i < pGfxPass->numDescriptorSets; i++)
     {
         auto& setTrackers = pGfxPass->resourceTrackers[i];
@@ -423,6 +625,30 @@ void RenderGraph::AddGraphicsPassDrawIndexedIndirectNode(RDGPassNode* pParent,
                                RHIAccessMode::eRead);
 }
 
+void RenderGraph::AddGraphicsPassDrawIndexedIndirectCountNode(RDGPassNode* pParent,
+                                                              RHIBuffer* pIndirectBuffer,
+                                                              uint32_t offset,
+                                                              RHIBuffer* pCountBuffer,
+                                                              uint32_t countBufferOffset,
+                                                              uint32_t maxDrawCount,
+                                                              uint32_t stride)
+{
+    auto* pNode              = AllocPassChildNode<RDGDrawIndexedIndirectCountNode>(pParent);
+    pNode->type              = RDGPassCmdType::eDrawIndexedIndirectCount;
+    pNode->pIndirectBuffer   = pIndirectBuffer;
+    pNode->pCountBuffer      = pCountBuffer;
+    pNode->offset            = offset;
+    pNode->countBufferOffset = countBufferOffset;
+    pNode->maxDrawCount      = maxDrawCount;
+    pNode->stride            = stride;
+    pNode->pParent->selfStages.SetFlags(RHIPipelineStageBits::eDrawIndirect);
+
+    DeclareBufferAccessForPass(pParent, pIndirectBuffer, RHIBufferUsage::eIndirectBuffer,
+                               RHIAccessMode::eRead);
+    DeclareBufferAccessForPass(pParent, pCountBuffer, RHIBufferUsage::eIndirectBuffer,
+                               RHIAccessMode::eRead);
+}
+
 void RenderGraph::AddGraphicsPassSetBlendConstantNode(RDGPassNode* pParent, const Color& color)
 {
     auto* pNode  = AllocPassChildNode<RDGSetBlendConstantsNode>(pParent);
@@ -809,6 +1035,24 @@ void RenderGraph::AddTextureMipmapGenNode(RHITexture* pTexture)
     AddResourceAccess(pResource, writeAccess);
 }
 
+void RenderGraph::ExportTexture(RHITexture* pTexture)
+{
+    RDGResource* pResource = GetOrAllocResource(pTexture, RDGResourceType::eTexture);
+    pResource->tag         = pTexture->GetResourceTag();
+    pResource->exported    = true;
+}
+
+void RenderGraph::ExportBuffer(RHIBuffer* pBuffer)
+{
+    RDGResource* pResource = GetOrAllocResource(pBuffer, RDGResourceType::eBuffer);
+    pResource->exported    = true;
+}
+
+void RenderGraph::ExportViewport(RHIViewport* pViewport)
+{
+    ExportTexture(pViewport->GetColorBackBuffer());
+}
+
 void RenderGraph::DeclareTextureAccessForPass(const RDGPassNode* pPassNode,
                                               RHITexture* pTexture,
                                               RHITextureUsage usage,
@@ -927,6 +1171,136 @@ bool RenderGraph::AddNodeDepsForResource(RDGResource* pResource,
     return addInDegree;
 }
 
+void RenderGraph::CullNodes()
+{
+    m_culledNodes.clear();
+    bool hasOutputs = false;
+    for (const RDGResource* pResource : m_resources)
+    {
+        hasOutputs |= pResource->exported;
+    }
+    if (!hasOutputs)
+    {
+        return;
+    }
+
+    // every write starts a version of its resource that is read by the accesses up to the next
+    // write. Writes may keep part of the previous contents, so they read the previous version too
+    struct Version
+    {
+        RDG_ID producer;
+        uint32_t refCount;
+    };
+    HeapVector<Version> versions;
+    // versions produced by each node that are still referenced
+    HeapVector<uint32_t> nodeRefCounts(m_nodeCount);
+    HashMap<RDG_ID, HeapVector<uint32_t>> nodeReadVersions;
+    for (const RDGResource* pResource : m_resources)
+    {
+        int32_t currentVersion = -1;
+        for (const RDGAccess& access : pResource->accesses)
+        {
+            if (currentVersion >= 0 && versions[currentVersion].producer != access.nodeId)
+            {
+                versions[currentVersion].refCount++;
+                nodeReadVersions[access.nodeId].push_back(currentVersion);
+            }
+            if (access.accessMode == RHIAccessMode::eReadWrite)
+            {
+                currentVersion = static_cast<int32_t>(versions.size());
+                versions.push_back({access.nodeId, 0});
+                nodeRefCounts[access.nodeId]++;
+            }
+        }
+        // the last contents of an output are used after the graph
+        if (pResource->exported && currentVersion >= 0)
+        {
+            versions[currentVersion].refCount++;
+        }
+    }
+
+    m_culledNodes.resize(m_nodeCount);
+    HeapVector<uint32_t> unusedVersions;
+    auto cullNode = [&](RDG_ID nodeId) {
+        m_culledNodes[nodeId] = 1;
+        auto iter = nodeReadVersions.find(nodeId);
+        if (iter == nodeReadVersions.end())
+        {
+            return;
+        }
+        for (uint32_t version : iter->second)
+        {
+            if (--versions[version].refCount == 0)
+            {
+                unusedVersions.push_back(version);
+            }
+        }
+    };
+    for (uint32_t version = 0; version < versions.size(); version++)
+    {
+        if (versions[version].refCount == 0)
+        {
+            unusedVersions.push_back(version);
+        }
+    }
+    // nodes without writes have no effect
+    for (uint32_t nodeId = 0; nodeId < m_nodeCount; nodeId++)
+    {
+        if (nodeRefCounts[nodeId] == 0)
+        {
+            cullNode(static_cast<int32_t>(nodeId));
+        }
+    }
+    while (!unusedVersions.empty())
+    {
+        const RDG_ID producer = versions[unusedVersions.back()].producer;
+        unusedVersions.pop_back();
+        if (--nodeRefCounts[producer] == 0)
+        {
+            cullNode(producer);
+        }
+    }
+
+    for (uint32_t nodeId = 0; nodeId < m_nodeCount; nodeId++)
+    {
+        if (m_culledNodes[nodeId] == 0)
+        {
+            continue;
+        }
+
+        m_nodeAccessMap.erase(static_cast<int32_t>(nodeId));
+        m_compileStats.culledNodeCount++;
+        const RDGNodeType type = GetNodeBaseById(static_cast<int32_t>(nodeId))->type;
+        if (type == RDGNodeType::eGraphicsPass || type == RDGNodeType::eComputePass)
+        {
+            m_compileStats.culledPassCount++;
+        }
+    }
+    if (m_compileStats.culledNodeCount == 0)
+    {
+        return;
+    }
+
+    // the dependency sort and the barriers only see the accesses of the remaining nodes
+    HeapVector<RDGAccess> accesses;
+    for (RDGResource* pResource : m_resources)
+    {
+        accesses.clear();
+        for (const RDGAccess& access : pResource->accesses)
+        {
+            accesses.push_back(access);
+        }
+        pResource->accesses.clear();
+        for (const RDGAccess& access : accesses)
+        {
+            if (!IsNodeCulled(access.nodeId))
+            {
+                pResource->accesses.push_back(access);
+            }
+        }
+    }
+}
+
 void RenderGraph::SortNodesV2()
 {
     m_sortedNodes.clear();
@@ -1025,7 +1399,7 @@ void RenderGraph::SortNodesV2()
     std::queue<RDG_ID> queue;
     for (auto id = 0; id < inDegrees.size(); id++)
     {
-        if (inDegrees[id] == 0)
+        if (inDegrees[id] == 0 && !IsNodeCulled(id))
         {
             queue.emplace(id);
         }
@@ -1061,10 +1435,11 @@ void RenderGraph::SortNodesV2()
         m_sortedNodes.push_back(std::move(currentLevel));
     }
 
-    if (sortedCount != m_nodeCount)
+    const uint32_t liveNodeCount = m_nodeCount - m_compileStats.culledNodeCount;
+    if (sortedCount != liveNodeCount)
     {
         LOGE("Cycle detected in RenderGraph '{}': sorted {} of {} nodes", m_rdgTag, sortedCount,
-             m_nodeCount);
+             liveNodeCount);
     }
 }
 
@@ -1146,6 +1521,10 @@ void RenderGraph::DestroyPassChildNode(RDGPassChildNode* pNode)
         case RDGPassCmdType::eDrawIndexedIndirect:
             reinterpret_cast<RDGDrawIndexedIndirectNode*>(pNode)->~RDGDrawIndexedIndirectNode();
             break;
+        case RDGPassCmdType::eDrawIndexedIndirectCount:
+            reinterpret_cast<RDGDrawIndexedIndirectCountNode*>(pNode)
+                ->~RDGDrawIndexedIndirectCountNode();
+            break;
         case RDGPassCmdType::eDispatch:
             reinterpret_cast<RDGDispatchNode*>(pNode)->~RDGDispatchNode();
             break;
@@ -1201,13 +1580,19 @@ void RenderGraph::ResetBuildState()
 
     m_compiledNodes.clear();
     m_sortedNodes.clear();
+    m_culledNodes.clear();
     m_baseNodeMap.clear();
     m_passChildNodeMap.clear();
     m_resources.clear();
     m_nodeAccessMap.clear();
     m_resourceMap.clear();
+    m_resourceLifetimes.clear();
+    m_transientResources.clear();
+    m_recordBarriers.clear();
+    m_recordBufferTransitions.clear();
+    m_recordTextureTransitions.clear();
+    m_barrierEvents.clear();
     m_poolAlloc.Reset();
-    m_pCmdList       = nullptr;
     m_nodeCount      = 0;
     m_compileStats   = {};
     m_executionState = RDGExecutionState::eIdle;
@@ -1234,15 +1619,225 @@ void RenderGraph::Compile()
 {
     m_compiledNodes.clear();
     m_compileStats = {};
+    // before the structure key, culled nodes keep their type but lose their accesses
+    CullNodes();
+
+    std::vector<uint32_t> structureKey;
+    BuildStructureKey(structureKey);
+    const uint64_t structureHash =
+        util::HashBytes64(structureKey.data(), structureKey.size() * sizeof(uint32_t));
+
+    if (s_compiledPlanCache.Restore(structureHash, structureKey, m_sortedNodes, m_compiledNodes,
+                                    m_compileStats))
+    {
+        PatchCompiledNodeResources();
+    }
+    else
+    {
+        SortNodesV2();
+        BuildCompiledNodeList();
+        AttachFirstUseBarriers();
+        AttachIntraGraphBarriers();
+        s_compiledPlanCache.Store(structureHash, std::move(structureKey), m_sortedNodes,
+                                  m_compiledNodes, m_compileStats);
+    }
+    m_compileStats.cacheHits   = s_compiledPlanCache.GetNumHits();
+    m_compileStats.cacheMisses = s_compiledPlanCache.GetNumMisses();
+
+    AnalyzeResourceLifetimes();
+    PlaceTransientResources();
+    OptimizeBarriers();
 
-    SortNodesV2();
-    BuildCompiledNodeList();
-    AttachFirstUseBarriers();
-    AttachIntraGraphBarriers();
     ValidateCompiledGraph();
     m_executionState = RDGExecutionState::eCompiled;
 }
 
+void RenderGraph::BuildStructureKey(std::vector<uint32_t>& outKey) const
+{
+    outKey.clear();
+    outKey.push_back(m_nodeCount);
+    outKey.push_back(static_cast<uint32_t>(m_resources.size()));
+
+    for (uint32_t nodeId = 0; nodeId < m_nodeCount; nodeId++)
+    {
+        const RDGNodeBase* pNode = GetNodeBaseById(static_cast<int32_t>(nodeId));
+        outKey.push_back(ToUnderlying(pNode->type));
+        outKey.push_back(IsNodeCulled(static_cast<int32_t>(nodeId)) ? 1 : 0);
+        AppendKey64(outKey, static_cast<int64_t>(pNode->selfStages));
+
+        auto iter = m_nodeAccessMap.find(static_cast<int32_t>(nodeId));
+        if (iter == m_nodeAccessMap.end())
+        {
+            outKey.push_back(0);
+            continue;
+        }
+        outKey.push_back(static_cast<uint32_t>(iter->second.size()));
+        for (const RDGAccess& access : iter->second)
+        {
+            AppendAccessKey(outKey, access);
+        }
+    }
+
+    // the per resource access order drives the dependency sort
+    for (const RDGResource* pResource : m_resources)
+    {
+        outKey.push_back(ToUnderlying(pResource->type));
+        outKey.push_back(static_cast<uint32_t>(pResource->accesses.size()));
+        for (const RDGAccess& access : pResource->accesses)
+        {
+            AppendAccessKey(outKey, access);
+        }
+    }
+}
+
+void RenderGraph::PatchCompiledNodeResources()
+{
+    for (RDGCompiledNode& compiledNode : m_compiledNodes)
+    {
+        for (uint32_t i = 0; i < compiledNode.prologueBufferTransitions.size(); i++)
+        {
+            RDGResource* pResource = m_resources[compiledNode.prologueBufferResourceIds[i]];
+            compiledNode.prologueBufferTransitions[i].pBuffer =
+                dynamic_cast<RHIBuffer*>(pResource->pPhysicalRes);
+        }
+        for (uint32_t i = 0; i < compiledNode.prologueTextureTransitions.size(); i++)
+        {
+            RDGResource* pResource = m_resources[compiledNode.prologueTextureResourceIds[i]];
+            compiledNode.prologueTextureTransitions[i].pTexture =
+                dynamic_cast<RHITexture*>(pResource->pPhysicalRes);
+        }
+    }
+}
+
+void RenderGraph::AnalyzeResourceLifetimes()
+{
+    m_resourceLifetimes.clear();
+    m_resourceLifetimes.resize(m_resources.size());
+    for (uint32_t position = 0; position < m_compiledNodes.size(); position++)
+    {
+        auto iter = m_nodeAccessMap.find(m_compiledNodes[position].nodeId);
+        if (iter == m_nodeAccessMap.end())
+        {
+            continue;
+        }
+
+        for (const RDGAccess& access : iter->second)
+        {
+            if (access.resourceId < 0 ||
+                static_cast<size_t>(static_cast<int32_t>(access.resourceId)) >= m_resources.size())
+            {
+                continue;
+            }
+
+            RDGResourceLifetime& lifetime = m_resourceLifetimes[access.resourceId];
+            if (lifetime.firstNode < 0)
+            {
+                lifetime.firstNode = static_cast<int32_t>(position);
+            }
+            lifetime.lastNode = static_cast<int32_t>(position);
+        }
+    }
+}
+
+void RenderGraph::PlaceTransientResources()
+{
+    m_transientResources.clear();
+    HeapVector<RDG_ID> transientResourceIds;
+    HeapVector<RDGTransientRequest> requests;
+    for (const RDGResource* pResource : m_resources)
+    {
+        if (!pResource->transient || !m_resourceLifetimes[pResource->id].IsValid())
+        {
+            continue;
+        }
+
+        RDGTransientRequest& request = requests.emplace_back();
+        request.lifetime             = m_resourceLifetimes[pResource->id];
+        if (pResource->type == RDGResourceType::eTexture)
+        {
+            request.memory =
+                dynamic_cast<RHITexture*>(pResource->pPhysicalRes)->GetMemoryRequirements();
+        }
+        else
+        {
+            request.memory =
+                dynamic_cast<RHIBuffer*>(pResource->pPhysicalRes)->GetMemoryRequirements();
+        }
+
+        // placed by an earlier compile, the memory is bound by then and can not move
+        const RDGResourceTracker* pTracker = s_trackerPool.GetTracker(pResource->pPhysicalRes);
+        if (!pTracker->transientGraphTag.empty())
+        {
+            VERIFY_EXPR_MSG_F(pTracker->transientGraphTag == m_rdgTag,
+                              "transient resource {} of RenderGraph '{}' is also used by '{}'",
+                              pResource->pPhysicalRes->GetResourceTag(),
+                              pTracker->transientGraphTag, m_rdgTag);
+            request.fixed           = true;
+            request.fixedBlockIndex = pTracker->transientBlockIndex;
+            request.fixedOffset     = pTracker->transientOffset;
+        }
+        transientResourceIds.push_back(pResource->id);
+        m_transientResources.push_back(pResource->pPhysicalRes);
+    }
+
+    RDGTransientAllocator::Place(requests, RDGTransientAllocator::cDefaultMaxBlockSize,
+                                 m_transientLayout);
+    // bound memory can not move, executing would let both resources overwrite each other
+    if (!m_transientLayout.fixedConflicts.empty())
+    {
+        const auto& conflict = m_transientLayout.fixedConflicts[0];
+        LOG_FATAL_ERROR_AND_THROW(
+            "Transient resources {} and {} of RenderGraph '{}' are bound to the same memory but "
+            "now overlap, one of them has to be recreated",
+            m_transientResources[conflict.first]->GetResourceTag(),
+            m_transientResources[conflict.second]->GetResourceTag(), m_rdgTag);
+    }
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        RDGResourceTracker* pTracker = s_trackerPool.GetTracker(m_transientResources[i]);
+        if (pTracker->transientGraphTag.empty())
+        {
+            pTracker->transientGraphTag   = m_rdgTag;
+            pTracker->transientBlockIndex = m_transientLayout.placements[i].blockIndex;
+            pTracker->transientOffset     = m_transientLayout.placements[i].offset;
+        }
+    }
+    m_compileStats.transientResourceCount       = requests.size();
+    m_compileStats.transientMemorySize          = m_transientLayout.allocatedSize;
+    m_compileStats.transientMemoryRequestedSize = m_transientLayout.requestedSize;
+
+    // the previous user of the memory may still be writing it, the first use of the new resource
+    // already waits for all commands and discards the old contents
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        if (m_transientLayout.placements[i].aliasedRequest < 0)
+        {
+            continue;
+        }
+
+        RDGCompiledNode& compiledNode = m_compiledNodes[requests[i].lifetime.firstNode];
+        RHIMemoryTransition transition;
+        transition.srcAccess.SetFlag(RHIAccessFlagBits::eMemoryWrite);
+        transition.dstAccess.SetFlags(RHIAccessFlagBits::eMemoryRead,
+                                      RHIAccessFlagBits::eMemoryWrite);
+        compiledNode.aliasingMemoryTransitions.push_back(transition);
+        m_compileStats.aliasingBarrierCount++;
+    }
+}
+
+bool RenderGraph::IsTransientResource(RHIResource* pResourceRHI, RDGResourceType type)
+{
+    if (type == RDGResourceType::eTexture)
+    {
+        return dynamic_cast<RHITexture*>(pResourceRHI)->IsTransient();
+    }
+    if (type == RDGResourceType::eBuffer)
+    {
+        return dynamic_cast<RHIBuffer*>(pResourceRHI)->IsTransient();
+    }
+    return false;
+}
+
 void RenderGraph::BuildCompiledNodeList()
 {
     m_compiledNodes.reserve(m_nodeCount);
@@ -1261,6 +1856,7 @@ void RenderGraph::BuildCompiledNodeList()
 
             RDGCompiledNode& compiledNode = m_compiledNodes.emplace_back();
             compiledNode.nodeId           = nodeId;
+            compiledNode.level            = i;
 
             m_compileStats.nodeCount++;
             if (pNode->type == RDGNodeType::eGraphicsPass ||
@@ -1316,9 +1912,11 @@ void RenderGraph::AttachIntraGraphBarriers()
     HeapVector<uint8_t> resourceHasReadGroup(m_resources.size());
     HeapVector<RDGAccess> resourceStates(m_resources.size());
     HeapVector<BitField<RHIPipelineStageBits>> resourceReadGroupStages(m_resources.size());
+    HeapVector<int32_t> resourceLastNodes(m_resources.size());
 
-    for (RDGCompiledNode& compiledNode : m_compiledNodes)
+    for (uint32_t position = 0; position < m_compiledNodes.size(); position++)
     {
+        RDGCompiledNode& compiledNode = m_compiledNodes[position];
         auto iter = m_nodeAccessMap.find(compiledNode.nodeId);
         if (iter == m_nodeAccessMap.end())
         {
@@ -1340,6 +1938,7 @@ void RenderGraph::AttachIntraGraphBarriers()
             {
                 resourceInitialized[resourceIndex] = 1;
                 resourceStates[resourceIndex]      = access;
+                resourceLastNodes[resourceIndex]   = static_cast<int32_t>(position);
                 if (access.accessMode == RHIAccessMode::eRead)
                 {
                     resourceHasReadGroup[resourceIndex] = 1;
@@ -1353,16 +1952,17 @@ void RenderGraph::AttachIntraGraphBarriers()
             const bool needsBarrier = AccessNeedsBarrier(pResource, previousAccess, access);
             if (needsBarrier)
             {
+                RDGTransitionSource source;
+                source.node = resourceLastNodes[resourceIndex];
                 if (resourceHasReadGroup[resourceIndex] != 0)
                 {
-                    compiledNode.prologueSrcStages.SetFlag(
-                        resourceReadGroupStages[resourceIndex]);
+                    source.stages = resourceReadGroupStages[resourceIndex];
                 }
                 else
                 {
-                    compiledNode.prologueSrcStages.SetFlag(
-                        GetNodeBaseById(previousAccess.nodeId)->selfStages);
+                    source.stages = GetNodeBaseById(previousAccess.nodeId)->selfStages;
                 }
+                compiledNode.prologueSrcStages.SetFlag(source.stages);
                 compiledNode.prologueDstStages.SetFlag(GetNodeBaseById(access.nodeId)->selfStages);
 
                 if (pResource->type == RDGResourceType::eBuffer)
@@ -1374,6 +1974,8 @@ void RenderGraph::AttachIntraGraphBarriers()
                     transition.oldUsage      = previousAccess.bufferUsage;
                     transition.newUsage      = access.bufferUsage;
                     compiledNode.prologueBufferTransitions.push_back(transition);
+                    compiledNode.prologueBufferResourceIds.push_back(access.resourceId);
+                    compiledNode.prologueBufferSources.push_back(source);
                 }
                 else if (pResource->type == RDGResourceType::eTexture)
                 {
@@ -1385,6 +1987,8 @@ void RenderGraph::AttachIntraGraphBarriers()
                     transition.newUsage         = access.textureUsage;
                     transition.subResourceRange = access.textureSubResourceRange;
                     compiledNode.prologueTextureTransitions.push_back(transition);
+                    compiledNode.prologueTextureResourceIds.push_back(access.resourceId);
+                    compiledNode.prologueTextureSources.push_back(source);
                 }
                 else
                 {
@@ -1393,7 +1997,8 @@ void RenderGraph::AttachIntraGraphBarriers()
                 m_compileStats.barrierCount++;
             }
 
-            previousAccess = access;
+            previousAccess                   = access;
+            resourceLastNodes[resourceIndex] = static_cast<int32_t>(position);
             if (access.accessMode == RHIAccessMode::eRead)
             {
                 if (needsBarrier)
@@ -1414,12 +2019,96 @@ void RenderGraph::AttachIntraGraphBarriers()
     }
 }
 
+void RenderGraph::OptimizeBarriers()
+{
+    for (const RDGCompiledNode& compiledNode : m_compiledNodes)
+    {
+        if (HasPrologueTransitions(compiledNode))
+        {
+            m_compileStats.unmergedBarrierBatchCount++;
+        }
+    }
+
+    m_barrierEvents.clear();
+    for (uint32_t position = 0; position < m_compiledNodes.size(); position++)
+    {
+        RDGCompiledNode& compiledNode = m_compiledNodes[position];
+        RDGTransitionSource splitSource;
+        SplitDistantTransitions(position, compiledNode.prologueBufferTransitions,
+                                compiledNode.prologueBufferResourceIds,
+                                compiledNode.prologueBufferSources,
+                                compiledNode.splitBufferTransitions, splitSource);
+        SplitDistantTransitions(position, compiledNode.prologueTextureTransitions,
+                                compiledNode.prologueTextureResourceIds,
+                                compiledNode.prologueTextureSources,
+                                compiledNode.splitTextureTransitions, splitSource);
+        if (splitSource.node < 0)
+        {
+            continue;
+        }
+
+        compiledNode.splitSrcNode   = splitSource.node;
+        compiledNode.splitSrcStages = splitSource.stages;
+        m_compiledNodes[splitSource.node].splitBarrierConsumers.push_back(position);
+        m_compileStats.splitBarrierCount += compiledNode.splitBufferTransitions.size() +
+            compiledNode.splitTextureTransitions.size();
+
+        // the prologue no longer waits for the sources of the split transitions
+        compiledNode.prologueSrcStages.Clear();
+        if (!compiledNode.initialResourceAccesses.empty())
+        {
+            compiledNode.prologueSrcStages.SetFlag(RHIPipelineStageBits::eAllCommands);
+        }
+        for (const RDGTransitionSource& source : compiledNode.prologueBufferSources)
+        {
+            compiledNode.prologueSrcStages.SetFlag(source.stages);
+        }
+        for (const RDGTransitionSource& source : compiledNode.prologueTextureSources)
+        {
+            compiledNode.prologueSrcStages.SetFlag(source.stages);
+        }
+    }
+    if (m_compileStats.splitBarrierCount > 0)
+    {
+        m_barrierEvents.resize(m_compiledNodes.size());
+    }
+
+    bool groupHasBarrier = false;
+    for (uint32_t position = 0; position < m_compiledNodes.size(); position++)
+    {
+        if (!JoinsBarrierGroup(position))
+        {
+            groupHasBarrier = false;
+        }
+        if (!groupHasBarrier && HasPrologueTransitions(m_compiledNodes[position]))
+        {
+            m_compileStats.barrierBatchCount++;
+            groupHasBarrier = true;
+        }
+    }
+}
+
+bool RenderGraph::JoinsBarrierGroup(uint32_t node) const
+{
+    if (node == 0)
+    {
+        return false;
+    }
+
+    // nodes of a level do not depend on each other, so the barrier of a node can move ahead of
+    // the other nodes of its level. Aliased memory has to come first
+    const RDGCompiledNode& compiledNode = m_compiledNodes[node];
+    const RDGCompiledNode& previousNode = m_compiledNodes[node - 1];
+    return compiledNode.level == previousNode.level &&
+        compiledNode.aliasingMemoryTransitions.empty();
+}
+
 void RenderGraph::ValidateCompiledGraph() const
 {
-    if (m_compiledNodes.size() != m_nodeCount)
+    if (m_compiledNodes.size() + m_compileStats.culledNodeCount != m_nodeCount)
     {
-        LOGE("RenderGraph '{}' compiled {} of {} nodes", m_rdgTag, m_compiledNodes.size(),
-             m_nodeCount);
+        LOGE("RenderGraph '{}' compiled {} of {} nodes, {} culled", m_rdgTag,
+             m_compiledNodes.size(), m_nodeCount, m_compileStats.culledNodeCount);
     }
 
     if (m_baseNodeMap.size() != m_nodeCount)
@@ -1448,30 +2137,201 @@ void RenderGraph::ValidateCompiledGraph() const
     }
 
 #if defined(ZEN_DEBUG)
-    LOGI("RenderGraph '{}' compiled: nodes={}, passes={}, resources={}, barriers={}, cmdLists={}",
+    LOGI("RenderGraph '{}' compiled: nodes={}, passes={}, resources={}, barriers={}, cmdLists={}, "
+         "cacheHits={}, cacheMisses={}, transients={}, transientMemory={}/{}, aliasingBarriers={}, "
+         "barrierBatches={}/{}, splitBarriers={}, culledNodes={}, culledPasses={}",
          m_rdgTag, m_compileStats.nodeCount, m_compileStats.passCount, m_compileStats.resourceCount,
-         m_compileStats.barrierCount, m_compileStats.commandListCount);
+         m_compileStats.barrierCount, m_compileStats.commandListCount, m_compileStats.cacheHits,
+         m_compileStats.cacheMisses, m_compileStats.transientResourceCount,
+         m_compileStats.transientMemorySize, m_compileStats.transientMemoryRequestedSize,
+         m_compileStats.aliasingBarrierCount, m_compileStats.barrierBatchCount,
+         m_compileStats.unmergedBarrierBatchCount, m_compileStats.splitBarrierCount,
+         m_compileStats.culledNodeCount, m_compileStats.culledPassCount);
 #endif
 }
 
 void RenderGraph::Execute(RHICommandList* pCmdList)
+{
+    Execute(MakeVecView(&pCmdList, 1), nullptr);
+}
+
+void RenderGraph::Execute(VectorView<RHICommandList*> cmdLists,
+                          JobSystem* pJobSystem,
+                          HeapVector<RHIPlatformCommandList*>* pOutPlatformCmdLists)
 {
     VERIFY_EXPR_MSG(m_executionState == RDGExecutionState::eCompiled,
                     "RenderGraph::Execute called before graph is compiled");
-    m_pCmdList       = pCmdList;
+    VERIFY_EXPR_MSG(!cmdLists.empty(), "RenderGraph::Execute needs at least one command list");
     m_executionState = RDGExecutionState::eExecuting;
+    if (pOutPlatformCmdLists != nullptr)
+    {
+        pOutPlatformCmdLists->clear();
+        pOutPlatformCmdLists->resize(cmdLists.size());
+    }
 
-    for (RDGCompiledNode& compiledNode : m_compiledNodes)
+    // the tracked resource state depends on the node order, resolve every barrier up front
+    m_recordBarriers.resize(m_compiledNodes.size());
+    m_recordBufferTransitions.clear();
+    m_recordTextureTransitions.clear();
+    m_compileStats.redundantTransitionCount = 0;
+    for (uint32_t i = 0; i < m_compiledNodes.size(); i++)
     {
-        EmitCompiledNodeBarriers(compiledNode);
-        RunNode(GetNodeBaseById(compiledNode.nodeId));
+        ResolveCompiledNodeBarriers(m_compiledNodes[i], m_recordBarriers[i]);
+    }
+
+    const uint32_t numSegments = static_cast<uint32_t>(cmdLists.size());
+    HeapVector<uint32_t> segmentBegins;
+    SplitRecordSegments(numSegments, segmentBegins);
+    const bool parallel = pJobSystem != nullptr && numSegments > 1;
+    // a split barrier is set and waited on while the lists are finalized
+    const bool eventsAcrossLists = !parallel || pOutPlatformCmdLists == nullptr;
+    auto recordSegments = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t segment = begin; segment < end; segment++)
+        {
+            RecordSegment(segmentBegins[segment], segmentBegins[segment + 1], cmdLists[segment],
+                          eventsAcrossLists);
+            // each list owns its context, the backend encodes it right here
+            if (pOutPlatformCmdLists != nullptr)
+            {
+                (*pOutPlatformCmdLists)[segment] =
+                    GDynamicRHI->FinalizeCommandList(cmdLists[segment]);
+            }
+        }
+    };
+    if (parallel)
+    {
+        JobCounter counter;
+        pJobSystem->ParallelFor(numSegments, 1, recordSegments, &counter);
+        pJobSystem->Wait(&counter);
+    }
+    else
+    {
+        recordSegments(0, numSegments);
     }
 
-    m_pCmdList       = nullptr;
     m_executionState = RDGExecutionState::eCompiled;
 }
 
-void RenderGraph::RunNode(RDGNodeBase* pBase)
+void RenderGraph::SplitRecordSegments(uint32_t numSegments,
+                                      HeapVector<uint32_t>& outSegmentBegins) const
+{
+    const uint32_t numNodes = static_cast<uint32_t>(m_compiledNodes.size());
+    HeapVector<uint32_t> nodeCosts(numNodes);
+    uint64_t totalCost = 0;
+    for (uint32_t i = 0; i < numNodes; i++)
+    {
+        const RDGCompiledNode& compiledNode = m_compiledNodes[i];
+        const RDGNodeBase* pBase            = GetNodeBaseById(compiledNode.nodeId);
+        // one for the node itself and its barriers, plus every command of a pass
+        nodeCosts[i] = 1;
+        if (pBase->type == RDGNodeType::eGraphicsPass || pBase->type == RDGNodeType::eComputePass)
+        {
+            nodeCosts[i] += static_cast<uint32_t>(GetPassChildNodes(compiledNode.nodeId).size());
+        }
+        totalCost += nodeCosts[i];
+    }
+
+    // a segment ends once the running cost reaches its share, only depends on the graph and the
+    // number of segments
+    outSegmentBegins.clear();
+    outSegmentBegins.reserve(numSegments + 1);
+    outSegmentBegins.push_back(0);
+    uint64_t runningCost = 0;
+    uint32_t node        = 0;
+    for (uint32_t segment = 1; segment < numSegments; segment++)
+    {
+        const uint64_t segmentEndCost = totalCost * segment / numSegments;
+        while (node < numNodes && runningCost < segmentEndCost)
+        {
+            runningCost += nodeCosts[node];
+            node++;
+        }
+        outSegmentBegins.push_back(node);
+    }
+    outSegmentBegins.push_back(numNodes);
+}
+
+void RenderGraph::RecordSegment(uint32_t beginNode,
+                                uint32_t endNode,
+                                RHICommandList* pCmdList,
+                                bool eventsAcrossLists)
+{
+    for (uint32_t i = beginNode; i < endNode; i++)
+    {
+        const RDGCompiledNode& compiledNode = m_compiledNodes[i];
+        // a group continuing from the previous list already has its barrier there
+        if (!JoinsBarrierGroup(i))
+        {
+            RecordBarrierGroup(i, pCmdList);
+        }
+        if (compiledNode.splitSrcNode >= 0)
+        {
+            if (eventsAcrossLists || static_cast<uint32_t>(compiledNode.splitSrcNode) >= beginNode)
+            {
+                pCmdList->WaitBarrierEvent(&m_barrierEvents[i]);
+            }
+            else
+            {
+                pCmdList->AddTransitions(
+                    compiledNode.splitSrcStages, GetNodeBaseById(compiledNode.nodeId)->selfStages,
+                    {}, VectorView<RHIBufferTransition>(compiledNode.splitBufferTransitions),
+                    VectorView<RHITextureTransition>(compiledNode.splitTextureTransitions));
+            }
+        }
+        RunNode(GetNodeBaseById(compiledNode.nodeId), pCmdList);
+        for (uint32_t consumer : compiledNode.splitBarrierConsumers)
+        {
+            if (!eventsAcrossLists && consumer >= endNode)
+            {
+                continue;
+            }
+            const RDGCompiledNode& consumerNode = m_compiledNodes[consumer];
+            pCmdList->SetBarrierEvent(
+                &m_barrierEvents[consumer], consumerNode.splitSrcStages,
+                GetNodeBaseById(consumerNode.nodeId)->selfStages,
+                VectorView<RHIBufferTransition>(consumerNode.splitBufferTransitions),
+                VectorView<RHITextureTransition>(consumerNode.splitTextureTransitions));
+        }
+    }
+}
+
+void RenderGraph::RecordBarrierGroup(uint32_t beginNode, RHICommandList* pCmdList)
+{
+    // the transitions of consecutive nodes are consecutive in the resolved arrays
+    BitField<RHIPipelineStageBits> srcStages;
+    BitField<RHIPipelineStageBits> dstStages;
+    uint32_t numBufferTransitions  = 0;
+    uint32_t numTextureTransitions = 0;
+    uint32_t node                  = beginNode;
+    do
+    {
+        const RDGRecordBarriers& barriers = m_recordBarriers[node];
+        if (barriers.numBufferTransitions > 0 || barriers.numTextureTransitions > 0)
+        {
+            srcStages.SetFlag(m_compiledNodes[node].prologueSrcStages);
+            dstStages.SetFlag(m_compiledNodes[node].prologueDstStages);
+            numBufferTransitions += barriers.numBufferTransitions;
+            numTextureTransitions += barriers.numTextureTransitions;
+        }
+        node++;
+    } while (node < m_compiledNodes.size() && JoinsBarrierGroup(node));
+
+    if (numBufferTransitions == 0 && numTextureTransitions == 0)
+    {
+        return;
+    }
+
+    const RDGRecordBarriers& barriers = m_recordBarriers[beginNode];
+    pCmdList->AddTransitions(
+        srcStages, dstStages,
+        VectorView<RHIMemoryTransition>(m_compiledNodes[beginNode].aliasingMemoryTransitions),
+        MakeVecView(m_recordBufferTransitions.data() + barriers.firstBufferTransition,
+                    numBufferTransitions),
+        MakeVecView(m_recordTextureTransitions.data() + barriers.firstTextureTransition,
+                    numTextureTransitions));
+}
+
+void RenderGraph::RunNode(RDGNodeBase* pBase, RHICommandList* pCmdList)
 {
     RDGNodeType type = pBase->type;
     switch (type)
@@ -1479,13 +2339,13 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
         case RDGNodeType::eClearBuffer:
         {
             RDGBufferClearNode* pNode = reinterpret_cast<RDGBufferClearNode*>(pBase);
-            m_pCmdList->ClearBuffer(pNode->pBuffer, pNode->offset, pNode->size);
+            pCmdList->ClearBuffer(pNode->pBuffer, pNode->offset, pNode->size);
         }
         break;
         case RDGNodeType::eCopyBuffer:
         {
             RDGBufferCopyNode* pNode = reinterpret_cast<RDGBufferCopyNode*>(pBase);
-            m_pCmdList->CopyBuffer(pNode->pSrcBuffer, pNode->pDstBuffer, pNode->region);
+            pCmdList->CopyBuffer(pNode->pSrcBuffer, pNode->pDstBuffer, pNode->region);
         }
         break;
         case RDGNodeType::eUpdateBuffer:
@@ -1493,28 +2353,28 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
             RDGBufferUpdateNode* pNode = reinterpret_cast<RDGBufferUpdateNode*>(pBase);
             for (auto& source : pNode->sources)
             {
-                m_pCmdList->CopyBuffer(source.pBuffer, pNode->pDstBuffer, source.region);
+                pCmdList->CopyBuffer(source.pBuffer, pNode->pDstBuffer, source.region);
             }
         }
         break;
         case RDGNodeType::eClearTexture:
         {
             RDGTextureClearNode* pNode = reinterpret_cast<RDGTextureClearNode*>(pBase);
-            m_pCmdList->ClearTexture(pNode->pTexture, pNode->color,
+            pCmdList->ClearTexture(pNode->pTexture, pNode->color,
                                      pNode->pTexture->GetSubResourceRange());
         }
         break;
         case RDGNodeType::eCopyTexture:
         {
             RDGTextureCopyNode* pNode = reinterpret_cast<RDGTextureCopyNode*>(pBase);
-            m_pCmdList->CopyTexture(pNode->pSrcTexture, pNode->pDstTexture,
+            pCmdList->CopyTexture(pNode->pSrcTexture, pNode->pDstTexture,
                                     pNode->textureCopyRegions);
         }
         break;
         case RDGNodeType::eReadTexture:
         {
             RDGTextureReadNode* pNode = reinterpret_cast<RDGTextureReadNode*>(pBase);
-            m_pCmdList->CopyTextureToBuffer(pNode->pSrcTexture, pNode->pDstBuffer,
+            pCmdList->CopyTextureToBuffer(pNode->pSrcTexture, pNode->pDstBuffer,
                                             pNode->bufferTextureCopyRegions);
         }
         break;
@@ -1525,14 +2385,14 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
             for (uint32_t i = 0; i < pNode->numCopySources; i++)
             {
                 const RHIBufferTextureCopySource& source = pNode->copySources[i];
-                m_pCmdList->CopyBufferToTexture(source.pBuffer, pNode->pDstTexture, source.region);
+                pCmdList->CopyBufferToTexture(source.pBuffer, pNode->pDstTexture, source.region);
             }
         }
         break;
         case RDGNodeType::eResolveTexture:
         {
             RDGTextureResolveNode* pNode = reinterpret_cast<RDGTextureResolveNode*>(pBase);
-            m_pCmdList->ResolveTexture(pNode->pSrcTexture, pNode->pDstTexture, pNode->srcLayer,
+            pCmdList->ResolveTexture(pNode->pSrcTexture, pNode->pDstTexture, pNode->srcLayer,
                                        pNode->srcMipmap, pNode->dstLayer, pNode->dstMipmap);
         }
         break;
@@ -1540,7 +2400,7 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
         case RDGNodeType::eGenTextureMipmap:
         {
             RDGTextureMipmapGenNode* pNode = reinterpret_cast<RDGTextureMipmapGenNode*>(pBase);
-            m_pCmdList->GenerateTextureMipmaps(pNode->pTexture);
+            pCmdList->GenerateTextureMipmaps(pNode->pTexture);
         }
         break;
 
@@ -1549,15 +2409,15 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
             RDGComputePassNode* pNode   = reinterpret_cast<RDGComputePassNode*>(pBase);
             RHIPipeline* pBoundPipeline = nullptr;
             // for (RDGPassChildNode* child : node->childNodes)
-            for (RDGPassChildNode* pChild : m_passChildNodeMap[pNode->id])
+            for (RDGPassChildNode* pChild : GetPassChildNodes(pNode->id))
             {
                 switch (pChild->type)
                 {
                     case RDGPassCmdType::eBindPipeline:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGBindPipelineNode*>(pChild);
-                        pBoundPipeline = pCmdNode->pPipeline;
-                        m_pCmdList->BindPipeline(pCmdNode->pipelineType, pCmdNode->pPipeline,
+                        pBoundPipeline = *pCmdNode->ppPipeline;
+                        pCmdList->BindPipeline(pCmdNode->pipelineType, pBoundPipeline,
                                                  pNode->pComputePass->numDescriptorSets,
                                                  pNode->pComputePass->pDescriptorSets);
                     }
@@ -1565,21 +2425,21 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
                     case RDGPassCmdType::eDispatch:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGDispatchNode*>(pChild);
-                        m_pCmdList->Dispatch(pCmdNode->groupCountX, pCmdNode->groupCountY,
+                        pCmdList->Dispatch(pCmdNode->groupCountX, pCmdNode->groupCountY,
                                              pCmdNode->groupCountZ);
                     }
                     break;
                     case RDGPassCmdType::eDispatchIndirect:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGDispatchIndirectNode*>(pChild);
-                        m_pCmdList->DispatchIndirect(pCmdNode->pIndirectBuffer, pCmdNode->offset);
+                        pCmdList->DispatchIndirect(pCmdNode->pIndirectBuffer, pCmdNode->offset);
                     }
                     break;
                     case RDGPassCmdType::eSetPushConstant:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGSetPushConstantsNode*>(pChild);
                         VERIFY_EXPR(pBoundPipeline != nullptr);
-                        m_pCmdList->SetPushConstants(pBoundPipeline, pCmdNode->pcData);
+                        pCmdList->SetPushConstants(pBoundPipeline, pCmdNode->pcData);
                     }
                     break;
                     default: break;
@@ -1596,7 +2456,14 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
             DataFormat boundIndexFormat  = DataFormat::eUndefined;
             uint32_t boundIndexOffset    = 0;
 
-            m_pCmdList->BeginRendering(pNode->pGraphicsPass->pRenderingLayout);
+            if (pNode->pGraphicsPass->pPipeline == nullptr)
+            {
+                // pipeline still compiling on a worker, the barriers above are kept so resource
+                // states stay consistent for the following passes
+                break;
+            }
+
+            pCmdList->BeginRendering(pNode->pGraphicsPass->pRenderingLayout);
 
             // if (node->dynamic)
             // {
@@ -1612,7 +2479,7 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
 
             // m_cmdList->BeginRenderPass(node->renderPass, node->framebuffer, node->renderArea,
             //                            VectorView(node->clearValues, node->numAttachments));
-            for (RDGPassChildNode* pChild : m_passChildNodeMap[pNode->id])
+            for (RDGPassChildNode* pChild : GetPassChildNodes(pNode->id))
             {
                 switch (pChild->type)
                 {
@@ -1633,14 +2500,14 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
                         //m_cmdList->BindVertexBuffers(
                         //    VectorView(cmdNode->VertexBuffers(), cmdNode->numBuffers),
                         //    cmdNode->VertexBufferOffsets());
-                        m_pCmdList->BindVertexBuffers(pCmdNode->vertexBuffers, pCmdNode->offsets);
+                        pCmdList->BindVertexBuffers(pCmdNode->vertexBuffers, pCmdNode->offsets);
                     }
                     break;
                     case RDGPassCmdType::eBindPipeline:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGBindPipelineNode*>(pChild);
-                        pBoundPipeline = pCmdNode->pPipeline;
-                        m_pCmdList->BindPipeline(pCmdNode->pipelineType, pCmdNode->pPipeline,
+                        pBoundPipeline = *pCmdNode->ppPipeline;
+                        pCmdList->BindPipeline(pCmdNode->pipelineType, pBoundPipeline,
                                                  pNode->pGraphicsPass->numDescriptorSets,
                                                  pNode->pGraphicsPass->pDescriptorSets);
                     }
@@ -1649,7 +2516,7 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
                     case RDGPassCmdType::eDraw:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGDrawNode*>(pChild);
-                        m_pCmdList->Draw(pCmdNode->vertexCount, pCmdNode->instanceCount, 0, 0);
+                        pCmdList->Draw(pCmdNode->vertexCount, pCmdNode->instanceCount, 0, 0);
                     }
                     break;
                     case RDGPassCmdType::eDrawIndexed:
@@ -1666,7 +2533,7 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
                         param.vertexOffset      = pCmdNode->vertexOffset;
                         param.firstInstance     = pCmdNode->firstInstance;
 
-                        m_pCmdList->DrawIndexed(param);
+                        pCmdList->DrawIndexed(param);
                     }
                     break;
                     case RDGPassCmdType::eDrawIndexedIndirect:
@@ -1682,7 +2549,26 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
                         param.drawCount         = pCmdNode->drawCount;
                         param.stride            = pCmdNode->stride;
 
-                        m_pCmdList->DrawIndexedIndirect(param);
+                        pCmdList->DrawIndexedIndirect(param);
+                    }
+                    break;
+                    case RDGPassCmdType::eDrawIndexedIndirectCount:
+                    {
+                        auto* pCmdNode =
+                            reinterpret_cast<RDGDrawIndexedIndirectCountNode*>(pChild);
+                        VERIFY_EXPR(pBoundIndexBuffer != nullptr);
+                        RHICommandDrawIndexedIndirectCount::Param param{};
+                        param.pIndirectBuffer   = pCmdNode->pIndirectBuffer;
+                        param.pIndexBuffer      = pBoundIndexBuffer;
+                        param.indexFormat       = boundIndexFormat;
+                        param.indexBufferOffset = boundIndexOffset;
+                        param.offset            = pCmdNode->offset;
+                        param.pCountBuffer      = pCmdNode->pCountBuffer;
+                        param.countBufferOffset = pCmdNode->countBufferOffset;
+                        param.maxDrawCount      = pCmdNode->maxDrawCount;
+                        param.stride            = pCmdNode->stride;
+
+                        pCmdList->DrawIndexedIndirectCount(param);
                     }
                     break;
                     case RDGPassCmdType::eExecuteCommands: break;
@@ -1693,32 +2579,32 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
                     {
                         auto* pCmdNode = reinterpret_cast<RDGSetPushConstantsNode*>(pChild);
                         VERIFY_EXPR(pBoundPipeline != nullptr);
-                        m_pCmdList->SetPushConstants(pBoundPipeline, pCmdNode->pcData);
+                        pCmdList->SetPushConstants(pBoundPipeline, pCmdNode->pcData);
                     }
                     break;
                     case RDGPassCmdType::eSetLineWidth:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGSetLineWidthNode*>(pChild);
-                        m_pCmdList->SetLineWidth(pCmdNode->width);
+                        pCmdList->SetLineWidth(pCmdNode->width);
                     }
                     break;
                     case RDGPassCmdType::eSetBlendConstant:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGSetBlendConstantsNode*>(pChild);
-                        m_pCmdList->SetBlendConstants(pCmdNode->color);
+                        pCmdList->SetBlendConstants(pCmdNode->color);
                     }
                     break;
                     case RDGPassCmdType::eSetScissor:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGSetScissorNode*>(pChild);
-                        m_pCmdList->SetScissor(pCmdNode->scissor.minX, pCmdNode->scissor.minY,
+                        pCmdList->SetScissor(pCmdNode->scissor.minX, pCmdNode->scissor.minY,
                                                pCmdNode->scissor.maxX, pCmdNode->scissor.maxY);
                     }
                     break;
                     case RDGPassCmdType::eSetViewport:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGSetViewportNode*>(pChild);
-                        m_pCmdList->SetViewport(static_cast<uint32_t>(pCmdNode->viewport.minX),
+                        pCmdList->SetViewport(static_cast<uint32_t>(pCmdNode->viewport.minX),
                                                 static_cast<uint32_t>(pCmdNode->viewport.minY),
                                                 static_cast<uint32_t>(pCmdNode->viewport.maxX),
                                                 static_cast<uint32_t>(pCmdNode->viewport.maxY));
@@ -1727,7 +2613,7 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
                     case RDGPassCmdType::eSetDepthBias:
                     {
                         auto* pCmdNode = reinterpret_cast<RDGSetDepthBiasNode*>(pChild);
-                        m_pCmdList->SetDepthBias(pCmdNode->depthBiasConstantFactor,
+                        pCmdList->SetDepthBias(pCmdNode->depthBiasConstantFactor,
                                                  pCmdNode->depthBiasClamp,
                                                  pCmdNode->depthBiasSlopeFactor);
                     }
@@ -1738,7 +2624,7 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
                 }
             }
 
-            m_pCmdList->EndRendering();
+            pCmdList->EndRendering();
 
             // if (node->dynamic)
             // {
@@ -1756,40 +2642,11 @@ void RenderGraph::RunNode(RDGNodeBase* pBase)
     }
 }
 
-void RenderGraph::EmitCompiledNodeBarriers(RDGCompiledNode& compiledNode)
+void RenderGraph::ResolveCompiledNodeBarriers(const RDGCompiledNode& compiledNode,
+                                              RDGRecordBarriers& outBarriers)
 {
-    if (compiledNode.initialResourceAccesses.empty())
-    {
-        if (compiledNode.prologueTextureTransitions.empty() &&
-            compiledNode.prologueBufferTransitions.empty())
-        {
-            return;
-        }
-
-        for (const RHIBufferTransition& transition : compiledNode.prologueBufferTransitions)
-        {
-            s_trackerPool.UpdateTrackerState(transition.pBuffer, transition.newAccessMode,
-                                             transition.newUsage);
-        }
-
-        for (const RHITextureTransition& transition : compiledNode.prologueTextureTransitions)
-        {
-            s_trackerPool.UpdateTrackerState(transition.pTexture, transition.newAccessMode,
-                                             transition.newUsage);
-        }
-
-        m_pCmdList->AddTransitions(compiledNode.prologueSrcStages, compiledNode.prologueDstStages,
-                                   {}, MakeVecView(compiledNode.prologueBufferTransitions),
-                                   MakeVecView(compiledNode.prologueTextureTransitions));
-        return;
-    }
-
-    HeapVector<RHITextureTransition> textureTransitions;
-    HeapVector<RHIBufferTransition> bufferTransitions;
-    textureTransitions.reserve(compiledNode.initialResourceAccesses.size() +
-                               compiledNode.prologueTextureTransitions.size());
-    bufferTransitions.reserve(compiledNode.initialResourceAccesses.size() +
-                              compiledNode.prologueBufferTransitions.size());
+    outBarriers.firstBufferTransition  = static_cast<uint32_t>(m_recordBufferTransitions.size());
+    outBarriers.firstTextureTransition = static_cast<uint32_t>(m_recordTextureTransitions.size());
 
     for (const RDGAccess& access : compiledNode.initialResourceAccesses)
     {
@@ -1800,10 +2657,22 @@ void RenderGraph::EmitCompiledNodeBarriers(RDGCompiledNode& compiledNode)
             continue;
         }
 
-        RDGResource* pResource = m_resources[access.resourceId];
+        RDGResource* pResource       = m_resources[access.resourceId];
+        RDGResourceTracker* pTracker = s_trackerPool.GetTracker(pResource->pPhysicalRes);
+        // a read of a resource already read the same way needs no barrier, unless the memory
+        // was aliased
+        const bool sameUsage = pResource->type == RDGResourceType::eTexture ?
+            pTracker->textureUsage == access.textureUsage :
+            pTracker->bufferUsage == access.bufferUsage;
+        if (access.accessMode == RHIAccessMode::eRead &&
+            pTracker->accessMode == RHIAccessMode::eRead && sameUsage && !pResource->transient)
+        {
+            m_compileStats.redundantTransitionCount++;
+            continue;
+        }
+
         if (pResource->type == RDGResourceType::eTexture)
         {
-            RDGResourceTracker* pTracker = s_trackerPool.GetTracker(pResource->pPhysicalRes);
             RHITextureTransition textureTransition;
             textureTransition.pTexture         = dynamic_cast<RHITexture*>(pResource->pPhysicalRes);
             textureTransition.oldUsage         = pTracker->textureUsage;
@@ -1811,11 +2680,16 @@ void RenderGraph::EmitCompiledNodeBarriers(RDGCompiledNode& compiledNode)
             textureTransition.oldAccessMode    = pTracker->accessMode;
             textureTransition.newAccessMode    = access.accessMode;
             textureTransition.subResourceRange = access.textureSubResourceRange;
-            textureTransitions.push_back(textureTransition);
+            if (pResource->transient)
+            {
+                // memory may have been used by an aliased resource, contents are discarded
+                textureTransition.oldUsage      = RHITextureUsage::eNone;
+                textureTransition.oldAccessMode = RHIAccessMode::eNone;
+            }
+            m_recordTextureTransitions.push_back(textureTransition);
         }
         else if (pResource->type == RDGResourceType::eBuffer)
         {
-            RDGResourceTracker* pTracker = s_trackerPool.GetTracker(pResource->pPhysicalRes);
             RHIBufferTransition bufferTransition;
             bufferTransition.pBuffer       = dynamic_cast<RHIBuffer*>(pResource->pPhysicalRes);
             bufferTransition.oldUsage      = pTracker->bufferUsage;
@@ -1823,38 +2697,56 @@ void RenderGraph::EmitCompiledNodeBarriers(RDGCompiledNode& compiledNode)
             bufferTransition.oldAccessMode = pTracker->accessMode;
             bufferTransition.newAccessMode = access.accessMode;
             bufferTransition.offset        = 0;
-            bufferTransitions.push_back(bufferTransition);
+            if (pResource->transient)
+            {
+                bufferTransition.oldUsage      = RHIBufferUsage::eNone;
+                bufferTransition.oldAccessMode = RHIAccessMode::eNone;
+            }
+            m_recordBufferTransitions.push_back(bufferTransition);
         }
     }
 
     for (const RHIBufferTransition& transition : compiledNode.prologueBufferTransitions)
     {
-        bufferTransitions.push_back(transition);
+        m_recordBufferTransitions.push_back(transition);
     }
 
     for (const RHITextureTransition& transition : compiledNode.prologueTextureTransitions)
     {
-        textureTransitions.push_back(transition);
+        m_recordTextureTransitions.push_back(transition);
     }
 
-    if (textureTransitions.empty() && bufferTransitions.empty())
+    outBarriers.numBufferTransitions =
+        static_cast<uint32_t>(m_recordBufferTransitions.size()) - outBarriers.firstBufferTransition;
+    outBarriers.numTextureTransitions = static_cast<uint32_t>(m_recordTextureTransitions.size()) -
+        outBarriers.firstTextureTransition;
+
+    for (uint32_t i = 0; i < outBarriers.numBufferTransitions; i++)
     {
-        return;
+        const RHIBufferTransition& transition =
+            m_recordBufferTransitions[outBarriers.firstBufferTransition + i];
+        s_trackerPool.UpdateTrackerState(transition.pBuffer, transition.newAccessMode,
+                                         transition.newUsage);
     }
 
-    for (const RHIBufferTransition& transition : bufferTransitions)
+    for (uint32_t i = 0; i < outBarriers.numTextureTransitions; i++)
+    {
+        const RHITextureTransition& transition =
+            m_recordTextureTransitions[outBarriers.firstTextureTransition + i];
+        s_trackerPool.UpdateTrackerState(transition.pTexture, transition.newAccessMode,
+                                         transition.newUsage);
+    }
+
+    for (const RHIBufferTransition& transition : compiledNode.splitBufferTransitions)
     {
         s_trackerPool.UpdateTrackerState(transition.pBuffer, transition.newAccessMode,
                                          transition.newUsage);
     }
 
-    for (const RHITextureTransition& transition : textureTransitions)
+    for (const RHITextureTransition& transition : compiledNode.splitTextureTransitions)
     {
         s_trackerPool.UpdateTrackerState(transition.pTexture, transition.newAccessMode,
                                          transition.newUsage);
     }
-
-    m_pCmdList->AddTransitions(compiledNode.prologueSrcStages, compiledNode.prologueDstStages, {},
-                               bufferTransitions, textureTransitions);
 }
 } // namespace zen::rc
@@ -1,5 +1,7 @@
+#include <numeric>
 #include "Graphics/RenderCore/V2/RenderScene.h"
 #include "Graphics/RenderCore/V2/RenderDevice.h"
+#include "Graphics/RenderCore/V2/RenderConfig.h"
 #include "Systems/SceneEditor.h"
 #include "SceneGraph/Camera.h"
 
@@ -10,11 +12,9 @@ RenderScene::RenderScene(RenderDevice* pRenderDevice, const SceneData& sceneData
 {
     m_pCamera = sceneData.pCamera;
     m_pScene  = sceneData.pScene;
-    if (sceneData.envTextureName.empty())
-    {
-        // use default env texture
-        m_envTextureName = "papermill.ktx";
-    }
+    // papermill.ktx is the default env texture
+    m_envTextureName =
+        sceneData.envTextureName.empty() ? "papermill.ktx" : sceneData.envTextureName;
 
     std::memcpy(m_sceneUniformData.lightPositions, sceneData.lightPositions,
                 sizeof(sceneData.lightPositions));
@@ -23,22 +23,61 @@ RenderScene::RenderScene(RenderDevice* pRenderDevice, const SceneData& sceneData
     std::memcpy(m_sceneUniformData.lightIntensities, sceneData.lightIntensities,
                 sizeof(sceneData.lightIntensities));
 
+    // node data comes from the transform hierarchy from here on, nodes moved later are picked up
+    // by Update
+    m_pScene->BuildTransformHierarchy();
     sys::SceneEditor::CenterAndNormalizeScene(m_pScene);
+    m_pScene->UpdateTransforms();
+    m_pScene->BuildBVH();
 
     for (auto* pNode : m_pScene->GetRenderableNodes())
     {
         m_nodesData.emplace_back(pNode->GetData());
     }
 
-    m_pVertexBuffer =
-        m_pRenderDevice->CreateVertexBuffer(sceneData.numVertices * sizeof(asset::Vertex),
-                                           reinterpret_cast<const uint8_t*>(sceneData.pVertices));
+    // with packed vertices only the compute voxelizer, used without geometry shaders, still reads
+    // the full layout
+    if (!RenderConfig::GetInstance().packedVertices ||
+        !m_pRenderDevice->GetGPUInfo().supportGeometryShader)
+    {
+        m_pVertexBuffer = m_pRenderDevice->CreateVertexBuffer(
+            sceneData.numVertices * sizeof(asset::Vertex),
+            reinterpret_cast<const uint8_t*>(sceneData.pVertices));
+    }
 
     m_pIndexBuffer =
         m_pRenderDevice->CreateIndexBuffer(sceneData.numIndices * sizeof(uint32_t),
                                           reinterpret_cast<const uint8_t*>(sceneData.pIndices));
 
     m_numIndices = sceneData.numIndices;
+
+    if (RenderConfig::GetInstance().packedVertices)
+    {
+        PackVertices(sceneData);
+    }
+}
+
+void RenderScene::PackVertices(const SceneData& sceneData)
+{
+    std::vector<asset::PackedVertex> packedVertices(sceneData.numVertices);
+    for (const sg::SubMesh* pSubMesh : m_pScene->GetComponents<sg::SubMesh>())
+    {
+        if (pSubMesh->GetIndexCount() == 0)
+        {
+            continue;
+        }
+        // submeshes own disjoint vertex ranges, find them through their indices
+        const uint32_t* pFirstIndex = sceneData.pIndices + pSubMesh->GetFirstIndex();
+        const auto [pMinIndex, pMaxIndex] =
+            std::minmax_element(pFirstIndex, pFirstIndex + pSubMesh->GetIndexCount());
+        m_vertexQuantizationBounds[pSubMesh] =
+            asset::PackVertices(sceneData.pVertices + *pMinIndex, *pMaxIndex - *pMinIndex + 1,
+                                packedVertices.data() + *pMinIndex);
+    }
+
+    m_pPackedVertexBuffer = m_pRenderDevice->CreateVertexBuffer(
+        packedVertices.size() * sizeof(asset::PackedVertex),
+        reinterpret_cast<const uint8_t*>(packedVertices.data()));
 }
 
 void RenderScene::Init()
@@ -109,11 +148,90 @@ void RenderScene::PrepareBuffers()
     m_pMaterialSSBO = m_pRenderDevice->CreateStorageBuffer(
         sizeof(sg::MaterialData) * m_materialsData.size(),
         reinterpret_cast<const uint8_t*>(m_materialsData.data()), "material_data_ssbo");
+
+    if (RenderConfig::GetInstance().gpuDrivenDraws)
+    {
+        PrepareDrawInstances();
+    }
+}
+
+void RenderScene::PrepareDrawInstances()
+{
+    const std::vector<DrawInstanceData> drawInstances = MakeDrawInstances();
+    m_numDrawInstances = static_cast<uint32_t>(drawInstances.size());
+
+    m_pDrawInstanceSSBO = m_pRenderDevice->CreateStorageBuffer(
+        sizeof(DrawInstanceData) * drawInstances.size(),
+        reinterpret_cast<const uint8_t*>(drawInstances.data()), "draw_instance_ssbo");
+}
+
+std::vector<DrawInstanceData> RenderScene::MakeDrawInstances() const
+{
+    // bounds are baked like the node data ssbo
+    const sg::SceneBVH& bvh = m_pScene->GetBVH();
+    std::vector<DrawInstanceData> drawInstances(bvh.GetNumItems());
+    for (uint32_t i = 0; i < bvh.GetNumItems(); i++)
+    {
+        drawInstances[i] = MakeDrawInstance(bvh.GetItem(i));
+    }
+    return drawInstances;
+}
+
+void RenderScene::UpdateNodesData()
+{
+    const auto& renderableNodes = m_pScene->GetRenderableNodes();
+    for (uint32_t i = 0; i < renderableNodes.size(); i++)
+    {
+        m_nodesData[i] = renderableNodes[i]->GetData();
+    }
+    m_pRenderDevice->UpdateBuffer(m_pNodeSSBO, sizeof(sg::NodeData) * m_nodesData.size(),
+                                  reinterpret_cast<const uint8_t*>(m_nodesData.data()));
+
+    if (m_pDrawInstanceSSBO != nullptr)
+    {
+        const std::vector<DrawInstanceData> drawInstances = MakeDrawInstances();
+        m_pRenderDevice->UpdateBuffer(m_pDrawInstanceSSBO,
+                                      sizeof(DrawInstanceData) * drawInstances.size(),
+                                      reinterpret_cast<const uint8_t*>(drawInstances.data()));
+    }
+}
+
+DrawInstanceData RenderScene::MakeDrawInstance(const sg::SceneBVH::Item& item)
+{
+    const sg::AABB bounds = sg::SceneBVH::TransformAABB(item.pSubMesh->GetAABB(),
+                                                        item.pNode->GetData().modelMatrix);
+
+    DrawInstanceData instance{};
+    instance.center        = Vec4(bounds.GetCenter(), 0.0f);
+    instance.extent        = Vec4(bounds.GetExtent3D() * 0.5f, 0.0f);
+    instance.indexCount    = item.pSubMesh->GetIndexCount();
+    instance.firstIndex    = item.pSubMesh->GetFirstIndex();
+    instance.nodeIndex     = item.pNode->GetRenderableIndex();
+    instance.materialIndex = item.pSubMesh->GetMaterial()->index;
+    return instance;
 }
 
 void RenderScene::Update()
 {
     m_sceneUniformData.viewPos = Vec4(m_pCamera->GetPos(), 1.0f);
+    // the BVH is refitted with the moved nodes, the renderers cull against it
+    if (m_pScene->UpdateTransforms())
+    {
+        UpdateNodesData();
+    }
+}
+
+void RenderScene::CullView(const Frustum& frustum, std::vector<uint32_t>& visibleItems) const
+{
+    visibleItems.clear();
+    const sg::SceneBVH& bvh = m_pScene->GetBVH();
+    if (!RenderConfig::GetInstance().frustumCulling)
+    {
+        visibleItems.resize(bvh.GetNumItems());
+        std::iota(visibleItems.begin(), visibleItems.end(), 0);
+        return;
+    }
+    bvh.Cull(frustum, visibleItems);
 }
 
 const sg::Camera* RenderScene::GetCamera() const
@@ -1,6 +1,8 @@
 #include "Graphics/RHI/RHIShaderUtil.h"
+#include "Graphics/RHI/RHIShaderReflectionCache.h"
 #include "Graphics/RenderCore/V2/ShaderProgram.h"
 #include "Graphics/RenderCore/V2/RenderDevice.h"
+#include "Graphics/RenderCore/V2/RenderConfig.h"
 #include "Memory/Memory.h"
 #include "Utils/Errors.h"
 #include <fstream>
@@ -198,14 +200,49 @@ void ShaderProgramManager::Destroy()
     {
         ZEN_DELETE(kv.second);
     }
+    m_programCache.clear();
 }
 
 void ShaderProgramManager::BuildShaderPrograms(RenderDevice* pRenderDevice)
 {
+    RenderConfig& config = RenderConfig::GetInstance();
+    if (config.gpuDrivenDraws &&
+        (!pRenderDevice->GetGPUInfo().supportDrawIndirectCount || config.packedVertices))
+    {
+        LOGW("GPU driven draws need draw indirect count support and the full vertex layout, "
+             "falling back to CPU submitted draws");
+        config.gpuDrivenDraws = false;
+    }
     {
         ShaderProgram* pShaderProgram             = ZEN_NEW() GBufferSP(pRenderDevice);
         m_programCache[pShaderProgram->GetName()] = pShaderProgram;
     }
+    if (config.packedVertices)
+    {
+        {
+            ShaderProgram* pShaderProgram             = ZEN_NEW() GBufferPackedSP(pRenderDevice);
+            m_programCache[pShaderProgram->GetName()] = pShaderProgram;
+        }
+        {
+            ShaderProgram* pShaderProgram = ZEN_NEW() ShadowMapRenderPackedSP(pRenderDevice);
+            m_programCache[pShaderProgram->GetName()] = pShaderProgram;
+        }
+    }
+    if (config.gpuDrivenDraws)
+    {
+        {
+            ShaderProgram* pShaderProgram             = ZEN_NEW() GBufferIndirectSP(pRenderDevice);
+            m_programCache[pShaderProgram->GetName()] = pShaderProgram;
+        }
+        {
+            ShaderProgram* pShaderProgram = ZEN_NEW() ShadowMapRenderIndirectSP(pRenderDevice);
+            m_programCache[pShaderProgram->GetName()] = pShaderProgram;
+        }
+        {
+            ShaderProgram* pShaderProgram             = ZEN_NEW() CullDrawsSP(pRenderDevice);
+            m_programCache[pShaderProgram->GetName()] = pShaderProgram;
+        }
+    }
     {
         ShaderProgram* pShaderProgram             = ZEN_NEW() DeferredLightingSP(pRenderDevice);
         m_programCache[pShaderProgram->GetName()] = pShaderProgram;
@@ -232,6 +269,11 @@ void ShaderProgramManager::BuildShaderPrograms(RenderDevice* pRenderDevice)
             ShaderProgram* pShaderProgram             = ZEN_NEW() VoxelizationSP(pRenderDevice);
             m_programCache[pShaderProgram->GetName()] = pShaderProgram;
         }
+        if (config.packedVertices)
+        {
+            ShaderProgram* pShaderProgram = ZEN_NEW() VoxelizationPackedSP(pRenderDevice);
+            m_programCache[pShaderProgram->GetName()] = pShaderProgram;
+        }
         {
             ShaderProgram* pShaderProgram             = ZEN_NEW() VoxelDrawSP(pRenderDevice);
             m_programCache[pShaderProgram->GetName()] = pShaderProgram;
@@ -273,5 +315,11 @@ void ShaderProgramManager::BuildShaderPrograms(RenderDevice* pRenderDevice)
         ShaderProgram* pShaderProgram             = ZEN_NEW() VoxelInjectRadianceSP(pRenderDevice);
         m_programCache[pShaderProgram->GetName()] = pShaderProgram;
     }
+
+    // every program is reflected by now, store new entries right away instead of at shutdown
+    RHIShaderReflectionCache* pReflectionCache = GDynamicRHI->GetShaderReflectionCache();
+    LOGI("Shader reflection cache: {} hits, {} misses", pReflectionCache->GetNumHits(),
+         pReflectionCache->GetNumMisses());
+    pReflectionCache->Save();
 }
 } // namespace zen::rc
\ No newline at end of file
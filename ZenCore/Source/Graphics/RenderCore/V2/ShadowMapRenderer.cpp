@@ -1,5 +1,6 @@
 #include "Graphics/RenderCore/V2/Renderer/ShadowMapRenderer.h"
 
+#include "Graphics/RenderCore/V2/RenderConfig.h"
 #include "Graphics/RenderCore/V2/RenderResource.h"
 #include "Graphics/RenderCore/V2/RenderScene.h"
 #include "Graphics/RenderCore/V2/ShaderProgram.h"
@@ -24,24 +25,42 @@ void ShadowMapRenderer::Init()
     PrepareTextures();
 
     BuildGraphicsPasses();
+
+    if (RenderConfig::GetInstance().gpuDrivenDraws)
+    {
+        m_indirectCuller = MakeUnique<IndirectDrawCuller>(m_pRenderDevice);
+        m_indirectCuller->Init("evsm");
+    }
 }
 
 void ShadowMapRenderer::Destroy()
 {
     m_pRenderDevice->DestroyTexture(m_offscreenTextures.pShadowMap);
     m_pRenderDevice->DestroyTexture(m_offscreenTextures.pDepth);
+    if (m_indirectCuller)
+    {
+        m_indirectCuller->Destroy();
+    }
 }
 
 void ShadowMapRenderer::SetRenderScene(RenderScene* pRenderScene)
 {
     m_pScene     = pRenderScene;
     m_lightView = sg::Camera::CreateOrthoOnAABB(m_pScene->GetAABB());
+    if (m_indirectCuller)
+    {
+        m_indirectCuller->SetRenderScene(m_pScene);
+    }
     UpdateUniformData();
     UpdateGraphicsPassResources();
 }
 
 void ShadowMapRenderer::PrepareRenderWorkload()
 {
+    if (!m_indirectCuller)
+    {
+        UpdateVisibleItems();
+    }
     if (m_rebuildRDG)
     {
         BuildRenderGraph();
@@ -106,11 +125,11 @@ void ShadowMapRenderer::PrepareTextures()
         texFormat.height      = m_config.shadowMapHeight;
         texFormat.depth       = 1;
         texFormat.arrayLayers = 1;
-        texFormat.mipmaps     = RHITexture::CalculateTextureMipLevels(m_config.shadowMapWidth,
-                                                                      m_config.shadowMapHeight);
+        texFormat.mipmaps     = 1;
 
+        // only read by the depth test of the evsm pass, its memory is reused once the pass is done
         m_offscreenTextures.pDepth = m_pRenderDevice->CreateTextureDepthStencilRT(
-            texFormat, {.copyUsage = false}, "shadowmap_render_depth");
+            texFormat, {.copyUsage = false, .transient = true}, "shadowmap_render_depth");
     }
     {
         RHISamplerCreateInfo samplerInfo{};
@@ -142,13 +161,16 @@ void ShadowMapRenderer::BuildGraphicsPasses()
         rc::GraphicsPassBuilder builder(m_pRenderDevice);
         m_gfxPasses.pEvsm =
             builder
-                .SetShaderProgramName("ShadowMapRenderSP")
+                .SetShaderProgramName(RenderConfig::GetInstance().gpuDrivenDraws ?
+                                          "ShadowMapRenderIndirectSP" :
+                                          "ShadowMapRenderSP")
                 // .SetNumSamples(SampleCount::e1)
                 .AddColorRenderTarget(m_offscreenTextures.pShadowMap)
                 .SetDepthStencilTarget(m_offscreenTextures.pDepth, RHIRenderTargetLoadOp::eClear,
-                                       RHIRenderTargetStoreOp::eStore)
+                                       RHIRenderTargetStoreOp::eNone)
                 .SetPipelineState(pso)
                 .SetFramebufferInfo(m_pViewport, m_config.shadowMapWidth, m_config.shadowMapHeight)
+                .SetAsyncPipelineCompile(true)
                 .SetTag("evsm")
                 .Build();
     }
@@ -158,6 +180,10 @@ void ShadowMapRenderer::BuildRenderGraph()
 {
     m_rdg = MakeUnique<RenderGraph>("shadowmap_rdg");
     m_rdg->Begin();
+    if (m_indirectCuller)
+    {
+        m_indirectCuller->AddCullPassNodes(m_rdg.Get());
+    }
     // offscreen pPass
     {
         ShadowMapRenderSP* pShaderProgram =
@@ -180,24 +206,41 @@ void ShadowMapRenderer::BuildRenderGraph()
         // m_rdg->DeclareTextureAccessForPass(
         //     pPass, m_offscreenTextures.depth, RHITextureUsage::eDepthStencilAttachment,
         //     RHITextureSubResourceRange::DepthStencil(), RHIAccessMode::eReadWrite);
-        m_rdg->AddGraphicsPassBindVertexBufferNode(pPass, m_pScene->GetVertexBuffer(), {0});
+        const bool packedVertices = RenderConfig::GetInstance().packedVertices;
+        m_rdg->AddGraphicsPassBindVertexBufferNode(
+            pPass,
+            packedVertices ? m_pScene->GetPackedVertexBuffer() : m_pScene->GetVertexBuffer(),
+            {0});
         m_rdg->AddGraphicsPassBindIndexBufferNode(pPass, m_pScene->GetIndexBuffer(),
                                                   DataFormat::eR32UInt);
         m_rdg->AddGraphicsPassSetViewportNode(pPass, viewport);
         m_rdg->AddGraphicsPassSetScissorNode(pPass, area);
         pShaderProgram->pushConstantsData.alphaCutoff = 0.01f;
         pShaderProgram->pushConstantsData.exponents   = m_config.exponents;
-        for (auto* node : m_pScene->GetRenderableNodes())
+        if (m_indirectCuller)
+        {
+            m_rdg->AddGraphicsPassSetPushConstants(pPass, &pShaderProgram->pushConstantsData,
+                                                   sizeof(ShadowMapRenderSP::PushConstantsData));
+            m_indirectCuller->AddDrawNode(m_rdg.Get(), pPass);
+        }
+        else if (packedVertices)
         {
-            pShaderProgram->pushConstantsData.nodeIndex = node->GetRenderableIndex();
-            for (auto* subMesh : node->GetComponent<sg::Mesh>()->GetSubMeshes())
+            AddPackedMeshDrawNodes(pPass);
+        }
+        else
+        {
+            const sg::SceneBVH& bvh = m_pScene->GetBVH();
+            for (uint32_t itemIndex : m_visibleItems)
             {
-                pShaderProgram->pushConstantsData.materialIndex = subMesh->GetMaterial()->index;
+                const sg::SceneBVH::Item& item = bvh.GetItem(itemIndex);
+                pShaderProgram->pushConstantsData.nodeIndex = item.pNode->GetRenderableIndex();
+                pShaderProgram->pushConstantsData.materialIndex =
+                    item.pSubMesh->GetMaterial()->index;
                 m_rdg->AddGraphicsPassSetPushConstants(
                     pPass, &pShaderProgram->pushConstantsData,
                     sizeof(ShadowMapRenderSP::PushConstantsData));
-                m_rdg->AddGraphicsPassDrawIndexedNode(pPass, subMesh->GetIndexCount(), 1,
-                                                      subMesh->GetFirstIndex(), 0, 0);
+                m_rdg->AddGraphicsPassDrawIndexedNode(pPass, item.pSubMesh->GetIndexCount(), 1,
+                                                      item.pSubMesh->GetFirstIndex(), 0, 0);
             }
         }
     }
@@ -205,6 +248,32 @@ void ShadowMapRenderer::BuildRenderGraph()
     m_rdg->End();
 }
 
+void ShadowMapRenderer::AddPackedMeshDrawNodes(RDGPassNode* pPass)
+{
+    ShadowMapRenderPackedSP* pShaderProgram =
+        dynamic_cast<ShadowMapRenderPackedSP*>(m_gfxPasses.pEvsm->pShaderProgram);
+    ShadowMapRenderSP::PushConstantsData& base = pShaderProgram->packedPushConstantsData.base;
+    base.exponents   = pShaderProgram->pushConstantsData.exponents;
+    base.alphaCutoff = pShaderProgram->pushConstantsData.alphaCutoff;
+    // the BVH holds no empty submeshes
+    const sg::SceneBVH& bvh = m_pScene->GetBVH();
+    for (uint32_t itemIndex : m_visibleItems)
+    {
+        const sg::SceneBVH::Item& item = bvh.GetItem(itemIndex);
+        const asset::VertexQuantizationBounds& bounds =
+            m_pScene->GetVertexQuantizationBounds(item.pSubMesh);
+        base.nodeIndex     = item.pNode->GetRenderableIndex();
+        base.materialIndex = item.pSubMesh->GetMaterial()->index;
+        pShaderProgram->packedPushConstantsData.posOffset = bounds.offset;
+        pShaderProgram->packedPushConstantsData.posScale  = bounds.scale;
+        m_rdg->AddGraphicsPassSetPushConstants(
+            pPass, &pShaderProgram->packedPushConstantsData,
+            sizeof(ShadowMapRenderPackedSP::PackedPushConstantsData));
+        m_rdg->AddGraphicsPassDrawIndexedNode(pPass, item.pSubMesh->GetIndexCount(), 1,
+                                              item.pSubMesh->GetFirstIndex(), 0, 0);
+    }
+}
+
 void ShadowMapRenderer::UpdateGraphicsPassResources()
 {
     {
@@ -219,6 +288,11 @@ void ShadowMapRenderer::UpdateGraphicsPassResources()
                                   m_pScene->GetNodesDataSSBO());
         ADD_SHADER_BINDING_SINGLE(set0bindings, 2, RHIShaderResourceType::eStorageBuffer,
                                   m_pScene->GetMaterialsDataSSBO());
+        if (m_indirectCuller)
+        {
+            ADD_SHADER_BINDING_SINGLE(set0bindings, 3, RHIShaderResourceType::eStorageBuffer,
+                                      m_pScene->GetDrawInstancesSSBO());
+        }
 
         // set-1 bindings
         // texture array
@@ -239,5 +313,20 @@ void ShadowMapRenderer::UpdateUniformData()
         reinterpret_cast<const sg::CameraUniformData*>(m_pScene->GetCameraUniformData());
     m_gfxPasses.pEvsm->pShaderProgram->UpdateUniformBuffer(
         "uLightInfo", reinterpret_cast<const uint8_t*>(&pCameraUniformData->projViewMatrix), 0);
+    m_lightFrustum.ExtractPlanes(pCameraUniformData->projViewMatrix);
+    if (m_indirectCuller)
+    {
+        m_indirectCuller->SetFrustum(m_lightFrustum);
+    }
+}
+
+void ShadowMapRenderer::UpdateVisibleItems()
+{
+    m_pScene->CullView(m_lightFrustum, m_cullResult);
+    if (m_cullResult != m_visibleItems)
+    {
+        m_visibleItems.swap(m_cullResult);
+        m_rebuildRDG = true;
+    }
 }
 } // namespace zen::rc
\ No newline at end of file
@@ -192,6 +192,7 @@ void SkyboxRenderer::BuildGraphicsPasses()
                                            RHIRenderTargetStoreOp::eStore)
                 .SetPipelineState(pso)
                 .SetFramebufferInfo(m_pViewport)
+                .SetAsyncPipelineCompile(true)
                 .SetTag("SkyboxDraw")
                 .Build();
     }
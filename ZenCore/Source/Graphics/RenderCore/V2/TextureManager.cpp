@@ -150,11 +150,36 @@ void TextureManager::LoadSceneTextures(const sg::Scene* pScene,
         texFormat.height      = pSgTexture->height;
         texFormat.depth       = 1;
         texFormat.arrayLayers = 1;
-        texFormat.mipmaps     = 1;
+        texFormat.mipmaps     = pSgTexture->mipLevels;
 
         RHITexture* pTexture = m_pRenderDevice->CreateTextureSampled(texFormat, {.copyUsage = true},
                                                                      pSgTexture->GetName());
-        UpdateTexture(pTexture, pSgTexture->bytesData.size(), pSgTexture->bytesData.data());
+        if (pSgTexture->mipLevels > 1)
+        {
+            // pre-built mip chain from a cooked scene, one copy region per level
+            HeapVector<RHIBufferTextureCopyRegion> regions;
+            regions.reserve(pSgTexture->mipLevels);
+            uint32_t offset = 0;
+            for (uint32_t level = 0; level < pSgTexture->mipLevels; level++)
+            {
+                const uint32_t width  = std::max(pSgTexture->width >> level, 1u);
+                const uint32_t height = std::max(pSgTexture->height >> level, 1u);
+                RHIBufferTextureCopyRegion region{};
+                region.textureSubresources.aspect.SetFlag(RHITextureAspectFlagBits::eColor);
+                region.textureSubresources.mipmap     = level;
+                region.textureSubresources.layerCount = 1;
+                region.textureSize                    = {width, height, 1};
+                region.bufferOffset                   = offset;
+                regions.push_back(region);
+                offset += width * height * 4;
+            }
+            UpdateTextureRegions(pTexture, regions, pSgTexture->bytesData.size(),
+                                 pSgTexture->bytesData.data());
+        }
+        else
+        {
+            UpdateTexture(pTexture, pSgTexture->bytesData.size(), pSgTexture->bytesData.data());
+        }
         m_textureCache[pSgTexture->GetName()] = pTexture;
         outTextures.push_back(pTexture);
     }
@@ -219,8 +244,8 @@ void TextureManager::LoadTextureEnv(const std::string& file, EnvTexture* pOutTex
         }
     }
 
-    UpdateTextureCube(pTexture, regions, texCube.size(),
-                      static_cast<const uint8_t*>(texCube.data()));
+    UpdateTextureRegions(pTexture, regions, texCube.size(),
+                         static_cast<const uint8_t*>(texCube.data()));
 
     m_textureCache[file] = pTexture;
 
@@ -267,10 +292,10 @@ void TextureManager::UpdateTexture(RHITexture* pTexture,
     });
 }
 
-void TextureManager::UpdateTextureCube(RHITexture* pTexture,
-                                       const HeapVector<RHIBufferTextureCopyRegion>& regions,
-                                       uint32_t dataSize,
-                                       const uint8_t* pData)
+void TextureManager::UpdateTextureRegions(RHITexture* pTexture,
+                                          const HeapVector<RHIBufferTextureCopyRegion>& regions,
+                                          uint32_t dataSize,
+                                          const uint8_t* pData)
 {
     RHIBuffer* pStagingBuffer = m_pStagingMgr->RequireBuffer(dataSize);
     // map staging buffer
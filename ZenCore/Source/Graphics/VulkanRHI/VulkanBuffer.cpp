@@ -19,6 +19,12 @@ void VulkanRHI::DestroyBuffer(RHIBuffer* pBuffer)
     pBuffer->ReleaseReference();
 }
 
+void VulkanRHI::BindBufferMemory(RHIBuffer* pBuffer, RHIMemoryBlock* pMemoryBlock, uint64_t offset)
+{
+    dynamic_cast<VulkanBuffer*>(pBuffer)->BindMemory(
+        dynamic_cast<VulkanMemoryBlock*>(pMemoryBlock), offset);
+}
+
 RHIBuffer* VulkanResourceFactory::CreateBuffer(const RHIBufferCreateInfo& createInfo)
 {
     RHIBuffer* pBuffer = VulkanBuffer::CreateObject(createInfo);
@@ -65,11 +71,31 @@ void VulkanBuffer::Init()
         bufferCI.pQueueFamilyIndices   = queueFamilyIndices;
     }
 
+    if (m_transient)
+    {
+        // memory is bound later by the render graph
+        VKCHECK(vkCreateBuffer(GVulkanRHI->GetVkDevice(), &bufferCI, nullptr, &m_vkBuffer));
+        VkMemoryRequirements memRequirements{};
+        vkGetBufferMemoryRequirements(GVulkanRHI->GetVkDevice(), m_vkBuffer, &memRequirements);
+        m_memoryRequirements.size           = memRequirements.size;
+        m_memoryRequirements.alignment      = memRequirements.alignment;
+        m_memoryRequirements.memoryTypeBits = memRequirements.memoryTypeBits;
+        m_allocatedSize                     = memRequirements.size;
+        return;
+    }
+
     GVkMemAllocator->AllocBuffer(m_requiredSize, &bufferCI, m_allocateType, &m_vkBuffer,
                                  &m_memAlloc);
     m_allocatedSize = m_memAlloc.info.size;
 }
 
+void VulkanBuffer::BindMemory(const VulkanMemoryBlock* pMemoryBlock, uint64_t offset)
+{
+    VERIFY_EXPR_MSG(m_transient && !m_bound, "only transient buffers are bound, and only once");
+    GVkMemAllocator->BindBufferMemory(pMemoryBlock->GetMemoryAllocation(), offset, m_vkBuffer);
+    m_bound = true;
+}
+
 void VulkanBuffer::Destroy()
 {
     if (m_bufferView != VK_NULL_HANDLE)
@@ -77,7 +103,15 @@ void VulkanBuffer::Destroy()
         vkDestroyBufferView(GVulkanRHI->GetVkDevice(), m_bufferView, nullptr);
     }
 
-    GVkMemAllocator->FreeBuffer(m_vkBuffer, m_memAlloc);
+    if (m_transient)
+    {
+        // the memory belongs to the block it was bound to
+        vkDestroyBuffer(GVulkanRHI->GetVkDevice(), m_vkBuffer, nullptr);
+    }
+    else
+    {
+        GVkMemAllocator->FreeBuffer(m_vkBuffer, m_memAlloc);
+    }
     this->~VulkanBuffer();
 
     VersatileResource::Free(GVulkanRHI->GetResourceAllocator(), this);
@@ -357,8 +357,10 @@ void VulkanCommandContextBase::SubmitRecordedWorkloads()
     CollectWorkloads(workloadsToSubmit);
     if (workloadsToSubmit.empty())
     {
+        ReconcileImageLayouts(nullptr);
         return;
     }
+    ReconcileImageLayouts(workloadsToSubmit[0]);
 
     for (VulkanWorkload* pWorkload : workloadsToSubmit)
     {
@@ -380,7 +382,7 @@ void VulkanCommandContextBase::WaitForLastSubmittedWork(uint64_t timeToWaitNS)
     m_lastSubmittedSerial = 0;
 }
 
-void VulkanCommandContextBase::SetupNewCommandBuffer()
+FVulkanCommandBuffer* VulkanCommandContextBase::AcquireCommandBuffer()
 {
     LockAuto lock(&m_pCmdBufferPool->m_mutex);
 
@@ -426,8 +428,23 @@ void VulkanCommandContextBase::SetupNewCommandBuffer()
     }
 #endif
 
-    m_pCurrentWorkload->AddCommandBuffer(pCmdBuffer);
     pCmdBuffer->Begin();
+    return pCmdBuffer;
+}
+
+void VulkanCommandContextBase::SetupNewCommandBuffer()
+{
+    m_pCurrentWorkload->AddCommandBuffer(AcquireCommandBuffer());
+}
+
+FVulkanCommandBuffer* VulkanCommandContextBase::PrependCommandBuffer(VulkanWorkload* pWorkload)
+{
+    FVulkanCommandBuffer* pCmdBuffer = AcquireCommandBuffer();
+    HeapVector<FVulkanCommandBuffer*> cmdBuffers;
+    cmdBuffers.push_back(pCmdBuffer);
+    cmdBuffers.push_back(pWorkload->m_commandBuffers);
+    pWorkload->m_commandBuffers = std::move(cmdBuffers);
+    return pCmdBuffer;
 }
 
 void VulkanCommandContextBase::StartWorkload()
@@ -826,6 +843,30 @@ void FVulkanCommandListContext::RHIDrawIndexedIndirect(RHIBuffer* pIndirectBuffe
                              stride);
 }
 
+void FVulkanCommandListContext::RHIDrawIndexedIndirectCount(RHIBuffer* pIndirectBuffer,
+                                                            RHIBuffer* pIndexBuffer,
+                                                            DataFormat indexFormat,
+                                                            uint32_t indexBufferOffset,
+                                                            uint32_t offset,
+                                                            RHIBuffer* pCountBuffer,
+                                                            uint32_t countBufferOffset,
+                                                            uint32_t maxDrawCount,
+                                                            uint32_t stride)
+{
+    VERIFY_EXPR(m_pDevice->SupportsDrawIndirectCount());
+    m_pGfxState->PreDraw(this);
+
+    FVulkanCommandBuffer* pCmdBuffer = GetCommandBuffer();
+    VkIndexType vkIndexType =
+        indexFormat == DataFormat::eR16UInt ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+
+    vkCmdBindIndexBuffer(pCmdBuffer->GetVkHandle(), TO_VK_BUFFER(pIndexBuffer)->GetVkBuffer(),
+                         indexBufferOffset, vkIndexType);
+    vkCmdDrawIndexedIndirectCountKHR(
+        pCmdBuffer->GetVkHandle(), TO_VK_BUFFER(pIndirectBuffer)->GetVkBuffer(), offset,
+        TO_VK_BUFFER(pCountBuffer)->GetVkBuffer(), countBufferOffset, maxDrawCount, stride);
+}
+
 void FVulkanCommandListContext::RHIDispatch(uint32_t groupCountX,
                                             uint32_t groupCountY,
                                             uint32_t groupCountZ)
@@ -867,15 +908,34 @@ void FVulkanCommandListContext::RHIAddTransitions(
     }
 
     VulkanPipelineBarrier barrier;
-    bool hasBarrier = false;
-
     for (const auto& memoryTransition : memoryTransitions)
     {
         barrier.AddMemoryBarrier(ToVkAccessFlags(memoryTransition.srcAccess),
                                  ToVkAccessFlags(memoryTransition.dstAccess));
-        hasBarrier = true;
     }
+    AddTransitionBarriers(bufferTransitions, textureTransitions, barrier);
 
+    // every transition of the call goes into one barrier command
+    if (!barrier.IsEmpty())
+    {
+        VkCommandBuffer cmdBuffer = GetCommandBuffer()->GetVkHandle();
+        if (m_pDevice->SupportsSynchronization2())
+        {
+            barrier.Execute2(cmdBuffer, srcStages, dstStages);
+        }
+        else
+        {
+            barrier.Execute(cmdBuffer, srcStages, dstStages);
+        }
+    }
+    FinalizePendingRenderPassWorkload();
+}
+
+void FVulkanCommandListContext::AddTransitionBarriers(
+    VectorView<RHIBufferTransition> bufferTransitions,
+    VectorView<RHITextureTransition> textureTransitions,
+    VulkanPipelineBarrier& barrier)
+{
     for (const auto& bufferTransition : bufferTransitions)
     {
         VulkanBuffer* pVulkanBuffer = TO_VK_BUFFER(bufferTransition.pBuffer);
@@ -885,7 +945,6 @@ void FVulkanCommandListContext::RHIAddTransitions(
                                                                      bufferTransition.newAccessMode);
         barrier.AddBufferBarrier(pVulkanBuffer->GetVkBuffer(), bufferTransition.offset,
                                  bufferTransition.size, srcAccess, dstAccess);
-        hasBarrier = true;
     }
 
     for (const auto& textureTransition : textureTransitions)
@@ -896,9 +955,20 @@ void FVulkanCommandListContext::RHIAddTransitions(
             textureTransition.oldUsage, textureTransition.oldAccessMode));
         VkAccessFlags dstAccess = ToVkAccessFlags(RHITextureUsageToAccessFlagBits(
             textureTransition.newUsage, textureTransition.newAccessMode));
-        // VkImageLayout oldLayout =
-        //     ToVkImageLayout(RHITextureUsageToLayout(textureTransition.oldUsage));
-        VkImageLayout oldLayout = GVulkanRHI->GetImageCurrentLayout(pVulkanTexture->GetVkImage());
+        VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (textureTransition.oldUsage != RHITextureUsage::eNone)
+        {
+            // the render graph resolved the usage in submission order, earlier lists of the
+            // frame may not have published their layouts yet
+            oldLayout = GetImageLayout(
+                pVulkanTexture,
+                ToVkImageLayout(RHITextureUsageToLayout(textureTransition.oldUsage)));
+        }
+        // the memory of a transient texture may hold another resource, discard the contents
+        else if (!pVulkanTexture->IsTransient())
+        {
+            oldLayout = GetImageLayout(pVulkanTexture);
+        }
         VkImageLayout newLayout =
             ToVkImageLayout(RHITextureUsageToLayout(textureTransition.newUsage));
         // filter
@@ -916,15 +986,57 @@ void FVulkanCommandListContext::RHIAddTransitions(
 
         barrier.AddImageBarrier(pVulkanTexture->GetVkImage(), oldLayout, newLayout,
                                 subresourceRange, srcAccess, dstAccess);
-        GVulkanRHI->UpdateImageLayout(pVulkanTexture->GetVkImage(), newLayout);
-        hasBarrier = true;
+        SetImageLayout(pVulkanTexture->GetVkImage(), newLayout);
     }
+}
 
-    if (hasBarrier)
+void FVulkanCommandListContext::RHISetBarrierEvent(
+    RHIBarrierEvent* pEvent,
+    BitField<RHIPipelineStageBits> srcStages,
+    BitField<RHIPipelineStageBits> dstStages,
+    VectorView<RHIBufferTransition> bufferTransitions,
+    VectorView<RHITextureTransition> textureTransitions)
+{
+    FinalizePendingRenderPassWorkload();
+    VulkanBarrierEventManager* pEventManager = m_pDevice->GetBarrierEventManager();
+    pEvent->handle                           = pEventManager->AllocateEvent();
+
+    // the layouts are resolved here, the wait only repeats them
+    VulkanBarrierEventManager::BarrierEvent* pBarrierEvent =
+        pEventManager->GetEvent(pEvent->handle);
+    pBarrierEvent->srcStageFlags = static_cast<VkPipelineStageFlags>(srcStages);
+    pBarrierEvent->dstStageFlags = static_cast<VkPipelineStageFlags>(dstStages);
+    AddTransitionBarriers(bufferTransitions, textureTransitions, pBarrierEvent->barrier);
+    if (pBarrierEvent->event != VK_NULL_HANDLE)
     {
-        barrier.Execute(GetCommandBuffer()->GetVkHandle(), srcStages, dstStages);
+        pBarrierEvent->barrier.SetEvent2(GetCommandBuffer()->GetVkHandle(), pBarrierEvent->event,
+                                         pBarrierEvent->srcStageFlags,
+                                         pBarrierEvent->dstStageFlags);
     }
+}
+
+void FVulkanCommandListContext::RHIWaitBarrierEvent(RHIBarrierEvent* pEvent)
+{
+    VERIFY_EXPR_MSG(pEvent->handle != 0, "Barrier event waited on before it is set");
     FinalizePendingRenderPassWorkload();
+    VulkanBarrierEventManager* pEventManager = m_pDevice->GetBarrierEventManager();
+    VulkanBarrierEventManager::BarrierEvent* pBarrierEvent =
+        pEventManager->GetEvent(pEvent->handle);
+    VkCommandBuffer cmdBuffer = GetCommandBuffer()->GetVkHandle();
+    if (pBarrierEvent->event != VK_NULL_HANDLE)
+    {
+        pBarrierEvent->barrier.WaitEvent2(cmdBuffer, pBarrierEvent->event,
+                                          pBarrierEvent->srcStageFlags,
+                                          pBarrierEvent->dstStageFlags);
+    }
+    else
+    {
+        // no events without synchronization2, the whole barrier happens at the wait
+        pBarrierEvent->barrier.Execute(cmdBuffer, pBarrierEvent->srcStageFlags,
+                                       pBarrierEvent->dstStageFlags);
+    }
+    pEventManager->ReleaseEvent(pEvent->handle);
+    pEvent->handle = 0;
 }
 
 void FVulkanCommandListContext::RHIGenTextureMipmaps(RHITexture* pTexture)
@@ -941,7 +1053,7 @@ void FVulkanCommandListContext::RHIGenTextureMipmaps(RHITexture* pTexture)
     const uint32_t texHeight = pTexture->GetBaseInfo().height;
 
     // store image's original layout
-    VkImageLayout originLayout = GVulkanRHI->GetImageCurrentLayout(vkImage);
+    VkImageLayout originLayout = GetImageLayout(pVulkanTexture);
     // Transition first mip level to transfer source for read during blit
     // ChangeImageLayout(vkImage, originLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
     //                   vulkanTexture->GetVkSubresourceRange());
@@ -1011,13 +1123,13 @@ void FVulkanCommandListContext::RHIAddTextureTransition(RHITexture* pTexture,
     VulkanTexture* pVulkanTexture = TO_VK_TEXTURE(pTexture);
     VkImage vkImage               = pVulkanTexture->GetVkImage();
 
-    VkImageLayout srcLayout = GVulkanRHI->GetImageCurrentLayout(vkImage);
+    VkImageLayout srcLayout = GetImageLayout(pVulkanTexture);
     VkImageLayout dstLayout = ToVkImageLayout(newLayout);
 
     VulkanPipelineBarrier barrier;
     barrier.AddImageBarrier(vkImage, srcLayout, dstLayout, pVulkanTexture->GetVkSubresourceRange());
     barrier.ExecuteImageBarriersOnly(GetCommandBuffer()->GetVkHandle());
-    GVulkanRHI->UpdateImageLayout(vkImage, dstLayout);
+    SetImageLayout(vkImage, dstLayout);
     FinalizePendingRenderPassWorkload();
 }
 
@@ -1132,6 +1244,65 @@ void FVulkanCommandListContext::RHIResolveTexture(RHITexture* pSrcTexture,
                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 }
 
+VkImageLayout FVulkanCommandListContext::GetImageLayout(VulkanTexture* pVulkanTexture,
+                                                        VkImageLayout expectedLayout)
+{
+    const VkImage vkImage = pVulkanTexture->GetVkImage();
+    auto it               = m_imageLayouts.find(vkImage);
+    if (it != m_imageLayouts.end())
+    {
+        return it->second;
+    }
+
+    const VkImageLayout layout = expectedLayout != VK_IMAGE_LAYOUT_UNDEFINED ?
+        expectedLayout :
+        GVulkanRHI->GetImageCurrentLayout(vkImage);
+    m_initialImageLayouts[vkImage] = {layout, pVulkanTexture->GetVkSubresourceRange()};
+    m_imageLayouts[vkImage]        = layout;
+    return layout;
+}
+
+void FVulkanCommandListContext::SetImageLayout(VkImage image, VkImageLayout layout)
+{
+    m_imageLayouts[image] = layout;
+}
+
+void FVulkanCommandListContext::ReconcileImageLayouts(VulkanWorkload* pFirstWorkload)
+{
+    // nothing was recorded, no layout changed either
+    if (pFirstWorkload == nullptr)
+    {
+        m_initialImageLayouts.clear();
+        m_imageLayouts.clear();
+        return;
+    }
+
+    // the lists before this one are submitted, the RHI wide layouts are current again
+    VulkanPipelineBarrier barrier;
+    for (const auto& kv : m_initialImageLayouts)
+    {
+        const VkImageLayout currentLayout = GVulkanRHI->GetImageCurrentLayout(kv.first);
+        // an undefined expectation discards the contents anyway
+        if (kv.second.layout != VK_IMAGE_LAYOUT_UNDEFINED && currentLayout != kv.second.layout)
+        {
+            barrier.AddImageBarrier(kv.first, currentLayout, kv.second.layout, kv.second.range);
+        }
+    }
+    if (!barrier.IsEmpty())
+    {
+        FVulkanCommandBuffer* pCmdBuffer = PrependCommandBuffer(pFirstWorkload);
+        barrier.ExecuteImageBarriersOnly(pCmdBuffer->GetVkHandle());
+        pCmdBuffer->End();
+    }
+
+    for (const auto& kv : m_imageLayouts)
+    {
+        GVulkanRHI->UpdateImageLayout(kv.first, kv.second);
+    }
+    m_initialImageLayouts.clear();
+    m_imageLayouts.clear();
+}
+
 void FVulkanCommandListContext::RHIWaitUntilCompleted()
 {
     WaitForLastSubmittedWork(UINT64_MAX);
@@ -1139,11 +1310,13 @@ void FVulkanCommandListContext::RHIWaitUntilCompleted()
 
 VulkanPlatformCommandList* VulkanRHI::AcquirePlatformCommandList()
 {
+    LockAuto lock(&m_platformCommandListPoolMutex);
     return m_platformCommandListPool.Acquire();
 }
 
 void VulkanRHI::ReleasePlatformCommandList(VulkanPlatformCommandList* pCommandList)
 {
+    LockAuto lock(&m_platformCommandListPoolMutex);
     m_platformCommandListPool.Release(pCommandList);
 }
 
@@ -1152,37 +1325,42 @@ void VulkanRHI::DestroyPlatformCommandListPool()
     m_platformCommandListPool.Destroy();
 }
 
-void VulkanRHI::FinalizeCommandLists(VectorView<RHICommandList*> cmdLists,
-                                     HeapVector<RHIPlatformCommandList*>& outCommandLists)
+RHIPlatformCommandList* VulkanRHI::FinalizeCommandList(RHICommandList* pCmdList)
 {
-    if (cmdLists.empty())
+    VulkanPlatformCommandList* pPlatformCmdList = AcquirePlatformCommandList();
+
+    pCmdList->Execute();
+
+    FVulkanCommandListContext* pContext =
+        static_cast<FVulkanCommandListContext*>(pCmdList->GetContext());
+    pContext->CollectWorkloads(pPlatformCmdList->m_workloads);
+
+    if (pPlatformCmdList->m_workloads.empty())
     {
-        return;
+        pContext->ReconcileImageLayouts(nullptr);
+        ReleasePlatformCommandList(pPlatformCmdList);
+        return nullptr;
     }
 
+    pPlatformCmdList->m_contextWorkloadRanges.push_back(
+        VulkanPlatformCommandList::ContextWorkloadRange{
+            pContext,
+            0,
+            static_cast<uint32_t>(pPlatformCmdList->m_workloads.size()),
+        });
+    return pPlatformCmdList;
+}
+
+void VulkanRHI::FinalizeCommandLists(VectorView<RHICommandList*> cmdLists,
+                                     HeapVector<RHIPlatformCommandList*>& outCommandLists)
+{
     for (RHICommandList* pCmdList : cmdLists)
     {
-        VulkanPlatformCommandList* pPlatformCmdList = AcquirePlatformCommandList();
-
-        pCmdList->Execute();
-
-        FVulkanCommandListContext* pContext =
-            static_cast<FVulkanCommandListContext*>(pCmdList->GetContext());
-        pContext->CollectWorkloads(pPlatformCmdList->m_workloads);
-
-        if (pPlatformCmdList->m_workloads.empty())
+        RHIPlatformCommandList* pPlatformCmdList = FinalizeCommandList(pCmdList);
+        if (pPlatformCmdList != nullptr)
         {
-            ReleasePlatformCommandList(pPlatformCmdList);
-            continue;
+            outCommandLists.push_back(pPlatformCmdList);
         }
-
-        pPlatformCmdList->m_contextWorkloadRanges.push_back(
-            VulkanPlatformCommandList::ContextWorkloadRange{
-                pContext,
-                0,
-                static_cast<uint32_t>(pPlatformCmdList->m_workloads.size()),
-            });
-        outCommandLists.push_back(pPlatformCmdList);
     }
 }
 
@@ -1192,6 +1370,13 @@ void VulkanRHI::SubmitPlatformCommandLists(VectorView<RHIPlatformCommandList*> c
     {
         VulkanPlatformCommandList* pPlatformCmdList =
             static_cast<VulkanPlatformCommandList*>(pCommandList);
+        // the lists may have been finalized in parallel, settle the image layouts in order
+        for (const VulkanPlatformCommandList::ContextWorkloadRange& contextWorkloadRange :
+             pPlatformCmdList->m_contextWorkloadRanges)
+        {
+            contextWorkloadRange.pContext->ReconcileImageLayouts(
+                pPlatformCmdList->m_workloads[contextWorkloadRange.firstWorkloadIndex]);
+        }
         for (VulkanWorkload* pWorkload : pPlatformCmdList->m_workloads)
         {
             pWorkload->m_pQueue->m_workloadsPendingSubmit.Push(pWorkload);
@@ -1,4 +1,6 @@
 #include "Graphics/VulkanRHI/VulkanRHI.h"
+#include "Graphics/RHI/RHIOptions.h"
+#include "Graphics/RHI/RHIShaderReflectionCache.h"
 #include "Graphics/VulkanRHI/VulkanCommon.h"
 #include "Graphics/VulkanRHI/VulkanDevice.h"
 #include "Graphics/VulkanRHI/VulkanExtension.h"
@@ -541,7 +543,7 @@ void VulkanRHI::SelectGPU()
     m_pDevice = ZEN_NEW() VulkanDevice(physicalDevices[selectedIndex]);
 }
 
-VulkanRHI::VulkanRHI() : m_resourceAllocator(ZEN_DEFAULT_PAGESIZE, false)
+VulkanRHI::VulkanRHI() : m_resourceAllocator(ZEN_DEFAULT_PAGESIZE, true)
 {
 #if defined(ZEN_MACOS)
     setenv("MVK_CONFIG_USE_METAL_ARGUMENT_BUFFERS", "1", 1);
@@ -609,11 +611,15 @@ void VulkanRHI::Init()
 {
     m_pResourceFactory = ZEN_NEW() VulkanResourceFactory();
 
+    m_pShaderReflectionCache = ZEN_NEW() RHIShaderReflectionCache();
+    m_pShaderReflectionCache->Load(RHIOptions::GetInstance().ShaderReflectionCachePath());
+
     CreateInstance();
     SelectGPU();
     m_pDevice->Init();
 
-    m_gpuInfo.supportGeometryShader = m_pDevice->GetPhysicalDeviceFeatures().geometryShader;
+    m_gpuInfo.supportGeometryShader    = m_pDevice->GetPhysicalDeviceFeatures().geometryShader;
+    m_gpuInfo.supportDrawIndirectCount = m_pDevice->SupportsDrawIndirectCount();
     m_gpuInfo.uniformBufferAlignment =
         m_pDevice->GetPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment;
     m_gpuInfo.storageBufferAlignment =
@@ -669,6 +675,9 @@ void VulkanRHI::Destroy()
 
     ZEN_DELETE(m_pResourceFactory);
 
+    m_pShaderReflectionCache->Save();
+    ZEN_DELETE(m_pShaderReflectionCache);
+
     // destroy debug utils messenger
     vkDestroyDebugUtilsMessengerEXT(m_instance, m_messenger, nullptr);
     // destroy instance
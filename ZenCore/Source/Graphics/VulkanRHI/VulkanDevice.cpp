@@ -7,6 +7,8 @@
 #include "Graphics/VulkanRHI/VulkanCommon.h"
 #include "Graphics/VulkanRHI/VulkanCommands.h"
 #include "Graphics/VulkanRHI/VulkanSynchronization.h"
+#include "Graphics/VulkanRHI/VulkanPipelineCache.h"
+#include "Graphics/RHI/RHIOptions.h"
 
 namespace zen
 {
@@ -127,6 +129,10 @@ void VulkanDevice::Init()
 
     m_pFenceManager    = ZEN_NEW() VulkanFenceManager(this);
     m_pSemaphoreManger = ZEN_NEW() VulkanSemaphoreManager(this);
+    m_pBarrierEventManager = ZEN_NEW() VulkanBarrierEventManager(this);
+
+    m_pPipelineCache = ZEN_NEW() VulkanPipelineCache();
+    m_pPipelineCache->Init(this, RHIOptions::GetInstance().VKPipelineCachePath());
 
     // m_legacyImmediateContext     = ZEN_NEW() LegacyVulkanCommandListContext(GVulkanRHI);
     // m_legacyImmediateCommandList = ZEN_NEW() LegacyVulkanCommandList(m_legacyImmediateContext);
@@ -279,6 +285,13 @@ void VulkanDevice::WaitForIdle()
 
 void VulkanDevice::Destroy()
 {
+    if (m_pBarrierEventManager != nullptr)
+    {
+        m_pBarrierEventManager->Destroy();
+        ZEN_DELETE(m_pBarrierEventManager);
+        m_pBarrierEventManager = nullptr;
+    }
+
     ZEN_DELETE(m_pGfxQueue);
     ZEN_DELETE(m_pComputeQueue);
     ZEN_DELETE(m_pTransferQueue);
@@ -289,6 +302,9 @@ void VulkanDevice::Destroy()
     m_pFenceManager->Destroy();
     ZEN_DELETE(m_pFenceManager);
 
+    m_pPipelineCache->Destroy();
+    ZEN_DELETE(m_pPipelineCache);
+
     vkDestroyDevice(m_device, nullptr);
 }
 
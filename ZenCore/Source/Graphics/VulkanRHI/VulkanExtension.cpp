@@ -148,6 +148,46 @@ private:
     VkPhysicalDeviceTimelineSemaphoreFeatures m_timelineSemaphoreFeatures{};
 };
 
+/**
+ * VK_KHR_synchronization2
+ */
+class VulkanSynchronization2Extension : public VulkanDeviceExtension
+{
+public:
+    VulkanSynchronization2Extension(VulkanDevice* pDevice) :
+        VulkanDeviceExtension(pDevice, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)
+    {
+        InitVkStruct(m_synchronization2Features,
+                     VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR);
+    }
+
+    void BeforePhysicalDeviceFeatures(
+        VkPhysicalDeviceFeatures2KHR& physicalDeviceFeatures2Khr) final
+    {
+        AddToPNext(physicalDeviceFeatures2Khr, m_synchronization2Features);
+    }
+
+    void AfterPhysicalDeviceFeatures() final
+    {
+        if (m_synchronization2Features.synchronization2 == VK_TRUE)
+        {
+            SetSupport();
+            m_pDevice->GetExtensionFlags().hasSynchronization2 = 1;
+        }
+    }
+
+    void BeforeCreateDevice(VkDeviceCreateInfo& DeviceCI) final
+    {
+        if (IsEnabledAndSupported())
+        {
+            AddToPNext(DeviceCI, m_synchronization2Features);
+        }
+    }
+
+private:
+    VkPhysicalDeviceSynchronization2FeaturesKHR m_synchronization2Features{};
+};
+
 /**
  * VK_KHR_buffer_device_address
  */
@@ -311,6 +351,26 @@ private:
     VkPhysicalDeviceRayQueryFeaturesKHR m_rayQueryFeature;
 };
 
+/**
+ * VK_KHR_draw_indirect_count
+ */
+class VulkanDrawIndirectCountExtension : public VulkanDeviceExtension
+{
+public:
+    VulkanDrawIndirectCountExtension(VulkanDevice* pDevice) :
+        VulkanDeviceExtension(pDevice, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME)
+    {}
+
+    // no feature struct, support is known once the extension list is checked
+    void BeforeCreateDevice(VkDeviceCreateInfo& DeviceCI) final
+    {
+        if (IsEnabledAndSupported())
+        {
+            m_pDevice->GetExtensionFlags().hasDrawIndirectCount = 1;
+        }
+    }
+};
+
 static int FindExtensionIndex(const char* pExtensionName,
                               const HeapVector<VkExtensionProperties>& supported)
 {
@@ -436,6 +496,8 @@ VulkanDeviceExtensionArray VulkanDeviceExtension::GetEnabledExtensions(VulkanDev
     ADD_ADVANCED_DEVICE_EXTENSION(VulkanRayQueryExtension)
     ADD_ADVANCED_DEVICE_EXTENSION(VulkanDynamicRenderingExtension)
     ADD_ADVANCED_DEVICE_EXTENSION(VulkanTimelineSemaphoreExtension)
+    ADD_ADVANCED_DEVICE_EXTENSION(VulkanSynchronization2Extension)
+    ADD_ADVANCED_DEVICE_EXTENSION(VulkanDrawIndirectCountExtension)
 
     FlagExtensionSupported(
         enabledExtensions,
@@ -1,5 +1,7 @@
 #include "Graphics/VulkanRHI/VulkanMemory.h"
 #include "Graphics/VulkanRHI/VulkanCommon.h"
+#include "Graphics/VulkanRHI/VulkanRHI.h"
+#include "Graphics/VulkanRHI/VulkanResourceAllocator.h"
 
 
 
@@ -152,6 +154,37 @@ void VulkanMemoryAllocator::FreeBuffer(VkBuffer buffer, const VulkanMemoryAlloca
     vmaDestroyBuffer(m_vmaAllocator, buffer, memAlloc.handle);
 }
 
+void VulkanMemoryAllocator::AllocMemoryBlock(const VkMemoryRequirements& requirements,
+                                             VulkanMemoryAllocation* pAllocation)
+{
+    VmaAllocationCreateInfo vmaAllocationCI{};
+    vmaAllocationCI.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    // blocks are large and live as long as the render graph, keep them out of the shared pools
+    vmaAllocationCI.flags         = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    vmaAllocationCI.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    VKCHECK(vmaAllocateMemory(m_vmaAllocator, &requirements, &vmaAllocationCI,
+                              &pAllocation->handle, &pAllocation->info));
+}
+
+void VulkanMemoryAllocator::FreeMemoryBlock(const VulkanMemoryAllocation& memAlloc)
+{
+    vmaFreeMemory(m_vmaAllocator, memAlloc.handle);
+}
+
+void VulkanMemoryAllocator::BindImageMemory(const VulkanMemoryAllocation& memAlloc,
+                                            VkDeviceSize offset,
+                                            VkImage image)
+{
+    VKCHECK(vmaBindImageMemory2(m_vmaAllocator, memAlloc.handle, offset, image, nullptr));
+}
+
+void VulkanMemoryAllocator::BindBufferMemory(const VulkanMemoryAllocation& memAlloc,
+                                             VkDeviceSize offset,
+                                             VkBuffer buffer)
+{
+    VKCHECK(vmaBindBufferMemory2(m_vmaAllocator, memAlloc.handle, offset, buffer, nullptr));
+}
+
 VmaPool VulkanMemoryAllocator::GetOrCreateSmallAllocPools(MemoryTypeIndex memTypeIndex)
 {
     if (m_smallPools.contains(memTypeIndex))
@@ -174,4 +207,43 @@ VmaPool VulkanMemoryAllocator::GetOrCreateSmallAllocPools(MemoryTypeIndex memTyp
 
     return pool;
 }
+
+RHIMemoryBlock* VulkanRHI::CreateMemoryBlock(const RHIMemoryRequirements& requirements)
+{
+    return VulkanMemoryBlock::CreateObject(requirements);
+}
+
+void VulkanRHI::DestroyMemoryBlock(RHIMemoryBlock* pMemoryBlock)
+{
+    pMemoryBlock->ReleaseReference();
+}
+
+VulkanMemoryBlock* VulkanMemoryBlock::CreateObject(const RHIMemoryRequirements& requirements)
+{
+    VulkanMemoryBlock* pMemoryBlock =
+        VersatileResource::AllocMem<VulkanMemoryBlock>(GVulkanRHI->GetResourceAllocator());
+
+    new (pMemoryBlock) VulkanMemoryBlock(requirements);
+
+    pMemoryBlock->Init();
+
+    return pMemoryBlock;
+}
+
+void VulkanMemoryBlock::Init()
+{
+    VkMemoryRequirements memRequirements{};
+    memRequirements.size           = m_requirements.size;
+    memRequirements.alignment      = m_requirements.alignment;
+    memRequirements.memoryTypeBits = m_requirements.memoryTypeBits;
+    GVkMemAllocator->AllocMemoryBlock(memRequirements, &m_memAlloc);
+}
+
+void VulkanMemoryBlock::Destroy()
+{
+    GVkMemAllocator->FreeMemoryBlock(m_memAlloc);
+    this->~VulkanMemoryBlock();
+
+    VersatileResource::Free(GVulkanRHI->GetResourceAllocator(), this);
+}
 } // namespace zen
@@ -1,9 +1,10 @@
 #include "Graphics/VulkanRHI/VulkanRHI.h"
 #include "Graphics/VulkanRHI/VulkanPipeline.h"
 #include "Graphics/RHI/RHIOptions.h"
-#include "Graphics/RHI/RHIShaderUtil.h"
+#include "Graphics/RHI/RHIShaderReflectionCache.h"
 #include "Graphics/VulkanRHI/VulkanCommon.h"
 #include "Graphics/VulkanRHI/VulkanDevice.h"
+#include "Graphics/VulkanRHI/VulkanPipelineCache.h"
 #include "Graphics/VulkanRHI/VulkanResourceAllocator.h"
 #include "Graphics/VulkanRHI/VulkanTypes.h"
 #include "Platform/FileSystem.h"
@@ -129,7 +130,7 @@ void VulkanShader::Init()
     }
 
     RHIShaderGroupInfo sgInfo{};
-    RHIShaderUtil::ReflectShaderGroupInfo(m_shaderGroupSPIRV, sgInfo);
+    GVulkanRHI->GetShaderReflectionCache()->GetOrReflect(m_shaderGroupSPIRV, sgInfo);
     sgInfo.name = m_name;
     m_SRDTable  = sgInfo.SRDTable;
 
@@ -962,8 +963,9 @@ void VulkanPipeline::InitGraphics()
         pipelineCI.pNext = &renderingCI;
     }
 
-    VKCHECK(vkCreateGraphicsPipelines(GVulkanRHI->GetVkDevice(), nullptr, 1, &pipelineCI, nullptr,
-                                      &m_vkPipeline));
+    VkPipelineCache pipelineCache = GVulkanRHI->GetDevice()->GetPipelineCache()->GetVkHandle();
+    VKCHECK(vkCreateGraphicsPipelines(GVulkanRHI->GetVkDevice(), pipelineCache, 1, &pipelineCI,
+                                      nullptr, &m_vkPipeline));
 
     m_pushConstantsStageFlags = pShader->GetPushConstantsStageFlags();
 }
@@ -978,8 +980,9 @@ void VulkanPipeline::InitCompute()
     pipelineCI.layout = pShader->GetVkPipelineLayout();
 
     VkPipeline computePipeline{VK_NULL_HANDLE};
-    VKCHECK(vkCreateComputePipelines(GVulkanRHI->GetVkDevice(), nullptr, 1, &pipelineCI, nullptr,
-                                     &m_vkPipeline));
+    VkPipelineCache pipelineCache = GVulkanRHI->GetDevice()->GetPipelineCache()->GetVkHandle();
+    VKCHECK(vkCreateComputePipelines(GVulkanRHI->GetVkDevice(), pipelineCache, 1, &pipelineCI,
+                                     nullptr, &m_vkPipeline));
     m_pushConstantsStageFlags = pShader->GetPushConstantsStageFlags();
 }
 
@@ -0,0 +1,165 @@
+#include "Graphics/VulkanRHI/VulkanPipelineCache.h"
+#include "Graphics/VulkanRHI/VulkanCommon.h"
+#include "Graphics/VulkanRHI/VulkanDevice.h"
+#include "Platform/FileSystem.h"
+#include "Utils/Errors.h"
+#include "Utils/Helpers.h"
+#include <fstream>
+
+namespace zen
+{
+void VulkanPipelineCache::Init(VulkanDevice* pDevice, const std::string& path)
+{
+    m_pDevice = pDevice;
+    m_path    = path;
+
+    std::vector<uint8_t> initialData;
+    if (!m_path.empty())
+    {
+        std::ifstream file(m_path, std::ios::binary | std::ios::ate);
+        if (file.is_open())
+        {
+            std::vector<uint8_t> fileData(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(fileData.data()),
+                      static_cast<std::streamsize>(fileData.size()));
+            if (!file ||
+                !UnpackCacheFile(m_pDevice->GetPhysicalDeviceProperties(), fileData.data(),
+                                 fileData.size(), initialData))
+            {
+                LOGW("Discarding invalid pipeline cache {}", m_path);
+                initialData.clear();
+            }
+        }
+    }
+
+    VkPipelineCacheCreateInfo pipelineCacheCI;
+    InitVkStruct(pipelineCacheCI, VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+    pipelineCacheCI.initialDataSize = initialData.size();
+    pipelineCacheCI.pInitialData    = initialData.empty() ? nullptr : initialData.data();
+    VKCHECK(vkCreatePipelineCache(m_pDevice->GetVkHandle(), &pipelineCacheCI, nullptr,
+                                  &m_pipelineCache));
+
+    m_loadedFromDisk = !initialData.empty();
+    if (m_loadedFromDisk)
+    {
+        m_fileDataHash = util::HashBytes64(initialData.data(), initialData.size());
+        LOGI("Pipeline cache loaded from {} ({} bytes)", m_path, initialData.size());
+    }
+}
+
+bool VulkanPipelineCache::Save()
+{
+    if (m_path.empty() || m_pipelineCache == VK_NULL_HANDLE)
+    {
+        return false;
+    }
+    size_t dataSize = 0;
+    VKCHECK(vkGetPipelineCacheData(m_pDevice->GetVkHandle(), m_pipelineCache, &dataSize, nullptr));
+    std::vector<uint8_t> data(dataSize);
+    VKCHECK(
+        vkGetPipelineCacheData(m_pDevice->GetVkHandle(), m_pipelineCache, &dataSize, data.data()));
+    data.resize(dataSize);
+
+    const uint64_t dataHash = util::HashBytes64(data.data(), data.size());
+    if (data.empty() || dataHash == m_fileDataHash)
+    {
+        return false;
+    }
+
+    const std::vector<uint8_t> fileData =
+        PackCacheFile(m_pDevice->GetPhysicalDeviceProperties(), data.data(), data.size());
+
+    if (!platform::FileSystem::WriteBinaryFileAtomic(m_path, fileData.data(), fileData.size()))
+    {
+        return false;
+    }
+    m_fileDataHash = dataHash;
+    return true;
+}
+
+void VulkanPipelineCache::Destroy()
+{
+    if (m_pipelineCache == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    Save();
+    vkDestroyPipelineCache(m_pDevice->GetVkHandle(), m_pipelineCache, nullptr);
+    m_pipelineCache = VK_NULL_HANDLE;
+}
+
+std::vector<uint8_t> VulkanPipelineCache::PackCacheFile(
+    const VkPhysicalDeviceProperties& properties,
+    const uint8_t* pData,
+    size_t dataSize)
+{
+    FileHeader header{};
+    header.magic         = cMagic;
+    header.version       = cVersion;
+    header.vendorID      = properties.vendorID;
+    header.deviceID      = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    header.dataSize = dataSize;
+    header.dataHash = util::HashBytes64(pData, dataSize);
+
+    std::vector<uint8_t> fileData(sizeof(FileHeader) + dataSize);
+    std::memcpy(fileData.data(), &header, sizeof(FileHeader));
+    if (dataSize > 0)
+    {
+        std::memcpy(fileData.data() + sizeof(FileHeader), pData, dataSize);
+    }
+    return fileData;
+}
+
+bool VulkanPipelineCache::UnpackCacheFile(const VkPhysicalDeviceProperties& properties,
+                                          const uint8_t* pFile,
+                                          size_t fileSize,
+                                          std::vector<uint8_t>& data)
+{
+    data.clear();
+    if (fileSize < sizeof(FileHeader))
+    {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, pFile, sizeof(FileHeader));
+    if (header.magic != cMagic || header.version != cVersion ||
+        header.vendorID != properties.vendorID || header.deviceID != properties.deviceID ||
+        header.driverVersion != properties.driverVersion ||
+        std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0 ||
+        header.dataSize != fileSize - sizeof(FileHeader))
+    {
+        return false;
+    }
+    const uint8_t* pData = pFile + sizeof(FileHeader);
+    // the driver trusts the blob, a flipped bit must never reach vkCreatePipelineCache
+    if (util::HashBytes64(pData, header.dataSize) != header.dataHash ||
+        !ValidateDriverHeader(properties, pData, header.dataSize))
+    {
+        return false;
+    }
+    data.assign(pData, pData + header.dataSize);
+    return true;
+}
+
+bool VulkanPipelineCache::ValidateDriverHeader(const VkPhysicalDeviceProperties& properties,
+                                               const uint8_t* pData,
+                                               size_t dataSize)
+{
+    if (dataSize < sizeof(VkPipelineCacheHeaderVersionOne))
+    {
+        return false;
+    }
+    VkPipelineCacheHeaderVersionOne driverHeader;
+    std::memcpy(&driverHeader, pData, sizeof(driverHeader));
+    const bool uuidMatches = std::memcmp(driverHeader.pipelineCacheUUID,
+                                         properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    return driverHeader.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+        driverHeader.headerSize <= dataSize &&
+        driverHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+        driverHeader.vendorID == properties.vendorID &&
+        driverHeader.deviceID == properties.deviceID && uuidMatches;
+}
+} // namespace zen
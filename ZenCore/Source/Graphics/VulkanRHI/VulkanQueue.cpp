@@ -135,6 +135,7 @@ void VulkanQueue::UpdateLastSubmittedCmdBuffer(VulkanCommandBuffer* pCmdBuffer)
 
 VulkanWorkload* VulkanQueue::AcquireWorkload()
 {
+    LockAuto lock(&m_workloadPoolMutex);
     if (!m_workloadPool.empty())
     {
         VulkanWorkload* pWorkload = m_workloadPool.back();
@@ -165,6 +166,7 @@ void VulkanQueue::ReleaseWorkload(VulkanWorkload* pWorkload)
     pWorkload->m_pMergedInto      = nullptr;
     pWorkload->m_waitSemaphoreInfos.clear();
     pWorkload->m_signalSemaphoreInfos.clear();
+    LockAuto lock(&m_workloadPoolMutex);
     m_workloadPool.push_back(pWorkload);
 }
 
@@ -156,6 +156,8 @@ VkRenderPassCreateInfo VulkanRenderPassBuilder::BuildRenderPassCreateInfo(
 VkRenderPass VulkanRHI::GetOrCreateRenderPass(const RHIRenderingLayout* pRenderingLayout)
 {
     const uint32_t layoutHash = pRenderingLayout->GetHash32();
+    // graphics pipelines may be compiled on worker threads
+    LockAuto lock(&m_renderPassCacheMutex);
     if (!m_renderPassCache.contains(layoutHash))
     {
         VkRenderPass renderPass{VK_NULL_HANDLE};
@@ -172,6 +174,8 @@ VkFramebuffer VulkanRHI::GetOrCreateFramebuffer(const RHIRenderingLayout* pRende
                                                 VkRenderPass renderPass)
 {
     VkFramebuffer framebuffer{VK_NULL_HANDLE};
+    // command lists are finalized on worker threads, this also covers the back buffer framebuffer
+    LockAuto lock(&m_framebufferCacheMutex);
     VulkanViewport* pViewport = GVulkanRHI->GetCurrentViewport();
     const uint32_t fbWidth   = pRenderingLayout->renderArea.Width();
     const uint32_t fbHeight  = pRenderingLayout->renderArea.Height();
@@ -337,12 +337,162 @@ void VulkanPipelineBarrier::Execute(VkCommandBuffer cmdBuffer,
                              m_bufferBarriers.data(), m_imageBarriers.size(),
                              m_imageBarriers.data());
 
-        m_memoryBarriers.clear();
-        m_bufferBarriers.clear();
-        m_imageBarriers.clear();
+        Clear();
     }
 }
 
+void VulkanPipelineBarrier::Execute2(VkCommandBuffer cmdBuffer,
+                                     VkPipelineStageFlags srcStageFlags,
+                                     VkPipelineStageFlags dstStageFlags)
+{
+    if (!IsEmpty())
+    {
+        VkDependencyInfoKHR dependencyInfo;
+        BuildDependencyInfo(srcStageFlags, dstStageFlags, dependencyInfo);
+        vkCmdPipelineBarrier2KHR(cmdBuffer, &dependencyInfo);
+        Clear();
+    }
+}
+
+void VulkanPipelineBarrier::SetEvent2(VkCommandBuffer cmdBuffer,
+                                      VkEvent event,
+                                      VkPipelineStageFlags srcStageFlags,
+                                      VkPipelineStageFlags dstStageFlags)
+{
+    VkDependencyInfoKHR dependencyInfo;
+    BuildDependencyInfo(srcStageFlags, dstStageFlags, dependencyInfo);
+    vkCmdSetEvent2KHR(cmdBuffer, event, &dependencyInfo);
+}
+
+void VulkanPipelineBarrier::WaitEvent2(VkCommandBuffer cmdBuffer,
+                                       VkEvent event,
+                                       VkPipelineStageFlags srcStageFlags,
+                                       VkPipelineStageFlags dstStageFlags)
+{
+    VkDependencyInfoKHR dependencyInfo;
+    BuildDependencyInfo(srcStageFlags, dstStageFlags, dependencyInfo);
+    vkCmdWaitEvents2KHR(cmdBuffer, 1, &event, &dependencyInfo);
+    vkCmdResetEvent2KHR(cmdBuffer, event, static_cast<VkPipelineStageFlags2KHR>(dstStageFlags));
+    Clear();
+}
+
+void VulkanPipelineBarrier::BuildDependencyInfo(VkPipelineStageFlags srcStageFlags,
+                                                VkPipelineStageFlags dstStageFlags,
+                                                VkDependencyInfoKHR& dependencyInfo)
+{
+    // the legacy stage and access bits keep their values in the 64 bit flags
+    const VkPipelineStageFlags2KHR srcStages = srcStageFlags;
+    const VkPipelineStageFlags2KHR dstStages = dstStageFlags;
+
+    m_memoryBarriers2.clear();
+    for (const VkMemoryBarrier& memoryBarrier : m_memoryBarriers)
+    {
+        VkMemoryBarrier2KHR& barrier = m_memoryBarriers2.emplace_back();
+        InitVkStruct(barrier, VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR);
+        barrier.srcStageMask  = srcStages;
+        barrier.srcAccessMask = memoryBarrier.srcAccessMask;
+        barrier.dstStageMask  = dstStages;
+        barrier.dstAccessMask = memoryBarrier.dstAccessMask;
+    }
+
+    m_bufferBarriers2.clear();
+    for (const VkBufferMemoryBarrier& bufferBarrier : m_bufferBarriers)
+    {
+        VkBufferMemoryBarrier2KHR& barrier = m_bufferBarriers2.emplace_back();
+        InitVkStruct(barrier, VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR);
+        barrier.srcStageMask        = srcStages;
+        barrier.srcAccessMask       = bufferBarrier.srcAccessMask;
+        barrier.dstStageMask        = dstStages;
+        barrier.dstAccessMask       = bufferBarrier.dstAccessMask;
+        barrier.srcQueueFamilyIndex = bufferBarrier.srcQueueFamilyIndex;
+        barrier.dstQueueFamilyIndex = bufferBarrier.dstQueueFamilyIndex;
+        barrier.buffer              = bufferBarrier.buffer;
+        barrier.offset              = bufferBarrier.offset;
+        barrier.size                = bufferBarrier.size;
+    }
+
+    m_imageBarriers2.clear();
+    for (const VkImageMemoryBarrier& imageBarrier : m_imageBarriers)
+    {
+        VkImageMemoryBarrier2KHR& barrier = m_imageBarriers2.emplace_back();
+        InitVkStruct(barrier, VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR);
+        barrier.srcStageMask        = srcStages;
+        barrier.srcAccessMask       = imageBarrier.srcAccessMask;
+        barrier.dstStageMask        = dstStages;
+        barrier.dstAccessMask       = imageBarrier.dstAccessMask;
+        barrier.oldLayout           = imageBarrier.oldLayout;
+        barrier.newLayout           = imageBarrier.newLayout;
+        barrier.srcQueueFamilyIndex = imageBarrier.srcQueueFamilyIndex;
+        barrier.dstQueueFamilyIndex = imageBarrier.dstQueueFamilyIndex;
+        barrier.image               = imageBarrier.image;
+        barrier.subresourceRange    = imageBarrier.subresourceRange;
+    }
+
+    InitVkStruct(dependencyInfo, VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR);
+    dependencyInfo.memoryBarrierCount       = m_memoryBarriers2.size();
+    dependencyInfo.pMemoryBarriers          = m_memoryBarriers2.data();
+    dependencyInfo.bufferMemoryBarrierCount = m_bufferBarriers2.size();
+    dependencyInfo.pBufferMemoryBarriers    = m_bufferBarriers2.data();
+    dependencyInfo.imageMemoryBarrierCount  = m_imageBarriers2.size();
+    dependencyInfo.pImageMemoryBarriers     = m_imageBarriers2.data();
+}
+
+void VulkanPipelineBarrier::Clear()
+{
+    m_memoryBarriers.clear();
+    m_bufferBarriers.clear();
+    m_imageBarriers.clear();
+}
+
+void VulkanBarrierEventManager::Destroy()
+{
+    for (BarrierEvent* pEvent : m_events)
+    {
+        if (pEvent->event != VK_NULL_HANDLE)
+        {
+            vkDestroyEvent(m_pDevice->GetVkHandle(), pEvent->event, nullptr);
+        }
+        ZEN_DELETE(pEvent);
+    }
+    m_events.clear();
+    m_freeEvents.clear();
+}
+
+uint64_t VulkanBarrierEventManager::AllocateEvent()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_freeEvents.empty())
+    {
+        const uint32_t index = m_freeEvents.back();
+        m_freeEvents.pop_back();
+        return index + 1;
+    }
+
+    BarrierEvent* pEvent = ZEN_NEW() BarrierEvent();
+    if (m_pDevice->SupportsSynchronization2())
+    {
+        VkEventCreateInfo eventCI;
+        InitVkStruct(eventCI, VK_STRUCTURE_TYPE_EVENT_CREATE_INFO);
+        eventCI.flags = VK_EVENT_CREATE_DEVICE_ONLY_BIT_KHR;
+        VKCHECK(vkCreateEvent(m_pDevice->GetVkHandle(), &eventCI, nullptr, &pEvent->event));
+    }
+    m_events.push_back(pEvent);
+    return m_events.size();
+}
+
+VulkanBarrierEventManager::BarrierEvent* VulkanBarrierEventManager::GetEvent(uint64_t handle)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    VERIFY_EXPR_MSG(handle > 0 && handle <= m_events.size(), "Invalid barrier event handle");
+    return m_events[handle - 1];
+}
+
+void VulkanBarrierEventManager::ReleaseEvent(uint64_t handle)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_freeEvents.push_back(static_cast<uint32_t>(handle - 1));
+}
+
 // void VulkanPipelineBarrier::Execute(VulkanCommandBuffer* cmdBuffer,
 //                                     BitField<RHIPipelineStageBits> srcStages,
 //                                     BitField<RHIPipelineStageBits> dstStages)
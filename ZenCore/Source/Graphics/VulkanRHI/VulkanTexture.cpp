@@ -157,6 +157,14 @@ void VulkanRHI::DestroyTexture(RHITexture* pTexture)
     pTexture->ReleaseReference();
 }
 
+void VulkanRHI::BindTextureMemory(RHITexture* pTexture,
+                                  RHIMemoryBlock* pMemoryBlock,
+                                  uint64_t offset)
+{
+    dynamic_cast<VulkanTexture*>(pTexture)->BindMemory(
+        dynamic_cast<VulkanMemoryBlock*>(pMemoryBlock), offset);
+}
+
 // RHITexture* RHITexture::Create(const RHITextureCreateInfo& createInfo)
 // {
 //     // RHITexture* pTexture = VulkanTexture::CreateObject(createInfo);
@@ -190,11 +198,22 @@ void VulkanTexture::CreateImageViewHelper()
     if (vkCreateImageView(GVulkanRHI->GetVkDevice(), &imageViewCI, nullptr, &m_vkImageView) !=
         VK_SUCCESS)
     {
-        GVkMemAllocator->FreeImage(m_vkImage, m_memAlloc);
+        if (!m_baseInfo.transient)
+        {
+            GVkMemAllocator->FreeImage(m_vkImage, m_memAlloc);
+        }
         LOGE("vkCreateImageView failed with error");
     }
 }
 
+void VulkanTexture::BindMemory(const VulkanMemoryBlock* pMemoryBlock, uint64_t offset)
+{
+    VERIFY_EXPR_MSG(m_baseInfo.transient && m_vkImageView == VK_NULL_HANDLE,
+                    "only transient textures are bound, and only once");
+    GVkMemAllocator->BindImageMemory(pMemoryBlock->GetMemoryAllocation(), offset, m_vkImage);
+    CreateImageViewHelper();
+}
+
 VulkanTexture* VulkanTexture::CreateObject(const RHITextureCreateInfo& createInfo)
 {
     VulkanTexture* pTexture =
@@ -271,16 +290,32 @@ void VulkanTexture::Init()
             imageCI.pQueueFamilyIndices   = queueFamilyIndices;
         }
 
-        const auto textureSize = CalculateTextureSize(m_baseInfo);
+        if (m_baseInfo.transient)
+        {
+            // memory is bound later by the render graph, the view is created then
+            VKCHECK(vkCreateImage(GVulkanRHI->GetVkDevice(), &imageCI, nullptr, &m_vkImage));
+            VkMemoryRequirements memRequirements{};
+            vkGetImageMemoryRequirements(GVulkanRHI->GetVkDevice(), m_vkImage, &memRequirements);
+            m_memoryRequirements.size           = memRequirements.size;
+            m_memoryRequirements.alignment      = memRequirements.alignment;
+            m_memoryRequirements.memoryTypeBits = memRequirements.memoryTypeBits;
+        }
+        else
+        {
+            const auto textureSize = CalculateTextureSize(m_baseInfo);
 
-        GVkMemAllocator->AllocImage(&imageCI, m_baseInfo.cpuReadable, &m_vkImage, &m_memAlloc,
-                                    textureSize);
+            GVkMemAllocator->AllocImage(&imageCI, m_baseInfo.cpuReadable, &m_vkImage, &m_memAlloc,
+                                        textureSize);
+        }
         m_vkImageCI                    = imageCI;
         m_vkImageCI.queueFamilyIndexCount = 0;
         m_vkImageCI.pQueueFamilyIndices   = nullptr;
 
         // create image view
-        CreateImageViewHelper();
+        if (!m_baseInfo.transient)
+        {
+            CreateImageViewHelper();
+        }
 
         if (!m_baseInfo.tag.empty())
         {
@@ -307,7 +342,15 @@ void VulkanTexture::Destroy()
     GVulkanRHI->RemoveImageLayout(m_vkImage);
     if (m_isProxy != true)
     {
-        GVkMemAllocator->FreeImage(m_vkImage, m_memAlloc);
+        if (m_baseInfo.transient)
+        {
+            // the memory belongs to the block it was bound to
+            vkDestroyImage(GVulkanRHI->GetVkDevice(), m_vkImage, nullptr);
+        }
+        else
+        {
+            GVkMemAllocator->FreeImage(m_vkImage, m_memAlloc);
+        }
     }
     VersatileResource::Free(GVulkanRHI->GetResourceAllocator(), this);
 }
@@ -522,6 +565,7 @@ void VulkanTexture::InitProxy()
 
 void VulkanRHI::UpdateImageLayout(VkImage image, VkImageLayout newLayout)
 {
+    LockAuto lock(&m_imageLayoutCacheMutex);
     // if (m_imageLayoutCache.contains(image))
     // {
     m_imageLayoutCache[image] = newLayout;
@@ -530,6 +574,7 @@ void VulkanRHI::UpdateImageLayout(VkImage image, VkImageLayout newLayout)
 
 void VulkanRHI::RemoveImageLayout(VkImage image)
 {
+    LockAuto lock(&m_imageLayoutCacheMutex);
     if (m_imageLayoutCache.contains(image))
     {
         m_imageLayoutCache.erase(image);
@@ -539,6 +584,7 @@ void VulkanRHI::RemoveImageLayout(VkImage image)
 
 VkImageLayout VulkanRHI::GetImageCurrentLayout(VkImage image)
 {
+    LockAuto lock(&m_imageLayoutCacheMutex);
     VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
     if (m_imageLayoutCache.contains(image))
     {
@@ -1,4 +1,5 @@
 #include "Memory/Memory.h"
+#include "Memory/SizeClassAllocator.h"
 #include "Utils/Errors.h"
 
 #include <algorithm>
@@ -22,29 +23,37 @@ DefaultAllocator* DefaultAllocator::GetInstance()
     return &instance;
 }
 
-void DefaultAllocator::LockAllocationSiteStats()
+void DefaultAllocator::LockAllocationSiteShard(AllocationSiteShard& shard)
 {
-    while (m_allocationSiteStatsLock.test_and_set(std::memory_order_acquire))
+    while (shard.lock.test_and_set(std::memory_order_acquire))
     {
     }
 }
 
-void DefaultAllocator::UnlockAllocationSiteStats()
+void DefaultAllocator::UnlockAllocationSiteShard(AllocationSiteShard& shard)
 {
-    m_allocationSiteStatsLock.clear(std::memory_order_release);
+    shard.lock.clear(std::memory_order_release);
+}
+
+uintptr_t DefaultAllocator::HashAllocationSite(const char* pFileName, uint32_t lineNum)
+{
+    uintptr_t hash = reinterpret_cast<uintptr_t>(pFileName);
+    hash ^= static_cast<uintptr_t>(lineNum) * 2654435761u;
+    return hash;
 }
 
 DefaultAllocator::AllocationSiteStats* DefaultAllocator::FindOrAddAllocationSite(
+    AllocationSiteShard& shard,
+    uintptr_t hash,
     const char* pFileName,
     uint32_t lineNum)
 {
-    uintptr_t hash = reinterpret_cast<uintptr_t>(pFileName);
-    hash ^= static_cast<uintptr_t>(lineNum) * 2654435761u;
-    uint32_t index = static_cast<uint32_t>(hash % cMaxTrackedAllocationSites);
+    uint32_t index =
+        static_cast<uint32_t>((hash / cNumAllocationSiteShards) % cAllocationSitesPerShard);
 
-    for (uint32_t probe = 0; probe < cMaxTrackedAllocationSites; ++probe)
+    for (uint32_t probe = 0; probe < cAllocationSitesPerShard; ++probe)
     {
-        AllocationSiteStats& stats = m_allocationSiteStats[index];
+        AllocationSiteStats& stats = shard.sites[index];
         if (stats.pFileName == pFileName && stats.lineNumber == lineNum)
         {
             return &stats;
@@ -57,10 +66,10 @@ DefaultAllocator::AllocationSiteStats* DefaultAllocator::FindOrAddAllocationSite
             return &stats;
         }
 
-        index = (index + 1) % cMaxTrackedAllocationSites;
+        index = (index + 1) % cAllocationSitesPerShard;
     }
 
-    m_allocationSiteStatsOverflow = true;
+    shard.overflow = true;
     return nullptr;
 }
 
@@ -74,8 +83,10 @@ void DefaultAllocator::TrackAllocationSiteAlloc(size_t size,
         return;
     }
 
-    LockAllocationSiteStats();
-    AllocationSiteStats* pStats = FindOrAddAllocationSite(pFileName, lineNum);
+    const uintptr_t hash       = HashAllocationSite(pFileName, lineNum);
+    AllocationSiteShard& shard = m_allocationSiteShards[hash % cNumAllocationSiteShards];
+    LockAllocationSiteShard(shard);
+    AllocationSiteStats* pStats = FindOrAddAllocationSite(shard, hash, pFileName, lineNum);
     if (pStats != nullptr)
     {
         pStats->totalAllocated += size;
@@ -90,7 +101,7 @@ void DefaultAllocator::TrackAllocationSiteAlloc(size_t size,
             ++pStats->allocationCount;
         }
     }
-    UnlockAllocationSiteStats();
+    UnlockAllocationSiteShard(shard);
 }
 
 void DefaultAllocator::TrackAllocationSiteFree(size_t size,
@@ -102,15 +113,17 @@ void DefaultAllocator::TrackAllocationSiteFree(size_t size,
         return;
     }
 
-    LockAllocationSiteStats();
-    AllocationSiteStats* pStats = FindOrAddAllocationSite(pFileName, lineNum);
+    const uintptr_t hash       = HashAllocationSite(pFileName, lineNum);
+    AllocationSiteShard& shard = m_allocationSiteShards[hash % cNumAllocationSiteShards];
+    LockAllocationSiteShard(shard);
+    AllocationSiteStats* pStats = FindOrAddAllocationSite(shard, hash, pFileName, lineNum);
     if (pStats != nullptr)
     {
         pStats->totalFreed += size;
         pStats->currentUsage -= std::min(pStats->currentUsage, size);
         ++pStats->freeCount;
     }
-    UnlockAllocationSiteStats();
+    UnlockAllocationSiteShard(shard);
 }
 
 void DefaultAllocator::TrackMemAlloc(size_t s, const char* pFileName, uint32_t lineNum)
@@ -298,39 +311,43 @@ void DefaultAllocator::ReportMemUsage()
     AllocationSiteStats topSites[cNumTopAllocationSites]{};
     uint32_t numTopSites = 0;
 
-    pAlloc->LockAllocationSiteStats();
-    for (const AllocationSiteStats& stats : pAlloc->m_allocationSiteStats)
+    bool allocationSiteStatsOverflow = false;
+    for (AllocationSiteShard& shard : pAlloc->m_allocationSiteShards)
     {
-        if (stats.pFileName == nullptr || stats.totalAllocated == 0)
+        LockAllocationSiteShard(shard);
+        for (const AllocationSiteStats& stats : shard.sites)
         {
-            continue;
-        }
+            if (stats.pFileName == nullptr || stats.totalAllocated == 0)
+            {
+                continue;
+            }
 
-        if (numTopSites < cNumTopAllocationSites)
-        {
-            topSites[numTopSites] = stats;
-            uint32_t siteIndex    = numTopSites++;
-            while (siteIndex > 0 &&
-                   topSites[siteIndex].totalAllocated > topSites[siteIndex - 1].totalAllocated)
+            if (numTopSites < cNumTopAllocationSites)
             {
-                std::swap(topSites[siteIndex], topSites[siteIndex - 1]);
-                --siteIndex;
+                topSites[numTopSites] = stats;
+                uint32_t siteIndex    = numTopSites++;
+                while (siteIndex > 0 &&
+                       topSites[siteIndex].totalAllocated > topSites[siteIndex - 1].totalAllocated)
+                {
+                    std::swap(topSites[siteIndex], topSites[siteIndex - 1]);
+                    --siteIndex;
+                }
             }
-        }
-        else if (stats.totalAllocated > topSites[cNumTopAllocationSites - 1].totalAllocated)
-        {
-            topSites[cNumTopAllocationSites - 1] = stats;
-            uint32_t siteIndex = cNumTopAllocationSites - 1;
-            while (siteIndex > 0 &&
-                   topSites[siteIndex].totalAllocated > topSites[siteIndex - 1].totalAllocated)
+            else if (stats.totalAllocated > topSites[cNumTopAllocationSites - 1].totalAllocated)
             {
-                std::swap(topSites[siteIndex], topSites[siteIndex - 1]);
-                --siteIndex;
+                topSites[cNumTopAllocationSites - 1] = stats;
+                uint32_t siteIndex = cNumTopAllocationSites - 1;
+                while (siteIndex > 0 &&
+                       topSites[siteIndex].totalAllocated > topSites[siteIndex - 1].totalAllocated)
+                {
+                    std::swap(topSites[siteIndex], topSites[siteIndex - 1]);
+                    --siteIndex;
+                }
             }
         }
+        allocationSiteStatsOverflow |= shard.overflow;
+        UnlockAllocationSiteShard(shard);
     }
-    const bool allocationSiteStatsOverflow = pAlloc->m_allocationSiteStatsOverflow;
-    pAlloc->UnlockAllocationSiteStats();
 
     if (numTopSites > 0)
     {
@@ -394,6 +411,12 @@ void DefaultAllocator::ReportMemUsage()
 
 void* DefaultAllocator::DefaultAllocImpl(size_t size, size_t alignment)
 {
+#if defined(ZEN_SIZE_CLASS_ALLOCATOR)
+    if (SizeClassAllocator::IsSmall(size, alignment))
+    {
+        return SizeClassAllocator::Alloc(size);
+    }
+#endif
     void* pMem;
 #if _POSIX_VERSION >= 20112L || defined(ZEN_MACOS)
     if (posix_memalign(&pMem, Pow2Align(alignment, sizeof(void*)), size) != 0)
@@ -432,6 +455,26 @@ void* DefaultAllocator::DefaultReallocImpl(void* pMem,
     }
 
     void* pNewMem;
+#if defined(ZEN_SIZE_CLASS_ALLOCATOR)
+    // blocks of the size class allocator can not be resized in place, and their usable size is
+    // known so the copy never reads past the old block
+    const size_t oldBlockSize = SizeClassAllocator::GetBlockSize(pMem);
+    if (oldBlockSize != 0 || SizeClassAllocator::IsSmall(size, alignment))
+    {
+        pNewMem = DefaultAllocImpl(size, alignment);
+        if (pNewMem)
+        {
+            size_t bytesToCopy = copySize > 0 ? copySize : size;
+            if (oldBlockSize != 0)
+            {
+                bytesToCopy = std::min(bytesToCopy, oldBlockSize);
+            }
+            std::memcpy(pNewMem, pMem, bytesToCopy);
+            DefaultFreeImpl(pMem);
+        }
+        return pNewMem;
+    }
+#endif
 #if _POSIX_VERSION >= 200112L || defined(ZEN_MACOS)
     // posix_memalign does not support realloc, so we need to manually handle it
     pNewMem = DefaultAllocImpl(size, alignment);
@@ -459,6 +502,13 @@ void DefaultAllocator::DefaultFreeImpl(void* pMem)
     // {
     //     GetAllocations().erase(pMem);
     // }
+#if defined(ZEN_SIZE_CLASS_ALLOCATOR)
+    if (SizeClassAllocator::Owns(pMem))
+    {
+        SizeClassAllocator::Free(pMem);
+        return;
+    }
+#endif
 #if _POSIX_VERSION >= 20112L || defined(ZEN_MACOS)
     free(pMem);
 #elif _MSC_VER
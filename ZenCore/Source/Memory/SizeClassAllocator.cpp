@@ -0,0 +1,414 @@
+#include "Memory/SizeClassAllocator.h"
+#include "Utils/SpinLock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+
+namespace zen
+{
+namespace
+{
+constexpr uint32_t cNumTinyClasses = 8;  // 16, 32 ... 128
+constexpr size_t cTinyClassStep     = 16; // step of the tiny classes
+constexpr uint32_t cStepsPerBand    = 4;  // 4 classes per power of 2 above 128
+constexpr size_t cArenaSize         = size_t(4) << 20;
+constexpr size_t cBatchBytes        = 32 * 1024;
+
+// page map: 48 bit address space split into 64KB pages, two levels of 16 bits each
+constexpr uint32_t cAddressBits = 48;
+constexpr uint32_t cLeafBits    = 16;
+constexpr uint32_t cRootBits    = cAddressBits - SizeClassAllocator::cPageShift - cLeafBits;
+constexpr size_t cLeafSize      = size_t(1) << cLeafBits;
+constexpr size_t cRootSize      = size_t(1) << cRootBits;
+
+constexpr size_t ClassIndexToSize(uint32_t index)
+{
+    if (index < cNumTinyClasses)
+    {
+        return (index + 1) * cTinyClassStep;
+    }
+    const uint32_t band = (index - cNumTinyClasses) / cStepsPerBand;
+    const uint32_t step = (index - cNumTinyClasses) % cStepsPerBand;
+    const size_t base   = (cNumTinyClasses * cTinyClassStep) << band;
+    return base + (step + 1) * (base / cStepsPerBand);
+}
+
+static_assert(ClassIndexToSize(SizeClassAllocator::cNumSizeClasses - 1) ==
+                  SizeClassAllocator::cMaxSmallSize,
+              "size class table does not cover cMaxSmallSize");
+
+inline uint32_t SizeToClassIndex(size_t size)
+{
+    if (size <= cNumTinyClasses * cTinyClassStep)
+    {
+        return static_cast<uint32_t>((size + cTinyClassStep - 1) / cTinyClassStep) - 1;
+    }
+    // base < size <= 2 * base
+    const uint32_t log2 = static_cast<uint32_t>(std::bit_width(size - 1)) - 1;
+    const size_t base   = size_t(1) << log2;
+    const size_t step   = base / cStepsPerBand;
+    const uint32_t sub  = static_cast<uint32_t>((size - base + step - 1) / step) - 1;
+    return cNumTinyClasses + (log2 - 7) * cStepsPerBand + sub;
+}
+
+inline size_t GetSpanSize(uint32_t classIndex)
+{
+    const size_t wanted = ClassIndexToSize(classIndex) * 8;
+    return std::max(SizeClassAllocator::cPageSize,
+                    (wanted + SizeClassAllocator::cPageSize - 1) &
+                        ~(SizeClassAllocator::cPageSize - 1));
+}
+
+inline uint32_t GetBatchSize(uint32_t classIndex)
+{
+    const size_t count = cBatchBytes / ClassIndexToSize(classIndex);
+    return static_cast<uint32_t>(std::clamp<size_t>(count, 2, 64));
+}
+
+// free blocks are threaded through their first word, the head block of a batch stored in the
+// central heap uses its second word to link to the next batch
+struct FreeBlock
+{
+    FreeBlock* pNext;
+    FreeBlock* pNextBatch;
+};
+
+struct alignas(64) CentralFreeList
+{
+    SpinLock lock;
+    FreeBlock* pBatches{nullptr};
+};
+
+CentralFreeList g_centralLists[SizeClassAllocator::cNumSizeClasses];
+
+SpinLock g_spanLock;
+uint8_t* g_pArenaCursor = nullptr;
+uint8_t* g_pArenaEnd    = nullptr;
+std::atomic<uint8_t*> g_pageMap[cRootSize];
+std::atomic<size_t> g_reservedBytes{0};
+
+void* ReserveFromOS(size_t size)
+{
+    void* pMem = nullptr;
+#if defined(_MSC_VER)
+    pMem = _aligned_malloc(size, SizeClassAllocator::cPageSize);
+#else
+    if (posix_memalign(&pMem, SizeClassAllocator::cPageSize, size) != 0)
+    {
+        pMem = nullptr;
+    }
+#endif
+    return pMem;
+}
+
+// stores classIndex + 1 for every page of the span, 0 means "not ours"
+bool RegisterSpan(uint8_t* pSpan, size_t spanSize, uint32_t classIndex)
+{
+    for (size_t offset = 0; offset < spanSize; offset += SizeClassAllocator::cPageSize)
+    {
+        const uintptr_t page = reinterpret_cast<uintptr_t>(pSpan + offset) >>
+            SizeClassAllocator::cPageShift;
+        const uintptr_t rootIndex = page >> cLeafBits;
+        if (rootIndex >= cRootSize)
+        {
+            return false;
+        }
+        uint8_t* pLeaf = g_pageMap[rootIndex].load(std::memory_order_acquire);
+        if (pLeaf == nullptr)
+        {
+            pLeaf = static_cast<uint8_t*>(std::calloc(cLeafSize, 1));
+            if (pLeaf == nullptr)
+            {
+                return false;
+            }
+            g_pageMap[rootIndex].store(pLeaf, std::memory_order_release);
+        }
+        pLeaf[page & (cLeafSize - 1)] = static_cast<uint8_t>(classIndex + 1);
+    }
+    return true;
+}
+
+// returns classIndex + 1, or 0 if the address does not belong to a span
+inline uint32_t LookupPage(const void* pMem)
+{
+    const uintptr_t page = reinterpret_cast<uintptr_t>(pMem) >> SizeClassAllocator::cPageShift;
+    const uintptr_t rootIndex = page >> cLeafBits;
+    if (rootIndex >= cRootSize)
+    {
+        return 0;
+    }
+    const uint8_t* pLeaf = g_pageMap[rootIndex].load(std::memory_order_acquire);
+    return pLeaf != nullptr ? pLeaf[page & (cLeafSize - 1)] : 0;
+}
+
+// carves a new span into batches, returns the first one and hands the rest to the central heap
+FreeBlock* AllocSpan(uint32_t classIndex)
+{
+    const size_t spanSize  = GetSpanSize(classIndex);
+    const size_t blockSize = ClassIndexToSize(classIndex);
+
+    g_spanLock.Lock();
+    if (g_pArenaCursor == nullptr || g_pArenaCursor + spanSize > g_pArenaEnd)
+    {
+        auto* pArena = static_cast<uint8_t*>(ReserveFromOS(cArenaSize));
+        if (pArena == nullptr)
+        {
+            g_spanLock.Unlock();
+            return nullptr;
+        }
+        g_reservedBytes.fetch_add(cArenaSize, std::memory_order_relaxed);
+        // the tail of the previous arena is dropped, at most one span worth of memory
+        g_pArenaCursor = pArena;
+        g_pArenaEnd    = pArena + cArenaSize;
+    }
+    uint8_t* pSpan = g_pArenaCursor;
+    if (!RegisterSpan(pSpan, spanSize, classIndex))
+    {
+        g_spanLock.Unlock();
+        return nullptr;
+    }
+    g_pArenaCursor += spanSize;
+    g_spanLock.Unlock();
+
+    const uint32_t batchSize = GetBatchSize(classIndex);
+    const size_t numBlocks   = spanSize / blockSize;
+
+    FreeBlock* pFirstBatch = nullptr;
+    FreeBlock* pBatches    = nullptr;
+    for (size_t first = 0; first < numBlocks; first += batchSize)
+    {
+        const size_t last = std::min(numBlocks, first + batchSize);
+        for (size_t i = first; i < last; ++i)
+        {
+            auto* pBlock  = reinterpret_cast<FreeBlock*>(pSpan + i * blockSize);
+            auto* pNext   = reinterpret_cast<FreeBlock*>(pSpan + (i + 1) * blockSize);
+            pBlock->pNext = i + 1 < last ? pNext : nullptr;
+        }
+        auto* pHead = reinterpret_cast<FreeBlock*>(pSpan + first * blockSize);
+        if (pFirstBatch == nullptr)
+        {
+            pFirstBatch = pHead;
+        }
+        else
+        {
+            pHead->pNextBatch = pBatches;
+            pBatches          = pHead;
+        }
+    }
+
+    if (pBatches != nullptr)
+    {
+        FreeBlock* pTail = pBatches;
+        while (pTail->pNextBatch != nullptr)
+        {
+            pTail = pTail->pNextBatch;
+        }
+        CentralFreeList& central = g_centralLists[classIndex];
+        central.lock.Lock();
+        pTail->pNextBatch = central.pBatches;
+        central.pBatches  = pBatches;
+        central.lock.Unlock();
+    }
+    return pFirstBatch;
+}
+
+FreeBlock* FetchBatch(uint32_t classIndex)
+{
+    CentralFreeList& central = g_centralLists[classIndex];
+    central.lock.Lock();
+    FreeBlock* pBatch = central.pBatches;
+    if (pBatch != nullptr)
+    {
+        central.pBatches = pBatch->pNextBatch;
+    }
+    central.lock.Unlock();
+
+    return pBatch != nullptr ? pBatch : AllocSpan(classIndex);
+}
+
+void ReleaseBatch(uint32_t classIndex, FreeBlock* pBatch)
+{
+    CentralFreeList& central = g_centralLists[classIndex];
+    central.lock.Lock();
+    pBatch->pNextBatch = central.pBatches;
+    central.pBatches   = pBatch;
+    central.lock.Unlock();
+}
+
+struct ThreadFreeList
+{
+    FreeBlock* pHead{nullptr};
+    uint32_t count{0};
+};
+
+struct ThreadCache
+{
+    ThreadFreeList lists[SizeClassAllocator::cNumSizeClasses];
+
+    ~ThreadCache();
+
+    void Flush()
+    {
+        for (uint32_t classIndex = 0; classIndex < SizeClassAllocator::cNumSizeClasses;
+             ++classIndex)
+        {
+            ThreadFreeList& list = lists[classIndex];
+            while (list.pHead != nullptr)
+            {
+                ReleaseBatch(classIndex, DetachBatch(list, GetBatchSize(classIndex)));
+            }
+        }
+    }
+
+    static FreeBlock* DetachBatch(ThreadFreeList& list, uint32_t batchSize)
+    {
+        FreeBlock* pBatch = list.pHead;
+        FreeBlock* pTail  = pBatch;
+        uint32_t count    = 1;
+        while (count < batchSize && pTail->pNext != nullptr)
+        {
+            pTail = pTail->pNext;
+            ++count;
+        }
+        list.pHead   = pTail->pNext;
+        list.count  -= count;
+        pTail->pNext = nullptr;
+        return pBatch;
+    }
+};
+
+enum class ThreadCacheState : uint8_t
+{
+    Uninitialized,
+    Alive,
+    Destroyed
+};
+
+// trivially destructible, still readable while thread_local destructors run
+thread_local ThreadCacheState tl_threadCacheState = ThreadCacheState::Uninitialized;
+thread_local ThreadCache tl_threadCache;
+
+ThreadCache::~ThreadCache()
+{
+    Flush();
+    tl_threadCacheState = ThreadCacheState::Destroyed;
+}
+
+// nullptr once the calling thread is shutting down, callers then talk to the central heap
+inline ThreadCache* GetThreadCache()
+{
+    if (tl_threadCacheState == ThreadCacheState::Alive)
+    {
+        return &tl_threadCache;
+    }
+    if (tl_threadCacheState == ThreadCacheState::Destroyed)
+    {
+        return nullptr;
+    }
+    tl_threadCacheState = ThreadCacheState::Alive;
+    return &tl_threadCache;
+}
+} // namespace
+
+void* SizeClassAllocator::Alloc(size_t size)
+{
+    const uint32_t classIndex = SizeToClassIndex(size);
+    ThreadCache* pCache       = GetThreadCache();
+    if (pCache == nullptr)
+    {
+        FreeBlock* pBatch = FetchBatch(classIndex);
+        if (pBatch == nullptr)
+        {
+            return nullptr;
+        }
+        if (pBatch->pNext != nullptr)
+        {
+            ReleaseBatch(classIndex, pBatch->pNext);
+        }
+        return pBatch;
+    }
+
+    ThreadFreeList& list = pCache->lists[classIndex];
+    if (list.pHead == nullptr)
+    {
+        list.pHead = FetchBatch(classIndex);
+        if (list.pHead == nullptr)
+        {
+            return nullptr;
+        }
+        list.count = 0;
+        for (FreeBlock* pBlock = list.pHead; pBlock != nullptr; pBlock = pBlock->pNext)
+        {
+            ++list.count;
+        }
+    }
+    FreeBlock* pBlock = list.pHead;
+    list.pHead        = pBlock->pNext;
+    --list.count;
+    return pBlock;
+}
+
+void SizeClassAllocator::Free(void* pMem)
+{
+    const uint32_t classIndex = LookupPage(pMem) - 1;
+    auto* pBlock              = static_cast<FreeBlock*>(pMem);
+    ThreadCache* pCache       = GetThreadCache();
+    if (pCache == nullptr)
+    {
+        pBlock->pNext = nullptr;
+        ReleaseBatch(classIndex, pBlock);
+        return;
+    }
+
+    ThreadFreeList& list = pCache->lists[classIndex];
+    pBlock->pNext        = list.pHead;
+    list.pHead           = pBlock;
+    ++list.count;
+
+    // keep at most two batches per class, give the oldest one back
+    const uint32_t batchSize = GetBatchSize(classIndex);
+    if (list.count >= 2 * batchSize)
+    {
+        FreeBlock* pKeep = list.pHead;
+        for (uint32_t i = 1; i < batchSize; ++i)
+        {
+            pKeep = pKeep->pNext;
+        }
+        FreeBlock* pBatch = pKeep->pNext;
+        pKeep->pNext      = nullptr;
+        list.count        = batchSize;
+        ReleaseBatch(classIndex, pBatch);
+    }
+}
+
+bool SizeClassAllocator::Owns(const void* pMem)
+{
+    return pMem != nullptr && LookupPage(pMem) != 0;
+}
+
+size_t SizeClassAllocator::GetBlockSize(const void* pMem)
+{
+    const uint32_t page = pMem != nullptr ? LookupPage(pMem) : 0;
+    return page != 0 ? ClassIndexToSize(page - 1) : 0;
+}
+
+size_t SizeClassAllocator::GetSizeClassSize(size_t size)
+{
+    return IsSmall(size, 1) ? ClassIndexToSize(SizeToClassIndex(size)) : 0;
+}
+
+size_t SizeClassAllocator::GetReservedBytes()
+{
+    return g_reservedBytes.load(std::memory_order_relaxed);
+}
+
+void SizeClassAllocator::FlushThreadCache()
+{
+    if (ThreadCache* pCache = GetThreadCache())
+    {
+        pCache->Flush();
+    }
+}
+} // namespace zen
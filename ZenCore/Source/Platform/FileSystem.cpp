@@ -1,6 +1,15 @@
 #include "Platform/FileSystem.h"
 #include "Utils/Errors.h"
+#include <filesystem>
 #include <fstream>
+#if defined(ZEN_WIN32)
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
 
 namespace zen::platform
 {
@@ -16,6 +25,110 @@ std::string FileSystem::LoadTextFile(const std::string& path)
     return std::string{(std::istreambuf_iterator<char>(file)), (std::istreambuf_iterator<char>())};
 }
 
+bool FileSystem::WriteBinaryFileAtomic(const std::string& path,
+                                       const uint8_t* pData,
+                                       size_t size,
+                                       const std::string& tempPath)
+{
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    const fs::path targetPath(path);
+    if (targetPath.has_parent_path())
+    {
+        fs::create_directories(targetPath.parent_path(), ec);
+    }
+    const fs::path writePath = tempPath.empty() ? fs::path(path + ".tmp") : fs::path(tempPath);
+    {
+        std::ofstream file(writePath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(pData), static_cast<std::streamsize>(size));
+        if (!file)
+        {
+            LOGW("Failed to write {}", writePath.string());
+            fs::remove(writePath, ec);
+            return false;
+        }
+    }
+    fs::rename(writePath, targetPath, ec);
+    if (ec)
+    {
+        LOGW("Failed to write {}: {}", path, ec.message());
+        fs::remove(writePath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+#if defined(ZEN_WIN32)
+    HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+    HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(hFile);
+    if (hMapping == nullptr)
+    {
+        return false;
+    }
+    // the view keeps the mapping alive
+    void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(hMapping);
+    if (pView == nullptr)
+    {
+        return false;
+    }
+    m_pData = static_cast<const uint8_t*>(pView);
+    m_size  = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    void* pView = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps the file alive
+    close(fd);
+    if (pView == MAP_FAILED)
+    {
+        return false;
+    }
+    m_pData = static_cast<const uint8_t*>(pView);
+    m_size  = static_cast<size_t>(fileStat.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_pData == nullptr)
+    {
+        return;
+    }
+#if defined(ZEN_WIN32)
+    UnmapViewOfFile(m_pData);
+#else
+    munmap(const_cast<uint8_t*>(m_pData), m_size);
+#endif
+    m_pData = nullptr;
+    m_size  = 0;
+}
+
 // template <typename T> std::vector<T> FileSystem::LoadSpvFile(const std::string& name)
 // {
 //     const auto path = std::string(SPV_SHADER_PATH) + name;
@@ -0,0 +1,67 @@
+#include <cstring>
+#include "SceneGraph/DrawList.h"
+#include "Utils/RadixSort.h"
+
+namespace zen::sg
+{
+uint32_t DrawKey::EncodeDepth(float depth)
+{
+    // also catches NaN
+    if (!(depth > 0.0f))
+    {
+        return 0;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits;
+}
+
+uint64_t DrawKey::Make(uint32_t pass,
+                       uint32_t pipeline,
+                       uint32_t material,
+                       float depth,
+                       bool backToFront)
+{
+    const uint64_t passBits = static_cast<uint64_t>(pass & ((1u << cPassBits) - 1)) << cPassShift;
+    if (backToFront)
+    {
+        return passBits | ~EncodeDepth(depth);
+    }
+    return passBits |
+        (static_cast<uint64_t>(pipeline & ((1u << cPipelineBits) - 1)) << cPipelineShift) |
+        (static_cast<uint64_t>(material & ((1u << cMaterialBits) - 1)) << cMaterialShift) |
+        EncodeDepth(depth);
+}
+
+void DrawList::Clear()
+{
+    m_keys.clear();
+    m_items.clear();
+}
+
+void DrawList::Reserve(uint32_t count)
+{
+    m_keys.reserve(count);
+    m_items.reserve(count);
+}
+
+void DrawList::Sort(JobSystem* pJobSystem)
+{
+    const uint32_t count = GetSize();
+    m_order.resize(count);
+    m_scratchKeys.resize(count);
+    m_scratchOrder.resize(count);
+    m_sortedItems.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        m_order[i] = i;
+    }
+    RadixSort::Sort(m_keys.data(), m_order.data(), m_scratchKeys.data(), m_scratchOrder.data(),
+                    count, pJobSystem);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        m_sortedItems[i] = m_items[m_order[i]];
+    }
+    m_items.swap(m_sortedItems);
+}
+} // namespace zen::sg
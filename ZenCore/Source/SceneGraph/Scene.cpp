@@ -1,4 +1,3 @@
-#include <map>
 #include "SceneGraph/Scene.h"
 #include "SceneGraph/Camera.h"
 
@@ -18,34 +17,87 @@ void Scene::UpdateAABB()
     }
 }
 
-std::vector<std::pair<Node*, SubMesh*>> Scene::GetSortedSubMeshes(const Vec3& eyePos,
-                                                                  const Mat4& transform)
+void Scene::BuildTransformHierarchy()
 {
-    std::vector<std::pair<Node*, SubMesh*>> result;
+    m_transformHierarchy.Clear();
+    m_transformHierarchy.Reserve(static_cast<uint32_t>(m_nodes.size()));
+    for (auto& node : m_nodes)
+    {
+        if (node->GetParent() == nullptr)
+        {
+            AddTransformHierarchyNode(node.Get(), TransformHierarchy::cInvalidIndex);
+        }
+    }
+}
+
+void Scene::AddTransformHierarchyNode(Node* pNode, uint32_t parent)
+{
+    uint32_t index = 0;
+    if (pNode->HasComponent<Transform>())
+    {
+        // includes the matrix set with Transform::SetLocalMatrix
+        index = m_transformHierarchy.AddNode(parent,
+                                             pNode->GetComponent<Transform>()->GetLocalMatrix());
+    }
+    else
+    {
+        index = m_transformHierarchy.AddNode(parent);
+    }
+    pNode->SetTransformIndex(index);
+    for (auto* pChild : pNode->GetChildren())
+    {
+        AddTransformHierarchyNode(pChild, index);
+    }
+}
 
-    std::multimap<float, std::pair<Node*, SubMesh*>> tmp;
+bool Scene::UpdateTransforms(JobSystem* pJobSystem)
+{
+    m_transformHierarchy.Update(pJobSystem);
+    bool moved = false;
+    for (auto* pNode : m_renderableNodes)
+    {
+        const uint32_t index = pNode->GetTransformIndex();
+        if (index != TransformHierarchy::cInvalidIndex && m_transformHierarchy.IsUpdated(index))
+        {
+            pNode->SetData({m_transformHierarchy.GetWorldMatrix(index),
+                            m_transformHierarchy.GetNormalMatrix(index)});
+            moved = true;
+        }
+    }
+    if (moved && !m_bvh.IsEmpty())
+    {
+        m_bvh.Refit();
+    }
+    return moved;
+}
+
+void Scene::BuildDrawList(const Vec3& eyePos,
+                          const Mat4& transform,
+                          DrawList& drawList,
+                          JobSystem* pJobSystem)
+{
+    drawList.Clear();
     for (auto& mesh : GetComponents<Mesh>())
     {
         for (auto& node : mesh->GetNodes())
         {
-            auto worldMat = node->GetComponent<Transform>()->GetWorldMatrix();
+            const Mat4 worldMat = transform * node->GetComponent<Transform>()->GetWorldMatrix();
             for (auto& subMesh : mesh->GetSubMeshes())
             {
-                const sg::AABB& meshBounds = subMesh->GetAABB();
+                const Vec3 center = Vec3(worldMat * Vec4(subMesh->GetAABB().GetCenter(), 1.0f));
+                const float distance = glm::length(eyePos - center);
 
-                sg::AABB worldBounds{meshBounds.GetMin(), meshBounds.GetMax()};
-                worldBounds.Transform(transform * worldMat);
-
-                float distance = glm::length(eyePos - worldBounds.GetCenter());
-                tmp.emplace(distance, std::make_pair(node, subMesh));
+                const Material* pMaterial = subMesh->GetMaterial();
+                const AlphaMode alphaMode = pMaterial ? pMaterial->alphaMode : AlphaMode::Opaque;
+                const bool doubleSided    = pMaterial != nullptr && pMaterial->doubleSided;
+                drawList.Add(DrawKey::Make(static_cast<uint32_t>(alphaMode), doubleSided ? 1 : 0,
+                                           subMesh->GetMaterialIndex(), distance,
+                                           alphaMode == AlphaMode::Blend),
+                             node, subMesh);
             }
         }
     }
-    for (auto nodeIt = tmp.begin(); nodeIt != tmp.end(); nodeIt++)
-    {
-        result.push_back(nodeIt->second);
-    }
-    return result;
+    drawList.Sort(pJobSystem);
 }
 
 void Scene::LoadDefaultTextures(uint32_t startIndex)
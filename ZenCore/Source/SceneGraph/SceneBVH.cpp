@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <limits>
+#include "SceneGraph/SceneBVH.h"
+#include "SceneGraph/Scene.h"
+#include "Utils/Errors.h"
+#include "Graphics/Types/Frustum.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define ZEN_BVH_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define ZEN_BVH_NEON 1
+#endif
+
+namespace zen::sg
+{
+namespace
+{
+// frustum planes split into components, |n| turns the box extent into a projected radius
+struct CullPlanes
+{
+    float nx[6];
+    float ny[6];
+    float nz[6];
+    float absNx[6];
+    float absNy[6];
+    float absNz[6];
+    float w[6];
+};
+
+// bit i of outsideMask: box i is behind one of the planes, bit i of intersectMask: box i is not
+// completely in front of all planes
+template <class Node>
+void TestBoxes(const Node& node,
+               const CullPlanes& planes,
+               uint32_t& outsideMask,
+               uint32_t& intersectMask)
+{
+#if defined(ZEN_BVH_SSE2)
+    const __m128 cx   = _mm_load_ps(node.centerX);
+    const __m128 cy   = _mm_load_ps(node.centerY);
+    const __m128 cz   = _mm_load_ps(node.centerZ);
+    const __m128 ex   = _mm_load_ps(node.extentX);
+    const __m128 ey   = _mm_load_ps(node.extentY);
+    const __m128 ez   = _mm_load_ps(node.extentZ);
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 outside   = _mm_setzero_ps();
+    __m128 intersect = _mm_setzero_ps();
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        const __m128 dist = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(planes.nx[i])),
+                       _mm_mul_ps(cy, _mm_set1_ps(planes.ny[i]))),
+            _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(planes.nz[i])), _mm_set1_ps(planes.w[i])));
+        const __m128 radius =
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(planes.absNx[i])),
+                                  _mm_mul_ps(ey, _mm_set1_ps(planes.absNy[i]))),
+                       _mm_mul_ps(ez, _mm_set1_ps(planes.absNz[i])));
+        outside   = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), zero));
+        intersect = _mm_or_ps(intersect, _mm_cmplt_ps(_mm_sub_ps(dist, radius), zero));
+    }
+    outsideMask   = static_cast<uint32_t>(_mm_movemask_ps(outside));
+    intersectMask = static_cast<uint32_t>(_mm_movemask_ps(intersect));
+#elif defined(ZEN_BVH_NEON)
+    const float32x4_t cx   = vld1q_f32(node.centerX);
+    const float32x4_t cy   = vld1q_f32(node.centerY);
+    const float32x4_t cz   = vld1q_f32(node.centerZ);
+    const float32x4_t ex   = vld1q_f32(node.extentX);
+    const float32x4_t ey   = vld1q_f32(node.extentY);
+    const float32x4_t ez   = vld1q_f32(node.extentZ);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    uint32x4_t outside   = vdupq_n_u32(0);
+    uint32x4_t intersect = vdupq_n_u32(0);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        float32x4_t dist = vdupq_n_f32(planes.w[i]);
+        dist             = vmlaq_n_f32(dist, cx, planes.nx[i]);
+        dist             = vmlaq_n_f32(dist, cy, planes.ny[i]);
+        dist             = vmlaq_n_f32(dist, cz, planes.nz[i]);
+        float32x4_t radius = vmulq_n_f32(ex, planes.absNx[i]);
+        radius             = vmlaq_n_f32(radius, ey, planes.absNy[i]);
+        radius             = vmlaq_n_f32(radius, ez, planes.absNz[i]);
+        outside   = vorrq_u32(outside, vcltq_f32(vaddq_f32(dist, radius), zero));
+        intersect = vorrq_u32(intersect, vcltq_f32(vsubq_f32(dist, radius), zero));
+    }
+    // NEON has no movemask, weight the lanes and add them up
+    const uint32x4_t bits = {1, 2, 4, 8};
+    outsideMask           = vaddvq_u32(vandq_u32(outside, bits));
+    intersectMask         = vaddvq_u32(vandq_u32(intersect, bits));
+#else
+    outsideMask   = 0;
+    intersectMask = 0;
+    for (uint32_t slot = 0; slot < 4; slot++)
+    {
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            const float dist = node.centerX[slot] * planes.nx[i] +
+                node.centerY[slot] * planes.ny[i] + node.centerZ[slot] * planes.nz[i] +
+                planes.w[i];
+            const float radius = node.extentX[slot] * planes.absNx[i] +
+                node.extentY[slot] * planes.absNy[i] + node.extentZ[slot] * planes.absNz[i];
+            outsideMask |= static_cast<uint32_t>(dist + radius < 0.0f) << slot;
+            intersectMask |= static_cast<uint32_t>(dist - radius < 0.0f) << slot;
+        }
+    }
+#endif
+}
+} // namespace
+
+AABB SceneBVH::TransformAABB(const AABB& aabb, const Mat4& model)
+{
+    const Vec3 center = Vec3(model * Vec4(aabb.GetCenter(), 1.0f));
+    const Vec3 extent = (aabb.GetMax() - aabb.GetMin()) * 0.5f;
+
+    Vec3 worldExtent;
+    for (int row = 0; row < 3; row++)
+    {
+        worldExtent[row] = std::abs(model[0][row]) * extent.x +
+            std::abs(model[1][row]) * extent.y + std::abs(model[2][row]) * extent.z;
+    }
+    return AABB(center - worldExtent, center + worldExtent);
+}
+
+void SceneBVH::Clear()
+{
+    m_items.clear();
+    m_itemBounds.clear();
+    m_itemOrder.clear();
+    m_nodes.clear();
+}
+
+void SceneBVH::Build(Scene* pScene)
+{
+    Clear();
+    for (auto* pNode : pScene->GetRenderableNodes())
+    {
+        const Mat4& model = pNode->GetData().modelMatrix;
+        for (auto* pSubMesh : pNode->GetComponent<Mesh>()->GetSubMeshes())
+        {
+            if (pSubMesh->GetIndexCount() == 0)
+            {
+                continue;
+            }
+            m_items.push_back({pNode, pSubMesh});
+            m_itemBounds.emplace_back();
+            SetItemBounds(GetNumItems() - 1, TransformAABB(pSubMesh->GetAABB(), model));
+        }
+    }
+    BuildTree();
+}
+
+void SceneBVH::Build(const std::vector<AABB>& bounds)
+{
+    Clear();
+    m_items.resize(bounds.size());
+    m_itemBounds.resize(bounds.size());
+    for (uint32_t i = 0; i < bounds.size(); i++)
+    {
+        SetItemBounds(i, bounds[i]);
+    }
+    BuildTree();
+}
+
+void SceneBVH::Refit()
+{
+    for (uint32_t i = 0; i < GetNumItems(); i++)
+    {
+        const Item& item = m_items[i];
+        if (item.pNode != nullptr)
+        {
+            SetItemBounds(i, TransformAABB(item.pSubMesh->GetAABB(),
+                                           item.pNode->GetData().modelMatrix));
+        }
+    }
+    RefitNodes();
+}
+
+void SceneBVH::Refit(const std::vector<AABB>& bounds)
+{
+    VERIFY_EXPR(bounds.size() == m_items.size());
+    for (uint32_t i = 0; i < GetNumItems(); i++)
+    {
+        SetItemBounds(i, bounds[i]);
+    }
+    RefitNodes();
+}
+
+void SceneBVH::SetItemBounds(uint32_t index, const AABB& aabb)
+{
+    m_itemBounds[index].center = aabb.GetCenter();
+    m_itemBounds[index].extent = (aabb.GetMax() - aabb.GetMin()) * 0.5f;
+}
+
+void SceneBVH::BuildTree()
+{
+    m_itemOrder.resize(m_items.size());
+    for (uint32_t i = 0; i < GetNumItems(); i++)
+    {
+        m_itemOrder[i] = i;
+    }
+    if (m_items.empty())
+    {
+        return;
+    }
+    // leaves hold single items, a full 4-wide tree has about n / 3 nodes
+    m_nodes.reserve(m_items.size() / 3 + 1);
+    BuildNode(0, GetNumItems());
+    RefitNodes();
+}
+
+uint32_t SceneBVH::BuildNode(uint32_t begin, uint32_t end)
+{
+    const uint32_t nodeIndex = GetNumNodes();
+    m_nodes.emplace_back();
+    m_nodes[nodeIndex].firstItem = begin;
+    m_nodes[nodeIndex].numItems  = end - begin;
+
+    // median split on the longest centroid axis
+    auto split = [this](uint32_t first, uint32_t last) {
+        Vec3 minCenter(std::numeric_limits<float>::max());
+        Vec3 maxCenter(std::numeric_limits<float>::lowest());
+        for (uint32_t i = first; i < last; i++)
+        {
+            minCenter = glm::min(minCenter, m_itemBounds[m_itemOrder[i]].center);
+            maxCenter = glm::max(maxCenter, m_itemBounds[m_itemOrder[i]].center);
+        }
+        const Vec3 size = maxCenter - minCenter;
+        const int axis  = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+        const uint32_t mid = first + (last - first) / 2;
+        std::nth_element(m_itemOrder.begin() + first, m_itemOrder.begin() + mid,
+                         m_itemOrder.begin() + last, [this, axis](uint32_t lhs, uint32_t rhs) {
+                             return m_itemBounds[lhs].center[axis] <
+                                 m_itemBounds[rhs].center[axis];
+                         });
+        return mid;
+    };
+
+    // up to 4 groups, each becomes an item slot or a child node
+    uint32_t groups[cWidth + 1];
+    uint32_t numGroups = 0;
+    if (end - begin <= cWidth)
+    {
+        for (uint32_t i = begin; i <= end; i++)
+        {
+            groups[numGroups++] = i;
+        }
+        numGroups--;
+    }
+    else
+    {
+        const uint32_t mid = split(begin, end);
+        groups[0]          = begin;
+        groups[1]          = split(begin, mid);
+        groups[2]          = mid;
+        groups[3]          = split(mid, end);
+        groups[4]          = end;
+        numGroups          = cWidth;
+    }
+
+    for (uint32_t slot = 0; slot < cWidth; slot++)
+    {
+        uint32_t child = cEmptySlot;
+        if (slot < numGroups)
+        {
+            const uint32_t first = groups[slot];
+            const uint32_t last  = groups[slot + 1];
+            child = last - first == 1 ? (m_itemOrder[first] | cItemFlag) : BuildNode(first, last);
+        }
+        // m_nodes may have grown
+        m_nodes[nodeIndex].children[slot] = child;
+    }
+    return nodeIndex;
+}
+
+void SceneBVH::SetSlot(BVHNode& node, uint32_t slot, const Vec3& center, const Vec3& extent)
+{
+    node.centerX[slot] = center.x;
+    node.centerY[slot] = center.y;
+    node.centerZ[slot] = center.z;
+    node.extentX[slot] = extent.x;
+    node.extentY[slot] = extent.y;
+    node.extentZ[slot] = extent.z;
+}
+
+void SceneBVH::RefitNodes()
+{
+    // children are created after their parents
+    for (uint32_t n = GetNumNodes(); n-- > 0;)
+    {
+        BVHNode& node = m_nodes[n];
+        for (uint32_t slot = 0; slot < cWidth; slot++)
+        {
+            const uint32_t child = node.children[slot];
+            if (child == cEmptySlot)
+            {
+                SetSlot(node, slot, Vec3(0.0f), Vec3(0.0f));
+            }
+            else if ((child & cItemFlag) != 0)
+            {
+                const ItemBounds& bounds = m_itemBounds[child & ~cItemFlag];
+                SetSlot(node, slot, bounds.center, bounds.extent);
+            }
+            else
+            {
+                const BVHNode& childNode = m_nodes[child];
+                Vec3 minPos(std::numeric_limits<float>::max());
+                Vec3 maxPos(std::numeric_limits<float>::lowest());
+                for (uint32_t i = 0; i < cWidth; i++)
+                {
+                    if (childNode.children[i] == cEmptySlot)
+                    {
+                        continue;
+                    }
+                    const Vec3 center(childNode.centerX[i], childNode.centerY[i],
+                                      childNode.centerZ[i]);
+                    const Vec3 extent(childNode.extentX[i], childNode.extentY[i],
+                                      childNode.extentZ[i]);
+                    minPos = glm::min(minPos, center - extent);
+                    maxPos = glm::max(maxPos, center + extent);
+                }
+                SetSlot(node, slot, (minPos + maxPos) * 0.5f, (maxPos - minPos) * 0.5f);
+            }
+        }
+    }
+}
+
+void SceneBVH::Cull(const Frustum& frustum, std::vector<uint32_t>& visibleItems) const
+{
+    if (m_nodes.empty())
+    {
+        return;
+    }
+    CullPlanes planes;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        const Vec4& plane = frustum.GetPlanes()[i];
+        planes.nx[i]      = plane.x;
+        planes.ny[i]      = plane.y;
+        planes.nz[i]      = plane.z;
+        planes.absNx[i]   = std::abs(plane.x);
+        planes.absNy[i]   = std::abs(plane.y);
+        planes.absNz[i]   = std::abs(plane.z);
+        planes.w[i]       = plane.w;
+    }
+
+    uint32_t stack[64];
+    uint32_t stackSize  = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0)
+    {
+        const BVHNode& node = m_nodes[stack[--stackSize]];
+        uint32_t outsideMask, intersectMask;
+        TestBoxes(node, planes, outsideMask, intersectMask);
+        for (uint32_t slot = 0; slot < cWidth; slot++)
+        {
+            const uint32_t child = node.children[slot];
+            if (child == cEmptySlot || (outsideMask & (1u << slot)) != 0)
+            {
+                continue;
+            }
+            if ((child & cItemFlag) != 0)
+            {
+                visibleItems.push_back(child & ~cItemFlag);
+            }
+            else if ((intersectMask & (1u << slot)) == 0)
+            {
+                // completely inside, skip the tests below
+                const BVHNode& childNode = m_nodes[child];
+                visibleItems.insert(visibleItems.end(),
+                                    m_itemOrder.begin() + childNode.firstItem,
+                                    m_itemOrder.begin() + childNode.firstItem +
+                                        childNode.numItems);
+            }
+            else
+            {
+                stack[stackSize++] = child;
+            }
+        }
+    }
+}
+} // namespace zen::sg
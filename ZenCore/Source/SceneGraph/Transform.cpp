@@ -19,10 +19,12 @@ void Transform::UpdateWorldMatrix()
     auto parent   = m_node.GetParent();
     while (parent)
     {
+        // the closest transformed ancestor already includes the rest of the chain
         if (parent->HasComponent<Transform>())
         {
             auto* pTransform = parent->GetComponent<Transform>();
             m_worldMatrix   = pTransform->GetWorldMatrix() * m_worldMatrix;
+            break;
         }
         // Get parent node
         parent = parent->GetParent();
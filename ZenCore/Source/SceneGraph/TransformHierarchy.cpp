@@ -0,0 +1,158 @@
+#include <algorithm>
+#include "SceneGraph/TransformHierarchy.h"
+#include "Utils/Errors.h"
+#include "Utils/JobSystem.h"
+
+namespace zen::sg
+{
+// same operations as Transform, results match bit for bit
+static Mat4 ComposeLocalMatrix(const Vec3& translation, const Quat& rotation, const Vec3& scale)
+{
+    return glm::translate(Mat4(1.0f), translation) * glm::mat4_cast(rotation) *
+        glm::scale(Mat4(1.0f), scale);
+}
+
+uint32_t TransformHierarchy::AddNode(uint32_t parent,
+                                     const Vec3& translation,
+                                     const Quat& rotation,
+                                     const Vec3& scale)
+{
+    return AddNode(parent, ComposeLocalMatrix(translation, rotation, scale));
+}
+
+uint32_t TransformHierarchy::AddNode(uint32_t parent, const Mat4& localMatrix)
+{
+    const uint32_t index = GetNumNodes();
+    // keep subtrees contiguous, a node can only be appended to the open branch
+    VERIFY_EXPR(parent == cInvalidIndex || m_subtreeEnds[parent] == index);
+
+    m_parents.push_back(parent);
+    m_subtreeEnds.push_back(index + 1);
+    m_localMatrices.push_back(localMatrix);
+    m_worldMatrices.emplace_back(1.0f);
+    m_normalMatrices.emplace_back(1.0f);
+    m_flags.push_back(0);
+    for (uint32_t ancestor = parent; ancestor != cInvalidIndex; ancestor = m_parents[ancestor])
+    {
+        m_subtreeEnds[ancestor] = index + 1;
+    }
+    MarkDirty(index);
+    return index;
+}
+
+void TransformHierarchy::SetLocalTransform(uint32_t index,
+                                           const Vec3& translation,
+                                           const Quat& rotation,
+                                           const Vec3& scale)
+{
+    SetLocalMatrix(index, ComposeLocalMatrix(translation, rotation, scale));
+}
+
+void TransformHierarchy::SetLocalMatrix(uint32_t index, const Mat4& localMatrix)
+{
+    m_localMatrices[index] = localMatrix;
+    MarkDirty(index);
+}
+
+void TransformHierarchy::MarkDirty(uint32_t index)
+{
+    m_flags[index] |= cFlagDirty;
+    m_dirtyBegin = std::min(m_dirtyBegin, index);
+    m_dirtyEnd   = std::max(m_dirtyEnd, m_subtreeEnds[index]);
+}
+
+void TransformHierarchy::Clear()
+{
+    m_parents.clear();
+    m_subtreeEnds.clear();
+    m_localMatrices.clear();
+    m_worldMatrices.clear();
+    m_normalMatrices.clear();
+    m_flags.clear();
+    m_dirtyBegin   = cInvalidIndex;
+    m_dirtyEnd     = 0;
+    m_updatedBegin = 0;
+    m_updatedEnd   = 0;
+}
+
+void TransformHierarchy::Reserve(uint32_t numNodes)
+{
+    m_parents.reserve(numNodes);
+    m_subtreeEnds.reserve(numNodes);
+    m_localMatrices.reserve(numNodes);
+    m_worldMatrices.reserve(numNodes);
+    m_normalMatrices.reserve(numNodes);
+    m_flags.reserve(numNodes);
+}
+
+void TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; i++)
+    {
+        // parents come first, their updated flag is final by the time a child is visited
+        const uint32_t parent = m_parents[i];
+        const bool parentUpdated =
+            parent != cInvalidIndex && (m_flags[parent] & cFlagUpdated) != 0;
+        if ((m_flags[i] & cFlagDirty) == 0 && !parentUpdated)
+        {
+            continue;
+        }
+        // same operations as Transform and Node::SetData, results match bit for bit
+        m_worldMatrices[i] = parent != cInvalidIndex ?
+            m_worldMatrices[parent] * m_localMatrices[i] :
+            m_localMatrices[i];
+        m_normalMatrices[i] = glm::transpose(glm::inverse(m_worldMatrices[i]));
+        m_flags[i]          = cFlagUpdated;
+    }
+}
+
+void TransformHierarchy::Update(JobSystem* pJobSystem)
+{
+    for (uint32_t i = m_updatedBegin; i < m_updatedEnd; i++)
+    {
+        m_flags[i] &= ~cFlagUpdated;
+    }
+    m_updatedBegin = 0;
+    m_updatedEnd   = 0;
+    if (m_dirtyBegin >= m_dirtyEnd)
+    {
+        return;
+    }
+    const uint32_t begin = m_dirtyBegin;
+    const uint32_t end   = m_dirtyEnd;
+
+    if (pJobSystem == nullptr || end - begin <= cNumNodesPerJob)
+    {
+        UpdateRange(begin, end);
+    }
+    else
+    {
+        // nodes above the split are updated here in order, each subtree that fits into a job
+        // only depends on them and is updated in parallel. Neighbouring small subtrees are
+        // batched into one job.
+        JobCounter counter;
+        uint32_t i = begin;
+        while (i < end)
+        {
+            if (std::min(m_subtreeEnds[i], end) - i > cNumNodesPerJob)
+            {
+                UpdateRange(i, i + 1);
+                i++;
+                continue;
+            }
+            uint32_t jobEnd = std::min(m_subtreeEnds[i], end);
+            while (jobEnd < end && std::min(m_subtreeEnds[jobEnd], end) - i <= cNumNodesPerJob)
+            {
+                jobEnd = std::min(m_subtreeEnds[jobEnd], end);
+            }
+            pJobSystem->Submit([this, i, jobEnd]() { UpdateRange(i, jobEnd); }, &counter);
+            i = jobEnd;
+        }
+        pJobSystem->Wait(&counter);
+    }
+    m_updatedBegin = begin;
+    m_updatedEnd   = end;
+    m_dirtyBegin   = cInvalidIndex;
+    m_dirtyEnd     = 0;
+}
+} // namespace zen::sg
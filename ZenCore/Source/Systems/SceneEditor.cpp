@@ -18,12 +18,23 @@ void SceneEditor::CenterAndNormalizeScene(sg::Scene* pScene)
     Mat4 translateMat   = glm::translate(Mat4(1.0f), center - pScene->GetAABB().GetCenter());
     Mat4 transformMat   = scaleMat * translateMat;
 
+    // nodes of the transform hierarchy get it through their root so it survives the next
+    // Scene::UpdateTransforms, every subtree starts with its root
+    sg::TransformHierarchy& hierarchy = pScene->GetTransformHierarchy();
+    for (uint32_t root = 0; root < hierarchy.GetNumNodes(); root = hierarchy.GetSubtreeEnd(root))
+    {
+        hierarchy.SetLocalMatrix(root, transformMat * hierarchy.GetLocalMatrix(root));
+    }
+
     for (auto* pSgNode : pScene->GetRenderableNodes())
     {
-        sg::NodeData nodeData = pSgNode->GetData();
-        nodeData.modelMatrix  = transformMat * nodeData.modelMatrix;
-        nodeData.normalMatrix = glm::transpose(glm::inverse(nodeData.modelMatrix));
-        pSgNode->SetData(nodeData);
+        if (pSgNode->GetTransformIndex() == sg::TransformHierarchy::cInvalidIndex)
+        {
+            sg::NodeData nodeData = pSgNode->GetData();
+            nodeData.modelMatrix  = transformMat * nodeData.modelMatrix;
+            nodeData.normalMatrix = glm::transpose(glm::inverse(nodeData.modelMatrix));
+            pSgNode->SetData(nodeData);
+        }
         for (auto* pSubMesh : pSgNode->GetComponent<sg::Mesh>()->GetSubMeshes()) {
             pSubMesh->GetAABB().Transform(transformMat);
         }
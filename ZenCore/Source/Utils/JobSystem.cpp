@@ -0,0 +1,273 @@
+#include "Utils/JobSystem.h"
+#include "Utils/Errors.h"
+
+namespace zen
+{
+static std::atomic<uint64_t> g_nextJobSystemId{1};
+
+// per thread cache of the context owned by the calling thread, keyed by JobSystem id so that a
+// stale entry is never matched by a JobSystem allocated at the same address
+static thread_local uint64_t tl_jobSystemId  = 0;
+static thread_local uint32_t tl_contextIndex = 0;
+
+JobSystem::JobSystem(uint32_t numWorkers) :
+    m_id(g_nextJobSystemId.fetch_add(1, std::memory_order_relaxed))
+{
+    if (numWorkers == 0)
+    {
+        const uint32_t numHwThreads = std::thread::hardware_concurrency();
+        numWorkers                  = numHwThreads > 1 ? numHwThreads - 1 : 1;
+    }
+    m_numWorkers = std::min(numWorkers, cMaxContexts / 2);
+
+    for (uint32_t i = 0; i < m_numWorkers; ++i)
+    {
+        m_contexts[i]        = MakeUnique<WorkerContext>();
+        m_contexts[i]->index = i;
+    }
+    m_numContexts.store(m_numWorkers, std::memory_order_release);
+
+    m_threads.reserve(m_numWorkers);
+    for (uint32_t i = 0; i < m_numWorkers; ++i)
+    {
+        m_threads.emplace_back(&JobSystem::WorkerMain, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    m_stop.store(true, std::memory_order_seq_cst);
+    m_wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+    m_wakeEpoch.notify_all();
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+
+    // run whatever is left so that counters and captured resources are released
+    const uint32_t numContexts = m_numContexts.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < numContexts; ++i)
+    {
+        while (Job* pJob = m_contexts[i]->queue.Steal())
+        {
+            pJob->pInvoke(pJob);
+            if (pJob->pCounter != nullptr)
+            {
+                pJob->pCounter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < numContexts; ++i)
+    {
+        for (Job* pChunk : m_contexts[i]->jobChunks)
+        {
+            delete[] pChunk;
+        }
+        m_contexts[i].Reset();
+    }
+}
+
+JobSystem::WorkerContext* JobSystem::GetContext()
+{
+    if (tl_jobSystemId == m_id)
+    {
+        return m_contexts[tl_contextIndex].Get();
+    }
+
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    m_contextLock.Lock();
+    const uint32_t numContexts = m_numContexts.load(std::memory_order_acquire);
+    WorkerContext* pContext    = nullptr;
+    // the thread may have been registered before it switched to another JobSystem
+    for (uint32_t i = m_numWorkers; i < numContexts; ++i)
+    {
+        if (m_contexts[i]->threadId == threadId)
+        {
+            pContext = m_contexts[i].Get();
+            break;
+        }
+    }
+    if (pContext == nullptr && numContexts < cMaxContexts)
+    {
+        m_contexts[numContexts]           = MakeUnique<WorkerContext>();
+        m_contexts[numContexts]->index    = numContexts;
+        m_contexts[numContexts]->threadId = threadId;
+        pContext                          = m_contexts[numContexts].Get();
+        m_numContexts.store(numContexts + 1, std::memory_order_release);
+    }
+    m_contextLock.Unlock();
+
+    if (pContext == nullptr)
+    {
+        LOGW("JobSystem: out of thread contexts, jobs will run inline.");
+        return nullptr;
+    }
+    tl_jobSystemId  = m_id;
+    tl_contextIndex = pContext->index;
+    return pContext;
+}
+
+Job* JobSystem::AllocJob()
+{
+    WorkerContext* pContext = GetContext();
+    if (pContext == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (pContext->pFreeList == nullptr)
+    {
+        pContext->pFreeList = pContext->pRemoteFreeList.exchange(nullptr, std::memory_order_acquire);
+    }
+    if (pContext->pFreeList == nullptr)
+    {
+        Job* pChunk = new Job[cJobChunkSize];
+        for (uint32_t i = 0; i < cJobChunkSize; ++i)
+        {
+            pChunk[i].ownerIndex = pContext->index;
+            pChunk[i].pNext      = i + 1 < cJobChunkSize ? &pChunk[i + 1] : nullptr;
+        }
+        pContext->jobChunks.push_back(pChunk);
+        pContext->pFreeList = pChunk;
+    }
+
+    Job* pJob           = pContext->pFreeList;
+    pContext->pFreeList = pJob->pNext;
+    return pJob;
+}
+
+void JobSystem::FreeJob(WorkerContext* pContext, Job* pJob)
+{
+    if (pJob->ownerIndex == pContext->index)
+    {
+        pJob->pNext         = pContext->pFreeList;
+        pContext->pFreeList = pJob;
+        return;
+    }
+    // push only stack, the owner takes the whole list at once so there is no ABA problem
+    WorkerContext* pOwner = m_contexts[pJob->ownerIndex].Get();
+    Job* pHead            = pOwner->pRemoteFreeList.load(std::memory_order_relaxed);
+    do
+    {
+        pJob->pNext = pHead;
+    } while (!pOwner->pRemoteFreeList.compare_exchange_weak(
+        pHead, pJob, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void JobSystem::Enqueue(Job* pJob)
+{
+    WorkerContext* pContext = m_contexts[pJob->ownerIndex].Get();
+    if (!pContext->queue.Push(pJob))
+    {
+        // queue is full, execute the job right away instead of blocking the producer
+        Execute(pContext, pJob);
+        return;
+    }
+    WakeWorkers();
+}
+
+void JobSystem::Execute(WorkerContext* pContext, Job* pJob)
+{
+    JobCounter* pCounter = pJob->pCounter;
+    pJob->pInvoke(pJob);
+    FreeJob(pContext, pJob);
+    if (pCounter != nullptr)
+    {
+        pCounter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+Job* JobSystem::FindJob(WorkerContext* pContext)
+{
+    if (Job* pJob = pContext->queue.Pop())
+    {
+        return pJob;
+    }
+    const uint32_t numContexts = m_numContexts.load(std::memory_order_acquire);
+    for (uint32_t i = 1; i < numContexts; ++i)
+    {
+        const uint32_t victim = (pContext->index + i) % numContexts;
+        if (Job* pJob = m_contexts[victim]->queue.Steal())
+        {
+            return pJob;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::HasPendingJobs() const
+{
+    const uint32_t numContexts = m_numContexts.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < numContexts; ++i)
+    {
+        if (!m_contexts[i]->queue.Empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::WakeWorkers()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_numSleeping.load(std::memory_order_relaxed) > 0)
+    {
+        m_wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+        m_wakeEpoch.notify_one();
+    }
+}
+
+void JobSystem::Wait(JobCounter* pCounter)
+{
+    WorkerContext* pContext = GetContext();
+    while (!pCounter->IsDone())
+    {
+        Job* pJob = pContext != nullptr ? FindJob(pContext) : nullptr;
+        if (pJob != nullptr)
+        {
+            Execute(pContext, pJob);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerMain(uint32_t index)
+{
+    WorkerContext* pContext = m_contexts[index].Get();
+    pContext->threadId      = std::this_thread::get_id();
+    tl_jobSystemId          = m_id;
+    tl_contextIndex         = index;
+
+    uint32_t numSpins = 0;
+    while (!m_stop.load(std::memory_order_relaxed))
+    {
+        if (Job* pJob = FindJob(pContext))
+        {
+            Execute(pContext, pJob);
+            numSpins = 0;
+            continue;
+        }
+        if (++numSpins < cSpinCount)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        // nothing to do, go to sleep until a producer bumps the wake epoch
+        m_numSleeping.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint32_t epoch = m_wakeEpoch.load(std::memory_order_seq_cst);
+        if (!HasPendingJobs() && !m_stop.load(std::memory_order_seq_cst))
+        {
+            m_wakeEpoch.wait(epoch, std::memory_order_seq_cst);
+        }
+        m_numSleeping.fetch_sub(1, std::memory_order_seq_cst);
+        numSpins = 0;
+    }
+}
+} // namespace zen
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "Utils/RadixSort.h"
+#include "Utils/JobSystem.h"
+
+namespace zen
+{
+namespace
+{
+constexpr uint32_t cNumPasses  = 8;
+constexpr uint32_t cNumBuckets = 256;
+// blocks per worker, keeps the workers busy when some blocks take longer
+constexpr uint32_t cBlocksPerWorker = 2;
+constexpr uint32_t cMaxBlocks       = 64;
+} // namespace
+
+void RadixSort::Sort(uint64_t* pKeys,
+                     uint32_t* pValues,
+                     uint64_t* pScratchKeys,
+                     uint32_t* pScratchValues,
+                     uint32_t count,
+                     JobSystem* pJobSystem)
+{
+    if (count < 2)
+    {
+        return;
+    }
+    uint32_t numBlocks = 1;
+    if (pJobSystem != nullptr && count >= cMinParallelCount)
+    {
+        numBlocks = std::min(cMaxBlocks, (pJobSystem->GetNumWorkers() + 1) * cBlocksPerWorker);
+    }
+    const uint32_t blockSize = (count + numBlocks - 1) / numBlocks;
+
+    // runs func(block) for every block, on the job system when there is more than one
+    auto forEachBlock = [&](auto&& func) {
+        if (numBlocks == 1)
+        {
+            func(0u);
+            return;
+        }
+        // ParallelFor keeps a reference, the range function has to outlive the wait
+        auto blockRange = [&func](uint32_t begin, uint32_t end) {
+            for (uint32_t block = begin; block < end; block++)
+            {
+                func(block);
+            }
+        };
+        JobCounter counter;
+        pJobSystem->ParallelFor(numBlocks, 1, blockRange, &counter);
+        pJobSystem->Wait(&counter);
+    };
+
+    // counts of every byte of every key, per block. Keys are only moved between blocks by the
+    // passes, so the totals also tell which passes can be skipped.
+    std::vector<uint32_t> counts(numBlocks * cNumPasses * cNumBuckets, 0);
+    forEachBlock([&](uint32_t block) {
+        uint32_t* pCounts   = counts.data() + block * cNumPasses * cNumBuckets;
+        const uint32_t last = std::min(count, (block + 1) * blockSize);
+        for (uint32_t i = block * blockSize; i < last; i++)
+        {
+            const uint64_t key = pKeys[i];
+            for (uint32_t pass = 0; pass < cNumPasses; pass++)
+            {
+                pCounts[pass * cNumBuckets + ((key >> (pass * 8)) & 0xFF)]++;
+            }
+        }
+    });
+
+    uint64_t* pSrcKeys    = pKeys;
+    uint32_t* pSrcValues  = pValues;
+    uint64_t* pDstKeys    = pScratchKeys;
+    uint32_t* pDstValues  = pScratchValues;
+    bool countsAreCurrent = true;
+    std::vector<uint32_t> offsets(numBlocks * cNumBuckets);
+    for (uint32_t pass = 0; pass < cNumPasses; pass++)
+    {
+        const uint32_t shift = pass * 8;
+        // skip bytes shared by all keys, the totals do not depend on the current order
+        bool skip = false;
+        for (uint32_t bucket = 0; bucket < cNumBuckets; bucket++)
+        {
+            uint32_t total = 0;
+            for (uint32_t block = 0; block < numBlocks; block++)
+            {
+                total += counts[(block * cNumPasses + pass) * cNumBuckets + bucket];
+            }
+            if (total == count)
+            {
+                skip = true;
+                break;
+            }
+            if (total != 0)
+            {
+                break;
+            }
+        }
+        if (skip)
+        {
+            continue;
+        }
+
+        // earlier passes moved keys between blocks, count this byte again
+        if (!countsAreCurrent)
+        {
+            forEachBlock([&](uint32_t block) {
+                uint32_t* pCounts = counts.data() + (block * cNumPasses + pass) * cNumBuckets;
+                std::fill(pCounts, pCounts + cNumBuckets, 0);
+                const uint32_t last = std::min(count, (block + 1) * blockSize);
+                for (uint32_t i = block * blockSize; i < last; i++)
+                {
+                    pCounts[(pSrcKeys[i] >> shift) & 0xFF]++;
+                }
+            });
+        }
+        countsAreCurrent = false;
+
+        // bucket major, block minor: equal keys keep their order across blocks
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < cNumBuckets; bucket++)
+        {
+            for (uint32_t block = 0; block < numBlocks; block++)
+            {
+                offsets[block * cNumBuckets + bucket] = offset;
+                offset += counts[(block * cNumPasses + pass) * cNumBuckets + bucket];
+            }
+        }
+
+        forEachBlock([&](uint32_t block) {
+            uint32_t* pOffsets  = offsets.data() + block * cNumBuckets;
+            const uint32_t last = std::min(count, (block + 1) * blockSize);
+            for (uint32_t i = block * blockSize; i < last; i++)
+            {
+                const uint32_t dst = pOffsets[(pSrcKeys[i] >> shift) & 0xFF]++;
+                pDstKeys[dst]      = pSrcKeys[i];
+                pDstValues[dst]    = pSrcValues[i];
+            }
+        });
+        std::swap(pSrcKeys, pDstKeys);
+        std::swap(pSrcValues, pDstValues);
+    }
+
+    if (pSrcKeys != pKeys)
+    {
+        std::memcpy(pKeys, pSrcKeys, sizeof(uint64_t) * count);
+        std::memcpy(pValues, pSrcValues, sizeof(uint32_t) * count);
+    }
+}
+} // namespace zen
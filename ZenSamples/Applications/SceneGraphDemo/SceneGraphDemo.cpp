@@ -103,11 +103,11 @@ void SceneGraphDemo::SetupRenderGraph()
 void SceneGraphDemo::RecordDrawCmdsSecondary(val::CommandBuffer* pPrimaryCmdBuffer,
                                              const RDGPhysicalPass& physicalPass)
 {
-    auto subMeshes =
-        m_scene->GetSortedSubMeshes(m_camera->GetPos(), m_cameraUniformData.modelMatrix);
+    m_scene->BuildDrawList(m_camera->GetPos(), m_cameraUniformData.modelMatrix, m_drawList);
+    const sg::DrawList& drawList = m_drawList;
 
     uint32_t num2ndCmdBuffers = RenderConfig::GetInstance().numSecondaryCmdBuffers;
-    uint32_t numMeshes        = util::ToU32(subMeshes.size());
+    uint32_t numMeshes        = drawList.GetSize();
     uint32_t numDrawPerCmd    = numMeshes / num2ndCmdBuffers;
     uint32_t numDrawRemained  = numMeshes % num2ndCmdBuffers;
     uint32_t meshStart        = 0;
@@ -124,9 +124,9 @@ void SceneGraphDemo::RecordDrawCmdsSecondary(val::CommandBuffer* pPrimaryCmdBuff
         }
         if (RenderConfig::GetInstance().numThreads > 1)
         {
-            auto fut = m_threadPool->Push([this, &pPrimaryCmdBuffer, meshStart, meshEnd, &subMeshes,
+            auto fut = m_threadPool->Push([this, &pPrimaryCmdBuffer, meshStart, meshEnd, &drawList,
                                            &physicalPass](uint32_t threadId) {
-                return RecordDrawCmdsSecondary(pPrimaryCmdBuffer, meshStart, meshEnd, subMeshes,
+                return RecordDrawCmdsSecondary(pPrimaryCmdBuffer, meshStart, meshEnd, drawList,
                                                physicalPass, threadId);
             });
 
@@ -135,7 +135,7 @@ void SceneGraphDemo::RecordDrawCmdsSecondary(val::CommandBuffer* pPrimaryCmdBuff
         else
         {
             secondaryCmds.push_back(RecordDrawCmdsSecondary(pPrimaryCmdBuffer, meshStart, meshEnd,
-                                                            subMeshes, physicalPass));
+                                                            drawList, physicalPass));
         }
 
         meshStart = meshEnd;
@@ -156,7 +156,7 @@ val::CommandBuffer* SceneGraphDemo::RecordDrawCmdsSecondary(
     uint32_t meshStart,
     uint32_t meshEnd,
     // all sub meshes and their nodes
-    const std::vector<std::pair<sg::Node*, sg::SubMesh*>>& subMeshes,
+    const sg::DrawList& drawList,
     // related scene graph physical pass
     const RDGPhysicalPass& physicalPass,
     // thread id for command buffer
@@ -189,8 +189,8 @@ val::CommandBuffer* SceneGraphDemo::RecordDrawCmdsSecondary(
     PushConstantsData pushConstantData = m_pushConstantData;
     for (auto i = meshStart; i < meshEnd; i++)
     {
-        auto* pNode    = subMeshes[i].first;
-        auto* pSubMesh = subMeshes[i].second;
+        auto* pNode    = drawList[i].pNode;
+        auto* pSubMesh = drawList[i].pSubMesh;
 
         pushConstantData.nodeIndex     = m_nodesUniformIndex[pNode->GetHash()];
         pushConstantData.materialIndex = pSubMesh->GetMaterial()->index;
@@ -6,6 +6,7 @@
 #include "Graphics/RenderCore/RenderBuffers.h"
 #include "Platform/Timer.h"
 #include "SceneGraph/Camera.h"
+#include "SceneGraph/DrawList.h"
 #include "Math/Math.h"
 #include "Graphics/RenderCore/TextureManager.h"
 #include "AssetLib/GLTFLoader.h"
@@ -99,7 +100,7 @@ private:
         uint32_t meshStart,
         uint32_t meshEnd,
         // all sub meshes and their nodes
-        const std::vector<std::pair<sg::Node*, sg::SubMesh*>>& subMeshes,
+        const sg::DrawList& drawList,
         // related scene graph physical pass
         const RDGPhysicalPass& physicalPass,
         // thread id for command buffer
@@ -129,6 +130,9 @@ private:
 
     UniquePtr<sg::Camera> m_camera;
 
+    // sorted sub meshes, rebuilt every frame
+    sg::DrawList m_drawList;
+
     UniquePtr<UniformBuffer> m_cameraUBO;
     CameraUniformData m_cameraUniformData{};
 
@@ -0,0 +1,99 @@
+#include "Memory/Memory.h"
+#include "Memory/SizeClassAllocator.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace zen;
+
+static constexpr uint32_t cNumOpsPerThread = 200000;
+static constexpr uint32_t cNumLiveBlocks   = 256;
+
+// every thread keeps a window of live blocks and replaces one of them per iteration with a new
+// block of a pseudo random small size, returns millions of alloc/free pairs per second
+template <class AllocFunc, class FreeFunc>
+static double RunAllocFree(uint32_t numThreads, AllocFunc&& allocFunc, FreeFunc&& freeFunc)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            void* liveBlocks[cNumLiveBlocks] = {};
+            uint32_t seed                    = 0x9E3779B9u * (t + 1);
+            for (uint32_t i = 0; i < cNumOpsPerThread; ++i)
+            {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                const uint32_t slot = seed % cNumLiveBlocks;
+                const size_t size   = 16 + (seed >> 8) % 1024;
+                if (liveBlocks[slot] != nullptr)
+                {
+                    freeFunc(liveBlocks[slot]);
+                }
+                liveBlocks[slot] = allocFunc(size);
+                static_cast<uint8_t*>(liveBlocks[slot])[0] = 1;
+            }
+            for (void* pMem : liveBlocks)
+            {
+                if (pMem != nullptr)
+                {
+                    freeFunc(pMem);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    const double elapsed = std::chrono::duration<double, std::milli>(
+                               std::chrono::high_resolution_clock::now() - start)
+                               .count();
+    return static_cast<double>(numThreads) * cNumOpsPerThread / elapsed / 1000.0;
+}
+
+static void* SystemAlloc(size_t size)
+{
+#if defined(_MSC_VER)
+    return _aligned_malloc(size, 16);
+#else
+    void* pMem = nullptr;
+    return posix_memalign(&pMem, 16, size) == 0 ? pMem : nullptr;
+#endif
+}
+
+static void SystemFree(void* pMem)
+{
+#if defined(_MSC_VER)
+    _aligned_free(pMem);
+#else
+    free(pMem);
+#endif
+}
+
+TEST(allocator_benchmark, alloc_free_throughput)
+{
+    const uint32_t threadCounts[] = {1, 2, 4, 8, 16, 32};
+    for (uint32_t numThreads : threadCounts)
+    {
+        const double systemMops = RunAllocFree(
+            numThreads, [](size_t size) { return SystemAlloc(size); },
+            [](void* pMem) { SystemFree(pMem); });
+        const double sizeClassMops = RunAllocFree(
+            numThreads, [](size_t size) { return SizeClassAllocator::Alloc(size); },
+            [](void* pMem) { SizeClassAllocator::Free(pMem); });
+        const double defaultMops = RunAllocFree(
+            numThreads, [](size_t size) { return ZEN_MEM_ALLOC(size); },
+            [](void* pMem) { ZEN_MEM_FREE(pMem); });
+
+        LOGI("{:>2} threads: system {:7.2f} Mops/s | SizeClassAllocator {:7.2f} Mops/s | "
+             "ZEN_MEM_ALLOC {:7.2f} Mops/s",
+             numThreads, systemMops, sizeClassMops, defaultMops);
+    }
+}
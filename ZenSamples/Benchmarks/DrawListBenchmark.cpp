@@ -0,0 +1,104 @@
+#include "SceneGraph/DrawList.h"
+#include "SceneGraph/Node.h"
+#include "Utils/JobSystem.h"
+#include "Utils/UniquePtr.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+#include <random>
+
+using namespace zen;
+
+static constexpr uint32_t cNumFrames = 5;
+
+static double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+struct BenchmarkDraw
+{
+    sg::Node* pNode;
+    uint32_t material;
+    float distance;
+};
+
+static void RunDrawListBenchmark(uint32_t numDraws, JobSystem& jobSystem)
+{
+    // submeshes spread over 256 nodes and 512 materials
+    std::vector<UniquePtr<sg::Node>> nodes;
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        nodes.emplace_back(MakeUnique<sg::Node>(i, ""));
+    }
+    std::mt19937 rng(numDraws);
+    std::uniform_real_distribution<float> distance(0.0f, 500.0f);
+    std::vector<BenchmarkDraw> draws(numDraws);
+    for (auto& draw : draws)
+    {
+        draw = {nodes[rng() % nodes.size()].Get(), static_cast<uint32_t>(rng() % 512),
+                distance(rng)};
+    }
+
+    // Scene::GetSortedSubMeshes: multimap on distance, copied into a vector
+    std::vector<std::pair<sg::Node*, sg::SubMesh*>> result;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        result.clear();
+        std::multimap<float, std::pair<sg::Node*, sg::SubMesh*>> tmp;
+        for (const auto& draw : draws)
+        {
+            tmp.emplace(draw.distance, std::make_pair(draw.pNode, nullptr));
+        }
+        for (auto it = tmp.begin(); it != tmp.end(); it++)
+        {
+            result.push_back(it->second);
+        }
+    }
+    const double multimapMs = ElapsedMs(start) / cNumFrames;
+
+    sg::DrawList drawList;
+    auto buildDrawList = [&](JobSystem* pJobSystem) {
+        drawList.Clear();
+        for (const auto& draw : draws)
+        {
+            drawList.Add(sg::DrawKey::Make(0, 0, draw.material, draw.distance), draw.pNode,
+                         nullptr);
+        }
+        drawList.Sort(pJobSystem);
+    };
+    // first build sizes the arrays
+    buildDrawList(nullptr);
+    start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        buildDrawList(nullptr);
+    }
+    const double serialMs = ElapsedMs(start) / cNumFrames;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        buildDrawList(&jobSystem);
+    }
+    const double parallelMs = ElapsedMs(start) / cNumFrames;
+
+    EXPECT_TRUE(std::is_sorted(drawList.GetKeys().begin(), drawList.GetKeys().end()));
+    LOGI("Sorting {} draws: multimap {:.3f} ms | radix {:.3f} ms ({:.2f}x) | {} workers {:.3f} "
+         "ms ({:.2f}x)",
+         numDraws, multimapMs, serialMs, multimapMs / serialMs, jobSystem.GetNumWorkers(),
+         parallelMs, multimapMs / parallelMs);
+}
+
+TEST(draw_list_benchmark, multimap_vs_radix)
+{
+    JobSystem jobSystem;
+    for (uint32_t numDraws : {10000u, 100000u, 1000000u})
+    {
+        RunDrawListBenchmark(numDraws, jobSystem);
+    }
+}
@@ -0,0 +1,43 @@
+#include "AssetLib/FastGLTFLoader.h"
+#include "SceneGraph/Scene.h"
+#include "Utils/Errors.h"
+#include "../CommonTest/SyntheticGltf.h"
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace zen;
+
+static double LoadSceneMs(const std::filesystem::path& gltfPath, bool parallelLoading)
+{
+    sg::Scene scene;
+    asset::FastGLTFLoader loader;
+    loader.SetParallelLoading(parallelLoading);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    loader.LoadFromFile(gltfPath.string(), &scene);
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+TEST(gltf_load_benchmark, synthetic_large_scene)
+{
+    // ~5M triangles over 64 primitives, in the range of our CAD scenes
+    SyntheticGltfDesc desc;
+    desc.numMeshes            = 16;
+    desc.numPrimitivesPerMesh = 4;
+    desc.gridSize             = 200;
+    const auto gltfPath       = WriteSyntheticGltf(
+        std::filesystem::temp_directory_path() / "ZenEngineBenchmarks" / "gltf_load", desc);
+
+    const double numTriangles = 2.0 * desc.numMeshes * desc.numPrimitivesPerMesh *
+        (desc.gridSize - 1) * (desc.gridSize - 1);
+
+    // warm the file cache so both runs read from memory
+    LoadSceneMs(gltfPath, true);
+    const double serialMs   = LoadSceneMs(gltfPath, false);
+    const double parallelMs = LoadSceneMs(gltfPath, true);
+
+    LOGI("glTF load ({:.1f}M triangles): serial {:.2f} ms | parallel {:.2f} ms ({:.2f}x)",
+         numTriangles / 1e6, serialMs, parallelMs, serialMs / parallelMs);
+}
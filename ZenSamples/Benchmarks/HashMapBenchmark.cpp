@@ -0,0 +1,113 @@
+#include "Templates/HashMap.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace zen;
+
+// engine maps range from a handful of passes to tens of thousands of cached objects
+static constexpr size_t cMapSizes[] = {64, 1024, 16384, 131072};
+static constexpr size_t cNumOpsPerRun = 1 << 20;
+
+struct MapTimings
+{
+    double insertNs{0};
+    double lookupNs{0};
+    double eraseNs{0};
+};
+
+static double ElapsedNs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() -
+                                                    start)
+        .count();
+}
+
+// builds and tears down maps of `size` keys until cNumOpsPerRun operations were timed, so small
+// maps are measured over enough iterations, returns the time per operation
+template <class Map, class Key> static MapTimings RunMap(const std::vector<Key>& keys, size_t size)
+{
+    MapTimings timings;
+    const size_t numRounds = std::max<size_t>(1, cNumOpsPerRun / size);
+    uint64_t checksum      = 0;
+    for (size_t round = 0; round < numRounds; ++round)
+    {
+        Map map;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < size; ++i)
+        {
+            map[keys[i]] = static_cast<uint32_t>(i);
+        }
+        timings.insertNs += ElapsedNs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < size; ++i)
+        {
+            // every other lookup misses
+            auto it = map.find(keys[(i * 7919) % (size * 2)]);
+            checksum += it != map.end() ? it->second : 1;
+        }
+        timings.lookupNs += ElapsedNs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < size; ++i)
+        {
+            checksum += map.erase(keys[i]);
+        }
+        timings.eraseNs += ElapsedNs(start);
+    }
+    EXPECT_NE(checksum, 0);
+
+    const double numOps = static_cast<double>(numRounds * size);
+    timings.insertNs /= numOps;
+    timings.lookupNs /= numOps;
+    timings.eraseNs /= numOps;
+    return timings;
+}
+
+template <class Key, class MakeKey>
+static void RunComparison(const char* pKeyName, MakeKey&& makeKey)
+{
+    for (size_t size : cMapSizes)
+    {
+        std::mt19937_64 rng(size);
+        std::vector<Key> keys;
+        keys.reserve(size * 2);
+        for (size_t i = 0; i < size * 2; ++i)
+        {
+            keys.push_back(makeKey(rng()));
+        }
+
+        const MapTimings stdTimings  = RunMap<std::unordered_map<Key, uint32_t>>(keys, size);
+        const MapTimings flatTimings = RunMap<HashMap<Key, uint32_t>>(keys, size);
+
+        LOGI("{} keys, size {:>6}: insert {:6.1f} / {:6.1f} ns | lookup {:6.1f} / {:6.1f} ns | "
+             "erase {:6.1f} / {:6.1f} ns (std::unordered_map / HashMap)",
+             pKeyName, size, stdTimings.insertNs, flatTimings.insertNs, stdTimings.lookupNs,
+             flatTimings.lookupNs, stdTimings.eraseNs, flatTimings.eraseNs);
+    }
+}
+
+TEST(hash_map_benchmark, uint64_keys)
+{
+    RunComparison<uint64_t>("uint64", [](uint64_t value) { return value; });
+}
+
+TEST(hash_map_benchmark, pointer_keys)
+{
+    // resource pointers as used by the render graph trackers, 64 byte aligned
+    RunComparison<const void*>("pointer", [](uint64_t value) {
+        return reinterpret_cast<const void*>((value & 0xFFFFFFFFFFull) << 6);
+    });
+}
+
+TEST(hash_map_benchmark, string_keys)
+{
+    RunComparison<std::string>("string", [](uint64_t value) {
+        return "Textures/Material_" + std::to_string(value);
+    });
+}
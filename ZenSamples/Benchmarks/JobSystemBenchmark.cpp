@@ -0,0 +1,62 @@
+#include "Utils/JobSystem.h"
+#include "Utils/ThreadPool.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace zen;
+
+static constexpr uint32_t cNumTinyTasks = 1000000;
+
+static double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+TEST(job_system_benchmark, tiny_tasks_thread_pool)
+{
+    const uint32_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<uint64_t> sum = 0;
+
+    ThreadPool<void, uint32_t> threadPool(numThreads);
+    std::vector<std::future<void>> futures;
+    futures.reserve(cNumTinyTasks);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < cNumTinyTasks; ++i)
+    {
+        futures.emplace_back(threadPool.Push(
+            [&sum, i](uint32_t threadId) { sum.fetch_add(i, std::memory_order_relaxed); }));
+    }
+    for (auto& fut : futures)
+    {
+        fut.get();
+    }
+    const double elapsed = ElapsedMs(start);
+
+    LOGI("ThreadPool: {} tiny tasks on {} threads in {:.2f} ms ({:.2f} Mtasks/s)", cNumTinyTasks,
+         numThreads, elapsed, cNumTinyTasks / elapsed / 1000.0);
+    EXPECT_EQ(sum.load(), static_cast<uint64_t>(cNumTinyTasks) * (cNumTinyTasks - 1) / 2);
+}
+
+TEST(job_system_benchmark, tiny_tasks_job_system)
+{
+    std::atomic<uint64_t> sum = 0;
+
+    JobSystem jobSystem;
+    JobCounter counter;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < cNumTinyTasks; ++i)
+    {
+        jobSystem.Submit([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+    }
+    jobSystem.Wait(&counter);
+    const double elapsed = ElapsedMs(start);
+
+    LOGI("JobSystem: {} tiny tasks on {} workers + caller in {:.2f} ms ({:.2f} Mtasks/s)",
+         cNumTinyTasks, jobSystem.GetNumWorkers(), elapsed, cNumTinyTasks / elapsed / 1000.0);
+    EXPECT_EQ(sum.load(), static_cast<uint64_t>(cNumTinyTasks) * (cNumTinyTasks - 1) / 2);
+}
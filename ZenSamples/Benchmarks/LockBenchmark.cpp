@@ -0,0 +1,63 @@
+#include "Utils/Mutex.h"
+#include "Utils/SpinLock.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace zen;
+
+static constexpr uint32_t cNumLocksPerThread = 200000;
+
+// every thread takes the lock cNumLocksPerThread times around a tiny critical section
+template <class LockFunc, class UnlockFunc>
+static double RunContention(uint32_t numThreads, LockFunc&& lockFunc, UnlockFunc&& unlockFunc)
+{
+    uint64_t counter = 0;
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (uint32_t j = 0; j < cNumLocksPerThread; ++j)
+            {
+                lockFunc();
+                ++counter;
+                unlockFunc();
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    const double elapsed = std::chrono::duration<double, std::milli>(
+                               std::chrono::high_resolution_clock::now() - start)
+                               .count();
+    EXPECT_EQ(counter, static_cast<uint64_t>(numThreads) * cNumLocksPerThread);
+    return elapsed;
+}
+
+TEST(lock_benchmark, contention)
+{
+    const uint32_t threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    for (uint32_t numThreads : threadCounts)
+    {
+        Mutex mutex;
+        std::mutex stdMutex;
+        SpinLock spinLock;
+
+        const double mutexMs =
+            RunContention(numThreads, [&]() { mutex.Lock(); }, [&]() { mutex.UnLock(); });
+        const double stdMutexMs =
+            RunContention(numThreads, [&]() { stdMutex.lock(); }, [&]() { stdMutex.unlock(); });
+        const double spinLockMs =
+            RunContention(numThreads, [&]() { spinLock.Lock(); }, [&]() { spinLock.Unlock(); });
+
+        LOGI("{:>2} threads: zen::Mutex {:8.2f} ms | std::mutex {:8.2f} ms | SpinLock {:8.2f} ms",
+             numThreads, mutexMs, stdMutexMs, spinLockMs);
+    }
+}
@@ -0,0 +1,91 @@
+#include "Graphics/RHI/DynamicRHI.h"
+#include "Graphics/RHI/RHIOptions.h"
+#include "Graphics/VulkanRHI/VulkanRHI.h"
+#include "Graphics/VulkanRHI/VulkanDevice.h"
+#include "Graphics/VulkanRHI/VulkanPipeline.h"
+#include "Graphics/VulkanRHI/VulkanPipelineCache.h"
+#include "Graphics/VulkanRHI/VulkanTypes.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+
+using namespace zen;
+
+// creates one compute pipeline per shader and destroys it again
+static double CreatePipelinesMs(const std::vector<RHIShader*>& shaders,
+                                VkPipelineCache pipelineCache)
+{
+    VkDevice device = GVulkanRHI->GetVkDevice();
+    auto start      = std::chrono::high_resolution_clock::now();
+    for (RHIShader* pShader : shaders)
+    {
+        VulkanShader* pVkShader = TO_VK_SHADER(pShader);
+        VkComputePipelineCreateInfo pipelineCI{};
+        pipelineCI.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineCI.stage  = pVkShader->GetStageCreateInfoData()[0];
+        pipelineCI.layout = pVkShader->GetVkPipelineLayout();
+        VkPipeline pipeline{VK_NULL_HANDLE};
+        VKCHECK(
+            vkCreateComputePipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
+        vkDestroyPipeline(device, pipeline, nullptr);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+// Needs a Vulkan device, e.g. lavapipe through VK_ICD_FILENAMES. Run with
+// MESA_SHADER_CACHE_DISABLE=true so the driver's own disk cache does not hide the difference.
+TEST(pipeline_cache_benchmark, cold_vs_warm)
+{
+    const auto cachePath = std::filesystem::temp_directory_path() / "ZenEngineBenchmarks" /
+        "pipeline_cache" / "vk_pipeline_cache.bin";
+    std::filesystem::remove(cachePath);
+    // the device cache would serve the runs below
+    RHIOptions::GetInstance().SetVKPipelineCachePath("");
+    DynamicRHI* pRHI = DynamicRHI::Create(RHIAPIType::eVulkan);
+
+    std::vector<RHIShader*> shaders;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(SPV_SHADER_PATH))
+    {
+        if (entry.path().string().ends_with(".comp.spv"))
+        {
+            RHIShaderCreateInfo shaderCI{};
+            shaderCI.spirvFileName[ToUnderlying(RHIShaderStage::eCompute)] =
+                std::filesystem::relative(entry.path(), SPV_SHADER_PATH).generic_string();
+            shaderCI.stageFlags.SetFlag(RHIShaderStageFlagBits::eCompute);
+            shaderCI.name = entry.path().stem().string();
+            shaders.push_back(pRHI->CreateShader(shaderCI));
+        }
+    }
+    ASSERT_FALSE(shaders.empty());
+
+    VulkanDevice* pDevice  = GVulkanRHI->GetDevice();
+    const double noCacheMs = CreatePipelinesMs(shaders, VK_NULL_HANDLE);
+
+    VulkanPipelineCache coldCache;
+    coldCache.Init(pDevice, cachePath.string());
+    EXPECT_FALSE(coldCache.IsLoadedFromDisk());
+    const double coldMs = CreatePipelinesMs(shaders, coldCache.GetVkHandle());
+    EXPECT_TRUE(coldCache.Save());
+    coldCache.Destroy();
+
+    // second run: every pipeline is found, so the cache has nothing new to write
+    VulkanPipelineCache warmCache;
+    warmCache.Init(pDevice, cachePath.string());
+    EXPECT_TRUE(warmCache.IsLoadedFromDisk());
+    const double warmMs = CreatePipelinesMs(shaders, warmCache.GetVkHandle());
+    EXPECT_FALSE(warmCache.Save());
+    warmCache.Destroy();
+
+    LOGI("{} compute pipelines: no cache {:.2f} ms | cold cache {:.2f} ms | warm cache {:.2f} ms "
+         "({:.2f}x)",
+         shaders.size(), noCacheMs, coldMs, warmMs, noCacheMs / warmMs);
+
+    for (RHIShader* pShader : shaders)
+    {
+        pRHI->DestroyShader(pShader);
+    }
+    pRHI->Destroy();
+}
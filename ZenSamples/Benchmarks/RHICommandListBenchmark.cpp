@@ -0,0 +1,309 @@
+#include "Graphics/NullRHI/NullRHI.h"
+#include "Graphics/RHI/RHICommandList.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace zen;
+
+static constexpr uint32_t cNumFrames = 20;
+
+static double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+// only counts the calls, so the replay cost is the command list walk itself
+class CountingCommandContext : public IRHICommandContext
+{
+public:
+    RHICommandContextType GetContextType() override
+    {
+        return RHICommandContextType::eGraphics;
+    }
+
+    void RHIBeginRendering(const RHIRenderingLayout* pRenderingLayout) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIEndRendering() override
+    {
+        m_numCalls++;
+    }
+
+    void RHISetScissor(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) override
+    {
+        m_numCalls++;
+    }
+
+    void RHISetViewport(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) override
+    {
+        m_numCalls++;
+    }
+
+    void RHISetDepthBias(float depthBiasConstantFactor,
+                         float depthBiasClamp,
+                         float depthBiasSlopeFactor) override
+    {
+        m_numCalls++;
+    }
+
+    void RHISetLineWidth(float lineWidth) override
+    {
+        m_numCalls++;
+    }
+
+    void RHISetBlendConstants(const Color& blendConstants) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIBindPipeline(RHIPipeline* pPipeline,
+                         uint32_t numDescriptorSets,
+                         RHIDescriptorSet* const* pDescriptorSets) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIBindVertexBuffers(VectorView<RHIBuffer*> pBuffers,
+                              VectorView<uint64_t> offsets) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIBindVertexBuffer(RHIBuffer* pBuffer, uint64_t offset) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIDraw(uint32_t vertexCount,
+                 uint32_t instanceCount,
+                 uint32_t firstVertex,
+                 uint32_t firstInstance) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIDrawIndexed(RHIBuffer* pIndexBuffer,
+                        DataFormat indexFormat,
+                        uint32_t indexBufferOffset,
+                        uint32_t indexCount,
+                        uint32_t instanceCount,
+                        uint32_t firstIndex,
+                        int32_t vertexOffset,
+                        uint32_t firstInstance) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIDrawIndexedIndirect(RHIBuffer* pIndirectBuffer,
+                                RHIBuffer* pIndexBuffer,
+                                DataFormat indexFormat,
+                                uint32_t indexBufferOffset,
+                                uint32_t offset,
+                                uint32_t drawCount,
+                                uint32_t stride) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIDrawIndexedIndirectCount(RHIBuffer* pIndirectBuffer,
+                                     RHIBuffer* pIndexBuffer,
+                                     DataFormat indexFormat,
+                                     uint32_t indexBufferOffset,
+                                     uint32_t offset,
+                                     RHIBuffer* pCountBuffer,
+                                     uint32_t countBufferOffset,
+                                     uint32_t maxDrawCount,
+                                     uint32_t stride) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIDispatchIndirect(RHIBuffer* pIndirectBuffer, uint32_t offset) override
+    {
+        m_numCalls++;
+    }
+
+    void RHISetPushConstants(RHIPipeline* pPipeline, VectorView<uint8_t> data) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIAddTransitions(BitField<RHIPipelineStageBits> srcStages,
+                           BitField<RHIPipelineStageBits> dstStages,
+                           VectorView<RHIMemoryTransition> memoryTransitions,
+                           VectorView<RHIBufferTransition> bufferTransitions,
+                           VectorView<RHITextureTransition> textureTransitions) override
+    {
+        m_numCalls++;
+    }
+
+    void RHISetBarrierEvent(RHIBarrierEvent* pEvent,
+                            BitField<RHIPipelineStageBits> srcStages,
+                            BitField<RHIPipelineStageBits> dstStages,
+                            VectorView<RHIBufferTransition> bufferTransitions,
+                            VectorView<RHITextureTransition> textureTransitions) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIWaitBarrierEvent(RHIBarrierEvent* pEvent) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIGenTextureMipmaps(RHITexture* pTexture) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIAddTextureTransition(RHITexture* pTexture, RHITextureLayout newLayout) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIClearBuffer(RHIBuffer* pBuffer, uint32_t offset, uint32_t size) override
+    {
+        m_numCalls++;
+    }
+
+    void RHICopyBuffer(RHIBuffer* pSrcBuffer,
+                       RHIBuffer* pDstBuffer,
+                       const RHIBufferCopyRegion& region) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIClearTexture(RHITexture* pTex,
+                         const Color& color,
+                         const RHITextureSubResourceRange& range) override
+    {
+        m_numCalls++;
+    }
+
+    void RHICopyTexture(RHITexture* pSrcTexture,
+                        RHITexture* pDstTexture,
+                        VectorView<RHITextureCopyRegion> regions) override
+    {
+        m_numCalls++;
+    }
+
+    void RHICopyTextureToBuffer(RHITexture* pSrcTex,
+                                RHIBuffer* pDstBuffer,
+                                VectorView<RHIBufferTextureCopyRegion> regions) override
+    {
+        m_numCalls++;
+    }
+
+    void RHICopyBufferToTexture(RHIBuffer* pSrcBuffer,
+                                RHITexture* pDstTexture,
+                                VectorView<RHIBufferTextureCopyRegion> regions) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIResolveTexture(RHITexture* pSrcTexture,
+                           RHITexture* pDstTexture,
+                           uint32_t srcLayer,
+                           uint32_t srcMipmap,
+                           uint32_t dstLayer,
+                           uint32_t dstMipmap) override
+    {
+        m_numCalls++;
+    }
+
+    void RHIWaitUntilCompleted() override {}
+
+    uint64_t GetNumCalls() const
+    {
+        return m_numCalls;
+    }
+
+private:
+    uint64_t m_numCalls{0};
+};
+
+// numMaterials pipelines, each dispatch rebinds its pipeline and pushes its material constants
+// the way a pass recording its items without state sorting does
+static void RunReplayBenchmark(uint32_t numDispatches, uint32_t numMaterials)
+{
+    NullRHI rhi;
+    rhi.Init();
+
+    RHIShaderCreateInfo shaderInfo{};
+    shaderInfo.name    = "simulate";
+    RHIShader* pShader = rhi.CreateShader(shaderInfo);
+
+    HeapVector<RHIPipeline*> pipelines;
+    HeapVector<uint8_t> constants;
+    for (uint32_t i = 0; i < numMaterials; i++)
+    {
+        RHIComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.pShader = pShader;
+        pipelines.push_back(rhi.CreatePipeline(pipelineInfo));
+        for (uint32_t j = 0; j < 16; j++)
+        {
+            constants.push_back(static_cast<uint8_t>(i + j));
+        }
+    }
+
+    // the list owns its context
+    CountingCommandContext* pContext = ZEN_NEW() CountingCommandContext();
+    RHICommandList* pCmdList         = RHICommandList::Create(pContext);
+
+    double recordMs = 0.0;
+    double replayMs = 0.0;
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < numDispatches; i++)
+        {
+            // consecutive dispatches share a material, 16 at a time
+            const uint32_t material = (i / 16) % numMaterials;
+            pCmdList->BindPipeline(RHIPipelineType::eCompute, pipelines[material], 0, nullptr);
+            pCmdList->SetPushConstants(pipelines[material],
+                                       MakeVecView(&constants[material * 16], 16));
+            pCmdList->Dispatch(64, 1, 1);
+        }
+        recordMs += ElapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        pCmdList->Execute();
+        replayMs += ElapsedMs(start);
+
+        if (frame + 1 < cNumFrames)
+        {
+            pCmdList->Reset();
+        }
+    }
+
+    LOGI("rhi command list {} dispatches, {} materials: record {:.3f} ms, replay {:.3f} ms, "
+         "{} of {} commands skipped, {} context calls",
+         numDispatches, numMaterials, recordMs / cNumFrames, replayMs / cNumFrames,
+         pCmdList->GetNumSkippedCommands(),
+         pCmdList->GetNumCommands() + pCmdList->GetNumSkippedCommands(),
+         pContext->GetNumCalls() / cNumFrames);
+
+    ZEN_DELETE(pCmdList);
+    for (RHIPipeline* pPipeline : pipelines)
+    {
+        rhi.DestroyPipeline(pPipeline);
+    }
+    rhi.DestroyShader(pShader);
+    rhi.Destroy();
+}
+
+TEST(rhi_command_list_benchmark, replay)
+{
+    RunReplayBenchmark(10000, 8);
+    RunReplayBenchmark(50000, 64);
+}
@@ -0,0 +1,156 @@
+#include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "Graphics/RHI/RHICommandList.h"
+#include "Graphics/RHI/RHIResource.h"
+#include "Utils/JobSystem.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <deque>
+
+using namespace zen;
+using namespace zen::rc;
+
+static constexpr uint32_t cNumFrames = 20;
+
+static double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+class BenchmarkBuffer : public RHIBuffer
+{
+public:
+    explicit BenchmarkBuffer(const std::string& tag) : RHIBuffer(MakeCreateInfo(tag)) {}
+
+    ~BenchmarkBuffer()
+    {
+        ReleaseReference();
+    }
+
+    uint8_t* Map() override
+    {
+        return nullptr;
+    }
+
+    void Unmap() override {}
+
+    void SetTexelFormat(DataFormat format) override {}
+
+protected:
+    void Init() override {}
+
+    void Destroy() override {}
+
+private:
+    static RHIBufferCreateInfo MakeCreateInfo(const std::string& tag)
+    {
+        RHIBufferCreateInfo createInfo{};
+        createInfo.size = 4096;
+        createInfo.tag  = tag;
+        return createInfo;
+    }
+};
+
+// chains of upload, simulation and copy work, each simulation issues numDispatches dispatches
+static void RunRecordBenchmark(uint32_t numChains, uint32_t numDispatches, JobSystem& jobSystem)
+{
+    std::deque<BenchmarkBuffer> staging;
+    std::deque<BenchmarkBuffer> particles;
+    std::deque<BenchmarkBuffer> results;
+    std::deque<ComputePass> passes;
+    for (uint32_t i = 0; i < numChains; i++)
+    {
+        const std::string suffix = std::to_string(i);
+        staging.emplace_back("staging" + suffix);
+        particles.emplace_back("particles" + suffix);
+        results.emplace_back("results" + suffix);
+        passes.emplace_back();
+
+        ComputePass& pass      = passes.back();
+        pass.pPipeline         = nullptr;
+        pass.numDescriptorSets = 1;
+        pass.pShaderProgram    = nullptr;
+        for (RHIDescriptorSet*& pSet : pass.pDescriptorSets)
+        {
+            pSet = nullptr;
+        }
+        PassResourceTracker& tracker = pass.resourceTrackers[0][0];
+        tracker.name                 = "particles";
+        tracker.pBuffer              = &particles.back();
+        tracker.resourceType         = PassResourceType::eBuffer;
+        tracker.accessMode           = RHIAccessMode::eReadWrite;
+        tracker.bufferUsage          = RHIBufferUsage::eStorageBuffer;
+    }
+
+    RenderGraph rdg("rdg_record_benchmark");
+    rdg.Begin();
+    RHIBufferCopyRegion region{};
+    region.size = 4096;
+    for (uint32_t i = 0; i < numChains; i++)
+    {
+        rdg.AddBufferClearNode(&staging[i], 0, 4096);
+        rdg.AddBufferCopyNode(&staging[i], &particles[i], region);
+        RDGPassNode* pPass = rdg.AddComputePassNode(&passes[i], "simulate" + std::to_string(i));
+        for (uint32_t dispatch = 0; dispatch < numDispatches; dispatch++)
+        {
+            rdg.AddComputePassDispatchNode(pPass, 64, 1, 1);
+        }
+        rdg.AddBufferCopyNode(&particles[i], &results[i], region);
+    }
+    rdg.End();
+
+    // the lists are only encoded, never replayed, so no command context is needed
+    HeapVector<RHICommandList*> cmdLists;
+    for (uint32_t i = 0; i < jobSystem.GetNumWorkers(); i++)
+    {
+        cmdLists.push_back(ZEN_NEW() RHICommandList());
+    }
+    auto record = [&](uint32_t numSegments, JobSystem* pJobSystem) {
+        rdg.Execute(MakeVecView(cmdLists.data(), numSegments), pJobSystem);
+        for (uint32_t i = 0; i < numSegments; i++)
+        {
+            cmdLists[i]->Reset();
+        }
+    };
+    // first run settles the tracked resource state and sizes the command allocators
+    record(jobSystem.GetNumWorkers(), &jobSystem);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        record(1, nullptr);
+    }
+    const double serialMs = ElapsedMs(start) / cNumFrames;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        record(jobSystem.GetNumWorkers(), &jobSystem);
+    }
+    const double parallelMs = ElapsedMs(start) / cNumFrames;
+
+    LOGI("Recording {} nodes ({} passes x {} dispatches): 1 list {:.3f} ms | {} lists {:.3f} ms "
+         "({:.2f}x)",
+         rdg.GetCompiledNodes().size(), numChains, numDispatches, serialMs,
+         jobSystem.GetNumWorkers(), parallelMs, serialMs / parallelMs);
+
+    for (RHICommandList* pCmdList : cmdLists)
+    {
+        ZEN_DELETE(pCmdList);
+    }
+}
+
+TEST(render_graph_record_benchmark, single_vs_segmented_lists)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    JobSystem jobSystem;
+    for (uint32_t numDispatches : {4u, 64u, 512u})
+    {
+        RunRecordBenchmark(256, numDispatches, jobSystem);
+    }
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
@@ -0,0 +1,103 @@
+#include "SceneGraph/SceneBVH.h"
+#include "Graphics/Types/Frustum.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+
+using namespace zen;
+
+static constexpr uint32_t cNumBoxes = 250000;
+static constexpr uint32_t cNumViews = 64;
+
+static double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+// what the renderers did before: every box against every plane
+static bool IsOutside(const sg::AABB& box, const Frustum& frustum)
+{
+    for (const Vec4& plane : frustum.GetPlanes())
+    {
+        const Vec3 corner(plane.x > 0.0f ? box.GetMax().x : box.GetMin().x,
+                          plane.y > 0.0f ? box.GetMax().y : box.GetMin().y,
+                          plane.z > 0.0f ? box.GetMax().z : box.GetMin().z);
+        if (glm::dot(Vec3(plane), corner) + plane.w < 0.0f)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(scene_bvh_benchmark, frustum_cull_250k_boxes)
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.2f, 3.0f);
+    std::vector<sg::AABB> boxes;
+    boxes.reserve(cNumBoxes);
+    for (uint32_t i = 0; i < cNumBoxes; i++)
+    {
+        const Vec3 center(position(rng), position(rng) * 0.1f, position(rng));
+        const Vec3 extent(size(rng));
+        boxes.emplace_back(center - extent, center + extent);
+    }
+
+    // camera circling the scene center
+    const Mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+    std::vector<Frustum> frustums(cNumViews);
+    for (uint32_t i = 0; i < cNumViews; i++)
+    {
+        const float angle = glm::radians(360.0f * static_cast<float>(i) / cNumViews);
+        const Vec3 eye(std::cos(angle) * 200.0f, 20.0f, std::sin(angle) * 200.0f);
+        frustums[i].ExtractPlanes(proj * glm::lookAt(eye, Vec3(0.0f), Vec3(0.0f, 1.0f, 0.0f)));
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    sg::SceneBVH bvh;
+    bvh.Build(boxes);
+    const double buildMs = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    bvh.Refit(boxes);
+    const double refitMs = ElapsedMs(start);
+
+    std::vector<uint32_t> visible;
+    uint64_t numBruteForce = 0;
+    start                  = std::chrono::high_resolution_clock::now();
+    for (const Frustum& frustum : frustums)
+    {
+        visible.clear();
+        for (uint32_t i = 0; i < cNumBoxes; i++)
+        {
+            if (!IsOutside(boxes[i], frustum))
+            {
+                visible.push_back(i);
+            }
+        }
+        numBruteForce += visible.size();
+    }
+    const double bruteForceMs = ElapsedMs(start) / cNumViews;
+
+    uint64_t numBVH = 0;
+    start           = std::chrono::high_resolution_clock::now();
+    for (const Frustum& frustum : frustums)
+    {
+        visible.clear();
+        bvh.Cull(frustum, visible);
+        numBVH += visible.size();
+    }
+    const double bvhMs = ElapsedMs(start) / cNumViews;
+    // boxes touching a plane may go either way
+    EXPECT_NEAR(static_cast<double>(numBVH), static_cast<double>(numBruteForce),
+                numBruteForce * 1e-4);
+
+    LOGI("Frustum culling, {} boxes ({} nodes, build {:.2f} ms, refit {:.2f} ms), {:.0f} visible "
+         "per view: brute force {:.3f} ms | BVH {:.3f} ms ({:.2f}x)",
+         cNumBoxes, bvh.GetNumNodes(), buildMs, refitMs,
+         static_cast<double>(numBVH) / cNumViews, bruteForceMs, bvhMs, bruteForceMs / bvhMs);
+}
@@ -0,0 +1,58 @@
+#include "AssetLib/FastGLTFLoader.h"
+#include "SceneGraph/Scene.h"
+#include "Utils/Errors.h"
+#include "../CommonTest/SyntheticGltf.h"
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace zen;
+
+static double LoadSceneMs(const std::filesystem::path& gltfPath,
+                          const std::filesystem::path& cacheDir,
+                          bool* pLoadedFromCache = nullptr)
+{
+    sg::Scene scene;
+    asset::FastGLTFLoader loader;
+    loader.SetOptimizeMeshes(true);
+    loader.SetBuildMeshlets(true);
+    loader.SetSceneCacheDir(cacheDir.string());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    loader.LoadFromFile(gltfPath.string(), &scene);
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::high_resolution_clock::now() - start)
+                          .count();
+    if (pLoadedFromCache != nullptr)
+    {
+        *pLoadedFromCache = loader.IsLoadedFromSceneCache();
+    }
+    return ms;
+}
+
+TEST(scene_cache_benchmark, cold_vs_warm)
+{
+    // ~1.3M triangles and 16 1k textures
+    SyntheticGltfDesc desc;
+    desc.numMeshes            = 8;
+    desc.numPrimitivesPerMesh = 4;
+    desc.gridSize             = 150;
+    desc.numTextures          = 16;
+    desc.textureSize          = 1024;
+    const auto benchmarkDir =
+        std::filesystem::temp_directory_path() / "ZenEngineBenchmarks" / "scene_cache";
+    std::filesystem::remove_all(benchmarkDir);
+    const auto gltfPath = WriteSyntheticGltf(benchmarkDir, desc);
+    const auto cacheDir = benchmarkDir / "cache";
+
+    // cold: parse, decode, optimize, build meshlets and mips, then write the cooked file
+    bool loadedFromCache = true;
+    const double coldMs  = LoadSceneMs(gltfPath, cacheDir, &loadedFromCache);
+    EXPECT_FALSE(loadedFromCache);
+    const double warmMs = LoadSceneMs(gltfPath, cacheDir, &loadedFromCache);
+    EXPECT_TRUE(loadedFromCache);
+
+    const auto cachePath = asset::SceneCache::GetCachePath(cacheDir.string(), gltfPath.string());
+    LOGI("Scene load ({:.1f} MB cooked): cold {:.2f} ms | warm {:.2f} ms ({:.2f}x)",
+         std::filesystem::file_size(cachePath) / (1024.0 * 1024.0), coldMs, warmMs,
+         coldMs / warmMs);
+}
@@ -0,0 +1,130 @@
+#include "SceneGraph/Scene.h"
+#include "Utils/JobSystem.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+
+using namespace zen;
+
+static constexpr uint32_t cNumNodes  = 100000;
+static constexpr uint32_t cNumFrames = 20;
+
+static double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+// depth first random tree, each node hangs below one of the last few nodes of the open branch
+static std::vector<uint32_t> GenerateParents(uint32_t numNodes)
+{
+    std::mt19937 rng(1);
+    std::vector<uint32_t> parents(numNodes);
+    std::vector<uint32_t> branch;
+    for (uint32_t i = 0; i < numNodes; i++)
+    {
+        if (branch.empty())
+        {
+            parents[i] = sg::TransformHierarchy::cInvalidIndex;
+        }
+        else
+        {
+            const uint32_t pop = std::min<uint32_t>(rng() % 3, branch.size() - 1);
+            branch.resize(branch.size() - pop);
+            parents[i] = branch.back();
+        }
+        branch.push_back(i);
+    }
+    return parents;
+}
+
+static Vec3 AnimatedTranslation(uint32_t node, uint32_t frame)
+{
+    return Vec3(static_cast<float>(node % 7), static_cast<float>(frame) * 0.1f, 1.0f);
+}
+
+TEST(transform_hierarchy_benchmark, update_100k_nodes)
+{
+    const auto parents = GenerateParents(cNumNodes);
+    const Quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+    const Vec3 scale(1.0f);
+
+    // legacy: Transform components walk their parents, Node::SetData inverts per node
+    std::vector<UniquePtr<sg::Node>> nodes;
+    std::vector<UniquePtr<sg::Transform>> transforms;
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        nodes.emplace_back(MakeUnique<sg::Node>(i, ""));
+        if (parents[i] != sg::TransformHierarchy::cInvalidIndex)
+        {
+            nodes[i]->SetParent(nodes[parents[i]].Get());
+            nodes[parents[i]]->AddChild(nodes[i].Get());
+        }
+        transforms.emplace_back(MakeUnique<sg::Transform>(*nodes[i]));
+        nodes[i]->AddComponent(transforms[i].Get());
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        for (uint32_t i = 0; i < cNumNodes; i++)
+        {
+            transforms[i]->SetTranslation(AnimatedTranslation(i, frame));
+        }
+        for (uint32_t i = 0; i < cNumNodes; i++)
+        {
+            nodes[i]->SetData(i, transforms[i]->GetWorldMatrix());
+        }
+    }
+    const double legacyMs = ElapsedMs(start) / cNumFrames;
+
+    sg::TransformHierarchy hierarchy;
+    hierarchy.Reserve(cNumNodes);
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        hierarchy.AddNode(parents[i]);
+    }
+    start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        for (uint32_t i = 0; i < cNumNodes; i++)
+        {
+            hierarchy.SetLocalTransform(i, AnimatedTranslation(i, frame), rotation, scale);
+        }
+        hierarchy.Update();
+    }
+    const double serialMs = ElapsedMs(start) / cNumFrames;
+
+    JobSystem jobSystem;
+    start = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        for (uint32_t i = 0; i < cNumNodes; i++)
+        {
+            hierarchy.SetLocalTransform(i, AnimatedTranslation(i, frame), rotation, scale);
+        }
+        hierarchy.Update(&jobSystem);
+    }
+    const double parallelMs = ElapsedMs(start) / cNumFrames;
+
+    for (uint32_t i = 0; i < cNumNodes; i += 997)
+    {
+        EXPECT_EQ(hierarchy.GetWorldMatrix(i), nodes[i]->GetData().modelMatrix);
+    }
+
+    // one small subtree moves, only its range is visited
+    const uint32_t moved = cNumNodes / 2;
+    start                = std::chrono::high_resolution_clock::now();
+    for (uint32_t frame = 0; frame < cNumFrames; frame++)
+    {
+        hierarchy.SetLocalTransform(moved, AnimatedTranslation(moved, frame), rotation, scale);
+        hierarchy.Update(&jobSystem);
+    }
+    const double subtreeMs = ElapsedMs(start) / cNumFrames;
+
+    LOGI("Transform update, {} nodes: legacy {:.2f} ms | hierarchy {:.2f} ms ({:.2f}x) | "
+         "{} workers {:.2f} ms ({:.2f}x) | subtree of {} nodes {:.4f} ms",
+         cNumNodes, legacyMs, serialMs, legacyMs / serialMs, jobSystem.GetNumWorkers(),
+         parallelMs, legacyMs / parallelMs, hierarchy.GetSubtreeEnd(moved) - moved, subtreeMs);
+}
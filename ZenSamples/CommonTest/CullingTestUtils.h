@@ -0,0 +1,23 @@
+#pragma once
+#include "Graphics/Types/Frustum.h"
+#include "SceneGraph/SceneBVH.h"
+#include <algorithm>
+#include <vector>
+
+// frustum helpers shared by the scene BVH and the indirect draw culling tests
+
+// the clip volume of a uniform scale is the cube [-halfSize, halfSize]^3
+inline zen::Frustum MakeCubeFrustum(float halfSize)
+{
+    zen::Frustum frustum;
+    frustum.ExtractPlanes(glm::scale(zen::Mat4(1.0f), zen::Vec3(1.0f / halfSize)));
+    return frustum;
+}
+
+inline std::vector<uint32_t> CullSorted(const zen::sg::SceneBVH& bvh, const zen::Frustum& frustum)
+{
+    std::vector<uint32_t> visible;
+    bvh.Cull(frustum, visible);
+    std::sort(visible.begin(), visible.end());
+    return visible;
+}
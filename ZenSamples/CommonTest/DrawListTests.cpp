@@ -0,0 +1,190 @@
+#include "SceneGraph/DrawList.h"
+#include "SceneGraph/Node.h"
+#include "SceneGraph/Scene.h"
+#include "Utils/UniquePtr.h"
+#include "Utils/RadixSort.h"
+#include "Utils/JobSystem.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+using namespace zen;
+
+// sorts with RadixSort and checks the result against std::stable_sort, values are the input
+// positions so stability is checked as well
+static void ExpectSortedLikeStableSort(std::vector<uint64_t> keys, JobSystem* pJobSystem)
+{
+    const uint32_t count = static_cast<uint32_t>(keys.size());
+    std::vector<uint32_t> values(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        values[i] = i;
+    }
+    std::vector<uint32_t> expected = values;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&keys](uint32_t lhs, uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+
+    std::vector<uint64_t> sortedKeys = keys;
+    std::vector<uint64_t> scratchKeys(count);
+    std::vector<uint32_t> scratchValues(count);
+    RadixSort::Sort(sortedKeys.data(), values.data(), scratchKeys.data(), scratchValues.data(),
+                    count, pJobSystem);
+    ASSERT_EQ(values, expected);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ASSERT_EQ(sortedKeys[i], keys[expected[i]]);
+    }
+}
+
+TEST(draw_list_tests, radix_sort_matches_stable_sort)
+{
+    std::mt19937_64 rng(42);
+    JobSystem jobSystem(4);
+    for (uint32_t count : {0u, 1u, 2u, 100u, 5000u, RadixSort::cMinParallelCount * 3 + 17})
+    {
+        // full range keys
+        std::vector<uint64_t> keys(count);
+        for (auto& key : keys)
+        {
+            key = rng();
+        }
+        ExpectSortedLikeStableSort(keys, nullptr);
+        ExpectSortedLikeStableSort(keys, &jobSystem);
+
+        // many duplicates, only a few bytes in use so most passes are skipped
+        for (auto& key : keys)
+        {
+            key = (rng() % 16) << 40 | (rng() % 8);
+        }
+        ExpectSortedLikeStableSort(keys, nullptr);
+        ExpectSortedLikeStableSort(keys, &jobSystem);
+    }
+
+    // all keys equal: nothing moves
+    ExpectSortedLikeStableSort(std::vector<uint64_t>(1000, 0x1234u), nullptr);
+}
+
+TEST(draw_list_tests, draw_key_order)
+{
+    // every field dominates all fields after it
+    EXPECT_LT(sg::DrawKey::Make(0, 4095, 65535, 1e30f), sg::DrawKey::Make(1, 0, 0, 0.0f));
+    EXPECT_LT(sg::DrawKey::Make(2, 0, 65535, 1e30f), sg::DrawKey::Make(2, 1, 0, 0.0f));
+    EXPECT_LT(sg::DrawKey::Make(2, 3, 7, 1e30f), sg::DrawKey::Make(2, 3, 8, 0.0f));
+    EXPECT_LT(sg::DrawKey::Make(2, 3, 7, 1.5f), sg::DrawKey::Make(2, 3, 7, 2.0f));
+    // back to front reverses the depth and drops pipeline and material
+    EXPECT_GT(sg::DrawKey::Make(2, 3, 7, 1.5f, true), sg::DrawKey::Make(2, 3, 7, 2.0f, true));
+    EXPECT_LT(sg::DrawKey::Make(1, 3, 7, 1.5f, true), sg::DrawKey::Make(2, 3, 7, 2.0f, true));
+    EXPECT_GT(sg::DrawKey::Make(2, 0, 0, 1.5f, true),
+              sg::DrawKey::Make(2, 4095, 65535, 2.0f, true));
+    EXPECT_EQ(sg::DrawKey::GetPipeline(sg::DrawKey::Make(2, 3, 7, 1.5f, true)), 0u);
+    EXPECT_EQ(sg::DrawKey::GetMaterial(sg::DrawKey::Make(2, 3, 7, 1.5f, true)), 0u);
+
+    const uint64_t key = sg::DrawKey::Make(9, 300, 4000, 3.0f);
+    EXPECT_EQ(sg::DrawKey::GetPass(key), 9u);
+    EXPECT_EQ(sg::DrawKey::GetPipeline(key), 300u);
+    EXPECT_EQ(sg::DrawKey::GetMaterial(key), 4000u);
+
+    // depth bits keep the float order, negative and NaN clamp to 0
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> depth(0.0f, 1000.0f);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        const float a = depth(rng);
+        const float b = depth(rng);
+        EXPECT_EQ(a < b, sg::DrawKey::EncodeDepth(a) < sg::DrawKey::EncodeDepth(b));
+    }
+    EXPECT_EQ(sg::DrawKey::EncodeDepth(-1.0f), 0u);
+    EXPECT_EQ(sg::DrawKey::EncodeDepth(std::numeric_limits<float>::quiet_NaN()), 0u);
+}
+
+TEST(draw_list_tests, sort_is_stable)
+{
+    std::vector<UniquePtr<sg::Node>> nodes;
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        nodes.emplace_back(MakeUnique<sg::Node>(i, "node" + std::to_string(i)));
+    }
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> depth(0.0f, 10.0f);
+    sg::DrawList drawList;
+    for (uint32_t frame = 0; frame < 2; frame++)
+    {
+        drawList.Clear();
+        std::vector<std::pair<uint64_t, sg::Node*>> expected;
+        for (uint32_t i = 0; i < nodes.size(); i++)
+        {
+            // few distinct keys, rounded depth creates ties
+            const uint64_t key =
+                sg::DrawKey::Make(rng() % 2, 0, rng() % 3, std::floor(depth(rng)));
+            drawList.Add(key, nodes[i].Get(), nullptr);
+            expected.emplace_back(key, nodes[i].Get());
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        drawList.Sort();
+
+        ASSERT_EQ(drawList.GetSize(), expected.size());
+        for (uint32_t i = 0; i < drawList.GetSize(); i++)
+        {
+            EXPECT_EQ(drawList.GetKeys()[i], expected[i].first);
+            EXPECT_EQ(drawList[i].pNode, expected[i].second);
+        }
+    }
+}
+
+TEST(draw_list_tests, blended_draws_sort_back_to_front_across_materials)
+{
+    // two blended materials with different pipelines, their draws alternate along the view axis
+    std::vector<UniquePtr<sg::Material>> materials;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        materials.emplace_back(MakeUnique<sg::Material>("material" + std::to_string(i)));
+        materials[i]->index       = i;
+        materials[i]->alphaMode   = i < 2 ? sg::AlphaMode::Blend : sg::AlphaMode::Opaque;
+        materials[i]->doubleSided = i == 1;
+    }
+
+    sg::Scene scene;
+    std::vector<UniquePtr<sg::Node>> nodes;
+    std::vector<UniquePtr<sg::Transform>> transforms;
+    std::vector<UniquePtr<sg::Mesh>> meshes;
+    std::vector<UniquePtr<sg::SubMesh>> subMeshes;
+    const uint32_t cNumNodes = 9;
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        nodes.emplace_back(MakeUnique<sg::Node>(i, "node" + std::to_string(i)));
+        transforms.emplace_back(MakeUnique<sg::Transform>(*nodes[i]));
+        transforms[i]->SetTranslation(Vec3(0.0f, 0.0f, -1.0f - static_cast<float>(i)));
+        nodes[i]->AddComponent(transforms[i].Get());
+
+        meshes.emplace_back(MakeUnique<sg::Mesh>("mesh" + std::to_string(i)));
+        subMeshes.emplace_back(MakeUnique<sg::SubMesh>("submesh", 0, 3, 3));
+        // the last node is opaque, the others alternate between the blended materials
+        const uint32_t materialIndex = i == cNumNodes - 1 ? 2 : i % 2;
+        subMeshes[i]->SetMaterial(materialIndex, materials[materialIndex].Get());
+        meshes[i]->AddSubMesh(subMeshes[i].Get());
+        meshes[i]->AddNode(nodes[i].Get());
+        nodes[i]->AddComponent(meshes[i].Get());
+    }
+    std::vector<sg::Node*> nodePointers;
+    for (auto& node : nodes)
+    {
+        nodePointers.push_back(node.Get());
+    }
+    scene.SetNodes(std::move(nodes));
+    scene.SetComponents(std::move(materials));
+    scene.SetComponents(std::move(transforms));
+    scene.SetComponents(std::move(meshes));
+    scene.SetComponents(std::move(subMeshes));
+
+    sg::DrawList drawList;
+    scene.BuildDrawList(Vec3(0.0f), Mat4(1.0f), drawList);
+    ASSERT_EQ(drawList.GetSize(), cNumNodes);
+    // opaque pass first, then every blended draw from the farthest to the nearest
+    EXPECT_EQ(drawList[0].pNode, nodePointers[cNumNodes - 1]);
+    for (uint32_t i = 1; i < cNumNodes; i++)
+    {
+        EXPECT_EQ(drawList[i].pNode, nodePointers[cNumNodes - 1 - i]);
+    }
+}
@@ -0,0 +1,89 @@
+#include "AssetLib/FastGLTFLoader.h"
+#include "SceneGraph/Scene.h"
+#include "SyntheticGltf.h"
+#include "TestUtils.h"
+#include <gtest/gtest.h>
+
+using namespace zen;
+
+TEST(gltf_mesh_loading_test, parallel_matches_serial)
+{
+    SyntheticGltfDesc desc;
+    desc.numMeshes            = 6;
+    desc.numPrimitivesPerMesh = 3;
+    // large enough for primitives to be split into several vertex and index jobs
+    desc.gridSize = 200;
+    // the last primitive of each mesh is drawn without indices
+    desc.nonIndexedPrimitives = true;
+    const auto gltfPath = WriteSyntheticGltf(GetTestDir("parallel_matches_serial"), desc);
+
+    sg::Scene serialScene;
+    asset::FastGLTFLoader serialLoader;
+    serialLoader.SetParallelLoading(false);
+    serialLoader.LoadFromFile(gltfPath.string(), &serialScene);
+
+    sg::Scene parallelScene;
+    asset::FastGLTFLoader parallelLoader;
+    parallelLoader.LoadFromFile(gltfPath.string(), &parallelScene);
+
+    const auto& serialVertices   = serialLoader.GetVertices();
+    const auto& parallelVertices = parallelLoader.GetVertices();
+    const auto& serialIndices    = serialLoader.GetIndices();
+    const auto& parallelIndices  = parallelLoader.GetIndices();
+
+    const size_t numVertices = desc.numMeshes * desc.numPrimitivesPerMesh * desc.gridSize *
+        desc.gridSize;
+    ASSERT_EQ(serialVertices.size(), numVertices);
+    ASSERT_EQ(parallelVertices.size(), numVertices);
+    const size_t numIndices = desc.numMeshes * (desc.numPrimitivesPerMesh - 1) *
+        (desc.gridSize - 1) * (desc.gridSize - 1) * 6;
+    ASSERT_EQ(serialIndices.size(), numIndices);
+    ASSERT_EQ(parallelIndices.size(), numIndices);
+    EXPECT_EQ(std::memcmp(serialVertices.data(), parallelVertices.data(),
+                          numVertices * sizeof(asset::Vertex)),
+              0);
+    EXPECT_EQ(serialIndices, parallelIndices);
+
+    const auto& serialSubMeshes   = serialScene.GetComponents<sg::SubMesh>();
+    const auto& parallelSubMeshes = parallelScene.GetComponents<sg::SubMesh>();
+    ASSERT_EQ(serialSubMeshes.size(), parallelSubMeshes.size());
+    uint32_t expectedFirstIndex = 0;
+    for (size_t i = 0; i < serialSubMeshes.size(); ++i)
+    {
+        EXPECT_EQ(serialSubMeshes[i]->GetFirstIndex(), expectedFirstIndex);
+        EXPECT_EQ(parallelSubMeshes[i]->GetFirstIndex(), serialSubMeshes[i]->GetFirstIndex());
+        EXPECT_EQ(parallelSubMeshes[i]->GetIndexCount(), serialSubMeshes[i]->GetIndexCount());
+        EXPECT_EQ(parallelSubMeshes[i]->GetVertexCount(), serialSubMeshes[i]->GetVertexCount());
+        const bool indexed = (i + 1) % desc.numPrimitivesPerMesh != 0;
+        EXPECT_EQ(serialSubMeshes[i]->GetIndexCount() > 0, indexed);
+        expectedFirstIndex += serialSubMeshes[i]->GetIndexCount();
+    }
+}
+
+TEST(gltf_mesh_loading_test, index_rebase)
+{
+    SyntheticGltfDesc desc;
+    desc.numMeshes            = 2;
+    desc.numPrimitivesPerMesh = 2;
+    desc.gridSize             = 8;
+    const auto gltfPath = WriteSyntheticGltf(GetTestDir("index_rebase"), desc);
+
+    sg::Scene scene;
+    asset::FastGLTFLoader loader;
+    loader.LoadFromFile(gltfPath.string(), &scene);
+
+    // indices of every primitive must point into its own vertex range of the shared buffer
+    const uint32_t numVerticesPerPrimitive = desc.gridSize * desc.gridSize;
+    const auto& indices                    = loader.GetIndices();
+    const auto& subMeshes                  = scene.GetComponents<sg::SubMesh>();
+    ASSERT_EQ(subMeshes.size(), 4);
+    for (uint32_t i = 0; i < subMeshes.size(); ++i)
+    {
+        const uint32_t firstIndex = subMeshes[i]->GetFirstIndex();
+        for (uint32_t j = 0; j < subMeshes[i]->GetIndexCount(); ++j)
+        {
+            EXPECT_GE(indices[firstIndex + j], i * numVerticesPerPrimitive);
+            EXPECT_LT(indices[firstIndex + j], (i + 1) * numVerticesPerPrimitive);
+        }
+    }
+}
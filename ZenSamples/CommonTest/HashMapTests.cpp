@@ -0,0 +1,229 @@
+#include "Templates/HashMap.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace zen;
+
+namespace
+{
+struct Tracked
+{
+    static inline int s_numAlive = 0;
+
+    explicit Tracked(int v = 0) : value(v)
+    {
+        ++s_numAlive;
+    }
+    Tracked(const Tracked& other) : value(other.value)
+    {
+        ++s_numAlive;
+    }
+    Tracked(Tracked&& other) noexcept : value(other.value)
+    {
+        ++s_numAlive;
+    }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked()
+    {
+        --s_numAlive;
+    }
+
+    int value;
+};
+
+// every key lands in the same group, exercises probing and tombstones
+struct CollidingHash
+{
+    size_t operator()(int) const
+    {
+        return 0;
+    }
+};
+} // namespace
+
+TEST(hash_map_test, basic)
+{
+    HashMap<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+    EXPECT_FALSE(map.contains(1));
+
+    map[1] = 10;
+    map.insert({2, 20});
+    map.emplace(3, 30);
+    auto [it, inserted] = map.try_emplace(3, 300);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(it->second, 30);
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at(2), 20);
+    EXPECT_EQ(map.count(3), 1);
+    EXPECT_THROW(map.at(4), std::out_of_range);
+
+    map.insert_or_assign(3, 33);
+    EXPECT_EQ(map[3], 33);
+
+    EXPECT_EQ(map.erase(2), 1);
+    EXPECT_EQ(map.erase(2), 0);
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(map.size(), 2);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(hash_map_test, matches_std_unordered_map)
+{
+    HashMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng(42);
+
+    for (uint32_t i = 0; i < 200000; ++i)
+    {
+        const uint64_t key = rng() % 5000;
+        switch (rng() % 3)
+        {
+            case 0:
+                map[key] = i;
+                reference[key] = i;
+                break;
+            case 1: EXPECT_EQ(map.erase(key), reference.erase(key)); break;
+            default:
+            {
+                auto it    = map.find(key);
+                auto refIt = reference.find(key);
+                ASSERT_EQ(it == map.end(), refIt == reference.end());
+                if (refIt != reference.end())
+                {
+                    EXPECT_EQ(it->second, refIt->second);
+                }
+            }
+            break;
+        }
+    }
+
+    EXPECT_EQ(map.size(), reference.size());
+    size_t numIterated = 0;
+    for (const auto& [key, value] : map)
+    {
+        EXPECT_EQ(reference.at(key), value);
+        ++numIterated;
+    }
+    EXPECT_EQ(numIterated, reference.size());
+}
+
+TEST(hash_map_test, collisions_and_tombstones)
+{
+    HashMap<int, int, CollidingHash> map;
+    for (int round = 0; round < 20; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            map[i] = i + round;
+        }
+        for (int i = 0; i < 100; i += 2)
+        {
+            map.erase(i);
+        }
+        for (int i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(map.contains(i), i % 2 == 1);
+        }
+    }
+    // repeated insert/erase cycles must be absorbed by tombstone reuse, not unbounded growth
+    EXPECT_LE(map.capacity(), 256);
+}
+
+TEST(hash_map_test, heterogeneous_lookup)
+{
+    HashMap<std::string, int> map;
+    map["albedo"] = 1;
+    map.emplace("normal", 2);
+
+    std::string_view view = "normal";
+    EXPECT_EQ(map.find(view)->second, 2);
+    EXPECT_TRUE(map.contains("albedo"));
+    EXPECT_EQ(map.at("albedo"), 1);
+    EXPECT_EQ(map.count(std::string_view("missing")), 0);
+    EXPECT_EQ(map.erase(view), 1);
+    EXPECT_FALSE(map.contains(std::string("normal")));
+}
+
+TEST(hash_map_test, reserve)
+{
+    HashMap<uint32_t, uint32_t> map;
+    map.reserve(1000);
+    const size_t capacity = map.capacity();
+    EXPECT_GE(capacity, 1000);
+
+    map[0]                    = 0;
+    const auto* pFirstElement = &map[0];
+    for (uint32_t i = 1; i < 1000; ++i)
+    {
+        map[i] = i;
+    }
+    // nothing moved while staying within the reserved size
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_EQ(&map[0], pFirstElement);
+}
+
+TEST(hash_map_test, erase_while_iterating)
+{
+    HashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i)
+    {
+        map[i] = i;
+    }
+    for (auto it = map.begin(); it != map.end();)
+    {
+        if (it->first % 3 == 0)
+        {
+            it = map.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    EXPECT_EQ(map.size(), 666);
+    for (const auto& [key, value] : map)
+    {
+        EXPECT_NE(key % 3, 0);
+    }
+}
+
+TEST(hash_map_test, object_lifetime)
+{
+    {
+        HashMap<int, Tracked> map;
+        for (int i = 0; i < 500; ++i)
+        {
+            map.try_emplace(i, i);
+        }
+        EXPECT_EQ(Tracked::s_numAlive, 500);
+
+        HashMap<int, Tracked> copy = map;
+        EXPECT_EQ(Tracked::s_numAlive, 1000);
+        EXPECT_EQ(copy.at(42).value, 42);
+
+        HashMap<int, Tracked> moved = std::move(copy);
+        EXPECT_EQ(Tracked::s_numAlive, 1000);
+        EXPECT_TRUE(copy.empty());
+
+        for (int i = 0; i < 250; ++i)
+        {
+            moved.erase(i);
+        }
+        EXPECT_EQ(Tracked::s_numAlive, 750);
+    }
+    EXPECT_EQ(Tracked::s_numAlive, 0);
+
+    HashMap<std::string, std::unique_ptr<int>> uniqueMap;
+    uniqueMap.emplace("a", std::make_unique<int>(1));
+    uniqueMap["b"] = std::make_unique<int>(2);
+    EXPECT_EQ(*uniqueMap.at("b"), 2);
+}
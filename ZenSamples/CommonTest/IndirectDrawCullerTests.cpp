@@ -0,0 +1,191 @@
+#include "Graphics/RenderCore/V2/Renderer/IndirectDrawCuller.h"
+#include "Graphics/RenderCore/V2/RenderScene.h"
+#include "Graphics/Types/Frustum.h"
+#include "SceneGraph/Scene.h"
+#include "CullingTestUtils.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using namespace zen;
+using namespace zen::rc;
+
+// std430 layouts of cull_draws.comp
+static_assert(sizeof(DrawInstanceData) == 48);
+static_assert(sizeof(CullDrawsSP::CullData) == 112);
+static_assert(sizeof(DrawIndexedIndirectCommand) == 20);
+
+// mesh nodes scattered in a cube with random rotations and scales, every mesh has two submeshes
+// with their own index range, bounds and material. The scene owns every component.
+static void BuildRandomScene(sg::Scene& scene, uint32_t numNodes, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+    std::vector<UniquePtr<sg::Material>> materials;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        materials.emplace_back(MakeUnique<sg::Material>("material" + std::to_string(i)));
+        materials.back()->index = i;
+    }
+
+    std::vector<UniquePtr<sg::Node>> nodes;
+    std::vector<UniquePtr<sg::Mesh>> meshes;
+    std::vector<UniquePtr<sg::SubMesh>> subMeshes;
+    uint32_t firstIndex = 0;
+    for (uint32_t i = 0; i < numNodes; i++)
+    {
+        nodes.emplace_back(MakeUnique<sg::Node>(i, "node" + std::to_string(i)));
+        meshes.emplace_back(MakeUnique<sg::Mesh>("mesh" + std::to_string(i)));
+        for (uint32_t s = 0; s < 2; s++)
+        {
+            const uint32_t indexCount = 36 * (i % 4 + s + 1);
+            subMeshes.emplace_back(
+                MakeUnique<sg::SubMesh>("submesh" + std::to_string(s), firstIndex, indexCount, 24));
+            // the second submesh sits next to the first one
+            const Vec3 offset(static_cast<float>(s), 0.0f, 0.0f);
+            subMeshes.back()->SetAABB(offset - Vec3(0.5f, 0.25f, 0.75f),
+                                      offset + Vec3(0.5f, 0.25f, 0.75f));
+            const uint32_t materialIndex = (i + s) % materials.size();
+            subMeshes.back()->SetMaterial(materialIndex, materials[materialIndex].Get());
+            meshes.back()->AddSubMesh(subMeshes.back().Get());
+            firstIndex += indexCount;
+        }
+
+        const Vec3 translation(position(rng), position(rng), position(rng));
+        const Quat rotation =
+            glm::normalize(Quat(axis(rng), axis(rng), axis(rng), axis(rng) + 2.0f));
+        const Vec3 nodeScale(scale(rng), scale(rng), scale(rng));
+        const Mat4 model = glm::translate(Mat4(1.0f), translation) * glm::mat4_cast(rotation) *
+            glm::scale(Mat4(1.0f), nodeScale);
+        // renderable indices are not the node indices
+        nodes.back()->SetData(numNodes - 1 - i, model);
+        nodes.back()->AddComponent(meshes.back().Get());
+        scene.AddRenderableNode(nodes.back().Get());
+    }
+    scene.SetNodes(std::move(nodes));
+    scene.SetComponents(std::move(materials));
+    scene.SetComponents(std::move(meshes));
+    scene.SetComponents(std::move(subMeshes));
+    scene.BuildBVH();
+}
+
+static std::vector<DrawInstanceData> MakeDrawInstances(const sg::SceneBVH& bvh)
+{
+    std::vector<DrawInstanceData> instances;
+    for (uint32_t i = 0; i < bvh.GetNumItems(); i++)
+    {
+        instances.push_back(RenderScene::MakeDrawInstance(bvh.GetItem(i)));
+    }
+    return instances;
+}
+
+// visible instances in instance order, the box test of cull_draws.comp on the draw instance bounds
+static std::vector<uint32_t> CullInstances(const std::vector<DrawInstanceData>& instances,
+                                           const Frustum& frustum)
+{
+    std::vector<uint32_t> visible;
+    for (uint32_t instanceIndex = 0; instanceIndex < instances.size(); instanceIndex++)
+    {
+        const DrawInstanceData& instance = instances[instanceIndex];
+        bool inside                      = true;
+        for (const Vec4& plane : frustum.GetPlanes())
+        {
+            const Vec3 normal = Vec3(plane);
+            if (glm::dot(normal, Vec3(instance.center)) + plane.w +
+                    glm::dot(glm::abs(normal), Vec3(instance.extent)) <
+                0.0f)
+            {
+                inside = false;
+                break;
+            }
+        }
+        if (inside)
+        {
+            visible.push_back(instanceIndex);
+        }
+    }
+    return visible;
+}
+
+TEST(indirect_draw_culler_tests, draw_instances_pack_the_bvh_items)
+{
+    sg::Scene scene;
+    BuildRandomScene(scene, 50, 3);
+    const sg::SceneBVH& bvh = scene.GetBVH();
+    ASSERT_EQ(bvh.GetNumItems(), 100u);
+
+    for (uint32_t i = 0; i < bvh.GetNumItems(); i++)
+    {
+        const sg::SceneBVH::Item& item  = bvh.GetItem(i);
+        const DrawInstanceData instance = RenderScene::MakeDrawInstance(item);
+        EXPECT_EQ(instance.indexCount, item.pSubMesh->GetIndexCount());
+        EXPECT_EQ(instance.firstIndex, item.pSubMesh->GetFirstIndex());
+        EXPECT_EQ(instance.nodeIndex, item.pNode->GetRenderableIndex());
+        EXPECT_EQ(instance.materialIndex, item.pSubMesh->GetMaterial()->index);
+        EXPECT_EQ(instance.center.w, 0.0f);
+        EXPECT_EQ(instance.extent.w, 0.0f);
+
+        // the world box holds every transformed corner of the submesh box and touches the
+        // farthest corner on each axis
+        const sg::AABB& local = item.pSubMesh->GetAABB();
+        const Mat4& model     = item.pNode->GetData().modelMatrix;
+        Vec3 cornerMin(std::numeric_limits<float>::max());
+        Vec3 cornerMax(-std::numeric_limits<float>::max());
+        for (uint32_t corner = 0; corner < 8; corner++)
+        {
+            const Vec3 point((corner & 1) ? local.GetMax().x : local.GetMin().x,
+                             (corner & 2) ? local.GetMax().y : local.GetMin().y,
+                             (corner & 4) ? local.GetMax().z : local.GetMin().z);
+            const Vec3 world = Vec3(model * Vec4(point, 1.0f));
+            cornerMin        = glm::min(cornerMin, world);
+            cornerMax        = glm::max(cornerMax, world);
+        }
+        const Vec3 center = Vec3(instance.center);
+        const Vec3 extent = Vec3(instance.extent);
+        for (int axis = 0; axis < 3; axis++)
+        {
+            EXPECT_NEAR(center[axis] - extent[axis], cornerMin[axis], 1e-3f);
+            EXPECT_NEAR(center[axis] + extent[axis], cornerMax[axis], 1e-3f);
+        }
+    }
+}
+
+TEST(indirect_draw_culler_tests, instance_bounds_cull_like_scene_bvh)
+{
+    sg::Scene scene;
+    BuildRandomScene(scene, 400, 7);
+    const sg::SceneBVH& bvh                       = scene.GetBVH();
+    const std::vector<DrawInstanceData> instances = MakeDrawInstances(bvh);
+
+    std::vector<Frustum> frustums;
+    for (float halfSize : {0.1f, 5.0f, 12.5f, 100.0f})
+    {
+        frustums.push_back(MakeCubeFrustum(halfSize));
+    }
+    for (const Vec3& eye : {Vec3(0.0f, 0.0f, 45.0f), Vec3(20.0f, 10.0f, -5.0f)})
+    {
+        Frustum frustum;
+        frustum.ExtractPlanes(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 50.0f) *
+                              glm::lookAt(eye, Vec3(0.0f), Vec3(0.0f, 1.0f, 0.0f)));
+        frustums.push_back(frustum);
+    }
+
+    // the GPU pass sees the same instances the BVH culls, indexed like the BVH items
+    for (const Frustum& frustum : frustums)
+    {
+        EXPECT_EQ(CullInstances(instances, frustum), CullSorted(bvh, frustum));
+    }
+
+    const auto cullData = IndirectDrawCuller::MakeCullData(
+        frustums[0], static_cast<uint32_t>(instances.size()), true);
+    EXPECT_EQ(cullData.numInstances, instances.size());
+    EXPECT_EQ(cullData.cullingEnabled, 1u);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(cullData.frustumPlanes[i], frustums[0].GetPlanes()[i]);
+    }
+}
@@ -0,0 +1,151 @@
+#include "Utils/JobSystem.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using zen::JobCounter;
+using zen::JobSystem;
+
+TEST(job_system_test, basic)
+{
+    JobSystem jobSystem(4);
+    JobCounter counter;
+    std::atomic<int> value = 0;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        jobSystem.Submit([&value]() { value++; }, &counter);
+    }
+    jobSystem.Wait(&counter);
+
+    EXPECT_TRUE(counter.IsDone());
+    EXPECT_EQ(value.load(), 100);
+}
+
+TEST(job_system_test, large_callable)
+{
+    JobSystem jobSystem(2);
+    JobCounter counter;
+    std::atomic<uint64_t> sum = 0;
+
+    // does not fit in the inline job storage
+    uint64_t payload[16];
+    for (uint64_t i = 0; i < 16; ++i)
+    {
+        payload[i] = i;
+    }
+    for (int i = 0; i < 64; ++i)
+    {
+        jobSystem.Submit(
+            [&sum, payload]() {
+                uint64_t localSum = 0;
+                for (uint64_t v : payload)
+                {
+                    localSum += v;
+                }
+                sum += localSum;
+            },
+            &counter);
+    }
+    jobSystem.Wait(&counter);
+
+    EXPECT_EQ(sum.load(), 64 * 120);
+}
+
+TEST(job_system_test, parallel_for)
+{
+    JobSystem jobSystem(4);
+    JobCounter counter;
+    std::vector<uint32_t> data(100000, 0);
+
+    jobSystem.ParallelFor(
+        static_cast<uint32_t>(data.size()), 1000,
+        [&data](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                data[i] = i * 2;
+            }
+        },
+        &counter);
+    jobSystem.Wait(&counter);
+
+    for (uint32_t i = 0; i < data.size(); ++i)
+    {
+        ASSERT_EQ(data[i], i * 2);
+    }
+}
+
+TEST(job_system_test, nested_jobs)
+{
+    JobSystem jobSystem(4);
+    JobCounter counter;
+    std::atomic<int> value = 0;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        jobSystem.Submit(
+            [&jobSystem, &counter, &value]() {
+                for (int j = 0; j < 100; ++j)
+                {
+                    jobSystem.Submit([&value]() { value++; }, &counter);
+                }
+            },
+            &counter);
+    }
+    jobSystem.Wait(&counter);
+
+    EXPECT_EQ(value.load(), 100 * 100);
+}
+
+TEST(job_system_test, stress)
+{
+    const uint32_t numProducers    = 8;
+    const uint32_t jobsPerProducer = 100000;
+
+    JobSystem jobSystem;
+    std::atomic<uint64_t> sum = 0;
+
+    // several external threads submit and wait concurrently, jobs get stolen across all queues
+    std::vector<std::thread> producers;
+    producers.reserve(numProducers);
+    for (uint32_t p = 0; p < numProducers; ++p)
+    {
+        producers.emplace_back([&jobSystem, &sum, jobsPerProducer]() {
+            JobCounter counter;
+            for (uint32_t i = 0; i < jobsPerProducer; ++i)
+            {
+                jobSystem.Submit([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); },
+                                 &counter);
+            }
+            jobSystem.Wait(&counter);
+            EXPECT_TRUE(counter.IsDone());
+        });
+    }
+    for (auto& t : producers)
+    {
+        t.join();
+    }
+
+    const uint64_t expected =
+        static_cast<uint64_t>(numProducers) * jobsPerProducer * (jobsPerProducer - 1) / 2;
+    EXPECT_EQ(sum.load(), expected);
+}
+
+TEST(job_system_test, idle_wakeup)
+{
+    JobSystem jobSystem(4);
+    std::atomic<int> value = 0;
+
+    // let the workers go to sleep between batches
+    for (int round = 0; round < 10; ++round)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        JobCounter counter;
+        for (int i = 0; i < 10; ++i)
+        {
+            jobSystem.Submit([&value]() { value++; }, &counter);
+        }
+        jobSystem.Wait(&counter);
+    }
+
+    EXPECT_EQ(value.load(), 100);
+}
@@ -1,4 +1,6 @@
 #include "Utils/SpinLock.h"
+#include "Utils/Mutex.h"
+#include "Utils/ConditionVariable.h"
 #include <gtest/gtest.h>
 #include <thread>
 
@@ -41,3 +43,142 @@ TEST(spin_lock_test, basic)
 
     EXPECT_EQ(sharedCounter, numThreads * incrementsPerThread);
 }
+
+TEST(mutex_test, heavy_contention)
+{
+    const int numThreads          = 64;
+    const int incrementsPerThread = 10000;
+
+    zen::Mutex mutex;
+    int counter = 0;
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([&mutex, &counter, incrementsPerThread]() {
+            for (int j = 0; j < incrementsPerThread; ++j)
+            {
+                zen::LockAuto lock(&mutex);
+                ++counter;
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(counter, numThreads * incrementsPerThread);
+}
+
+TEST(mutex_test, try_lock)
+{
+    zen::Mutex mutex;
+    EXPECT_TRUE(mutex.TryLock());
+
+    bool acquiredByOther = true;
+    std::thread other([&mutex, &acquiredByOther]() { acquiredByOther = mutex.TryLock(); });
+    other.join();
+    EXPECT_FALSE(acquiredByOther);
+
+    mutex.UnLock();
+    EXPECT_TRUE(mutex.TryLock());
+    mutex.UnLock();
+}
+
+TEST(condition_variable_test, producer_consumer)
+{
+    const int numProducers     = 32;
+    const int numConsumers     = 32;
+    const int itemsPerProducer = 2000;
+
+    zen::Mutex mutex;
+    zen::ConditionVariable notEmpty;
+    std::vector<int> items;
+    int numProduced = 0;
+    long long sum   = 0;
+    bool done       = false;
+
+    std::vector<std::thread> consumers;
+    consumers.reserve(numConsumers);
+    for (int i = 0; i < numConsumers; ++i)
+    {
+        consumers.emplace_back([&]() {
+            while (true)
+            {
+                zen::LockAuto lock(&mutex);
+                notEmpty.Wait(&mutex, [&]() { return !items.empty() || done; });
+                if (items.empty())
+                {
+                    return;
+                }
+                sum += items.back();
+                items.pop_back();
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    producers.reserve(numProducers);
+    for (int i = 0; i < numProducers; ++i)
+    {
+        producers.emplace_back([&]() {
+            for (int j = 0; j < itemsPerProducer; ++j)
+            {
+                zen::LockAuto lock(&mutex);
+                items.push_back(j);
+                ++numProduced;
+                notEmpty.NotifyOne();
+            }
+        });
+    }
+    for (auto& t : producers)
+    {
+        t.join();
+    }
+    {
+        zen::LockAuto lock(&mutex);
+        done = true;
+        notEmpty.NotifyAll();
+    }
+    for (auto& t : consumers)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(numProduced, numProducers * itemsPerProducer);
+    EXPECT_TRUE(items.empty());
+    EXPECT_EQ(sum,
+              static_cast<long long>(numProducers) * itemsPerProducer * (itemsPerProducer - 1) / 2);
+}
+
+TEST(condition_variable_test, timed_wait)
+{
+    zen::Mutex mutex;
+    zen::ConditionVariable conVar;
+    bool flag = false;
+
+    // nobody signals, the wait must time out
+    {
+        zen::LockAuto lock(&mutex);
+        auto start   = std::chrono::steady_clock::now();
+        bool result  = conVar.WaitFor(&mutex, [&flag]() { return flag; }, 20);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_FALSE(result);
+        EXPECT_GE(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 20);
+    }
+
+    // signaled before the timeout
+    std::thread signaler([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        zen::LockAuto lock(&mutex);
+        flag = true;
+        conVar.NotifyAll();
+    });
+    {
+        zen::LockAuto lock(&mutex);
+        EXPECT_TRUE(conVar.WaitFor(&mutex, [&flag]() { return flag; }, 5000));
+    }
+    signaler.join();
+}
@@ -0,0 +1,340 @@
+#include "AssetLib/MeshOptimizer.h"
+#include "AssetLib/FastGLTFLoader.h"
+#include "SceneGraph/Scene.h"
+#include "Utils/Errors.h"
+#include "SyntheticGltf.h"
+#include "TestUtils.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <filesystem>
+#include <random>
+
+using namespace zen;
+using namespace zen::asset;
+
+namespace
+{
+struct TestMesh
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+using Triangle = std::array<float, 9>;
+
+Vertex MakeVertex(const Vec3& pos)
+{
+    Vertex vertex{};
+    vertex.pos = Vec4(pos, 1.0f);
+    return vertex;
+}
+
+// n x n vertices in the xz plane, quads in row order like most exporters write them
+TestMesh MakeGrid(uint32_t n)
+{
+    TestMesh mesh;
+    for (uint32_t z = 0; z < n; ++z)
+    {
+        for (uint32_t x = 0; x < n; ++x)
+        {
+            mesh.vertices.push_back(MakeVertex(Vec3(x, 0.0f, z)));
+        }
+    }
+    for (uint32_t z = 0; z + 1 < n; ++z)
+    {
+        for (uint32_t x = 0; x + 1 < n; ++x)
+        {
+            const uint32_t i = z * n + x;
+            mesh.indices.insert(mesh.indices.end(), {i, i + n, i + 1, i + 1, i + n, i + n + 1});
+        }
+    }
+    return mesh;
+}
+
+// closed uv sphere with counter-clockwise triangles seen from outside
+TestMesh MakeSphere(uint32_t numRings, uint32_t numSegments, float radius)
+{
+    TestMesh mesh;
+    for (uint32_t ring = 0; ring <= numRings; ++ring)
+    {
+        const float theta = 3.14159265f * ring / numRings;
+        for (uint32_t segment = 0; segment <= numSegments; ++segment)
+        {
+            const float phi = 2.0f * 3.14159265f * segment / numSegments;
+            mesh.vertices.push_back(MakeVertex(
+                Vec3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                     std::sin(theta) * std::sin(phi)) *
+                radius));
+        }
+    }
+    for (uint32_t ring = 0; ring < numRings; ++ring)
+    {
+        for (uint32_t segment = 0; segment < numSegments; ++segment)
+        {
+            const uint32_t i0 = ring * (numSegments + 1) + segment;
+            const uint32_t i1 = i0 + numSegments + 1;
+            mesh.indices.insert(mesh.indices.end(), {i0, i0 + 1, i1, i0 + 1, i1 + 1, i1});
+        }
+    }
+    return mesh;
+}
+
+// random triangle order, the worst case for the post-transform cache
+void ShuffleTriangles(TestMesh& mesh, uint32_t seed)
+{
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+        triangles.push_back({mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]});
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(seed));
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        std::copy(triangles[i].begin(), triangles[i].end(), mesh.indices.begin() + i * 3);
+    }
+}
+
+// triangles by position, vertex renumbering keeps these while indices change
+std::vector<Triangle> GetSortedTriangles(const std::vector<Vertex>& vertices,
+                                         const uint32_t* pIndices,
+                                         uint32_t numIndices)
+{
+    std::vector<Triangle> triangles(numIndices / 3);
+    for (uint32_t i = 0; i < numIndices; ++i)
+    {
+        const Vec4& pos                 = vertices[pIndices[i]].pos;
+        triangles[i / 3][i % 3 * 3 + 0] = pos.x;
+        triangles[i / 3][i % 3 * 3 + 1] = pos.y;
+        triangles[i / 3][i % 3 * 3 + 2] = pos.z;
+    }
+    // the first vertex of a triangle may change, the winding may not
+    for (Triangle& triangle : triangles)
+    {
+        Triangle rotated = triangle;
+        for (uint32_t i = 1; i < 3; ++i)
+        {
+            std::rotate(rotated.begin(), rotated.begin() + 3, rotated.end());
+            triangle = std::min(triangle, rotated);
+        }
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+std::vector<Triangle> GetSortedTriangles(const TestMesh& mesh)
+{
+    return GetSortedTriangles(mesh.vertices, mesh.indices.data(), mesh.indices.size());
+}
+
+VertexCacheStatistics Analyze(const TestMesh& mesh)
+{
+    return MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size());
+}
+} // namespace
+
+TEST(mesh_optimizer_test, analyze_vertex_cache)
+{
+    // one triangle transforms every vertex once
+    const uint32_t triangle[]        = {4, 5, 6};
+    VertexCacheStatistics statistics = MeshOptimizer::AnalyzeVertexCache(triangle, 3);
+    EXPECT_EQ(statistics.numTransformedVertices, 3);
+    EXPECT_FLOAT_EQ(statistics.acmr, 3.0f);
+    EXPECT_FLOAT_EQ(statistics.atvr, 1.0f);
+
+    // a quad reuses its diagonal
+    const uint32_t quad[] = {0, 1, 2, 2, 1, 3};
+    statistics            = MeshOptimizer::AnalyzeVertexCache(quad, 6);
+    EXPECT_EQ(statistics.numTransformedVertices, 4);
+    EXPECT_FLOAT_EQ(statistics.acmr, 2.0f);
+    EXPECT_FLOAT_EQ(statistics.atvr, 1.0f);
+
+    // with a cache of 3 the fifo evicts vertex 0 before the last triangle
+    const uint32_t fan[] = {0, 1, 2, 0, 2, 3, 0, 3, 4};
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(fan, 9, 3).numTransformedVertices, 6);
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(fan, 9, 16).numTransformedVertices, 5);
+
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(quad, 0).numTransformedVertices, 0);
+}
+
+TEST(mesh_optimizer_test, vertex_cache)
+{
+    TestMesh grid         = MakeGrid(128);
+    TestMesh shuffledGrid = grid;
+    ShuffleTriangles(shuffledGrid, 3);
+    TestMesh sphere = MakeSphere(64, 128, 5.0f);
+    ShuffleTriangles(sphere, 7);
+
+    for (TestMesh* pMesh : {&grid, &shuffledGrid, &sphere})
+    {
+        const std::vector<Triangle> triangles = GetSortedTriangles(*pMesh);
+        const VertexCacheStatistics before    = Analyze(*pMesh);
+        MeshOptimizer::OptimizeVertexCache(pMesh->indices.data(), pMesh->indices.size());
+        const VertexCacheStatistics after = Analyze(*pMesh);
+        LOGI("acmr {:.3f} -> {:.3f}, atvr {:.3f} -> {:.3f}", before.acmr, after.acmr, before.atvr,
+             after.atvr);
+
+        EXPECT_EQ(GetSortedTriangles(*pMesh), triangles);
+        // a regular grid needs 0.5 at best, forsyth gets within ~0.2 of it on a 16 entry fifo
+        EXPECT_LT(after.acmr, 0.75f);
+        EXPECT_LT(after.atvr, 1.5f);
+        EXPECT_LT(after.acmr, before.acmr);
+    }
+}
+
+TEST(mesh_optimizer_test, overdraw)
+{
+    // an inner sphere listed before the outer one, the outer shell has to be drawn first
+    TestMesh mesh           = MakeSphere(24, 48, 2.0f);
+    const TestMesh outer    = MakeSphere(24, 48, 5.0f);
+    const uint32_t numInner = mesh.vertices.size();
+    mesh.vertices.insert(mesh.vertices.end(), outer.vertices.begin(), outer.vertices.end());
+    for (uint32_t index : outer.indices)
+    {
+        mesh.indices.push_back(index + numInner);
+    }
+    ShuffleTriangles(mesh, 11);
+    const std::vector<Triangle> triangles = GetSortedTriangles(mesh);
+
+    MeshOptimizer::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size());
+    const VertexCacheStatistics cacheOptimized = Analyze(mesh);
+    MeshOptimizer::OptimizeOverdraw(mesh.vertices.data(), mesh.indices.data(),
+                                    mesh.indices.size());
+    const VertexCacheStatistics overdrawOptimized = Analyze(mesh);
+
+    EXPECT_EQ(GetSortedTriangles(mesh), triangles);
+    // clusters are split where their acmr is within the threshold, cache restarts cost a little
+    EXPECT_LE(overdrawOptimized.acmr, cacheOptimized.acmr * MeshOptimizer::cOverdrawThreshold);
+
+    bool reachedInner = false;
+    for (uint32_t index : mesh.indices)
+    {
+        const bool isInner = index < numInner;
+        EXPECT_TRUE(isInner || !reachedInner);
+        reachedInner |= isInner;
+    }
+}
+
+TEST(mesh_optimizer_test, vertex_fetch)
+{
+    // a submesh in the middle of the scene vertex array
+    TestMesh mesh = MakeSphere(16, 32, 1.0f);
+    ShuffleTriangles(mesh, 5);
+    const uint32_t baseVertex = 100;
+    std::vector<Vertex> vertices(baseVertex, MakeVertex(Vec3(-1000.0f)));
+    vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+    for (uint32_t& index : mesh.indices)
+    {
+        index += baseVertex;
+    }
+    // an unreferenced vertex inside the range and one only used by a degenerate triangle
+    vertices.push_back(MakeVertex(Vec3(1000.0f)));
+    const uint32_t lastVertex = vertices.size();
+    vertices.push_back(MakeVertex(Vec3(1500.0f)));
+    mesh.indices.insert(mesh.indices.end(), {lastVertex, lastVertex, lastVertex});
+    vertices.push_back(MakeVertex(Vec3(2000.0f)));
+
+    const std::vector<Triangle> triangles =
+        GetSortedTriangles(vertices, mesh.indices.data(), mesh.indices.size());
+    MeshOptimizer::OptimizeVertexFetch(vertices.data(), mesh.indices.data(), mesh.indices.size());
+    EXPECT_EQ(GetSortedTriangles(vertices, mesh.indices.data(), mesh.indices.size()), triangles);
+
+    // vertices are fetched in ascending order, the unreferenced one moves to the end of the
+    // range and the vertices around the range stay put
+    uint32_t nextVertex = baseVertex;
+    for (uint32_t index : mesh.indices)
+    {
+        ASSERT_LE(index, nextVertex);
+        nextVertex = std::max(nextVertex, index + 1);
+    }
+    EXPECT_EQ(nextVertex, lastVertex);
+    EXPECT_EQ(vertices[lastVertex].pos.x, 1000.0f);
+    EXPECT_EQ(vertices[baseVertex - 1].pos.x, -1000.0f);
+    EXPECT_EQ(vertices[lastVertex + 1].pos.x, 2000.0f);
+}
+
+TEST(mesh_optimizer_test, generated_gltf)
+{
+    SyntheticGltfDesc desc;
+    desc.numMeshes            = 2;
+    desc.numPrimitivesPerMesh = 2;
+    desc.gridSize             = 96;
+    const auto gltfPath = WriteSyntheticGltf(GetTestDir("mesh_optimizer"), desc);
+
+    sg::Scene scene;
+    FastGLTFLoader loader;
+    loader.LoadFromFile(gltfPath.string(), &scene);
+    sg::Scene optimizedScene;
+    FastGLTFLoader optimizedLoader;
+    optimizedLoader.SetOptimizeMeshes(true);
+    optimizedLoader.LoadFromFile(gltfPath.string(), &optimizedScene);
+
+    const auto& subMeshes          = scene.GetComponents<sg::SubMesh>();
+    const auto& optimizedSubMeshes = optimizedScene.GetComponents<sg::SubMesh>();
+    ASSERT_EQ(subMeshes.size(), optimizedSubMeshes.size());
+    for (size_t i = 0; i < subMeshes.size(); ++i)
+    {
+        // submeshes keep their index ranges, only the order inside them changes
+        ASSERT_EQ(optimizedSubMeshes[i]->GetFirstIndex(), subMeshes[i]->GetFirstIndex());
+        ASSERT_EQ(optimizedSubMeshes[i]->GetIndexCount(), subMeshes[i]->GetIndexCount());
+        const uint32_t* pIndices = loader.GetIndices().data() + subMeshes[i]->GetFirstIndex();
+        const uint32_t* pOptimizedIndices =
+            optimizedLoader.GetIndices().data() + subMeshes[i]->GetFirstIndex();
+        const uint32_t numIndices = subMeshes[i]->GetIndexCount();
+
+        EXPECT_EQ(GetSortedTriangles(optimizedLoader.GetVertices(), pOptimizedIndices, numIndices),
+                  GetSortedTriangles(loader.GetVertices(), pIndices, numIndices));
+        EXPECT_LT(MeshOptimizer::AnalyzeVertexCache(pOptimizedIndices, numIndices).acmr,
+                  MeshOptimizer::AnalyzeVertexCache(pIndices, numIndices).acmr);
+    }
+}
+
+TEST(mesh_optimizer_test, sample_models)
+{
+    // same location the VulkanRHIDemo samples load their models from
+    const char* cSampleModels[] = {
+        "../../glTF-Sample-Models/2.0/DamagedHelmet/glTF/DamagedHelmet.gltf",
+        "../../glTF-Sample-Models/2.0/FlightHelmet/glTF/FlightHelmet.gltf",
+        "../../glTF-Sample-Models/2.0/Sponza/glTF/Sponza.gltf",
+    };
+    uint32_t numLoadedModels = 0;
+    for (const char* pModelPath : cSampleModels)
+    {
+        if (!std::filesystem::exists(pModelPath))
+        {
+            continue;
+        }
+        numLoadedModels++;
+
+        sg::Scene scene;
+        FastGLTFLoader loader;
+        loader.LoadFromFile(pModelPath, &scene);
+        sg::Scene optimizedScene;
+        FastGLTFLoader optimizedLoader;
+        optimizedLoader.SetOptimizeMeshes(true);
+        optimizedLoader.LoadFromFile(pModelPath, &optimizedScene);
+
+        uint32_t numTriangles            = 0;
+        uint32_t numTransformed          = 0;
+        uint32_t numOptimizedTransformed = 0;
+        for (const sg::SubMesh* pSubMesh : scene.GetComponents<sg::SubMesh>())
+        {
+            const uint32_t firstIndex = pSubMesh->GetFirstIndex();
+            const uint32_t numIndices = pSubMesh->GetIndexCount();
+            const VertexCacheStatistics before =
+                MeshOptimizer::AnalyzeVertexCache(&loader.GetIndices()[firstIndex], numIndices);
+            const VertexCacheStatistics after = MeshOptimizer::AnalyzeVertexCache(
+                &optimizedLoader.GetIndices()[firstIndex], numIndices);
+            numTriangles += numIndices / 3;
+            numTransformed += before.numTransformedVertices;
+            numOptimizedTransformed += after.numTransformedVertices;
+        }
+        EXPECT_LE(numOptimizedTransformed, numTransformed);
+        LOGI("{}: acmr {:.3f} -> {:.3f}", pModelPath,
+             static_cast<float>(numTransformed) / numTriangles,
+             static_cast<float>(numOptimizedTransformed) / numTriangles);
+    }
+    if (numLoadedModels == 0)
+    {
+        GTEST_SKIP() << "glTF-Sample-Models not found next to the repository";
+    }
+}
@@ -0,0 +1,256 @@
+#include "AssetLib/MeshletBuilder.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <random>
+
+using namespace zen;
+using namespace zen::asset;
+
+namespace
+{
+struct TestMesh
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+Vertex MakeVertex(const Vec3& pos)
+{
+    Vertex vertex{};
+    vertex.pos = Vec4(pos, 1.0f);
+    return vertex;
+}
+
+// n x n vertices in the xz plane facing +y, placed after baseVertex unused vertices like a
+// submesh in the middle of the scene vertex array
+TestMesh MakeGrid(uint32_t n, uint32_t baseVertex = 0)
+{
+    TestMesh mesh;
+    mesh.vertices.resize(baseVertex, MakeVertex(Vec3(1000.0f)));
+    for (uint32_t z = 0; z < n; ++z)
+    {
+        for (uint32_t x = 0; x < n; ++x)
+        {
+            mesh.vertices.push_back(MakeVertex(Vec3(x, 0.0f, z)));
+        }
+    }
+    for (uint32_t z = 0; z + 1 < n; ++z)
+    {
+        for (uint32_t x = 0; x + 1 < n; ++x)
+        {
+            const uint32_t i = baseVertex + z * n + x;
+            mesh.indices.insert(mesh.indices.end(), {i, i + n, i + 1, i + 1, i + n, i + n + 1});
+        }
+    }
+    return mesh;
+}
+
+// closed uv sphere with counter-clockwise triangles seen from outside
+TestMesh MakeSphere(uint32_t numRings, uint32_t numSegments)
+{
+    TestMesh mesh;
+    for (uint32_t ring = 0; ring <= numRings; ++ring)
+    {
+        const float theta = 3.14159265f * ring / numRings;
+        for (uint32_t segment = 0; segment <= numSegments; ++segment)
+        {
+            const float phi = 2.0f * 3.14159265f * segment / numSegments;
+            mesh.vertices.push_back(MakeVertex(
+                Vec3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                     std::sin(theta) * std::sin(phi)) *
+                5.0f));
+        }
+    }
+    for (uint32_t ring = 0; ring < numRings; ++ring)
+    {
+        for (uint32_t segment = 0; segment < numSegments; ++segment)
+        {
+            const uint32_t i0 = ring * (numSegments + 1) + segment;
+            const uint32_t i1 = i0 + numSegments + 1;
+            mesh.indices.insert(mesh.indices.end(), {i0, i0 + 1, i1, i0 + 1, i1 + 1, i1});
+        }
+    }
+    return mesh;
+}
+
+// unconnected random triangles, as exported for flat shading
+TestMesh MakeTriangleSoup(uint32_t numTriangles)
+{
+    TestMesh mesh;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
+    for (uint32_t i = 0; i < numTriangles; ++i)
+    {
+        const Vec3 center(dist(rng), dist(rng), dist(rng));
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            mesh.vertices.push_back(
+                MakeVertex(center + Vec3(dist(rng), dist(rng), dist(rng)) * 0.05f));
+            mesh.indices.push_back(i * 3 + j);
+        }
+    }
+    // a few degenerate triangles
+    mesh.indices.insert(mesh.indices.end(), {0, 0, 1, 4, 4, 4});
+    return mesh;
+}
+
+Vec3 GetPos(const TestMesh& mesh, uint32_t index)
+{
+    return Vec3(mesh.vertices[index].pos);
+}
+
+// index coverage, size limits, bounding sphere containment and conservative cone culling
+void ValidateMeshlets(const TestMesh& mesh, const MeshletData& meshletData)
+{
+    std::vector<std::array<uint32_t, 3>> expectedTriangles;
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+        expectedTriangles.push_back({mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]});
+    }
+
+    std::vector<std::array<uint32_t, 3>> meshletTriangles;
+    for (const Meshlet& meshlet : meshletData.meshlets)
+    {
+        ASSERT_GT(meshlet.vertexCount, 0);
+        ASSERT_GT(meshlet.triangleCount, 0);
+        ASSERT_LE(meshlet.vertexCount, MeshletBuilder::cMaxVertices);
+        ASSERT_LE(meshlet.triangleCount, MeshletBuilder::cMaxTriangles);
+
+        const Vec3 center(meshlet.boundingSphere);
+        const float radius = meshlet.boundingSphere.w;
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+        {
+            const Vec3 pos = GetPos(mesh, meshletData.vertices[meshlet.vertexOffset + i]);
+            EXPECT_LE(glm::distance(center, pos), radius * (1.0f + 1e-5f) + 1e-6f);
+        }
+        for (uint32_t i = 0; i < meshlet.triangleCount; ++i)
+        {
+            std::array<uint32_t, 3> triangle;
+            for (uint32_t j = 0; j < 3; ++j)
+            {
+                const uint8_t localIndex =
+                    meshletData.triangles[(meshlet.triangleOffset + i) * 3 + j];
+                ASSERT_LT(localIndex, meshlet.vertexCount);
+                triangle[j] = meshletData.vertices[meshlet.vertexOffset + localIndex];
+            }
+            meshletTriangles.push_back(triangle);
+        }
+    }
+    // every triangle exactly once, with its winding
+    std::sort(expectedTriangles.begin(), expectedTriangles.end());
+    std::sort(meshletTriangles.begin(), meshletTriangles.end());
+    EXPECT_EQ(meshletTriangles, expectedTriangles);
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> dist(-60.0f, 60.0f);
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+        const Vec3 cameraPos(dist(rng), dist(rng), dist(rng));
+        for (const Meshlet& meshlet : meshletData.meshlets)
+        {
+            if (!MeshletBuilder::IsBackFacing(meshlet, cameraPos))
+            {
+                continue;
+            }
+            const uint32_t* pMeshletVertices = &meshletData.vertices[meshlet.vertexOffset];
+            for (uint32_t j = 0; j < meshlet.triangleCount; ++j)
+            {
+                const uint8_t* pTriangle = &meshletData.triangles[(meshlet.triangleOffset + j) * 3];
+                const Vec3 p0            = GetPos(mesh, pMeshletVertices[pTriangle[0]]);
+                const Vec3 p1            = GetPos(mesh, pMeshletVertices[pTriangle[1]]);
+                const Vec3 p2            = GetPos(mesh, pMeshletVertices[pTriangle[2]]);
+                const Vec3 normal        = glm::cross(p1 - p0, p2 - p0);
+                EXPECT_GE(glm::dot(normal, p0 - cameraPos), -1e-3f * glm::length(normal));
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(meshlet_builder_test, grid)
+{
+    const TestMesh mesh = MakeGrid(97, 123);
+    MeshletData meshletData;
+    const uint32_t numMeshlets = MeshletBuilder::Build(mesh.vertices.data(), mesh.indices.data(),
+                                                       mesh.indices.size(), meshletData);
+    EXPECT_EQ(numMeshlets, meshletData.meshlets.size());
+    ValidateMeshlets(mesh, meshletData);
+
+    // clusters grown over shared vertices stay close to the 8x8 vertex patch limit
+    const float averageTriangles = static_cast<float>(mesh.indices.size() / 3) / numMeshlets;
+    EXPECT_GT(averageTriangles, 80.0f);
+
+    // the grid faces +y, from below every meshlet is culled
+    for (const Meshlet& meshlet : meshletData.meshlets)
+    {
+        EXPECT_TRUE(MeshletBuilder::IsBackFacing(meshlet, Vec3(48.0f, -500.0f, 48.0f)));
+        EXPECT_FALSE(MeshletBuilder::IsBackFacing(meshlet, Vec3(48.0f, 500.0f, 48.0f)));
+    }
+}
+
+TEST(meshlet_builder_test, sphere)
+{
+    const TestMesh mesh = MakeSphere(48, 96);
+    MeshletData meshletData;
+    MeshletBuilder::Build(mesh.vertices.data(), mesh.indices.data(), mesh.indices.size(),
+                          meshletData);
+    ValidateMeshlets(mesh, meshletData);
+
+    // roughly the far half of a sphere is back facing
+    uint32_t numCulled = 0;
+    for (const Meshlet& meshlet : meshletData.meshlets)
+    {
+        numCulled += MeshletBuilder::IsBackFacing(meshlet, Vec3(0.0f, 0.0f, 100.0f));
+    }
+    EXPECT_GT(numCulled, meshletData.meshlets.size() / 4);
+}
+
+TEST(meshlet_builder_test, triangle_soup)
+{
+    const TestMesh mesh = MakeTriangleSoup(5000);
+    MeshletData meshletData;
+    MeshletBuilder::Build(mesh.vertices.data(), mesh.indices.data(), mesh.indices.size(),
+                          meshletData);
+    ValidateMeshlets(mesh, meshletData);
+    // three unshared vertices per triangle, the vertex limit is what splits, meshlets still fill
+    // up in index order
+    for (size_t i = 0; i + 1 < meshletData.meshlets.size(); ++i)
+    {
+        EXPECT_GE(meshletData.meshlets[i].vertexCount, MeshletBuilder::cMaxVertices - 2);
+    }
+}
+
+TEST(meshlet_builder_test, append_submeshes)
+{
+    // two submeshes of one scene share the output arrays
+    TestMesh mesh             = MakeGrid(20);
+    const TestMesh sphere     = MakeSphere(8, 16);
+    const uint32_t baseVertex = mesh.vertices.size();
+    const uint32_t firstIndex = mesh.indices.size();
+    mesh.vertices.insert(mesh.vertices.end(), sphere.vertices.begin(), sphere.vertices.end());
+    for (uint32_t index : sphere.indices)
+    {
+        mesh.indices.push_back(index + baseVertex);
+    }
+
+    MeshletData meshletData;
+    const uint32_t numGridMeshlets =
+        MeshletBuilder::Build(mesh.vertices.data(), mesh.indices.data(), firstIndex, meshletData);
+    const uint32_t numSphereMeshlets =
+        MeshletBuilder::Build(mesh.vertices.data(), mesh.indices.data() + firstIndex,
+                              mesh.indices.size() - firstIndex, meshletData);
+    EXPECT_EQ(numGridMeshlets + numSphereMeshlets, meshletData.meshlets.size());
+    ValidateMeshlets(mesh, meshletData);
+    for (uint32_t i = numGridMeshlets; i < meshletData.meshlets.size(); ++i)
+    {
+        const Meshlet& meshlet = meshletData.meshlets[i];
+        for (uint32_t j = 0; j < meshlet.vertexCount; ++j)
+        {
+            EXPECT_GE(meshletData.vertices[meshlet.vertexOffset + j], baseVertex);
+        }
+    }
+
+    MeshletData emptyData;
+    EXPECT_EQ(MeshletBuilder::Build(mesh.vertices.data(), mesh.indices.data(), 0, emptyData), 0);
+    EXPECT_TRUE(emptyData.meshlets.empty());
+}
@@ -0,0 +1,341 @@
+#include "Graphics/NullRHI/NullRHI.h"
+#include "Graphics/NullRHI/NullResources.h"
+#include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "RenderGraphTestUtils.h"
+#include "Utils/JobSystem.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace zen;
+using namespace zen::rc;
+
+namespace
+{
+class NullRHITest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_pRHI = ZEN_NEW() NullRHI();
+        m_pRHI->Init();
+    }
+
+    void TearDown() override
+    {
+        m_pRHI->Destroy();
+        ZEN_DELETE(m_pRHI);
+    }
+
+    RHIBuffer* CreateBuffer(const std::string& tag, uint32_t size, bool transient = false)
+    {
+        RHIBufferCreateInfo createInfo = MakeTestBufferInfo(tag, transient);
+        createInfo.size                = size;
+        return m_pRHI->CreateBuffer(createInfo);
+    }
+
+    RHITexture* CreateTexture(const std::string& tag)
+    {
+        return m_pRHI->CreateTexture(MakeTestTextureInfo(tag));
+    }
+
+    // a shader without stages does not load any SPIR-V, pipelines are named after it
+    RHIPipeline* CreateComputePipeline(const std::string& name, RHIShader** ppShader)
+    {
+        RHIShaderCreateInfo shaderInfo{};
+        shaderInfo.name = name;
+        *ppShader       = m_pRHI->CreateShader(shaderInfo);
+
+        RHIComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.pShader = *ppShader;
+        return m_pRHI->CreatePipeline(pipelineInfo);
+    }
+
+    // finalizes and submits one list, the way the renderer does at the end of a frame
+    void Submit(RHICommandList* pCmdList)
+    {
+        HeapVector<RHIPlatformCommandList*> platformCmdLists;
+        m_pRHI->FinalizeCommandLists(MakeVecView(&pCmdList, 1), platformCmdLists);
+        m_pRHI->SubmitPlatformCommandLists(MakeVecView(platformCmdLists));
+    }
+
+    std::vector<std::string> SubmittedTexts() const
+    {
+        std::vector<std::string> texts;
+        for (const NullCommandRecord& record : m_pRHI->GetSubmittedRecords())
+        {
+            texts.push_back(record.text);
+        }
+        return texts;
+    }
+
+    NullRHI* m_pRHI{nullptr};
+};
+} // namespace
+
+TEST_F(NullRHITest, resources_are_tracked_until_destroyed)
+{
+    RHIBuffer* pBuffer   = CreateBuffer("vertices", 256);
+    RHITexture* pTexture = CreateTexture("albedo");
+    EXPECT_EQ(m_pRHI->GetNumLiveResources(RHIResourceType::eBuffer), 1u);
+    EXPECT_EQ(m_pRHI->GetNumLiveResources(RHIResourceType::eTexture), 1u);
+    EXPECT_TRUE(m_pRHI->IsResourceAlive(pBuffer));
+
+    m_pRHI->DestroyBuffer(pBuffer);
+    m_pRHI->DestroyTexture(pTexture);
+    EXPECT_EQ(m_pRHI->GetNumLiveResources(RHIResourceType::eBuffer), 0u);
+    EXPECT_EQ(m_pRHI->GetNumLiveResources(RHIResourceType::eTexture), 0u);
+    EXPECT_EQ(m_pRHI->GetNumCreatedResources(RHIResourceType::eBuffer), 1u);
+    EXPECT_TRUE(m_pRHI->GetValidationErrors().empty());
+}
+
+TEST_F(NullRHITest, submitted_lists_are_logged_in_order)
+{
+    RHIBuffer* pSrc = CreateBuffer("staging", 256);
+    RHIBuffer* pDst = CreateBuffer("vertices", 256);
+
+    RHICommandList* pCmdList =
+        RHICommandList::Create(m_pRHI->GetCommandContext(RHICommandContextType::eGraphics));
+    pCmdList->ClearBuffer(pSrc, 0, 256);
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    pCmdList->CopyBuffer(pSrc, pDst, region);
+    Submit(pCmdList);
+
+    EXPECT_EQ(SubmittedTexts(),
+              (std::vector<std::string>{"ClearBuffer staging 0 256",
+                                        "CopyBuffer staging vertices 256"}));
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eCopyBuffer), 1u);
+    EXPECT_TRUE(m_pRHI->GetValidationErrors().empty());
+
+    ZEN_DELETE(pCmdList);
+    m_pRHI->DestroyBuffer(pSrc);
+    m_pRHI->DestroyBuffer(pDst);
+}
+
+TEST_F(NullRHITest, draw_outside_rendering_is_reported)
+{
+    RHICommandList* pCmdList =
+        RHICommandList::Create(m_pRHI->GetCommandContext(RHICommandContextType::eGraphics));
+    pCmdList->Draw(3, 1, 0, 0);
+    Submit(pCmdList);
+
+    // the draw is still logged, next to the errors it caused
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eDraw), 1u);
+    EXPECT_EQ(m_pRHI->GetValidationErrors().size(), 2u);
+
+    ZEN_DELETE(pCmdList);
+}
+
+TEST_F(NullRHITest, use_after_destroy_is_reported)
+{
+    RHIBuffer* pBuffer = CreateBuffer("particles", 256);
+    m_pRHI->DestroyBuffer(pBuffer);
+
+    RHICommandList* pCmdList =
+        RHICommandList::Create(m_pRHI->GetCommandContext(RHICommandContextType::eAsyncCompute));
+    pCmdList->ClearBuffer(pBuffer, 0, 256);
+    Submit(pCmdList);
+
+    EXPECT_EQ(SubmittedTexts(), (std::vector<std::string>{"ClearBuffer destroyed 0 256"}));
+    ASSERT_EQ(m_pRHI->GetValidationErrors().size(), 1u);
+
+    ZEN_DELETE(pCmdList);
+}
+
+TEST_F(NullRHITest, transitions_must_start_from_the_tracked_usage)
+{
+    RHIBuffer* pBuffer = CreateBuffer("particles", 256);
+
+    RHIBufferTransition transition{};
+    transition.pBuffer  = pBuffer;
+    transition.oldUsage = RHIBufferUsage::eNone;
+    transition.newUsage = RHIBufferUsage::eTransferDst;
+
+    RHICommandList* pCmdList =
+        RHICommandList::Create(m_pRHI->GetCommandContext(RHICommandContextType::eGraphics));
+    const BitField<RHIPipelineStageBits> transferStage(RHIPipelineStageBits::eTransfer);
+    const BitField<RHIPipelineStageBits> computeStage(RHIPipelineStageBits::eComputeShader);
+    pCmdList->AddTransitions(transferStage, transferStage, {}, MakeVecView(&transition, 1), {});
+    // the buffer is a transfer destination, not a storage buffer
+    transition.oldUsage = RHIBufferUsage::eStorageBuffer;
+    transition.newUsage = RHIBufferUsage::eUniformBuffer;
+    pCmdList->AddTransitions(transferStage, computeStage, {}, MakeVecView(&transition, 1), {});
+    Submit(pCmdList);
+
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eTransitions), 2u);
+    EXPECT_EQ(m_pRHI->GetValidationErrors().size(), 1u);
+    EXPECT_EQ(static_cast<NullBuffer*>(pBuffer)->GetTrackedUsage(),
+              RHIBufferUsage::eUniformBuffer);
+
+    ZEN_DELETE(pCmdList);
+    m_pRHI->DestroyBuffer(pBuffer);
+}
+
+TEST_F(NullRHITest, transient_buffers_need_bound_memory)
+{
+    RHIBuffer* pBuffer = CreateBuffer("scratch", 512, true);
+    RHIMemoryRequirements requirements{};
+    requirements.size            = 256;
+    RHIMemoryBlock* pMemoryBlock = m_pRHI->CreateMemoryBlock(requirements);
+
+    RHICommandList* pCmdList =
+        RHICommandList::Create(m_pRHI->GetCommandContext(RHICommandContextType::eGraphics));
+    pCmdList->ClearBuffer(pBuffer, 0, 512);
+    Submit(pCmdList);
+    EXPECT_EQ(m_pRHI->GetValidationErrors().size(), 1u);
+    m_pRHI->ClearValidationErrors();
+
+    // 512 bytes do not fit into a 256 byte block
+    m_pRHI->BindBufferMemory(pBuffer, pMemoryBlock, 0);
+    EXPECT_EQ(m_pRHI->GetValidationErrors().size(), 1u);
+
+    ZEN_DELETE(pCmdList);
+    m_pRHI->DestroyBuffer(pBuffer);
+    m_pRHI->DestroyMemoryBlock(pMemoryBlock);
+}
+
+TEST_F(NullRHITest, render_graph_executes_through_the_null_context)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    RHIBuffer* pParticles  = CreateBuffer("particles", 256);
+    RHIShader* pShader     = nullptr;
+    RHIPipeline* pPipeline = CreateComputePipeline("simulate", &pShader);
+
+    ComputePass pass;
+    pass.pPipeline         = pPipeline;
+    pass.numDescriptorSets = 1;
+    pass.pShaderProgram    = nullptr;
+    for (RHIDescriptorSet*& pSet : pass.pDescriptorSets)
+    {
+        pSet = nullptr;
+    }
+    PassResourceTracker& tracker = pass.resourceTrackers[0][0];
+    tracker.name                 = "particles";
+    tracker.pBuffer              = pParticles;
+    tracker.resourceType         = PassResourceType::eBuffer;
+    tracker.accessMode           = RHIAccessMode::eReadWrite;
+    tracker.bufferUsage          = RHIBufferUsage::eStorageBuffer;
+
+    RenderGraph rdg("rdg_null_rhi");
+    rdg.Begin();
+    rdg.AddBufferClearNode(pParticles, 0, 256);
+    RDGPassNode* pPassNode = rdg.AddComputePassNode(&pass, "simulate");
+    rdg.AddComputePassDispatchNode(pPassNode, 8, 1, 1);
+    rdg.End();
+    // the trackers are declared, the shader has no reflection data to create a set from
+    pass.numDescriptorSets = 0;
+
+    RHICommandList* pCmdList =
+        RHICommandList::Create(m_pRHI->GetCommandContext(RHICommandContextType::eGraphics));
+    rdg.Execute(pCmdList);
+    Submit(pCmdList);
+
+    // the clear is a transfer write, the dispatch reads it as a storage buffer
+    EXPECT_EQ(SubmittedTexts(), (std::vector<std::string>{"Transitions 0 particles:0->2",
+                                                          "ClearBuffer particles 0 256",
+                                                          "Transitions 0 particles:2->6",
+                                                          "BindPipeline simulate 0",
+                                                          "Dispatch 8 1 1"}));
+    EXPECT_TRUE(m_pRHI->GetValidationErrors().empty());
+    EXPECT_EQ(static_cast<NullBuffer*>(pParticles)->GetTrackedUsage(),
+              RHIBufferUsage::eStorageBuffer);
+
+    ZEN_DELETE(pCmdList);
+    m_pRHI->DestroyPipeline(pPipeline);
+    m_pRHI->DestroyShader(pShader);
+    m_pRHI->DestroyBuffer(pParticles);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST_F(NullRHITest, render_graph_segments_are_finalized_on_the_workers)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    DynamicRHI* pPrevRHI = GDynamicRHI;
+    GDynamicRHI          = m_pRHI;
+
+    RHIBuffer* pStaging  = CreateBuffer("staging", 256);
+    RHIBuffer* pVertices = CreateBuffer("vertices", 256);
+    std::vector<RHIBuffer*> scratch;
+    RenderGraph rdg("rdg_null_rhi_segments");
+    rdg.Begin();
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    rdg.AddBufferClearNode(pStaging, 0, 256);
+    for (uint32_t i = 0; i < RenderGraph::cSplitBarrierMinDistance; i++)
+    {
+        scratch.push_back(CreateBuffer("scratch" + std::to_string(i), 256));
+        rdg.AddBufferClearNode(scratch.back(), 0, 256);
+    }
+    rdg.AddBufferCopyNode(pStaging, pVertices, region);
+    rdg.End();
+    ASSERT_EQ(rdg.GetCompileStats().splitBarrierCount, 1u);
+
+    // the first run moves the resources to the usage every later run starts from
+    for (uint32_t run = 0; run < 2; run++)
+    {
+        m_pRHI->ClearSubmittedRecords();
+        RHICommandList* pCmdList =
+            RHICommandList::Create(m_pRHI->GetCommandContext(RHICommandContextType::eGraphics));
+        rdg.Execute(pCmdList);
+        Submit(pCmdList);
+        ZEN_DELETE(pCmdList);
+    }
+    const std::vector<std::string> expected = SubmittedTexts();
+    ASSERT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eWaitBarrierEvent), 1u);
+
+    // each list is replayed by the job that recorded it, so the split barrier that crosses
+    // the lists becomes a plain one and the lists are checked in submission order
+    JobSystem jobSystem(2);
+    const uint32_t numSegments = 3;
+    HeapVector<RHICommandList*> cmdLists;
+    for (uint32_t i = 0; i < numSegments; i++)
+    {
+        cmdLists.push_back(
+            RHICommandList::Create(m_pRHI->GetCommandContext(RHICommandContextType::eGraphics)));
+    }
+    HeapVector<RHIPlatformCommandList*> platformCmdLists;
+    m_pRHI->ClearSubmittedRecords();
+    rdg.Execute(MakeVecView(cmdLists), &jobSystem, &platformCmdLists);
+    ASSERT_EQ(platformCmdLists.size(), numSegments);
+    m_pRHI->SubmitPlatformCommandLists(MakeVecView(platformCmdLists));
+
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eSetBarrierEvent), 0u);
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eWaitBarrierEvent), 0u);
+    std::vector<std::string> work;
+    std::vector<std::string> expectedWork;
+    for (const std::string& text : SubmittedTexts())
+    {
+        if (text.rfind("Transitions", 0) != 0)
+        {
+            work.push_back(text);
+        }
+    }
+    for (const std::string& text : expected)
+    {
+        if (text.rfind("Transitions", 0) != 0 && text.find("BarrierEvent") == std::string::npos)
+        {
+            expectedWork.push_back(text);
+        }
+    }
+    EXPECT_EQ(work, expectedWork);
+    EXPECT_TRUE(m_pRHI->GetValidationErrors().empty());
+    EXPECT_EQ(static_cast<NullBuffer*>(pStaging)->GetTrackedUsage(),
+              RHIBufferUsage::eTransferSrc);
+
+    for (RHICommandList* pCmdList : cmdLists)
+    {
+        ZEN_DELETE(pCmdList);
+    }
+    for (RHIBuffer* pBuffer : scratch)
+    {
+        m_pRHI->DestroyBuffer(pBuffer);
+    }
+    m_pRHI->DestroyBuffer(pVertices);
+    m_pRHI->DestroyBuffer(pStaging);
+    GDynamicRHI = pPrevRHI;
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
@@ -0,0 +1,117 @@
+#include "Graphics/VulkanRHI/VulkanPipelineCache.h"
+#include <gtest/gtest.h>
+#include <cstring>
+
+using namespace zen;
+
+static VkPhysicalDeviceProperties MakeDeviceProperties()
+{
+    VkPhysicalDeviceProperties properties{};
+    properties.vendorID      = 0x10005;
+    properties.deviceID      = 0x0001;
+    properties.driverVersion = 42;
+    for (uint32_t i = 0; i < VK_UUID_SIZE; i++)
+    {
+        properties.pipelineCacheUUID[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    return properties;
+}
+
+// what vkGetPipelineCacheData returns: VkPipelineCacheHeaderVersionOne followed by driver data
+static std::vector<uint8_t> MakeDriverData(const VkPhysicalDeviceProperties& properties,
+                                           size_t payloadSize)
+{
+    VkPipelineCacheHeaderVersionOne header{};
+    header.headerSize    = sizeof(VkPipelineCacheHeaderVersionOne);
+    header.headerVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+    header.vendorID      = properties.vendorID;
+    header.deviceID      = properties.deviceID;
+    std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    std::vector<uint8_t> data(sizeof(header) + payloadSize);
+    std::memcpy(data.data(), &header, sizeof(header));
+    for (size_t i = sizeof(header); i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 31);
+    }
+    return data;
+}
+
+TEST(pipeline_cache, round_trip)
+{
+    const VkPhysicalDeviceProperties properties = MakeDeviceProperties();
+    const std::vector<uint8_t> driverData       = MakeDriverData(properties, 1000);
+    const std::vector<uint8_t> file =
+        VulkanPipelineCache::PackCacheFile(properties, driverData.data(), driverData.size());
+
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(VulkanPipelineCache::UnpackCacheFile(properties, file.data(), file.size(), data));
+    EXPECT_EQ(data, driverData);
+}
+
+TEST(pipeline_cache, rejects_other_device)
+{
+    const VkPhysicalDeviceProperties properties = MakeDeviceProperties();
+    const std::vector<uint8_t> driverData       = MakeDriverData(properties, 256);
+    const std::vector<uint8_t> file =
+        VulkanPipelineCache::PackCacheFile(properties, driverData.data(), driverData.size());
+
+    std::vector<uint8_t> data;
+    VkPhysicalDeviceProperties other = properties;
+    other.vendorID++;
+    EXPECT_FALSE(VulkanPipelineCache::UnpackCacheFile(other, file.data(), file.size(), data));
+    other = properties;
+    other.deviceID++;
+    EXPECT_FALSE(VulkanPipelineCache::UnpackCacheFile(other, file.data(), file.size(), data));
+    other = properties;
+    other.driverVersion++;
+    EXPECT_FALSE(VulkanPipelineCache::UnpackCacheFile(other, file.data(), file.size(), data));
+    other = properties;
+    other.pipelineCacheUUID[VK_UUID_SIZE - 1] ^= 0xFF;
+    EXPECT_FALSE(VulkanPipelineCache::UnpackCacheFile(other, file.data(), file.size(), data));
+    EXPECT_TRUE(data.empty());
+}
+
+TEST(pipeline_cache, rejects_corrupted_file)
+{
+    const VkPhysicalDeviceProperties properties = MakeDeviceProperties();
+    const std::vector<uint8_t> driverData       = MakeDriverData(properties, 512);
+    const std::vector<uint8_t> file =
+        VulkanPipelineCache::PackCacheFile(properties, driverData.data(), driverData.size());
+
+    std::vector<uint8_t> data;
+    // truncated anywhere, including inside the header
+    for (size_t size : {size_t(0), size_t(16), file.size() / 2, file.size() - 1})
+    {
+        EXPECT_FALSE(VulkanPipelineCache::UnpackCacheFile(properties, file.data(), size, data));
+    }
+    // any flipped byte
+    for (size_t i = 0; i < file.size(); i += 13)
+    {
+        std::vector<uint8_t> corrupted = file;
+        corrupted[i] ^= 0x5A;
+        EXPECT_FALSE(VulkanPipelineCache::UnpackCacheFile(properties, corrupted.data(),
+                                                          corrupted.size(), data))
+            << "byte " << i;
+    }
+    EXPECT_TRUE(data.empty());
+}
+
+TEST(pipeline_cache, rejects_mismatching_driver_header)
+{
+    const VkPhysicalDeviceProperties properties = MakeDeviceProperties();
+    std::vector<uint8_t> data;
+
+    // the outer header matches but the driver data was produced for another device
+    VkPhysicalDeviceProperties other = properties;
+    other.deviceID++;
+    std::vector<uint8_t> driverData = MakeDriverData(other, 128);
+    std::vector<uint8_t> file =
+        VulkanPipelineCache::PackCacheFile(properties, driverData.data(), driverData.size());
+    EXPECT_FALSE(VulkanPipelineCache::UnpackCacheFile(properties, file.data(), file.size(), data));
+
+    // shorter than VkPipelineCacheHeaderVersionOne
+    driverData.resize(sizeof(VkPipelineCacheHeaderVersionOne) - 4);
+    file = VulkanPipelineCache::PackCacheFile(properties, driverData.data(), driverData.size());
+    EXPECT_FALSE(VulkanPipelineCache::UnpackCacheFile(properties, file.data(), file.size(), data));
+}
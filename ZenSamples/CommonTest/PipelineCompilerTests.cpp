@@ -0,0 +1,235 @@
+#include "Graphics/NullRHI/NullRHI.h"
+#include "Graphics/NullRHI/NullResources.h"
+#include "Graphics/RHI/DynamicRHI.h"
+#include "Graphics/RenderCore/V2/PipelineCompiler.h"
+#include "Graphics/RenderCore/V2/RenderDevice.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <unordered_set>
+
+using namespace zen;
+
+// Needs a Vulkan device, e.g. lavapipe through VK_ICD_FILENAMES
+TEST(pipeline_compiler, concurrent_requests_are_deduplicated)
+{
+    constexpr uint32_t cNumPipelines = 384;
+    constexpr uint32_t cNumThreads   = 8;
+
+    DynamicRHI* pRHI = DynamicRHI::Create(RHIAPIType::eVulkan);
+
+    RHIShaderCreateInfo shaderCI{};
+    shaderCI.spirvFileName[ToUnderlying(RHIShaderStage::eVertex)]   = "triangle.vert.spv";
+    shaderCI.spirvFileName[ToUnderlying(RHIShaderStage::eFragment)] = "triangle_fixed.frag.spv";
+    shaderCI.stageFlags.SetFlags(RHIShaderStageFlagBits::eVertex,
+                                 RHIShaderStageFlagBits::eFragment);
+    shaderCI.name      = "pipeline_compiler_test";
+    RHIShader* pShader = pRHI->CreateShader(shaderCI);
+
+    RHIRenderingLayout layout{};
+    layout.numColorRenderTargets           = 1;
+    layout.colorRenderTargets[0].format    = DataFormat::eR8G8B8A8UNORM;
+    layout.hasDepthStencilRT               = true;
+    layout.depthStencilRenderTarget.format = DataFormat::eD32SFloat;
+
+    // every pipeline differs in its depth bias, the cull mode adds some variety for the driver
+    std::vector<RHIGfxPipelineCreateInfo> createInfos(cNumPipelines);
+    std::vector<size_t> hashes(cNumPipelines);
+    const HashMap<uint32_t, int> specConstants;
+    std::vector<uint32_t> desc;
+    for (uint32_t i = 0; i < cNumPipelines; i++)
+    {
+        RHIGfxPipelineStates pso{};
+        pso.rasterizationState.cullMode                = static_cast<RHIPolygonCullMode>(i % 3);
+        pso.rasterizationState.enableDepthBias         = true;
+        pso.rasterizationState.depthBiasConstantFactor = static_cast<float>(i);
+        pso.depthStencilState                          = RHIGfxPipelineDepthStencilState::Create(
+            true, true, RHIDepthCompareOperator::eLessOrEqual);
+        pso.colorBlendState.AddAttachment();
+        pso.dynamicStates.Enable(RHIDynamicState::eViewPort, RHIDynamicState::eScissor);
+
+        createInfos[i].pShader          = pShader;
+        createInfos[i].states           = pso;
+        createInfos[i].pRenderingLayout = &layout;
+        createInfos[i].subpassIdx       = 0;
+
+        rc::RenderDevice::BuildGfxPipelineDesc(pso, pShader->GetHash32(), &layout, specConstants,
+                                               desc);
+        hashes[i] = rc::RenderDevice::CalcPipelineHash(desc);
+    }
+
+    std::vector<rc::PipelineCompiler::CompiledPipeline> compiled;
+    std::vector<std::vector<RHIPipeline*>> targets(cNumThreads,
+                                                   std::vector<RHIPipeline*>(cNumPipelines));
+    {
+        rc::PipelineCompiler compiler(4);
+
+        // every thread asks for every pipeline, starting at a different offset
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < cNumThreads; t++)
+        {
+            threads.emplace_back([&, t]() {
+                for (uint32_t n = 0; n < cNumPipelines; n++)
+                {
+                    const uint32_t i = (n + t * cNumPipelines / cNumThreads) % cNumPipelines;
+                    EXPECT_EQ(compiler.RequestGfxPipeline(hashes[i], createInfos[i],
+                                                          &targets[t][i]),
+                              nullptr);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        compiler.WaitIdle();
+        EXPECT_EQ(compiler.GetNumPending(), 0u);
+        EXPECT_EQ(compiler.GetNumRequested(), cNumPipelines);
+
+        compiler.PublishCompleted(compiled);
+        ASSERT_EQ(compiled.size(), cNumPipelines);
+
+        // published pipelines are returned right away
+        EXPECT_NE(compiler.RequestGfxPipeline(hashes[0], createInfos[0]), nullptr);
+    }
+
+    HashMap<size_t, RHIPipeline*> pipelines;
+    std::unordered_set<RHIPipeline*> uniquePipelines;
+    for (const auto& entry : compiled)
+    {
+        ASSERT_NE(entry.pPipeline, nullptr);
+        pipelines[entry.hash] = entry.pPipeline;
+        uniquePipelines.insert(entry.pPipeline);
+    }
+    EXPECT_EQ(pipelines.size(), cNumPipelines);
+    EXPECT_EQ(uniquePipelines.size(), cNumPipelines);
+
+    // all requesters of one hash got the same pipeline
+    for (uint32_t t = 0; t < cNumThreads; t++)
+    {
+        for (uint32_t i = 0; i < cNumPipelines; i++)
+        {
+            EXPECT_EQ(targets[t][i], pipelines[hashes[i]]);
+        }
+    }
+
+    for (RHIPipeline* pPipeline : uniquePipelines)
+    {
+        pRHI->DestroyPipeline(pPipeline);
+    }
+    pRHI->DestroyShader(pShader);
+    pRHI->Destroy();
+}
+
+// the tests below compile through the NullRHI and run without a device
+static RHIGfxPipelineCreateInfo MakeNullPipelineInfo(RHIShader* pShader,
+                                                     const RHIRenderingLayout* pLayout,
+                                                     uint32_t index)
+{
+    RHIGfxPipelineCreateInfo createInfo{};
+    createInfo.pShader                                           = pShader;
+    createInfo.states.rasterizationState.depthBiasConstantFactor = static_cast<float>(index);
+    createInfo.pRenderingLayout                                  = pLayout;
+    createInfo.subpassIdx                                        = 0;
+    return createInfo;
+}
+
+TEST(pipeline_compiler, rendering_layout_is_copied_into_the_request)
+{
+    NullRHI* pRHI        = ZEN_NEW() NullRHI();
+    DynamicRHI* pPrevRHI = GDynamicRHI;
+    GDynamicRHI          = pRHI;
+    pRHI->Init();
+
+    RHIShaderCreateInfo shaderCI{};
+    shaderCI.name      = "pipeline_compiler_null";
+    RHIShader* pShader = pRHI->CreateShader(shaderCI);
+
+    RHIRenderingLayout layout{};
+    layout.numColorRenderTargets        = 1;
+    layout.colorRenderTargets[0].format = DataFormat::eR8G8B8A8UNORM;
+
+    std::vector<rc::PipelineCompiler::CompiledPipeline> compiled;
+    {
+        rc::PipelineCompiler compiler(2);
+        compiler.RequestGfxPipeline(1, MakeNullPipelineInfo(pShader, &layout, 0));
+        // a resize rewrites the renderer's layout while the worker may still be compiling
+        layout.numColorRenderTargets        = 2;
+        layout.colorRenderTargets[0].format = DataFormat::eR16G16B16A16SFloat;
+        compiler.Wait(1);
+        compiler.PublishCompleted(compiled);
+        ASSERT_EQ(compiled.size(), 1u);
+
+        const auto* pPipeline = static_cast<const NullPipeline*>(compiled[0].pPipeline);
+        ASSERT_NE(pPipeline->GetRenderingLayout(), nullptr);
+        EXPECT_NE(pPipeline->GetRenderingLayout(), &layout);
+        EXPECT_EQ(pPipeline->GetRenderingLayout()->numColorRenderTargets, 1u);
+        EXPECT_EQ(pPipeline->GetRenderingLayout()->colorRenderTargets[0].format,
+                  DataFormat::eR8G8B8A8UNORM);
+    }
+
+    pRHI->DestroyPipeline(compiled[0].pPipeline);
+    pRHI->DestroyShader(pShader);
+    EXPECT_TRUE(pRHI->GetValidationErrors().empty());
+    pRHI->Destroy();
+    ZEN_DELETE(pRHI);
+    GDynamicRHI = pPrevRHI;
+}
+
+TEST(pipeline_compiler, wait_returns_once_the_requested_pipeline_is_compiled)
+{
+    constexpr uint32_t cNumPipelines = 256;
+
+    NullRHI* pRHI        = ZEN_NEW() NullRHI();
+    DynamicRHI* pPrevRHI = GDynamicRHI;
+    GDynamicRHI          = pRHI;
+    pRHI->Init();
+
+    RHIShaderCreateInfo shaderCI{};
+    shaderCI.name      = "pipeline_compiler_null";
+    RHIShader* pShader = pRHI->CreateShader(shaderCI);
+
+    RHIRenderingLayout layout{};
+    layout.numColorRenderTargets        = 1;
+    layout.colorRenderTargets[0].format = DataFormat::eR8G8B8A8UNORM;
+
+    std::vector<rc::PipelineCompiler::CompiledPipeline> compiled;
+    {
+        rc::PipelineCompiler compiler(2);
+        // unknown hashes do not block
+        compiler.Wait(cNumPipelines + 1);
+
+        for (uint32_t i = 0; i < cNumPipelines; i++)
+        {
+            compiler.RequestGfxPipeline(i + 1, MakeNullPipelineInfo(pShader, &layout, i));
+        }
+
+        // the last request is queued behind all the others
+        compiler.Wait(cNumPipelines);
+        compiler.PublishCompleted(compiled);
+        const bool found =
+            std::any_of(compiled.begin(), compiled.end(), [](const auto& entry) {
+                return entry.hash == cNumPipelines && entry.pPipeline != nullptr;
+            });
+        EXPECT_TRUE(found);
+        EXPECT_NE(compiler.RequestGfxPipeline(cNumPipelines,
+                                              MakeNullPipelineInfo(pShader, &layout, 0)),
+                  nullptr);
+
+        compiler.WaitIdle();
+        EXPECT_EQ(compiler.GetNumPending(), 0u);
+        compiler.PublishCompleted(compiled);
+        EXPECT_EQ(compiled.size(), cNumPipelines);
+    }
+
+    for (const auto& entry : compiled)
+    {
+        pRHI->DestroyPipeline(entry.pPipeline);
+    }
+    pRHI->DestroyShader(pShader);
+    EXPECT_TRUE(pRHI->GetValidationErrors().empty());
+    pRHI->Destroy();
+    ZEN_DELETE(pRHI);
+    GDynamicRHI = pPrevRHI;
+}
@@ -0,0 +1,265 @@
+#include "Graphics/RenderCore/V2/RenderDevice.h"
+#include <gtest/gtest.h>
+#include <functional>
+
+using namespace zen;
+using namespace zen::rc;
+
+namespace
+{
+constexpr uint32_t cShaderHash = 0x1234ABCD;
+
+struct PipelineInputs
+{
+    RHIGfxPipelineStates pso;
+    RHIRenderingLayout layout;
+    HashMap<uint32_t, int> specConstants;
+    uint32_t shaderHash{cShaderHash};
+};
+
+// g-buffer like setup: 2 color targets, depth, a few dynamic states
+PipelineInputs MakeBaseInputs()
+{
+    PipelineInputs inputs;
+    inputs.pso.primitiveType               = RHIDrawPrimitiveType::eTriangleList;
+    inputs.pso.rasterizationState.cullMode = RHIPolygonCullMode::eBack;
+    inputs.pso.depthStencilState           = RHIGfxPipelineDepthStencilState::Create(
+        true, true, RHIDepthCompareOperator::eLessOrEqual);
+    inputs.pso.colorBlendState.AddAttachments(2);
+    inputs.pso.dynamicStates.Enable(RHIDynamicState::eViewPort, RHIDynamicState::eScissor);
+
+    inputs.layout.numColorRenderTargets           = 2;
+    inputs.layout.colorRenderTargets[0].format    = DataFormat::eR8G8B8A8UNORM;
+    inputs.layout.colorRenderTargets[1].format    = DataFormat::eR16G16B16A16SFloat;
+    inputs.layout.hasDepthStencilRT               = true;
+    inputs.layout.depthStencilRenderTarget.format = DataFormat::eD32SFloat;
+
+    inputs.specConstants[0] = 1;
+    inputs.specConstants[1] = 4;
+    return inputs;
+}
+
+std::vector<uint32_t> BuildDesc(const PipelineInputs& inputs)
+{
+    std::vector<uint32_t> desc;
+    RenderDevice::BuildGfxPipelineDesc(inputs.pso, inputs.shaderHash, &inputs.layout,
+                                       inputs.specConstants, desc);
+    return desc;
+}
+
+struct StateFlip
+{
+    const char* name;
+    std::function<void(PipelineInputs&)> apply;
+};
+
+std::vector<StateFlip> MakeStateFlips()
+{
+    using Attachment = RHIGfxPipelineColorBlendState::Attachment;
+    auto attachment  = [](PipelineInputs& in) -> Attachment& {
+        return in.pso.colorBlendState.attachments[1];
+    };
+
+    return {
+        {"shaderHash", [](PipelineInputs& in) { in.shaderHash ^= 1u; }},
+        {"primitiveType",
+         [](PipelineInputs& in) { in.pso.primitiveType = RHIDrawPrimitiveType::eLineList; }},
+        // rasterization
+        {"enableDepthClamp",
+         [](PipelineInputs& in) { in.pso.rasterizationState.enableDepthClamp = true; }},
+        {"discardPrimitives",
+         [](PipelineInputs& in) { in.pso.rasterizationState.discardPrimitives = true; }},
+        {"wireframe", [](PipelineInputs& in) { in.pso.rasterizationState.wireframe = true; }},
+        {"cullMode",
+         [](PipelineInputs& in) {
+             in.pso.rasterizationState.cullMode = RHIPolygonCullMode::eFront;
+         }},
+        {"frontFace",
+         [](PipelineInputs& in) {
+             in.pso.rasterizationState.frontFace = RHIPolygonFrontFace::eClockWise;
+         }},
+        {"enableDepthBias",
+         [](PipelineInputs& in) { in.pso.rasterizationState.enableDepthBias = true; }},
+        {"depthBiasConstantFactor",
+         [](PipelineInputs& in) { in.pso.rasterizationState.depthBiasConstantFactor = 1.25f; }},
+        {"depthBiasClamp",
+         [](PipelineInputs& in) { in.pso.rasterizationState.depthBiasClamp = 0.5f; }},
+        {"depthBiasSlopeFactor",
+         [](PipelineInputs& in) { in.pso.rasterizationState.depthBiasSlopeFactor = 1.75f; }},
+        {"lineWidth", [](PipelineInputs& in) { in.pso.rasterizationState.lineWidth = 2.0f; }},
+        // multisample
+        {"sampleCount",
+         [](PipelineInputs& in) { in.pso.multiSampleState.sampleCount = SampleCount::e4; }},
+        {"enableSampleShading",
+         [](PipelineInputs& in) { in.pso.multiSampleState.enableSampleShading = true; }},
+        {"minSampleShading",
+         [](PipelineInputs& in) { in.pso.multiSampleState.minSampleShading = 0.5f; }},
+        {"enableAlphaToCoverage",
+         [](PipelineInputs& in) { in.pso.multiSampleState.enableAlphaToCoverage = true; }},
+        {"enableAlphaToOne",
+         [](PipelineInputs& in) { in.pso.multiSampleState.enableAlphaToOne = true; }},
+        {"sampleMasks", [](PipelineInputs& in) { in.pso.multiSampleState.sampleMasks ^= 2u; }},
+        // depth stencil
+        {"enableDepthTest",
+         [](PipelineInputs& in) { in.pso.depthStencilState.enableDepthTest = false; }},
+        {"enableDepthWrite",
+         [](PipelineInputs& in) { in.pso.depthStencilState.enableDepthWrite = false; }},
+        {"depthCompareOp",
+         [](PipelineInputs& in) {
+             in.pso.depthStencilState.depthCompareOp = RHIDepthCompareOperator::eGreater;
+         }},
+        {"enableDepthBoundsTest",
+         [](PipelineInputs& in) { in.pso.depthStencilState.enableDepthBoundsTest = true; }},
+        {"enableStencilTest",
+         [](PipelineInputs& in) { in.pso.depthStencilState.enableStencilTest = true; }},
+        {"frontOp.fail",
+         [](PipelineInputs& in) { in.pso.depthStencilState.frontOp.fail = RHIStencilOp::eZero; }},
+        {"frontOp.pass",
+         [](PipelineInputs& in) { in.pso.depthStencilState.frontOp.pass = RHIStencilOp::eZero; }},
+        {"frontOp.depthFail",
+         [](PipelineInputs& in) {
+             in.pso.depthStencilState.frontOp.depthFail = RHIStencilOp::eZero;
+         }},
+        {"frontOp.compare",
+         [](PipelineInputs& in) {
+             in.pso.depthStencilState.frontOp.compare = RHIDepthCompareOperator::eNever;
+         }},
+        {"frontOp.compareMask",
+         [](PipelineInputs& in) { in.pso.depthStencilState.frontOp.compareMask = 0xFF; }},
+        {"frontOp.writeMask",
+         [](PipelineInputs& in) { in.pso.depthStencilState.frontOp.writeMask = 0xFF; }},
+        {"frontOp.reference",
+         [](PipelineInputs& in) { in.pso.depthStencilState.frontOp.reference = 1; }},
+        {"backOp.fail",
+         [](PipelineInputs& in) { in.pso.depthStencilState.backOp.fail = RHIStencilOp::eZero; }},
+        {"backOp.reference",
+         [](PipelineInputs& in) { in.pso.depthStencilState.backOp.reference = 1; }},
+        {"minDepthBounds",
+         [](PipelineInputs& in) { in.pso.depthStencilState.minDepthBounds = 0.25f; }},
+        {"maxDepthBounds",
+         [](PipelineInputs& in) { in.pso.depthStencilState.maxDepthBounds = 0.75f; }},
+        // color blend
+        {"enableLogicOp",
+         [](PipelineInputs& in) { in.pso.colorBlendState.enableLogicOp = true; }},
+        {"logicOp",
+         [](PipelineInputs& in) { in.pso.colorBlendState.logicOp = RHIBlendLogicOp::eAnd; }},
+        {"attachmentCount", [](PipelineInputs& in) { in.pso.colorBlendState.AddAttachment(); }},
+        {"enableBlend", [=](PipelineInputs& in) { attachment(in).enableBlend = true; }},
+        {"srcColorBlendFactor",
+         [=](PipelineInputs& in) { attachment(in).srcColorBlendFactor = RHIBlendFactor::eOne; }},
+        {"dstColorBlendFactor",
+         [=](PipelineInputs& in) { attachment(in).dstColorBlendFactor = RHIBlendFactor::eOne; }},
+        {"colorBlendOp",
+         [=](PipelineInputs& in) { attachment(in).colorBlendOp = RHIBlendOp::eSubstract; }},
+        {"srcAlphaBlendFactor",
+         [=](PipelineInputs& in) { attachment(in).srcAlphaBlendFactor = RHIBlendFactor::eOne; }},
+        {"dstAlphaBlendFactor",
+         [=](PipelineInputs& in) { attachment(in).dstAlphaBlendFactor = RHIBlendFactor::eOne; }},
+        {"alphaBlendOp",
+         [=](PipelineInputs& in) { attachment(in).alphaBlendOp = RHIBlendOp::eSubstract; }},
+        {"colorWriteMask",
+         [=](PipelineInputs& in) {
+             attachment(in).colorWriteMask.ClearFlag(RHIColorComponent::eAlpha);
+         }},
+        {"blendConstants.r",
+         [](PipelineInputs& in) { in.pso.colorBlendState.blendConstants.r = 1.0f; }},
+        {"blendConstants.a",
+         [](PipelineInputs& in) { in.pso.colorBlendState.blendConstants.a = 0.5f; }},
+        // dynamic states
+        {"dynamicStates",
+         [](PipelineInputs& in) { in.pso.dynamicStates.Enable(RHIDynamicState::eDepthBias); }},
+        // rendering layout
+        {"numLayers", [](PipelineInputs& in) { in.layout.numLayers = 6; }},
+        {"colorFormat",
+         [](PipelineInputs& in) {
+             in.layout.colorRenderTargets[1].format = DataFormat::eR8G8B8A8UNORM;
+         }},
+        {"colorSamples",
+         [](PipelineInputs& in) { in.layout.colorRenderTargets[0].numSamples = SampleCount::e4; }},
+        {"numColorRenderTargets", [](PipelineInputs& in) { in.layout.numColorRenderTargets = 1; }},
+        {"hasDepthStencilRT", [](PipelineInputs& in) { in.layout.hasDepthStencilRT = false; }},
+        {"depthFormat",
+         [](PipelineInputs& in) {
+             in.layout.depthStencilRenderTarget.format = DataFormat::eD32SFloatS8UInt;
+         }},
+        // specialization constants
+        {"specConstantValue", [](PipelineInputs& in) { in.specConstants[1] = 8; }},
+        {"specConstantAdded", [](PipelineInputs& in) { in.specConstants[2] = 0; }},
+    };
+}
+} // namespace
+
+TEST(pipeline_state_hash, equal_states_equal_hash)
+{
+    const PipelineInputs a = MakeBaseInputs();
+    const PipelineInputs b = MakeBaseInputs();
+    const auto descA       = BuildDesc(a);
+    const auto descB       = BuildDesc(b);
+    EXPECT_EQ(descA, descB);
+    EXPECT_EQ(RenderDevice::CalcPipelineHash(descA), RenderDevice::CalcPipelineHash(descB));
+}
+
+TEST(pipeline_state_hash, each_state_flip_is_distinct)
+{
+    const auto baseDesc = BuildDesc(MakeBaseInputs());
+    const auto flips    = MakeStateFlips();
+
+    std::vector<std::vector<uint32_t>> descs;
+    std::vector<size_t> hashes;
+    for (const StateFlip& flip : flips)
+    {
+        PipelineInputs inputs = MakeBaseInputs();
+        flip.apply(inputs);
+        descs.push_back(BuildDesc(inputs));
+        hashes.push_back(RenderDevice::CalcPipelineHash(descs.back()));
+        EXPECT_NE(descs.back(), baseDesc) << flip.name;
+        EXPECT_NE(hashes.back(), RenderDevice::CalcPipelineHash(baseDesc)) << flip.name;
+    }
+
+    for (size_t i = 0; i < flips.size(); i++)
+    {
+        for (size_t j = i + 1; j < flips.size(); j++)
+        {
+            EXPECT_NE(hashes[i], hashes[j]) << flips[i].name << " vs " << flips[j].name;
+        }
+    }
+}
+
+TEST(pipeline_state_hash, spec_constant_order_independent)
+{
+    PipelineInputs a = MakeBaseInputs();
+    a.specConstants.clear();
+    PipelineInputs b = a;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        a.specConstants[i] = static_cast<int>(i * 3);
+    }
+    for (uint32_t i = 16; i-- > 0;)
+    {
+        b.specConstants[i] = static_cast<int>(i * 3);
+    }
+    EXPECT_EQ(BuildDesc(a), BuildDesc(b));
+}
+
+TEST(pipeline_state_hash, ignores_unused_attachments_and_load_ops)
+{
+    const auto baseDesc = BuildDesc(MakeBaseInputs());
+
+    // slots past attachmentsMask never reach the driver
+    PipelineInputs unusedSlot = MakeBaseInputs();
+    unusedSlot.pso.colorBlendState.attachments[5].enableBlend = true;
+    EXPECT_EQ(BuildDesc(unusedSlot), baseDesc);
+
+    // render passes differing in load and store ops are compatible
+    PipelineInputs loadOp = MakeBaseInputs();
+    loadOp.layout.colorRenderTargets[0].loadOp = RHIRenderTargetLoadOp::eClear;
+    EXPECT_EQ(BuildDesc(loadOp), baseDesc);
+}
+
+TEST(pipeline_state_hash, compute_differs_from_gfx)
+{
+    std::vector<uint32_t> computeDesc;
+    RenderDevice::BuildComputePipelineDesc(cShaderHash, computeDesc);
+    EXPECT_NE(RenderDevice::CalcPipelineHash(computeDesc),
+              RenderDevice::CalcPipelineHash(BuildDesc(MakeBaseInputs())));
+}
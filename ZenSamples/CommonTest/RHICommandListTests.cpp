@@ -0,0 +1,244 @@
+#include "Graphics/NullRHI/NullRHI.h"
+#include "Graphics/RHI/RHICommandList.h"
+#include "Memory/PoolAllocator.h"
+#include "RenderGraphTestUtils.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace zen;
+
+namespace
+{
+// replays lists into a NullCommandContext, its records are the calls the context received
+class RHICommandListTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_pRHI = ZEN_NEW() NullRHI();
+        m_pRHI->Init();
+
+        m_pSrcBuffer = m_pRHI->CreateBuffer(MakeTestBufferInfo("src"));
+        m_pDstBuffer = m_pRHI->CreateBuffer(MakeTestBufferInfo("dst"));
+        m_pTexture   = m_pRHI->CreateTexture(MakeTestTextureInfo("color"));
+
+        RHIShaderCreateInfo shaderInfo{};
+        shaderInfo.name = "simulate";
+        m_pShader       = m_pRHI->CreateShader(shaderInfo);
+        RHIComputePipelineCreateInfo computeInfo{};
+        computeInfo.pShader = m_pShader;
+        m_pComputePipeline  = m_pRHI->CreatePipeline(computeInfo);
+        m_pOtherPipeline    = m_pRHI->CreatePipeline(computeInfo);
+
+        shaderInfo.name = "forward";
+        m_pGfxShader    = m_pRHI->CreateShader(shaderInfo);
+        RHIGfxPipelineCreateInfo gfxInfo{};
+        gfxInfo.pShader = m_pGfxShader;
+        m_pGfxPipeline  = m_pRHI->CreatePipeline(gfxInfo);
+
+        m_pContext = static_cast<NullCommandContext*>(
+            m_pRHI->GetCommandContext(RHICommandContextType::eGraphics));
+        m_pCmdList = RHICommandList::Create(m_pContext);
+    }
+
+    void TearDown() override
+    {
+        ZEN_DELETE(m_pCmdList);
+        m_pRHI->DestroyPipeline(m_pComputePipeline);
+        m_pRHI->DestroyPipeline(m_pOtherPipeline);
+        m_pRHI->DestroyPipeline(m_pGfxPipeline);
+        m_pRHI->DestroyShader(m_pShader);
+        m_pRHI->DestroyShader(m_pGfxShader);
+        m_pRHI->DestroyTexture(m_pTexture);
+        m_pRHI->DestroyBuffer(m_pSrcBuffer);
+        m_pRHI->DestroyBuffer(m_pDstBuffer);
+        m_pRHI->Destroy();
+        ZEN_DELETE(m_pRHI);
+    }
+
+    std::vector<std::string> Replay()
+    {
+        m_pCmdList->Execute();
+        std::vector<std::string> texts;
+        for (const NullCommandRecord& record : m_pContext->GetRecords())
+        {
+            texts.push_back(record.text);
+        }
+        return texts;
+    }
+
+    NullRHI* m_pRHI{nullptr};
+    NullCommandContext* m_pContext{nullptr};
+    RHICommandList* m_pCmdList{nullptr};
+    RHIBuffer* m_pSrcBuffer{nullptr};
+    RHIBuffer* m_pDstBuffer{nullptr};
+    RHITexture* m_pTexture{nullptr};
+    RHIShader* m_pShader{nullptr};
+    RHIShader* m_pGfxShader{nullptr};
+    RHIPipeline* m_pComputePipeline{nullptr};
+    RHIPipeline* m_pOtherPipeline{nullptr};
+    RHIPipeline* m_pGfxPipeline{nullptr};
+};
+} // namespace
+
+TEST_F(RHICommandListTest, replay_keeps_the_recorded_call_sequence)
+{
+    RHIBufferCopyRegion bufferRegion{};
+    bufferRegion.size = 256;
+    RHIBufferTransition transition{};
+    transition.pBuffer  = m_pDstBuffer;
+    transition.oldUsage = RHIBufferUsage::eTransferDst;
+    transition.newUsage = RHIBufferUsage::eStorageBuffer;
+    const BitField<RHIPipelineStageBits> transferStage(RHIPipelineStageBits::eTransfer);
+    const BitField<RHIPipelineStageBits> computeStage(RHIPipelineStageBits::eComputeShader);
+    uint8_t constants[4] = {1, 2, 3, 4};
+    RHIBarrierEvent event;
+
+    RHIRenderingLayout renderingLayout{};
+    renderingLayout.numColorRenderTargets          = 1;
+    renderingLayout.colorRenderTargets[0].pTexture = m_pTexture;
+    RHIBuffer* vertexBuffers[] = {m_pSrcBuffer, m_pDstBuffer};
+    uint64_t offsets[]         = {0, 64};
+    RHICommandDrawIndexed::Param drawIndexed{};
+    drawIndexed.pIndexBuffer = m_pSrcBuffer;
+    drawIndexed.indexFormat  = DataFormat::eR32UInt;
+    drawIndexed.indexCount   = 6;
+
+    m_pCmdList->ClearBuffer(m_pSrcBuffer, 0, 256);
+    m_pCmdList->CopyBuffer(m_pSrcBuffer, m_pDstBuffer, bufferRegion);
+    m_pCmdList->SetBarrierEvent(&event, transferStage, computeStage,
+                                MakeVecView(&transition, 1), {});
+    m_pCmdList->WaitBarrierEvent(&event);
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, nullptr);
+    m_pCmdList->SetPushConstants(m_pComputePipeline, MakeVecView(constants, 4));
+    m_pCmdList->Dispatch(8, 4, 1);
+    m_pCmdList->DispatchIndirect(m_pDstBuffer, 16);
+    m_pCmdList->AddTextureTransition(m_pTexture, RHITextureLayout::eColorTarget);
+    m_pCmdList->BeginRendering(&renderingLayout);
+    m_pCmdList->SetViewport(0, 0, 64, 64);
+    m_pCmdList->SetScissor(0, 0, 32, 32);
+    m_pCmdList->SetLineWidth(1.0f);
+    m_pCmdList->BindPipeline(RHIPipelineType::eGraphics, m_pGfxPipeline, 0, nullptr);
+    m_pCmdList->BindVertexBuffers(MakeVecView(vertexBuffers, 2), MakeVecView(offsets, 2));
+    m_pCmdList->BindVertexBuffer(m_pSrcBuffer, 128);
+    m_pCmdList->Draw(3, 1, 0, 0);
+    m_pCmdList->DrawIndexed(drawIndexed);
+    m_pCmdList->EndRendering();
+    m_pCmdList->GenerateTextureMipmaps(m_pTexture);
+
+    EXPECT_EQ(m_pCmdList->GetNumCommands(), 20u);
+    EXPECT_EQ(Replay(), (std::vector<std::string>{"ClearBuffer src 0 256",
+                                                  "CopyBuffer src dst 256",
+                                                  "SetBarrierEvent 1 1 0",
+                                                  "WaitBarrierEvent 1",
+                                                  "BindPipeline simulate 0",
+                                                  "SetPushConstants simulate 4",
+                                                  "Dispatch 8 4 1",
+                                                  "DispatchIndirect dst 16",
+                                                  "AddTextureTransition color 2",
+                                                  "BeginRendering color",
+                                                  "SetViewport 0 0 64 64",
+                                                  "SetScissor 0 0 32 32",
+                                                  "SetLineWidth 1.000000",
+                                                  "BindPipeline forward 0",
+                                                  "BindVertexBuffers src dst",
+                                                  "BindVertexBuffers src",
+                                                  "Draw 3 1",
+                                                  "DrawIndexed src 6 0",
+                                                  "EndRendering",
+                                                  "GenTextureMipmaps color"}));
+    EXPECT_TRUE(m_pRHI->GetValidationErrors().empty());
+}
+
+TEST_F(RHICommandListTest, binding_the_bound_pipeline_again_is_skipped)
+{
+    RHIDescriptorSet* sets[2] = {};
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, sets);
+    m_pCmdList->Dispatch(1, 1, 1);
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, sets);
+    m_pCmdList->Dispatch(2, 1, 1);
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pOtherPipeline, 0, sets);
+    m_pCmdList->Dispatch(3, 1, 1);
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, sets);
+    m_pCmdList->Dispatch(4, 1, 1);
+
+    EXPECT_EQ(m_pCmdList->GetNumSkippedCommands(), 1u);
+    EXPECT_EQ(m_pCmdList->GetNumCommands(), 7u);
+    EXPECT_EQ(m_pContext->GetNumRecords(NullCommandType::eBindPipeline), 0u);
+    Replay();
+    EXPECT_EQ(m_pContext->GetNumRecords(NullCommandType::eBindPipeline), 3u);
+    EXPECT_EQ(m_pContext->GetNumRecords(NullCommandType::eDispatch), 4u);
+    EXPECT_TRUE(m_pRHI->GetValidationErrors().empty());
+}
+
+TEST_F(RHICommandListTest, other_descriptor_sets_are_bound_again)
+{
+    // the contents of the set arrays are compared, not their addresses
+    RHIDescriptorSet* pSetA = reinterpret_cast<RHIDescriptorSet*>(uintptr_t(0x100));
+    RHIDescriptorSet* pSetB = reinterpret_cast<RHIDescriptorSet*>(uintptr_t(0x200));
+    RHIDescriptorSet* first[1]  = {pSetA};
+    RHIDescriptorSet* copy[1]   = {pSetA};
+    RHIDescriptorSet* second[1] = {pSetB};
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 1, first);
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 1, copy);
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 1, second);
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, second);
+
+    EXPECT_EQ(m_pCmdList->GetNumCommands(), 3u);
+    EXPECT_EQ(m_pCmdList->GetNumSkippedCommands(), 1u);
+}
+
+TEST_F(RHICommandListTest, repeated_push_constants_are_skipped)
+{
+    uint8_t constants[4] = {1, 2, 3, 4};
+    uint8_t changed[4]   = {1, 2, 3, 5};
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, nullptr);
+    m_pCmdList->SetPushConstants(m_pComputePipeline, MakeVecView(constants, 4));
+    m_pCmdList->Dispatch(1, 1, 1);
+    m_pCmdList->SetPushConstants(m_pComputePipeline, MakeVecView(constants, 4));
+    m_pCmdList->Dispatch(1, 1, 1);
+    m_pCmdList->SetPushConstants(m_pComputePipeline, MakeVecView(changed, 4));
+    m_pCmdList->Dispatch(1, 1, 1);
+    // binding another pipeline drops the constants
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pOtherPipeline, 0, nullptr);
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, nullptr);
+    m_pCmdList->SetPushConstants(m_pComputePipeline, MakeVecView(changed, 4));
+    m_pCmdList->Dispatch(1, 1, 1);
+
+    EXPECT_EQ(m_pCmdList->GetNumSkippedCommands(), 1u);
+    Replay();
+    EXPECT_EQ(m_pContext->GetNumRecords(NullCommandType::eSetPushConstants), 3u);
+    EXPECT_TRUE(m_pRHI->GetValidationErrors().empty());
+}
+
+TEST_F(RHICommandListTest, replay_and_reset_forget_the_bound_state)
+{
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, nullptr);
+    m_pCmdList->Dispatch(1, 1, 1);
+    Replay();
+    // the context starts over once the list is replayed
+    HeapVector<NullCommandRecord> records;
+    m_pContext->TakeRecords(records);
+    m_pCmdList->Reset();
+
+    m_pCmdList->BindPipeline(RHIPipelineType::eCompute, m_pComputePipeline, 0, nullptr);
+    m_pCmdList->Dispatch(1, 1, 1);
+    EXPECT_EQ(m_pCmdList->GetNumSkippedCommands(), 0u);
+    EXPECT_EQ(Replay(), (std::vector<std::string>{"BindPipeline simulate 0", "Dispatch 1 1 1"}));
+    EXPECT_TRUE(m_pRHI->GetValidationErrors().empty());
+}
+
+TEST(pool_allocator, reset_reuses_the_allocators)
+{
+    PoolAllocator<LinearAllocator> allocator(1024);
+    for (uint32_t frame = 0; frame < 4; frame++)
+    {
+        for (uint32_t i = 0; i < 64; i++)
+        {
+            EXPECT_NE(allocator.Alloc(128, 16), nullptr);
+        }
+        allocator.Reset();
+    }
+    // 1 KB, 2 KB, 4 KB and 8 KB pages hold the 8 KB of one frame
+    EXPECT_EQ(allocator.NumAllocators(), 4u);
+}
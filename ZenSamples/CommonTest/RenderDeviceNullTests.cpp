@@ -0,0 +1,206 @@
+#include "AssetLib/FastGLTFLoader.h"
+#include "Graphics/NullRHI/NullRHI.h"
+#include "Graphics/RenderCore/V2/RenderConfig.h"
+#include "Graphics/RenderCore/V2/RenderDevice.h"
+#include "Graphics/RenderCore/V2/RenderScene.h"
+#include "Graphics/RenderCore/V2/Renderer/RendererServer.h"
+#include "Graphics/RenderCore/V2/ShaderProgram.h"
+#include "SceneGraph/Camera.h"
+#include "SceneGraph/Scene.h"
+#include "SyntheticGltf.h"
+#include "TestUtils.h"
+#include <gli/gli.hpp>
+#include <gtest/gtest.h>
+
+using namespace zen;
+using namespace zen::rc;
+
+namespace
+{
+// papermill.ktx is not part of the repository, a small black cubemap is enough for the env
+// texture preprocessing. Returns the path relative to ZEN_TEXTURE_PATH the scene loads it from
+std::string WriteEnvTexture(const std::filesystem::path& dir)
+{
+    std::filesystem::create_directories(dir);
+    gli::texture_cube texture(gli::FORMAT_RGBA16_SFLOAT_PACK16, gli::extent2d(8, 8), 1);
+    texture.clear();
+    const std::filesystem::path path = dir / "env.ktx";
+    gli::save_ktx(texture, path.string());
+    return std::filesystem::relative(path, std::filesystem::path(ZEN_TEXTURE_PATH).parent_path())
+        .string();
+}
+
+// runs RenderDevice, its renderers and the TextureManager on the null RHI with a synthetic
+// glTF scene, the submitted command log of a frame is inspected through the NullRHI
+class RenderDeviceNullTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_prevConfig         = RenderConfig::GetInstance();
+        RenderConfig& config = RenderConfig::GetInstance();
+        // every submesh is drawn, the expected draw counts do not depend on the camera
+        config.frustumCulling  = false;
+        config.offScreenFbSize = 256;
+    }
+
+    void TearDown() override
+    {
+        RenderConfig::GetInstance() = m_prevConfig;
+    }
+
+    void InitDevice(const char* pTestName)
+    {
+        m_renderDevice = MakeUnique<RenderDevice>(RHIAPIType::eNull, 2);
+        m_pRHI         = static_cast<NullRHI*>(GDynamicRHI);
+        m_pViewport    = m_renderDevice->CreateViewport(nullptr, 320, 180, false);
+        ShaderProgramManager::GetInstance().BuildShaderPrograms(m_renderDevice.Get());
+        m_renderDevice->Init(m_pViewport);
+
+        SyntheticGltfDesc desc;
+        desc.numMeshes            = 2;
+        desc.numPrimitivesPerMesh = 2;
+        desc.gridSize             = 8;
+        const std::filesystem::path dir = GetTestDir(pTestName);
+        const auto gltfPath             = WriteSyntheticGltf(dir, desc);
+        m_scene                         = MakeUnique<sg::Scene>();
+        m_loader                        = MakeUnique<asset::FastGLTFLoader>();
+        m_loader->LoadFromFile(gltfPath.string(), m_scene.Get());
+        m_camera = sg::Camera::CreateUnique(Vec3{0.0f, 0.0f, 2.0f}, Vec3{0.0f, 0.0f, 0.0f},
+                                            320.0f / 180.0f);
+
+        SceneData sceneData{};
+        sceneData.pCamera     = m_camera.Get();
+        sceneData.pScene      = m_scene.Get();
+        sceneData.pVertices   = m_loader->GetVertices().data();
+        sceneData.pIndices    = m_loader->GetIndices().data();
+        sceneData.numVertices = m_loader->GetVertices().size();
+        sceneData.numIndices  = m_loader->GetIndices().size();
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            sceneData.lightPositions[i]   = Vec4(1.0f);
+            sceneData.lightColors[i]      = Vec4(1.0f);
+            sceneData.lightIntensities[i] = Vec4(5.0f);
+        }
+        sceneData.envTextureName = WriteEnvTexture(dir);
+
+        m_renderScene = MakeUnique<RenderScene>(m_renderDevice.Get(), sceneData);
+        m_renderScene->Init();
+        m_camera->SetupOnAABB(m_scene->GetAABB());
+        m_renderDevice->GetRendererServer()->SetRenderScene(m_renderScene.Get());
+
+        // the uploads and the env texture preprocessing are submitted while the scene loads
+        m_pRHI->ClearSubmittedRecords();
+        m_pRHI->ClearValidationErrors();
+    }
+
+    // the null RHI is deleted with the device
+    void DestroyDevice()
+    {
+        ShaderProgramManager::GetInstance().Destroy();
+        m_renderScene->Destroy();
+        m_renderDevice->Destroy();
+        m_pRHI = nullptr;
+    }
+
+    // position of the first submitted record containing text, -1 when there is none
+    int FindRecord(const std::string& text) const
+    {
+        const HeapVector<NullCommandRecord>& records = m_pRHI->GetSubmittedRecords();
+        for (uint32_t i = 0; i < records.size(); i++)
+        {
+            if (records[i].text.find(text) != std::string::npos)
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    bool HasRecord(const std::string& text) const
+    {
+        return FindRecord(text) >= 0;
+    }
+
+    void ExpectNoValidationErrors() const
+    {
+        for (const std::string& error : m_pRHI->GetValidationErrors())
+        {
+            ADD_FAILURE() << error;
+        }
+    }
+
+    RenderConfig m_prevConfig;
+    UniquePtr<RenderDevice> m_renderDevice;
+    NullRHI* m_pRHI{nullptr};
+    RHIViewport* m_pViewport{nullptr};
+    UniquePtr<sg::Scene> m_scene;
+    UniquePtr<asset::FastGLTFLoader> m_loader;
+    UniquePtr<sg::Camera> m_camera;
+    UniquePtr<RenderScene> m_renderScene;
+};
+} // namespace
+
+TEST_F(RenderDeviceNullTest, pbr_frame_draws_the_scene_and_presents)
+{
+    InitDevice("pbr_frame_draws_the_scene_and_presents");
+    const uint32_t numItems = m_renderScene->GetBVH().GetNumItems();
+    ASSERT_EQ(numItems, 4u);
+
+    m_renderDevice->GetRendererServer()->DispatchRenderWorkloads();
+
+    const HeapVector<NullCommandRecord>& records = m_pRHI->GetSubmittedRecords();
+    ASSERT_FALSE(records.empty());
+    EXPECT_EQ(records.back().text, "Present viewport_color");
+    // the skybox and the lighting pass render into the back buffer, the G-buffer offscreen
+    EXPECT_TRUE(HasRecord("BeginRendering viewport_color depth viewport_depth"));
+    EXPECT_TRUE(HasRecord("BeginRendering offscreen_position offscreen_normal"));
+    // one draw per submesh, the skybox cube and the full screen lighting triangle
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eDrawIndexed), numItems + 1);
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eDraw), 1u);
+    EXPECT_GT(m_pRHI->GetNumSubmittedRecords(NullCommandType::eTransitions), 0u);
+    EXPECT_GT(m_pRHI->GetNumCreatedResources(RHIResourceType::ePipeline), 0u);
+    ExpectNoValidationErrors();
+
+    // the second frame replays the same graphs
+    m_renderDevice->NextFrame();
+    m_pRHI->ClearSubmittedRecords();
+    m_renderDevice->GetRendererServer()->DispatchRenderWorkloads();
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eDrawIndexed), numItems + 1);
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::ePresent), 1u);
+    ExpectNoValidationErrors();
+
+    DestroyDevice();
+}
+
+TEST_F(RenderDeviceNullTest, gpu_driven_frame_draws_the_scene_indirectly)
+{
+    RenderConfig::GetInstance().gpuDrivenDraws = true;
+    InitDevice("gpu_driven_frame_draws_the_scene_indirectly");
+    // the null RHI supports draw indirect count, BuildShaderPrograms keeps the option
+    ASSERT_TRUE(RenderConfig::GetInstance().gpuDrivenDraws);
+    const uint32_t numItems = m_renderScene->GetBVH().GetNumItems();
+    ASSERT_EQ(numItems, 4u);
+    ASSERT_EQ(m_renderScene->GetNumDrawInstances(), numItems);
+
+    m_renderDevice->GetRendererServer()->DispatchRenderWorkloads();
+
+    // the draw count is cleared and one workgroup culls the instances before the G-buffer draw
+    const std::string drawText =
+        "DrawIndexedIndirectCount OffScreen_draw_commands OffScreen_draw_count " +
+        std::to_string(numItems);
+    const int clear = FindRecord("ClearBuffer OffScreen_draw_count 0 4");
+    const int cull  = FindRecord("Dispatch 1 1 1");
+    const int draw  = FindRecord(drawText);
+    ASSERT_GE(clear, 0);
+    EXPECT_LT(clear, cull);
+    EXPECT_LT(cull, draw);
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eDispatch), 1u);
+    // one indirect draw replaces the submesh draws, the skybox cube is still drawn directly
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eDrawIndexedIndirectCount), 1u);
+    EXPECT_EQ(m_pRHI->GetNumSubmittedRecords(NullCommandType::eDrawIndexed), 1u);
+    EXPECT_EQ(m_pRHI->GetSubmittedRecords().back().text, "Present viewport_color");
+    ExpectNoValidationErrors();
+
+    DestroyDevice();
+}
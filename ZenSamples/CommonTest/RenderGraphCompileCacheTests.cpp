@@ -0,0 +1,185 @@
+#include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "RenderGraphTestUtils.h"
+#include <gtest/gtest.h>
+
+using namespace zen;
+using namespace zen::rc;
+
+namespace
+{
+// the physical resources one frame builds its graph with
+struct FrameResources
+{
+    explicit FrameResources(const std::string& tag) :
+        staging(tag + "_staging"),
+        vertices(tag + "_vertices"),
+        counters(tag + "_counters"),
+        albedo(tag + "_albedo"),
+        albedoCopy(tag + "_albedo_copy")
+    {}
+
+    TestBuffer staging;
+    TestBuffer vertices;
+    TestBuffer counters;
+    TestTexture albedo;
+    TestTexture albedoCopy;
+};
+
+void BuildGraph(RenderGraph& rdg, FrameResources& res, bool clearCounters)
+{
+    rdg.Begin();
+    RHIBufferCopyRegion bufferRegion{};
+    bufferRegion.size = 256;
+    rdg.AddBufferClearNode(&res.staging, 0, 256);
+    rdg.AddBufferCopyNode(&res.staging, &res.vertices, bufferRegion);
+    if (clearCounters)
+    {
+        rdg.AddBufferClearNode(&res.counters, 0, 256);
+    }
+    rdg.AddBufferCopyNode(&res.vertices, &res.counters, bufferRegion);
+
+    rdg.AddTextureClearNode(&res.albedo, Color(), res.albedo.GetSubResourceRange());
+    rdg.AddTextureMipmapGenNode(&res.albedo);
+    RHITextureCopyRegion textureRegion{};
+    rdg.AddTextureCopyNode(&res.albedo, &res.albedoCopy, MakeVecView(&textureRegion, 1));
+    rdg.End();
+}
+
+void ExpectSameRange(const RHITextureSubResourceRange& a, const RHITextureSubResourceRange& b)
+{
+    EXPECT_EQ(static_cast<int64_t>(a.aspect), static_cast<int64_t>(b.aspect));
+    EXPECT_EQ(a.baseMipLevel, b.baseMipLevel);
+    EXPECT_EQ(a.levelCount, b.levelCount);
+    EXPECT_EQ(a.baseArrayLayer, b.baseArrayLayer);
+    EXPECT_EQ(a.layerCount, b.layerCount);
+}
+
+void ExpectSamePlan(const RenderGraph& expected, const RenderGraph& actual)
+{
+    const RDGCompileStats& expectedStats = expected.GetCompileStats();
+    const RDGCompileStats& actualStats   = actual.GetCompileStats();
+    EXPECT_EQ(actualStats.nodeCount, expectedStats.nodeCount);
+    EXPECT_EQ(actualStats.passCount, expectedStats.passCount);
+    EXPECT_EQ(actualStats.resourceCount, expectedStats.resourceCount);
+    EXPECT_EQ(actualStats.barrierCount, expectedStats.barrierCount);
+    EXPECT_EQ(actualStats.commandListCount, expectedStats.commandListCount);
+
+    const HeapVector<RDGCompiledNode>& expectedNodes = expected.GetCompiledNodes();
+    const HeapVector<RDGCompiledNode>& actualNodes   = actual.GetCompiledNodes();
+    ASSERT_EQ(actualNodes.size(), expectedNodes.size());
+    for (uint32_t i = 0; i < expectedNodes.size(); i++)
+    {
+        SCOPED_TRACE(i);
+        const RDGCompiledNode& e = expectedNodes[i];
+        const RDGCompiledNode& a = actualNodes[i];
+        EXPECT_EQ(a.nodeId, e.nodeId);
+        EXPECT_EQ(static_cast<int64_t>(a.prologueSrcStages),
+                  static_cast<int64_t>(e.prologueSrcStages));
+        EXPECT_EQ(static_cast<int64_t>(a.prologueDstStages),
+                  static_cast<int64_t>(e.prologueDstStages));
+
+        ASSERT_EQ(a.initialResourceAccesses.size(), e.initialResourceAccesses.size());
+        for (uint32_t j = 0; j < e.initialResourceAccesses.size(); j++)
+        {
+            const RDGAccess& ea = e.initialResourceAccesses[j];
+            const RDGAccess& aa = a.initialResourceAccesses[j];
+            EXPECT_EQ(aa.accessMode, ea.accessMode);
+            EXPECT_EQ(aa.nodeId, ea.nodeId);
+            EXPECT_EQ(aa.resourceId, ea.resourceId);
+            EXPECT_EQ(aa.bufferUsage, ea.bufferUsage);
+            EXPECT_EQ(aa.textureUsage, ea.textureUsage);
+            ExpectSameRange(aa.textureSubResourceRange, ea.textureSubResourceRange);
+        }
+
+        ASSERT_EQ(a.prologueBufferTransitions.size(), e.prologueBufferTransitions.size());
+        for (uint32_t j = 0; j < e.prologueBufferTransitions.size(); j++)
+        {
+            const RHIBufferTransition& et = e.prologueBufferTransitions[j];
+            const RHIBufferTransition& at = a.prologueBufferTransitions[j];
+            EXPECT_EQ(at.pBuffer, et.pBuffer);
+            EXPECT_EQ(at.oldAccessMode, et.oldAccessMode);
+            EXPECT_EQ(at.newAccessMode, et.newAccessMode);
+            EXPECT_EQ(at.oldUsage, et.oldUsage);
+            EXPECT_EQ(at.newUsage, et.newUsage);
+        }
+
+        ASSERT_EQ(a.prologueTextureTransitions.size(), e.prologueTextureTransitions.size());
+        for (uint32_t j = 0; j < e.prologueTextureTransitions.size(); j++)
+        {
+            const RHITextureTransition& et = e.prologueTextureTransitions[j];
+            const RHITextureTransition& at = a.prologueTextureTransitions[j];
+            EXPECT_EQ(at.pTexture, et.pTexture);
+            EXPECT_EQ(at.oldAccessMode, et.oldAccessMode);
+            EXPECT_EQ(at.newAccessMode, et.newAccessMode);
+            EXPECT_EQ(at.oldUsage, et.oldUsage);
+            EXPECT_EQ(at.newUsage, et.newUsage);
+            ExpectSameRange(at.subResourceRange, et.subResourceRange);
+        }
+    }
+}
+} // namespace
+
+TEST(render_graph_compile_cache, identical_structure_replays_compiled_plan)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    FrameResources frame0("frame0");
+    FrameResources frame1("frame1");
+
+    RenderGraph rdg0("rdg_compile_cache_test");
+    BuildGraph(rdg0, frame0, true);
+    const RDGCompileStats stats0 = rdg0.GetCompileStats();
+    EXPECT_GT(stats0.barrierCount, 0u);
+
+    // next frame, a new graph with other resources but the same structure
+    RenderGraph rdg1("rdg_compile_cache_test");
+    BuildGraph(rdg1, frame1, true);
+    EXPECT_EQ(rdg1.GetCompileStats().cacheHits, stats0.cacheHits + 1);
+    EXPECT_EQ(rdg1.GetCompileStats().cacheMisses, stats0.cacheMisses);
+
+    // the same graph compiled from scratch
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph rdg2("rdg_compile_cache_test");
+    BuildGraph(rdg2, frame1, true);
+    EXPECT_EQ(rdg2.GetCompileStats().cacheMisses, stats0.cacheMisses + 1);
+
+    ExpectSamePlan(rdg2, rdg1);
+
+    // patched transitions never point at the resources of the first frame
+    for (const RDGCompiledNode& compiledNode : rdg1.GetCompiledNodes())
+    {
+        for (const RHIBufferTransition& transition : compiledNode.prologueBufferTransitions)
+        {
+            EXPECT_TRUE(transition.pBuffer == &frame1.staging ||
+                        transition.pBuffer == &frame1.vertices ||
+                        transition.pBuffer == &frame1.counters);
+        }
+        for (const RHITextureTransition& transition : compiledNode.prologueTextureTransitions)
+        {
+            EXPECT_TRUE(transition.pTexture == &frame1.albedo ||
+                        transition.pTexture == &frame1.albedoCopy);
+        }
+    }
+    RenderGraph::ClearCompiledPlanCache();
+}
+
+TEST(render_graph_compile_cache, different_structure_is_compiled)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    FrameResources frame0("frame0");
+    FrameResources frame1("frame1");
+
+    RenderGraph rdg0("rdg_compile_cache_test");
+    BuildGraph(rdg0, frame0, true);
+    const RDGCompileStats stats0 = rdg0.GetCompileStats();
+
+    RenderGraph rdg1("rdg_compile_cache_test");
+    BuildGraph(rdg1, frame1, false);
+    EXPECT_EQ(rdg1.GetCompileStats().cacheHits, stats0.cacheHits);
+    EXPECT_EQ(rdg1.GetCompileStats().cacheMisses, stats0.cacheMisses + 1);
+    EXPECT_EQ(rdg1.GetCompileStats().nodeCount, stats0.nodeCount - 1);
+
+    // a graph instance reused across frames hits as well
+    BuildGraph(rdg1, frame0, false);
+    EXPECT_EQ(rdg1.GetCompileStats().cacheHits, stats0.cacheHits + 1);
+    RenderGraph::ClearCompiledPlanCache();
+}
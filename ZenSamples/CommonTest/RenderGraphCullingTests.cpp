@@ -0,0 +1,200 @@
+#include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "RenderGraphTestUtils.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace zen;
+using namespace zen::rc;
+
+namespace
+{
+// reads pSrc and writes pDst through storage buffer bindings
+ComputePass MakeComputePass(TestBuffer* pSrc, TestBuffer* pDst)
+{
+    ComputePass pass;
+    pass.pPipeline         = nullptr;
+    pass.numDescriptorSets = 1;
+    pass.pShaderProgram    = nullptr;
+    for (RHIDescriptorSet*& pSet : pass.pDescriptorSets)
+    {
+        pSet = nullptr;
+    }
+    PassResourceTracker& src = pass.resourceTrackers[0][0];
+    src.name                 = "src";
+    src.pBuffer              = pSrc;
+    src.resourceType         = PassResourceType::eBuffer;
+    src.accessMode           = RHIAccessMode::eRead;
+    src.bufferUsage          = RHIBufferUsage::eStorageBuffer;
+
+    PassResourceTracker& dst = pass.resourceTrackers[0][1];
+    dst.name                 = "dst";
+    dst.pBuffer              = pDst;
+    dst.resourceType         = PassResourceType::eBuffer;
+    dst.accessMode           = RHIAccessMode::eReadWrite;
+    dst.bufferUsage          = RHIBufferUsage::eStorageBuffer;
+    return pass;
+}
+
+struct GraphResources
+{
+    TestBuffer staging{"staging"};
+    TestBuffer vertices{"vertices"};
+    TestBuffer counters{"counters"};
+    TestTexture albedo{"albedo"};
+    TestTexture albedoCopy{"albedo_copy"};
+};
+
+// node 0-2: a buffer upload chain, node 3-5: a texture chain ending in albedoCopy
+void BuildGraph(RenderGraph& rdg, GraphResources& res, bool exportAlbedoCopy)
+{
+    rdg.Begin();
+    RHIBufferCopyRegion bufferRegion{};
+    bufferRegion.size = 256;
+    rdg.AddBufferClearNode(&res.staging, 0, 256);
+    rdg.AddBufferCopyNode(&res.staging, &res.vertices, bufferRegion);
+    rdg.AddBufferCopyNode(&res.vertices, &res.counters, bufferRegion);
+
+    rdg.AddTextureClearNode(&res.albedo, Color(), res.albedo.GetSubResourceRange());
+    rdg.AddTextureMipmapGenNode(&res.albedo);
+    RHITextureCopyRegion textureRegion{};
+    rdg.AddTextureCopyNode(&res.albedo, &res.albedoCopy, MakeVecView(&textureRegion, 1));
+    if (exportAlbedoCopy)
+    {
+        rdg.ExportTexture(&res.albedoCopy);
+    }
+    rdg.End();
+}
+
+std::vector<int32_t> CompiledNodeIds(const RenderGraph& rdg)
+{
+    std::vector<int32_t> nodeIds;
+    for (const RDGCompiledNode& compiledNode : rdg.GetCompiledNodes())
+    {
+        nodeIds.push_back(compiledNode.nodeId);
+    }
+    return nodeIds;
+}
+} // namespace
+
+TEST(render_graph_culling, graph_without_outputs_keeps_every_node)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    GraphResources res;
+    RenderGraph rdg("rdg_culling_no_outputs");
+    BuildGraph(rdg, res, false);
+
+    EXPECT_EQ(rdg.GetCompiledNodes().size(), 6u);
+    EXPECT_EQ(rdg.GetCompileStats().culledNodeCount, 0u);
+    EXPECT_EQ(rdg.GetCompileStats().culledPassCount, 0u);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_culling, chain_not_reaching_an_output_is_culled)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    GraphResources res;
+    RenderGraph rdg("rdg_culling_unused_chain");
+    BuildGraph(rdg, res, true);
+
+    EXPECT_EQ(CompiledNodeIds(rdg), (std::vector<int32_t>{3, 4, 5}));
+    const RDGCompileStats& stats = rdg.GetCompileStats();
+    EXPECT_EQ(stats.nodeCount, 3u);
+    EXPECT_EQ(stats.culledNodeCount, 3u);
+    EXPECT_EQ(stats.culledPassCount, 0u);
+    // the buffers of the culled chain are neither used nor transitioned
+    EXPECT_FALSE(rdg.GetResourceLifetime(&res.staging).IsValid());
+    EXPECT_FALSE(rdg.GetResourceLifetime(&res.counters).IsValid());
+    EXPECT_TRUE(rdg.GetResourceLifetime(&res.albedo).IsValid());
+    for (const RDGCompiledNode& compiledNode : rdg.GetCompiledNodes())
+    {
+        EXPECT_TRUE(compiledNode.prologueBufferTransitions.empty());
+    }
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_culling, producers_of_live_passes_are_kept)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestBuffer particles("particles");
+    TestBuffer positions("positions");
+    TestBuffer debugLines("debug_lines");
+    TestBuffer debugReadback("debug_readback");
+    ComputePass simulate = MakeComputePass(&particles, &positions);
+    ComputePass debug    = MakeComputePass(&particles, &debugLines);
+
+    RenderGraph rdg("rdg_culling_passes");
+    rdg.Begin();
+    rdg.AddBufferClearNode(&particles, 0, 256);
+    RDGPassNode* pSimulate = rdg.AddComputePassNode(&simulate, "simulate");
+    rdg.AddComputePassDispatchNode(pSimulate, 8, 1, 1);
+    RDGPassNode* pDebug = rdg.AddComputePassNode(&debug, "debug");
+    rdg.AddComputePassDispatchNode(pDebug, 8, 1, 1);
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    rdg.AddBufferCopyNode(&debugLines, &debugReadback, region);
+    rdg.ExportBuffer(&positions);
+    rdg.End();
+
+    // the debug pass and its readback only feed a buffer nobody declared as an output
+    EXPECT_EQ(CompiledNodeIds(rdg), (std::vector<int32_t>{0, 1}));
+    const RDGCompileStats& stats = rdg.GetCompileStats();
+    EXPECT_EQ(stats.passCount, 1u);
+    EXPECT_EQ(stats.culledNodeCount, 2u);
+    EXPECT_EQ(stats.culledPassCount, 1u);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_culling, exported_readback_keeps_the_chain)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestBuffer particles("particles");
+    TestBuffer debugLines("debug_lines");
+    TestBuffer debugReadback("debug_readback");
+    ComputePass debug = MakeComputePass(&particles, &debugLines);
+
+    RenderGraph rdg("rdg_culling_readback");
+    rdg.Begin();
+    rdg.AddBufferClearNode(&particles, 0, 256);
+    RDGPassNode* pDebug = rdg.AddComputePassNode(&debug, "debug");
+    rdg.AddComputePassDispatchNode(pDebug, 8, 1, 1);
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    rdg.AddBufferCopyNode(&debugLines, &debugReadback, region);
+    rdg.ExportBuffer(&debugReadback);
+    rdg.End();
+
+    EXPECT_EQ(CompiledNodeIds(rdg), (std::vector<int32_t>{0, 1, 2}));
+    EXPECT_EQ(rdg.GetCompileStats().culledNodeCount, 0u);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_culling, cached_plan_matches_the_outputs)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    GraphResources res;
+    RenderGraph rdg("rdg_culling_cache");
+    BuildGraph(rdg, res, false);
+    EXPECT_EQ(rdg.GetCompiledNodes().size(), 6u);
+    const uint32_t cacheHits = rdg.GetCompileStats().cacheHits;
+
+    // same nodes and accesses, the export alone must not restore the plan of all six nodes
+    BuildGraph(rdg, res, true);
+    EXPECT_EQ(rdg.GetCompileStats().cacheHits, cacheHits);
+    EXPECT_EQ(CompiledNodeIds(rdg), (std::vector<int32_t>{3, 4, 5}));
+
+    BuildGraph(rdg, res, true);
+    EXPECT_EQ(rdg.GetCompileStats().cacheHits, cacheHits + 1);
+    EXPECT_EQ(CompiledNodeIds(rdg), (std::vector<int32_t>{3, 4, 5}));
+    EXPECT_EQ(rdg.GetCompileStats().culledNodeCount, 3u);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
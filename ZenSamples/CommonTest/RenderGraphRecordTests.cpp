@@ -0,0 +1,564 @@
+#include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "Graphics/RHI/RHICommandList.h"
+#include "RenderGraphTestUtils.h"
+#include "Utils/JobSystem.h"
+#include <gtest/gtest.h>
+#include <deque>
+
+using namespace zen;
+using namespace zen::rc;
+
+namespace
+{
+std::string ToString(const void* pPtr)
+{
+    return std::to_string(reinterpret_cast<uintptr_t>(pPtr));
+}
+
+// writes every replayed call as one line
+class CaptureContext : public IRHICommandContext
+{
+public:
+    explicit CaptureContext(std::vector<std::string>* pLog) : m_pLog(pLog) {}
+
+    RHICommandContextType GetContextType() override
+    {
+        return RHICommandContextType::eGraphics;
+    }
+
+    void RHIBeginRendering(const RHIRenderingLayout* pRenderingLayout) override
+    {
+        Log("BeginRendering " + ToString(pRenderingLayout));
+    }
+
+    void RHIEndRendering() override
+    {
+        Log("EndRendering");
+    }
+
+    void RHISetScissor(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) override
+    {
+        Log("SetScissor " + std::to_string(minX) + " " + std::to_string(minY) + " " +
+            std::to_string(maxX) + " " + std::to_string(maxY));
+    }
+
+    void RHISetViewport(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) override
+    {
+        Log("SetViewport " + std::to_string(minX) + " " + std::to_string(minY) + " " +
+            std::to_string(maxX) + " " + std::to_string(maxY));
+    }
+
+    void RHISetDepthBias(float depthBiasConstantFactor,
+                         float depthBiasClamp,
+                         float depthBiasSlopeFactor) override
+    {
+        Log("SetDepthBias " + std::to_string(depthBiasConstantFactor) + " " +
+            std::to_string(depthBiasClamp) + " " + std::to_string(depthBiasSlopeFactor));
+    }
+
+    void RHISetLineWidth(float lineWidth) override
+    {
+        Log("SetLineWidth " + std::to_string(lineWidth));
+    }
+
+    void RHISetBlendConstants(const Color& blendConstants) override
+    {
+        Log("SetBlendConstants");
+    }
+
+    void RHIBindPipeline(RHIPipeline* pPipeline,
+                         uint32_t numDescriptorSets,
+                         RHIDescriptorSet* const* pDescriptorSets) override
+    {
+        Log("BindPipeline " + ToString(pPipeline) + " " + std::to_string(numDescriptorSets));
+    }
+
+    void RHIBindVertexBuffers(VectorView<RHIBuffer*> pBuffers,
+                              VectorView<uint64_t> offsets) override
+    {
+        Log("BindVertexBuffers " + std::to_string(pBuffers.size()));
+    }
+
+    void RHIBindVertexBuffer(RHIBuffer* pBuffer, uint64_t offset) override
+    {
+        Log("BindVertexBuffer " + ToString(pBuffer));
+    }
+
+    void RHIDraw(uint32_t vertexCount,
+                 uint32_t instanceCount,
+                 uint32_t firstVertex,
+                 uint32_t firstInstance) override
+    {
+        Log("Draw " + std::to_string(vertexCount) + " " + std::to_string(instanceCount));
+    }
+
+    void RHIDrawIndexed(RHIBuffer* pIndexBuffer,
+                        DataFormat indexFormat,
+                        uint32_t indexBufferOffset,
+                        uint32_t indexCount,
+                        uint32_t instanceCount,
+                        uint32_t firstIndex,
+                        int32_t vertexOffset,
+                        uint32_t firstInstance) override
+    {
+        Log("DrawIndexed " + ToString(pIndexBuffer) + " " + std::to_string(indexCount));
+    }
+
+    void RHIDrawIndexedIndirect(RHIBuffer* pIndirectBuffer,
+                                RHIBuffer* pIndexBuffer,
+                                DataFormat indexFormat,
+                                uint32_t indexBufferOffset,
+                                uint32_t offset,
+                                uint32_t drawCount,
+                                uint32_t stride) override
+    {
+        Log("DrawIndexedIndirect " + ToString(pIndirectBuffer) + " " + std::to_string(drawCount));
+    }
+
+    void RHIDrawIndexedIndirectCount(RHIBuffer* pIndirectBuffer,
+                                     RHIBuffer* pIndexBuffer,
+                                     DataFormat indexFormat,
+                                     uint32_t indexBufferOffset,
+                                     uint32_t offset,
+                                     RHIBuffer* pCountBuffer,
+                                     uint32_t countBufferOffset,
+                                     uint32_t maxDrawCount,
+                                     uint32_t stride) override
+    {
+        Log("DrawIndexedIndirectCount " + ToString(pIndirectBuffer) + " " +
+            ToString(pCountBuffer));
+    }
+
+    void RHIDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override
+    {
+        Log("Dispatch " + std::to_string(groupCountX) + " " + std::to_string(groupCountY) + " " +
+            std::to_string(groupCountZ));
+    }
+
+    void RHIDispatchIndirect(RHIBuffer* pIndirectBuffer, uint32_t offset) override
+    {
+        Log("DispatchIndirect " + ToString(pIndirectBuffer) + " " + std::to_string(offset));
+    }
+
+    void RHISetPushConstants(RHIPipeline* pPipeline, VectorView<uint8_t> data) override
+    {
+        Log("SetPushConstants " + ToString(pPipeline) + " " + std::to_string(data.size()));
+    }
+
+    void RHIAddTransitions(BitField<RHIPipelineStageBits> srcStages,
+                           BitField<RHIPipelineStageBits> dstStages,
+                           VectorView<RHIMemoryTransition> memoryTransitions,
+                           VectorView<RHIBufferTransition> bufferTransitions,
+                           VectorView<RHITextureTransition> textureTransitions) override
+    {
+        std::string line = "AddTransitions " + std::to_string(static_cast<int64_t>(srcStages)) +
+            " " + std::to_string(static_cast<int64_t>(dstStages)) + " " +
+            std::to_string(memoryTransitions.size());
+        for (const RHIBufferTransition& transition : bufferTransitions)
+        {
+            line += " b" + ToString(transition.pBuffer) + ":" +
+                std::to_string(ToUnderlying(transition.oldUsage)) + "->" +
+                std::to_string(ToUnderlying(transition.newUsage)) + ":" +
+                std::to_string(ToUnderlying(transition.oldAccessMode)) + "->" +
+                std::to_string(ToUnderlying(transition.newAccessMode));
+        }
+        for (const RHITextureTransition& transition : textureTransitions)
+        {
+            line += " t" + ToString(transition.pTexture) + ":" +
+                std::to_string(ToUnderlying(transition.oldUsage)) + "->" +
+                std::to_string(ToUnderlying(transition.newUsage)) + ":" +
+                std::to_string(transition.subResourceRange.baseMipLevel) + "+" +
+                std::to_string(transition.subResourceRange.levelCount);
+        }
+        Log(line);
+    }
+
+    void RHISetBarrierEvent(RHIBarrierEvent* pEvent,
+                            BitField<RHIPipelineStageBits> srcStages,
+                            BitField<RHIPipelineStageBits> dstStages,
+                            VectorView<RHIBufferTransition> bufferTransitions,
+                            VectorView<RHITextureTransition> textureTransitions) override
+    {
+        pEvent->handle = reinterpret_cast<uintptr_t>(pEvent);
+        Log("SetBarrierEvent " + ToString(pEvent) + " " +
+            std::to_string(static_cast<int64_t>(srcStages)) + " " +
+            std::to_string(static_cast<int64_t>(dstStages)) + " " +
+            std::to_string(bufferTransitions.size()) + " " +
+            std::to_string(textureTransitions.size()));
+    }
+
+    void RHIWaitBarrierEvent(RHIBarrierEvent* pEvent) override
+    {
+        Log("WaitBarrierEvent " + ToString(pEvent) + (pEvent->handle == 0 ? " unset" : ""));
+        pEvent->handle = 0;
+    }
+
+    void RHIGenTextureMipmaps(RHITexture* pTexture) override
+    {
+        Log("GenTextureMipmaps " + ToString(pTexture));
+    }
+
+    void RHIAddTextureTransition(RHITexture* pTexture, RHITextureLayout newLayout) override
+    {
+        Log("AddTextureTransition " + ToString(pTexture));
+    }
+
+    void RHIClearBuffer(RHIBuffer* pBuffer, uint32_t offset, uint32_t size) override
+    {
+        Log("ClearBuffer " + ToString(pBuffer) + " " + std::to_string(offset) + " " +
+            std::to_string(size));
+    }
+
+    void RHICopyBuffer(RHIBuffer* pSrcBuffer,
+                       RHIBuffer* pDstBuffer,
+                       const RHIBufferCopyRegion& region) override
+    {
+        Log("CopyBuffer " + ToString(pSrcBuffer) + " " + ToString(pDstBuffer) + " " +
+            std::to_string(region.size));
+    }
+
+    void RHIClearTexture(RHITexture* pTex,
+                         const Color& color,
+                         const RHITextureSubResourceRange& range) override
+    {
+        Log("ClearTexture " + ToString(pTex));
+    }
+
+    void RHICopyTexture(RHITexture* pSrcTexture,
+                        RHITexture* pDstTexture,
+                        VectorView<RHITextureCopyRegion> regions) override
+    {
+        Log("CopyTexture " + ToString(pSrcTexture) + " " + ToString(pDstTexture) + " " +
+            std::to_string(regions.size()));
+    }
+
+    void RHICopyTextureToBuffer(RHITexture* pSrcTex,
+                                RHIBuffer* pDstBuffer,
+                                VectorView<RHIBufferTextureCopyRegion> regions) override
+    {
+        Log("CopyTextureToBuffer " + ToString(pSrcTex) + " " + ToString(pDstBuffer));
+    }
+
+    void RHICopyBufferToTexture(RHIBuffer* pSrcBuffer,
+                                RHITexture* pDstTexture,
+                                VectorView<RHIBufferTextureCopyRegion> regions) override
+    {
+        Log("CopyBufferToTexture " + ToString(pSrcBuffer) + " " + ToString(pDstTexture));
+    }
+
+    void RHIResolveTexture(RHITexture* pSrcTexture,
+                           RHITexture* pDstTexture,
+                           uint32_t srcLayer,
+                           uint32_t srcMipmap,
+                           uint32_t dstLayer,
+                           uint32_t dstMipmap) override
+    {
+        Log("ResolveTexture " + ToString(pSrcTexture) + " " + ToString(pDstTexture));
+    }
+
+    void RHIWaitUntilCompleted() override {}
+
+private:
+    void Log(std::string line)
+    {
+        m_pLog->push_back(std::move(line));
+    }
+
+    std::vector<std::string>* m_pLog;
+};
+
+// independent chains of transfer and compute work, a shared buffer at the end joins them
+struct SyntheticFrame
+{
+    static constexpr uint32_t cNumChains = 24;
+
+    SyntheticFrame() : histogram("histogram")
+    {
+        for (uint32_t i = 0; i < cNumChains; i++)
+        {
+            const std::string suffix = std::to_string(i);
+            staging.emplace_back("staging" + suffix);
+            particles.emplace_back("particles" + suffix);
+            albedo.emplace_back("albedo" + suffix);
+            albedoCopy.emplace_back("albedo_copy" + suffix);
+            passes.emplace_back();
+        }
+
+        for (uint32_t i = 0; i < cNumChains; i++)
+        {
+            ComputePass& pass      = passes[i];
+            pass.pPipeline         = nullptr;
+            pass.numDescriptorSets = 1;
+            pass.pShaderProgram    = nullptr;
+            for (RHIDescriptorSet*& pSet : pass.pDescriptorSets)
+            {
+                pSet = nullptr;
+            }
+
+            PassResourceTracker& input = pass.resourceTrackers[0][0];
+            input.name                 = "particles";
+            input.pBuffer              = &particles[i];
+            input.resourceType         = PassResourceType::eBuffer;
+            input.accessMode           = RHIAccessMode::eReadWrite;
+            input.bufferUsage          = RHIBufferUsage::eStorageBuffer;
+
+            PassResourceTracker& output = pass.resourceTrackers[0][1];
+            output.name                 = "histogram";
+            output.pBuffer              = &histogram;
+            output.resourceType         = PassResourceType::eBuffer;
+            output.accessMode           = RHIAccessMode::eReadWrite;
+            output.bufferUsage          = RHIBufferUsage::eStorageBuffer;
+        }
+    }
+
+    void Build(RenderGraph& rdg)
+    {
+        rdg.Begin();
+        RHIBufferCopyRegion bufferRegion{};
+        bufferRegion.size = 256;
+        RHITextureCopyRegion textureRegion{};
+        for (uint32_t i = 0; i < cNumChains; i++)
+        {
+            rdg.AddBufferClearNode(&staging[i], 0, 256);
+            rdg.AddBufferCopyNode(&staging[i], &particles[i], bufferRegion);
+
+            RDGPassNode* pPass = rdg.AddComputePassNode(&passes[i], "simulate" + std::to_string(i));
+            // passes differ in size so misplaced commands change the stream
+            for (uint32_t dispatch = 0; dispatch < 1 + i % 4; dispatch++)
+            {
+                rdg.AddComputePassDispatchNode(pPass, i + 1, dispatch + 1, 1);
+            }
+
+            rdg.AddTextureClearNode(&albedo[i], Color(), albedo[i].GetSubResourceRange());
+            rdg.AddTextureMipmapGenNode(&albedo[i]);
+            rdg.AddTextureCopyNode(&albedo[i], &albedoCopy[i], MakeVecView(&textureRegion, 1));
+        }
+        rdg.End();
+    }
+
+    // deque keeps the addresses stable, resources are not movable
+    std::deque<TestBuffer> staging;
+    std::deque<TestBuffer> particles;
+    std::deque<TestTexture> albedo;
+    std::deque<TestTexture> albedoCopy;
+    std::deque<ComputePass> passes;
+    TestBuffer histogram;
+};
+
+// records rdg into numSegments lists and replays them in order
+std::vector<std::string> RecordStream(RenderGraph& rdg,
+                                      uint32_t numSegments,
+                                      JobSystem* pJobSystem,
+                                      std::vector<size_t>* pSegmentSizes = nullptr)
+{
+    std::vector<std::vector<std::string>> logs(numSegments);
+    HeapVector<RHICommandList*> cmdLists;
+    for (uint32_t i = 0; i < numSegments; i++)
+    {
+        cmdLists.push_back(RHICommandList::Create(ZEN_NEW() CaptureContext(&logs[i])));
+    }
+
+    rdg.Execute(MakeVecView(cmdLists), pJobSystem);
+
+    std::vector<std::string> stream;
+    for (uint32_t i = 0; i < numSegments; i++)
+    {
+        cmdLists[i]->Execute();
+        stream.insert(stream.end(), logs[i].begin(), logs[i].end());
+        if (pSegmentSizes != nullptr)
+        {
+            pSegmentSizes->push_back(logs[i].size());
+        }
+        ZEN_DELETE(cmdLists[i]);
+    }
+    return stream;
+}
+
+bool Contains(const std::vector<std::string>& log, const std::string& text)
+{
+    for (const std::string& line : log)
+    {
+        if (line.find(text) != std::string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+TEST(render_graph_record, segments_replay_the_single_list_stream)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    SyntheticFrame frame;
+    RenderGraph rdg("rdg_record_test");
+    frame.Build(rdg);
+
+    // the first run moves the tracked resource state to where every later run starts from
+    RecordStream(rdg, 1, nullptr);
+    const std::vector<std::string> expected = RecordStream(rdg, 1, nullptr);
+    ASSERT_FALSE(expected.empty());
+
+    JobSystem jobSystem(3);
+    for (uint32_t numSegments : {2u, 3u, 4u, 7u, 16u})
+    {
+        SCOPED_TRACE(numSegments);
+        std::vector<size_t> segmentSizes;
+        EXPECT_EQ(RecordStream(rdg, numSegments, &jobSystem, &segmentSizes), expected);
+        // the work is spread over the lists
+        for (size_t size : segmentSizes)
+        {
+            EXPECT_GT(size, 0u);
+        }
+
+        EXPECT_EQ(RecordStream(rdg, numSegments, nullptr), expected);
+    }
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_record, more_segments_than_nodes)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestBuffer staging("staging");
+    TestBuffer vertices("vertices");
+    RenderGraph rdg("rdg_record_small_test");
+    rdg.Begin();
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    rdg.AddBufferClearNode(&staging, 0, 256);
+    rdg.AddBufferCopyNode(&staging, &vertices, region);
+    rdg.End();
+
+    RecordStream(rdg, 1, nullptr);
+    const std::vector<std::string> expected = RecordStream(rdg, 1, nullptr);
+
+    JobSystem jobSystem(2);
+    std::vector<size_t> segmentSizes;
+    EXPECT_EQ(RecordStream(rdg, 5, &jobSystem, &segmentSizes), expected);
+    ASSERT_EQ(segmentSizes.size(), 5u);
+    // two nodes, the rest of the lists stay empty
+    uint32_t numUsed = 0;
+    for (size_t size : segmentSizes)
+    {
+        numUsed += size > 0 ? 1 : 0;
+    }
+    EXPECT_EQ(numUsed, 2u);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_record, barriers_of_a_level_share_one_call)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    std::deque<TestBuffer> staging;
+    std::deque<TestBuffer> vertices;
+    RenderGraph rdg("rdg_barrier_batch_test");
+    rdg.Begin();
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        staging.emplace_back("staging" + std::to_string(i));
+        vertices.emplace_back("vertices" + std::to_string(i));
+        rdg.AddBufferClearNode(&staging.back(), 0, 256);
+    }
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        rdg.AddBufferCopyNode(&staging[i], &vertices[i], region);
+    }
+    rdg.End();
+
+    // the clears and the copies each form a level
+    const RDGCompileStats& stats = rdg.GetCompileStats();
+    EXPECT_EQ(stats.unmergedBarrierBatchCount, 6u);
+    EXPECT_EQ(stats.barrierBatchCount, 2u);
+    EXPECT_EQ(stats.splitBarrierCount, 0u);
+
+    const std::vector<std::string> stream = RecordStream(rdg, 1, nullptr);
+    uint32_t numBarriers = 0;
+    for (const std::string& line : stream)
+    {
+        numBarriers += line.rfind("AddTransitions", 0) == 0 ? 1 : 0;
+    }
+    EXPECT_EQ(numBarriers, 2u);
+    // every clear waits for the first barrier, every copy for the second
+    ASSERT_EQ(stream.size(), 8u);
+    EXPECT_EQ(stream[0].rfind("AddTransitions", 0), 0u);
+    EXPECT_EQ(stream[4].rfind("AddTransitions", 0), 0u);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        EXPECT_NE(stream[4].find("b" + ToString(&staging[i])), std::string::npos);
+        EXPECT_NE(stream[4].find("b" + ToString(&vertices[i])), std::string::npos);
+    }
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_record, distant_producer_uses_split_barrier)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestBuffer staging("staging");
+    TestBuffer vertices("vertices");
+    std::deque<TestBuffer> scratch;
+    RenderGraph rdg("rdg_split_barrier_test");
+    rdg.Begin();
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    rdg.AddBufferClearNode(&staging, 0, 256);
+    for (uint32_t i = 0; i < RenderGraph::cSplitBarrierMinDistance; i++)
+    {
+        scratch.emplace_back("scratch" + std::to_string(i));
+        rdg.AddBufferClearNode(&scratch.back(), 0, 256);
+    }
+    rdg.AddBufferCopyNode(&staging, &vertices, region);
+    rdg.End();
+    EXPECT_EQ(rdg.GetCompileStats().splitBarrierCount, 1u);
+
+    // the transition of staging starts after its clear and finishes right before the copy
+    RecordStream(rdg, 1, nullptr);
+    const std::vector<std::string> stream = RecordStream(rdg, 1, nullptr);
+    ASSERT_EQ(stream.size(), 10u);
+    EXPECT_EQ(stream[1], "ClearBuffer " + ToString(&staging) + " 0 256");
+    EXPECT_EQ(stream[2].rfind("SetBarrierEvent", 0), 0u);
+    EXPECT_EQ(stream[7].find("b" + ToString(&staging)), std::string::npos);
+    const std::string eventName = stream[2].substr(15, stream[2].find(' ', 16) - 15);
+    EXPECT_EQ(stream[8], "WaitBarrierEvent" + eventName);
+    EXPECT_EQ(stream[9].rfind("CopyBuffer " + ToString(&staging), 0), 0u);
+
+    // the event may be set and waited in different lists
+    JobSystem jobSystem(2);
+    EXPECT_EQ(RecordStream(rdg, 3, &jobSystem), stream);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_record, repeated_read_skips_transition)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestBuffer source("source");
+    TestBuffer destination("destination");
+    RenderGraph rdg("rdg_redundant_transition_test");
+    rdg.Begin();
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    rdg.AddBufferCopyNode(&source, &destination, region);
+    rdg.End();
+
+    const std::vector<std::string> first = RecordStream(rdg, 1, nullptr);
+    EXPECT_EQ(rdg.GetCompileStats().redundantTransitionCount, 0u);
+    EXPECT_TRUE(Contains(first, "b" + ToString(&source)));
+
+    // source is still read as a copy source, only destination needs a barrier
+    const std::vector<std::string> second = RecordStream(rdg, 1, nullptr);
+    EXPECT_EQ(rdg.GetCompileStats().redundantTransitionCount, 1u);
+    EXPECT_FALSE(Contains(second, "b" + ToString(&source)));
+    EXPECT_TRUE(Contains(second, "b" + ToString(&destination)));
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "Graphics/RHI/RHIResource.h"
+#include <string>
+
+// Create infos and fake RHI resources shared by the render graph and RHI tests. The fakes own no
+// memory, they only carry a tag, their create info and memory requirements.
+inline zen::RHIBufferCreateInfo MakeTestBufferInfo(const std::string& tag, bool transient = false)
+{
+    zen::RHIBufferCreateInfo createInfo{};
+    createInfo.size      = 256;
+    createInfo.transient = transient;
+    createInfo.tag       = tag;
+    return createInfo;
+}
+
+// 64x64 RGBA8 with a full mip chain
+inline zen::RHITextureCreateInfo MakeTestTextureInfo(const std::string& tag,
+                                                     bool transient = false)
+{
+    zen::RHITextureCreateInfo createInfo{};
+    createInfo.format    = DataFormat::eR8G8B8A8UNORM;
+    createInfo.type      = zen::RHITextureType::e2D;
+    createInfo.width     = 64;
+    createInfo.height    = 64;
+    createInfo.mipmaps   = 7;
+    createInfo.transient = transient;
+    createInfo.tag       = tag;
+    return createInfo;
+}
+
+class TestBuffer : public zen::RHIBuffer
+{
+public:
+    // memorySize is what a transient placement reserves for the buffer
+    explicit TestBuffer(const std::string& tag, uint64_t memorySize = 256, bool transient = false) :
+        zen::RHIBuffer(MakeTestBufferInfo(tag, transient))
+    {
+        m_memoryRequirements.size      = memorySize;
+        m_memoryRequirements.alignment = 256;
+    }
+
+    ~TestBuffer()
+    {
+        ReleaseReference();
+    }
+
+    uint8_t* Map() override
+    {
+        return nullptr;
+    }
+
+    void Unmap() override {}
+
+    void SetTexelFormat(DataFormat format) override {}
+
+protected:
+    void Init() override {}
+
+    void Destroy() override {}
+};
+
+class TestTexture : public zen::RHITexture
+{
+public:
+    // memorySize is what a transient placement reserves for the texture
+    explicit TestTexture(const std::string& tag,
+                         uint64_t memorySize = 64 * 1024,
+                         bool transient      = false) :
+        zen::RHITexture(MakeTestTextureInfo(tag, transient))
+    {
+        m_memoryRequirements.size      = memorySize;
+        m_memoryRequirements.alignment = 64 * 1024;
+    }
+
+    ~TestTexture()
+    {
+        ReleaseReference();
+    }
+
+protected:
+    void Init() override {}
+
+    void Destroy() override {}
+};
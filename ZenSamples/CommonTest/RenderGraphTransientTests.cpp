@@ -0,0 +1,414 @@
+#include "Graphics/RenderCore/V2/RenderGraph.h"
+#include "RenderGraphTestUtils.h"
+#include <gtest/gtest.h>
+
+using namespace zen;
+using namespace zen::rc;
+
+namespace
+{
+constexpr uint64_t cMB = 1024 * 1024;
+
+// position of a node in the compiled order
+int32_t CompiledPosition(const RenderGraph& rdg, int32_t nodeId)
+{
+    const HeapVector<RDGCompiledNode>& compiledNodes = rdg.GetCompiledNodes();
+    for (uint32_t i = 0; i < compiledNodes.size(); i++)
+    {
+        if (static_cast<int32_t>(compiledNodes[i].nodeId) == nodeId)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+void ExpectLifetime(const RDGResourceLifetime& lifetime, int32_t firstNode, int32_t lastNode)
+{
+    EXPECT_EQ(lifetime.firstNode, firstNode);
+    EXPECT_EQ(lifetime.lastNode, lastNode);
+}
+
+RDGTransientRequest MakeRequest(uint64_t size,
+                                int32_t firstNode,
+                                int32_t lastNode,
+                                uint64_t alignment       = cMB,
+                                uint32_t memoryTypeBits = ~0u)
+{
+    RDGTransientRequest request{};
+    request.memory.size           = size;
+    request.memory.alignment      = alignment;
+    request.memory.memoryTypeBits = memoryTypeBits;
+    request.lifetime              = {firstNode, lastNode};
+    return request;
+}
+
+// no two requests alive at the same node share memory
+void ExpectNoLiveOverlap(const HeapVector<RDGTransientRequest>& requests,
+                         const RDGTransientLayout& layout)
+{
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        const RDGTransientPlacement& a = layout.placements[i];
+        EXPECT_EQ(a.offset % requests[i].memory.alignment, 0u);
+        EXPECT_LE(a.offset + requests[i].memory.size, layout.blocks[a.blockIndex].size);
+        for (uint32_t j = i + 1; j < requests.size(); j++)
+        {
+            const RDGTransientPlacement& b = layout.placements[j];
+            if (a.blockIndex != b.blockIndex ||
+                !requests[i].lifetime.Overlaps(requests[j].lifetime))
+            {
+                continue;
+            }
+            EXPECT_TRUE(a.offset + requests[i].memory.size <= b.offset ||
+                        b.offset + requests[j].memory.size <= a.offset)
+                << "requests " << i << " and " << j;
+        }
+    }
+}
+} // namespace
+
+TEST(render_graph_transient, chain_reuses_memory_of_finished_textures)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestTexture gbuffer("gbuffer", 4 * cMB, true);
+    TestTexture lighting("lighting", 4 * cMB, true);
+    TestTexture bloom("bloom", 4 * cMB, true);
+    TestTexture tonemap("tonemap", 4 * cMB, true);
+    TestTexture output("output", 4 * cMB, false);
+
+    RenderGraph rdg("rdg_transient_chain_test");
+    rdg.Begin();
+    RHITextureCopyRegion region{};
+    rdg.AddTextureClearNode(&gbuffer, Color(), gbuffer.GetSubResourceRange());
+    rdg.AddTextureCopyNode(&gbuffer, &lighting, MakeVecView(&region, 1));
+    rdg.AddTextureCopyNode(&lighting, &bloom, MakeVecView(&region, 1));
+    rdg.AddTextureCopyNode(&bloom, &tonemap, MakeVecView(&region, 1));
+    rdg.AddTextureCopyNode(&tonemap, &output, MakeVecView(&region, 1));
+    rdg.End();
+
+    // a strict chain compiles in declaration order
+    for (int32_t nodeId = 0; nodeId < 5; nodeId++)
+    {
+        ASSERT_EQ(CompiledPosition(rdg, nodeId), nodeId);
+    }
+    ExpectLifetime(rdg.GetResourceLifetime(&gbuffer), 0, 1);
+    ExpectLifetime(rdg.GetResourceLifetime(&lighting), 1, 2);
+    ExpectLifetime(rdg.GetResourceLifetime(&bloom), 2, 3);
+    ExpectLifetime(rdg.GetResourceLifetime(&tonemap), 3, 4);
+    ExpectLifetime(rdg.GetResourceLifetime(&output), 4, 4);
+
+    const RDGCompileStats& stats = rdg.GetCompileStats();
+    EXPECT_EQ(stats.transientResourceCount, 4u);
+    EXPECT_EQ(stats.transientMemoryRequestedSize, 16 * cMB);
+    // two targets are alive at every step, the others alternate between the same two slots
+    EXPECT_EQ(rdg.GetTransientLayout().peakLiveSize, 8 * cMB);
+    EXPECT_EQ(stats.transientMemorySize, 8 * cMB);
+    EXPECT_EQ(stats.aliasingBarrierCount, 2u);
+
+    const HeapVector<RHIResource*>& resources = rdg.GetTransientResources();
+    const RDGTransientLayout& layout          = rdg.GetTransientLayout();
+    ASSERT_EQ(resources.size(), 4u);
+    ASSERT_EQ(layout.placements.size(), 4u);
+    EXPECT_EQ(resources[0], &gbuffer);
+    EXPECT_EQ(resources[2], &bloom);
+    EXPECT_EQ(layout.blocks.size(), 1u);
+    EXPECT_EQ(layout.placements[2].offset, layout.placements[0].offset);
+    EXPECT_EQ(layout.placements[2].aliasedRequest, 0);
+    EXPECT_EQ(layout.placements[3].offset, layout.placements[1].offset);
+    EXPECT_EQ(layout.placements[3].aliasedRequest, 1);
+    EXPECT_NE(layout.placements[0].offset, layout.placements[1].offset);
+
+    // the aliasing barriers sit on the first use of the new resources
+    const HeapVector<RDGCompiledNode>& compiledNodes = rdg.GetCompiledNodes();
+    EXPECT_TRUE(compiledNodes[1].aliasingMemoryTransitions.empty());
+    EXPECT_EQ(compiledNodes[2].aliasingMemoryTransitions.size(), 1u);
+    EXPECT_EQ(compiledNodes[3].aliasingMemoryTransitions.size(), 1u);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_transient, parallel_buffers_follow_compiled_order)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestBuffer culled("culled", 1 * cMB, true);
+    TestBuffer compacted("compacted", 1 * cMB, true);
+    TestBuffer histogram("histogram", 2 * cMB, true);
+    TestBuffer exposure("exposure", 2 * cMB, false);
+
+    RenderGraph rdg("rdg_transient_parallel_test");
+    rdg.Begin();
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+    rdg.AddBufferClearNode(&culled, 0, 256);
+    rdg.AddBufferCopyNode(&culled, &compacted, region);
+    rdg.AddBufferClearNode(&histogram, 0, 256);
+    rdg.AddBufferCopyNode(&histogram, &exposure, region);
+    rdg.End();
+
+    const int32_t clearCulled    = CompiledPosition(rdg, 0);
+    const int32_t copyCulled     = CompiledPosition(rdg, 1);
+    const int32_t clearHistogram = CompiledPosition(rdg, 2);
+    const int32_t copyHistogram  = CompiledPosition(rdg, 3);
+    ASSERT_LT(clearCulled, copyCulled);
+    ASSERT_LT(clearHistogram, copyHistogram);
+    ExpectLifetime(rdg.GetResourceLifetime(&culled), clearCulled, copyCulled);
+    ExpectLifetime(rdg.GetResourceLifetime(&compacted), copyCulled, copyCulled);
+    ExpectLifetime(rdg.GetResourceLifetime(&histogram), clearHistogram, copyHistogram);
+    ExpectLifetime(rdg.GetResourceLifetime(&exposure), copyHistogram, copyHistogram);
+
+    // the largest sum of transient sizes alive at one position of this order
+    const RDGResourceLifetime lifetimes[] = {rdg.GetResourceLifetime(&culled),
+                                             rdg.GetResourceLifetime(&compacted),
+                                             rdg.GetResourceLifetime(&histogram)};
+    const uint64_t sizes[]                = {1 * cMB, 1 * cMB, 2 * cMB};
+    uint64_t expectedPeak                 = 0;
+    for (int32_t position = 0; position < 4; position++)
+    {
+        uint64_t live = 0;
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            if (lifetimes[i].firstNode <= position && position <= lifetimes[i].lastNode)
+            {
+                live += sizes[i];
+            }
+        }
+        expectedPeak = std::max(expectedPeak, live);
+    }
+
+    const RDGTransientLayout& layout = rdg.GetTransientLayout();
+    EXPECT_EQ(rdg.GetCompileStats().transientResourceCount, 3u);
+    EXPECT_EQ(layout.requestedSize, 4 * cMB);
+    EXPECT_EQ(layout.peakLiveSize, expectedPeak);
+    EXPECT_GE(layout.allocatedSize, layout.peakLiveSize);
+    EXPECT_LE(layout.allocatedSize, layout.requestedSize);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_transient, placement_reaches_peak_for_staggered_lifetimes)
+{
+    HeapVector<RDGTransientRequest> requests;
+    requests.push_back(MakeRequest(4 * cMB, 0, 2));
+    requests.push_back(MakeRequest(2 * cMB, 1, 3));
+    requests.push_back(MakeRequest(2 * cMB, 3, 5));
+    requests.push_back(MakeRequest(1 * cMB, 4, 5));
+    requests.push_back(MakeRequest(3 * cMB, 6, 7));
+
+    RDGTransientLayout layout;
+    RDGTransientAllocator::Place(requests, RDGTransientAllocator::cDefaultMaxBlockSize, layout);
+    ExpectNoLiveOverlap(requests, layout);
+
+    EXPECT_EQ(layout.requestedSize, 12 * cMB);
+    EXPECT_EQ(layout.peakLiveSize, 6 * cMB);
+    ASSERT_EQ(layout.blocks.size(), 1u);
+    EXPECT_EQ(layout.allocatedSize, 6 * cMB);
+
+    EXPECT_EQ(layout.placements[0].offset, 0u);
+    EXPECT_EQ(layout.placements[1].offset, 4 * cMB);
+    EXPECT_EQ(layout.placements[2].offset, 0u);
+    EXPECT_EQ(layout.placements[3].offset, 2 * cMB);
+    EXPECT_EQ(layout.placements[4].offset, 0u);
+
+    EXPECT_EQ(layout.placements[0].aliasedRequest, -1);
+    EXPECT_EQ(layout.placements[1].aliasedRequest, -1);
+    EXPECT_EQ(layout.placements[2].aliasedRequest, 0);
+    EXPECT_EQ(layout.placements[3].aliasedRequest, 0);
+    EXPECT_EQ(layout.placements[4].aliasedRequest, 2);
+}
+
+TEST(render_graph_transient, placement_without_reuse_keeps_every_request)
+{
+    // all alive at once, nothing can be shared
+    HeapVector<RDGTransientRequest> requests;
+    requests.push_back(MakeRequest(3 * cMB, 0, 4));
+    requests.push_back(MakeRequest(1 * cMB, 1, 3));
+    requests.push_back(MakeRequest(2 * cMB, 2, 2));
+
+    RDGTransientLayout layout;
+    RDGTransientAllocator::Place(requests, RDGTransientAllocator::cDefaultMaxBlockSize, layout);
+    ExpectNoLiveOverlap(requests, layout);
+
+    EXPECT_EQ(layout.peakLiveSize, 6 * cMB);
+    EXPECT_EQ(layout.allocatedSize, 6 * cMB);
+    EXPECT_EQ(layout.requestedSize, 6 * cMB);
+    for (const RDGTransientPlacement& placement : layout.placements)
+    {
+        EXPECT_EQ(placement.aliasedRequest, -1);
+    }
+
+    RDGTransientLayout empty;
+    RDGTransientAllocator::Place({}, RDGTransientAllocator::cDefaultMaxBlockSize, empty);
+    EXPECT_TRUE(empty.blocks.empty());
+    EXPECT_EQ(empty.peakLiveSize, 0u);
+}
+
+TEST(render_graph_transient, placement_respects_memory_types_alignment_and_block_size)
+{
+    HeapVector<RDGTransientRequest> requests;
+    // disjoint lifetimes but no common memory type
+    requests.push_back(MakeRequest(1 * cMB, 0, 0, cMB, 0x1));
+    requests.push_back(MakeRequest(1 * cMB, 1, 1, cMB, 0x2));
+    // alive together, the smaller one starts at the next multiple of its alignment
+    requests.push_back(MakeRequest(300, 2, 3, 1, 0x4));
+    requests.push_back(MakeRequest(100, 3, 4, 256, 0x4));
+    // larger than the block limit, opens a block of its own size that others may share
+    requests.push_back(MakeRequest(16 * cMB, 5, 5, cMB, 0x1));
+
+    RDGTransientLayout layout;
+    RDGTransientAllocator::Place(requests, 8 * cMB, layout);
+    ExpectNoLiveOverlap(requests, layout);
+
+    EXPECT_NE(layout.placements[0].blockIndex, layout.placements[1].blockIndex);
+    EXPECT_EQ(layout.placements[2].blockIndex, layout.placements[3].blockIndex);
+    EXPECT_EQ(layout.placements[2].offset, 0u);
+    EXPECT_EQ(layout.placements[3].offset, 512u);
+    EXPECT_EQ(layout.blocks[layout.placements[3].blockIndex].size, 612u);
+    EXPECT_EQ(layout.blocks[layout.placements[3].blockIndex].alignment, 256u);
+    EXPECT_EQ(layout.placements[4].offset, 0u);
+    EXPECT_EQ(layout.blocks[layout.placements[4].blockIndex].size, 16 * cMB);
+    EXPECT_EQ(layout.placements[0].blockIndex, layout.placements[4].blockIndex);
+    EXPECT_EQ(layout.placements[4].aliasedRequest, 0);
+    EXPECT_EQ(layout.blocks.size(), 3u);
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        const RDGTransientBlock& block = layout.blocks[layout.placements[i].blockIndex];
+        EXPECT_NE(block.memoryTypeBits & requests[i].memory.memoryTypeBits, 0u);
+    }
+    EXPECT_EQ(layout.peakLiveSize, 16 * cMB);
+}
+
+TEST(render_graph_transient, fixed_requests_keep_their_placement)
+{
+    HeapVector<RDGTransientRequest> requests;
+    // bound by an earlier compile, the larger request would take offset 0 otherwise
+    requests.push_back(MakeRequest(1 * cMB, 0, 1));
+    requests.back().fixed       = true;
+    requests.back().fixedOffset = 0;
+    requests.push_back(MakeRequest(4 * cMB, 1, 2));
+    // bound to a block the new layout does not need otherwise
+    requests.push_back(MakeRequest(1 * cMB, 3, 3));
+    requests.back().fixed           = true;
+    requests.back().fixedBlockIndex = 1;
+    requests.back().fixedOffset     = 2 * cMB;
+
+    RDGTransientLayout layout;
+    RDGTransientAllocator::Place(requests, RDGTransientAllocator::cDefaultMaxBlockSize, layout);
+    ExpectNoLiveOverlap(requests, layout);
+
+    ASSERT_EQ(layout.blocks.size(), 2u);
+    EXPECT_EQ(layout.placements[0].blockIndex, 0u);
+    EXPECT_EQ(layout.placements[0].offset, 0u);
+    EXPECT_EQ(layout.placements[1].blockIndex, 0u);
+    EXPECT_EQ(layout.placements[1].offset, 1 * cMB);
+    EXPECT_EQ(layout.placements[2].blockIndex, 1u);
+    EXPECT_EQ(layout.placements[2].offset, 2 * cMB);
+    EXPECT_EQ(layout.blocks[1].size, 3 * cMB);
+    EXPECT_TRUE(layout.fixedConflicts.empty());
+
+    // bound to the same memory while both are alive, nothing can be moved
+    requests.push_back(MakeRequest(1 * cMB, 2, 3));
+    requests.back().fixed           = true;
+    requests.back().fixedBlockIndex = 1;
+    requests.back().fixedOffset     = 2 * cMB;
+    RDGTransientAllocator::Place(requests, RDGTransientAllocator::cDefaultMaxBlockSize, layout);
+    ASSERT_EQ(layout.fixedConflicts.size(), 1u);
+    EXPECT_EQ(layout.fixedConflicts[0].first, 2u);
+    EXPECT_EQ(layout.fixedConflicts[0].second, 3u);
+}
+
+TEST(render_graph_transient, recompiled_graph_keeps_placed_resources)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestBuffer culled("culled", 1 * cMB, true);
+    TestBuffer compacted("compacted", 1 * cMB, true);
+    TestBuffer histogram("histogram", 4 * cMB, true);
+    TestBuffer exposure("exposure", 256, false);
+    RHIBufferCopyRegion region{};
+    region.size = 256;
+
+    RenderGraph rdg("rdg_transient_recompile_test");
+    rdg.Begin();
+    rdg.AddBufferClearNode(&culled, 0, 256);
+    rdg.AddBufferCopyNode(&culled, &compacted, region);
+    rdg.AddBufferCopyNode(&compacted, &exposure, region);
+    rdg.End();
+    const RDGTransientPlacement culledPlacement    = rdg.GetTransientLayout().placements[0];
+    const RDGTransientPlacement compactedPlacement = rdg.GetTransientLayout().placements[1];
+
+    // the larger histogram is alive next to both and would be placed first on its own
+    rdg.Begin();
+    rdg.AddBufferClearNode(&histogram, 0, 256);
+    rdg.AddBufferCopyNode(&histogram, &culled, region);
+    rdg.AddBufferCopyNode(&culled, &compacted, region);
+    rdg.AddBufferCopyNode(&compacted, &exposure, region);
+    rdg.AddBufferCopyNode(&histogram, &exposure, region);
+    rdg.End();
+
+    const HeapVector<RHIResource*>& resources = rdg.GetTransientResources();
+    const RDGTransientLayout& layout          = rdg.GetTransientLayout();
+    ASSERT_EQ(resources.size(), 3u);
+    ASSERT_EQ(resources[1], &culled);
+    ASSERT_EQ(resources[2], &compacted);
+    EXPECT_EQ(layout.placements[1].offset, culledPlacement.offset);
+    EXPECT_EQ(layout.placements[2].offset, compactedPlacement.offset);
+    EXPECT_GE(layout.placements[0].offset, 2 * cMB);
+    EXPECT_TRUE(layout.fixedConflicts.empty());
+
+    // a destroyed resource gives up its memory
+    RenderGraph::ReleaseResourceTracker(&culled);
+    RenderGraph::ReleaseResourceTracker(&compacted);
+    RenderGraph::ReleaseResourceTracker(&histogram);
+    rdg.Begin();
+    rdg.AddBufferClearNode(&histogram, 0, 256);
+    rdg.AddBufferCopyNode(&histogram, &exposure, region);
+    rdg.End();
+    EXPECT_EQ(rdg.GetTransientLayout().placements[0].offset, 0u);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
+
+TEST(render_graph_transient, overlapping_bound_resources_fail_the_compile)
+{
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+    TestTexture depth("depth", 4 * cMB, true);
+    TestTexture velocity("velocity", 4 * cMB, true);
+    TestTexture output("output", 4 * cMB, false);
+    TestTexture history("history", 4 * cMB, false);
+    RHITextureCopyRegion region{};
+
+    RenderGraph rdg("rdg_transient_conflict_test");
+    rdg.Begin();
+    rdg.AddTextureClearNode(&depth, Color(), depth.GetSubResourceRange());
+    rdg.AddTextureCopyNode(&depth, &output, MakeVecView(&region, 1));
+    rdg.AddTextureCopyNode(&output, &velocity, MakeVecView(&region, 1));
+    rdg.AddTextureCopyNode(&velocity, &history, MakeVecView(&region, 1));
+    rdg.End();
+    const RDGTransientLayout& layout = rdg.GetTransientLayout();
+    ASSERT_EQ(layout.placements.size(), 2u);
+    ASSERT_EQ(layout.placements[0].offset, layout.placements[1].offset);
+
+    // both are alive at once now, but keep the memory the first compile bound them to
+    rdg.Begin();
+    rdg.AddTextureClearNode(&depth, Color(), depth.GetSubResourceRange());
+    rdg.AddTextureCopyNode(&depth, &velocity, MakeVecView(&region, 1));
+    rdg.AddTextureCopyNode(&velocity, &history, MakeVecView(&region, 1));
+    EXPECT_THROW(rdg.End(), std::runtime_error);
+
+    // a recreated resource is placed again
+    RenderGraph::ReleaseResourceTracker(&velocity);
+    rdg.Begin();
+    rdg.AddTextureClearNode(&depth, Color(), depth.GetSubResourceRange());
+    rdg.AddTextureCopyNode(&depth, &velocity, MakeVecView(&region, 1));
+    rdg.AddTextureCopyNode(&velocity, &history, MakeVecView(&region, 1));
+    rdg.End();
+    EXPECT_TRUE(rdg.GetTransientLayout().fixedConflicts.empty());
+    EXPECT_NE(rdg.GetTransientLayout().placements[0].offset,
+              rdg.GetTransientLayout().placements[1].offset);
+    RenderGraph::ClearCompiledPlanCache();
+    RenderGraph::ClearResourceTrackers();
+}
@@ -0,0 +1,149 @@
+#include "SceneGraph/SceneBVH.h"
+#include "Graphics/Types/Frustum.h"
+#include "CullingTestUtils.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace zen;
+
+static std::vector<sg::AABB> GenerateBoxes(uint32_t count, float worldSize, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-worldSize, worldSize);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+    std::vector<sg::AABB> boxes;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        const Vec3 extent(size(rng), size(rng), size(rng));
+        boxes.emplace_back(center - extent, center + extent);
+    }
+    return boxes;
+}
+
+// smallest signed distance of the box to the planes, negative when it is outside
+static float PlaneMargin(const sg::AABB& box, const Frustum& frustum)
+{
+    float margin = std::numeric_limits<float>::max();
+    for (const Vec4& plane : frustum.GetPlanes())
+    {
+        // farthest corner along the plane normal
+        const Vec3 corner(plane.x > 0.0f ? box.GetMax().x : box.GetMin().x,
+                          plane.y > 0.0f ? box.GetMax().y : box.GetMin().y,
+                          plane.z > 0.0f ? box.GetMax().z : box.GetMin().z);
+        margin = std::min(margin, glm::dot(Vec3(plane), corner) + plane.w);
+    }
+    return margin;
+}
+
+TEST(scene_bvh_tests, cube_frustum_known_answers)
+{
+    // unit boxes centered at x = -20, -18, ..., 20
+    std::vector<sg::AABB> boxes;
+    for (int i = 0; i < 21; i++)
+    {
+        const Vec3 center(static_cast<float>(i * 2 - 20), 0.0f, 0.0f);
+        boxes.emplace_back(center - Vec3(0.5f), center + Vec3(0.5f));
+    }
+    // far away in y and z
+    boxes.emplace_back(Vec3(-1.0f, 50.0f, -1.0f), Vec3(1.0f, 52.0f, 1.0f));
+    boxes.emplace_back(Vec3(-1.0f, -1.0f, -90.0f), Vec3(1.0f, 1.0f, -80.0f));
+    // straddles the x = 10 plane
+    boxes.emplace_back(Vec3(9.0f, -1.0f, -1.0f), Vec3(30.0f, 1.0f, 1.0f));
+
+    sg::SceneBVH bvh;
+    bvh.Build(boxes);
+    EXPECT_EQ(bvh.GetNumItems(), boxes.size());
+
+    // x in [-10, 10] keeps the boxes centered at -10 ... 10
+    const std::vector<uint32_t> expected = {5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 23};
+    EXPECT_EQ(CullSorted(bvh, MakeCubeFrustum(10.0f)), expected);
+
+    // everything fits
+    std::vector<uint32_t> all(boxes.size());
+    std::iota(all.begin(), all.end(), 0);
+    EXPECT_EQ(CullSorted(bvh, MakeCubeFrustum(1000.0f)), all);
+
+    // only the middle box
+    EXPECT_EQ(CullSorted(bvh, MakeCubeFrustum(0.25f)), std::vector<uint32_t>{10});
+}
+
+TEST(scene_bvh_tests, perspective_matches_brute_force)
+{
+    const auto boxes = GenerateBoxes(20000, 200.0f, 17);
+    sg::SceneBVH bvh;
+    bvh.Build(boxes);
+
+    const Mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+    const Vec3 eyes[]    = {Vec3(0.0f), Vec3(120.0f, 30.0f, -40.0f), Vec3(-250.0f, 0.0f, 0.0f)};
+    const Vec3 targets[] = {Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f), Vec3(0.0f, 10.0f, 0.0f)};
+    for (uint32_t view = 0; view < 3; view++)
+    {
+        Frustum frustum;
+        frustum.ExtractPlanes(proj * glm::lookAt(eyes[view], targets[view], Vec3(0, 1, 0)));
+        const auto visible = CullSorted(bvh, frustum);
+        EXPECT_FALSE(visible.empty());
+        EXPECT_LT(visible.size(), boxes.size());
+
+        // boxes on a plane within float noise may go either way
+        for (uint32_t i = 0; i < boxes.size(); i++)
+        {
+            const float margin = PlaneMargin(boxes[i], frustum);
+            const bool found   = std::binary_search(visible.begin(), visible.end(), i);
+            if (margin > 1e-3f)
+            {
+                EXPECT_TRUE(found) << "box " << i << " view " << view;
+            }
+            else if (margin < -1e-3f)
+            {
+                EXPECT_FALSE(found) << "box " << i << " view " << view;
+            }
+        }
+    }
+}
+
+TEST(scene_bvh_tests, refit)
+{
+    auto boxes = GenerateBoxes(5000, 50.0f, 23);
+    sg::SceneBVH bvh;
+    bvh.Build(boxes);
+    const Frustum frustum = MakeCubeFrustum(20.0f);
+    const auto before     = CullSorted(bvh, frustum);
+    EXPECT_FALSE(before.empty());
+
+    // move everything out of view
+    const Vec3 offset(500.0f, 0.0f, 0.0f);
+    std::vector<sg::AABB> moved;
+    for (const auto& box : boxes)
+    {
+        moved.emplace_back(box.GetMin() + offset, box.GetMax() + offset);
+    }
+    bvh.Refit(moved);
+    EXPECT_TRUE(CullSorted(bvh, frustum).empty());
+    EXPECT_EQ(CullSorted(bvh, MakeCubeFrustum(1000.0f)).size(), boxes.size());
+
+    bvh.Refit(boxes);
+    EXPECT_EQ(CullSorted(bvh, frustum), before);
+}
+
+TEST(scene_bvh_tests, transform_aabb)
+{
+    const sg::AABB box(Vec3(-1.0f), Vec3(1.0f));
+    // 45 degrees around z, then moved by (10, 0, 0)
+    const float c = std::sqrt(0.5f);
+    Mat4 model(1.0f);
+    model[0] = Vec4(c, c, 0.0f, 0.0f);
+    model[1] = Vec4(-c, c, 0.0f, 0.0f);
+    model[3] = Vec4(10.0f, 0.0f, 0.0f, 1.0f);
+
+    const sg::AABB world = sg::SceneBVH::TransformAABB(box, model);
+    const float r        = 2.0f * c;
+    EXPECT_NEAR(world.GetMin().x, 10.0f - r, 1e-5f);
+    EXPECT_NEAR(world.GetMax().x, 10.0f + r, 1e-5f);
+    EXPECT_NEAR(world.GetMin().y, -r, 1e-5f);
+    EXPECT_NEAR(world.GetMax().y, r, 1e-5f);
+    EXPECT_NEAR(world.GetMin().z, -1.0f, 1e-5f);
+    EXPECT_NEAR(world.GetMax().z, 1.0f, 1e-5f);
+}
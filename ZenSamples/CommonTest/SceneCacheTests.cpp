@@ -0,0 +1,259 @@
+#include "AssetLib/FastGLTFLoader.h"
+#include "AssetLib/TextureLoader.h"
+#include "SceneGraph/Scene.h"
+#include "SyntheticGltf.h"
+#include "TestUtils.h"
+#include <gtest/gtest.h>
+
+using namespace zen;
+
+static void LoadScene(const std::filesystem::path& gltfPath,
+                      const std::filesystem::path& cacheDir,
+                      sg::Scene* pScene,
+                      asset::FastGLTFLoader& loader)
+{
+    loader.SetOptimizeMeshes(true);
+    loader.SetBuildMeshlets(true);
+    loader.SetSceneCacheDir(cacheDir.string());
+    loader.LoadFromFile(gltfPath.string(), pScene);
+}
+
+static void ExpectEqualAABB(const sg::AABB& lhs, const sg::AABB& rhs)
+{
+    EXPECT_EQ(lhs.GetMin(), rhs.GetMin());
+    EXPECT_EQ(lhs.GetMax(), rhs.GetMax());
+}
+
+// everything the renderers read from a loaded scene
+static void ExpectEqualScenes(sg::Scene& cold,
+                              const asset::FastGLTFLoader& coldLoader,
+                              sg::Scene& warm,
+                              const asset::FastGLTFLoader& warmLoader)
+{
+    ASSERT_EQ(coldLoader.GetVertices().size(), warmLoader.GetVertices().size());
+    EXPECT_EQ(std::memcmp(coldLoader.GetVertices().data(), warmLoader.GetVertices().data(),
+                          coldLoader.GetVertices().size() * sizeof(asset::Vertex)),
+              0);
+    EXPECT_EQ(coldLoader.GetIndices(), warmLoader.GetIndices());
+    const auto& coldMeshlets = coldLoader.GetMeshletData();
+    const auto& warmMeshlets = warmLoader.GetMeshletData();
+    ASSERT_EQ(coldMeshlets.meshlets.size(), warmMeshlets.meshlets.size());
+    EXPECT_EQ(std::memcmp(coldMeshlets.meshlets.data(), warmMeshlets.meshlets.data(),
+                          coldMeshlets.meshlets.size() * sizeof(asset::Meshlet)),
+              0);
+    EXPECT_EQ(coldMeshlets.vertices, warmMeshlets.vertices);
+    EXPECT_EQ(coldMeshlets.triangles, warmMeshlets.triangles);
+
+    EXPECT_EQ(cold.GetName(), warm.GetName());
+    ExpectEqualAABB(cold.GetAABB(), warm.GetAABB());
+
+    const auto coldSamplers = cold.GetComponents<sg::Sampler>();
+    const auto warmSamplers = warm.GetComponents<sg::Sampler>();
+    ASSERT_EQ(coldSamplers.size(), warmSamplers.size());
+    for (size_t i = 0; i < coldSamplers.size(); ++i)
+    {
+        EXPECT_EQ(coldSamplers[i]->GetName(), warmSamplers[i]->GetName());
+        EXPECT_EQ(coldSamplers[i]->minFilter, warmSamplers[i]->minFilter);
+        EXPECT_EQ(coldSamplers[i]->magFilter, warmSamplers[i]->magFilter);
+        EXPECT_EQ(coldSamplers[i]->wrapS, warmSamplers[i]->wrapS);
+        EXPECT_EQ(coldSamplers[i]->wrapT, warmSamplers[i]->wrapT);
+    }
+
+    const auto coldTextures = cold.GetComponents<sg::Texture>();
+    const auto warmTextures = warm.GetComponents<sg::Texture>();
+    ASSERT_EQ(coldTextures.size(), warmTextures.size());
+    for (size_t i = 0; i < coldTextures.size(); ++i)
+    {
+        EXPECT_EQ(coldTextures[i]->GetName(), warmTextures[i]->GetName());
+        EXPECT_TRUE(*coldTextures[i] == *warmTextures[i]) << coldTextures[i]->GetName();
+    }
+
+    // extension pointers are never set by the loader, compare field by field
+    const auto coldMaterials = cold.GetComponents<sg::Material>();
+    const auto warmMaterials = warm.GetComponents<sg::Material>();
+    ASSERT_EQ(coldMaterials.size(), warmMaterials.size());
+    for (size_t i = 0; i < coldMaterials.size(); ++i)
+    {
+        const sg::Material& lhs = *coldMaterials[i];
+        const sg::Material& rhs = *warmMaterials[i];
+        EXPECT_EQ(lhs.GetName(), rhs.GetName());
+        EXPECT_EQ(lhs.index, rhs.index);
+        EXPECT_EQ(lhs.alphaMode, rhs.alphaMode);
+        EXPECT_EQ(lhs.doubleSided, rhs.doubleSided);
+        EXPECT_EQ(lhs.alphaCutoff, rhs.alphaCutoff);
+        EXPECT_EQ(lhs.metallicFactor, rhs.metallicFactor);
+        EXPECT_EQ(lhs.roughnessFactor, rhs.roughnessFactor);
+        EXPECT_EQ(lhs.baseColorFactor, rhs.baseColorFactor);
+        EXPECT_EQ(lhs.emissiveFactor, rhs.emissiveFactor);
+        EXPECT_EQ(lhs.emissiveStrength, rhs.emissiveStrength);
+        EXPECT_EQ(std::memcmp(&lhs.texCoordSets, &rhs.texCoordSets, sizeof(lhs.texCoordSets)), 0);
+        EXPECT_EQ(std::memcmp(&lhs.data, &rhs.data, sizeof(lhs.data)), 0);
+        EXPECT_EQ(lhs.m_pBaseColorTexture->GetName(), rhs.m_pBaseColorTexture->GetName());
+        EXPECT_EQ(lhs.m_pNormalTexture->GetName(), rhs.m_pNormalTexture->GetName());
+        EXPECT_EQ(lhs.m_pEmissiveTexture->GetName(), rhs.m_pEmissiveTexture->GetName());
+    }
+
+    const auto coldSubMeshes = cold.GetComponents<sg::SubMesh>();
+    const auto warmSubMeshes = warm.GetComponents<sg::SubMesh>();
+    ASSERT_EQ(coldSubMeshes.size(), warmSubMeshes.size());
+    for (size_t i = 0; i < coldSubMeshes.size(); ++i)
+    {
+        const sg::SubMesh& lhs = *coldSubMeshes[i];
+        const sg::SubMesh& rhs = *warmSubMeshes[i];
+        EXPECT_EQ(lhs.GetName(), rhs.GetName());
+        EXPECT_EQ(lhs.GetFirstIndex(), rhs.GetFirstIndex());
+        EXPECT_EQ(lhs.GetIndexCount(), rhs.GetIndexCount());
+        EXPECT_EQ(lhs.GetVertexCount(), rhs.GetVertexCount());
+        EXPECT_EQ(lhs.GetMaterialIndex(), rhs.GetMaterialIndex());
+        EXPECT_EQ(lhs.GetMaterial()->GetName(), rhs.GetMaterial()->GetName());
+        EXPECT_EQ(lhs.GetFirstMeshlet(), rhs.GetFirstMeshlet());
+        EXPECT_EQ(lhs.GetMeshletCount(), rhs.GetMeshletCount());
+        EXPECT_EQ(lhs.HasIndices(), rhs.HasIndices());
+        ExpectEqualAABB(lhs.GetAABB(), rhs.GetAABB());
+    }
+
+    const auto coldMeshes = cold.GetComponents<sg::Mesh>();
+    const auto warmMeshes = warm.GetComponents<sg::Mesh>();
+    ASSERT_EQ(coldMeshes.size(), warmMeshes.size());
+    for (size_t i = 0; i < coldMeshes.size(); ++i)
+    {
+        EXPECT_EQ(coldMeshes[i]->GetName(), warmMeshes[i]->GetName());
+        EXPECT_EQ(coldMeshes[i]->GetNumIndices(), warmMeshes[i]->GetNumIndices());
+        EXPECT_EQ(coldMeshes[i]->GetSubMeshes().size(), warmMeshes[i]->GetSubMeshes().size());
+        EXPECT_EQ(coldMeshes[i]->GetNodes().size(), warmMeshes[i]->GetNodes().size());
+        ExpectEqualAABB(coldMeshes[i]->GetAABB(), warmMeshes[i]->GetAABB());
+    }
+    EXPECT_EQ(cold.GetComponents<sg::Transform>().size(),
+              warm.GetComponents<sg::Transform>().size());
+
+    const auto& coldNodes = cold.GetRenderableNodes();
+    const auto& warmNodes = warm.GetRenderableNodes();
+    ASSERT_EQ(coldNodes.size(), warmNodes.size());
+    for (size_t i = 0; i < coldNodes.size(); ++i)
+    {
+        EXPECT_EQ(coldNodes[i]->GetIndex(), warmNodes[i]->GetIndex());
+        EXPECT_EQ(coldNodes[i]->GetName(), warmNodes[i]->GetName());
+        EXPECT_EQ(coldNodes[i]->GetRenderableIndex(), warmNodes[i]->GetRenderableIndex());
+        EXPECT_EQ(coldNodes[i]->GetData().modelMatrix, warmNodes[i]->GetData().modelMatrix);
+        EXPECT_EQ(coldNodes[i]->GetData().normalMatrix, warmNodes[i]->GetData().normalMatrix);
+        ASSERT_EQ(coldNodes[i]->GetParent() == nullptr, warmNodes[i]->GetParent() == nullptr);
+        if (coldNodes[i]->GetParent() != nullptr)
+        {
+            EXPECT_EQ(coldNodes[i]->GetParent()->GetIndex(), warmNodes[i]->GetParent()->GetIndex());
+        }
+    }
+}
+
+TEST(scene_cache_test, generate_mipmaps)
+{
+    // 4x2 -> 2x1 -> 1x1
+    std::vector<uint8_t> data(4 * 2 * 4);
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        const uint8_t value = i % 2 ? 255 : 0;
+        data[i * 4 + 0]     = value;
+        data[i * 4 + 1]     = 200;
+        data[i * 4 + 2]     = 0;
+        data[i * 4 + 3]     = value;
+    }
+    std::vector<uint8_t> srgbData = data;
+    EXPECT_EQ(asset::TextureLoader::GenerateMipmaps(4, 2, false, data), 3);
+    ASSERT_EQ(data.size(), (8 + 2 + 1) * 4);
+    EXPECT_EQ(data[32 + 0], 128);
+    EXPECT_EQ(data[32 + 1], 200);
+    EXPECT_EQ(data[40 + 3], 128);
+
+    // black and white average to about 188 in srgb, alpha stays linear
+    EXPECT_EQ(asset::TextureLoader::GenerateMipmaps(4, 2, true, srgbData), 3);
+    EXPECT_NEAR(srgbData[32 + 0], 188, 1);
+    EXPECT_EQ(srgbData[32 + 1], 200);
+    EXPECT_EQ(srgbData[32 + 3], 128);
+
+    std::vector<uint8_t> single(4, 7);
+    EXPECT_EQ(asset::TextureLoader::GenerateMipmaps(1, 1, false, single), 1);
+    EXPECT_EQ(single.size(), 4);
+}
+
+TEST(scene_cache_test, cold_matches_warm)
+{
+    SyntheticGltfDesc desc;
+    desc.numMeshes            = 4;
+    desc.numPrimitivesPerMesh = 3;
+    desc.gridSize             = 40;
+    desc.numTextures          = 3;
+    desc.textureSize          = 64;
+    desc.nestedNodes          = true;
+    const auto testDir        = GetTestDir("scene_cache_cold_matches_warm");
+    std::filesystem::remove_all(testDir);
+    const auto gltfPath = WriteSyntheticGltf(testDir, desc);
+    const auto cacheDir = testDir / "cache";
+
+    sg::Scene coldScene;
+    asset::FastGLTFLoader coldLoader;
+    LoadScene(gltfPath, cacheDir, &coldScene, coldLoader);
+    EXPECT_FALSE(coldLoader.IsLoadedFromSceneCache());
+    ASSERT_TRUE(std::filesystem::exists(
+        asset::SceneCache::GetCachePath(cacheDir.string(), gltfPath.string())));
+
+    sg::Scene warmScene;
+    asset::FastGLTFLoader warmLoader;
+    LoadScene(gltfPath, cacheDir, &warmScene, warmLoader);
+    ASSERT_TRUE(warmLoader.IsLoadedFromSceneCache());
+
+    // textures carry mip chains, 64x64 down to 1x1
+    const auto textures = warmScene.GetComponents<sg::Texture>();
+    ASSERT_EQ(textures.size(), desc.numTextures + 5);
+    EXPECT_EQ(textures[0]->mipLevels, 7);
+    EXPECT_EQ(textures[0]->format, asset::Format::R8G8B8A8_SRGB);
+    EXPECT_EQ(textures[1]->format, asset::Format::R8G8B8A8_UNORM);
+
+    ExpectEqualScenes(coldScene, coldLoader, warmScene, warmLoader);
+}
+
+TEST(scene_cache_test, invalidation)
+{
+    SyntheticGltfDesc desc;
+    desc.numMeshes   = 2;
+    desc.gridSize    = 8;
+    desc.numTextures = 1;
+    desc.textureSize = 16;
+    const auto testDir = GetTestDir("scene_cache_invalidation");
+    std::filesystem::remove_all(testDir);
+    const auto gltfPath  = WriteSyntheticGltf(testDir, desc);
+    const auto cacheDir  = testDir / "cache";
+    const auto cachePath = asset::SceneCache::GetCachePath(cacheDir.string(), gltfPath.string());
+
+    auto IsLoadedFromCache = [&](bool buildMeshlets) {
+        sg::Scene scene;
+        asset::FastGLTFLoader loader;
+        loader.SetBuildMeshlets(buildMeshlets);
+        loader.SetSceneCacheDir(cacheDir.string());
+        loader.LoadFromFile(gltfPath.string(), &scene);
+        EXPECT_EQ(scene.GetComponents<sg::SubMesh>().size(),
+                  desc.numMeshes * desc.numPrimitivesPerMesh);
+        return loader.IsLoadedFromSceneCache();
+    };
+    EXPECT_FALSE(IsLoadedFromCache(false));
+    EXPECT_TRUE(IsLoadedFromCache(false));
+
+    // loader options are part of the key
+    EXPECT_FALSE(IsLoadedFromCache(true));
+    EXPECT_TRUE(IsLoadedFromCache(true));
+
+    // a changed image next to an unchanged source
+    desc.textureSize = 32;
+    WriteSyntheticGltf(testDir, desc);
+    EXPECT_FALSE(IsLoadedFromCache(true));
+    EXPECT_TRUE(IsLoadedFromCache(true));
+
+    // a changed source
+    desc.gridSize = 9;
+    WriteSyntheticGltf(testDir, desc);
+    EXPECT_FALSE(IsLoadedFromCache(true));
+    EXPECT_TRUE(IsLoadedFromCache(true));
+
+    // truncated cache files are cooked again
+    std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) / 2);
+    EXPECT_FALSE(IsLoadedFromCache(true));
+    EXPECT_TRUE(IsLoadedFromCache(true));
+}
@@ -0,0 +1,249 @@
+#include "Graphics/RHI/RHIShaderReflectionCache.h"
+#include "Graphics/RHI/RHIShaderUtil.h"
+#include "Platform/FileSystem.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+
+using namespace zen;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+struct SpvShader
+{
+    std::string name;
+    RHIShaderGroupSPIRVPtr spirv;
+};
+
+bool StageFromFileName(const fs::path& path, RHIShaderStage& stage)
+{
+    // offscreen.vert.spv -> .vert
+    const std::string ext = path.stem().extension().string();
+    if (ext == ".vert")
+    {
+        stage = RHIShaderStage::eVertex;
+    }
+    else if (ext == ".geom")
+    {
+        stage = RHIShaderStage::eGeometry;
+    }
+    else if (ext == ".frag")
+    {
+        stage = RHIShaderStage::eFragment;
+    }
+    else if (ext == ".comp")
+    {
+        stage = RHIShaderStage::eCompute;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// every module of Data/SpvShaders as a single stage group
+std::vector<SpvShader> LoadAllSpvShaders()
+{
+    std::vector<SpvShader> shaders;
+    const fs::path root(SPV_SHADER_PATH);
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(root, ec))
+    {
+        RHIShaderStage stage;
+        if (!entry.is_regular_file() || entry.path().extension() != ".spv" ||
+            !StageFromFileName(entry.path(), stage))
+        {
+            continue;
+        }
+        SpvShader shader{fs::relative(entry.path(), root).generic_string(),
+                         MakeRefCountPtr<RHIShaderGroupSPIRV>()};
+        shader.spirv->SetStageSPIRV(stage, platform::FileSystem::LoadSpvFile(shader.name));
+        shaders.push_back(std::move(shader));
+    }
+    return shaders;
+}
+
+void ExpectEqual(const RHIShaderGroupInfo& expected,
+                 const RHIShaderGroupInfo& actual,
+                 const std::string& name)
+{
+    SCOPED_TRACE(name);
+    EXPECT_EQ(actual.pushConstants.name, expected.pushConstants.name);
+    EXPECT_EQ(actual.pushConstants.size, expected.pushConstants.size);
+    EXPECT_EQ(static_cast<int64_t>(actual.pushConstants.stageFlags),
+              static_cast<int64_t>(expected.pushConstants.stageFlags));
+
+    ASSERT_EQ(actual.vertexInputAttributes.size(), expected.vertexInputAttributes.size());
+    for (uint32_t i = 0; i < expected.vertexInputAttributes.size(); i++)
+    {
+        const auto& e = expected.vertexInputAttributes[i];
+        const auto& a = actual.vertexInputAttributes[i];
+        EXPECT_EQ(a.name, e.name);
+        EXPECT_EQ(a.location, e.location);
+        EXPECT_EQ(a.binding, e.binding);
+        EXPECT_EQ(a.offset, e.offset);
+        EXPECT_EQ(a.format, e.format);
+    }
+    EXPECT_EQ(actual.vertexBindingStride, expected.vertexBindingStride);
+
+    ASSERT_EQ(actual.SRDTable.size(), expected.SRDTable.size());
+    for (uint32_t set = 0; set < expected.SRDTable.size(); set++)
+    {
+        ASSERT_EQ(actual.SRDTable[set].size(), expected.SRDTable[set].size());
+        for (uint32_t i = 0; i < expected.SRDTable[set].size(); i++)
+        {
+            const RHIShaderResourceDescriptor& e = expected.SRDTable[set][i];
+            const RHIShaderResourceDescriptor& a = actual.SRDTable[set][i];
+            EXPECT_EQ(a.name, e.name);
+            EXPECT_EQ(a.type, e.type);
+            EXPECT_EQ(static_cast<int64_t>(a.stageFlags), static_cast<int64_t>(e.stageFlags));
+            EXPECT_EQ(a.writable, e.writable);
+            EXPECT_EQ(a.arraySize, e.arraySize);
+            EXPECT_EQ(a.blockSize, e.blockSize);
+            EXPECT_EQ(a.set, e.set);
+            EXPECT_EQ(a.binding, e.binding);
+        }
+    }
+
+    ASSERT_EQ(actual.specializationConstants.size(), expected.specializationConstants.size());
+    for (uint32_t i = 0; i < expected.specializationConstants.size(); i++)
+    {
+        const RHIShaderSpecializationConstant& e = expected.specializationConstants[i];
+        const RHIShaderSpecializationConstant& a = actual.specializationConstants[i];
+        EXPECT_EQ(a.type, e.type);
+        EXPECT_EQ(a.constantId, e.constantId);
+        EXPECT_EQ(static_cast<int64_t>(a.stages), static_cast<int64_t>(e.stages));
+        EXPECT_EQ(a.intValue, e.intValue);
+    }
+}
+
+fs::path MakeTempCachePath(const char* name)
+{
+    fs::path path = fs::temp_directory_path() / name;
+    std::error_code ec;
+    fs::remove(path, ec);
+    return path;
+}
+} // namespace
+
+TEST(shader_reflection_cache, serialized_matches_fresh_reflection)
+{
+    const std::vector<SpvShader> shaders = LoadAllSpvShaders();
+    ASSERT_FALSE(shaders.empty());
+
+    for (const SpvShader& shader : shaders)
+    {
+        RHIShaderGroupInfo fresh{};
+        RHIShaderUtil::ReflectShaderGroupInfo(shader.spirv, fresh);
+
+        std::vector<uint8_t> data;
+        RHIShaderReflectionCache::Serialize(fresh, data);
+        RHIShaderGroupInfo cached{};
+        ASSERT_TRUE(RHIShaderReflectionCache::Deserialize(data.data(), data.size(), cached))
+            << shader.name;
+        ExpectEqual(fresh, cached, shader.name);
+    }
+}
+
+TEST(shader_reflection_cache, reloaded_cache_matches_fresh_reflection)
+{
+    const std::vector<SpvShader> shaders = LoadAllSpvShaders();
+    ASSERT_FALSE(shaders.empty());
+    const fs::path path = MakeTempCachePath("zen_shader_reflection_cache_test.bin");
+
+    {
+        RHIShaderReflectionCache cache;
+        cache.Load(path.string());
+        for (const SpvShader& shader : shaders)
+        {
+            RHIShaderGroupInfo info{};
+            cache.GetOrReflect(shader.spirv, info);
+        }
+        EXPECT_EQ(cache.GetNumHits(), 0u);
+        EXPECT_EQ(cache.GetNumMisses(), shaders.size());
+        ASSERT_TRUE(cache.Save());
+        // nothing new to store
+        EXPECT_FALSE(cache.Save());
+    }
+
+    RHIShaderReflectionCache cache;
+    cache.Load(path.string());
+    EXPECT_EQ(cache.GetNumEntries(), shaders.size());
+    for (const SpvShader& shader : shaders)
+    {
+        RHIShaderGroupInfo fresh{};
+        RHIShaderUtil::ReflectShaderGroupInfo(shader.spirv, fresh);
+
+        RHIShaderGroupInfo cached{};
+        cached.name = shader.name;
+        cache.GetOrReflect(shader.spirv, cached);
+        EXPECT_EQ(cached.name, shader.name);
+        ExpectEqual(fresh, cached, shader.name);
+    }
+    EXPECT_EQ(cache.GetNumHits(), shaders.size());
+    EXPECT_EQ(cache.GetNumMisses(), 0u);
+
+    std::error_code ec;
+    fs::remove(path, ec);
+}
+
+TEST(shader_reflection_cache, hash_covers_stage_and_code)
+{
+    HeapVector<uint8_t> code(64);
+    for (uint32_t i = 0; i < code.size(); i++)
+    {
+        code[i] = static_cast<uint8_t>(i * 13);
+    }
+    RHIShaderGroupSPIRV vertex;
+    vertex.SetStageSPIRV(RHIShaderStage::eVertex, HeapVector<uint8_t>(code.data(), code.size()));
+    RHIShaderGroupSPIRV fragment;
+    fragment.SetStageSPIRV(RHIShaderStage::eFragment,
+                           HeapVector<uint8_t>(code.data(), code.size()));
+    code[17] ^= 1;
+    RHIShaderGroupSPIRV modified;
+    modified.SetStageSPIRV(RHIShaderStage::eVertex,
+                           HeapVector<uint8_t>(code.data(), code.size()));
+
+    const uint64_t hash = RHIShaderReflectionCache::CalcSPIRVHash(vertex);
+    EXPECT_NE(hash, RHIShaderReflectionCache::CalcSPIRVHash(fragment));
+    EXPECT_NE(hash, RHIShaderReflectionCache::CalcSPIRVHash(modified));
+}
+
+TEST(shader_reflection_cache, rejects_damaged_file)
+{
+    RHIShaderGroupInfo info{};
+    info.pushConstants.name = "PushConstants";
+    info.pushConstants.size = 16;
+    info.pushConstants.stageFlags.SetFlag(RHIShaderStageFlagBits::eVertex);
+    info.SRDTable.resize(1);
+    RHIShaderResourceDescriptor srd{};
+    srd.name      = "uCameraData";
+    srd.type      = RHIShaderResourceType::eUniformBuffer;
+    srd.blockSize = 128;
+    srd.stageFlags.SetFlag(RHIShaderStageFlagBits::eVertex);
+    info.SRDTable[0].push_back(srd);
+
+    HashMap<uint64_t, std::vector<uint8_t>> entries;
+    RHIShaderReflectionCache::Serialize(info, entries[42]);
+    const std::vector<uint8_t> file = RHIShaderReflectionCache::PackCacheFile(entries);
+
+    HashMap<uint64_t, std::vector<uint8_t>> unpacked;
+    ASSERT_TRUE(RHIShaderReflectionCache::UnpackCacheFile(file.data(), file.size(), unpacked));
+    ASSERT_TRUE(unpacked.contains(42));
+    EXPECT_EQ(unpacked[42], entries[42]);
+
+    std::vector<uint8_t> damaged = file;
+    damaged.back() ^= 0x80;
+    EXPECT_FALSE(
+        RHIShaderReflectionCache::UnpackCacheFile(damaged.data(), damaged.size(), unpacked));
+    EXPECT_TRUE(unpacked.empty());
+
+    EXPECT_FALSE(RHIShaderReflectionCache::UnpackCacheFile(file.data(), file.size() - 1, unpacked));
+
+    // a truncated entry never decodes
+    const std::vector<uint8_t>& data = entries[42];
+    RHIShaderGroupInfo decoded{};
+    EXPECT_FALSE(RHIShaderReflectionCache::Deserialize(data.data(), data.size() - 1, decoded));
+}
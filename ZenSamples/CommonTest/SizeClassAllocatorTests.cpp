@@ -0,0 +1,144 @@
+#include "Memory/Memory.h"
+#include "Memory/SizeClassAllocator.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace zen;
+
+TEST(size_class_allocator_test, size_classes)
+{
+    EXPECT_EQ(SizeClassAllocator::GetSizeClassSize(1), 16);
+    EXPECT_EQ(SizeClassAllocator::GetSizeClassSize(16), 16);
+    EXPECT_EQ(SizeClassAllocator::GetSizeClassSize(17), 32);
+    EXPECT_EQ(SizeClassAllocator::GetSizeClassSize(SizeClassAllocator::cMaxSmallSize),
+              SizeClassAllocator::cMaxSmallSize);
+    EXPECT_EQ(SizeClassAllocator::GetSizeClassSize(SizeClassAllocator::cMaxSmallSize + 1), 0);
+
+    // classes must be monotonic and waste at most a quarter of the block past the tiny classes
+    size_t prevClassSize = 0;
+    for (size_t size = 1; size <= SizeClassAllocator::cMaxSmallSize; size += 7)
+    {
+        const size_t classSize = SizeClassAllocator::GetSizeClassSize(size);
+        EXPECT_GE(classSize, size);
+        EXPECT_GE(classSize, prevClassSize);
+        EXPECT_EQ(classSize % SizeClassAllocator::cMinAlignment, 0);
+        if (size > 128)
+        {
+            EXPECT_LE(classSize - size, classSize / 4);
+        }
+        prevClassSize = classSize;
+    }
+}
+
+TEST(size_class_allocator_test, alloc_free)
+{
+    std::vector<void*> blocks;
+    for (size_t size = 1; size <= SizeClassAllocator::cMaxSmallSize; size = size * 3 / 2 + 1)
+    {
+        void* pMem = SizeClassAllocator::Alloc(size);
+        ASSERT_NE(pMem, nullptr);
+        EXPECT_TRUE(SizeClassAllocator::Owns(pMem));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(pMem) % SizeClassAllocator::cMinAlignment, 0);
+        EXPECT_EQ(SizeClassAllocator::GetBlockSize(pMem),
+                  SizeClassAllocator::GetSizeClassSize(size));
+        std::memset(pMem, 0xCD, size);
+        blocks.push_back(pMem);
+    }
+    for (void* pMem : blocks)
+    {
+        SizeClassAllocator::Free(pMem);
+    }
+
+    int stackValue = 0;
+    void* pSystemMem = malloc(64);
+    EXPECT_FALSE(SizeClassAllocator::Owns(&stackValue));
+    EXPECT_FALSE(SizeClassAllocator::Owns(pSystemMem));
+    EXPECT_EQ(SizeClassAllocator::GetBlockSize(pSystemMem), 0);
+    free(pSystemMem);
+}
+
+TEST(size_class_allocator_test, reuse)
+{
+    // a freed block goes to the thread cache and is handed out again first
+    void* pFirst = SizeClassAllocator::Alloc(48);
+    SizeClassAllocator::Free(pFirst);
+    void* pSecond = SizeClassAllocator::Alloc(48);
+    EXPECT_EQ(pFirst, pSecond);
+    SizeClassAllocator::Free(pSecond);
+}
+
+TEST(size_class_allocator_test, cross_thread_free)
+{
+    constexpr uint32_t numThreads      = 8;
+    constexpr uint32_t numAllocsThread = 20000;
+
+    // every thread allocates blocks which are freed by its neighbour
+    std::vector<std::vector<void*>> blocks(numThreads);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&blocks, t]() {
+            blocks[t].reserve(numAllocsThread);
+            for (uint32_t i = 0; i < numAllocsThread; ++i)
+            {
+                const size_t size = 16 + (i * 37 + t * 101) % 2048;
+                auto* pMem        = static_cast<uint32_t*>(SizeClassAllocator::Alloc(size));
+                pMem[0]           = t;
+                pMem[1]           = i;
+                blocks[t].push_back(pMem);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    threads.clear();
+
+    for (uint32_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&blocks, t]() {
+            const uint32_t owner = (t + 1) % numThreads;
+            for (uint32_t i = 0; i < numAllocsThread; ++i)
+            {
+                auto* pMem = static_cast<uint32_t*>(blocks[owner][i]);
+                EXPECT_EQ(pMem[0], owner);
+                EXPECT_EQ(pMem[1], i);
+                SizeClassAllocator::Free(pMem);
+            }
+            SizeClassAllocator::FlushThreadCache();
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST(size_class_allocator_test, default_allocator)
+{
+    constexpr int numElements = 100;
+    auto* pArr                = static_cast<int*>(ZEN_MEM_ALLOC(sizeof(int) * numElements));
+    ASSERT_NE(pArr, nullptr);
+    for (int i = 0; i < numElements; ++i)
+    {
+        pArr[i] = i;
+    }
+
+    // grow past the small size limit and shrink back, contents must survive both moves
+    constexpr int numLargeElements = SizeClassAllocator::cMaxSmallSize / sizeof(int) * 2;
+    pArr = static_cast<int*>(ZEN_MEM_REALLOC(pArr, sizeof(int) * numLargeElements));
+    ASSERT_NE(pArr, nullptr);
+    for (int i = 0; i < numElements; ++i)
+    {
+        EXPECT_EQ(pArr[i], i);
+    }
+    pArr = static_cast<int*>(ZEN_MEM_REALLOC(pArr, sizeof(int) * numElements));
+    ASSERT_NE(pArr, nullptr);
+    for (int i = 0; i < numElements; ++i)
+    {
+        EXPECT_EQ(pArr[i], i);
+    }
+    ZEN_MEM_FREE(pArr);
+}
@@ -0,0 +1,244 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stb_image_write.h>
+
+// Writes a .gltf + .bin pair made of tessellated grids, used to test and benchmark mesh loading
+// without shipping large assets. Every primitive has positions, normals, tangents, uvs and
+// colors, index types and materials alternate between primitives.
+struct SyntheticGltfDesc
+{
+    uint32_t numMeshes{4};
+    uint32_t numPrimitivesPerMesh{2};
+    // vertices per grid side, each primitive has gridSize^2 vertices and 2(gridSize-1)^2 triangles
+    uint32_t gridSize{64};
+    // external png images, used as base color and normal textures by the materials
+    uint32_t numTextures{0};
+    uint32_t textureSize{256};
+    // chains the mesh nodes into one hierarchy instead of placing them side by side
+    bool nestedNodes{false};
+    // the last primitive of every mesh has no index accessor
+    bool nonIndexedPrimitives{false};
+};
+
+namespace synthetic_gltf
+{
+struct BufferWriter
+{
+    std::vector<uint8_t> data;
+    std::ostringstream bufferViews;
+    std::ostringstream accessors;
+    uint32_t numBufferViews{0};
+    uint32_t numAccessors{0};
+
+    template <class T> uint32_t AddBufferView(const std::vector<T>& values)
+    {
+        while (data.size() % 4 != 0)
+        {
+            data.push_back(0);
+        }
+        const size_t offset   = data.size();
+        const size_t numBytes = values.size() * sizeof(T);
+        data.resize(offset + numBytes);
+        std::memcpy(data.data() + offset, values.data(), numBytes);
+        bufferViews << (numBufferViews ? "," : "") << "{\"buffer\":0,\"byteOffset\":" << offset
+                    << ",\"byteLength\":" << numBytes << "}";
+        return numBufferViews++;
+    }
+
+    uint32_t AddAccessor(uint32_t bufferView,
+                         uint32_t componentType,
+                         size_t count,
+                         const char* pType,
+                         const std::string& extra = "")
+    {
+        accessors << (numAccessors ? "," : "") << "{\"bufferView\":" << bufferView
+                  << ",\"componentType\":" << componentType << ",\"count\":" << count
+                  << ",\"type\":\"" << pType << "\"" << extra << "}";
+        return numAccessors++;
+    }
+};
+} // namespace synthetic_gltf
+
+inline std::filesystem::path WriteSyntheticGltf(const std::filesystem::path& dir,
+                                                const SyntheticGltfDesc& desc)
+{
+    using namespace synthetic_gltf;
+    constexpr uint32_t cFloat         = 5126;
+    constexpr uint32_t cUnsignedByte  = 5121;
+    constexpr uint32_t cUnsignedShort = 5123;
+    constexpr uint32_t cUnsignedInt   = 5125;
+
+    std::filesystem::create_directories(dir);
+    BufferWriter writer;
+    std::ostringstream meshes;
+    std::ostringstream nodes;
+    std::ostringstream sceneNodes;
+
+    const uint32_t n           = desc.gridSize;
+    const uint32_t numVertices = n * n;
+    for (uint32_t meshIndex = 0; meshIndex < desc.numMeshes; ++meshIndex)
+    {
+        std::ostringstream primitives;
+        for (uint32_t primIndex = 0; primIndex < desc.numPrimitivesPerMesh; ++primIndex)
+        {
+            const uint32_t seed = meshIndex * desc.numPrimitivesPerMesh + primIndex;
+            std::vector<float> positions, normals, tangents, uvs;
+            std::vector<uint8_t> colors;
+            positions.reserve(numVertices * 3);
+            for (uint32_t y = 0; y < n; ++y)
+            {
+                for (uint32_t x = 0; x < n; ++x)
+                {
+                    const float fx = static_cast<float>(x) / (n - 1);
+                    const float fy = static_cast<float>(y) / (n - 1);
+                    const float fz = 0.1f * std::sin(fx * 6.0f + seed) * std::cos(fy * 4.0f);
+                    positions.insert(positions.end(), {fx + seed, fz, fy});
+                    normals.insert(normals.end(), {-fz, 1.0f, 0.5f * fz});
+                    tangents.insert(tangents.end(), {1.0f, 0.0f, 0.0f, (x + y) % 2 ? 1.0f : -1.0f});
+                    uvs.insert(uvs.end(), {fx, fy});
+                    colors.insert(colors.end(), {static_cast<uint8_t>(x * 7 + seed),
+                                                 static_cast<uint8_t>(y * 13),
+                                                 static_cast<uint8_t>(x ^ y)});
+                }
+            }
+            std::vector<uint32_t> indices;
+            indices.reserve((n - 1) * (n - 1) * 6);
+            for (uint32_t y = 0; y + 1 < n; ++y)
+            {
+                for (uint32_t x = 0; x + 1 < n; ++x)
+                {
+                    const uint32_t i = y * n + x;
+                    indices.insert(indices.end(), {i, i + n, i + 1, i + 1, i + n, i + n + 1});
+                }
+            }
+
+            std::ostringstream bounds;
+            bounds << ",\"min\":[" << seed << ",-0.1,0],\"max\":[" << seed + 1 << ",0.1,1]";
+            const uint32_t posAccessor = writer.AddAccessor(writer.AddBufferView(positions), cFloat,
+                                                            numVertices, "VEC3", bounds.str());
+            const uint32_t normalAccessor =
+                writer.AddAccessor(writer.AddBufferView(normals), cFloat, numVertices, "VEC3");
+            const uint32_t tangentAccessor =
+                writer.AddAccessor(writer.AddBufferView(tangents), cFloat, numVertices, "VEC4");
+            const uint32_t uvAccessor =
+                writer.AddAccessor(writer.AddBufferView(uvs), cFloat, numVertices, "VEC2");
+            const uint32_t colorAccessor = writer.AddAccessor(
+                writer.AddBufferView(colors), cUnsignedByte, numVertices, "VEC3",
+                ",\"normalized\":true");
+
+            primitives << (primIndex ? "," : "") << "{\"attributes\":{\"POSITION\":" << posAccessor
+                       << ",\"NORMAL\":" << normalAccessor << ",\"TANGENT\":" << tangentAccessor
+                       << ",\"TEXCOORD_0\":" << uvAccessor << ",\"COLOR_0\":" << colorAccessor
+                       << "}";
+            const bool indexed =
+                !desc.nonIndexedPrimitives || primIndex + 1 < desc.numPrimitivesPerMesh;
+            // 16 bit indices where they fit on every other primitive
+            if (indexed && primIndex % 2 == 0 && numVertices <= 0xFFFF)
+            {
+                std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+                primitives << ",\"indices\":"
+                           << writer.AddAccessor(writer.AddBufferView(shortIndices),
+                                                 cUnsignedShort, indices.size(), "SCALAR");
+            }
+            else if (indexed)
+            {
+                primitives << ",\"indices\":"
+                           << writer.AddAccessor(writer.AddBufferView(indices), cUnsignedInt,
+                                                 indices.size(), "SCALAR");
+            }
+            if (seed % 3 != 2)
+            {
+                primitives << ",\"material\":" << seed % 2;
+            }
+            primitives << "}";
+        }
+        meshes << (meshIndex ? "," : "") << "{\"name\":\"SyntheticMesh" << meshIndex
+               << "\",\"primitives\":[" << primitives.str() << "]}";
+        nodes << (meshIndex ? "," : "") << "{\"mesh\":" << meshIndex << ",\"translation\":["
+              << meshIndex << ",0,0]";
+        if (desc.nestedNodes)
+        {
+            // a mesh-less node between every two meshes
+            nodes << ",\"rotation\":[0,0.38268343,0,0.92387953],\"scale\":[1,2,1]";
+            if (meshIndex + 1 < desc.numMeshes)
+            {
+                nodes << ",\"children\":[" << desc.numMeshes + meshIndex << "]";
+            }
+        }
+        else
+        {
+            sceneNodes << (meshIndex ? "," : "") << meshIndex;
+        }
+        nodes << "}";
+    }
+    if (desc.nestedNodes)
+    {
+        sceneNodes << 0;
+        for (uint32_t meshIndex = 0; meshIndex + 1 < desc.numMeshes; ++meshIndex)
+        {
+            nodes << ",{\"name\":\"Group" << meshIndex << "\",\"translation\":[0,1,0],"
+                  << "\"children\":[" << meshIndex + 1 << "]}";
+        }
+    }
+
+    std::ostringstream textureSections;
+    std::ostringstream baseColorTexture;
+    std::ostringstream normalTexture;
+    if (desc.numTextures > 0)
+    {
+        std::ostringstream textures;
+        std::ostringstream images;
+        const uint32_t size = desc.textureSize;
+        for (uint32_t i = 0; i < desc.numTextures; ++i)
+        {
+            std::vector<uint8_t> pixels(size * size * 4);
+            for (uint32_t y = 0; y < size; ++y)
+            {
+                for (uint32_t x = 0; x < size; ++x)
+                {
+                    uint8_t* pPixel = &pixels[(y * size + x) * 4];
+                    pPixel[0]       = static_cast<uint8_t>(x * 255 / size);
+                    pPixel[1]       = static_cast<uint8_t>(y * 255 / size);
+                    pPixel[2]       = static_cast<uint8_t>((x / 8 + y / 8 + i) % 2 * 255);
+                    pPixel[3]       = static_cast<uint8_t>(255 - i * 16);
+                }
+            }
+            const std::string imageName = "synthetic_" + std::to_string(i) + ".png";
+            stbi_write_png((dir / imageName).string().c_str(), size, size, 4, pixels.data(),
+                           size * 4);
+            images << (i ? "," : "") << "{\"uri\":\"" << imageName << "\"}";
+            textures << (i ? "," : "") << "{\"source\":" << i << ",\"sampler\":0}";
+        }
+        textureSections << ",\"textures\":[" << textures.str() << "],\"images\":[" << images.str()
+                        << "],\"samplers\":[{\"magFilter\":9729,\"minFilter\":9987,"
+                        << "\"wrapS\":10497,\"wrapT\":33071}]";
+        baseColorTexture << ",\"baseColorTexture\":{\"index\":0}";
+        normalTexture << ",\"normalTexture\":{\"index\":" << (desc.numTextures - 1) << "}";
+    }
+
+    const std::filesystem::path binPath  = dir / "synthetic.bin";
+    const std::filesystem::path gltfPath = dir / "synthetic.gltf";
+    std::ofstream(binPath, std::ios::binary)
+        .write(reinterpret_cast<const char*>(writer.data.data()),
+               static_cast<std::streamsize>(writer.data.size()));
+
+    std::ofstream gltf(gltfPath);
+    gltf << "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":["
+         << sceneNodes.str() << "]}],\"nodes\":[" << nodes.str() << "],\"meshes\":["
+         << meshes.str() << "],\"materials\":["
+         << "{\"pbrMetallicRoughness\":{\"baseColorFactor\":[1,0.5,0.25,1]"
+         << baseColorTexture.str() << "}" << normalTexture.str() << "},"
+         << "{\"pbrMetallicRoughness\":{\"baseColorFactor\":[0.2,0.4,0.6,0.8]}"
+         << normalTexture.str() << "}]" << textureSections.str() << ",\"accessors\":["
+         << writer.accessors.str() << "],\"bufferViews\":[" << writer.bufferViews.str()
+         << "],\"buffers\":[{\"uri\":\"synthetic.bin\",\"byteLength\":" << writer.data.size()
+         << "}]}";
+    return gltfPath;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <filesystem>
+
+// scratch directory of a test, the tests create and overwrite the files they need in it
+inline std::filesystem::path GetTestDir(const char* pName)
+{
+    return std::filesystem::temp_directory_path() / "ZenEngineTests" / pName;
+}
@@ -0,0 +1,238 @@
+#include "SceneGraph/Scene.h"
+#include "Utils/JobSystem.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace zen;
+
+struct RandomTransform
+{
+    Vec3 translation;
+    Quat rotation;
+    Vec3 scale;
+};
+
+static RandomTransform GenerateTransform(std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+    RandomTransform transform;
+    transform.translation = Vec3(position(rng), position(rng), position(rng));
+    transform.rotation = glm::normalize(Quat(axis(rng), axis(rng), axis(rng), axis(rng) + 2.0f));
+    transform.scale    = Vec3(scale(rng), scale(rng), scale(rng));
+    return transform;
+}
+
+// depth first random tree: each node hangs below a random node of the open branch
+static std::vector<uint32_t> GenerateParents(uint32_t numNodes, uint32_t numRoots, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<uint32_t> parents(numNodes);
+    std::vector<uint32_t> branch;
+    for (uint32_t i = 0; i < numNodes; i++)
+    {
+        if (branch.empty() || rng() % (numNodes / numRoots) == 0)
+        {
+            branch.clear();
+            parents[i] = sg::TransformHierarchy::cInvalidIndex;
+        }
+        else
+        {
+            // favour deep chains
+            const uint32_t depth = static_cast<uint32_t>(branch.size()) - 1 -
+                std::min<uint32_t>(rng() % 4, static_cast<uint32_t>(branch.size()) - 1);
+            branch.resize(depth + 1);
+            parents[i] = branch.back();
+        }
+        branch.push_back(i);
+    }
+    return parents;
+}
+
+TEST(transform_hierarchy_tests, matches_transform_components)
+{
+    const uint32_t cNumNodes = 2000;
+    const auto parents       = GenerateParents(cNumNodes, 4, 7);
+    std::mt19937 rng(11);
+
+    sg::Scene scene;
+    std::vector<UniquePtr<sg::Node>> nodes;
+    std::vector<UniquePtr<sg::Transform>> transforms;
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        nodes.emplace_back(MakeUnique<sg::Node>(i, "node" + std::to_string(i)));
+        if (parents[i] != sg::TransformHierarchy::cInvalidIndex)
+        {
+            nodes[i]->SetParent(nodes[parents[i]].Get());
+            nodes[parents[i]]->AddChild(nodes[i].Get());
+        }
+        // every fifth node is a group without a transform
+        if (i % 5 != 4)
+        {
+            const auto random = GenerateTransform(rng);
+            transforms.emplace_back(MakeUnique<sg::Transform>(*nodes[i]));
+            transforms.back()->SetTranslation(random.translation);
+            transforms.back()->SetRotation(random.rotation);
+            transforms.back()->SetScale(random.scale);
+            nodes[i]->AddComponent(transforms.back().Get());
+            scene.AddRenderableNode(nodes[i].Get());
+        }
+    }
+
+    // reference: parent walk per node and inverse transpose in Node::SetData
+    std::vector<sg::NodeData> expected;
+    for (auto* pNode : scene.GetRenderableNodes())
+    {
+        sg::Node reference(0, "");
+        reference.SetData(0, pNode->GetComponent<sg::Transform>()->GetWorldMatrix());
+        expected.push_back(reference.GetData());
+    }
+
+    scene.SetNodes(std::move(nodes));
+    scene.SetComponents(std::move(transforms));
+    scene.BuildTransformHierarchy();
+    scene.UpdateTransforms();
+
+    const auto& renderableNodes = scene.GetRenderableNodes();
+    for (uint32_t i = 0; i < renderableNodes.size(); i++)
+    {
+        EXPECT_EQ(renderableNodes[i]->GetData().modelMatrix, expected[i].modelMatrix);
+        EXPECT_EQ(renderableNodes[i]->GetData().normalMatrix, expected[i].normalMatrix);
+    }
+}
+
+TEST(transform_hierarchy_tests, local_matrix_of_transform)
+{
+    // glTF nodes given by a matrix, the shear is not expressible as translation, rotation and scale
+    Mat4 shear(1.0f);
+    shear[1][0] = 0.5f;
+    shear[2][1] = -0.25f;
+    shear[3]    = Vec4(1.0f, 2.0f, 3.0f, 1.0f);
+
+    sg::Scene scene;
+    std::vector<UniquePtr<sg::Node>> nodes;
+    std::vector<UniquePtr<sg::Transform>> transforms;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        nodes.emplace_back(MakeUnique<sg::Node>(i, "node" + std::to_string(i)));
+        transforms.emplace_back(MakeUnique<sg::Transform>(*nodes[i]));
+        nodes[i]->AddComponent(transforms[i].Get());
+        scene.AddRenderableNode(nodes[i].Get());
+        if (i > 0)
+        {
+            nodes[i]->SetParent(nodes[i - 1].Get());
+            nodes[i - 1]->AddChild(nodes[i].Get());
+        }
+    }
+    transforms[0]->SetLocalMatrix(shear);
+    transforms[1]->SetTranslation(Vec3(0.0f, 1.0f, 0.0f));
+    transforms[2]->SetLocalMatrix(glm::transpose(shear));
+    transforms[2]->SetScale(Vec3(2.0f));
+
+    std::vector<Mat4> expected;
+    for (auto& transform : transforms)
+    {
+        expected.push_back(transform->GetWorldMatrix());
+    }
+
+    scene.SetNodes(std::move(nodes));
+    scene.SetComponents(std::move(transforms));
+    scene.BuildTransformHierarchy();
+    EXPECT_TRUE(scene.UpdateTransforms());
+    EXPECT_FALSE(scene.UpdateTransforms());
+
+    const auto& renderableNodes = scene.GetRenderableNodes();
+    for (uint32_t i = 0; i < renderableNodes.size(); i++)
+    {
+        EXPECT_EQ(renderableNodes[i]->GetData().modelMatrix, expected[i]);
+    }
+
+    // the local matrix replaces the transform of the root, its subtree follows
+    sg::TransformHierarchy& hierarchy = scene.GetTransformHierarchy();
+    hierarchy.SetLocalMatrix(0, glm::translate(Mat4(1.0f), Vec3(4.0f, 0.0f, 0.0f)));
+    EXPECT_TRUE(scene.UpdateTransforms());
+    EXPECT_EQ(renderableNodes[2]->GetData().modelMatrix,
+              hierarchy.GetWorldMatrix(0) * hierarchy.GetLocalMatrix(1) *
+                  hierarchy.GetLocalMatrix(2));
+}
+
+TEST(transform_hierarchy_tests, dirty_subtree)
+{
+    const uint32_t cNumNodes = 1000;
+    const auto parents       = GenerateParents(cNumNodes, 2, 3);
+    std::mt19937 rng(5);
+
+    sg::TransformHierarchy hierarchy;
+    std::vector<RandomTransform> locals;
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        locals.push_back(GenerateTransform(rng));
+        hierarchy.AddNode(parents[i], locals[i].translation, locals[i].rotation, locals[i].scale);
+    }
+    hierarchy.Update();
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        EXPECT_TRUE(hierarchy.IsUpdated(i));
+    }
+
+    // nothing changed
+    hierarchy.Update();
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        EXPECT_FALSE(hierarchy.IsUpdated(i));
+    }
+
+    // first node past the start with children
+    uint32_t moved = 37;
+    while (hierarchy.GetSubtreeEnd(moved) == moved + 1)
+    {
+        moved++;
+    }
+    locals[moved] = GenerateTransform(rng);
+    hierarchy.SetLocalTransform(moved, locals[moved].translation, locals[moved].rotation,
+                                locals[moved].scale);
+    hierarchy.Update();
+
+    sg::TransformHierarchy rebuilt;
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        rebuilt.AddNode(parents[i], locals[i].translation, locals[i].rotation, locals[i].scale);
+    }
+    rebuilt.Update();
+
+    const uint32_t subtreeEnd = hierarchy.GetSubtreeEnd(moved);
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        EXPECT_EQ(hierarchy.IsUpdated(i), i >= moved && i < subtreeEnd);
+        EXPECT_EQ(hierarchy.GetWorldMatrix(i), rebuilt.GetWorldMatrix(i));
+        EXPECT_EQ(hierarchy.GetNormalMatrix(i), rebuilt.GetNormalMatrix(i));
+    }
+}
+
+TEST(transform_hierarchy_tests, parallel_matches_serial)
+{
+    const uint32_t cNumNodes = 50000;
+    const auto parents       = GenerateParents(cNumNodes, 1, 9);
+    std::mt19937 rng(13);
+
+    sg::TransformHierarchy serial;
+    sg::TransformHierarchy parallel;
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        const auto random = GenerateTransform(rng);
+        serial.AddNode(parents[i], random.translation, random.rotation, random.scale);
+        parallel.AddNode(parents[i], random.translation, random.rotation, random.scale);
+    }
+
+    JobSystem jobSystem(4);
+    serial.Update();
+    parallel.Update(&jobSystem);
+    for (uint32_t i = 0; i < cNumNodes; i++)
+    {
+        ASSERT_EQ(serial.GetWorldMatrix(i), parallel.GetWorldMatrix(i));
+        ASSERT_EQ(serial.GetNormalMatrix(i), parallel.GetNormalMatrix(i));
+        ASSERT_TRUE(parallel.IsUpdated(i));
+    }
+}
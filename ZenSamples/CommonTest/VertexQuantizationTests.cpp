@@ -0,0 +1,230 @@
+#include "AssetLib/VertexQuantization.h"
+#include "AssetLib/FastGLTFLoader.h"
+#include "SceneGraph/Scene.h"
+#include "Utils/Errors.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <random>
+
+using namespace zen;
+using namespace zen::asset;
+
+namespace
+{
+// error bounds documented in AssetLib/VertexQuantization.h
+constexpr float cMaxDirectionErrorDegrees = 0.005f;
+constexpr float cMaxColorError            = 1.0f / 510.0f + 1e-6f;
+constexpr float cMaxHalfRelativeError     = 1.0f / 2048.0f;
+
+// atan2 stays accurate for tiny angles where acos of a float dot product does not
+float AngleDegrees(const Vec3& lhs, const Vec3& rhs)
+{
+    const float sinAngle = glm::length(glm::cross(lhs, rhs));
+    return std::atan2(sinAngle, glm::dot(lhs, rhs)) * 57.29578f;
+}
+
+Vec3 RandomDirection(std::mt19937& rng)
+{
+    std::normal_distribution<float> dist;
+    Vec3 direction;
+    do
+    {
+        direction = Vec3(dist(rng), dist(rng), dist(rng));
+    } while (glm::length(direction) < 1e-3f);
+    return glm::normalize(direction);
+}
+
+// checks every attribute of a round tripped vertex against the documented bounds
+void ExpectWithinBounds(const Vertex& vertex,
+                        const Vertex& unpacked,
+                        const VertexQuantizationBounds& bounds)
+{
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        // half a step, plus float rounding of offset + q * scale
+        const float range    = std::abs(bounds.offset[i]) + bounds.scale[i] * 65535.0f;
+        const float maxError = bounds.scale[i] * 0.5f + range * 1e-6f;
+        EXPECT_LE(std::abs(unpacked.pos[i] - vertex.pos[i]), maxError);
+    }
+    if (glm::length(Vec3(vertex.normal)) > 0.0f)
+    {
+        EXPECT_LE(AngleDegrees(Vec3(vertex.normal), Vec3(unpacked.normal)),
+                  cMaxDirectionErrorDegrees);
+    }
+    if (glm::length(Vec3(vertex.tangent)) > 0.0f)
+    {
+        EXPECT_LE(AngleDegrees(Vec3(vertex.tangent), Vec3(unpacked.tangent)),
+                  cMaxDirectionErrorDegrees);
+        EXPECT_EQ(unpacked.tangent.w, vertex.tangent.w);
+    }
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        EXPECT_LE(std::abs(unpacked.uv0[i] - vertex.uv0[i]),
+                  std::abs(vertex.uv0[i]) * cMaxHalfRelativeError + 1e-7f);
+        EXPECT_LE(std::abs(unpacked.uv1[i] - vertex.uv1[i]),
+                  std::abs(vertex.uv1[i]) * cMaxHalfRelativeError + 1e-7f);
+    }
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        EXPECT_LE(std::abs(unpacked.color[i] - vertex.color[i]), cMaxColorError);
+    }
+}
+} // namespace
+
+TEST(vertex_quantization_test, half_float)
+{
+    // every finite half survives the round trip through float
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+    {
+        if ((bits & 0x7C00) == 0x7C00 && (bits & 0x3FF) != 0)
+        {
+            continue; // nan
+        }
+        EXPECT_EQ(FloatToHalf(HalfToFloat(static_cast<uint16_t>(bits))), bits);
+    }
+    EXPECT_EQ(FloatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.0f), 0xC000);
+    EXPECT_EQ(FloatToHalf(65504.0f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(1e6f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(5.96046448e-8f), 0x0001);
+    // ties round to even
+    EXPECT_EQ(FloatToHalf(1.0f + 1.0f / 2048.0f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(1.0f + 3.0f / 2048.0f), 0x3C02);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-64.0f, 64.0f);
+    for (uint32_t i = 0; i < 100000; ++i)
+    {
+        const float value = dist(rng);
+        EXPECT_LE(std::abs(HalfToFloat(FloatToHalf(value)) - value),
+                  std::abs(value) * cMaxHalfRelativeError);
+    }
+}
+
+TEST(vertex_quantization_test, octahedral_directions)
+{
+    std::mt19937 rng(3);
+    for (uint32_t i = 0; i < 100000; ++i)
+    {
+        const Vec3 direction = RandomDirection(rng);
+        EXPECT_LE(AngleDegrees(direction, OctDecode(OctEncode(direction))), 1e-3f);
+    }
+    // axes and the folded edges of the lower hemisphere
+    const Vec3 cEdgeCases[] = {Vec3(0, 0, 1),  Vec3(0, 0, -1), Vec3(1, 0, 0), Vec3(-1, 0, 0),
+                               Vec3(0, 1, 0),  Vec3(0, -1, 0), Vec3(1, 1, -1),
+                               Vec3(-1, 1, -1)};
+    for (const Vec3& direction : cEdgeCases)
+    {
+        EXPECT_LE(AngleDegrees(direction, OctDecode(OctEncode(direction))), 1e-3f);
+    }
+}
+
+TEST(vertex_quantization_test, round_trip)
+{
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> posDist(-250.0f, 250.0f);
+    std::uniform_real_distribution<float> uvDist(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+
+    std::vector<Vertex> vertices(50000);
+    for (Vertex& vertex : vertices)
+    {
+        vertex.pos     = Vec4(posDist(rng), posDist(rng) * 0.01f, posDist(rng), 1.0f);
+        vertex.normal  = Vec4(RandomDirection(rng), 0.0f);
+        vertex.tangent = Vec4(RandomDirection(rng), unitDist(rng) < 0.5f ? -1.0f : 1.0f);
+        vertex.uv0     = Vec2(uvDist(rng), uvDist(rng));
+        vertex.uv1     = Vec2(unitDist(rng), unitDist(rng));
+        vertex.color   = Vec4(unitDist(rng), unitDist(rng), unitDist(rng), unitDist(rng));
+    }
+
+    std::vector<PackedVertex> packedVertices(vertices.size());
+    const VertexQuantizationBounds bounds =
+        PackVertices(vertices.data(), vertices.size(), packedVertices.data());
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        ExpectWithinBounds(vertices[i], UnpackVertex(packedVertices[i], bounds), bounds);
+    }
+}
+
+TEST(vertex_quantization_test, flat_submesh)
+{
+    // a quad in the xz plane, the flat y axis must come back exactly
+    std::vector<Vertex> vertices(4);
+    vertices[0].pos = Vec4(-1.0f, 2.5f, -1.0f, 1.0f);
+    vertices[1].pos = Vec4(1.0f, 2.5f, -1.0f, 1.0f);
+    vertices[2].pos = Vec4(1.0f, 2.5f, 1.0f, 1.0f);
+    vertices[3].pos = Vec4(-1.0f, 2.5f, 1.0f, 1.0f);
+
+    std::vector<PackedVertex> packedVertices(vertices.size());
+    const VertexQuantizationBounds bounds =
+        PackVertices(vertices.data(), vertices.size(), packedVertices.data());
+    EXPECT_EQ(bounds.scale.y, 0.0f);
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        const Vertex unpacked = UnpackVertex(packedVertices[i], bounds);
+        EXPECT_EQ(unpacked.pos.x, vertices[i].pos.x);
+        EXPECT_EQ(unpacked.pos.y, 2.5f);
+        EXPECT_EQ(unpacked.pos.z, vertices[i].pos.z);
+    }
+}
+
+TEST(vertex_quantization_test, sample_models)
+{
+    // same location the VulkanRHIDemo samples load their models from
+    const char* cSampleModels[] = {
+        "../../glTF-Sample-Models/2.0/Box/glTF/Box.gltf",
+        "../../glTF-Sample-Models/2.0/DamagedHelmet/glTF/DamagedHelmet.gltf",
+        "../../glTF-Sample-Models/2.0/FlightHelmet/glTF/FlightHelmet.gltf",
+        "../../glTF-Sample-Models/2.0/Sponza/glTF/Sponza.gltf",
+    };
+    uint32_t numLoadedModels = 0;
+    for (const char* pModelPath : cSampleModels)
+    {
+        if (!std::filesystem::exists(pModelPath))
+        {
+            continue;
+        }
+        numLoadedModels++;
+
+        sg::Scene scene;
+        FastGLTFLoader loader;
+        loader.LoadFromFile(pModelPath, &scene);
+        const auto& vertices = loader.GetVertices();
+        const auto& indices  = loader.GetIndices();
+
+        // submeshes own disjoint vertex ranges, find them through the indices
+        std::vector<PackedVertex> packedVertices(vertices.size());
+        for (const sg::SubMesh* pSubMesh : scene.GetComponents<sg::SubMesh>())
+        {
+            if (pSubMesh->GetIndexCount() == 0)
+            {
+                continue;
+            }
+            const auto first = indices.begin() + pSubMesh->GetFirstIndex();
+            const auto [minIt, maxIt] =
+                std::minmax_element(first, first + pSubMesh->GetIndexCount());
+            const uint32_t numVertices = *maxIt - *minIt + 1;
+
+            const VertexQuantizationBounds bounds =
+                PackVertices(&vertices[*minIt], numVertices, &packedVertices[*minIt]);
+            for (uint32_t i = *minIt; i <= *maxIt; ++i)
+            {
+                Vertex vertex = vertices[i];
+                // the packed layout drops skinning data
+                vertex.joint0  = Vec4(0.0f);
+                vertex.weight0 = Vec4(0.0f);
+                ExpectWithinBounds(vertex, UnpackVertex(packedVertices[i], bounds), bounds);
+            }
+        }
+
+        const size_t fullSize   = vertices.size() * sizeof(Vertex);
+        const size_t packedSize = vertices.size() * sizeof(PackedVertex);
+        LOGI("{}: {} vertices, {:.2f} MB -> {:.2f} MB ({:.1f}% saved)", pModelPath,
+             vertices.size(), fullSize / (1024.0 * 1024.0), packedSize / (1024.0 * 1024.0),
+             100.0 * (1.0 - static_cast<double>(packedSize) / fullSize));
+    }
+    if (numLoadedModels == 0)
+    {
+        GTEST_SKIP() << "glTF-Sample-Models not found next to the repository";
+    }
+}